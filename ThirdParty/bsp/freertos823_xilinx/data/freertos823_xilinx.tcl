@@ -215,7 +215,13 @@ proc generate {os_handle} {
 	file copy -force [file join src Source list.c] ./src
 	file copy -force [file join src Source timers.c] ./src
 	file copy -force [file join src Source event_groups.c] ./src
-	file copy -force [file join src Source portable MemMang heap_4.c] ./src
+	set use_slab_heap [common::get_property CONFIG.use_slab_heap $os_handle]
+	if { $use_slab_heap == "true" } {
+		file copy -force [file join src Source portable MemMang heap_slab.c] ./src
+		file copy -force [file join src Source portable MemMang heap_slab.h] ./src
+	} else {
+		file copy -force [file join src Source portable MemMang heap_4.c] ./src
+	}
 
 	if { $proctype == "psu_cortexr5" } {
 		file copy -force [file join src Source portable GCC ARM_CR5 port.c] ./src
@@ -509,7 +515,13 @@ proc generate {os_handle} {
 		xput_define $config_file "configNUM_THREAD_LOCAL_STORAGE_POINTERS"  $val
 	}
 
-	puts $config_file "#define configUSE_TICKLESS_IDLE	0"
+	set val [common::get_property CONFIG.use_tickless_idle $os_handle]
+	if {$val == "false"} {
+		xput_define $config_file "configUSE_TICKLESS_IDLE"  "0"
+	} else {
+		xput_define $config_file "configUSE_TICKLESS_IDLE"  "1"
+	}
+
 	puts $config_file "#define configTASK_RETURN_ADDRESS    NULL"
 	puts $config_file "#define INCLUDE_vTaskPrioritySet             1"
 	puts $config_file "#define INCLUDE_uxTaskPriorityGet            1"
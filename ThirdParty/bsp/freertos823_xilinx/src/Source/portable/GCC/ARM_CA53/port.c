@@ -128,13 +128,18 @@ this value. */
 (but the lowest) interrupt priority. */
 #define portUNMASK_VALUE				( 0xFFUL )
 
-/* Tasks are not created with a floating point context, but can be given a
-floating point context after they have been created.  A variable is stored as
-part of the tasks context that holds portNO_FLOATING_POINT_CONTEXT if the task
-does not have an FPU context, or any other value if the task does have an FPU
-context. */
+/* The FPU registers are switched lazily.  They stay in the FPU while their
+owner is switched out, and are only saved into the owner's stack frame when
+another task executes an FPU instruction.  A variable stored as part of the task
+context holds portNO_FLOATING_POINT_CONTEXT if the frame does not hold an FPU
+context, or any other value if it does. */
 #define portNO_FLOATING_POINT_CONTEXT	( ( StackType_t ) 0 )
 
+/* Every task context reserves space for an FPU context (Q0 to Q31, FPSR and
+FPCR), so saving the registers of a task that is not running never writes
+below its saved stack pointer.  Must match portFPU_CONTEXT_SIZE in portASM.S. */
+#define portFPU_CONTEXT_WORDS			( ( 32 * 2 ) + 2 )
+
 /* Constants required to setup the initial task context. */
 #define portEL3							( ( StackType_t ) 0x0c )
 #define portSP_ELx						( ( StackType_t ) 0x01 )
@@ -185,9 +190,9 @@ the scheduler starts.  As it is stored as part of the task context it will
 automatically be set to 0 when the first task is started. */
 volatile uint64_t ullCriticalNesting = 9999ULL;
 
-/* Saved as part of the task context.  If ullPortTaskHasFPUContext is non-zero
-then floating point context must be saved and restored for the task. */
-uint64_t ullPortTaskHasFPUContext = pdFALSE;
+/* The task whose registers are live in the FPU, or NULL.  Every other task
+runs with FPU accesses trapped, and the trap hands the FPU over. */
+void * volatile pxPortFPUOwnerTCB = NULL;
 
 /* Set to 1 to pend a context switch from an ISR. */
 uint64_t ullPortYieldRequired = pdFALSE;
@@ -285,14 +290,16 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 	*pxTopOfStack = ( StackType_t ) pxCode; /* Exception return address. */
 	pxTopOfStack--;
 
+	/* Space for the FPU context. */
+	pxTopOfStack -= portFPU_CONTEXT_WORDS;
+
 	/* The task will start with a critical nesting count of 0 as interrupts are
 	enabled. */
 	*pxTopOfStack = portNO_CRITICAL_NESTING;
 	pxTopOfStack--;
 
-	/* The task will start without a floating point context.  A task that uses
-	the floating point hardware must call vPortTaskUsesFPU() before executing
-	any floating point instructions. */
+	/* The task will start without a floating point context.  It is given one
+	automatically the first time it executes a floating point instruction. */
 	*pxTopOfStack = portNO_FLOATING_POINT_CONTEXT;
 
 	return pxTopOfStack;
@@ -461,12 +468,20 @@ void FreeRTOS_Tick_Handler( void )
 
 void vPortTaskUsesFPU( void )
 {
-	/* A task is registering the fact that it needs an FPU context.  Set the
-	FPU flag (which is saved as part of the task context). */
-	ullPortTaskHasFPUContext = pdTRUE;
+	/* FPU contexts are now created on the first floating point instruction a
+	task executes, so there is nothing to register.  Kept so existing
+	applications still build. */
+}
+/*-----------------------------------------------------------*/
 
-	/* Consider initialising the FPSR here - but probably not necessary in
-	AArch64. */
+void vPortCleanUpTCB( void *pvTCB )
+{
+	/* A deleted task must not be left as the FPU owner, or the next FPU trap
+	would save registers into its freed stack. */
+	if( pxPortFPUOwnerTCB == pvTCB )
+	{
+		pxPortFPUOwnerTCB = NULL;
+	}
 }
 /*-----------------------------------------------------------*/
 
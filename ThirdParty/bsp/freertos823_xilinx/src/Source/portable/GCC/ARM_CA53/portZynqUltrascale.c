@@ -78,6 +78,17 @@
 /* Timer used to generate the tick interrupt. */
 static XTtcPs xTimerInstance;
 XScuGic xInterruptController;
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+	/* Timer counts in one tick period, and the largest number of tick periods
+	the interval register can hold. */
+	static uint32_t ulTimerCountsForOneTick = 0;
+	static TickType_t xMaximumPossibleSuppressedTicks = 0;
+
+	/* Set while the interval is stretched to the end of a partial tick period
+	after an early wake up. */
+	static volatile BaseType_t xRestoreTickInterval = pdFALSE;
+#endif
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_SetupTickInterrupt( void )
@@ -128,6 +139,13 @@ XScuGic_Config *pxInterruptControllerConfig;
 	XTtcPs_SetInterval( &xTimerInstance, usInterval );
 	XTtcPs_SetPrescaler( &xTimerInstance, ucPrescale );
 
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		ulTimerCountsForOneTick = ( uint32_t ) usInterval;
+		xMaximumPossibleSuppressedTicks = ( TickType_t ) ( XTTCPS_MAX_INTERVAL_COUNT / ulTimerCountsForOneTick );
+	}
+	#endif
+
 	/* The priority must be the lowest possible. */
 	XScuGic_SetPriorityTriggerType( &xInterruptController, configTIMER_INTERRUPT_ID, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT, ucLevelSensitive );
 
@@ -155,6 +173,17 @@ volatile uint32_t ulInterruptStatus;
 	/* Read the interrupt status, then write it back to clear the interrupt. */
 	ulInterruptStatus = XTtcPs_GetInterruptStatus( &xTimerInstance );
 	XTtcPs_ClearInterruptStatus( &xTimerInstance, ulInterruptStatus );
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* Return to one tick per interrupt after an early wake up. */
+		if( xRestoreTickInterval != pdFALSE )
+		{
+			XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick );
+			xRestoreTickInterval = pdFALSE;
+		}
+	}
+	#endif
 	__asm volatile( "DSB SY" );
 	__asm volatile( "ISB SY" );
 }
@@ -182,6 +211,104 @@ const XScuGic_VectorTableEntry *pxVectorEntry;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+/* Returns pdTRUE if the tick interrupt is pending in the GIC.  The TTC
+interrupt status register is clear on read, so the GIC pending state is used to
+find out whether the timer reached its interval without disturbing the tick
+handler. */
+static BaseType_t prvTickInterruptPending( void )
+{
+uint32_t ulPending;
+
+	ulPending = XScuGic_DistReadReg( &xInterruptController, XSCUGIC_PENDING_SET_OFFSET + ( ( configTIMER_INTERRUPT_ID / 32UL ) * 4UL ) );
+	return ( ( ulPending & ( 1UL << ( configTIMER_INTERRUPT_ID % 32UL ) ) ) != 0UL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+uint32_t ulCounter, ulNextInterval, ulCompleteTickPeriods;
+TickType_t xModifiableIdleTime;
+
+	/* The interval register limits how long the timer can measure. */
+	if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+	{
+		xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+	}
+
+	/* Mask IRQ in the core rather than through the GIC priority mask.  WFI
+	still wakes on a pending interrupt, but its handler does not run until the
+	tick count has been corrected below. */
+	portDISABLE_INTERRUPTS();
+
+	/* A task may have been readied, or the tick may have fired, since the
+	idle task decided to sleep. */
+	if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( prvTickInterruptPending() != pdFALSE ) )
+	{
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	/* In interval mode the counter holds the counts elapsed in the current
+	tick period and keeps running, so stretching the interval moves the next
+	interrupt to the expected wake time without losing any counts. */
+	XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick * ( uint32_t ) xExpectedIdleTime );
+
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+	if( xModifiableIdleTime > 0 )
+	{
+		__asm volatile( "DSB SY" );
+		__asm volatile( "WFI" );
+		__asm volatile( "ISB SY" );
+	}
+	configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+	if( prvTickInterruptPending() != pdFALSE )
+	{
+		/* The timer reached the expected wake time and restarted from zero.
+		The pending tick interrupt accounts for the last tick period once
+		interrupts are enabled again. */
+		XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick );
+		if( XTtcPs_GetCounterValue( &xTimerInstance ) >= ulTimerCountsForOneTick )
+		{
+			XTtcPs_ResetCounterValue( &xTimerInstance );
+		}
+		ulCompleteTickPeriods = ( uint32_t ) xExpectedIdleTime - 1UL;
+	}
+	else
+	{
+		/* Something other than the tick woke the core.  Account for the tick
+		periods that completed and let the timer run to the end of the current
+		one, where FreeRTOS_ClearTickInterrupt() restores the one tick
+		interval. */
+		ulCounter = XTtcPs_GetCounterValue( &xTimerInstance );
+		ulCompleteTickPeriods = ulCounter / ulTimerCountsForOneTick;
+		ulNextInterval = ( ulCompleteTickPeriods + 1UL ) * ulTimerCountsForOneTick;
+		XTtcPs_SetInterval( &xTimerInstance, ulNextInterval );
+		xRestoreTickInterval = pdTRUE;
+
+		if( XTtcPs_GetCounterValue( &xTimerInstance ) >= ulNextInterval )
+		{
+			/* The counter passed the boundary before the interval was
+			written, so no interrupt will be generated for it.  Count the
+			period here and restart the timer. */
+			XTtcPs_SetInterval( &xTimerInstance, ulTimerCountsForOneTick );
+			XTtcPs_ResetCounterValue( &xTimerInstance );
+			xRestoreTickInterval = pdFALSE;
+			ulCompleteTickPeriods++;
+		}
+	}
+
+	vTaskStepTick( ( TickType_t ) ulCompleteTickPeriods );
+
+	portENABLE_INTERRUPTS();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /* This version of vApplicationAssert() is declared as a weak symbol to allow it
 to be overridden by a version implemented within the application that is using
 this BSP. */
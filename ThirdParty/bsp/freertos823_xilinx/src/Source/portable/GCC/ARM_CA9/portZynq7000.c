@@ -96,6 +96,13 @@ void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __att
 /* Timer used to generate the tick interrupt. */
 static XScuTimer xTimer;
 XScuGic xInterruptController; 	/* Interrupt controller instance */
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+	/* Timer counts in one tick period, and the largest number of tick periods
+	the 32-bit counter can hold. */
+	static uint32_t ulTimerCountsForOneTick = 0;
+	static TickType_t xMaximumPossibleSuppressedTicks = 0;
+#endif
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_SetupTickInterrupt( void )
@@ -140,6 +147,13 @@ const uint8_t ucRisingEdge = 3;
 	/* Load the timer counter register. */
 	XScuTimer_LoadTimer( &xTimer, XSCUTIMER_CLOCK_HZ / configTICK_RATE_HZ );
 
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		ulTimerCountsForOneTick = XSCUTIMER_CLOCK_HZ / configTICK_RATE_HZ;
+		xMaximumPossibleSuppressedTicks = ( TickType_t ) ( 0xFFFFFFFFUL / ulTimerCountsForOneTick );
+	}
+	#endif
+
 	/* Start the timer counter and then wait for it to timeout a number of
 	times. */
 	XScuTimer_Start( &xTimer );
@@ -178,6 +192,91 @@ const XScuGic_VectorTableEntry *pxVectorEntry;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+uint32_t ulReloadValue, ulCounter, ulElapsed, ulCompleteTickPeriods;
+TickType_t xModifiableIdleTime;
+
+	/* The 32-bit counter limits how long the timer can measure. */
+	if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+	{
+		xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+	}
+
+	/* Mask IRQ in the core rather than through the GIC priority mask.  WFI
+	still wakes on a pending interrupt, but its handler does not run until the
+	tick count has been corrected below. */
+	__asm volatile ( "CPSID i" );
+	__asm volatile ( "DSB" );
+	__asm volatile ( "ISB" );
+
+	/* A task may have been readied, or the tick may have fired, since the
+	idle task decided to sleep. */
+	if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( XScuTimer_IsExpired( &xTimer ) != FALSE ) )
+	{
+		__asm volatile ( "CPSIE i" );
+		__asm volatile ( "DSB" );
+		__asm volatile ( "ISB" );
+		return;
+	}
+
+	/* The counter counts down to zero.  Load it with the counts left in the
+	current tick period plus the whole periods to sleep.  The counts lost while
+	the timer is stopped are ignored. */
+	XScuTimer_Stop( &xTimer );
+	ulReloadValue = XScuTimer_GetCounterValue( &xTimer ) + ( ulTimerCountsForOneTick * ( ( uint32_t ) xExpectedIdleTime - 1UL ) );
+	XScuTimer_LoadTimer( &xTimer, ulReloadValue );
+	XScuTimer_Start( &xTimer );
+
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+	if( xModifiableIdleTime > 0 )
+	{
+		__asm volatile( "DSB" );
+		__asm volatile( "WFI" );
+		__asm volatile( "ISB" );
+	}
+	configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+	XScuTimer_Stop( &xTimer );
+	ulCounter = XScuTimer_GetCounterValue( &xTimer );
+
+	if( XScuTimer_IsExpired( &xTimer ) != FALSE )
+	{
+		/* The timer reached the expected wake time and reloaded with the
+		long value.  The pending tick interrupt accounts for the last tick
+		period once interrupts are enabled again. */
+		ulElapsed = ( ulReloadValue - ulCounter ) % ulTimerCountsForOneTick;
+		ulCompleteTickPeriods = ( uint32_t ) xExpectedIdleTime - 1UL;
+	}
+	else
+	{
+		/* Something other than the tick woke the core.  Count the tick
+		periods that completed, measured from the start of the period the
+		sleep began in. */
+		ulElapsed = ( ulTimerCountsForOneTick * ( uint32_t ) xExpectedIdleTime ) - ulCounter;
+		ulCompleteTickPeriods = ulElapsed / ulTimerCountsForOneTick;
+		ulElapsed %= ulTimerCountsForOneTick;
+	}
+
+	/* Restore the one tick reload value, then start the counter from the
+	point reached in the current tick period. */
+	XScuTimer_LoadTimer( &xTimer, ulTimerCountsForOneTick );
+	XScuTimer_WriteReg( xTimer.Config.BaseAddr, XSCUTIMER_COUNTER_OFFSET, ulTimerCountsForOneTick - ulElapsed );
+	XScuTimer_Start( &xTimer );
+
+	vTaskStepTick( ( TickType_t ) ulCompleteTickPeriods );
+
+	__asm volatile ( "CPSIE i" );
+	__asm volatile ( "DSB" );
+	__asm volatile ( "ISB" );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /* This version of vApplicationAssert() is declared as a weak symbol to allow it
 to be overridden by a version implemented within the application that is using
 this BSP. */
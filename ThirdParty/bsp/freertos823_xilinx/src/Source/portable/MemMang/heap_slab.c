@@ -0,0 +1,991 @@
+/*
+    FreeRTOS V8.2.3 - Copyright (C) 2015 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() that can be used in
+ * place of heap_4.c.  Small requests (up to 256 bytes) are served in constant
+ * time from per size class slab pages.  Larger requests are served in constant
+ * time by a two level segregated fit (TLSF) allocator that coalesces adjacent
+ * free blocks as they are freed.
+ *
+ * The heap array is split in two.  The large object region occupies the
+ * bottom of the array, and slab pages are carved off its top end on demand,
+ * so the boundary between the two (pucSlabBreak) moves down as pages are
+ * needed.  A slab page that becomes empty stays cached in its size class if the
+ * class has no empty page yet, otherwise it goes to a free page pool for reuse
+ * by any size class.  Pool pages at the bottom of the slab area are handed
+ * back to the large object region, moving the boundary up again.  vPortFree()
+ * tells the two regions apart by comparing the address being freed against
+ * the boundary.  If no slab page can be obtained a small request
+ * is served by the large object region instead.
+ *
+ * vPortGetHeapSlabStats(), declared in heap_slab.h, reports per size class
+ * usage, high water marks and large object region fragmentation.
+ *
+ * See heap_4.c for the general purpose first fit alternative, and the memory
+ * management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_slab.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* The size of a slab page.  Must be a power of two.  Each page holds objects of
+a single size class, and the header of the page is found by masking the address
+of any object within it. */
+#ifndef configSLAB_PAGE_SIZE
+	#define heapSLAB_PAGE_SIZE		( ( size_t ) 2048 )
+#else
+	#define heapSLAB_PAGE_SIZE		( ( size_t ) configSLAB_PAGE_SIZE )
+#endif
+
+#define heapSLAB_PAGE_MASK			( heapSLAB_PAGE_SIZE - ( size_t ) 1 )
+
+/* Requests up to this size are served from slab pages. */
+#define heapSLAB_MAX_OBJECT_SIZE	( ( size_t ) 256 )
+
+/* Granularity of the size to class lookup table. */
+#define heapSLAB_GRANULE_SHIFT		( 4 )
+
+/* TLSF geometry.  Each first level range [2^n, 2^(n+1)) is split into
+2^heapTLSF_SL_LOG2 second level lists.  Blocks smaller than
+heapTLSF_SMALL_BLOCK_SIZE share first level list 0, split linearly. */
+#define heapTLSF_SL_LOG2			( 3 )
+#define heapTLSF_SL_COUNT			( 1UL << heapTLSF_SL_LOG2 )
+#define heapTLSF_FL_SHIFT			( 7 )
+#define heapTLSF_SMALL_BLOCK_SIZE	( ( size_t ) 1 << heapTLSF_FL_SHIFT )
+#define heapTLSF_FL_COUNT			( 32 - heapTLSF_FL_SHIFT + 1 )
+
+/* Bit 0 of the xSize member of a TLSF block is set while the block is free.
+Block sizes are always a multiple of portBYTE_ALIGNMENT so the bit is never
+part of the size. */
+#define heapTLSF_BLOCK_FREE			( ( size_t ) 1 )
+
+/* Index of the most significant bit set in a non zero size.  Computed at the
+width of size_t, so sizes are not truncated on 64-bit ports. */
+#define heapSIZE_FLS( x )			( ( uint32_t ) ( ( sizeof( unsigned long ) * 8U ) - 1U ) - ( uint32_t ) __builtin_clzl( ( unsigned long ) ( x ) ) )
+
+/* usClass of a slab page that is in the free page pool. */
+#define heapSLAB_FREE_PAGE			( ( uint16_t ) 0xFFFF )
+
+#define heapALIGN_UP( x )			( ( ( x ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Header of a block in the large object region.  Only pxPrevPhys and xSize
+are kept while the block is allocated - the free list links overlay the start
+of the memory returned to the application. */
+typedef struct TLSF_BLOCK
+{
+	struct TLSF_BLOCK *pxPrevPhys;	/*<< The block physically before this one. */
+	size_t xSize;					/*<< Size of the block including this header, plus the free flag. */
+	struct TLSF_BLOCK *pxNextFree;	/*<< The next block in the same free list. */
+	struct TLSF_BLOCK *pxPrevFree;	/*<< The previous block in the same free list. */
+} TlsfBlock_t;
+
+/* Header placed at the start of every slab page. */
+typedef struct SLAB_PAGE
+{
+	struct SLAB_PAGE *pxNext;	/*<< Next page in the class partial list, or in the free page pool. */
+	struct SLAB_PAGE *pxPrev;	/*<< Previous page in the class partial list, or in the free page pool. */
+	void *pvFreeList;			/*<< Objects that have been freed back to this page. */
+	uint8_t *pucBump;			/*<< First object that has never been handed out. */
+	uint16_t usClass;			/*<< Index into xSlabClasses[], or heapSLAB_FREE_PAGE. */
+	uint16_t usFree;			/*<< Number of objects not allocated. */
+	uint16_t usTotal;			/*<< Number of objects the page holds. */
+} SlabPage_t;
+
+/* A size class.  Only pages with at least one free object are linked into
+pxPartial, so allocation never has to search.  pxEmpty caches one empty page,
+so a class that repeatedly allocates and frees its last object does not move a
+page in and out of the pool every time. */
+typedef struct SLAB_CLASS
+{
+	SlabPage_t *pxPartial;
+	SlabPage_t *pxEmpty;
+	size_t xObjectSize;
+	size_t xObjectsInUse;
+	size_t xMaxObjectsInUse;
+	size_t xSlabs;
+} SlabClass_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Allocate and free objects of size class xClass.  prvSlabAlloc() returns
+ * NULL if the class has no free object and no slab page can be obtained.
+ */
+static void *prvSlabAlloc( size_t xClass );
+static void prvSlabFree( void *pv );
+
+/*
+ * Take a page from the free page pool or, failing that, carve one from the
+ * top of the large object region.
+ */
+static SlabPage_t *prvGetPage( void );
+
+/*
+ * Add an empty page to the free page pool, then hand pool pages at the bottom
+ * of the slab area back to the large object region.
+ */
+static void prvPutPage( SlabPage_t *pxPage );
+
+/*
+ * Allocate and free blocks from the large object region.
+ */
+static void *prvTlsfAlloc( size_t xWantedSize );
+static void prvTlsfFree( void *pv );
+
+/*
+ * Link and unlink a free block to and from the free list matching its size.
+ */
+static void prvTlsfInsert( TlsfBlock_t *pxBlock );
+static void prvTlsfRemove( TlsfBlock_t *pxBlock );
+
+/*
+ * Map a block size onto its first and second level list indexes.
+ */
+static void prvTlsfMapping( size_t xSize, uint32_t *pulFl, uint32_t *pulSl );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of a TLSF block header that is kept while the block is
+allocated, and the smallest block that can hold the whole header when free. */
+static const size_t xTlsfHeaderSize = heapALIGN_UP( 2 * sizeof( void * ) );
+static const size_t xTlsfMinBlockSize = heapALIGN_UP( sizeof( TlsfBlock_t ) );
+
+/* Offset of the first object within a slab page. */
+static const size_t xSlabHeaderSize = heapALIGN_UP( sizeof( SlabPage_t ) );
+
+/* Object size of every class.  All are multiples of 16 so objects stay aligned
+for every supported portBYTE_ALIGNMENT. */
+static const uint16_t usSlabClassSizes[ heapSLAB_NUM_CLASSES ] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+/* Maps ( xWantedSize + 15 ) / 16 onto a size class. */
+static const uint8_t ucSlabSizeToClass[ ( heapSLAB_MAX_OBJECT_SIZE >> heapSLAB_GRANULE_SHIFT ) + 1 ] =
+{
+	0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7
+};
+
+static SlabClass_t xSlabClasses[ heapSLAB_NUM_CLASSES ];
+
+/* The free page pool. */
+static SlabPage_t *pxFreePages = NULL;
+static size_t xFreePageCount = 0U;
+
+/* Everything at or above pucSlabBreak belongs to slab pages, everything below
+it to the large object region.  pucHeapTop is the page aligned end of the
+heap. */
+static uint8_t *pucSlabBreak = NULL;
+static uint8_t *pucHeapTop = NULL;
+
+/* The zero sized, permanently allocated block that terminates the large object
+region.  It sits immediately below pucSlabBreak. */
+static TlsfBlock_t *pxTlsfSentinel = NULL;
+
+/* TLSF free list heads and the bitmaps showing which of them are not empty. */
+static uint32_t ulTlsfFlBitmap = 0U;
+static uint32_t ulTlsfSlBitmap[ heapTLSF_FL_COUNT ];
+static TlsfBlock_t *pxTlsfFreeLists[ heapTLSF_FL_COUNT ][ heapTLSF_SL_COUNT ];
+static size_t xTlsfFreeBytes = 0U;
+
+/* Keeps track of the number of free bytes remaining, over both regions. */
+static size_t xTotalHeapBytes = 0U;
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xSmallFallbacks = 0U;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( pxTlsfSentinel == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xWantedSize > 0 )
+		{
+			if( xWantedSize <= heapSLAB_MAX_OBJECT_SIZE )
+			{
+				pvReturn = prvSlabAlloc( ( size_t ) ucSlabSizeToClass[ ( xWantedSize + ( ( ( size_t ) 1 << heapSLAB_GRANULE_SHIFT ) - 1 ) ) >> heapSLAB_GRANULE_SHIFT ] );
+
+				if( pvReturn == NULL )
+				{
+					/* No slab page could be obtained, so fall back to the large
+					object region. */
+					pvReturn = prvTlsfAlloc( xWantedSize );
+
+					if( pvReturn != NULL )
+					{
+						xSmallFallbacks++;
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pvReturn = prvTlsfAlloc( xWantedSize );
+			}
+
+			if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+			{
+				xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+	if( pv != NULL )
+	{
+		configASSERT( pxTlsfSentinel != NULL );
+		configASSERT( ( ( uint8_t * ) pv >= ucHeap ) && ( ( uint8_t * ) pv < pucHeapTop ) );
+
+		vTaskSuspendAll();
+		{
+			traceFREE( pv, 0 );
+
+			if( ( uint8_t * ) pv >= pucSlabBreak )
+			{
+				prvSlabFree( pv );
+			}
+			else
+			{
+				prvTlsfFree( pv );
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapSlabStats( HeapSlabStats_t *pxStats )
+{
+size_t xClass;
+uint32_t ulFl, ulSl;
+TlsfBlock_t *pxBlock;
+size_t xLargest = 0U;
+
+	configASSERT( pxStats != NULL );
+
+	vTaskSuspendAll();
+	{
+		if( pxTlsfSentinel == NULL )
+		{
+			prvHeapInit();
+		}
+
+		for( xClass = 0; xClass < heapSLAB_NUM_CLASSES; xClass++ )
+		{
+			pxStats->xClass[ xClass ].xObjectSize = xSlabClasses[ xClass ].xObjectSize;
+			pxStats->xClass[ xClass ].xObjectsInUse = xSlabClasses[ xClass ].xObjectsInUse;
+			pxStats->xClass[ xClass ].xMaxObjectsInUse = xSlabClasses[ xClass ].xMaxObjectsInUse;
+			pxStats->xClass[ xClass ].xSlabs = xSlabClasses[ xClass ].xSlabs;
+		}
+
+		/* The largest free block is in the highest non empty list.  Blocks
+		within a list are not sorted, so walk that one list. */
+		if( ulTlsfFlBitmap != 0U )
+		{
+			ulFl = 31U - ( uint32_t ) __builtin_clz( ulTlsfFlBitmap );
+			ulSl = 31U - ( uint32_t ) __builtin_clz( ulTlsfSlBitmap[ ulFl ] );
+
+			for( pxBlock = pxTlsfFreeLists[ ulFl ][ ulSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFree )
+			{
+				if( ( pxBlock->xSize & ~heapTLSF_BLOCK_FREE ) > xLargest )
+				{
+					xLargest = pxBlock->xSize & ~heapTLSF_BLOCK_FREE;
+				}
+			}
+		}
+
+		pxStats->xTotalHeapSize = xTotalHeapBytes;
+		pxStats->xSlabAreaSize = ( size_t ) ( pucHeapTop - pucSlabBreak );
+		pxStats->xFreePages = xFreePageCount;
+		pxStats->xLargeFreeBytes = xTlsfFreeBytes;
+		pxStats->xLargestFreeBlock = xLargest;
+		pxStats->xFreeBytesRemaining = xFreeBytesRemaining;
+		pxStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		pxStats->xSmallFallbacks = xSmallFallbacks;
+
+		if( xTlsfFreeBytes != 0U )
+		{
+			pxStats->xFragmentationPercent = 100U - ( ( xLargest * 100U ) / xTlsfFreeBytes );
+		}
+		else
+		{
+			pxStats->xFragmentationPercent = 0U;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TlsfBlock_t *pxFirstBlock;
+uint8_t *pucAlignedHeap;
+size_t xClass;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	pucAlignedHeap = ( uint8_t * ) heapALIGN_UP( ( size_t ) ucHeap );
+
+	/* Slab pages must start on a page boundary, so the top of the heap is
+	rounded down to one.  Initially the whole heap is large object region. */
+	pucHeapTop = ( uint8_t * ) ( ( ( size_t ) &ucHeap[ configTOTAL_HEAP_SIZE ] ) & ~heapSLAB_PAGE_MASK );
+	pucSlabBreak = pucHeapTop;
+
+	configASSERT( ( heapSLAB_PAGE_SIZE & heapSLAB_PAGE_MASK ) == 0 );
+	configASSERT( pucSlabBreak > ( pucAlignedHeap + xTlsfHeaderSize + xTlsfMinBlockSize ) );
+
+	/* The TLSF lists and bitmaps cover block sizes below 4GB. */
+	configASSERT( ( ( uint64_t ) ( pucSlabBreak - pucAlignedHeap ) >> 32 ) == 0U );
+
+	/* One free block covering the region, terminated by the sentinel. */
+	pxTlsfSentinel = ( void * ) ( pucSlabBreak - xTlsfHeaderSize );
+	pxFirstBlock = ( void * ) pucAlignedHeap;
+	pxFirstBlock->pxPrevPhys = NULL;
+	pxFirstBlock->xSize = ( size_t ) ( ( uint8_t * ) pxTlsfSentinel - pucAlignedHeap );
+	pxTlsfSentinel->pxPrevPhys = pxFirstBlock;
+	pxTlsfSentinel->xSize = 0U;
+
+	xTotalHeapBytes = pxFirstBlock->xSize;
+	xTlsfFreeBytes = pxFirstBlock->xSize;
+	xFreeBytesRemaining = pxFirstBlock->xSize;
+	xMinimumEverFreeBytesRemaining = pxFirstBlock->xSize;
+
+	prvTlsfInsert( pxFirstBlock );
+
+	for( xClass = 0; xClass < heapSLAB_NUM_CLASSES; xClass++ )
+	{
+		xSlabClasses[ xClass ].pxPartial = NULL;
+		xSlabClasses[ xClass ].pxEmpty = NULL;
+		xSlabClasses[ xClass ].xObjectSize = ( size_t ) usSlabClassSizes[ xClass ];
+	}
+}
+/*-----------------------------------------------------------*/
+
+static SlabPage_t *prvGetPage( void )
+{
+SlabPage_t *pxPage = NULL;
+TlsfBlock_t *pxLast;
+size_t xLastSize;
+
+	if( pxFreePages != NULL )
+	{
+		pxPage = pxFreePages;
+		pxFreePages = pxPage->pxNext;
+
+		if( pxFreePages != NULL )
+		{
+			pxFreePages->pxPrev = NULL;
+		}
+
+		xFreePageCount--;
+	}
+	else
+	{
+		/* Carve a page off the top of the large object region.  This is only
+		possible when the block below the sentinel is free and stays at least
+		a minimum sized block once the page is removed from it. */
+		pxLast = pxTlsfSentinel->pxPrevPhys;
+		xLastSize = pxLast->xSize & ~heapTLSF_BLOCK_FREE;
+
+		if( ( ( pxLast->xSize & heapTLSF_BLOCK_FREE ) != 0 ) && ( xLastSize >= ( heapSLAB_PAGE_SIZE + xTlsfMinBlockSize ) ) )
+		{
+			prvTlsfRemove( pxLast );
+			pxLast->xSize = ( xLastSize - heapSLAB_PAGE_SIZE ) | heapTLSF_BLOCK_FREE;
+			prvTlsfInsert( pxLast );
+			xTlsfFreeBytes -= heapSLAB_PAGE_SIZE;
+
+			pucSlabBreak -= heapSLAB_PAGE_SIZE;
+			pxTlsfSentinel = ( void * ) ( pucSlabBreak - xTlsfHeaderSize );
+			pxTlsfSentinel->pxPrevPhys = pxLast;
+			pxTlsfSentinel->xSize = 0U;
+
+			pxPage = ( void * ) pucSlabBreak;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxPage;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPutPage( SlabPage_t *pxPage )
+{
+TlsfBlock_t *pxBlock;
+
+	pxPage->usClass = heapSLAB_FREE_PAGE;
+	pxPage->pxPrev = NULL;
+	pxPage->pxNext = pxFreePages;
+
+	if( pxFreePages != NULL )
+	{
+		pxFreePages->pxPrev = pxPage;
+	}
+
+	pxFreePages = pxPage;
+	xFreePageCount++;
+
+	/* The slab area has to stay contiguous, so only the page at the boundary
+	can go back to the large object region.  Releasing it may expose another
+	pool page at the new boundary. */
+	while( pucSlabBreak < pucHeapTop )
+	{
+		pxPage = ( void * ) pucSlabBreak;
+
+		if( pxPage->usClass != heapSLAB_FREE_PAGE )
+		{
+			break;
+		}
+
+		if( pxPage->pxPrev != NULL )
+		{
+			pxPage->pxPrev->pxNext = pxPage->pxNext;
+		}
+		else
+		{
+			pxFreePages = pxPage->pxNext;
+		}
+
+		if( pxPage->pxNext != NULL )
+		{
+			pxPage->pxNext->pxPrev = pxPage->pxPrev;
+		}
+
+		xFreePageCount--;
+
+		/* The sentinel becomes the header of a block spanning the page, and a
+		new sentinel is placed at the end of the page. */
+		pxBlock = pxTlsfSentinel;
+		pxBlock->xSize = heapSLAB_PAGE_SIZE;
+		pucSlabBreak += heapSLAB_PAGE_SIZE;
+		pxTlsfSentinel = ( void * ) ( pucSlabBreak - xTlsfHeaderSize );
+		pxTlsfSentinel->pxPrevPhys = pxBlock;
+		pxTlsfSentinel->xSize = 0U;
+
+		/* Free the block into the large object region so it merges with its
+		neighbour.  A pool page is already counted as free memory. */
+		xFreeBytesRemaining -= heapSLAB_PAGE_SIZE;
+		prvTlsfFree( ( ( uint8_t * ) pxBlock ) + xTlsfHeaderSize );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvSlabAlloc( size_t xClass )
+{
+SlabClass_t *pxClass = &xSlabClasses[ xClass ];
+SlabPage_t *pxPage = pxClass->pxPartial;
+void *pvReturn;
+
+	if( ( pxPage == NULL ) && ( pxClass->pxEmpty != NULL ) )
+	{
+		/* Reuse the cached empty page, which is still set up for this
+		class. */
+		pxPage = pxClass->pxEmpty;
+		pxClass->pxEmpty = NULL;
+		pxPage->pxNext = NULL;
+		pxPage->pxPrev = NULL;
+		pxClass->pxPartial = pxPage;
+	}
+	else if( pxPage == NULL )
+	{
+		pxPage = prvGetPage();
+
+		if( pxPage == NULL )
+		{
+			return NULL;
+		}
+
+		pxPage->pxNext = NULL;
+		pxPage->pxPrev = NULL;
+		pxPage->pvFreeList = NULL;
+		pxPage->pucBump = ( ( uint8_t * ) pxPage ) + xSlabHeaderSize;
+		pxPage->usClass = ( uint16_t ) xClass;
+		pxPage->usTotal = ( uint16_t ) ( ( heapSLAB_PAGE_SIZE - xSlabHeaderSize ) / pxClass->xObjectSize );
+		pxPage->usFree = pxPage->usTotal;
+		pxClass->pxPartial = pxPage;
+		pxClass->xSlabs++;
+
+		/* The page header and the unusable tail are no longer free memory. */
+		xFreeBytesRemaining -= heapSLAB_PAGE_SIZE - ( ( size_t ) pxPage->usTotal * pxClass->xObjectSize );
+	}
+
+	/* Prefer recycled objects so a page touches as little fresh memory as
+	possible. */
+	if( pxPage->pvFreeList != NULL )
+	{
+		pvReturn = pxPage->pvFreeList;
+		pxPage->pvFreeList = *( ( void ** ) pvReturn );
+	}
+	else
+	{
+		pvReturn = pxPage->pucBump;
+		pxPage->pucBump += pxClass->xObjectSize;
+	}
+
+	pxPage->usFree--;
+
+	if( pxPage->usFree == 0U )
+	{
+		/* A full page leaves the partial list until an object is freed. */
+		pxClass->pxPartial = pxPage->pxNext;
+
+		if( pxPage->pxNext != NULL )
+		{
+			pxPage->pxNext->pxPrev = NULL;
+		}
+
+		pxPage->pxNext = NULL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxClass->xObjectsInUse++;
+
+	if( pxClass->xObjectsInUse > pxClass->xMaxObjectsInUse )
+	{
+		pxClass->xMaxObjectsInUse = pxClass->xObjectsInUse;
+	}
+
+	xFreeBytesRemaining -= pxClass->xObjectSize;
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlabFree( void *pv )
+{
+SlabPage_t *pxPage = ( void * ) ( ( ( size_t ) pv ) & ~heapSLAB_PAGE_MASK );
+SlabClass_t *pxClass;
+
+	configASSERT( pxPage->usClass < heapSLAB_NUM_CLASSES );
+	configASSERT( pxPage->usFree < pxPage->usTotal );
+
+	pxClass = &xSlabClasses[ pxPage->usClass ];
+
+	configASSERT( ( ( ( size_t ) pv - ( size_t ) pxPage - xSlabHeaderSize ) % pxClass->xObjectSize ) == 0 );
+
+	*( ( void ** ) pv ) = pxPage->pvFreeList;
+	pxPage->pvFreeList = pv;
+	pxPage->usFree++;
+	pxClass->xObjectsInUse--;
+	xFreeBytesRemaining += pxClass->xObjectSize;
+
+	if( pxPage->usFree == 1U )
+	{
+		/* The page was full, so it is not on the partial list yet. */
+		pxPage->pxPrev = NULL;
+		pxPage->pxNext = pxClass->pxPartial;
+
+		if( pxClass->pxPartial != NULL )
+		{
+			pxClass->pxPartial->pxPrev = pxPage;
+		}
+
+		pxClass->pxPartial = pxPage;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxPage->usFree == pxPage->usTotal )
+	{
+		/* The page is empty.  Keep it for the class if the class has no
+		empty page yet, otherwise return it to the pool so any class, or the
+		large object region, can use it. */
+		if( pxPage->pxPrev != NULL )
+		{
+			pxPage->pxPrev->pxNext = pxPage->pxNext;
+		}
+		else
+		{
+			pxClass->pxPartial = pxPage->pxNext;
+		}
+
+		if( pxPage->pxNext != NULL )
+		{
+			pxPage->pxNext->pxPrev = pxPage->pxPrev;
+		}
+
+		if( pxClass->pxEmpty == NULL )
+		{
+			pxClass->pxEmpty = pxPage;
+		}
+		else
+		{
+			pxClass->xSlabs--;
+			xFreeBytesRemaining += heapSLAB_PAGE_SIZE - ( ( size_t ) pxPage->usTotal * pxClass->xObjectSize );
+			prvPutPage( pxPage );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTlsfMapping( size_t xSize, uint32_t *pulFl, uint32_t *pulSl )
+{
+uint32_t ulFl;
+
+	if( xSize < heapTLSF_SMALL_BLOCK_SIZE )
+	{
+		*pulFl = 0U;
+		*pulSl = ( uint32_t ) ( xSize / ( heapTLSF_SMALL_BLOCK_SIZE / heapTLSF_SL_COUNT ) );
+	}
+	else
+	{
+		ulFl = heapSIZE_FLS( xSize );
+		*pulSl = ( uint32_t ) ( xSize >> ( ulFl - heapTLSF_SL_LOG2 ) ) ^ heapTLSF_SL_COUNT;
+		*pulFl = ulFl - ( heapTLSF_FL_SHIFT - 1U );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTlsfInsert( TlsfBlock_t *pxBlock )
+{
+uint32_t ulFl, ulSl;
+
+	pxBlock->xSize |= heapTLSF_BLOCK_FREE;
+	prvTlsfMapping( pxBlock->xSize & ~heapTLSF_BLOCK_FREE, &ulFl, &ulSl );
+
+	pxBlock->pxPrevFree = NULL;
+	pxBlock->pxNextFree = pxTlsfFreeLists[ ulFl ][ ulSl ];
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPrevFree = pxBlock;
+	}
+
+	pxTlsfFreeLists[ ulFl ][ ulSl ] = pxBlock;
+	ulTlsfFlBitmap |= 1UL << ulFl;
+	ulTlsfSlBitmap[ ulFl ] |= 1UL << ulSl;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTlsfRemove( TlsfBlock_t *pxBlock )
+{
+uint32_t ulFl, ulSl;
+
+	prvTlsfMapping( pxBlock->xSize & ~heapTLSF_BLOCK_FREE, &ulFl, &ulSl );
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPrevFree = pxBlock->pxPrevFree;
+	}
+
+	if( pxBlock->pxPrevFree != NULL )
+	{
+		pxBlock->pxPrevFree->pxNextFree = pxBlock->pxNextFree;
+	}
+	else
+	{
+		pxTlsfFreeLists[ ulFl ][ ulSl ] = pxBlock->pxNextFree;
+
+		if( pxBlock->pxNextFree == NULL )
+		{
+			ulTlsfSlBitmap[ ulFl ] &= ~( 1UL << ulSl );
+
+			if( ulTlsfSlBitmap[ ulFl ] == 0U )
+			{
+				ulTlsfFlBitmap &= ~( 1UL << ulFl );
+			}
+		}
+	}
+
+	pxBlock->xSize &= ~heapTLSF_BLOCK_FREE;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTlsfAlloc( size_t xWantedSize )
+{
+TlsfBlock_t *pxBlock, *pxNewBlock, *pxNextPhys;
+uint32_t ulFl, ulSl, ulMap;
+size_t xBlockSize, xSearchSize;
+
+	/* Guard against the size wrapping when the header is added. */
+	if( xWantedSize > ( xTotalHeapBytes - xTlsfHeaderSize ) )
+	{
+		return NULL;
+	}
+
+	xBlockSize = heapALIGN_UP( xWantedSize + xTlsfHeaderSize );
+
+	if( xBlockSize < xTlsfMinBlockSize )
+	{
+		xBlockSize = xTlsfMinBlockSize;
+	}
+
+	if( xBlockSize > xTlsfFreeBytes )
+	{
+		return NULL;
+	}
+
+	/* Round the size up to the next list boundary, so that any block in the
+	list found is large enough and no list has to be searched. */
+	xSearchSize = xBlockSize;
+
+	if( xSearchSize >= heapTLSF_SMALL_BLOCK_SIZE )
+	{
+		xSearchSize += ( ( size_t ) 1 << ( heapSIZE_FLS( xSearchSize ) - heapTLSF_SL_LOG2 ) ) - 1U;
+	}
+	else
+	{
+		xSearchSize += ( heapTLSF_SMALL_BLOCK_SIZE / heapTLSF_SL_COUNT ) - 1U;
+	}
+
+	prvTlsfMapping( xSearchSize, &ulFl, &ulSl );
+
+	if( ulFl >= heapTLSF_FL_COUNT )
+	{
+		return NULL;
+	}
+
+	ulMap = ( ulSl < heapTLSF_SL_COUNT ) ? ( ulTlsfSlBitmap[ ulFl ] & ( ~0UL << ulSl ) ) : 0U;
+
+	if( ulMap == 0U )
+	{
+		ulMap = ( ulFl + 1U < heapTLSF_FL_COUNT ) ? ( ulTlsfFlBitmap & ( ~0UL << ( ulFl + 1U ) ) ) : 0U;
+
+		if( ulMap == 0U )
+		{
+			return NULL;
+		}
+
+		ulFl = ( uint32_t ) __builtin_ctz( ulMap );
+		ulMap = ulTlsfSlBitmap[ ulFl ];
+	}
+
+	ulSl = ( uint32_t ) __builtin_ctz( ulMap );
+	pxBlock = pxTlsfFreeLists[ ulFl ][ ulSl ];
+	configASSERT( pxBlock != NULL );
+
+	prvTlsfRemove( pxBlock );
+
+	/* Split off the tail if it is large enough to be a block by itself. */
+	if( ( pxBlock->xSize - xBlockSize ) >= xTlsfMinBlockSize )
+	{
+		pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+		pxNewBlock->xSize = pxBlock->xSize - xBlockSize;
+		pxNewBlock->pxPrevPhys = pxBlock;
+		pxNextPhys = ( void * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xSize );
+		pxNextPhys->pxPrevPhys = pxNewBlock;
+		pxBlock->xSize = xBlockSize;
+		prvTlsfInsert( pxNewBlock );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xTlsfFreeBytes -= pxBlock->xSize;
+	xFreeBytesRemaining -= pxBlock->xSize;
+
+	return ( void * ) ( ( ( uint8_t * ) pxBlock ) + xTlsfHeaderSize );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTlsfFree( void *pv )
+{
+TlsfBlock_t *pxBlock = ( void * ) ( ( ( uint8_t * ) pv ) - xTlsfHeaderSize );
+TlsfBlock_t *pxNeighbour;
+
+	/* Check the block is actually allocated. */
+	configASSERT( ( pxBlock->xSize & heapTLSF_BLOCK_FREE ) == 0 );
+	configASSERT( pxBlock->xSize >= xTlsfMinBlockSize );
+
+	xTlsfFreeBytes += pxBlock->xSize;
+	xFreeBytesRemaining += pxBlock->xSize;
+
+	/* Merge with the physically previous block if it is free. */
+	pxNeighbour = pxBlock->pxPrevPhys;
+
+	if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xSize & heapTLSF_BLOCK_FREE ) != 0 ) )
+	{
+		prvTlsfRemove( pxNeighbour );
+		pxNeighbour->xSize += pxBlock->xSize;
+		pxBlock = pxNeighbour;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Merge with the physically next block if it is free.  The sentinel is
+	never free so this cannot run off the end of the region. */
+	pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xSize );
+
+	if( ( pxNeighbour->xSize & heapTLSF_BLOCK_FREE ) != 0 )
+	{
+		prvTlsfRemove( pxNeighbour );
+		pxBlock->xSize += pxNeighbour->xSize;
+		pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xSize );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxNeighbour->pxPrevPhys = pxBlock;
+	prvTlsfInsert( pxBlock );
+}
+
@@ -0,0 +1,124 @@
+/*
+    FreeRTOS V8.2.3 - Copyright (C) 2015 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Statistics interface of heap_slab.c.  Include FreeRTOS.h before this file.
+ */
+
+#ifndef HEAP_SLAB_H
+#define HEAP_SLAB_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include heap_slab.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of small object size classes served from slab pages. */
+#define heapSLAB_NUM_CLASSES		( 8 )
+
+/* Usage of a single size class. */
+typedef struct xHEAP_SLAB_CLASS_STATS
+{
+	size_t xObjectSize;			/*<< The size of every object in the class. */
+	size_t xObjectsInUse;		/*<< The number of objects currently allocated. */
+	size_t xMaxObjectsInUse;	/*<< The highest value xObjectsInUse has reached. */
+	size_t xSlabs;				/*<< The number of slab pages owned by the class. */
+} HeapSlabClassStats_t;
+
+/* Snapshot of the whole heap, as filled in by vPortGetHeapSlabStats(). */
+typedef struct xHEAP_SLAB_STATS
+{
+	HeapSlabClassStats_t xClass[ heapSLAB_NUM_CLASSES ];
+	size_t xTotalHeapSize;					/*<< Bytes managed by the allocator. */
+	size_t xSlabAreaSize;					/*<< Bytes carved out as slab pages. */
+	size_t xFreePages;						/*<< Slab pages not owned by any class. */
+	size_t xLargeFreeBytes;					/*<< Free bytes in the large object region. */
+	size_t xLargestFreeBlock;				/*<< Largest free block in the large object region. */
+	size_t xFreeBytesRemaining;				/*<< As returned by xPortGetFreeHeapSize(). */
+	size_t xMinimumEverFreeBytesRemaining;	/*<< As returned by xPortGetMinimumEverFreeHeapSize(). */
+	size_t xFragmentationPercent;			/*<< 0 when the large object region is one block. */
+	size_t xSmallFallbacks;					/*<< Small requests served by the large object region. */
+} HeapSlabStats_t;
+
+/*
+ * Fill *pxStats with the current state of the heap.  The heap is walked with
+ * the scheduler suspended, so do not call this from an interrupt.
+ */
+void vPortGetHeapSlabStats( HeapSlabStats_t *pxStats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_SLAB_H */
+
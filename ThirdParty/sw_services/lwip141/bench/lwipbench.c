@@ -0,0 +1,877 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+/*
+ * lwipbench.c
+ *
+ * Host benchmark for the lwIP 1.4.1 port.  Two copies of the stack, each in
+ * its own process with its own simnetif, are connected back to back by a
+ * SOCK_SEQPACKET socket pair standing in for the Ethernet link:
+ *
+ *	client 192.168.1.1  <--- wire --->  server 192.168.1.10
+ *
+ * Workloads (-t):
+ *	tcp	client streams to a discard server for -d seconds
+ *	udp	client sends -s byte datagrams as fast as the TX ring allows
+ *	rr	client sends -s byte requests to an echo server, one at a time
+ *
+ * Each side reports frames per second, application goodput, and the cycles
+ * it spent per frame in lwIP and the netif, excluding time on the wire.
+ * Goodput counts payload bytes in both directions, so for rr a request and
+ * its echo count twice the request size on either side.
+ *
+ * -w file.pcap records every frame the client sees.  -r file.pcap replays
+ * the frames addressed to the server from such a capture into a single
+ * server stack, looping over them for -d seconds, for measuring the receive
+ * path alone.  Pass the -t the capture was recorded with so the server
+ * listens on the right port; replayed TCP segments do not match a live
+ * connection and are answered with resets, so udp captures are the ones
+ * that exercise the full receive path.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "lwip/init.h"
+#include "lwip/netif.h"
+#include "lwip/tcp.h"
+#include "lwip/tcp_impl.h"
+#include "lwip/udp.h"
+#include "lwip/ip_frag.h"
+#include "lwip/stats.h"
+#include "netif/etharp.h"
+
+#include "simnetif.h"
+
+#define BENCH_TCP_PORT	5001
+#define BENCH_UDP_PORT	5002
+#define BENCH_RR_PORT	5003
+#define BENCH_MAX_SIZE	1458
+
+/* time the client keeps polling after it stops, to let the FIN go out */
+#define BENCH_DRAIN_NS	200000000ULL
+
+/* longest sleep on an idle wire, so the stack timers still run */
+#define BENCH_IDLE_MS	1
+
+#define NS_PER_SEC	1000000000ULL
+
+enum bench_mode { MODE_TCP, MODE_UDP, MODE_RR };
+
+struct bench_host {
+	const char *name;
+	u8_t mac[6];
+	u8_t ip[4];
+};
+
+static const struct bench_host client_host = {
+	"client", { 0x00, 0x0a, 0x35, 0x00, 0x01, 0x01 }, { 192, 168, 1, 1 }
+};
+static const struct bench_host server_host = {
+	"server", { 0x00, 0x0a, 0x35, 0x00, 0x01, 0x10 }, { 192, 168, 1, 10 }
+};
+
+/* counters of one measurement window */
+struct bench_counters {
+	u64_t busy_cycles;
+	u64_t wire_cycles;
+	u64_t tx_frames;
+	u64_t rx_frames;
+};
+
+static struct {
+	enum bench_mode mode;
+	u64_t duration_ns;
+	u16_t size;
+	const struct bench_host *host;
+	const struct bench_host *peer;
+
+	int started;
+	int stopping;
+	int failed;
+	u64_t start_ns;
+	u64_t last_ns;
+	u64_t bytes;	/* payload moved, both directions, see RR_BYTES */
+	u64_t msgs;
+
+	/* rr */
+	u64_t rr_sent_ns;
+	u64_t rr_lat_ns;
+	u32_t rr_pending;
+
+	struct tcp_pcb *pcb;
+	struct udp_pcb *upcb;
+	struct bench_counters base;
+} app;
+
+static struct netif netif;
+static simnetif_s simnetif;
+static u64_t busy_cycles;
+
+static int wire_fd = -1;
+static int wire_eof;
+static FILE *pcap_out;
+
+static u8_t bench_buf[65536];
+
+static u64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64_t)ts.tv_sec * NS_PER_SEC + ts.tv_nsec;
+}
+
+/*
+ * pcap
+ */
+struct pcap_file_hdr {
+	u32_t magic;
+	u16_t version_major;
+	u16_t version_minor;
+	s32_t thiszone;
+	u32_t sigfigs;
+	u32_t snaplen;
+	u32_t linktype;
+};
+
+struct pcap_rec_hdr {
+	u32_t ts_sec;
+	u32_t ts_usec;
+	u32_t incl_len;
+	u32_t orig_len;
+};
+
+#define PCAP_MAGIC		0xa1b2c3d4
+#define PCAP_LINKTYPE_ETHERNET	1
+
+static FILE *pcap_create(const char *fname)
+{
+	struct pcap_file_hdr hdr = { PCAP_MAGIC, 2, 4, 0, 0, 65535, PCAP_LINKTYPE_ETHERNET };
+	FILE *f = fopen(fname, "wb");
+
+	if (f == NULL || fwrite(&hdr, sizeof hdr, 1, f) != 1) {
+		perror(fname);
+		exit(1);
+	}
+	return f;
+}
+
+static void pcap_write(FILE *f, const u8_t *frame, u16_t len)
+{
+	struct timespec ts;
+	struct pcap_rec_hdr rec;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	rec.ts_sec = ts.tv_sec;
+	rec.ts_usec = ts.tv_nsec / 1000;
+	rec.incl_len = rec.orig_len = len;
+	fwrite(&rec, sizeof rec, 1, f);
+	fwrite(frame, len, 1, f);
+}
+
+struct pcap_frame {
+	u16_t len;
+	u8_t *data;
+};
+
+/* Load the frames of a capture that are addressed to host. */
+static struct pcap_frame *pcap_load(const char *fname, const struct bench_host *host, u32_t *count)
+{
+	struct pcap_file_hdr hdr;
+	struct pcap_rec_hdr rec;
+	struct pcap_frame *frames = NULL;
+	u32_t n = 0, max = 0;
+	u8_t *data;
+	FILE *f = fopen(fname, "rb");
+
+	if (f == NULL || fread(&hdr, sizeof hdr, 1, f) != 1) {
+		perror(fname);
+		exit(1);
+	}
+	if (hdr.magic != PCAP_MAGIC || hdr.linktype != PCAP_LINKTYPE_ETHERNET) {
+		fprintf(stderr, "%s: not a native byte order Ethernet pcap file\n", fname);
+		exit(1);
+	}
+
+	while (fread(&rec, sizeof rec, 1, f) == 1) {
+		if (rec.incl_len > 65535)
+			break;
+		data = malloc(rec.incl_len);
+		if (data == NULL || fread(data, rec.incl_len, 1, f) != 1) {
+			free(data);
+			break;
+		}
+		if (rec.incl_len < 14 || rec.incl_len > SIMNETIF_MAX_FRAME_SIZE ||
+		    (memcmp(data, host->mac, 6) != 0 && !(data[0] & 1))) {
+			free(data);
+			continue;
+		}
+		if (n == max) {
+			max = max ? max * 2 : 1024;
+			frames = realloc(frames, max * sizeof *frames);
+			if (frames == NULL) {
+				perror("realloc");
+				exit(1);
+			}
+		}
+		frames[n].len = rec.incl_len;
+		frames[n].data = data;
+		n++;
+	}
+	fclose(f);
+
+	*count = n;
+	return frames;
+}
+
+/*
+ * wire
+ */
+static int wire_xmit(void *arg, const u8_t *frame, u16_t len)
+{
+	(void)arg;
+
+	if (wire_fd >= 0 && send(wire_fd, frame, len, MSG_DONTWAIT) < 0) {
+		/* link busy, the MAC keeps the frame */
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+			return -1;
+	}
+	if (pcap_out)
+		pcap_write(pcap_out, frame, len);
+	return 0;
+}
+
+/* Move frames from the wire into armed RX BDs.  Returns the number moved. */
+static int wire_poll(void)
+{
+	static u8_t frame[SIMNETIF_MAX_FRAME_SIZE];
+	ssize_t len;
+	int n = 0;
+
+	while (simnetif_mac_rx_ready(&simnetif)) {
+		len = recv(wire_fd, frame, sizeof frame, MSG_DONTWAIT);
+		if (len == 0) {
+			wire_eof = 1;
+			break;
+		}
+		if (len < 0)
+			break;
+		if (pcap_out)
+			pcap_write(pcap_out, frame, len);
+		simnetif_mac_rx(&simnetif, frame, len);
+		n++;
+	}
+	return n;
+}
+
+/*
+ * Sleep until the wire has a frame for us or, if the MAC is holding frames
+ * the wire refused, until it can take them.  Without this the two stacks
+ * would only hand over to each other on scheduler ticks when they share a
+ * CPU.
+ */
+static void wire_wait(void)
+{
+	struct pollfd pfd;
+
+	if (wire_fd < 0)
+		return;
+
+	pfd.fd = wire_fd;
+	pfd.events = POLLIN;
+	if (simnetif.tx_pending > 0)
+		pfd.events |= POLLOUT;
+	poll(&pfd, 1, BENCH_IDLE_MS);
+}
+
+/*
+ * One pass of the main loop: the receive handler, the stack, the
+ * application, the send handler and the stack timers, in that order.  Only
+ * passes that moved a frame count towards the cycles per frame figure, and
+ * a pass that moved none waits for the wire.
+ */
+static void bench_poll(int rx_frames, void (*app_poll)(void))
+{
+	static u64_t last_fast, last_slow, last_arp, last_reass;
+	u64_t start, wire, tx, now;
+
+	start = simnetif_cycles();
+	wire = simnetif.stats.wire_cycles;
+	tx = simnetif.stats.tx_frames;
+
+	simnetif_recv_handler(&simnetif);
+	while (simnetif_input(&netif))
+		;
+	if (app_poll)
+		app_poll();
+	simnetif_send_handler(&simnetif);
+
+	/* the BSP timer interrupt, at the intervals the Xilinx apps use */
+	now = now_ns() / 1000000ULL;
+	if (now - last_fast >= TCP_FAST_INTERVAL) {
+		tcp_fasttmr();
+		last_fast = now;
+	}
+	if (now - last_slow >= TCP_SLOW_INTERVAL) {
+		tcp_slowtmr();
+		last_slow = now;
+	}
+	if (now - last_arp >= ARP_TMR_INTERVAL) {
+		etharp_tmr();
+		last_arp = now;
+	}
+#if IP_REASSEMBLY
+	if (now - last_reass >= IP_TMR_INTERVAL) {
+		ip_reass_tmr();
+		last_reass = now;
+	}
+#endif
+
+	if (rx_frames > 0 || simnetif.stats.tx_frames != tx)
+		busy_cycles += simnetif_cycles() - start - (simnetif.stats.wire_cycles - wire);
+	else
+		wire_wait();
+}
+
+static void bench_snapshot(struct bench_counters *c)
+{
+	c->busy_cycles = busy_cycles;
+	c->wire_cycles = simnetif.stats.wire_cycles;
+	c->tx_frames = simnetif.stats.tx_frames;
+	c->rx_frames = simnetif.stats.rx_frames;
+}
+
+static void bench_start(void)
+{
+	if (app.started)
+		return;
+	app.started = 1;
+	app.start_ns = app.last_ns = now_ns();
+	bench_snapshot(&app.base);
+}
+
+static const char *mode_name(enum bench_mode mode)
+{
+	return mode == MODE_TCP ? "tcp" : (mode == MODE_UDP ? "udp" : "rr");
+}
+
+static void bench_report(void)
+{
+	struct bench_counters now;
+	u64_t frames, ns;
+	double secs;
+
+	bench_snapshot(&now);
+	frames = (now.tx_frames - app.base.tx_frames) + (now.rx_frames - app.base.rx_frames);
+	ns = app.last_ns - app.start_ns;
+	secs = ns ? (double)ns / NS_PER_SEC : 1.0;
+
+	if (!app.started || app.failed) {
+		printf("%-6s %-3s: no traffic%s, tx %llu rx %llu frames\n",
+				app.host->name, mode_name(app.mode),
+				app.failed ? " (connection failed)" : "",
+				(unsigned long long)now.tx_frames,
+				(unsigned long long)now.rx_frames);
+	} else {
+		printf("%-6s %-3s: %7.3f s  tx %9llu  rx %9llu frames  %10.0f pps  %8.2f Mbps  %6.0f cycles/frame\n",
+				app.host->name, mode_name(app.mode), secs,
+				(unsigned long long)(now.tx_frames - app.base.tx_frames),
+				(unsigned long long)(now.rx_frames - app.base.rx_frames),
+				frames / secs, app.bytes * 8 / secs / 1e6,
+				frames ? (double)(now.busy_cycles - app.base.busy_cycles) / frames : 0.0);
+
+		if (app.mode == MODE_UDP)
+			printf("       %llu datagrams  %.0f datagrams/s\n",
+					(unsigned long long)app.msgs, app.msgs / secs);
+		if (app.mode == MODE_RR && app.msgs)
+			printf("       %llu transactions  %.0f trans/s  %.1f us avg latency\n",
+					(unsigned long long)app.msgs, app.msgs / secs,
+					(double)app.rr_lat_ns / app.msgs / 1000.0);
+	}
+
+	printf("       tx_nobd %llu  rx_overrun %llu  rx_qfull %llu  rx_nopbuf %llu\n",
+			(unsigned long long)simnetif.stats.tx_nobd,
+			(unsigned long long)simnetif.stats.rx_overrun,
+			(unsigned long long)simnetif.stats.rx_qfull,
+			(unsigned long long)simnetif.stats.rx_nopbuf);
+#if LWIP_STATS_DISPLAY
+	stats_display();
+#endif
+	fflush(stdout);
+}
+
+/* payload bytes of rr traffic per len bytes received: the data and its echo */
+#define RR_BYTES(len)	(2 * (u64_t)(len))
+
+/*
+ * server: TCP discard, UDP sink and TCP echo
+ */
+
+static err_t server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+	struct pbuf *q;
+
+	(void)arg;
+	(void)err;
+
+	if (p == NULL) {
+		tcp_close(tpcb);
+		return ERR_OK;
+	}
+
+	bench_start();
+	app.bytes += app.mode == MODE_RR ? RR_BYTES(p->tot_len) : p->tot_len;
+	app.last_ns = now_ns();
+	tcp_recved(tpcb, p->tot_len);
+
+	if (app.mode == MODE_RR) {
+		/* echo it back */
+		for (q = p; q != NULL; q = q->next)
+			tcp_write(tpcb, q->payload, q->len, TCP_WRITE_FLAG_COPY);
+		tcp_output(tpcb);
+	}
+
+	pbuf_free(p);
+	return ERR_OK;
+}
+
+static err_t server_accept(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+	(void)arg;
+	(void)err;
+
+	if (app.mode == MODE_RR)
+		tcp_nagle_disable(newpcb);
+	tcp_recv(newpcb, server_recv);
+	return ERR_OK;
+}
+
+static void server_udp_recv(void *arg, struct udp_pcb *upcb, struct pbuf *p,
+		ip_addr_t *addr, u16_t port)
+{
+	(void)arg;
+	(void)upcb;
+	(void)addr;
+	(void)port;
+
+	bench_start();
+	app.msgs++;
+	app.bytes += p->tot_len;
+	app.last_ns = now_ns();
+	pbuf_free(p);
+}
+
+static void server_setup(void)
+{
+	struct tcp_pcb *pcb;
+
+	if (app.mode == MODE_UDP) {
+		app.upcb = udp_new();
+		udp_bind(app.upcb, IP_ADDR_ANY, BENCH_UDP_PORT);
+		udp_recv(app.upcb, server_udp_recv, NULL);
+		return;
+	}
+
+	pcb = tcp_new();
+	tcp_bind(pcb, IP_ADDR_ANY, app.mode == MODE_TCP ? BENCH_TCP_PORT : BENCH_RR_PORT);
+	pcb = tcp_listen(pcb);
+	tcp_accept(pcb, server_accept);
+}
+
+/*
+ * client
+ */
+static void client_tcp_send(struct tcp_pcb *tpcb)
+{
+	u32_t len;
+
+	while (!app.stopping) {
+		len = tcp_sndbuf(tpcb);
+		if (len == 0 || tcp_sndqueuelen(tpcb) >= TCP_SND_QUEUELEN)
+			break;
+		if (len > sizeof bench_buf)
+			len = sizeof bench_buf;
+		if (tcp_write(tpcb, bench_buf, len, TCP_WRITE_FLAG_COPY) != ERR_OK)
+			break;
+	}
+	tcp_output(tpcb);
+}
+
+static void client_rr_send(struct tcp_pcb *tpcb)
+{
+	app.rr_pending = app.size;
+	app.rr_sent_ns = now_ns();
+	tcp_write(tpcb, bench_buf, app.size, TCP_WRITE_FLAG_COPY);
+	tcp_output(tpcb);
+}
+
+static err_t client_sent(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+	(void)arg;
+
+	if (app.mode == MODE_TCP) {
+		app.bytes += len;
+		app.last_ns = now_ns();
+		client_tcp_send(tpcb);
+	}
+	return ERR_OK;
+}
+
+static err_t client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+	u64_t now;
+
+	(void)arg;
+	(void)err;
+
+	if (p == NULL)
+		return ERR_OK;
+
+	tcp_recved(tpcb, p->tot_len);
+	if (app.mode == MODE_RR && app.rr_pending) {
+		app.rr_pending -= p->tot_len < app.rr_pending ? p->tot_len : app.rr_pending;
+		if (app.rr_pending == 0) {
+			now = now_ns();
+			app.msgs++;
+			app.bytes += RR_BYTES(app.size);
+			app.rr_lat_ns += now - app.rr_sent_ns;
+			app.last_ns = now;
+			if (!app.stopping)
+				client_rr_send(tpcb);
+		}
+	}
+	pbuf_free(p);
+	return ERR_OK;
+}
+
+static void client_err(void *arg, err_t err)
+{
+	(void)arg;
+
+	fprintf(stderr, "client: connection error %d\n", err);
+	app.pcb = NULL;
+	app.failed = 1;
+	app.stopping = 1;
+}
+
+static err_t client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
+{
+	(void)arg;
+	(void)err;
+
+	bench_start();
+	tcp_sent(tpcb, client_sent);
+	tcp_recv(tpcb, client_recv);
+	if (app.mode == MODE_TCP) {
+		client_tcp_send(tpcb);
+	} else {
+		tcp_nagle_disable(tpcb);
+		client_rr_send(tpcb);
+	}
+	return ERR_OK;
+}
+
+static void client_udp_poll(void)
+{
+	ip_addr_t dst;
+	struct pbuf *p;
+	int i;
+
+	if (!app.started || app.stopping)
+		return;
+
+	IP4_ADDR(&dst, app.peer->ip[0], app.peer->ip[1], app.peer->ip[2], app.peer->ip[3]);
+	for (i = 0; i < XLWIP_CONFIG_N_TX_DESC; i++) {
+		p = pbuf_alloc(PBUF_TRANSPORT, app.size, PBUF_POOL);
+		if (p == NULL)
+			break;
+		pbuf_take(p, bench_buf, app.size);
+		if (udp_sendto(app.upcb, p, &dst, BENCH_UDP_PORT) != ERR_OK) {
+			pbuf_free(p);
+			break;
+		}
+		pbuf_free(p);
+		app.msgs++;
+		app.bytes += app.size;
+	}
+	app.last_ns = now_ns();
+}
+
+static void client_start(void)
+{
+	ip_addr_t dst;
+
+	IP4_ADDR(&dst, app.peer->ip[0], app.peer->ip[1], app.peer->ip[2], app.peer->ip[3]);
+
+	if (app.mode == MODE_UDP) {
+		app.upcb = udp_new();
+		bench_start();
+		return;
+	}
+
+	app.pcb = tcp_new();
+	tcp_err(app.pcb, client_err);
+	tcp_connect(app.pcb, &dst, app.mode == MODE_TCP ? BENCH_TCP_PORT : BENCH_RR_PORT,
+			client_connected);
+}
+
+static void client_stop(void)
+{
+	app.stopping = 1;
+	if (app.pcb != NULL) {
+		tcp_sent(app.pcb, NULL);
+		tcp_recv(app.pcb, NULL);
+		tcp_err(app.pcb, NULL);
+		if (tcp_close(app.pcb) != ERR_OK)
+			tcp_abort(app.pcb);
+		app.pcb = NULL;
+	}
+}
+
+/*
+ * setup and main loops
+ */
+static void stack_init(const struct bench_host *host, const struct bench_host *peer)
+{
+	ip_addr_t ipaddr, netmask, gw;
+
+	app.host = host;
+	app.peer = peer;
+
+	lwip_init();
+
+	memcpy(&simnetif.hwaddr, host->mac, 6);
+	simnetif.wire.xmit = wire_xmit;
+	simnetif.wire.arg = NULL;
+
+	IP4_ADDR(&ipaddr, host->ip[0], host->ip[1], host->ip[2], host->ip[3]);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+	IP4_ADDR(&gw, host->ip[0], host->ip[1], host->ip[2], 254);
+
+	if (!netif_add(&netif, &ipaddr, &netmask, &gw, &simnetif, simnetif_init, ethernet_input)) {
+		fprintf(stderr, "%s: netif_add failed\n", host->name);
+		exit(1);
+	}
+	netif_set_default(&netif);
+	netif_set_up(&netif);
+}
+
+static void run_server(void)
+{
+	stack_init(&server_host, &client_host);
+	server_setup();
+
+	while (!wire_eof)
+		bench_poll(wire_poll(), NULL);
+
+	bench_report();
+}
+
+static void run_client(void)
+{
+	void (*app_poll)(void) = NULL;
+	ip_addr_t dst, *ip_ret;
+	struct eth_addr *eth_ret;
+	u64_t t, deadline;
+
+	stack_init(&client_host, &server_host);
+	if (app.mode == MODE_UDP)
+		app_poll = client_udp_poll;
+
+	/* resolve the server first so that the window does not include ARP */
+	IP4_ADDR(&dst, server_host.ip[0], server_host.ip[1], server_host.ip[2], server_host.ip[3]);
+	deadline = now_ns() + NS_PER_SEC;
+	t = 0;
+	while (etharp_find_addr(&netif, &dst, &eth_ret, &ip_ret) < 0) {
+		if (now_ns() > deadline) {
+			fprintf(stderr, "client: no ARP reply from the server\n");
+			app.failed = 1;
+			return;
+		}
+		if (now_ns() - t > NS_PER_SEC / 10) {
+			etharp_request(&netif, &dst);
+			t = now_ns();
+		}
+		bench_poll(wire_poll(), NULL);
+	}
+
+	client_start();
+
+	deadline = now_ns() + app.duration_ns;
+	while (now_ns() < deadline && !app.failed)
+		bench_poll(wire_poll(), app_poll);
+
+	client_stop();
+	deadline = now_ns() + BENCH_DRAIN_NS;
+	while (now_ns() < deadline)
+		bench_poll(wire_poll(), NULL);
+}
+
+static void run_replay(const char *fname)
+{
+	struct pcap_frame *frames;
+	u32_t count, i = 0;
+	u64_t deadline;
+	int n;
+
+	frames = pcap_load(fname, &server_host, &count);
+	if (count == 0) {
+		fprintf(stderr, "%s: no frames addressed to the server\n", fname);
+		exit(1);
+	}
+
+	stack_init(&server_host, &client_host);
+	server_setup();
+	bench_start();
+
+	deadline = now_ns() + app.duration_ns;
+	while (now_ns() < deadline) {
+		for (n = 0; simnetif_mac_rx_ready(&simnetif); n++) {
+			simnetif_mac_rx(&simnetif, frames[i].data, frames[i].len);
+			i = (i + 1) % count;
+		}
+		bench_poll(n, NULL);
+	}
+	app.last_ns = now_ns();
+
+	printf("replay %s: %u frames, %.2f Mbps offered\n", fname, count,
+			simnetif.stats.rx_bytes * 8 / ((double)(app.last_ns - app.start_ns) / NS_PER_SEC) / 1e6);
+	bench_report();
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"usage: %s [-t tcp|udp|rr] [-d seconds] [-s size] [-w out.pcap]\n"
+		"       %s -r in.pcap [-t tcp|udp|rr] [-d seconds]\n", prog, prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	const char *wfile = NULL, *rfile = NULL;
+	int sv[2], status, opt, size = 0;
+	double secs = 5.0;
+	pid_t pid;
+
+	app.mode = MODE_TCP;
+	while ((opt = getopt(argc, argv, "t:d:s:w:r:h")) != -1) {
+		switch (opt) {
+		case 't':
+			if (!strcmp(optarg, "tcp"))
+				app.mode = MODE_TCP;
+			else if (!strcmp(optarg, "udp"))
+				app.mode = MODE_UDP;
+			else if (!strcmp(optarg, "rr"))
+				app.mode = MODE_RR;
+			else
+				usage(argv[0]);
+			break;
+		case 'd':
+			secs = atof(optarg);
+			break;
+		case 's':
+			size = atoi(optarg);
+			break;
+		case 'w':
+			wfile = optarg;
+			break;
+		case 'r':
+			rfile = optarg;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if (size <= 0)
+		size = 64;
+	/*
+	 * The GEM port clamps each TX BD to XEMACPS_MAX_FRAME_SIZE - 18 bytes,
+	 * so a datagram whose frame fits a single pbuf must stay within
+	 * 1500 - 14 - 20 - 8 bytes to leave the MAC untruncated.
+	 */
+	if (size > BENCH_MAX_SIZE)
+		size = BENCH_MAX_SIZE;
+	app.size = size;
+	app.duration_ns = (u64_t)(secs * NS_PER_SEC);
+	memset(bench_buf, 0xa5, sizeof bench_buf);
+
+	if (rfile) {
+		run_replay(rfile);
+		return 0;
+	}
+
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) < 0) {
+		perror("socketpair");
+		return 1;
+	}
+
+	fflush(stdout);
+	pid = fork();
+	if (pid < 0) {
+		perror("fork");
+		return 1;
+	}
+
+	if (pid == 0) {
+		close(sv[0]);
+		wire_fd = sv[1];
+		run_server();
+		return 0;
+	}
+
+	close(sv[1]);
+	wire_fd = sv[0];
+	if (wfile)
+		pcap_out = pcap_create(wfile);
+
+	run_client();
+
+	/* dropping the link ends the server, which reports first */
+	close(wire_fd);
+	waitpid(pid, &status, 0);
+	bench_report();
+
+	if (pcap_out)
+		fclose(pcap_out);
+
+	return app.failed;
+}
@@ -0,0 +1,168 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+/*
+ * lwipopts.h for the host benchmark.
+ *
+ * The options below are the ones lwip141.tcl writes for a RAW API BSP on
+ * a Zynq GEM (xemacpsif) with the lwip141.mld defaults.  Every tunable is
+ * guarded so that it can be overridden from the make command line, e.g.
+ *	make TCP_WND=16384 PBUF_POOL_SIZE=512
+ */
+
+#ifndef __LWIPOPTS_H_
+#define __LWIPOPTS_H_
+
+#ifndef PROCESSOR_LITTLE_ENDIAN
+#define PROCESSOR_LITTLE_ENDIAN
+#endif
+
+#define SYS_LIGHTWEIGHT_PROT 1
+
+/*
+ * The port's sys.h only provides these for MicroBlaze, PPC and ARM.  The
+ * benchmark runs the stack from one thread with no interrupt context, so on
+ * the host protection is a no-op.
+ */
+#define SYS_ARCH_DECL_PROTECT(lev) sys_prot_t lev
+#define SYS_ARCH_PROTECT(lev) lev = 0
+#define SYS_ARCH_UNPROTECT(lev) (void)(lev)
+
+#define NO_SYS 1
+#define LWIP_SOCKET 0
+#define LWIP_COMPAT_SOCKETS 0
+#define LWIP_NETCONN 0
+
+#define MEM_ALIGNMENT 64
+#ifndef MEM_SIZE
+#define MEM_SIZE 131072
+#endif
+#ifndef MEMP_NUM_PBUF
+#define MEMP_NUM_PBUF 16
+#endif
+#define MEMP_NUM_UDP_PCB 4
+#define MEMP_NUM_TCP_PCB 32
+#define MEMP_NUM_TCP_PCB_LISTEN 8
+#ifndef MEMP_NUM_TCP_SEG
+#define MEMP_NUM_TCP_SEG 256
+#endif
+#define MEMP_NUM_SYS_TIMEOUT 8
+#define MEMP_NUM_NETBUF 8
+#define MEMP_NUM_NETCONN 16
+#define MEMP_NUM_TCPIP_MSG_API 16
+#define MEMP_NUM_TCPIP_MSG_INPKT 64
+
+#ifndef PBUF_POOL_SIZE
+#define PBUF_POOL_SIZE 256
+#endif
+#ifndef PBUF_POOL_BUFSIZE
+#define PBUF_POOL_BUFSIZE 1700
+#endif
+#define PBUF_LINK_HLEN 16
+
+#define ARP_TABLE_SIZE 10
+#define ARP_QUEUEING 1
+
+#define ICMP_TTL 255
+
+#define IP_OPTIONS 0
+#define IP_FORWARD 0
+#define IP_REASSEMBLY 1
+#define IP_FRAG 1
+#define IP_REASS_MAX_PBUFS 128
+#define IP_FRAG_MAX_MTU 1500
+#define IP_DEFAULT_TTL 255
+#define LWIP_CHKSUM_ALGORITHM 3
+
+#define LWIP_UDP 1
+#define UDP_TTL 255
+
+#define LWIP_TCP 1
+#ifndef TCP_MSS
+#define TCP_MSS 1460
+#endif
+#ifndef TCP_SND_BUF
+#define TCP_SND_BUF 8192
+#endif
+#ifndef TCP_WND
+#define TCP_WND 2048
+#endif
+#define TCP_TTL 255
+#define TCP_MAXRTX 12
+#define TCP_SYNMAXRTX 4
+#define TCP_QUEUE_OOSEQ 1
+#define TCP_SND_QUEUELEN   16 * TCP_SND_BUF/TCP_MSS
+
+/*
+ * The GEM computes and checks all checksums in hardware, so the BSP turns
+ * the software checksums off.  Build with CSUM=1 to measure the cost of
+ * doing them in software, as the emaclite and AXI Ethernet BSPs do.
+ */
+#ifndef BENCH_SW_CHECKSUM
+#define CHECKSUM_GEN_TCP 	0
+#define CHECKSUM_GEN_UDP 	0
+#define CHECKSUM_GEN_IP  	0
+#define CHECKSUM_CHECK_TCP  0
+#define CHECKSUM_CHECK_UDP  0
+#define CHECKSUM_CHECK_IP 	0
+#define LWIP_FULL_CSUM_OFFLOAD_RX  1
+#define LWIP_FULL_CSUM_OFFLOAD_TX  1
+#else
+#define CHECKSUM_GEN_TCP 	1
+#define CHECKSUM_GEN_UDP 	1
+#define CHECKSUM_GEN_IP  	1
+#define CHECKSUM_CHECK_TCP  1
+#define CHECKSUM_CHECK_UDP  1
+#define CHECKSUM_CHECK_IP 	1
+#endif
+
+#define NO_SYS_NO_TIMERS 1
+#define MEMP_SEPARATE_POOLS 1
+#define MEMP_NUM_FRAG_PBUF 256
+#define IP_OPTIONS_ALLOWED 0
+#define TCP_OVERSIZE TCP_MSS
+
+#define LWIP_DHCP 0
+#define DHCP_DOES_ARP_CHECK 0
+
+#define CONFIG_LINKSPEED1000 1
+
+#ifdef BENCH_STATS
+#define LWIP_STATS 1
+#define LWIP_STATS_DISPLAY 1
+/* cc.h prints the statistics through xil_printf() */
+#include "xil_printf.h"
+#else
+#define LWIP_STATS 0
+#endif
+
+#endif
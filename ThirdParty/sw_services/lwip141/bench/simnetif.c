@@ -0,0 +1,443 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+/*
+ * simnetif.c
+ *
+ * A host-side stand-in for xemacpsif.c/xemacpsif_dma.c.  The MAC is
+ * replaced by a memcpy to and from a simulated wire, everything above it
+ * follows the GEM adapter: TX pbufs are referenced into a BD ring and only
+ * freed when the send handler reclaims completed BDs, RX BDs are armed with
+ * PBUF_POOL buffers, and the receive handler moves filled buffers to recv_q
+ * from where simnetif_input() feeds them to the stack one at a time.
+ */
+
+#include <string.h>
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/mem.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+
+#include "simnetif.h"
+
+/* Define those to better describe your network interface. */
+#define IFNAME0 's'
+#define IFNAME1 'm'
+
+/* the MAC's transmit FIFO, a frame is gathered here from its BDs */
+static u8_t tx_frame[SIMNETIF_MAX_FRAME_SIZE];
+
+/*
+ * mac_tx_kick():
+ *
+ * The MAC side of transmission: hand every complete frame that has been
+ * queued on the TX ring to the wire, in order, until the wire pushes back.
+ */
+static void mac_tx_kick(simnetif_s *simnetif)
+{
+	simnetif_bd *bd;
+	u32_t i, n;
+	u16_t len;
+	u64_t start;
+	int status;
+
+	while (simnetif->tx_pending > 0) {
+		/* gather one frame */
+		len = 0;
+		n = 0;
+		i = simnetif->tx_hw;
+		do {
+			bd = &simnetif->tx_bd[i];
+			if (len + bd->len <= SIMNETIF_MAX_FRAME_SIZE) {
+				memcpy(&tx_frame[len], bd->p->payload, bd->len);
+				len += bd->len;
+			}
+			i = (i + 1) % XLWIP_CONFIG_N_TX_DESC;
+			n++;
+		} while (!bd->last);
+
+		start = simnetif_cycles();
+		status = simnetif->wire.xmit(simnetif->wire.arg, tx_frame, len);
+		simnetif->stats.wire_cycles += simnetif_cycles() - start;
+		if (status < 0)
+			return;
+
+		/* set the used bit on every BD of the frame */
+		simnetif->tx_pending -= n;
+		while (n-- > 0) {
+			simnetif->tx_bd[simnetif->tx_hw].done = 1;
+			simnetif->tx_hw = (simnetif->tx_hw + 1) % XLWIP_CONFIG_N_TX_DESC;
+		}
+
+		simnetif->stats.tx_frames++;
+		simnetif->stats.tx_bytes += len;
+	}
+}
+
+static s32_t is_tx_space_available(simnetif_s *simnetif)
+{
+	return simnetif->tx_free;
+}
+
+/*
+ * process_sent_bds():
+ *
+ * Reclaim the BDs the MAC is done with and drop the reference taken on
+ * their pbufs in simnetif_sgsend().
+ */
+static void process_sent_bds(simnetif_s *simnetif)
+{
+	simnetif_bd *bd;
+
+	while (simnetif->tx_free < XLWIP_CONFIG_N_TX_DESC) {
+		bd = &simnetif->tx_bd[simnetif->tx_tail];
+		if (!bd->done)
+			break;
+
+		pbuf_free(bd->p);
+		bd->p = NULL;
+		bd->done = 0;
+		simnetif->tx_tail = (simnetif->tx_tail + 1) % XLWIP_CONFIG_N_TX_DESC;
+		simnetif->tx_free++;
+	}
+}
+
+static s32_t simnetif_sgsend(simnetif_s *simnetif, struct pbuf *p)
+{
+	struct pbuf *q;
+	s32_t n_pbufs;
+	simnetif_bd *bd = NULL;
+
+	/* first count the number of pbufs */
+	for (q = p, n_pbufs = 0; q != NULL; q = q->next)
+		n_pbufs++;
+
+	/* obtain as many BD's */
+	if (n_pbufs > simnetif->tx_free) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error allocating TxBD\r\n"));
+		return -1;
+	}
+
+	for (q = p; q != NULL; q = q->next) {
+		bd = &simnetif->tx_bd[simnetif->tx_head];
+		bd->p = q;
+		if (q->len > (SIMNETIF_MAX_FRAME_SIZE - 18))
+			bd->len = SIMNETIF_MAX_FRAME_SIZE - 18;
+		else
+			bd->len = q->len;
+		bd->last = 0;
+		bd->done = 0;
+		pbuf_ref(q);
+		simnetif->tx_head = (simnetif->tx_head + 1) % XLWIP_CONFIG_N_TX_DESC;
+	}
+	bd->last = 1;
+	simnetif->tx_free -= n_pbufs;
+	simnetif->tx_pending += n_pbufs;
+
+	/* Start transmit */
+	mac_tx_kick(simnetif);
+
+	return 0;
+}
+
+/*
+ * low_level_output():
+ *
+ * Should do the actual transmission of the packet. The packet is
+ * contained in the pbuf that is passed to the function. This pbuf
+ * might be chained.
+ *
+ */
+static err_t low_level_output(struct netif *netif, struct pbuf *p)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	err_t err;
+	simnetif_s *simnetif = (simnetif_s *)(netif->state);
+
+	SYS_ARCH_PROTECT(lev);
+
+	/* check if space is available to send */
+	if (is_tx_space_available(simnetif) <= 5) {
+		process_sent_bds(simnetif);
+	}
+
+	if (is_tx_space_available(simnetif)) {
+#if ETH_PAD_SIZE
+		pbuf_header(p, -ETH_PAD_SIZE);	/* drop the padding word */
+#endif
+		if (simnetif_sgsend(simnetif, p) < 0) {
+			simnetif->stats.tx_nobd++;
+#if LINK_STATS
+			lwip_stats.link.drop++;
+#endif
+		}
+#if ETH_PAD_SIZE
+		pbuf_header(p, ETH_PAD_SIZE);	/* reclaim the padding word */
+#endif
+#if LINK_STATS
+		lwip_stats.link.xmit++;
+#endif
+		err = ERR_OK;
+	} else {
+		simnetif->stats.tx_nobd++;
+#if LINK_STATS
+		lwip_stats.link.drop++;
+#endif
+		err = ERR_MEM;
+	}
+
+	SYS_ARCH_UNPROTECT(lev);
+	return err;
+}
+
+/*
+ * setup_rx_bds():
+ *
+ * Arm every free RX BD with a buffer from the pbuf pool.  As on the GEM a
+ * pool that runs dry simply leaves BDs unarmed until the next call.
+ */
+static void setup_rx_bds(simnetif_s *simnetif)
+{
+	simnetif_bd *bd;
+	struct pbuf *p;
+
+	while (1) {
+		bd = &simnetif->rx_bd[simnetif->rx_fill];
+		if (bd->p != NULL)
+			return;
+
+		p = pbuf_alloc(PBUF_RAW, SIMNETIF_MAX_FRAME_SIZE, PBUF_POOL);
+		if (!p) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			simnetif->stats.rx_nopbuf++;
+			return;
+		}
+
+		bd->p = p;
+		bd->done = 0;
+		simnetif->rx_fill = (simnetif->rx_fill + 1) % XLWIP_CONFIG_N_RX_DESC;
+	}
+}
+
+s32_t simnetif_mac_rx_ready(simnetif_s *simnetif)
+{
+	simnetif_bd *bd = &simnetif->rx_bd[simnetif->rx_hw];
+
+	return (bd->p != NULL && !bd->done);
+}
+
+s32_t simnetif_mac_rx(simnetif_s *simnetif, const u8_t *frame, u16_t len)
+{
+	simnetif_bd *bd = &simnetif->rx_bd[simnetif->rx_hw];
+
+	if (bd->p == NULL || bd->done) {
+		simnetif->stats.rx_overrun++;
+		return -1;
+	}
+
+	if (len > SIMNETIF_MAX_FRAME_SIZE)
+		len = SIMNETIF_MAX_FRAME_SIZE;
+
+	pbuf_take(bd->p, frame, len);
+	bd->len = len;
+	bd->done = 1;
+	simnetif->rx_hw = (simnetif->rx_hw + 1) % XLWIP_CONFIG_N_RX_DESC;
+
+	simnetif->stats.rx_frames++;
+	simnetif->stats.rx_bytes += len;
+	return 0;
+}
+
+void simnetif_send_handler(simnetif_s *simnetif)
+{
+	/* frames the wire refused earlier go out first */
+	mac_tx_kick(simnetif);
+	process_sent_bds(simnetif);
+}
+
+void simnetif_recv_handler(simnetif_s *simnetif)
+{
+	simnetif_bd *bd;
+	struct pbuf *p;
+
+	while (1) {
+		bd = &simnetif->rx_bd[simnetif->rx_tail];
+		if (!bd->done)
+			break;
+
+		p = bd->p;
+
+		/*
+		 * Adjust the buffer size to the actual number of bytes received.
+		 */
+		pbuf_realloc(p, bd->len);
+
+		/* store it in the receive queue,
+		 * where it'll be processed by a different handler
+		 */
+		if (pq_enqueue(simnetif->recv_q, (void*)p) < 0) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			simnetif->stats.rx_qfull++;
+			pbuf_free(p);
+		}
+
+		bd->p = NULL;
+		bd->done = 0;
+		simnetif->rx_tail = (simnetif->rx_tail + 1) % XLWIP_CONFIG_N_RX_DESC;
+	}
+
+	setup_rx_bds(simnetif);
+}
+
+/*
+ * low_level_input():
+ *
+ * Should allocate a pbuf and transfer the bytes of the incoming
+ * packet from the interface into the pbuf.
+ *
+ */
+static struct pbuf * low_level_input(struct netif *netif)
+{
+	simnetif_s *simnetif = (simnetif_s *)(netif->state);
+
+	/* see if there is data to process */
+	if (pq_qlength(simnetif->recv_q) == 0)
+		return NULL;
+
+	/* return one packet from receive q */
+	return (struct pbuf *)pq_dequeue(simnetif->recv_q);
+}
+
+static err_t simnetif_output(struct netif *netif, struct pbuf *p,
+		struct ip_addr *ipaddr)
+{
+	/* resolve hardware address, then send (or queue) packet */
+	return etharp_output(netif, p, ipaddr);
+}
+
+/*
+ * simnetif_input():
+ *
+ * Same contract as xemacpsif_input(): returns the number of packets read
+ * (max 1 packet on success, 0 if there are no packets)
+ *
+ */
+s32_t simnetif_input(struct netif *netif)
+{
+	struct eth_hdr *ethhdr;
+	struct pbuf *p;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	/* move received packet into a new pbuf */
+	SYS_ARCH_PROTECT(lev);
+	p = low_level_input(netif);
+	SYS_ARCH_UNPROTECT(lev);
+
+	/* no packet could be read, silently ignore this */
+	if (p == NULL) {
+		return 0;
+	}
+
+	/* points to packet payload, which starts with an Ethernet header */
+	ethhdr = p->payload;
+
+#if LINK_STATS
+	lwip_stats.link.recv++;
+#endif /* LINK_STATS */
+
+	switch (htons(ethhdr->type)) {
+		/* IP or ARP packet? */
+		case ETHTYPE_IP:
+		case ETHTYPE_ARP:
+			if (netif->input(p, netif) != ERR_OK) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("simnetif_input: IP input error\r\n"));
+				pbuf_free(p);
+				p = NULL;
+			}
+			break;
+
+		default:
+			pbuf_free(p);
+			p = NULL;
+			break;
+	}
+
+	return 1;
+}
+
+/*
+ * simnetif_init():
+ *
+ * netif->state must point to a simnetif_s with hwaddr and wire filled in.
+ */
+err_t simnetif_init(struct netif *netif)
+{
+	simnetif_s *simnetif = (simnetif_s *)(netif->state);
+
+	netif->name[0] = IFNAME0;
+	netif->name[1] = IFNAME1;
+	netif->output = simnetif_output;
+	netif->linkoutput = low_level_output;
+
+	/* maximum transfer unit */
+	netif->mtu = SIMNETIF_MAX_FRAME_SIZE - 18;
+
+	netif->hwaddr_len = 6;
+	memcpy(netif->hwaddr, &simnetif->hwaddr, 6);
+
+	/* device capabilities */
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+	simnetif->recv_q = pq_create_queue();
+	if (!simnetif->recv_q)
+		return ERR_MEM;
+
+	memset(simnetif->tx_bd, 0, sizeof(simnetif->tx_bd));
+	memset(simnetif->rx_bd, 0, sizeof(simnetif->rx_bd));
+	memset(&simnetif->stats, 0, sizeof(simnetif->stats));
+	simnetif->tx_head = simnetif->tx_hw = simnetif->tx_tail = 0;
+	simnetif->tx_free = XLWIP_CONFIG_N_TX_DESC;
+	simnetif->tx_pending = 0;
+	simnetif->rx_hw = simnetif->rx_tail = simnetif->rx_fill = 0;
+
+	setup_rx_bds(simnetif);
+
+	return ERR_OK;
+}
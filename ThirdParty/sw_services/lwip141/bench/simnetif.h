@@ -0,0 +1,141 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+#ifndef __NETIF_SIMNETIF_H__
+#define __NETIF_SIMNETIF_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <time.h>
+
+#include "xlwipconfig.h"
+#include "lwip/netif.h"
+#include "netif/etharp.h"
+#include "lwip/sys.h"
+
+#include "netif/xpqueue.h"
+
+/* Same as XEMACPS_MAX_FRAME_SIZE without jumbo frames */
+#define SIMNETIF_MAX_FRAME_SIZE	1518
+
+/*
+ * The "wire" a simulated GEM transmits on.  xmit() returns 0 once the frame
+ * has left the MAC, or -1 if the link cannot take it yet, in which case the
+ * BD stays owned by the MAC and is retried from the send handler.
+ */
+struct simnetif_wire {
+	int (*xmit)(void *arg, const u8_t *frame, u16_t len);
+	void *arg;
+};
+
+/* One buffer descriptor.  p holds the pbuf the BD points to. */
+typedef struct {
+	struct pbuf *p;
+	u16_t len;
+	u8_t last;	/* TX: last BD of a frame */
+	u8_t done;	/* TX: sent by the MAC, RX: written by the MAC */
+} simnetif_bd;
+
+typedef struct {
+	u64_t tx_frames;
+	u64_t tx_bytes;
+	u64_t tx_nobd;		/* low_level_output() found the TX ring full */
+	u64_t rx_frames;
+	u64_t rx_bytes;
+	u64_t rx_overrun;	/* frame arrived with no RX BD armed */
+	u64_t rx_qfull;		/* recv_q full, frame dropped */
+	u64_t rx_nopbuf;	/* pbuf pool empty while rearming RX BDs */
+	u64_t wire_cycles;	/* time spent in wire->xmit() */
+} simnetif_stats;
+
+/* structure within each netif, the counterpart of xemacpsif_s */
+typedef struct {
+	struct eth_addr hwaddr;
+	struct simnetif_wire wire;
+
+	/* queue to store received packets until xemacpsif_input() runs */
+	pq_queue_t *recv_q;
+
+	simnetif_bd tx_bd[XLWIP_CONFIG_N_TX_DESC];
+	u32_t tx_head;		/* next BD to allocate */
+	u32_t tx_hw;		/* next BD the MAC transmits */
+	u32_t tx_tail;		/* next BD to reclaim */
+	u32_t tx_free;
+	u32_t tx_pending;	/* BDs queued but not yet sent by the MAC */
+
+	simnetif_bd rx_bd[XLWIP_CONFIG_N_RX_DESC];
+	u32_t rx_hw;		/* next BD the MAC writes */
+	u32_t rx_tail;		/* next BD to reclaim */
+	u32_t rx_fill;		/* next BD to arm */
+
+	simnetif_stats stats;
+} simnetif_s;
+
+err_t 	simnetif_init(struct netif *netif);
+s32_t 	simnetif_input(struct netif *netif);
+
+/* MAC side: DMA a frame from the wire into the next armed RX BD */
+s32_t	simnetif_mac_rx(simnetif_s *simnetif, const u8_t *frame, u16_t len);
+s32_t	simnetif_mac_rx_ready(simnetif_s *simnetif);
+
+/* "interrupt handlers", called from the main loop */
+void 	simnetif_send_handler(simnetif_s *simnetif);
+void 	simnetif_recv_handler(simnetif_s *simnetif);
+
+/*
+ * Free running cycle counter used for the cycles per packet figures: the
+ * TSC on x86, the virtual counter on AArch64 and nanoseconds elsewhere.
+ */
+static inline u64_t simnetif_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	u32_t lo, hi;
+	__asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+	return ((u64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+	u64_t v;
+	__asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+	return v;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NETIF_SIMNETIF_H__ */
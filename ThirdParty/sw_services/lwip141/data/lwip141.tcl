@@ -457,6 +457,10 @@ proc generate_lwip_opts {libhandle} {
 			puts $lwipopts_fd "\#define DEFAULT_RAW_RECVMBOX_SIZE	30"
 			puts $lwipopts_fd "\#define LWIP_COMPAT_MUTEX 0"
 			puts $lwipopts_fd "\#define LWIP_ALLOW_MEM_FREE_FROM_OTHER_CONTEXT 1"
+			set lockfree_mbox [common::get_property CONFIG.lockfree_mbox $libhandle]
+			if {$lockfree_mbox == true} {
+				puts $lwipopts_fd "\#define LWIP_FREERTOS_LOCKFREE_MBOX 1"
+			}
 			puts $lwipopts_fd ""
 		}
 	}
@@ -106,13 +106,53 @@ typedef u32_t sys_prot_t;
 #include "semphr.h"
 #include "timers.h"
 
+#ifndef LWIP_FREERTOS_LOCKFREE_MBOX
+#define LWIP_FREERTOS_LOCKFREE_MBOX		0
+#endif
+
+#if LWIP_FREERTOS_LOCKFREE_MBOX
+/*
+ * Lock-free mailbox: a bounded ring of message pointers.  Every cell carries
+ * a sequence number that tells producers and consumers whether the cell is
+ * free for the current lap, so posting and fetching only need one
+ * compare-and-swap on the ring index and never enter a critical section.
+ *
+ * A consumer that finds the ring empty parks itself in xWaitingTask and
+ * sleeps on its direct-to-task notification; producers only call into the
+ * kernel when a consumer is actually parked.  Only one task may block on a
+ * given mailbox at a time, which is how lwIP uses its mailboxes, and a task
+ * that blocks on a mailbox must not use its task notification for anything
+ * else.  Posters that find the ring full block on xSpace.
+ */
+typedef struct sys_mbox_cell
+{
+	volatile unsigned long ulSequence;
+	void *pvMessage;
+} sys_mbox_cell_t;
+
+struct sys_mbox_s
+{
+	sys_mbox_cell_t *pxCells;
+	unsigned long ulMask;
+	volatile unsigned long ulPostIndex;
+	volatile unsigned long ulFetchIndex;
+	xTaskHandle volatile xWaitingTask;
+	volatile unsigned long ulWaitingPosters;
+	xSemaphoreHandle xSpace;
+};
+
+#define SYS_MBOX_NULL					( ( struct sys_mbox_s * ) NULL )
+typedef struct sys_mbox_s *sys_mbox_t;
+#else
 #define SYS_MBOX_NULL					( ( xQueueHandle ) NULL )
+typedef xQueueHandle sys_mbox_t;
+#endif
+
 #define SYS_SEM_NULL					( ( xSemaphoreHandle ) NULL )
 #define SYS_DEFAULT_THREAD_STACK_DEPTH	configMINIMAL_STACK_SIZE
 
 typedef xSemaphoreHandle sys_sem_t;
 typedef xSemaphoreHandle sys_mutex_t;
-typedef xQueueHandle sys_mbox_t;
 typedef xTaskHandle sys_thread_t;
 
 typedef unsigned long sys_prot_t;
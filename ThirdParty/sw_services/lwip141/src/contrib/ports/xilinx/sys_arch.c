@@ -478,6 +478,407 @@ functions are being called from an interrupt context or not.  This relies on
 the interrupt handler setting this variable manually. */
 extern long xInsideISR;
 
+#if LWIP_FREERTOS_LOCKFREE_MBOX
+/*---------------------------------------------------------------------------*
+ * Lock-free mailbox
+ *---------------------------------------------------------------------------*
+ * Cell i of the ring is free for the post with index p when its sequence
+ * equals p, and holds the message for the fetch with index f when its
+ * sequence equals f + 1.  Fetching a message advances the sequence by one
+ * ring length, handing the cell to the post one lap later.  Posts and
+ * fetches claim their index with a compare-and-swap, so an ISR can post
+ * while a task is in the middle of a post on the same core.
+ *---------------------------------------------------------------------------*/
+static void prvMboxWakeFetcher( sys_mbox_t xMailBox )
+{
+xTaskHandle xTask;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	/* Pairs with the fence in sys_arch_mbox_fetch(): either the fetcher
+	sees the new message or we see the fetcher parked. */
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+	xTask = xMailBox->xWaitingTask;
+	if( xTask == NULL )
+	{
+		return;
+	}
+
+	if( xInsideISR != pdFALSE )
+	{
+		vTaskNotifyGiveFromISR( xTask, &xHigherPriorityTaskWoken );
+		if (xHigherPriorityTaskWoken == pdTRUE) {
+			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		}
+	}
+	else
+	{
+		xTaskNotifyGive( xTask );
+	}
+}
+
+static void prvMboxWakePoster( sys_mbox_t xMailBox )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+	if( xMailBox->ulWaitingPosters == 0UL )
+	{
+		return;
+	}
+
+	if( xInsideISR != pdFALSE )
+	{
+		xSemaphoreGiveFromISR( xMailBox->xSpace, &xHigherPriorityTaskWoken );
+		if (xHigherPriorityTaskWoken == pdTRUE) {
+			portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+		}
+	}
+	else
+	{
+		xSemaphoreGive( xMailBox->xSpace );
+	}
+}
+
+static portBASE_TYPE prvMboxPost( sys_mbox_t xMailBox, void *pvMessage )
+{
+sys_mbox_cell_t *pxCell;
+unsigned long ulIndex, ulSequence;
+long lDiff;
+
+	ulIndex = __atomic_load_n( &xMailBox->ulPostIndex, __ATOMIC_RELAXED );
+	for( ;; )
+	{
+		pxCell = &xMailBox->pxCells[ ulIndex & xMailBox->ulMask ];
+		ulSequence = __atomic_load_n( &pxCell->ulSequence, __ATOMIC_ACQUIRE );
+		lDiff = ( long ) ( ulSequence - ulIndex );
+		if( lDiff == 0L )
+		{
+			if( __atomic_compare_exchange_n( &xMailBox->ulPostIndex, &ulIndex, ulIndex + 1UL,
+					pdTRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+			{
+				break;
+			}
+		}
+		else if( lDiff < 0L )
+		{
+			/* The cell still holds a message from the previous lap. */
+			return pdFALSE;
+		}
+		else
+		{
+			ulIndex = __atomic_load_n( &xMailBox->ulPostIndex, __ATOMIC_RELAXED );
+		}
+	}
+
+	pxCell->pvMessage = pvMessage;
+	__atomic_store_n( &pxCell->ulSequence, ulIndex + 1UL, __ATOMIC_RELEASE );
+
+	prvMboxWakeFetcher( xMailBox );
+	return pdTRUE;
+}
+
+static portBASE_TYPE prvMboxFetch( sys_mbox_t xMailBox, void **ppvMessage )
+{
+sys_mbox_cell_t *pxCell;
+unsigned long ulIndex, ulSequence;
+long lDiff;
+
+	ulIndex = __atomic_load_n( &xMailBox->ulFetchIndex, __ATOMIC_RELAXED );
+	for( ;; )
+	{
+		pxCell = &xMailBox->pxCells[ ulIndex & xMailBox->ulMask ];
+		ulSequence = __atomic_load_n( &pxCell->ulSequence, __ATOMIC_ACQUIRE );
+		lDiff = ( long ) ( ulSequence - ( ulIndex + 1UL ) );
+		if( lDiff == 0L )
+		{
+			if( __atomic_compare_exchange_n( &xMailBox->ulFetchIndex, &ulIndex, ulIndex + 1UL,
+					pdTRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+			{
+				break;
+			}
+		}
+		else if( lDiff < 0L )
+		{
+			/* Empty, or the oldest post has claimed its cell but not yet
+			filled it; that poster wakes us once it has. */
+			return pdFALSE;
+		}
+		else
+		{
+			ulIndex = __atomic_load_n( &xMailBox->ulFetchIndex, __ATOMIC_RELAXED );
+		}
+	}
+
+	*ppvMessage = pxCell->pvMessage;
+	__atomic_store_n( &pxCell->ulSequence, ulIndex + xMailBox->ulMask + 1UL, __ATOMIC_RELEASE );
+
+	prvMboxWakePoster( xMailBox );
+	return pdTRUE;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates a new mailbox.  The ring is rounded up to a power of two.
+ * Inputs:
+ *      int size                -- Size of elements in the mailbox
+ * Outputs:
+ *      sys_mbox_t              -- Handle to new mailbox
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_new( sys_mbox_t *pxMailBox, int iSize )
+{
+sys_mbox_t xMailBox;
+unsigned long ulSize, ulCell;
+
+	ulSize = 2UL;
+	while( ulSize < ( unsigned long ) iSize )
+	{
+		ulSize <<= 1;
+	}
+
+	xMailBox = pvPortMalloc( sizeof( struct sys_mbox_s ) + ( ulSize * sizeof( sys_mbox_cell_t ) ) );
+	if( xMailBox == NULL )
+	{
+		return ERR_MEM;
+	}
+
+	xMailBox->xSpace = xSemaphoreCreateCounting( ulSize, 0 );
+	if( xMailBox->xSpace == NULL )
+	{
+		vPortFree( xMailBox );
+		return ERR_MEM;
+	}
+
+	xMailBox->pxCells = ( sys_mbox_cell_t * ) ( xMailBox + 1 );
+	xMailBox->ulMask = ulSize - 1UL;
+	xMailBox->ulPostIndex = 0UL;
+	xMailBox->ulFetchIndex = 0UL;
+	xMailBox->xWaitingTask = NULL;
+	xMailBox->ulWaitingPosters = 0UL;
+	for( ulCell = 0UL; ulCell < ulSize; ulCell++ )
+	{
+		xMailBox->pxCells[ ulCell ].ulSequence = ulCell;
+	}
+
+	*pxMailBox = xMailBox;
+	SYS_STATS_INC_USED( mbox );
+	return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Deallocates a mailbox. If there are messages still present in the
+ *      mailbox when the mailbox is deallocated, it is an indication of a
+ *      programming error in lwIP and the developer should be notified.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *---------------------------------------------------------------------------*/
+void sys_mbox_free( sys_mbox_t *pxMailBox )
+{
+sys_mbox_t xMailBox = *pxMailBox;
+unsigned long ulMessagesWaiting;
+
+	ulMessagesWaiting = xMailBox->ulPostIndex - xMailBox->ulFetchIndex;
+	configASSERT( ( ulMessagesWaiting == 0 ) );
+
+	#if SYS_STATS
+	{
+		if( ulMessagesWaiting != 0UL )
+		{
+			SYS_STATS_INC( mbox.err );
+		}
+
+		SYS_STATS_DEC( mbox.used );
+	}
+	#endif /* SYS_STATS */
+
+	vSemaphoreDelete( xMailBox->xSpace );
+	vPortFree( xMailBox );
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_post
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Post the "msg" to the mailbox, blocking while it is full.  From an
+ *      ISR the message is dropped if the mailbox is full.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void *data              -- Pointer to data to post
+ *---------------------------------------------------------------------------*/
+void sys_mbox_post( sys_mbox_t *pxMailBox, void *pxMessageToPost )
+{
+sys_mbox_t xMailBox = *pxMailBox;
+portBASE_TYPE xPosted;
+
+	if( xInsideISR != pdFALSE )
+	{
+		if( prvMboxPost( xMailBox, pxMessageToPost ) == pdFALSE )
+		{
+			SYS_STATS_INC( mbox.err );
+		}
+		return;
+	}
+
+	while( prvMboxPost( xMailBox, pxMessageToPost ) == pdFALSE )
+	{
+		/* Announce ourselves before the second look, so that a fetch
+		racing with us either leaves room or gives xSpace. */
+		__atomic_add_fetch( &xMailBox->ulWaitingPosters, 1UL, __ATOMIC_SEQ_CST );
+		xPosted = prvMboxPost( xMailBox, pxMessageToPost );
+		if( xPosted == pdFALSE )
+		{
+			xSemaphoreTake( xMailBox->xSpace, portMAX_DELAY );
+		}
+		__atomic_sub_fetch( &xMailBox->ulWaitingPosters, 1UL, __ATOMIC_SEQ_CST );
+
+		if( xPosted != pdFALSE )
+		{
+			break;
+		}
+	}
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_trypost
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Try to post the "msg" to the mailbox.  Returns immediately with
+ *      error if cannot.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void *msg               -- Pointer to data to post
+ * Outputs:
+ *      err_t                   -- ERR_OK if message posted, else ERR_MEM
+ *                                  if not.
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_trypost( sys_mbox_t *pxMailBox, void *pxMessageToPost )
+{
+	if( prvMboxPost( *pxMailBox, pxMessageToPost ) == pdFALSE )
+	{
+		SYS_STATS_INC( mbox.err );
+		return ERR_MEM;
+	}
+
+	return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_fetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Blocks the thread until a message arrives in the mailbox, but does
+ *      not block the thread longer than "timeout" milliseconds.  The wait
+ *      is on the calling task's notification, which the posting side only
+ *      gives while the fetcher is parked on this mailbox.  From an ISR the
+ *      fetch never blocks.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ *      u32_t timeout           -- Number of milliseconds until timeout
+ * Outputs:
+ *      u32_t                   -- SYS_ARCH_TIMEOUT if timeout, else number
+ *                                  of milliseconds until received.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_fetch( sys_mbox_t *pxMailBox, void **ppvBuffer, u32_t ulTimeOut )
+{
+sys_mbox_t xMailBox = *pxMailBox;
+void *pvDummy;
+portTickType xStartTime, xElapsed, xTicksToWait;
+unsigned long ulReturn;
+
+	xStartTime = xTaskGetTickCount();
+
+	if( NULL == ppvBuffer )
+	{
+		ppvBuffer = &pvDummy;
+	}
+
+	if( ulTimeOut != 0UL )
+	{
+		xTicksToWait = ulTimeOut / portTICK_RATE_MS;
+	}
+	else
+	{
+		xTicksToWait = portMAX_DELAY;
+	}
+
+	for( ;; )
+	{
+		if( prvMboxFetch( xMailBox, ppvBuffer ) != pdFALSE )
+		{
+			break;
+		}
+
+		xElapsed = xTaskGetTickCount() - xStartTime;
+		if( ( xInsideISR != pdFALSE ) ||
+			( ( xTicksToWait != portMAX_DELAY ) && ( xElapsed >= xTicksToWait ) ) )
+		{
+			*ppvBuffer = NULL;
+			return SYS_ARCH_TIMEOUT;
+		}
+
+		/* Park, then look once more: a post that completed before we
+		parked is found here, one that completes after sees us parked. */
+		configASSERT( xMailBox->xWaitingTask == NULL );
+		xMailBox->xWaitingTask = xTaskGetCurrentTaskHandle();
+		__atomic_thread_fence( __ATOMIC_SEQ_CST );
+		if( prvMboxFetch( xMailBox, ppvBuffer ) != pdFALSE )
+		{
+			xMailBox->xWaitingTask = NULL;
+			break;
+		}
+
+		ulTaskNotifyTake( pdTRUE, ( xTicksToWait == portMAX_DELAY ) ? portMAX_DELAY : ( xTicksToWait - xElapsed ) );
+		xMailBox->xWaitingTask = NULL;
+	}
+
+	xElapsed = ( xTaskGetTickCount() - xStartTime ) * portTICK_RATE_MS;
+	ulReturn = xElapsed;
+	if( ( ulTimeOut == 0UL ) && ( ulReturn == 0UL ) )
+	{
+		ulReturn = 1UL;
+	}
+
+	return ulReturn;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_tryfetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Similar to sys_arch_mbox_fetch, but if message is not ready
+ *      immediately, we'll return with SYS_MBOX_EMPTY.  On success, 0 is
+ *      returned.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ * Outputs:
+ *      u32_t                   -- SYS_MBOX_EMPTY if no messages.  Otherwise,
+ *                                  return ERR_OK.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_tryfetch( sys_mbox_t *pxMailBox, void **ppvBuffer )
+{
+void *pvDummy;
+
+	if( ppvBuffer== NULL )
+	{
+		ppvBuffer = &pvDummy;
+	}
+
+	if( prvMboxFetch( *pxMailBox, ppvBuffer ) == pdFALSE )
+	{
+		return SYS_MBOX_EMPTY;
+	}
+
+	return ERR_OK;
+}
+
+#else /* LWIP_FREERTOS_LOCKFREE_MBOX */
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_mbox_new
  *---------------------------------------------------------------------------*
@@ -594,7 +995,6 @@ portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 	}
 	else
 	{
-		xil_printf("Queue is full\r\n");
 		/* The queue was already full. */
 		xReturn = ERR_MEM;
 		SYS_STATS_INC( mbox.err );
@@ -748,6 +1148,7 @@ portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
 	return ulReturn;
 }
+#endif /* LWIP_FREERTOS_LOCKFREE_MBOX */
 
 /*---------------------------------------------------------------------------*
  * Routine:  sys_sem_new
@@ -0,0 +1,731 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xaxidma_example_sg_batch.c
+ *
+ * This file demonstrates how to use the batched BD cache maintenance mode of
+ * the xaxidma driver on the Xilinx AXI DMA core (AXIDMA) configured in
+ * Scatter Gather Mode, and how to read the BD processing statistics of a
+ * ring.
+ *
+ * Batch mode is enabled on both rings before they are created, so the BD
+ * space is flushed with one range operation and every BD set given to or
+ * taken from hardware is handled with one or two cache range operations
+ * instead of one operation per BD. A set of packets is transmitted through
+ * the loopback widget with a single XAxiDma_BdRingToHw() call and received in
+ * polled mode, then the statistics of both rings are printed and cleared.
+ *
+ * This code assumes a loopback hardware widget is connected to the AXI DMA
+ * core for data packet loopback.
+ *
+ * To see the debug print, you need a Uart16550 or uartlite in your system,
+ * and please set "-DDEBUG" in your compiler options. You need to rebuild your
+ * software executable.
+ *
+ * Make sure that MEMORY_BASE is defined properly as per the HW system.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 9.4   esd  10/18/26 First release
+ *
+ * </pre>
+ *
+ * ***************************************************************************
+ */
+/***************************** Include Files *********************************/
+#include "xaxidma.h"
+#include "xparameters.h"
+#include "xdebug.h"
+
+#if defined(XPAR_UARTNS550_0_BASEADDR)
+#include "xuartns550_l.h"       /* to use uartns550 */
+#endif
+
+#ifndef DEBUG
+extern void xil_printf(const char *format, ...);
+#endif
+
+/******************** Constant Definitions **********************************/
+
+/*
+ * Device hardware build related constants.
+ */
+#define DMA_DEV_ID		XPAR_AXIDMA_0_DEVICE_ID
+
+#ifdef XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR		XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#elif XPAR_MIG7SERIES_0_BASEADDR
+#define DDR_BASE_ADDR	XPAR_MIG7SERIES_0_BASEADDR
+#elif XPAR_MIG_0_BASEADDR
+#define DDR_BASE_ADDR	XPAR_MIG_0_BASEADDR
+#elif XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR	XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#endif
+
+#ifndef DDR_BASE_ADDR
+#warning CHECK FOR THE VALID DDR ADDRESS IN XPARAMETERS.H, \
+		DEFAULT SET TO 0x01000000
+#define MEM_BASE_ADDR		0x01000000
+#else
+#define MEM_BASE_ADDR		(DDR_BASE_ADDR + 0x1000000)
+#endif
+
+#define TX_BD_SPACE_BASE	(MEM_BASE_ADDR)
+#define TX_BD_SPACE_HIGH	(MEM_BASE_ADDR + 0x00000FFF)
+#define RX_BD_SPACE_BASE	(MEM_BASE_ADDR + 0x00001000)
+#define RX_BD_SPACE_HIGH	(MEM_BASE_ADDR + 0x00001FFF)
+#define TX_BUFFER_BASE		(MEM_BASE_ADDR + 0x00020000)
+#define RX_BUFFER_BASE		(MEM_BASE_ADDR + 0x00030000)
+#define RX_BUFFER_HIGH		(MEM_BASE_ADDR + 0x0003FFFF)
+
+#define MAX_PKT_LEN		0x200
+#define NUMBER_OF_PACKETS 	0x10
+#define TEST_START_VALUE	0xC
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/************************** Function Prototypes ******************************/
+#if defined(XPAR_UARTNS550_0_BASEADDR)
+static void Uart550_Setup(void);
+#endif
+
+static int RxSetup(XAxiDma * AxiDmaInstPtr);
+static int TxSetup(XAxiDma * AxiDmaInstPtr);
+static int SendPackets(XAxiDma * AxiDmaInstPtr);
+static int CheckData(void);
+static int CheckDmaResult(XAxiDma * AxiDmaInstPtr);
+static void PrintStats(const char *Name, XAxiDma_BdRing * RingPtr);
+
+/************************** Variable Definitions *****************************/
+/*
+ * Device instance definitions
+ */
+XAxiDma AxiDma;
+
+/*
+ * Buffer for transmit packet.
+ */
+u32 *Packet = (u32 *) TX_BUFFER_BASE;
+
+/*****************************************************************************/
+/**
+*
+* Main function
+*
+* This function is the main entry of the test. It sets up the DMA engine in
+* batch mode, transmits a set of packets, verifies them after they are
+* received via the DMA loopback widget and prints the BD statistics of both
+* rings.
+*
+* @param	None
+*
+* @return	- XST_SUCCESS if test pass,
+* 		- XST_FAILURE if test fails
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+	XAxiDma_Config *Config;
+
+#if defined(XPAR_UARTNS550_0_BASEADDR)
+
+	Uart550_Setup();
+
+#endif
+
+	xil_printf("\r\n--- Entering main() --- \r\n");
+
+	Config = XAxiDma_LookupConfig(DMA_DEV_ID);
+	if (!Config) {
+		xil_printf("No config found for %d\r\n", DMA_DEV_ID);
+
+		return XST_FAILURE;
+	}
+
+	/* Initialize DMA engine */
+	Status = XAxiDma_CfgInitialize(&AxiDma, Config);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Initialization failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	if(!XAxiDma_HasSg(&AxiDma)) {
+		xil_printf("Device configured as simple mode \r\n");
+
+		return XST_FAILURE;
+	}
+
+	Status = TxSetup(&AxiDma);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = RxSetup(&AxiDma);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Send packets */
+	Status = SendPackets(&AxiDma);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Check DMA transfer result */
+	Status = CheckDmaResult(&AxiDma);
+
+	/* Report how the BD processing was batched, then start over */
+	PrintStats("TX", XAxiDma_GetTxRing(&AxiDma));
+	PrintStats("RX", XAxiDma_GetRxRing(&AxiDma));
+
+	XAxiDma_BdRingResetStats(XAxiDma_GetTxRing(&AxiDma));
+	XAxiDma_BdRingResetStats(XAxiDma_GetRxRing(&AxiDma));
+
+	xil_printf("Test %s\r\n",
+		(Status == XST_SUCCESS)? "passed":"failed");
+
+	xil_printf("--- Exiting main() --- \r\n");
+
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+#if defined(XPAR_UARTNS550_0_BASEADDR)
+/*****************************************************************************/
+/*
+*
+* Uart16550 setup routine, need to set baudrate to 9600 and data bits to 8
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None.
+*
+******************************************************************************/
+static void Uart550_Setup(void)
+{
+	/* Set the baudrate to be predictable
+	 */
+	XUartNs550_SetBaud(XPAR_UARTNS550_0_BASEADDR,
+			XPAR_XUARTNS550_CLOCK_HZ, 9600);
+
+	XUartNs550_SetLineControlReg(XPAR_UARTNS550_0_BASEADDR,
+			XUN_LCR_8_DATA_BITS);
+
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* This function sets up RX channel of the DMA engine in batch mode to be
+* ready for packet reception
+*
+* @param	AxiDmaInstPtr is the pointer to the instance of the DMA engine.
+*
+* @return	- XST_SUCCESS if the setup is successful
+*		- XST_FAILURE if setup is failure
+*
+* @note		None.
+*
+******************************************************************************/
+static int RxSetup(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *RxRingPtr;
+	int Delay = 0;
+	int Coalesce = 1;
+	int Status;
+	XAxiDma_Bd BdTemplate;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *BdCurPtr;
+	u32 BdCount;
+	u32 FreeBdCount;
+	UINTPTR RxBufferPtr;
+	u32 Index;
+
+	RxRingPtr = XAxiDma_GetRxRing(AxiDmaInstPtr);
+
+	/* Disable all RX interrupts before RxBD space setup */
+	XAxiDma_BdRingIntDisable(RxRingPtr, XAXIDMA_IRQ_ALL_MASK);
+
+	/* Set delay and coalescing */
+	XAxiDma_BdRingSetCoalesce(RxRingPtr, Coalesce, Delay);
+
+	/*
+	 * Enable batch mode before the ring is created so the BD space is
+	 * flushed with a single range operation
+	 */
+	Status = XAxiDma_BdRingSetBatchMode(RxRingPtr, TRUE);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Rx batch mode failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Setup Rx BD space */
+	BdCount = XAxiDma_BdRingCntCalc(XAXIDMA_BD_MINIMUM_ALIGNMENT,
+				RX_BD_SPACE_HIGH - RX_BD_SPACE_BASE + 1);
+
+	Status = XAxiDma_BdRingCreate(RxRingPtr, RX_BD_SPACE_BASE,
+				RX_BD_SPACE_BASE,
+				XAXIDMA_BD_MINIMUM_ALIGNMENT, BdCount);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Setup an all-zero BD as the template for the Rx channel.
+	 */
+	XAxiDma_BdClear(&BdTemplate);
+
+	Status = XAxiDma_BdRingClone(RxRingPtr, &BdTemplate);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Attach buffers to RxBD ring so we are ready to receive packets */
+	FreeBdCount = XAxiDma_BdRingGetFreeCnt(RxRingPtr);
+	Status = XAxiDma_BdRingAlloc(RxRingPtr, FreeBdCount, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	BdCurPtr = BdPtr;
+	RxBufferPtr = RX_BUFFER_BASE;
+
+	for (Index = 0; Index < FreeBdCount; Index++) {
+
+		Status = XAxiDma_BdSetBufAddr(BdCurPtr, RxBufferPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Rx set buffer addr %x on BD %x failed %d\r\n",
+			    (unsigned int)RxBufferPtr,
+			    (unsigned int)(UINTPTR)BdCurPtr, Status);
+
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_BdSetLength(BdCurPtr, MAX_PKT_LEN,
+				RxRingPtr->MaxTransferLen);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Rx set length %d on BD %x failed %d\r\n",
+			    MAX_PKT_LEN, (unsigned int)(UINTPTR)BdCurPtr, Status);
+
+			return XST_FAILURE;
+		}
+
+		/* Receive BDs do not need to set anything for the control
+		 * The hardware will set the SOF/EOF bits per stream status
+		 */
+		XAxiDma_BdSetCtrl(BdCurPtr, 0);
+		XAxiDma_BdSetId(BdCurPtr, RxBufferPtr);
+
+		RxBufferPtr += MAX_PKT_LEN;
+		if (RxBufferPtr > RX_BUFFER_HIGH - MAX_PKT_LEN + 1) {
+			RxBufferPtr = RX_BUFFER_BASE;
+		}
+
+		BdCurPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(RxRingPtr, BdCurPtr);
+	}
+
+	/* All RX BDs are handed to hardware as one set */
+	Status = XAxiDma_BdRingToHw(RxRingPtr, FreeBdCount, BdPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Start RX DMA channel */
+	Status = XAxiDma_BdRingStart(RxRingPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up the TX channel of a DMA engine in batch mode to be
+* ready for packet transmission
+*
+* @param	AxiDmaInstPtr is the instance pointer to the DMA engine.
+*
+* @return	- XST_SUCCESS if the setup is successful
+*		- XST_FAILURE if setup is failure
+*
+* @note		None.
+*
+******************************************************************************/
+static int TxSetup(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *TxRingPtr;
+	XAxiDma_Bd BdTemplate;
+	int Delay = 0;
+	int Coalesce = 1;
+	int Status;
+	u32 BdCount;
+
+	TxRingPtr = XAxiDma_GetTxRing(AxiDmaInstPtr);
+
+	/* Disable all TX interrupts before Tx BD space setup */
+	XAxiDma_BdRingIntDisable(TxRingPtr, XAXIDMA_IRQ_ALL_MASK);
+
+	/* Set TX delay and coalesce */
+	XAxiDma_BdRingSetCoalesce(TxRingPtr, Coalesce, Delay);
+
+	Status = XAxiDma_BdRingSetBatchMode(TxRingPtr, TRUE);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Tx batch mode failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Setup Tx BD space  */
+	BdCount = XAxiDma_BdRingCntCalc(XAXIDMA_BD_MINIMUM_ALIGNMENT,
+				TX_BD_SPACE_HIGH - TX_BD_SPACE_BASE + 1);
+
+	Status = XAxiDma_BdRingCreate(TxRingPtr, TX_BD_SPACE_BASE,
+				TX_BD_SPACE_BASE,
+				XAXIDMA_BD_MINIMUM_ALIGNMENT, BdCount);
+	if (Status != XST_SUCCESS) {
+		xil_printf("failed create BD ring in txsetup\r\n");
+
+		return XST_FAILURE;
+	}
+
+	/*
+	 * We create an all-zero BD as the template.
+	 */
+	XAxiDma_BdClear(&BdTemplate);
+
+	Status = XAxiDma_BdRingClone(TxRingPtr, &BdTemplate);
+	if (Status != XST_SUCCESS) {
+		xil_printf("failed bdring clone in txsetup %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Start the TX channel */
+	Status = XAxiDma_BdRingStart(TxRingPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("failed start bdring txsetup %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function transmits NUMBER_OF_PACKETS packets, one per BD, with a single
+* XAxiDma_BdRingToHw() call.
+*
+* @param	AxiDmaInstPtr points to the DMA engine instance
+*
+* @return	- XST_SUCCESS if the DMA accepts the packets successfully,
+*		- XST_FAILURE if failure.
+*
+* @note		None.
+*
+******************************************************************************/
+static int SendPackets(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *TxRingPtr;
+	u8 *TxPacket;
+	u8 Value;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *CurBdPtr;
+	UINTPTR BufAddr;
+	int Status;
+	int Index;
+
+	/* Create pattern in the packets to transmit */
+	TxPacket = (u8 *) Packet;
+
+	Value = TEST_START_VALUE;
+
+	for (Index = 0; Index < MAX_PKT_LEN * NUMBER_OF_PACKETS; Index++) {
+		TxPacket[Index] = Value;
+
+		Value = (Value + 1) & 0xFF;
+	}
+
+	/* Flush the SrcBuffer before the DMA transfer, in case the Data Cache
+	 * is enabled
+	 */
+	Xil_DCacheFlushRange((UINTPTR)TxPacket, MAX_PKT_LEN *
+							NUMBER_OF_PACKETS);
+
+	TxRingPtr = XAxiDma_GetTxRing(AxiDmaInstPtr);
+
+	/* Allocate BDs */
+	Status = XAxiDma_BdRingAlloc(TxRingPtr, NUMBER_OF_PACKETS, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Each packet is a frame of its own */
+	BufAddr = (UINTPTR)Packet;
+	CurBdPtr = BdPtr;
+
+	for (Index = 0; Index < NUMBER_OF_PACKETS; Index++) {
+
+		Status = XAxiDma_BdSetBufAddr(CurBdPtr, BufAddr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Tx set buffer addr %x on BD %x failed %d\r\n",
+			    (unsigned int)BufAddr,
+			    (unsigned int)(UINTPTR)CurBdPtr, Status);
+
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_BdSetLength(CurBdPtr, MAX_PKT_LEN,
+				TxRingPtr->MaxTransferLen);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Tx set length %d on BD %x failed %d\r\n",
+			    MAX_PKT_LEN, (unsigned int)(UINTPTR)CurBdPtr, Status);
+
+			return XST_FAILURE;
+		}
+
+#if (XPAR_AXIDMA_0_SG_INCLUDE_STSCNTRL_STRM == 1)
+		Status = XAxiDma_BdSetAppWord(CurBdPtr,
+		    XAXIDMA_LAST_APPWORD, MAX_PKT_LEN);
+
+		/* If Set app length failed, it is not fatal
+		 */
+		if (Status != XST_SUCCESS) {
+			xil_printf("Set app word failed with %d\r\n", Status);
+		}
+#endif
+
+		XAxiDma_BdSetCtrl(CurBdPtr, XAXIDMA_BD_CTRL_TXSOF_MASK |
+						XAXIDMA_BD_CTRL_TXEOF_MASK);
+		XAxiDma_BdSetId(CurBdPtr, BufAddr);
+
+		BufAddr += MAX_PKT_LEN;
+		CurBdPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(TxRingPtr, CurBdPtr);
+	}
+
+	/*
+	 * Give the whole set to DMA to kick off the transmission. In batch mode
+	 * the set is flushed with one cache range operation.
+	 */
+	Status = XAxiDma_BdRingToHw(TxRingPtr, NUMBER_OF_PACKETS, BdPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("to hw failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks data buffer after the DMA transfer is finished.
+*
+* @param	None
+*
+* @return	- XST_SUCCESS if validation is successful
+*		- XST_FAILURE if validation is failure.
+*
+* @note		None.
+*
+******************************************************************************/
+static int CheckData(void)
+{
+	u8 *RxPacket;
+	int Index;
+	u8 Value;
+
+	RxPacket = (u8 *) RX_BUFFER_BASE;
+	Value = TEST_START_VALUE;
+
+	/* Invalidate the DestBuffer before receiving the data, in case the
+	 * Data Cache is enabled
+	 */
+	Xil_DCacheInvalidateRange((UINTPTR)RxPacket, MAX_PKT_LEN *
+							NUMBER_OF_PACKETS);
+
+	for (Index = 0; Index < MAX_PKT_LEN * NUMBER_OF_PACKETS; Index++) {
+		if (RxPacket[Index] != Value) {
+			xil_printf("Data error %d: %x/%x\r\n", Index,
+			    (unsigned int)RxPacket[Index], (unsigned int)Value);
+
+			return XST_FAILURE;
+		}
+		Value = (Value + 1) & 0xFF;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function polls until the DMA transactions are finished, checks data,
+* and gives the RX BDs back to hardware.
+*
+* Every BD set retrieved from hardware is freed before the next poll, so the
+* count and pointer passed to XAxiDma_BdRingFree() always describe one set.
+*
+* @param	AxiDmaInstPtr points to the DMA engine instance
+*
+* @return	- XST_SUCCESS if DMA transfer is successful and data is correct
+*		- XST_FAILURE if failure
+*
+* @note		None.
+*
+******************************************************************************/
+static int CheckDmaResult(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *TxRingPtr;
+	XAxiDma_BdRing *RxRingPtr;
+	XAxiDma_Bd *BdPtr;
+	u32 ProcessedBdCount = 0;
+	u32 BdCount;
+	u32 FreeBdCount;
+	int Status;
+
+	TxRingPtr = XAxiDma_GetTxRing(AxiDmaInstPtr);
+	RxRingPtr = XAxiDma_GetRxRing(AxiDmaInstPtr);
+
+	/* Wait until the TX transactions are done */
+	while (ProcessedBdCount < NUMBER_OF_PACKETS) {
+		BdCount = XAxiDma_BdRingFromHw(TxRingPtr, XAXIDMA_ALL_BDS,
+								&BdPtr);
+		if (BdCount == 0) {
+			continue;
+		}
+
+		Status = XAxiDma_BdRingFree(TxRingPtr, BdCount, BdPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("free tx bd failed %d\r\n", Status);
+			return XST_FAILURE;
+		}
+
+		ProcessedBdCount += BdCount;
+	}
+
+	/* Wait until the data has been received by the Rx channel */
+	ProcessedBdCount = 0;
+
+	while (ProcessedBdCount < NUMBER_OF_PACKETS) {
+		BdCount = XAxiDma_BdRingFromHw(RxRingPtr, XAXIDMA_ALL_BDS,
+								&BdPtr);
+		if (BdCount == 0) {
+			continue;
+		}
+
+		Status = XAxiDma_BdRingFree(RxRingPtr, BdCount, BdPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("free rx bd failed %d\r\n", Status);
+			return XST_FAILURE;
+		}
+
+		ProcessedBdCount += BdCount;
+	}
+
+	/* Check received data */
+	if (CheckData() != XST_SUCCESS) {
+
+		return XST_FAILURE;
+	}
+
+	/* Return processed BDs to RX channel so we are ready to receive new
+	 * packets:
+	 *    - Allocate all free RX BDs
+	 *    - Pass the BDs to RX channel
+	 * The BDs still carry their buffer and length from RxSetup().
+	 */
+	FreeBdCount = XAxiDma_BdRingGetFreeCnt(RxRingPtr);
+	Status = XAxiDma_BdRingAlloc(RxRingPtr, FreeBdCount, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("bd alloc failed\r\n");
+		return XST_FAILURE;
+	}
+
+	Status = XAxiDma_BdRingToHw(RxRingPtr, FreeBdCount, BdPtr);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the BD processing statistics of a ring.
+*
+* @param	Name is the name of the ring to print.
+* @param	RingPtr is a pointer to the descriptor ring instance.
+*
+* @return	None.
+*
+* @note		ToHwMaxBdCnt and FromHwMaxBdCnt show how many BDs were
+*		handled per call; CacheOps is the number of BD cache range
+*		operations done in batch mode.
+*
+******************************************************************************/
+static void PrintStats(const char *Name, XAxiDma_BdRing * RingPtr)
+{
+	XAxiDma_BdRingStats Stats;
+
+	XAxiDma_BdRingGetStats(RingPtr, &Stats);
+
+	xil_printf("%s ring: batch mode %s\r\n", Name,
+		XAxiDma_BdRingIsBatchMode(RingPtr) ? "on" : "off");
+	xil_printf("  ToHw   calls %d, BDs %d, max BDs per call %d\r\n",
+		Stats.ToHwCalls, Stats.ToHwBdCnt, Stats.ToHwMaxBdCnt);
+	xil_printf("  FromHw calls %d, BDs %d, max BDs per call %d\r\n",
+		Stats.FromHwCalls, Stats.FromHwBdCnt, Stats.FromHwMaxBdCnt);
+	xil_printf("  BD cache range operations %d\r\n", Stats.CacheOps);
+}
@@ -66,7 +66,10 @@
 *						 int RingIndex)
 * 7.00a srt  06/18/12  All the APIs changed in v6_00_a are reverted back for
 *		       backward compatibility.
-*
+* 9.4   esd  10/18/26  Added batched BD cache maintenance mode, in which
+*		       XAxiDma_BdRingToHw() and XAxiDma_BdRingFromHw() do one
+*		       cache range operation per BD set instead of one per BD,
+*		       and per-ring BD processing statistics.
 *
 * </pre>
 ******************************************************************************/
@@ -82,6 +85,15 @@
  */
 #define XAXIDMA_STOP_TIMEOUT	500000   /* about 100 milliseconds on 100MHz */
 
+/* Maximum number of BDs invalidated with one cache range operation by
+ * XAxiDma_BdRingFromHw() in batch mode. Retrieval stops at the first BD not
+ * completed by hardware, so the completed BDs are looked up in blocks rather
+ * than invalidating the whole work group up front.
+ */
+#ifndef XAXIDMA_BATCH_BDS
+#define XAXIDMA_BATCH_BDS	32
+#endif
+
 /**************************** Type Definitions *******************************/
 
 
@@ -166,6 +178,9 @@
 
 /************************** Function Prototypes ******************************/
 
+static void XAxiDma_BdRingCacheSet(XAxiDma_BdRing * RingPtr,
+		XAxiDma_Bd * BdSetPtr, int NumBd, int Flush);
+
 /************************** Variable Definitions *****************************/
 
 
@@ -433,7 +448,9 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 		    (((u32)(RingPtr->HasDRE)) << XAXIDMA_BD_HAS_DRE_SHIFT) |
 		    RingPtr->DataWidth);
 
-		XAXIDMA_CACHE_FLUSH(BdVirtAddr);
+		if (!RingPtr->BatchMode) {
+			XAXIDMA_CACHE_FLUSH(BdVirtAddr);
+		}
 		BdVirtAddr += RingPtr->Separation;
 		BdPhysAddr += RingPtr->Separation;
 	}
@@ -468,6 +485,13 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	RingPtr->HwTail = (XAxiDma_Bd *) VirtAddr;
 	RingPtr->PostHead = (XAxiDma_Bd *) VirtAddr;
 	RingPtr->BdaRestart = (XAxiDma_Bd *) PhysAddr;
+	memset(&RingPtr->Stats, 0, sizeof(XAxiDma_BdRingStats));
+
+	/* In batch mode the whole ring is flushed at once */
+	if (RingPtr->BatchMode) {
+		XAxiDma_BdRingCacheSet(RingPtr, RingPtr->FreeHead, BdCount,
+				       TRUE);
+	}
 
 	return XST_SUCCESS;
 }
@@ -1064,8 +1088,12 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 		BdSts &=  ~XAXIDMA_BD_STS_COMPLETE_MASK;
 		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
 
-		/* Flush the current BD so DMA core could see the updates */
-		XAXIDMA_CACHE_FLUSH(CurBdPtr);
+		/* Flush the current BD so DMA core could see the updates. In
+		 * batch mode the whole set is flushed after the last BD.
+		 */
+		if (!RingPtr->BatchMode) {
+			XAXIDMA_CACHE_FLUSH(CurBdPtr);
+		}
 
 		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr, CurBdPtr));
 		BdCr = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
@@ -1096,7 +1124,12 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 	XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
 
 	/* Flush the last BD so DMA core could see the updates */
-	XAXIDMA_CACHE_FLUSH(CurBdPtr);
+	if (RingPtr->BatchMode) {
+		XAxiDma_BdRingCacheSet(RingPtr, BdSetPtr, NumBd, TRUE);
+	}
+	else {
+		XAXIDMA_CACHE_FLUSH(CurBdPtr);
+	}
 	DATA_SYNC;
 
 	/* This set has completed pre-processing, adjust ring pointers and
@@ -1107,6 +1140,12 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 	RingPtr->HwTail = CurBdPtr;
 	RingPtr->HwCnt += NumBd;
 
+	RingPtr->Stats.ToHwCalls++;
+	RingPtr->Stats.ToHwBdCnt += (u32)NumBd;
+	if ((u32)NumBd > RingPtr->Stats.ToHwMaxBdCnt) {
+		RingPtr->Stats.ToHwMaxBdCnt = (u32)NumBd;
+	}
+
 	/* If it is running, signal the engine to begin processing */
 	if (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED) {
 			if (RingPtr->IsRxChannel) {
@@ -1219,12 +1258,14 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 	XAxiDma_Bd *CurBdPtr;
 	int BdCount;
 	int BdPartialCount;
+	int BdInvalidCnt;
 	u32 BdSts;
 	u32 BdCr;
 
 	CurBdPtr = RingPtr->HwHead;
 	BdCount = 0;
 	BdPartialCount = 0;
+	BdInvalidCnt = 0;
 	BdSts = 0;
 	BdCr = 0;
 
@@ -1248,8 +1289,23 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 	 */
 
 	while (BdCount < BdLimit) {
-		/* Read the status */
-		XAXIDMA_CACHE_INVALIDATE(CurBdPtr);
+		/* Read the status. In batch mode the next block of BDs is
+		 * invalidated with a single range operation once the
+		 * previously invalidated block has been consumed.
+		 */
+		if (!RingPtr->BatchMode) {
+			XAXIDMA_CACHE_INVALIDATE(CurBdPtr);
+		}
+		else if (BdInvalidCnt == 0) {
+			BdInvalidCnt = BdLimit - BdCount;
+			if (BdInvalidCnt > XAXIDMA_BATCH_BDS) {
+				BdInvalidCnt = XAXIDMA_BATCH_BDS;
+			}
+			XAxiDma_BdRingCacheSet(RingPtr, CurBdPtr,
+					       BdInvalidCnt, FALSE);
+		}
+		BdInvalidCnt--;
+
 		BdSts = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_STS_OFFSET);
 		BdCr = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
 
@@ -1301,6 +1357,12 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 		RingPtr->PostCnt += BdCount;
 		XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->HwHead, BdCount);
 
+		RingPtr->Stats.FromHwCalls++;
+		RingPtr->Stats.FromHwBdCnt += (u32)BdCount;
+		if ((u32)BdCount > RingPtr->Stats.FromHwMaxBdCnt) {
+			RingPtr->Stats.FromHwMaxBdCnt = (u32)BdCount;
+		}
+
 		return BdCount;
 	}
 	else {
@@ -1369,6 +1431,147 @@ int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
 
 	return XST_SUCCESS;
 }
+/*****************************************************************************/
+/**
+ * Enable or disable batched cache maintenance of the BDs in a ring.
+ *
+ * By default, XAxiDma_BdRingToHw() flushes and XAxiDma_BdRingFromHw()
+ * invalidates every BD with its own cache range operation. In batch mode
+ * the BDs of a set are handled with a single range operation covering the
+ * whole span of the set, or with two operations if the set wraps around the
+ * end of the ring. BDs handed to hardware are always contiguous in the ring
+ * and each BD occupies its own cache lines (see XAXIDMA_BD_MINIMUM_ALIGNMENT),
+ * so no BD owned by software shares a cache line with one owned by hardware.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	Enable is TRUE to enable batch mode, FALSE to disable it.
+ *
+ * @return
+ *		- XST_SUCCESS if the mode was changed.
+ *		- XST_INVALID_PARAM if the BD separation of the ring is not a
+ *		multiple of XAXIDMA_BD_MINIMUM_ALIGNMENT.
+ *
+ * @note	The mode may be changed at any time, including before
+ *		XAxiDma_BdRingCreate(), in which case the ring is flushed with
+ *		one range operation when it is created.
+ *
+ *		This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingSetBatchMode(XAxiDma_BdRing * RingPtr, int Enable)
+{
+	if (Enable && (RingPtr->AllCnt != 0) &&
+	    ((RingPtr->Separation % XAXIDMA_BD_MINIMUM_ALIGNMENT) != 0)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingSetBatchMode: BD "
+			"separation %d not cache line aligned\r\n",
+			(int)RingPtr->Separation);
+
+		return XST_INVALID_PARAM;
+	}
+
+	RingPtr->BatchMode = Enable ? TRUE : FALSE;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Retrieve the BD processing statistics of a ring.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	StatsPtr points to the structure the statistics are copied to.
+ *
+ * @return	None
+ *
+ * @note	The average number of BDs processed per call can be computed
+ *		as ToHwBdCnt / ToHwCalls and FromHwBdCnt / FromHwCalls.
+ *
+ *		This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+void XAxiDma_BdRingGetStats(XAxiDma_BdRing * RingPtr,
+			    XAxiDma_BdRingStats *StatsPtr)
+{
+	memcpy(StatsPtr, &RingPtr->Stats, sizeof(XAxiDma_BdRingStats));
+}
+
+/*****************************************************************************/
+/**
+ * Clear the BD processing statistics of a ring.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ *
+ * @return	None
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+void XAxiDma_BdRingResetStats(XAxiDma_BdRing * RingPtr)
+{
+	memset(&RingPtr->Stats, 0, sizeof(XAxiDma_BdRingStats));
+}
+
+/*****************************************************************************/
+/**
+ * Flush or invalidate a set of contiguous BDs with as few cache range
+ * operations as possible. A set that wraps around the end of the ring is
+ * handled as two ranges.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	BdSetPtr is the first BD of the set.
+ * @param	NumBd is the number of BDs in the set.
+ * @param	Flush is TRUE to flush the set, FALSE to invalidate it.
+ *
+ * @return	None
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+static void XAxiDma_BdRingCacheSet(XAxiDma_BdRing * RingPtr,
+		XAxiDma_Bd * BdSetPtr, int NumBd, int Flush)
+{
+#ifndef __aarch64__
+	UINTPTR Start = (UINTPTR)BdSetPtr;
+	UINTPTR RingEnd = RingPtr->LastBdAddr + RingPtr->Separation;
+	u32 Len = (u32)(RingPtr->Separation * NumBd);
+	u32 HeadLen;
+
+	if ((Start + Len) > RingEnd) {
+		HeadLen = (u32)(RingEnd - Start);
+		if (Flush) {
+			Xil_DCacheFlushRange(Start, HeadLen);
+			Xil_DCacheFlushRange(RingPtr->FirstBdAddr,
+					     Len - HeadLen);
+		}
+		else {
+			Xil_DCacheInvalidateRange(Start, HeadLen);
+			Xil_DCacheInvalidateRange(RingPtr->FirstBdAddr,
+						  Len - HeadLen);
+		}
+		RingPtr->Stats.CacheOps += 2U;
+	}
+	else {
+		if (Flush) {
+			Xil_DCacheFlushRange(Start, Len);
+		}
+		else {
+			Xil_DCacheInvalidateRange(Start, Len);
+		}
+		RingPtr->Stats.CacheOps++;
+	}
+#else
+	(void)RingPtr;
+	(void)BdSetPtr;
+	(void)NumBd;
+	(void)Flush;
+#endif
+}
+
 /*****************************************************************************/
 /**
  * Check the internal data structures of the BD ring for the provided channel.
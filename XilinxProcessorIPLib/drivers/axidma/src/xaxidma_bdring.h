@@ -68,6 +68,14 @@
 * 7.00a srt  06/18/12  All the APIs changed in v6_00_a are reverted back for
 *		       backward compatibility.
 * 9.2   vak  15/04/16  Fixed the compilation warnings in axidma driver
+* 9.4   esd  10/18/26  Added batched BD cache maintenance mode and per-ring
+*		       BD processing statistics.
+*		      - New APIs
+*			* XAxiDma_BdRingSetBatchMode(XAxiDma_BdRing * RingPtr,
+*						int Enable)
+*			* XAxiDma_BdRingGetStats(XAxiDma_BdRing * RingPtr,
+*						XAxiDma_BdRingStats *StatsPtr)
+*			* XAxiDma_BdRingResetStats(XAxiDma_BdRing * RingPtr)
 *
 * </pre>
 *
@@ -100,6 +108,23 @@ extern "C" {
 
 /**************************** Type Definitions *******************************/
 
+/** BD processing statistics of a ring. The counters are updated by
+ * XAxiDma_BdRingToHw() and XAxiDma_BdRingFromHw() and can be used to find
+ * how well BD processing is batched per call.
+ */
+typedef struct {
+	u32 ToHwCalls;		/**< Number of non-empty XAxiDma_BdRingToHw()
+				     calls */
+	u32 ToHwBdCnt;		/**< Total BDs enqueued to hardware */
+	u32 ToHwMaxBdCnt;	/**< Largest BD set enqueued in one call */
+	u32 FromHwCalls;	/**< Number of XAxiDma_BdRingFromHw() calls
+				     that returned BDs */
+	u32 FromHwBdCnt;	/**< Total BDs retrieved from hardware */
+	u32 FromHwMaxBdCnt;	/**< Largest BD set retrieved in one call */
+	u32 CacheOps;		/**< Number of BD cache range operations
+				     done in batch mode */
+} XAxiDma_BdRingStats;
+
 /** Container structure for descriptor storage control. If address translation
  * is enabled, then all addresses and pointers excluding FirstBdPhysAddr are
  * expressed in terms of the virtual address.
@@ -133,6 +158,9 @@ typedef struct {
 	int PostCnt;		/**< Number of BDs in post-work group */
 	int AllCnt;		/**< Total Number of BDs for channel */
 	int RingIndex;		/**< Ring Index */
+	int BatchMode;		/**< Whether BD cache maintenance is done once
+				     per BD set instead of once per BD */
+	XAxiDma_BdRingStats Stats; /**< BD processing statistics */
 } XAxiDma_BdRing;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -217,6 +245,25 @@ typedef struct {
 *****************************************************************************/
 #define XAxiDma_BdRingGetFreeCnt(RingPtr)  ((RingPtr)->FreeCnt)
 
+/****************************************************************************/
+/**
+* Check whether batched BD cache maintenance is enabled for a BD ring.
+*
+* @param	RingPtr is the BD ring to operate on.
+*
+* @return
+*		- TRUE if BD cache maintenance is done once per BD set
+*		- FALSE if BD cache maintenance is done once per BD
+*
+* @note
+* 		C-style signature:
+*		int XAxiDma_BdRingIsBatchMode(XAxiDma_BdRing* RingPtr)
+*		This function is used only when system is configured as SG mode
+*
+*****************************************************************************/
+#define XAxiDma_BdRingIsBatchMode(RingPtr)  \
+	(((RingPtr)->BatchMode) ? TRUE : FALSE)
+
 
 /****************************************************************************/
 /**
@@ -514,6 +561,10 @@ int XAxiDma_BdRingStart(XAxiDma_BdRing * RingPtr);
 int XAxiDma_BdRingSetCoalesce(XAxiDma_BdRing * RingPtr, u32 Counter, u32 Timer);
 void XAxiDma_BdRingGetCoalesce(XAxiDma_BdRing * RingPtr,
 		u32 *CounterPtr, u32 *TimerPtr);
+int XAxiDma_BdRingSetBatchMode(XAxiDma_BdRing * RingPtr, int Enable);
+void XAxiDma_BdRingGetStats(XAxiDma_BdRing * RingPtr,
+		XAxiDma_BdRingStats *StatsPtr);
+void XAxiDma_BdRingResetStats(XAxiDma_BdRing * RingPtr);
 
 /* The following functions are for debug only
  */
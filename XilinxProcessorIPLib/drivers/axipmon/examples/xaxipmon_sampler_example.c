@@ -0,0 +1,290 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+* @file xaxipmon_sampler_example.c
+*
+* This file contains an example showing how to collect a time series of AXI
+* Performance Monitor samples with the sampler in xaxipmon_sampler.c.
+*
+* Metric Counter 0 and 1 of slot 1 are set up to count write and read bytes.
+* The sampler stores one sample per sample interval from the interrupt
+* handler, and the main loop exports the samples to a memory buffer and
+* prints the derived bandwidth of the slot.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 6.5   esd    10/18/26 First release
+* </pre>
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xaxipmon_sampler.h"
+#include "xparameters.h"
+#include "xstatus.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+#include "xintc.h"
+#else
+#include "xscugic.h"
+#endif
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+#ifdef XPAR_INTC_0_DEVICE_ID
+#define INTC				XIntc
+#define INTC_HANDLER			XIntc_InterruptHandler
+#define AXIPMON_DEVICE_ID		XPAR_AXIPMON_0_DEVICE_ID
+#define INTC_DEVICE_ID			XPAR_INTC_0_DEVICE_ID
+#define INTC_AXIPMON_INTERRUPT_ID	XPAR_INTC_0_AXIPMON_0_VEC_ID
+#else
+#define INTC				XScuGic
+#define INTC_HANDLER			XScuGic_InterruptHandler
+#define AXIPMON_DEVICE_ID		XPAR_AXIPMON_0_DEVICE_ID
+#define INTC_DEVICE_ID			XPAR_SCUGIC_0_DEVICE_ID
+#define INTC_AXIPMON_INTERRUPT_ID	XPAR_XAPMPS_0_INTR
+#endif
+
+#define SLOT_ID			1U		/* Monitor slot to sample */
+#define APM_CLK_FREQ_HZ		100000000U	/* Monitor clock frequency */
+#define SAMPLE_INTERVAL		(APM_CLK_FREQ_HZ / 1000U) /* 1 ms */
+#define RING_ENTRIES		16U		/* Sample ring size */
+#define NUM_SAMPLES		64U		/* Samples to collect */
+
+/************************** Function Prototypes *****************************/
+
+int AxiPmonSamplerExample(u16 AxiPmonDeviceId);
+
+static int AxiPmonSetupIntrSystem(INTC *IntcInstancePtr,
+				XAxiPmon_Sampler *SamplerPtr, u16 IntrId);
+
+/************************** Variable Definitions ****************************/
+
+static XAxiPmon AxiPmonInst;		/* AXI Performance Monitor instance */
+static XAxiPmon_Sampler Sampler;	/* Sampler instance */
+static XAxiPmon_Sample Ring[RING_ENTRIES];	/* Sample ring */
+static XAxiPmon_Sample Log[NUM_SAMPLES];	/* Exported samples */
+static XAxiPmon_MemSink MemSink;	/* Memory buffer sink */
+INTC Intc;	/* The Instance of the Interrupt Controller Driver */
+
+/****************************************************************************/
+/**
+*
+* Main function that invokes the example in this file.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if the example has completed successfully.
+*		- XST_FAILURE if the example has failed.
+*
+* @note		None.
+*
+*****************************************************************************/
+int main(void)
+{
+	int Status;
+
+	Status = AxiPmonSamplerExample(AXIPMON_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("AXI Performance Monitor Sampler example failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran AXI Performance Monitor Sampler "
+							"example\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function collects NUM_SAMPLES samples of the write and read byte
+* counts of SLOT_ID and prints the bandwidth of every sample.
+*
+* @param	AxiPmonDeviceId is the XPAR_<AXIPMON_instance>_DEVICE_ID value
+*		from xparameters.h.
+*
+* @return
+*		- XST_SUCCESS if the example has completed successfully.
+*		- XST_FAILURE if the example has failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int AxiPmonSamplerExample(u16 AxiPmonDeviceId)
+{
+	int Status;
+	u32 Index;
+	XAxiPmon_Config *ConfigPtr;
+	XAxiPmon_SlotRates Rates;
+
+	ConfigPtr = XAxiPmon_LookupConfig(AxiPmonDeviceId);
+	if (ConfigPtr == NULL) {
+		return XST_FAILURE;
+	}
+	XAxiPmon_CfgInitialize(&AxiPmonInst, ConfigPtr,
+				ConfigPtr->BaseAddress);
+
+	XAxiPmon_SetMetrics(&AxiPmonInst, SLOT_ID, XAPM_METRIC_SET_2,
+				XAPM_METRIC_COUNTER_0);
+	XAxiPmon_SetMetrics(&AxiPmonInst, SLOT_ID, XAPM_METRIC_SET_3,
+				XAPM_METRIC_COUNTER_1);
+
+	Status = XAxiPmon_SamplerInitialize(&Sampler, &AxiPmonInst, Ring,
+					RING_ENTRIES, APM_CLK_FREQ_HZ);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XAxiPmon_MemSinkInitialize(&MemSink, Log, NUM_SAMPLES, 0U);
+	XAxiPmon_SamplerSetSink(&Sampler, XAxiPmon_SinkMemWrite, &MemSink);
+
+	Status = AxiPmonSetupIntrSystem(&Intc, &Sampler,
+					INTC_AXIPMON_INTERRUPT_ID);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XAxiPmon_SamplerStart(&Sampler, SAMPLE_INTERVAL);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Application for which Metrics have to be computed runs here;
+	 * the ring is drained into the log meanwhile.
+	 */
+	while (MemSink.Count < NUM_SAMPLES) {
+		(void)XAxiPmon_SamplerFlush(&Sampler, RING_ENTRIES);
+	}
+
+	(void)XAxiPmon_SamplerStop(&Sampler);
+
+	for (Index = 0U; Index < MemSink.Count; Index++) {
+		XAxiPmon_SamplerGetRates(&Sampler, &Log[Index], SLOT_ID,
+								&Rates);
+		xil_printf("Sample %d: write %d KB/s read %d KB/s\r\n",
+				Log[Index].Sequence,
+				(u32)(Rates.WrBytesPerSec / 1024U),
+				(u32)(Rates.RdBytesPerSec / 1024U));
+	}
+
+	xil_printf("Dropped samples: %d\r\n",
+				XAxiPmon_SamplerGetDropped(&Sampler));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function connects the sampler interrupt handler to the interrupt
+* controller.
+*
+* @param	IntcInstancePtr is a reference to the Interrupt Controller
+*		driver Instance
+* @param	SamplerPtr is a reference to the XAxiPmon_Sampler Instance
+* @param	IntrId is XPAR_<INTC_instance>_<AXIPMON_instance>_INTERRUPT_INTR
+*		value from xparameters.h
+*
+* @return
+*		- XST_SUCCESS if the interrupt setup is successful.
+*		- XST_FAILURE if interrupt setup is not successful.
+*
+* @note		None.
+*
+******************************************************************************/
+static int AxiPmonSetupIntrSystem(INTC *IntcInstancePtr,
+				XAxiPmon_Sampler *SamplerPtr, u16 IntrId)
+{
+	int Status;
+#ifdef XPAR_INTC_0_DEVICE_ID
+	Status = XIntc_Initialize(IntcInstancePtr, INTC_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XIntc_Connect(IntcInstancePtr, IntrId,
+		(XInterruptHandler)XAxiPmon_SamplerIntrHandler, SamplerPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XIntc_Start(IntcInstancePtr, XIN_REAL_MODE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XIntc_Enable(IntcInstancePtr, IntrId);
+#else
+	XScuGic_Config *IntcConfig;
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (NULL == IntcConfig) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(IntcInstancePtr, IntcConfig,
+					IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XScuGic_Connect(IntcInstancePtr, IntrId,
+		(XInterruptHandler)XAxiPmon_SamplerIntrHandler, SamplerPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(IntcInstancePtr, IntrId);
+#endif
+
+	Xil_ExceptionInit();
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+				(Xil_ExceptionHandler)INTC_HANDLER,
+				IntcInstancePtr);
+
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
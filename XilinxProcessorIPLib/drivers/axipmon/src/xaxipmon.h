@@ -253,6 +253,10 @@
 * 6.3	kvn  07/02/15	Modified code according to MISRA-C:2012 guidelines.
 * 6.4   sk   11/10/15 Used UINTPTR instead of u32 for Baseaddress CR# 867425.
 *                     Changed the prototype of XAxiPmon_CfgInitialize API.
+* 6.5   esd  10/18/26 Added xaxipmon_sampler.c and xaxipmon_sampler.h which
+*                     collect the sampled counters into a ring of time
+*                     stamped samples from the sample interval interrupt and
+*                     export them through a pluggable sink.
 * </pre>
 *
 *****************************************************************************/
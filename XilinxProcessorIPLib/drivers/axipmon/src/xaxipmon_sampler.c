@@ -0,0 +1,719 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xaxipmon_sampler.c
+* @addtogroup axipmon_v6_3
+* @{
+*
+* This file contains the sampler functions which periodically collect the
+* sampled counters of the AXI Performance Monitor into a ring of samples and
+* export them through a sink.
+*
+* Refer to the xaxipmon_sampler.h header file for more information.
+*
+* @note 	None.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 6.5   esd    10/18/26 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xaxipmon_sampler.h"
+#include "xil_printf.h"
+#include <string.h>
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Orders the accesses to a ring entry against the update of Head or Tail. The
+ * memory clobber also keeps the compiler from moving accesses across it.
+ */
+#if defined (__MICROBLAZE__)
+#define XAxiPmon_SamplerBarrier() \
+	__asm__ __volatile__ ("mbar 1" : : : "memory")
+#else
+#define XAxiPmon_SamplerBarrier() \
+	__asm__ __volatile__ ("dmb sy" : : : "memory")
+#endif
+
+/************************** Function Prototypes ******************************/
+
+static void XAxiPmon_SamplerTakeSample(XAxiPmon_Sampler *SamplerPtr,
+		XAxiPmon_Sample *SamplePtr);
+
+/************************** Variable Definitions *****************************/
+
+/****************************************************************************/
+/**
+*
+* This function initializes a sampler for an AXI Performance Monitor. The
+* metric and slot of each counter are read from the Metric Selector
+* Registers in Advanced mode; in Profile mode they are unknown and can be
+* provided with XAxiPmon_SamplerSetMetric().
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	PmonPtr is a pointer to an initialized XAxiPmon instance.
+* @param	RingPtr is the storage for the sample ring.
+* @param	NumEntries is the number of samples in RingPtr. It must be a
+*		power of 2 and at least 2.
+* @param	ClkFreqHz is the frequency of the monitor clock in Hz, used to
+*		compute rates per second.
+*
+* @return	- XST_SUCCESS if the sampler is initialized.
+*		- XST_INVALID_PARAM if NumEntries is not a power of 2.
+*		- XST_NO_FEATURE if the monitor has no sampled counters.
+*
+* @note		The metrics are read once here; call this function again
+*		after changing them with XAxiPmon_SetMetrics().
+*
+*****************************************************************************/
+s32 XAxiPmon_SamplerInitialize(XAxiPmon_Sampler *SamplerPtr,
+		XAxiPmon *PmonPtr, XAxiPmon_Sample *RingPtr, u32 NumEntries,
+		u32 ClkFreqHz)
+{
+	u32 Index;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(PmonPtr != NULL);
+	Xil_AssertNonvoid(PmonPtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(RingPtr != NULL);
+
+	if ((NumEntries < 2U) || ((NumEntries & (NumEntries - 1U)) != 0U)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	if ((PmonPtr->Mode == XAPM_MODE_TRACE) ||
+		((PmonPtr->Mode == XAPM_MODE_ADVANCED) &&
+		(PmonPtr->Config.HaveSampledCounters != 1U))) {
+		return (s32)XST_NO_FEATURE;
+	}
+
+	(void)memset(SamplerPtr, 0, sizeof(XAxiPmon_Sampler));
+	SamplerPtr->PmonPtr = PmonPtr;
+	SamplerPtr->Ring = RingPtr;
+	SamplerPtr->RingMask = NumEntries - 1U;
+	SamplerPtr->ClkFreqHz = ClkFreqHz;
+
+	SamplerPtr->NumCounters = PmonPtr->Config.NumberofCounters;
+	if (SamplerPtr->NumCounters > XAPM_SAMPLER_MAX_COUNTERS) {
+		SamplerPtr->NumCounters = XAPM_SAMPLER_MAX_COUNTERS;
+	}
+
+	/* Sampled Incrementers are present in Advanced mode only */
+	if ((PmonPtr->Mode == XAPM_MODE_ADVANCED) &&
+		(PmonPtr->Config.IsEventCount == 1U)) {
+		SamplerPtr->NumIncrementers = SamplerPtr->NumCounters;
+		if (SamplerPtr->NumIncrementers > XAPM_MAX_COUNTERS) {
+			SamplerPtr->NumIncrementers = XAPM_MAX_COUNTERS;
+		}
+	}
+
+	for (Index = 0U; Index < XAPM_SAMPLER_MAX_COUNTERS; Index++) {
+		SamplerPtr->Metric[Index] = XAPM_SAMPLER_METRIC_NONE;
+		if ((PmonPtr->Mode == XAPM_MODE_ADVANCED) &&
+			(Index < SamplerPtr->NumCounters) &&
+			(Index < XAPM_MAX_COUNTERS)) {
+			(void)XAxiPmon_GetMetrics(PmonPtr, (u8)Index,
+					&SamplerPtr->Metric[Index],
+					&SamplerPtr->Slot[Index]);
+		}
+	}
+
+	return (s32)XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function sets the metric and slot the sampler assumes for a counter
+* when computing rates with XAxiPmon_SamplerGetRates(). It does not change
+* the monitor configuration.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	CounterNum is the Metric Counter number.
+* @param	Metric is one of the XAPM_METRIC_SET_* values, or
+*		XAPM_SAMPLER_METRIC_NONE to exclude the counter from rates.
+* @param	Slot is the monitor slot the counter is attached to.
+*
+* @return	None.
+*
+* @note		This is needed in Profile mode, where the Metric Selector
+*		Registers are not available.
+*
+*****************************************************************************/
+void XAxiPmon_SamplerSetMetric(XAxiPmon_Sampler *SamplerPtr, u32 CounterNum,
+		u8 Metric, u8 Slot)
+{
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertVoid(SamplerPtr != NULL);
+	Xil_AssertVoid(CounterNum < XAPM_SAMPLER_MAX_COUNTERS);
+
+	SamplerPtr->Metric[CounterNum] = Metric;
+	SamplerPtr->Slot[CounterNum] = Slot;
+}
+
+/****************************************************************************/
+/**
+*
+* This function selects the sink to which XAxiPmon_SamplerFlush() passes the
+* collected samples.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	FuncPtr is the sink handler, for example XAxiPmon_SinkUartWrite
+*		or XAxiPmon_SinkMemWrite.
+* @param	SinkRef is the argument passed to FuncPtr.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XAxiPmon_SamplerSetSink(XAxiPmon_Sampler *SamplerPtr,
+		XAxiPmon_SinkHandler FuncPtr, void *SinkRef)
+{
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertVoid(SamplerPtr != NULL);
+	Xil_AssertVoid(FuncPtr != NULL);
+
+	SamplerPtr->SinkHandler = FuncPtr;
+	SamplerPtr->SinkRef = SinkRef;
+}
+
+/****************************************************************************/
+/**
+*
+* This function starts periodic sampling. It enables the Metric Counters and
+* the Global Clock Counter, programs the Sample Interval Counter to reset the
+* Metric Counters on every lapse so that each sample holds the counts of one
+* interval, and enables the Sample Interval Counter Overflow interrupt.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	SampleInterval is the sample interval in monitor clock cycles.
+*
+* @return	- XST_SUCCESS if sampling is started.
+*		- XST_INVALID_PARAM if SampleInterval is 0.
+*
+* @note		XAxiPmon_SamplerIntrHandler() must be connected to the
+*		interrupt of the monitor before calling this function.
+*
+*****************************************************************************/
+s32 XAxiPmon_SamplerStart(XAxiPmon_Sampler *SamplerPtr, u32 SampleInterval)
+{
+	XAxiPmon *PmonPtr;
+	u32 RegValue;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(SamplerPtr->PmonPtr != NULL);
+
+	if (SampleInterval == 0U) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	PmonPtr = SamplerPtr->PmonPtr;
+
+	SamplerPtr->Interval = SampleInterval;
+	SamplerPtr->Sequence = 0U;
+	SamplerPtr->Elapsed = 0U;
+	SamplerPtr->Dropped = 0U;
+	SamplerPtr->Tail = SamplerPtr->Head;
+
+	/* Enable Metric Counters, and Global Clock Counter in Advanced mode */
+	RegValue = XAxiPmon_ReadReg(PmonPtr->Config.BaseAddress,
+						XAPM_CTL_OFFSET);
+	RegValue |= XAPM_CR_MCNTR_ENABLE_MASK;
+	if (PmonPtr->Mode == XAPM_MODE_ADVANCED) {
+		RegValue |= XAPM_CR_GCC_ENABLE_MASK;
+	}
+	XAxiPmon_WriteReg(PmonPtr->Config.BaseAddress, XAPM_CTL_OFFSET,
+								RegValue);
+
+	/* Clear stale status and enable the sample interval interrupt */
+	XAxiPmon_IntrClear(PmonPtr, XAPM_IXR_SIC_OVERFLOW_MASK);
+	XAxiPmon_IntrEnable(PmonPtr, XAPM_IXR_SIC_OVERFLOW_MASK);
+	XAxiPmon_IntrGlobalEnable(PmonPtr);
+
+	SamplerPtr->IsRunning = TRUE;
+
+	/*
+	 * Load the interval and start the down counter with Metric Counter
+	 * reset on lapse.
+	 */
+	XAxiPmon_SetSampleInterval(PmonPtr, SampleInterval);
+	XAxiPmon_LoadSampleIntervalCounter(PmonPtr);
+	XAxiPmon_WriteReg(PmonPtr->Config.BaseAddress, XAPM_SICR_OFFSET,
+			XAPM_SICR_ENABLE_MASK | XAPM_SICR_MCNTR_RST_MASK);
+
+	return (s32)XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function stops periodic sampling. The Sample Interval Counter, its
+* interrupt and the Metric Counters are disabled. Samples already in the ring
+* remain available to XAxiPmon_SamplerFlush().
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+*
+* @return	XST_SUCCESS
+*
+* @note		The Global Interrupt Enable is cleared only if no other
+*		monitor interrupt is enabled.
+*
+*****************************************************************************/
+s32 XAxiPmon_SamplerStop(XAxiPmon_Sampler *SamplerPtr)
+{
+	XAxiPmon *PmonPtr;
+	u32 RegValue;
+
+	/*
+	 * Assert the arguments.
+	 */
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+	Xil_AssertNonvoid(SamplerPtr->PmonPtr != NULL);
+
+	PmonPtr = SamplerPtr->PmonPtr;
+
+	XAxiPmon_WriteReg(PmonPtr->Config.BaseAddress, XAPM_SICR_OFFSET, 0U);
+
+	RegValue = XAxiPmon_ReadReg(PmonPtr->Config.BaseAddress,
+						XAPM_IE_OFFSET);
+	RegValue &= ~XAPM_IXR_SIC_OVERFLOW_MASK;
+	XAxiPmon_WriteReg(PmonPtr->Config.BaseAddress, XAPM_IE_OFFSET,
+								RegValue);
+	if (RegValue == 0U) {
+		XAxiPmon_IntrGlobalDisable(PmonPtr);
+	}
+	XAxiPmon_IntrClear(PmonPtr, XAPM_IXR_SIC_OVERFLOW_MASK);
+
+	RegValue = XAxiPmon_ReadReg(PmonPtr->Config.BaseAddress,
+						XAPM_CTL_OFFSET);
+	RegValue &= ~(XAPM_CR_MCNTR_ENABLE_MASK | XAPM_CR_GCC_ENABLE_MASK);
+	XAxiPmon_WriteReg(PmonPtr->Config.BaseAddress, XAPM_CTL_OFFSET,
+								RegValue);
+
+	SamplerPtr->IsRunning = FALSE;
+
+	return (s32)XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the interrupt handler of the sampler. On a Sample Interval
+* Counter Overflow it stores a snapshot of all sampled counters in the ring.
+* It has to be connected to the interrupt controller with the sampler
+* instance as the callback reference.
+*
+* @param	CallBackRef is a pointer to the XAxiPmon_Sampler instance.
+*
+* @return	None.
+*
+* @note		The handler only reads the sampled registers and never waits
+*		on the consumer, so its cost is bounded by the number of
+*		counters. If the ring is full the sample is dropped.
+*
+*****************************************************************************/
+void XAxiPmon_SamplerIntrHandler(void *CallBackRef)
+{
+	XAxiPmon_Sampler *SamplerPtr = (XAxiPmon_Sampler *)CallBackRef;
+	XAxiPmon *PmonPtr;
+	u32 IntrStatus;
+	u32 Head;
+
+	Xil_AssertVoid(SamplerPtr != NULL);
+
+	PmonPtr = SamplerPtr->PmonPtr;
+
+	IntrStatus = XAxiPmon_IntrGetStatus(PmonPtr);
+
+	if ((IntrStatus & XAPM_IXR_SIC_OVERFLOW_MASK) != 0U) {
+		Head = SamplerPtr->Head;
+		SamplerPtr->Sequence++;
+		SamplerPtr->Elapsed += SamplerPtr->Interval;
+
+		if ((Head - SamplerPtr->Tail) > SamplerPtr->RingMask) {
+			SamplerPtr->Dropped++;
+		}
+		else {
+			XAxiPmon_SamplerTakeSample(SamplerPtr,
+				&SamplerPtr->Ring[Head & SamplerPtr->RingMask]);
+			/* Publish the entry only once it is complete */
+			XAxiPmon_SamplerBarrier();
+			SamplerPtr->Head = Head + 1U;
+		}
+	}
+
+	/* Other APM interrupts belong to their own handlers */
+	XAxiPmon_IntrClear(PmonPtr, IntrStatus & XAPM_IXR_SIC_OVERFLOW_MASK);
+}
+
+/****************************************************************************/
+/**
+*
+* This function passes the samples collected since the previous call to the
+* sink. It is meant to be called from the application context, so the cost of
+* formatting and transmitting samples is not paid in the interrupt handler.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	MaxSamples is the maximum number of samples to export.
+*
+* @return	Number of samples consumed by the sink.
+*
+* @note		Samples are left in the ring if no sink is set or if the sink
+*		consumes fewer samples than offered.
+*
+*****************************************************************************/
+u32 XAxiPmon_SamplerFlush(XAxiPmon_Sampler *SamplerPtr, u32 MaxSamples)
+{
+	u32 Tail;
+	u32 Count;
+	u32 Run;
+	u32 Done;
+	u32 Total = 0U;
+
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+
+	if (SamplerPtr->SinkHandler == NULL) {
+		return 0U;
+	}
+
+	Tail = SamplerPtr->Tail;
+	Count = SamplerPtr->Head - Tail;
+	if (Count > MaxSamples) {
+		Count = MaxSamples;
+	}
+
+	/* Pairs with the barrier in the handler before Head is published */
+	XAxiPmon_SamplerBarrier();
+
+	while (Count > 0U) {
+		/* Pass the contiguous run up to the end of the ring storage */
+		Run = (SamplerPtr->RingMask + 1U) - (Tail & SamplerPtr->RingMask);
+		if (Run > Count) {
+			Run = Count;
+		}
+
+		Done = SamplerPtr->SinkHandler(SamplerPtr->SinkRef,
+				&SamplerPtr->Ring[Tail & SamplerPtr->RingMask],
+				Run);
+		if (Done > Run) {
+			Done = Run;
+		}
+
+		/* Entries are read before the handler may reuse them */
+		XAxiPmon_SamplerBarrier();
+		Tail += Done;
+		SamplerPtr->Tail = Tail;
+		Total += Done;
+		Count -= Done;
+
+		if (Done < Run) {
+			break;
+		}
+	}
+
+	return Total;
+}
+
+/****************************************************************************/
+/**
+*
+* This function computes bandwidth, transaction, latency and outstanding
+* transaction figures of one slot from a sample.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	SamplePtr is the sample to evaluate.
+* @param	Slot is the monitor slot to evaluate.
+* @param	RatesPtr is filled with the derived rates.
+*
+* @return	None.
+*
+* @note		Average outstanding transactions follow from Little's law as
+*		the total latency divided by the interval length.
+*
+*****************************************************************************/
+void XAxiPmon_SamplerGetRates(XAxiPmon_Sampler *SamplerPtr,
+		const XAxiPmon_Sample *SamplePtr, u8 Slot,
+		XAxiPmon_SlotRates *RatesPtr)
+{
+	u32 Index;
+	u32 Value;
+	u64 WrBytes = 0U;
+	u64 RdBytes = 0U;
+	u64 WrLatency = 0U;
+	u64 RdLatency = 0U;
+	u64 Interval;
+
+	Xil_AssertVoid(SamplerPtr != NULL);
+	Xil_AssertVoid(SamplePtr != NULL);
+	Xil_AssertVoid(RatesPtr != NULL);
+
+	(void)memset(RatesPtr, 0, sizeof(XAxiPmon_SlotRates));
+
+	Interval = SamplePtr->Interval;
+	if (Interval == 0U) {
+		return;
+	}
+
+	for (Index = 0U; Index < SamplerPtr->NumCounters; Index++) {
+		if (SamplerPtr->Slot[Index] != Slot) {
+			continue;
+		}
+		Value = SamplePtr->Counter[Index];
+
+		switch (SamplerPtr->Metric[Index]) {
+		case XAPM_METRIC_SET_0:
+			RatesPtr->WrTransactions += Value;
+			break;
+		case XAPM_METRIC_SET_1:
+			RatesPtr->RdTransactions += Value;
+			break;
+		case XAPM_METRIC_SET_2:
+			WrBytes += Value;
+			break;
+		case XAPM_METRIC_SET_3:
+			RdBytes += Value;
+			break;
+		case XAPM_METRIC_SET_5:
+			RdLatency += Value;
+			break;
+		case XAPM_METRIC_SET_6:
+			WrLatency += Value;
+			break;
+		default:
+			break;
+		}
+	}
+
+	RatesPtr->WrBytesPerSec = (WrBytes * SamplerPtr->ClkFreqHz) / Interval;
+	RatesPtr->RdBytesPerSec = (RdBytes * SamplerPtr->ClkFreqHz) / Interval;
+	RatesPtr->WrOutstanding = (u32)((WrLatency * 1000U) / Interval);
+	RatesPtr->RdOutstanding = (u32)((RdLatency * 1000U) / Interval);
+
+	if (RatesPtr->WrTransactions != 0U) {
+		RatesPtr->AvgWrLatency =
+			(u32)(WrLatency / RatesPtr->WrTransactions);
+	}
+	if (RatesPtr->RdTransactions != 0U) {
+		RatesPtr->AvgRdLatency =
+			(u32)(RdLatency / RatesPtr->RdTransactions);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function initializes a memory buffer sink.
+*
+* @param	SinkPtr is a pointer to the XAxiPmon_MemSink instance.
+* @param	BufferPtr is the sample storage.
+* @param	Capacity is the number of samples in BufferPtr.
+* @param	Wrap selects whether the oldest samples are overwritten when
+*		the buffer is full (1) or new samples are discarded (0).
+*
+* @return	None.
+*
+* @note		Pass XAxiPmon_SinkMemWrite and SinkPtr to
+*		XAxiPmon_SamplerSetSink() to use this sink.
+*
+*****************************************************************************/
+void XAxiPmon_MemSinkInitialize(XAxiPmon_MemSink *SinkPtr,
+		XAxiPmon_Sample *BufferPtr, u32 Capacity, u8 Wrap)
+{
+	Xil_AssertVoid(SinkPtr != NULL);
+	Xil_AssertVoid(BufferPtr != NULL);
+	Xil_AssertVoid(Capacity != 0U);
+
+	SinkPtr->Buffer = BufferPtr;
+	SinkPtr->Capacity = Capacity;
+	SinkPtr->Count = 0U;
+	SinkPtr->Next = 0U;
+	SinkPtr->Wrap = Wrap;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the sink handler of the memory buffer sink.
+*
+* @param	SinkRef is a pointer to an XAxiPmon_MemSink instance.
+* @param	SamplePtr points to the samples to store.
+* @param	NumSamples is the number of samples.
+*
+* @return	Number of samples consumed. Samples discarded because the
+*		buffer is full are consumed too.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XAxiPmon_SinkMemWrite(void *SinkRef, const XAxiPmon_Sample *SamplePtr,
+		u32 NumSamples)
+{
+	XAxiPmon_MemSink *SinkPtr = (XAxiPmon_MemSink *)SinkRef;
+	u32 Index;
+
+	Xil_AssertNonvoid(SinkPtr != NULL);
+
+	for (Index = 0U; Index < NumSamples; Index++) {
+		if ((SinkPtr->Count == SinkPtr->Capacity) &&
+						(SinkPtr->Wrap == 0U)) {
+			break;
+		}
+		(void)memcpy(&SinkPtr->Buffer[SinkPtr->Next], &SamplePtr[Index],
+					sizeof(XAxiPmon_Sample));
+		SinkPtr->Next++;
+		if (SinkPtr->Next == SinkPtr->Capacity) {
+			SinkPtr->Next = 0U;
+		}
+		if (SinkPtr->Count < SinkPtr->Capacity) {
+			SinkPtr->Count++;
+		}
+	}
+
+	return NumSamples;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the sink handler of the UART sink. Every sample is printed
+* with xil_printf as one CSV line:
+*	sequence,timestamp_hi,timestamp_lo,interval,counter0,...,incrementer0,...
+*
+* @param	SinkRef is a pointer to the XAxiPmon_Sampler instance that
+*		produced the samples.
+* @param	SamplePtr points to the samples to print.
+* @param	NumSamples is the number of samples.
+*
+* @return	Number of samples consumed.
+*
+* @note		Printing is slow compared to the sample rate of the monitor.
+*		Choose a sample interval long enough for the UART to keep
+*		up, or use the memory sink and print afterwards.
+*
+*****************************************************************************/
+u32 XAxiPmon_SinkUartWrite(void *SinkRef, const XAxiPmon_Sample *SamplePtr,
+		u32 NumSamples)
+{
+	XAxiPmon_Sampler *SamplerPtr = (XAxiPmon_Sampler *)SinkRef;
+	u32 Index;
+	u32 Counter;
+
+	Xil_AssertNonvoid(SamplerPtr != NULL);
+
+	for (Index = 0U; Index < NumSamples; Index++) {
+		xil_printf("%d,%08x,%08x,%d", SamplePtr[Index].Sequence,
+			(u32)(SamplePtr[Index].Timestamp >> 32U),
+			(u32)(SamplePtr[Index].Timestamp & 0xFFFFFFFFU),
+			SamplePtr[Index].Interval);
+		for (Counter = 0U; Counter < SamplerPtr->NumCounters;
+							Counter++) {
+			xil_printf(",%d", SamplePtr[Index].Counter[Counter]);
+		}
+		for (Counter = 0U; Counter < SamplerPtr->NumIncrementers;
+							Counter++) {
+			xil_printf(",%d",
+				SamplePtr[Index].Incrementer[Counter]);
+		}
+		xil_printf("\r\n");
+	}
+
+	return NumSamples;
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the sampled counters of the monitor into a sample.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+* @param	SamplePtr is the ring entry to fill.
+*
+* @return	None.
+*
+* @note		Called from XAxiPmon_SamplerIntrHandler().
+*
+*****************************************************************************/
+static void XAxiPmon_SamplerTakeSample(XAxiPmon_Sampler *SamplerPtr,
+		XAxiPmon_Sample *SamplePtr)
+{
+	XAxiPmon *PmonPtr = SamplerPtr->PmonPtr;
+	u32 Index;
+	u32 CntHigh;
+	u32 CntLow;
+
+	if (PmonPtr->Mode == XAPM_MODE_ADVANCED) {
+		XAxiPmon_GetGlobalClkCounter(PmonPtr, &CntHigh, &CntLow);
+		SamplePtr->Timestamp = ((u64)CntHigh << 32U) | (u64)CntLow;
+	}
+	else {
+		SamplePtr->Timestamp = SamplerPtr->Elapsed;
+	}
+	SamplePtr->Interval = SamplerPtr->Interval;
+	SamplePtr->Sequence = SamplerPtr->Sequence;
+
+	for (Index = 0U; Index < SamplerPtr->NumCounters; Index++) {
+		SamplePtr->Counter[Index] =
+			XAxiPmon_GetSampledMetricCounter(PmonPtr, Index);
+	}
+
+	for (Index = 0U; Index < SamplerPtr->NumIncrementers; Index++) {
+		SamplePtr->Incrementer[Index] =
+			XAxiPmon_GetSampledIncrementer(PmonPtr, Index);
+	}
+}
+/** @} */
@@ -0,0 +1,255 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xaxipmon_sampler.h
+* @addtogroup axipmon_v6_3
+* @{
+*
+* The sampler continuously collects the Sampled Metric Counters and Sampled
+* Incrementers of an AXI Performance Monitor into a ring of time stamped
+* samples, and exports them through a pluggable sink.
+*
+* <b> Collection </b>
+*
+* XAxiPmon_SamplerStart() programs the Sample Interval Counter and enables the
+* Sample Interval Counter Overflow interrupt. XAxiPmon_SamplerIntrHandler()
+* has to be connected to the interrupt controller by the application. On each
+* sample interval lapse the handler copies all configured counters into the
+* next free entry of the ring. The handler is the only writer of the ring
+* head and the consumer (XAxiPmon_SamplerFlush()) is the only writer of the
+* ring tail, so no locking is needed between them. When the ring is full new
+* samples are dropped and counted in the Dropped field.
+*
+* <b> Export </b>
+*
+* XAxiPmon_SamplerFlush() is called from the application context (a main loop
+* or a low priority task) and passes the collected samples to the sink
+* selected with XAxiPmon_SamplerSetSink(). Two sinks are provided:
+*	- XAxiPmon_SinkUartWrite prints samples as CSV lines with xil_printf
+*	- XAxiPmon_SinkMemWrite copies samples into an XAxiPmon_MemSink buffer
+* Any other transport, for example an rpmsg endpoint, can be used by providing
+* a function of type XAxiPmon_SinkHandler.
+*
+* <b> Derived metrics </b>
+*
+* XAxiPmon_SamplerGetRates() converts one sample into per slot bandwidth,
+* average latency and average outstanding transactions, using the metric
+* selected for each counter (Write/Read Byte Count, Write/Read Transaction
+* Count and Total Write/Read Latency).
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- -----  -------- -----------------------------------------------------
+* 6.5   esd    10/18/26 First release
+* </pre>
+*
+*****************************************************************************/
+#ifndef XAXIPMON_SAMPLER_H /* Prevent circular inclusions */
+#define XAXIPMON_SAMPLER_H /* by using protection macros  */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files ********************************/
+
+#include "xaxipmon.h"
+
+/************************** Constant Definitions ****************************/
+
+/**
+ * Maximum number of counters stored in a sample. Profile mode monitors have
+ * up to XAPM_MAX_COUNTERS_PROFILE counters, define this to that value to
+ * collect all of them at the cost of a larger sample.
+ */
+#ifndef XAPM_SAMPLER_MAX_COUNTERS
+#define XAPM_SAMPLER_MAX_COUNTERS	XAPM_MAX_COUNTERS
+#endif
+
+/**
+ * Value of the metric of a counter for which no metric is known.
+ */
+#define XAPM_SAMPLER_METRIC_NONE	0xFFU
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * One snapshot of the monitor taken at a sample interval lapse.
+ */
+typedef struct {
+	u64 Timestamp;		/**< Global Clock Counter at the lapse, or the
+				  *  accumulated sample intervals if the
+				  *  monitor has no Global Clock Counter */
+	u32 Interval;		/**< Clock cycles covered by this sample */
+	u32 Sequence;		/**< Sample number since start */
+	u32 Counter[XAPM_SAMPLER_MAX_COUNTERS];	/**< Sampled Metric
+						  *  Counters */
+	u32 Incrementer[XAPM_MAX_COUNTERS];	/**< Sampled Incrementers */
+} XAxiPmon_Sample;
+
+/**
+ * Rates derived from one sample for one monitor slot. Values for which the
+ * required metric is not assigned to any counter are 0.
+ */
+typedef struct {
+	u64 WrBytesPerSec;	/**< Write bandwidth in bytes per second */
+	u64 RdBytesPerSec;	/**< Read bandwidth in bytes per second */
+	u32 WrTransactions;	/**< Write transactions in the interval */
+	u32 RdTransactions;	/**< Read transactions in the interval */
+	u32 AvgWrLatency;	/**< Average write latency in clock cycles */
+	u32 AvgRdLatency;	/**< Average read latency in clock cycles */
+	u32 WrOutstanding;	/**< Average outstanding writes x 1000 */
+	u32 RdOutstanding;	/**< Average outstanding reads x 1000 */
+} XAxiPmon_SlotRates;
+
+/**
+ * Sink handler. It is called from XAxiPmon_SamplerFlush() with a contiguous
+ * run of samples and returns the number of samples it consumed. Returning
+ * less than NumSamples leaves the remaining samples in the ring.
+ */
+typedef u32 (*XAxiPmon_SinkHandler) (void *SinkRef,
+		const XAxiPmon_Sample *SamplePtr, u32 NumSamples);
+
+/**
+ * Memory buffer sink. Samples are copied into Buffer; when it is full the
+ * oldest samples are overwritten if Wrap is set, otherwise new samples are
+ * discarded.
+ */
+typedef struct {
+	XAxiPmon_Sample *Buffer;	/**< Sample storage */
+	u32 Capacity;			/**< Number of samples in Buffer */
+	u32 Count;			/**< Number of valid samples */
+	u32 Next;			/**< Index of the next sample to write */
+	u8 Wrap;			/**< Overwrite oldest samples when full */
+} XAxiPmon_MemSink;
+
+/**
+ * The sampler instance data. The user is required to allocate a variable of
+ * this type for every AXI Performance Monitor that is sampled.
+ */
+typedef struct {
+	XAxiPmon *PmonPtr;		/**< Monitor being sampled */
+	XAxiPmon_Sample *Ring;		/**< Sample ring storage */
+	u32 RingMask;			/**< Number of ring entries - 1 */
+	volatile u32 Head;		/**< Next entry written by the handler */
+	volatile u32 Tail;		/**< Next entry read by the consumer */
+	volatile u32 Dropped;		/**< Samples lost because of a full ring */
+	u32 Sequence;			/**< Samples taken since start */
+	u32 Interval;			/**< Sample interval in clock cycles */
+	u32 ClkFreqHz;			/**< Monitor clock frequency */
+	u64 Elapsed;			/**< Accumulated sample intervals */
+	u32 NumCounters;		/**< Counters stored per sample */
+	u32 NumIncrementers;		/**< Incrementers stored per sample */
+	u8 Metric[XAPM_SAMPLER_MAX_COUNTERS];	/**< Metric of each counter */
+	u8 Slot[XAPM_SAMPLER_MAX_COUNTERS];	/**< Slot of each counter */
+	XAxiPmon_SinkHandler SinkHandler;	/**< Export function */
+	void *SinkRef;			/**< Argument of SinkHandler */
+	u32 IsRunning;			/**< Sampling is active */
+} XAxiPmon_Sampler;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/****************************************************************************/
+/**
+* This macro returns the number of samples waiting in the ring.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+*
+* @return	Number of samples not yet passed to the sink.
+*
+* @note		C-Style signature:
+*		u32 XAxiPmon_SamplerGetCount(XAxiPmon_Sampler *SamplerPtr)
+*
+*****************************************************************************/
+#define XAxiPmon_SamplerGetCount(SamplerPtr) \
+	((SamplerPtr)->Head - (SamplerPtr)->Tail)
+
+/****************************************************************************/
+/**
+* This macro returns the number of samples dropped because the ring was full.
+*
+* @param	SamplerPtr is a pointer to the XAxiPmon_Sampler instance.
+*
+* @return	Number of dropped samples.
+*
+* @note		C-Style signature:
+*		u32 XAxiPmon_SamplerGetDropped(XAxiPmon_Sampler *SamplerPtr)
+*
+*****************************************************************************/
+#define XAxiPmon_SamplerGetDropped(SamplerPtr)	((SamplerPtr)->Dropped)
+
+/************************** Function Prototypes *****************************/
+
+/**
+ * Functions in xaxipmon_sampler.c
+ */
+s32 XAxiPmon_SamplerInitialize(XAxiPmon_Sampler *SamplerPtr,
+		XAxiPmon *PmonPtr, XAxiPmon_Sample *RingPtr, u32 NumEntries,
+		u32 ClkFreqHz);
+
+void XAxiPmon_SamplerSetMetric(XAxiPmon_Sampler *SamplerPtr, u32 CounterNum,
+		u8 Metric, u8 Slot);
+
+void XAxiPmon_SamplerSetSink(XAxiPmon_Sampler *SamplerPtr,
+		XAxiPmon_SinkHandler FuncPtr, void *SinkRef);
+
+s32 XAxiPmon_SamplerStart(XAxiPmon_Sampler *SamplerPtr, u32 SampleInterval);
+
+s32 XAxiPmon_SamplerStop(XAxiPmon_Sampler *SamplerPtr);
+
+void XAxiPmon_SamplerIntrHandler(void *CallBackRef);
+
+u32 XAxiPmon_SamplerFlush(XAxiPmon_Sampler *SamplerPtr, u32 MaxSamples);
+
+void XAxiPmon_SamplerGetRates(XAxiPmon_Sampler *SamplerPtr,
+		const XAxiPmon_Sample *SamplePtr, u8 Slot,
+		XAxiPmon_SlotRates *RatesPtr);
+
+void XAxiPmon_MemSinkInitialize(XAxiPmon_MemSink *SinkPtr,
+		XAxiPmon_Sample *BufferPtr, u32 Capacity, u8 Wrap);
+
+u32 XAxiPmon_SinkMemWrite(void *SinkRef, const XAxiPmon_Sample *SamplePtr,
+		u32 NumSamples);
+
+u32 XAxiPmon_SinkUartWrite(void *SinkRef, const XAxiPmon_Sample *SamplePtr,
+		u32 NumSamples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* End of protection macro. */
+/** @} */
@@ -98,6 +98,9 @@
 *			   Oob and No-Oob region.
 * 1.0   kpc    17/6/2015   Added timer based timeout intsead of sw counter.
 * 1.1   mi     09/16/16 Removed compilation warnings with extra compiler flags.
+* 1.2   esd    10/18/26 Added cache read/program, multi-plane and multi-LUN
+*			   pipelining to XNandPsu_Read/Write/Erase, and
+*			   throughput statistics.
 * </pre>
 *
 ******************************************************************************/
@@ -106,8 +109,11 @@
 #include "xnandpsu.h"
 #include "xnandpsu_bbm.h"
 #include "sleep.h"
+#include "xtime_l.h"
 /************************** Constant Definitions *****************************/
 
+#define XNANDPSU_LUN_IDLE	0xFFFFFFFFU	/**< No erase in flight */
+
 static const XNandPsu_EccMatrix EccMatrix[] = {
 	/* 512 byte page */
 	{XNANDPSU_PAGE_SIZE_512, 9U, 1U, XNANDPSU_HAMMING, 0x20DU, 0x3U},
@@ -140,6 +146,21 @@ static const XNandPsu_EccMatrix EccMatrix[] = {
 };
 
 /**************************** Type Definitions *******************************/
+
+/*
+ * Timer used for the throughput statistics. An R5 without the sleep timer
+ * has none, the statistics then only count bytes and pages.
+ */
+#if defined (ARMR5) && !defined (SLEEP_TIMER_BASEADDR)
+typedef u32 XNandPsu_Time;
+#define XNANDPSU_COUNTS_PER_SECOND	0U
+#define XNandPsu_GetTime(TimePtr)	(*(TimePtr) = 0U)
+#else
+typedef XTime XNandPsu_Time;
+#define XNANDPSU_COUNTS_PER_SECOND	COUNTS_PER_SECOND
+#define XNandPsu_GetTime(TimePtr)	XTime_GetTime(TimePtr)
+#endif
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
@@ -173,12 +194,42 @@ static s32 XNandPsu_OnfiReadId(XNandPsu *InstancePtr, u32 Target, u8 IdAddr,
 static s32 XNandPsu_OnfiReadParamPage(XNandPsu *InstancePtr, u32 Target,
 						u8 *Buf);
 
+static s32 XNandPsu_OnfiReadStatusEnh(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u16 *OnfiStatus);
+
 static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 							u32 Col, u8 *Buf);
 
+static s32 XNandPsu_ProgramPageCmd(XNandPsu *InstancePtr, u32 Target, u32 Page,
+						u32 Col, u8 *Buf, u8 Cmd2);
+
+static s32 XNandPsu_ProgramCachePages(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u32 NumPages, u8 *Buf);
+
+static s32 XNandPsu_ProgramPlanePair(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u8 *Buf);
+
 static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 							u32 Col, u8 *Buf);
 
+static s32 XNandPsu_ReadCachePages(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u32 NumPages, u8 *Buf);
+
+static s32 XNandPsu_CheckEcc(XNandPsu *InstancePtr, s32 XferStatus);
+
+static u32 XNandPsu_PageRun(XNandPsu *InstancePtr, u32 Page, u64 Length);
+
+static u32 XNandPsu_IsPlanePair(XNandPsu *InstancePtr, u32 Block, u32 Page,
+							u64 Length);
+
+static s32 XNandPsu_EraseBlockCmd(XNandPsu *InstancePtr, u32 Target,
+						u32 Block, u8 Cmd2);
+
+static s32 XNandPsu_EraseBlocks(XNandPsu *InstancePtr, u32 StartBlock,
+							u32 NumBlocks);
+
+static u32 XNandPsu_Rate(u64 Bytes, u64 Time);
+
 static s32 XNandPsu_CheckOnDie(XNandPsu *InstancePtr, OnfiParamPage *Param);
 
 static void XNandPsu_SetEccAddrSize(XNandPsu *InstancePtr);
@@ -200,6 +251,11 @@ static s32 XNandPsu_WaitFor_Transfer_Complete(XNandPsu *InstancePtr);
 
 static s32 XNandPsu_Device_Ready(XNandPsu *InstancePtr, u32 Target);
 
+static s32 XNandPsu_Cache_Ready(XNandPsu *InstancePtr, u32 Target,
+					u32 WaitArray, u32 CheckPrev);
+
+static s32 XNandPsu_Lun_Ready(XNandPsu *InstancePtr, u32 Target, u32 Page);
+
 static void XNandPsu_Fifo_Read(XNandPsu *InstancePtr, u8* Buf, u32 Size);
 
 static void XNandPsu_Fifo_Write(XNandPsu *InstancePtr, u8* Buf, u32 Size);
@@ -240,6 +296,9 @@ s32 XNandPsu_CfgInitialize(XNandPsu *InstancePtr, XNandPsu_Config *ConfigPtr,
 	InstancePtr->Mode = XNANDPSU_POLLING;
 	/* Enable MDMA mode by default */
 	InstancePtr->DmaMode = XNANDPSU_MDMA;
+	/* Use the optional ONFI operations the flash supports */
+	InstancePtr->PipelineMode = 1U;
+	(void)memset(&InstancePtr->Stats, 0, sizeof(InstancePtr->Stats));
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 
 	/* Initialize the NAND flash targets */
@@ -536,6 +595,24 @@ static void XNandPsu_InitFeatures(XNandPsu *InstancePtr, OnfiParamPage *Param)
 								1U : 0U;
 	InstancePtr->Features.ExtPrmPage = ((Param->Features & (1U << 7)) != 0U) ?
 								1U : 0U;
+	InstancePtr->Features.CacheProg = ((Param->OptionalCmds & (1U << 0))
+							!= 0U) ? 1U : 0U;
+	InstancePtr->Features.CacheRead = ((Param->OptionalCmds & (1U << 1))
+							!= 0U) ? 1U : 0U;
+	/* Blocks are paired as plane 0/1, the LUN must hold whole pairs */
+	InstancePtr->Features.MultiPlane = (((Param->Features & (1U << 3))
+					!= 0U) &&
+					(Param->PlaneAddrBits != 0U) &&
+					((Param->BlocksPerLun & 1U) == 0U)) ?
+								1U : 0U;
+	/* Busy LUNs are tracked with Read Status Enhanced */
+	InstancePtr->Features.MultiLun = (((Param->Features & (1U << 1))
+					!= 0U) &&
+					((Param->OptionalCmds & (1U << 3))
+					!= 0U) &&
+					(Param->NumLuns > 1U) &&
+					(Param->NumLuns <= XNANDPSU_MAX_LUNS)) ?
+								1U : 0U;
 }
 
 /*****************************************************************************/
@@ -725,6 +802,130 @@ void XNandPsu_DisableEccMode(XNandPsu *InstancePtr)
 	InstancePtr->EccMode = XNANDPSU_NONE;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function enables the cache, multi-plane and multi-LUN operations the
+* flash supports in XNandPsu_Read, XNandPsu_Write and XNandPsu_Erase.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+*
+* @return
+*		None
+*
+* @note		Pipelining is enabled by XNandPsu_CfgInitialize.
+*
+******************************************************************************/
+void XNandPsu_EnablePipelineMode(XNandPsu *InstancePtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->PipelineMode = 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function restricts XNandPsu_Read, XNandPsu_Write and XNandPsu_Erase
+* to one page or block operation at a time.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+void XNandPsu_DisablePipelineMode(XNandPsu *InstancePtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->PipelineMode = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the throughput statistics of XNandPsu_Read and
+* XNandPsu_Write, with the sustained MB/s computed from the accumulated
+* bytes and time.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	StatsPtr is a pointer to the statistics to fill in.
+*
+* @return
+*		None
+*
+* @note		The rates are 0 when no timer is available.
+*
+******************************************************************************/
+void XNandPsu_GetStats(XNandPsu *InstancePtr, XNandPsu_Stats *StatsPtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = InstancePtr->Stats;
+	StatsPtr->ReadMBps = XNandPsu_Rate(StatsPtr->ReadBytes,
+						StatsPtr->ReadTime);
+	StatsPtr->WriteMBps = XNandPsu_Rate(StatsPtr->WriteBytes,
+						StatsPtr->WriteTime);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the throughput statistics.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+void XNandPsu_ResetStats(XNandPsu *InstancePtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	(void)memset(&InstancePtr->Stats, 0, sizeof(InstancePtr->Stats));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function converts a byte count and timer counts to MB/s.
+*
+* @param	Bytes is the number of bytes transferred.
+* @param	Time is the number of timer counts spent.
+*
+* @return	Rate in MB/s, 0 if no time was recorded.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 XNandPsu_Rate(u64 Bytes, u64 Time)
+{
+	u32 Rate = 0U;
+
+	/* Scale in KB first so that the product does not overflow */
+	if (Time != 0U) {
+		Rate = (u32)((((Bytes >> 10U) *
+				(u64)XNANDPSU_COUNTS_PER_SECOND) / Time) >> 10U);
+	}
+
+	return Rate;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1112,6 +1313,62 @@ static s32 XNandPsu_OnfiReadStatus(XNandPsu *InstancePtr, u32 Target,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function sends ONFI Read Status Enhanced command to the flash, which
+* returns the status of the LUN that holds the given page.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is a page address in the LUN.
+* @param	OnfiStatus is the ONFI status value to return.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_OnfiReadStatusEnh(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u16 *OnfiStatus)
+{
+	s32 Status = XST_FAILURE;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(Target < XNANDPSU_MAX_TARGETS);
+	Xil_AssertNonvoid(OnfiStatus != NULL);
+	/* Enable Transfer Complete Interrupt in Interrupt Status Register */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+		XNANDPSU_INTR_STS_EN_OFFSET,
+		XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK);
+	/* Program Command Register, row address only as for erase */
+	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_RD_STS_ENHCD,
+			ONFI_CMD_INVALID, 0U, 0U,
+			InstancePtr->Geometry.RowAddrCycles);
+	XNandPsu_SetPageColAddr(InstancePtr, (Page >> 16U) & 0xFFFFU,
+					(u16)(Page & 0xFFFFU));
+	/* Program Memory Address Register2 for chip select */
+	XNandPsu_SelectChip(InstancePtr, Target);
+	/* Program Packet Size and Packet Count */
+	if(InstancePtr->DataInterface == XNANDPSU_SDR)
+		XNandPsu_SetPktSzCnt(InstancePtr, 1U, 1U);
+	else
+		XNandPsu_SetPktSzCnt(InstancePtr, 2U, 1U);
+
+	/* Set Read Status Enhanced in Program Register */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_PROG_OFFSET,XNANDPSU_PROG_RD_STS_ENH_MASK);
+	/* Poll for Transfer Complete event */
+	Status = XNandPsu_WaitFor_Transfer_Complete(InstancePtr);
+	/* Read Flash Status */
+	*OnfiStatus = (u16) XNandPsu_ReadReg(InstancePtr->Config.BaseAddress,
+						XNANDPSU_FLASH_STS_OFFSET);
+
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1341,11 +1598,14 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *SrcBuf)
 	u32 Block;
 	u32 PartialBytes = 0;
 	u32 NumBytes;
+	u32 NumPages;
 	u32 RemLen;
 	u8 *BufPtr;
 	u8 *SrcBufPtr = (u8 *)SrcBuf;
 	u64 OffsetVar = Offset;
 	u64 LengthVar = Length;
+	XNandPsu_Time Start;
+	XNandPsu_Time End;
 
 	/* Assert the input arguments. */
 	Xil_AssertNonvoid(InstancePtr != NULL);
@@ -1355,6 +1615,8 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *SrcBuf)
 	Xil_AssertNonvoid((OffsetVar + LengthVar) <=
 				InstancePtr->Geometry.DeviceSize);
 
+	XNandPsu_GetTime(&Start);
+
 	/*
 	 * Check if write operation exceeds flash size when including
 	 * bad blocks.
@@ -1396,36 +1658,68 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *SrcBuf)
 			Page %= InstancePtr->Geometry.NumTargetPages;
 		}
 
-		/* Check if partial write */
-		if (PartialBytes > 0U) {
-			BufPtr = &InstancePtr->PartialDataBuf[0];
-			(void)memset(BufPtr, 0xFF,
+		/*
+		 * Whole pages go through the multi-plane or cache program
+		 * when the flash supports them.
+		 */
+		NumPages = 0U;
+		if ((PartialBytes == 0U) && (InstancePtr->PipelineMode != 0U)) {
+			if (XNandPsu_IsPlanePair(InstancePtr, Block, Page,
+							LengthVar) != 0U) {
+				NumPages = 2U *
+					InstancePtr->Geometry.PagesPerBlock;
+				Status = XNandPsu_ProgramPlanePair(InstancePtr,
+						Target, Page, SrcBufPtr);
+			} else if (InstancePtr->Features.CacheProg != 0U) {
+				NumPages = XNandPsu_PageRun(InstancePtr, Page,
+								LengthVar);
+				if (NumPages > 1U) {
+					Status = XNandPsu_ProgramCachePages(
+						InstancePtr, Target, Page,
+						NumPages, SrcBufPtr);
+				}
+			}
+		}
+		if (NumPages > 1U) {
+			if (Status != XST_SUCCESS)
+				goto Out;
+			NumBytes = NumPages * InstancePtr->Geometry.BytesPerPage;
+		} else {
+			/* Check if partial write */
+			if (PartialBytes > 0U) {
+				BufPtr = &InstancePtr->PartialDataBuf[0];
+				(void)memset(BufPtr, 0xFF,
 					InstancePtr->Geometry.BytesPerPage);
-			(void)memcpy(BufPtr + Col, SrcBufPtr, PartialBytes);
+				(void)memcpy(BufPtr + Col, SrcBufPtr,
+							PartialBytes);
 
-			NumBytes = PartialBytes;
-		} else {
-			BufPtr = (u8 *)SrcBufPtr;
-			NumBytes = (InstancePtr->Geometry.BytesPerPage <
+				NumBytes = PartialBytes;
+			} else {
+				BufPtr = (u8 *)SrcBufPtr;
+				NumBytes = (InstancePtr->Geometry.BytesPerPage <
 					(u32)LengthVar) ?
 					InstancePtr->Geometry.BytesPerPage :
 					(u32)LengthVar;
-		}
-		/* Program page */
-		Status = XNandPsu_ProgramPage(InstancePtr, Target, Page, 0U,
-								BufPtr);
-		if (Status != XST_SUCCESS)
-			goto Out;
+			}
+			/* Program page */
+			Status = XNandPsu_ProgramPage(InstancePtr, Target,
+							Page, 0U, BufPtr);
+			if (Status != XST_SUCCESS)
+				goto Out;
 
-		Status = XNandPsu_Device_Ready(InstancePtr, Target);
-		if (Status != XST_SUCCESS)
-			goto Out;
+			Status = XNandPsu_Device_Ready(InstancePtr, Target);
+			if (Status != XST_SUCCESS)
+				goto Out;
+		}
 
 		SrcBufPtr += NumBytes;
 		OffsetVar += NumBytes;
 		LengthVar -= NumBytes;
 	}
 
+	XNandPsu_GetTime(&End);
+	InstancePtr->Stats.WriteBytes += Length;
+	InstancePtr->Stats.WriteTime += (u64)(XNandPsu_Time)(End - Start);
 Out:
 	return Status;
 }
@@ -1457,10 +1751,13 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 	u32 PartialBytes = 0U;
 	u32 RemLen;
 	u32 NumBytes;
+	u32 NumPages;
 	u8 *BufPtr;
 	u8 *DestBufPtr = (u8 *)DestBuf;
 	u64 OffsetVar = Offset;
 	u64 LengthVar = Length;
+	XNandPsu_Time Start;
+	XNandPsu_Time End;
 
 	/* Assert the input arguments. */
 	Xil_AssertNonvoid(InstancePtr != NULL);
@@ -1469,6 +1766,8 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 	Xil_AssertNonvoid((OffsetVar + LengthVar) <=
 				InstancePtr->Geometry.DeviceSize);
 
+	XNandPsu_GetTime(&Start);
+
 	/*
 	 * Check if read operation exceeds flash size when including
 	 * bad blocks.
@@ -1509,31 +1808,51 @@ s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *DestBuf)
 		if (Page > InstancePtr->Geometry.NumTargetPages) {
 			Page %= InstancePtr->Geometry.NumTargetPages;
 		}
-		/* Check if partial read */
-		if (PartialBytes > 0U) {
-			BufPtr = &InstancePtr->PartialDataBuf[0];
-			NumBytes = PartialBytes;
+		/* Whole pages go through the read cache when supported */
+		NumPages = 0U;
+		if ((PartialBytes == 0U) && (InstancePtr->PipelineMode != 0U) &&
+			(InstancePtr->Features.CacheRead != 0U)) {
+			NumPages = XNandPsu_PageRun(InstancePtr, Page,
+							LengthVar);
+		}
+		if (NumPages > 1U) {
+			Status = XNandPsu_ReadCachePages(InstancePtr, Target,
+						Page, NumPages, DestBufPtr);
+			if (Status != XST_SUCCESS) {
+				goto Out;
+			}
+			NumBytes = NumPages * InstancePtr->Geometry.BytesPerPage;
 		} else {
-			BufPtr = DestBufPtr;
-			NumBytes = (InstancePtr->Geometry.BytesPerPage <
+			/* Check if partial read */
+			if (PartialBytes > 0U) {
+				BufPtr = &InstancePtr->PartialDataBuf[0];
+				NumBytes = PartialBytes;
+			} else {
+				BufPtr = DestBufPtr;
+				NumBytes = (InstancePtr->Geometry.BytesPerPage <
 					(u32)LengthVar) ?
 					InstancePtr->Geometry.BytesPerPage :
 					(u32)LengthVar;
-		}
-		/* Read page */
-		Status = XNandPsu_ReadPage(InstancePtr, Target, Page, 0U,
-								BufPtr);
-		if (Status != XST_SUCCESS) {
-			goto Out;
-		}
-		if (PartialBytes > 0U) {
-			(void)memcpy(DestBufPtr, BufPtr + Col, NumBytes);
+			}
+			/* Read page */
+			Status = XNandPsu_ReadPage(InstancePtr, Target, Page,
+								0U, BufPtr);
+			if (Status != XST_SUCCESS) {
+				goto Out;
+			}
+			if (PartialBytes > 0U) {
+				(void)memcpy(DestBufPtr, BufPtr + Col,
+								NumBytes);
+			}
 		}
 		DestBufPtr += NumBytes;
 		OffsetVar += NumBytes;
 		LengthVar -= NumBytes;
 	}
 
+	XNandPsu_GetTime(&End);
+	InstancePtr->Stats.ReadBytes += Length;
+	InstancePtr->Stats.ReadTime += (u64)(XNandPsu_Time)(End - Start);
 	Status = XST_SUCCESS;
 Out:
 	return Status;
@@ -1560,7 +1879,6 @@ Out:
 s32 XNandPsu_Erase(XNandPsu *InstancePtr, u64 Offset, u64 Length)
 {
 	s32 Status = XST_FAILURE;
-	u32 Target = 0;
 	u32 StartBlock;
 	u32 NumBlocks = 0;
 	u32 Block;
@@ -1615,23 +1933,7 @@ s32 XNandPsu_Erase(XNandPsu *InstancePtr, u64 Offset, u64 Length)
 		LengthVar -= EraseLen;
 	}
 
-	for (Block = StartBlock; Block < (StartBlock + NumBlocks); Block++) {
-		Target = Block/InstancePtr->Geometry.NumTargetBlocks;
-		Block %= InstancePtr->Geometry.NumTargetBlocks;
-		/* Don't erase bad block */
-		if (XNandPsu_IsBlockBad(InstancePtr, Block) ==
-							XST_SUCCESS)
-			continue;
-		/* Block Erase */
-		Status = XNandPsu_EraseBlock(InstancePtr, Target, Block);
-		if (Status != XST_SUCCESS)
-			goto Out;
-
-		Status = XNandPsu_Device_Ready(InstancePtr, Target);
-		if (Status != XST_SUCCESS)
-					goto Out;
-
-				}
+	Status = XNandPsu_EraseBlocks(InstancePtr, StartBlock, NumBlocks);
 Out:
 	return Status;
 }
@@ -1656,6 +1958,34 @@ Out:
 ******************************************************************************/
 static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 							u32 Col, u8 *Buf)
+{
+	return XNandPsu_ProgramPageCmd(InstancePtr, Target, Page, Col, Buf,
+							ONFI_CMD_PG_PROG2);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends an ONFI program command with the given second cycle to
+* flash: 10h for Page Program, 15h for Page Cache Program or 11h for the
+* first plane of a multi-plane program.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the page address value to program.
+* @param	Col is the column address value to program.
+* @param	Buf is the data buffer to program.
+* @param	Cmd2 is the second cycle of the program command.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_ProgramPageCmd(XNandPsu *InstancePtr, u32 Target, u32 Page,
+						u32 Col, u8 *Buf, u8 Cmd2)
 {
 	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
 				InstancePtr->Geometry.ColAddrCycles;
@@ -1675,7 +2005,7 @@ static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	}
 	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
 
-	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_PG_PROG1, ONFI_CMD_PG_PROG2,
+	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_PG_PROG1, Cmd2,
 					1U, 1U, (u8)AddrCycles);
 
 	if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
@@ -1715,52 +2045,237 @@ static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 /*****************************************************************************/
 /**
 *
-* This function sends ONFI Program Page command to flash.
+* This function programs a run of pages within a block with Page Cache
+* Program. Each page but the last is committed with 15h, which returns as
+* soon as the cache register is free, so the transfer of the next page
+* overlaps the array program of the previous one. The last page is committed
+* with 10h and waited for.
 *
 * @param	InstancePtr is a pointer to the XNandPsu instance.
 * @param	Target is the chip select value.
-* @param	Page is the page address value to program.
-* @param	Col is the column address value to program.
+* @param	Page is the first page address value to program.
+* @param	NumPages is the number of pages to program.
 * @param	Buf is the data buffer to program.
 *
 * @return
 *		- XST_SUCCESS if successful.
 *		- XST_FAILURE if failed.
 *
-* @note		None
+* @note		The pages must not cross a block boundary.
 *
 ******************************************************************************/
-s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
+static s32 XNandPsu_ProgramCachePages(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u32 NumPages, u8 *Buf)
 {
-	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
-				InstancePtr->Geometry.ColAddrCycles;
-	u32 Col = InstancePtr->Geometry.BytesPerPage;
-	u32 Target = Page/InstancePtr->Geometry.NumTargetPages;
-	u32 PktSize = InstancePtr->Geometry.SpareBytesPerPage;
-	u32 PktCount = 1U;
-	u32 *BufPtr = (u32 *)(void *)Buf;
-	u16 PreEccSpareCol = 0U;
-	u16 PreEccSpareWrCnt = 0U;
-	u16 PostEccSpareCol = 0U;
-	u16 PostEccSpareWrCnt = 0U;
-	u32 PostWrite = 0U;
-	OnfiCmdFormat Cmd;
 	s32 Status = XST_FAILURE;
-	u32 PageVar = Page;
-	u32 RegVal;
+	u32 Index;
+	u32 Last;
+	u8 *BufPtr = Buf;
 
 	/* Assert the input arguments. */
-	Xil_AssertNonvoid(InstancePtr != NULL);
-	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
-	Xil_AssertNonvoid(PageVar < InstancePtr->Geometry.NumPages);
-	Xil_AssertNonvoid(Buf != NULL);
+	Xil_AssertNonvoid(NumPages > 1U);
+	Xil_AssertNonvoid((Page + NumPages) <= InstancePtr->Geometry.NumPages);
+
+	for (Index = 0U; Index < NumPages; Index++) {
+		Last = (Index == (NumPages - 1U)) ? 1U : 0U;
+		Status = XNandPsu_ProgramPageCmd(InstancePtr, Target,
+				Page + Index, 0U, BufPtr,
+				(Last != 0U) ? ONFI_CMD_PG_PROG2 :
+						ONFI_CMD_PG_CACHE_PROG2);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		/* FAILC reports the page before the one just committed */
+		Status = XNandPsu_Cache_Ready(InstancePtr, Target, Last,
+					(Index > 0U) ? 1U : 0U);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+	InstancePtr->Stats.CacheProgPages += NumPages;
 
-	PageVar %= InstancePtr->Geometry.NumTargetPages;
+Out:
+	return Status;
+}
 
-	if (InstancePtr->EccMode == XNANDPSU_HWECC) {
-		/* Calculate ECC free positions before and after ECC code */
-		PreEccSpareCol = 0x0U;
-		PreEccSpareWrCnt = InstancePtr->EccCfg.EccAddr -
+/*****************************************************************************/
+/**
+*
+* This function programs a pair of blocks, one in each plane, with
+* multi-plane program. Page N of the even block is queued with 11h and page N
+* of the odd block commits both, with 15h when the flash supports cache
+* program so that the next pair is transferred while this one programs.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the first page of the even block.
+* @param	Buf is the data of both blocks, even block first.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		Both blocks must be good, see XNandPsu_IsPlanePair.
+*
+******************************************************************************/
+static s32 XNandPsu_ProgramPlanePair(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u8 *Buf)
+{
+	s32 Status = XST_FAILURE;
+	u32 PagesPerBlock = InstancePtr->Geometry.PagesPerBlock;
+	u32 BytesPerPage = InstancePtr->Geometry.BytesPerPage;
+	u32 Cache = InstancePtr->Features.CacheProg;
+	u32 Index;
+	u32 Commit;
+	u8 Cmd2;
+
+	for (Index = 0U; Index < PagesPerBlock; Index++) {
+		Status = XNandPsu_ProgramPageCmd(InstancePtr, Target,
+				Page + Index, 0U, Buf + (Index * BytesPerPage),
+				ONFI_CMD_MUL_PG_PROG2);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		/* Only the short tDBSY busy time after 11h */
+		Status = XNandPsu_Cache_Ready(InstancePtr, Target, 0U, 0U);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+
+		Commit = ((Cache == 0U) || (Index == (PagesPerBlock - 1U))) ?
+								1U : 0U;
+		Cmd2 = (Commit != 0U) ? ONFI_CMD_PG_PROG2 :
+					ONFI_CMD_PG_CACHE_PROG2;
+		Status = XNandPsu_ProgramPageCmd(InstancePtr, Target,
+				Page + PagesPerBlock + Index, 0U,
+				Buf + InstancePtr->Geometry.BlockSize +
+						(Index * BytesPerPage), Cmd2);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		Status = XNandPsu_Cache_Ready(InstancePtr, Target, Commit,
+				((Cache != 0U) && (Index > 0U)) ? 1U : 0U);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+	InstancePtr->Stats.PlaneProgPages += 2U * PagesPerBlock;
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks whether a write from the given position can program
+* the block and the next one as a multi-plane pair.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Block is the block of the write position.
+* @param	Page is the page of the write position.
+* @param	Length is the number of bytes left to write.
+*
+* @return	1 if the position starts a pair of good blocks covered
+*		entirely by the write, 0 otherwise.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 XNandPsu_IsPlanePair(XNandPsu *InstancePtr, u32 Block, u32 Page,
+							u64 Length)
+{
+	u32 IsPair = 0U;
+
+	if ((InstancePtr->Features.MultiPlane != 0U) &&
+		((Block & 1U) == 0U) &&
+		((Page % InstancePtr->Geometry.PagesPerBlock) == 0U) &&
+		(Length >= (2U * (u64)InstancePtr->Geometry.BlockSize)) &&
+		(XNandPsu_IsBlockBad(InstancePtr, Block + 1U) != XST_SUCCESS)) {
+		IsPair = 1U;
+	}
+
+	return IsPair;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the number of whole pages a transfer can cover from
+* the given page without leaving its block.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Page is the first page.
+* @param	Length is the number of bytes left to transfer.
+*
+* @return	Number of pages.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 XNandPsu_PageRun(XNandPsu *InstancePtr, u32 Page, u64 Length)
+{
+	u32 NumPages = InstancePtr->Geometry.PagesPerBlock -
+			(Page % InstancePtr->Geometry.PagesPerBlock);
+	u64 FullPages = Length / InstancePtr->Geometry.BytesPerPage;
+
+	if (FullPages < (u64)NumPages) {
+		NumPages = (u32)FullPages;
+	}
+
+	return NumPages;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends ONFI Program Page command to flash.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the page address value to program.
+* @param	Col is the column address value to program.
+* @param	Buf is the data buffer to program.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
+{
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+	u32 Col = InstancePtr->Geometry.BytesPerPage;
+	u32 Target = Page/InstancePtr->Geometry.NumTargetPages;
+	u32 PktSize = InstancePtr->Geometry.SpareBytesPerPage;
+	u32 PktCount = 1U;
+	u32 *BufPtr = (u32 *)(void *)Buf;
+	u16 PreEccSpareCol = 0U;
+	u16 PreEccSpareWrCnt = 0U;
+	u16 PostEccSpareCol = 0U;
+	u16 PostEccSpareWrCnt = 0U;
+	u32 PostWrite = 0U;
+	OnfiCmdFormat Cmd;
+	s32 Status = XST_FAILURE;
+	u32 PageVar = Page;
+	u32 RegVal;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(PageVar < InstancePtr->Geometry.NumPages);
+	Xil_AssertNonvoid(Buf != NULL);
+
+	PageVar %= InstancePtr->Geometry.NumTargetPages;
+
+	if (InstancePtr->EccMode == XNANDPSU_HWECC) {
+		/* Calculate ECC free positions before and after ECC code */
+		PreEccSpareCol = 0x0U;
+		PreEccSpareWrCnt = InstancePtr->EccCfg.EccAddr -
 				(u16)InstancePtr->Geometry.BytesPerPage;
 
 		PostEccSpareCol = PreEccSpareWrCnt +
@@ -1931,6 +2446,31 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	Status = XNandPsu_Data_ReadWrite(InstancePtr, Buf, PktCount, PktSize, 0, 1);
 
 	/* Check ECC Errors */
+	Status = XNandPsu_CheckEcc(InstancePtr, Status);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the ECC status of the page just read and updates the
+* bit flip counters.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	XferStatus is the status of the data transfer.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_CheckEcc(XNandPsu *InstancePtr, s32 XferStatus)
+{
+	s32 Status = XferStatus;
+
 	if (InstancePtr->EccMode == XNANDPSU_HWECC) {
 		/* Hamming Multi Bit Errors */
 		if (((u32)XNandPsu_ReadReg(InstancePtr->Config.BaseAddress,
@@ -1979,6 +2519,134 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function reads a run of pages within a block with the ONFI read cache
+* commands. The controller sends 00h-address-30h followed by 31h for the
+* first page, 31h for the following pages and 3Fh for the last one. Each 31h
+* moves the next page to the cache register and starts the array read of the
+* one after it, so the array access of page N+1 overlaps the transfer of
+* page N.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the first page address value to read.
+* @param	NumPages is the number of pages to read, at least 2.
+* @param	Buf is the data buffer to fill in.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The pages must not cross a block boundary. An uncorrectable
+*		ECC error does not stop the sequence, which has to be ended
+*		with 3Fh, but is returned once all pages are read.
+*
+******************************************************************************/
+static s32 XNandPsu_ReadCachePages(XNandPsu *InstancePtr, u32 Target,
+					u32 Page, u32 NumPages, u8 *Buf)
+{
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+	u32 PktSize;
+	u32 PktCount;
+	u32 RegVal;
+	u32 ProgVal;
+	u32 Index;
+	u8 Cmd1;
+	u8 Cmd2;
+	u8 Cycles;
+	u8 *BufPtr = Buf;
+	s32 Status = XST_FAILURE;
+	s32 EccStatus = XST_SUCCESS;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(NumPages > 1U);
+	Xil_AssertNonvoid((Page + NumPages) <= InstancePtr->Geometry.NumPages);
+	Xil_AssertNonvoid(Target < XNANDPSU_MAX_TARGETS);
+
+	if (InstancePtr->EccCfg.CodeWordSize > 9U) {
+		PktSize = 1024U;
+	} else {
+		PktSize = 512U;
+	}
+	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
+
+	for (Index = 0U; Index < NumPages; Index++) {
+		if (Index == 0U) {
+			Cmd1 = ONFI_CMD_RD1;
+			Cmd2 = ONFI_CMD_RD2;
+			Cycles = (u8)AddrCycles;
+			ProgVal = XNANDPSU_PROG_RD_CACHE_START_MASK;
+		} else if (Index < (NumPages - 1U)) {
+			Cmd1 = ONFI_CMD_RD_CACHE_SEQ;
+			Cmd2 = ONFI_CMD_INVALID;
+			Cycles = 0U;
+			ProgVal = XNANDPSU_PROG_RD_CACHE_SEQ_MASK;
+		} else {
+			Cmd1 = ONFI_CMD_RD_CACHE_END;
+			Cmd2 = ONFI_CMD_INVALID;
+			Cycles = 0U;
+			ProgVal = XNANDPSU_PROG_RD_CACHE_END_MASK;
+		}
+
+		XNandPsu_Prepare_Cmd(InstancePtr, Cmd1, Cmd2, 1U, 1U, Cycles);
+
+		if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
+			RegVal = XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK |
+				 XNANDPSU_INTR_STS_EN_DMA_INT_STS_EN_MASK;
+			Xil_DCacheInvalidateRange((INTPTR)(void *)BufPtr,
+							(PktSize * PktCount));
+			XNandPsu_Update_DmaAddr(InstancePtr, BufPtr);
+		} else {
+			RegVal = XNANDPSU_INTR_STS_EN_BUFF_RD_RDY_STS_EN_MASK;
+		}
+		/* Enable Single bit error and Multi bit error */
+		if (InstancePtr->EccMode == XNANDPSU_HWECC)
+			RegVal |= XNANDPSU_INTR_STS_EN_MUL_BIT_ERR_STS_EN_MASK |
+				 XNANDPSU_INTR_STS_EN_ERR_INTR_STS_EN_MASK;
+
+		XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			   XNANDPSU_INTR_STS_EN_OFFSET, RegVal);
+		/* Program Page Size */
+		XNandPsu_SetPageSize(InstancePtr);
+		/* Program Column, Page, Block address */
+		XNandPsu_SetPageColAddr(InstancePtr, Page + Index, 0U);
+		/* Program Packet Size and Packet Count */
+		XNandPsu_SetPktSzCnt(InstancePtr, PktSize, PktCount);
+		/* Program Memory Address Register2 for chip select */
+		XNandPsu_SelectChip(InstancePtr, Target);
+		/* Set ECC */
+		if (InstancePtr->EccMode == XNANDPSU_HWECC) {
+			XNandPsu_SetEccSpareCmd(InstancePtr,
+					(ONFI_CMD_CHNG_RD_COL1 |
+					(ONFI_CMD_CHNG_RD_COL2 << (u8)8U)),
+					InstancePtr->Geometry.ColAddrCycles);
+		}
+
+		/* Set Read Cache command in Program Register */
+		XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+					XNANDPSU_PROG_OFFSET, ProgVal);
+
+		Status = XNandPsu_Data_ReadWrite(InstancePtr, BufPtr, PktCount,
+							PktSize, 0, 1);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+
+		if (XNandPsu_CheckEcc(InstancePtr, Status) != XST_SUCCESS) {
+			EccStatus = XST_FAILURE;
+		}
+		BufPtr += InstancePtr->Geometry.BytesPerPage;
+	}
+	InstancePtr->Stats.CacheReadPages += NumPages;
+	Status = EccStatus;
+
+Out:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -2063,18 +2731,44 @@ s32 XNandPsu_ReadSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
 ******************************************************************************/
 s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block)
 {
-	s32 Status = XST_FAILURE;
-	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles;
-	u32 Page;
-	u32 ErasePage;
-	u32 EraseCol;
-
 	/* Assert the input arguments. */
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertNonvoid(Target < XNANDPSU_MAX_TARGETS);
 	Xil_AssertNonvoid(Block < InstancePtr->Geometry.NumBlocks);
 
+	return XNandPsu_EraseBlockCmd(InstancePtr, Target, Block,
+						ONFI_CMD_BLK_ERASE2);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends an ONFI block erase command with the given second
+* cycle to the flash: D0h for Block Erase or D1h for the first plane of a
+* multi-plane erase.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Block is the block to erase.
+* @param	Cmd2 is the second cycle of the erase command.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_EraseBlockCmd(XNandPsu *InstancePtr, u32 Target,
+						u32 Block, u8 Cmd2)
+{
+	s32 Status = XST_FAILURE;
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles;
+	u32 Page;
+	u32 ErasePage;
+	u32 EraseCol;
+
 	Page = Block * InstancePtr->Geometry.PagesPerBlock;
 	ErasePage = (Page >> 16U) & 0xFFFFU;
 	EraseCol = Page & 0xFFFFU;
@@ -2089,7 +2783,7 @@ s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block)
 
 	/* Program Command */
 	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_BLK_ERASE1,
-			ONFI_CMD_BLK_ERASE2, 0U , 0U, (u8)AddrCycles);
+			Cmd2, 0U , 0U, (u8)AddrCycles);
 	/* Program Column, Page, Block address */
 	XNandPsu_SetPageColAddr(InstancePtr, ErasePage, (u16)EraseCol);
 	/* Program Memory Address Register2 for chip select */
@@ -2102,6 +2796,134 @@ s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function erases a range of blocks, skipping the bad ones. Pairs of
+* good blocks, one in each plane, are erased together with multi-plane
+* erase. On multi-LUN flashes the blocks of each LUN are erased in turn, so
+* that every LUN in the range erases concurrently, and a LUN is only polled
+* with Read Status Enhanced when it gets its next block.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	StartBlock is the first block to erase.
+* @param	NumBlocks is the number of blocks to erase.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		Without pipelining, the blocks are erased one at a time.
+*
+******************************************************************************/
+static s32 XNandPsu_EraseBlocks(XNandPsu *InstancePtr, u32 StartBlock,
+							u32 NumBlocks)
+{
+	s32 Status = XST_SUCCESS;
+	u32 Next[XNANDPSU_MAX_TARGETS * XNANDPSU_MAX_LUNS];
+	u32 End[XNANDPSU_MAX_TARGETS * XNANDPSU_MAX_LUNS];
+	u32 Busy[XNANDPSU_MAX_TARGETS * XNANDPSU_MAX_LUNS];
+	u32 EndBlock = StartBlock + NumBlocks;
+	u32 NumLuns = 1U;
+	u32 MultiPlane = 0U;
+	u32 BlocksPerUnit;
+	u32 NumUnits;
+	u32 Unit;
+	u32 Block;
+	u32 Target;
+	u32 Pending;
+
+	if (InstancePtr->PipelineMode != 0U) {
+		MultiPlane = InstancePtr->Features.MultiPlane;
+		if (InstancePtr->Features.MultiLun != 0U) {
+			NumLuns = InstancePtr->Geometry.NumLuns;
+		}
+	}
+	/* A unit is a LUN, or a whole target without multi-LUN support */
+	BlocksPerUnit = InstancePtr->Geometry.NumTargetBlocks / NumLuns;
+	NumUnits = (u32)InstancePtr->Geometry.NumTargets * NumLuns;
+
+	for (Unit = 0U; Unit < NumUnits; Unit++) {
+		Next[Unit] = Unit * BlocksPerUnit;
+		End[Unit] = Next[Unit] + BlocksPerUnit;
+		if (Next[Unit] < StartBlock) {
+			Next[Unit] = StartBlock;
+		}
+		if (End[Unit] > EndBlock) {
+			End[Unit] = EndBlock;
+		}
+		Busy[Unit] = XNANDPSU_LUN_IDLE;
+	}
+
+	do {
+		Pending = 0U;
+		for (Unit = 0U; Unit < NumUnits; Unit++) {
+			if (Next[Unit] >= End[Unit]) {
+				continue;
+			}
+			Pending = 1U;
+			Block = Next[Unit];
+			Next[Unit]++;
+			/* Don't erase bad block */
+			if (XNandPsu_IsBlockBad(InstancePtr, Block) ==
+							XST_SUCCESS) {
+				continue;
+			}
+			Target = Block / InstancePtr->Geometry.NumTargetBlocks;
+			Block %= InstancePtr->Geometry.NumTargetBlocks;
+
+			/* The LUN takes no command until its erase is done */
+			if (Busy[Unit] != XNANDPSU_LUN_IDLE) {
+				Status = XNandPsu_Lun_Ready(InstancePtr, Target,
+								Busy[Unit]);
+				if (Status != XST_SUCCESS) {
+					goto Out;
+				}
+				Busy[Unit] = XNANDPSU_LUN_IDLE;
+			}
+
+			if ((MultiPlane != 0U) && ((Block & 1U) == 0U) &&
+				(Next[Unit] < End[Unit]) &&
+				(XNandPsu_IsBlockBad(InstancePtr,
+					Next[Unit]) != XST_SUCCESS)) {
+				Status = XNandPsu_EraseBlockCmd(InstancePtr,
+					Target, Block, ONFI_CMD_MUL_BLK_ERASE2);
+				if (Status != XST_SUCCESS) {
+					goto Out;
+				}
+				Status = XNandPsu_Lun_Ready(InstancePtr, Target,
+				Block * InstancePtr->Geometry.PagesPerBlock);
+				if (Status != XST_SUCCESS) {
+					goto Out;
+				}
+				Block++;
+				Next[Unit]++;
+			}
+
+			Status = XNandPsu_EraseBlockCmd(InstancePtr, Target,
+						Block, ONFI_CMD_BLK_ERASE2);
+			if (Status != XST_SUCCESS) {
+				goto Out;
+			}
+			Busy[Unit] = Block * InstancePtr->Geometry.PagesPerBlock;
+		}
+	} while (Pending != 0U);
+
+	/* Wait for the last erase of every LUN */
+	for (Unit = 0U; Unit < NumUnits; Unit++) {
+		if (Busy[Unit] != XNANDPSU_LUN_IDLE) {
+			Status = XNandPsu_Lun_Ready(InstancePtr,
+					Unit / NumLuns, Busy[Unit]);
+			if (Status != XST_SUCCESS) {
+				goto Out;
+			}
+		}
+	}
+
+Out:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -2803,6 +3625,94 @@ Out:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function waits for the cache register after a cache or multi-plane
+* command, and optionally for the array.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chipselect value.
+* @param	WaitArray is 1 to also wait for the array and check FAIL.
+* @param	CheckPrev is 1 to check FAILC, the status of the page
+*		committed before the last one.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_Cache_Ready(XNandPsu *InstancePtr, u32 Target,
+					u32 WaitArray, u32 CheckPrev)
+{
+s32 Status = XST_SUCCESS;
+u16 OnfiStatus;
+u16 ReadyMask = ONFI_STS_RDY;
+
+	if (WaitArray != 0U)
+		ReadyMask |= ONFI_STS_ARDY;
+
+	do {
+		Status = XNandPsu_OnfiReadStatus(InstancePtr, Target,
+							&OnfiStatus);
+		if (Status != XST_SUCCESS)
+			goto Out;
+	} while ((OnfiStatus & ReadyMask) != ReadyMask);
+
+	if ((CheckPrev != 0U) && ((OnfiStatus & ONFI_STS_FAILC) != 0U))
+		Status = XST_FAILURE;
+	if ((WaitArray != 0U) && ((OnfiStatus & ONFI_STS_FAIL) != 0U))
+		Status = XST_FAILURE;
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function waits for the LUN holding the given page to be ready. On
+* multi-LUN flashes it polls with Read Status Enhanced, which is required
+* while other LUNs are busy.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chipselect value.
+* @param	Page is a page address in the LUN.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_Lun_Ready(XNandPsu *InstancePtr, u32 Target, u32 Page)
+{
+s32 Status = XST_SUCCESS;
+u16 OnfiStatus;
+
+	if ((InstancePtr->PipelineMode == 0U) ||
+		(InstancePtr->Features.MultiLun == 0U)) {
+		Status = XNandPsu_Device_Ready(InstancePtr, Target);
+		goto Out;
+	}
+
+	do {
+		Status = XNandPsu_OnfiReadStatusEnh(InstancePtr, Target, Page,
+							&OnfiStatus);
+		if (Status != XST_SUCCESS)
+			goto Out;
+	} while ((OnfiStatus & ONFI_STS_RDY) == 0U);
+
+	if ((OnfiStatus & ONFI_STS_FAIL) != 0U)
+		Status = XST_FAILURE;
+
+Out:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -96,6 +96,23 @@
 * only after the erase operation is completed successfully or an error is
 * reported.
 *
+* <b>Pipelined Operation</b>
+*
+* When the flash advertises them in its parameter page, the read, write and
+* erase calls use the ONFI optional operations to keep the array busy while
+* data moves over the bus:
+*	- Read Cache (31h/3Fh) for runs of whole pages within a block, so that
+*	  the array read of page N+1 overlaps the transfer of page N.
+*	- Page Cache Program (80h-15h) for runs of whole pages within a block,
+*	  so that the transfer of page N+1 overlaps the program of page N.
+*	- Multi-plane program and erase (11h/D1h) for whole, good block pairs.
+*	- Multi-LUN erase, interleaving the blocks of each LUN and tracking
+*	  them with Read Status Enhanced (78h).
+* Partial pages and single pages use the plain commands. The logical layout
+* of the flash is not changed. XNandPsu_DisablePipelineMode() restricts the
+* driver to the plain commands. XNandPsu_GetStats() reports the sustained
+* read and write throughput.
+*
 * @note		Driver has been renamed to nandpsu after change in
 *		naming convention.
 *
@@ -158,6 +175,9 @@
 * 1.0   kpc    17/06/2015  Increased the timeout for complete event to avoid
 *			   timeout errors for erase operation on slower devices.
 * 1.1   mi     09/16/16 Removed compilation warnings with extra compiler flags.
+* 1.2   esd    10/18/26 Added cache read/program, multi-plane and multi-LUN
+*			   pipelining to XNandPsu_Read/Write/Erase, and
+*			   throughput statistics.
 * </pre>
 *
 ******************************************************************************/
@@ -182,6 +202,8 @@ extern "C" {
 #define XNANDPSU_DEBUG
 
 #define XNANDPSU_MAX_TARGETS		1U	/**< ce_n0, ce_n1 */
+#define XNANDPSU_MAX_LUNS		4U	/**< Max LUNs interleaved per
+						  target */
 #define XNANDPSU_MAX_PKT_SIZE		0x7FFU	/**< Max packet size */
 #define XNANDPSU_MAX_PKT_COUNT		0xFFFU	/**< Max packet count */
 
@@ -332,8 +354,29 @@ typedef struct {
 	u32 EzNand;
 	u32 OnDie;
 	u32 ExtPrmPage;
+	u32 CacheRead;		/**< Read Cache (31h/3Fh) supported */
+	u32 CacheProg;		/**< Page Cache Program (15h) supported */
+	u32 MultiPlane;		/**< Multi-plane program/erase supported */
+	u32 MultiLun;		/**< Multi-LUN operations with Read Status
+				  Enhanced supported */
 } XNandPsu_Features;
 
+/**
+ * The XNandPsu_Stats structure contains the throughput statistics of
+ * XNandPsu_Read and XNandPsu_Write.
+ */
+typedef struct {
+	u64 ReadBytes;		/**< Bytes read */
+	u64 ReadTime;		/**< Timer counts spent reading */
+	u64 WriteBytes;		/**< Bytes written */
+	u64 WriteTime;		/**< Timer counts spent writing */
+	u32 CacheReadPages;	/**< Pages read with Read Cache */
+	u32 CacheProgPages;	/**< Pages programmed with Page Cache Program */
+	u32 PlaneProgPages;	/**< Pages programmed as multi-plane pairs */
+	u32 ReadMBps;		/**< Sustained read rate in MB/s */
+	u32 WriteMBps;		/**< Sustained write rate in MB/s */
+} XNandPsu_Stats;
+
 /**
  * The XNandPsu_EccMatrix structure contains ECC features information.
  */
@@ -376,6 +419,9 @@ typedef struct {
 	XNandPsu_EccCfg EccCfg;		/**< ECC configuration */
 	XNandPsu_Geometry Geometry;	/**< Flash geometry */
 	XNandPsu_Features Features;	/**< ONFI features */
+	u32 PipelineMode;		/**< Cache/multi-plane/multi-LUN
+					  operations enabled */
+	XNandPsu_Stats Stats;		/**< Throughput statistics */
 	u8 PartialDataBuf[XNANDPSU_MAX_PAGE_SIZE] __attribute__ ((aligned(64)));
 					/**< Partial read/write buffer */
 	/* Bad block table definitions */
@@ -554,6 +600,14 @@ void XNandPsu_EnableEccMode(XNandPsu *InstancePtr);
 
 void XNandPsu_DisableEccMode(XNandPsu *InstancePtr);
 
+void XNandPsu_EnablePipelineMode(XNandPsu *InstancePtr);
+
+void XNandPsu_DisablePipelineMode(XNandPsu *InstancePtr);
+
+void XNandPsu_GetStats(XNandPsu *InstancePtr, XNandPsu_Stats *StatsPtr);
+
+void XNandPsu_ResetStats(XNandPsu *InstancePtr);
+
 void XNandPsu_Prepare_Cmd(XNandPsu *InstancePtr, u8 Cmd1, u8 Cmd2, u8 EccState,
 			u8 DmaMode, u8 AddrCycles);
 
@@ -0,0 +1,277 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xprc_rmcache_example.c
+*
+* This file contains a design example using the Reconfigurable Module cache
+* of the PRC driver (XPrc) to swap the RMs of a software triggered VSM.
+*
+* The partial bitstreams of the RMs are expected in a bitstream store in
+* memory, for example copied there from an SD card, at the addresses listed
+* in RmStore. The fetch callback copies them into the cache slots on demand.
+* The VSM is marked quiescent, so the cache prefetches the RM which followed
+* the current one last time while the application works with the current RM.
+*
+* @note		The slot area must be free DDR below 4GB, reachable by the
+*		PRC fetch path.
+*
+* MODIFICATION HISTORY:
+* <pre>
+* Ver   Who     Date	    Changes
+* ---- ---- ------------ -------------------------------------------
+* 1.1   esd  10/18/2026   First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xprc.h"
+#include "xparameters.h"
+#include "xil_printf.h"
+#include <string.h>
+
+/************************** Constant Definitions *****************************/
+
+/**
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+#define XPRC_DEVICE_ID	XPAR_PRC_DEVICE_ID
+
+#define VSM_ID			0		/**< VSM to swap RMs in */
+#define NUM_RMS			3		/**< RMs in the store */
+#define SLOT_BASE_ADDR		0x20000000U	/**< DDR area for the slots */
+#define SLOT_SIZE		0x00100000U	/**< Largest RM bitstream */
+#define NUM_SLOTS		2		/**< Fewer than the RMs, so
+						  *  the cache has to evict */
+#define NUM_SWAPS		12		/**< Swaps to perform */
+#define SWAP_POLL_COUNT		1000000		/**< Process calls per swap */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * This typedef contains the location of a partial bitstream in the
+ * bitstream store.
+ */
+typedef struct {
+	UINTPTR Address;	/**< Address of the bitstream */
+	u32 Size;		/**< Size of the bitstream in bytes */
+} RmStoreEntry;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+u32 XPrc_RmCacheExample(u16 DeviceId);
+static s32 RmFetch(void *CallBackRef, u16 VsmId, u16 RmId, UINTPTR SlotAddr,
+			u32 SlotSize, u32 *BsSizePtr);
+
+/************************** Variable Definitions *****************************/
+
+XPrc Prc;		/* Instance of the PRC */
+XPrc_RmCache RmCache;	/* RM cache on the PRC */
+
+/**
+ * Bitstream store, to be filled with the partial bitstreams of the RMs of
+ * VSM_ID in RM identifier order.
+ */
+RmStoreEntry RmStore[NUM_RMS] = {
+	{ 0x30000000U, 0x00080000U },
+	{ 0x30100000U, 0x00080000U },
+	{ 0x30200000U, 0x00080000U }
+};
+
+/**
+ * Sequence of RMs requested, repeated patterns let the cache learn which
+ * RM follows which one.
+ */
+u16 SwapSequence[NUM_SWAPS] = { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2 };
+
+/*****************************************************************************/
+/**
+*
+* This is the main function to call the example.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	u32 Status;
+
+	/**
+	 * Run the PRC RM cache example, specify the Device ID that is
+	 * generated in xparameters.h
+	 */
+	Status = XPrc_RmCacheExample((u16)XPRC_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("PRC RM cache example is failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran PRC RM cache example\r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function swaps the RMs of a VSM through the RM cache and prints the
+* cache statistics.
+*
+* @param	DeviceId is the XPAR_<prc_instance>_DEVICE_ID value from
+*		xparameters.h.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The VSM must be set up with one software trigger mapped to
+*		each RM.
+*
+******************************************************************************/
+u32 XPrc_RmCacheExample(u16 DeviceId)
+{
+	int Status;
+	XPrc_Config *CfgPtr;
+	u32 Swap;
+	u32 PollCount;
+	u16 RmId;
+
+	/**
+	 * Initialize the PRC driver so that it's ready to use.
+	 * Look up the configuration in the config table, then initialize it.
+	 */
+	CfgPtr = XPrc_LookupConfig(DeviceId);
+	if (NULL == CfgPtr) {
+		return XST_FAILURE;
+	}
+
+	Status = XPrc_CfgInitialize(&Prc, CfgPtr, CfgPtr->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	if ((XPrc_GetNumberOfVsms(&Prc) <= VSM_ID) ||
+		(XPrc_GetNumRms(&Prc, VSM_ID) < NUM_RMS)) {
+		return XST_FAILURE;
+	}
+
+	Status = XPrc_RmCacheInitialize(&RmCache, &Prc, SLOT_BASE_ADDR,
+				SLOT_SIZE, NUM_SLOTS, RmFetch, RmStore);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/**
+	 * The RMs of this VSM only work while the application drives them,
+	 * so the cache may shut the VSM down between swaps to prefetch.
+	 */
+	XPrc_RmCacheSetQuiescent(&RmCache, VSM_ID, TRUE);
+
+	for (Swap = 0; Swap < NUM_SWAPS; Swap++) {
+		RmId = SwapSequence[Swap];
+		Status = XPrc_RmCacheRequest(&RmCache, VSM_ID, RmId);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		for (PollCount = 0; PollCount < SWAP_POLL_COUNT;
+							PollCount++) {
+			XPrc_RmCacheProcess(&RmCache);
+			if (XPrc_RmCacheIsIdle(&RmCache, VSM_ID) == TRUE) {
+				break;
+			}
+		}
+
+		if (XPrc_RmCacheGetCurrentRm(&RmCache, VSM_ID) != RmId) {
+			XPrc_RmCachePrintStats(&RmCache);
+			return XST_FAILURE;
+		}
+
+		/**
+		 * The application uses the RM here. One more call stages the
+		 * RM expected next while the VSM is quiescent.
+		 */
+		XPrc_RmCacheProcess(&RmCache);
+	}
+
+	XPrc_RmCachePrintStats(&RmCache);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function is the fetch callback of the RM cache. It copies the partial
+* bitstream of an RM from the bitstream store into a slot.
+*
+* @param	CallBackRef is the bitstream store.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM.
+* @param	SlotAddr is the address of the slot.
+* @param	SlotSize is the size of the slot in bytes.
+* @param	BsSizePtr receives the size of the bitstream in bytes.
+*
+* @return
+*		- XST_SUCCESS if the bitstream was copied.
+*		- XST_FAILURE if the RM is unknown or does not fit.
+*
+* @note		The RM cache flushes the slot from the data cache.
+*
+******************************************************************************/
+static s32 RmFetch(void *CallBackRef, u16 VsmId, u16 RmId, UINTPTR SlotAddr,
+			u32 SlotSize, u32 *BsSizePtr)
+{
+	RmStoreEntry *StorePtr = (RmStoreEntry *)CallBackRef;
+
+	if ((VsmId != VSM_ID) || (RmId >= NUM_RMS) ||
+		(StorePtr[RmId].Size > SlotSize)) {
+		return XST_FAILURE;
+	}
+
+	memcpy((void *)SlotAddr, (void *)StorePtr[RmId].Address,
+					StorePtr[RmId].Size);
+	*BsSizePtr = StorePtr[RmId].Size;
+
+	return XST_SUCCESS;
+}
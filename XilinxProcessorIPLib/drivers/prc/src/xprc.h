@@ -89,6 +89,34 @@
 *      API which returns the Configuration structure pointer which is passed
 *      as a parameter to the XPrc_CfgInitialize() API.
 *
+* <b> Reconfigurable Module cache </b>
+*
+* The optional RM cache (xprc_rmcache.c) manages Reconfigurable Module
+* bitstreams for VSMs which are triggered by software. It keeps a number of
+* equal sized slots in DDR, stages RM bitstreams into them on demand
+* through a user fetch callback and evicts the least recently used one when
+* all slots are taken. The Bitstream Information registers of an RM point at
+* its slot while it is staged. The slots must lie below 4GB, the bitstream
+* address registers are 32 bits wide.
+*   - XPrc_RmCacheInitialize() sets up the slots and the callbacks.
+*   - XPrc_RmCacheRequest() asks for an RM to be loaded in a VSM. Requests
+*     to a VSM which arrive before the previous one was started replace it.
+*   - XPrc_RmCachePredict() hints the RM a VSM is likely to need next. The
+*     cache also remembers which RM followed each staged RM and prefetches
+*     that one when the VSM is idle.
+*   - XPrc_RmCacheSetQuiescent() marks a VSM whose RM may be interrupted at
+*     any time. Writing the registers of a VSM needs a shutdown, so
+*     prefetching for a VSM and evicting the slot of a VSM other than the
+*     requesting one are only done on quiescent VSMs. No VSM is quiescent
+*     after XPrc_RmCacheInitialize(), which leaves prefetching off.
+*   - XPrc_RmCacheProcess() does the work: it collects finished loads,
+*     stages requested and predicted RMs, and sends the software triggers.
+*     Register updates of a VSM are made in a single shutdown and restart
+*     of that VSM. The restart reports the VSM as full or empty with the RM
+*     it held before the shutdown.
+* Swap latency, from request to the VSM reporting the RM loaded, is kept in
+* a histogram with power of two bins in units of the user time callback.
+*
 * <b> Threads </b>
 *
 * This driver is not thread safe. Any needs for threads or thread mutual
@@ -123,6 +151,8 @@
 * Ver   Who      Date        Changes
 * ---- -----  ------------  ----------------------------------------------
 * 1.0   ms     07/18/2016   First release
+* 1.1   esd    10/18/2026   Added the Reconfigurable Module cache,
+*                           XPrc_RmCache* APIs in xprc_rmcache.c
 *
 * </pre>
 *
@@ -310,6 +340,101 @@ typedef struct {
 	XPrc_Config Config;	/**< Pointer to instance config entry */
 } XPrc;
 
+/** @name Reconfigurable Module cache
+ * @{
+ */
+#define XPRC_RMC_MAX_SLOTS	(32)	/**< Maximum number of slots */
+#define XPRC_RMC_HIST_BINS	(32)	/**< Latency histogram bins, bin N
+					  *  counts latencies from 2^N to
+					  *  2^(N+1) - 1 */
+#define XPRC_RMC_NONE		(0xFFFF)/**< No RM / no slot */
+#define XPRC_RMC_POLL_COUNT	(100000)/**< Polls for VSM shutdown and
+					  *  restart */
+/*@}*/
+
+/**
+ * Callback to copy the bitstream of an RM into a slot. It returns
+ * XST_SUCCESS and the bitstream size in bytes, or XST_FAILURE.
+ */
+typedef s32 (*XPrc_RmFetchHandler)(void *CallBackRef, u16 VsmId, u16 RmId,
+			UINTPTR SlotAddr, u32 SlotSize, u32 *BsSizePtr);
+
+/**
+ * Callback returning a free running time stamp used for swap latencies.
+ */
+typedef u32 (*XPrc_RmTimeHandler)(void *CallBackRef);
+
+/**
+ * This typedef contains one DDR slot of the RM cache.
+ */
+typedef struct {
+	u16 VsmId;		/**< VSM of the staged RM */
+	u16 RmId;		/**< Staged RM, XPRC_RMC_NONE when empty */
+	u16 NextRmId;		/**< RM requested after this one the last
+				  *  time, XPRC_RMC_NONE if unknown */
+	u32 BsSize;		/**< Size of the staged bitstream */
+	u32 LastUse;		/**< LRU stamp */
+} XPrc_RmSlot;
+
+/**
+ * This typedef contains the per VSM state of the RM cache.
+ */
+typedef struct {
+	u16 CurrentRmId;	/**< RM loaded in the VSM */
+	u16 LoadingRmId;	/**< RM being loaded */
+	u16 RequestRmId;	/**< RM requested and not started yet */
+	u16 PredictRmId;	/**< RM to be prefetched */
+	u32 RequestTime;	/**< Time stamp of the request */
+	u16 WindowRmId;		/**< RM loaded when the cache shut the VSM
+				  *  down */
+	u8 WindowFull;		/**< XPRC_CR_VS_FULL if the VSM was full
+				  *  when the cache shut it down */
+} XPrc_RmVsm;
+
+/**
+ * This typedef contains the statistics of the RM cache.
+ */
+typedef struct {
+	u32 Requests;		/**< Requests received */
+	u32 Replaced;		/**< Requests replaced by a newer one to
+				  *  the same VSM before being started */
+	u32 Hits;		/**< Requested RM was staged */
+	u32 Misses;		/**< Requested RM had to be fetched */
+	u32 Prefetches;		/**< RMs staged ahead of a request */
+	u32 PrefetchHits;	/**< Requests served by a prefetched RM */
+	u32 Evictions;		/**< Staged RMs evicted */
+	u32 Windows;		/**< VSM shutdown and restart windows */
+	u32 Swaps;		/**< RM loads completed */
+	u32 Errors;		/**< Fetch or load errors */
+	u32 Timeouts;		/**< VSM shutdown or restart timeouts */
+	u32 Hist[XPRC_RMC_HIST_BINS];	/**< Swap latency histogram */
+} XPrc_RmStats;
+
+/**
+ * The RM cache instance data structure.
+ */
+typedef struct {
+	XPrc *PrcPtr;		/**< PRC the cache works on */
+	UINTPTR SlotBase;	/**< DDR address of the first slot */
+	u32 SlotSize;		/**< Size of each slot in bytes */
+	u16 NumSlots;		/**< Number of slots */
+	u32 Clock;		/**< LRU clock */
+	u32 WindowMask;		/**< VSMs shut down by the cache and not
+				  *  restarted yet */
+	u32 QuiescentMask;	/**< VSMs which may be shut down for
+				  *  prefetches and evictions */
+	XPrc_RmFetchHandler FetchHandler;	/**< Bitstream fetch */
+	void *FetchRef;		/**< Passed to FetchHandler */
+	XPrc_RmTimeHandler TimeHandler;	/**< Time stamps, may be NULL */
+	void *TimeRef;		/**< Passed to TimeHandler */
+	XPrc_RmSlot Slot[XPRC_RMC_MAX_SLOTS];	/**< Slots */
+	u8 Prefetched[XPRC_RMC_MAX_SLOTS];	/**< Slot was staged by a
+						  *  prefetch and not yet
+						  *  requested */
+	XPrc_RmVsm Vsm[XPRC_MAX_NUMBER_OF_VSMS];/**< Per VSM state */
+	XPrc_RmStats Stats;	/**< Statistics */
+} XPrc_RmCache;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -729,6 +854,22 @@ typedef struct {
 #define XPrc_GetNumHwTriggers(InstancePtr, VsmId) \
 		(InstancePtr)->Config.Num_Hw_Triggers[VsmId]
 
+/*****************************************************************************/
+/**
+*
+* This macro returns the RM the RM cache last saw loaded in a VSM.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM to access.
+*
+* @return	RM identifier or XPRC_RMC_NONE if unknown.
+*
+* @note		None.
+*
+******************************************************************************/
+#define XPrc_RmCacheGetCurrentRm(CachePtr, VsmId) \
+		(CachePtr)->Vsm[VsmId].CurrentRmId
+
 /************************** Function Prototypes ******************************/
 
 /* Lookup configuration in xprc_sinit.c */
@@ -779,6 +920,21 @@ u32 XPrc_GetRegisterAddress(XPrc *InstancePtr, u32 VsmId, u8 RegisterType,
 				u16 TableRow);
 void XPrc_PrintVsmStatus(XPrc *InstancePtr, u32 VsmIdOrStatus, char * Prefix);
 
+/* Functions in xprc_rmcache.c */
+s32 XPrc_RmCacheInitialize(XPrc_RmCache *CachePtr, XPrc *PrcPtr,
+				UINTPTR SlotBase, u32 SlotSize, u16 NumSlots,
+				XPrc_RmFetchHandler FetchHandler,
+				void *FetchRef);
+void XPrc_RmCacheSetTimeHandler(XPrc_RmCache *CachePtr,
+				XPrc_RmTimeHandler TimeHandler, void *TimeRef);
+s32 XPrc_RmCacheRequest(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId);
+void XPrc_RmCachePredict(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId);
+void XPrc_RmCacheSetQuiescent(XPrc_RmCache *CachePtr, u16 VsmId,
+				u8 Quiescent);
+void XPrc_RmCacheProcess(XPrc_RmCache *CachePtr);
+u8 XPrc_RmCacheIsIdle(XPrc_RmCache *CachePtr, u16 VsmId);
+void XPrc_RmCachePrintStats(XPrc_RmCache *CachePtr);
+
 /* Functions in xprc_selftest.c */
 s32 XPrc_SelfTest(XPrc *InstancePtr);
 
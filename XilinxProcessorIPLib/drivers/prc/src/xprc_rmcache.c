@@ -0,0 +1,927 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xprc_rmcache.c
+* @addtogroup prc_v1_0
+* @{
+*
+* This file contains the Reconfigurable Module cache of the XPrc driver. It
+* stages RM bitstreams in DDR slots, prefetches predicted RMs and schedules
+* the software triggers of the VSMs. Refer xprc.h for a description.
+*
+* <pre>
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date         Changes
+* ---- ----- -----------  ------------------------------------------------
+* 1.1   esd   10/18/2026    First release.
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xprc.h"
+#include "xil_cache.h"
+#include <string.h>
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Prototypes ******************************/
+
+static u32 XPrc_RmCacheNow(XPrc_RmCache *CachePtr);
+static u16 XPrc_RmCacheFind(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId);
+static u8 XPrc_RmCacheMayShutdown(XPrc_RmCache *CachePtr, u16 VsmId,
+				u16 OwnerVsmId, u8 IsPrefetch);
+static u16 XPrc_RmCacheVictim(XPrc_RmCache *CachePtr, u16 VsmId,
+				u8 IsPrefetch);
+static s32 XPrc_RmCacheOpenWindow(XPrc_RmCache *CachePtr, u16 VsmId);
+static void XPrc_RmCacheCloseWindows(XPrc_RmCache *CachePtr);
+static u16 XPrc_RmCacheStage(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId,
+				u8 IsPrefetch);
+static void XPrc_RmCacheCheckLoad(XPrc_RmCache *CachePtr, u16 VsmId);
+static void XPrc_RmCacheStartLoad(XPrc_RmCache *CachePtr, u16 VsmId);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes an RM cache on a PRC instance.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	PrcPtr is a pointer to an initialized PRC instance.
+* @param	SlotBase is the address of the DDR area holding the slots.
+*		It must be reachable by the PRC fetch path and the whole area
+*		must lie below 4GB.
+* @param	SlotSize is the size of each slot in bytes, the largest RM
+*		bitstream which can be staged.
+* @param	NumSlots is the number of slots, up to XPRC_RMC_MAX_SLOTS.
+* @param	FetchHandler is called to copy an RM bitstream into a slot.
+* @param	FetchRef is passed to FetchHandler.
+*
+* @return
+*		- XST_SUCCESS if the cache was initialized.
+*		- XST_INVALID_PARAM if NumSlots is out of range.
+*
+* @note		The RM loaded in each active VSM is taken from its status
+*		register. The cache assumes that it owns the Bitstream
+*		Information registers of the RMs it stages, and that the VSMs
+*		it manages are triggered by software only: a hardware trigger
+*		for an evicted RM would fetch an empty bitstream. No VSM is
+*		quiescent, see XPrc_RmCacheSetQuiescent().
+*
+******************************************************************************/
+s32 XPrc_RmCacheInitialize(XPrc_RmCache *CachePtr, XPrc *PrcPtr,
+				UINTPTR SlotBase, u32 SlotSize, u16 NumSlots,
+				XPrc_RmFetchHandler FetchHandler,
+				void *FetchRef)
+{
+	u32 Status;
+	u16 Index;
+
+	Xil_AssertNonvoid(CachePtr != NULL);
+	Xil_AssertNonvoid(PrcPtr != NULL);
+	Xil_AssertNonvoid(PrcPtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(SlotSize != 0);
+	Xil_AssertNonvoid(FetchHandler != NULL);
+
+	if ((NumSlots == 0) || (NumSlots > XPRC_RMC_MAX_SLOTS)) {
+		return XST_INVALID_PARAM;
+	}
+
+	/* The Bitstream Address registers only hold 32 bits */
+	Xil_AssertNonvoid(((u64)SlotBase + ((u64)SlotSize * NumSlots)) <=
+						((u64)1 << 32));
+
+	CachePtr->PrcPtr = PrcPtr;
+	CachePtr->SlotBase = SlotBase;
+	CachePtr->SlotSize = SlotSize;
+	CachePtr->NumSlots = NumSlots;
+	CachePtr->Clock = 0;
+	CachePtr->WindowMask = 0;
+	CachePtr->QuiescentMask = 0;
+	CachePtr->FetchHandler = FetchHandler;
+	CachePtr->FetchRef = FetchRef;
+	CachePtr->TimeHandler = NULL;
+	CachePtr->TimeRef = NULL;
+
+	for (Index = 0; Index < XPRC_RMC_MAX_SLOTS; Index++) {
+		CachePtr->Slot[Index].VsmId = XPRC_RMC_NONE;
+		CachePtr->Slot[Index].RmId = XPRC_RMC_NONE;
+		CachePtr->Slot[Index].NextRmId = XPRC_RMC_NONE;
+		CachePtr->Slot[Index].BsSize = 0;
+		CachePtr->Slot[Index].LastUse = 0;
+		CachePtr->Prefetched[Index] = FALSE;
+	}
+
+	for (Index = 0; Index < XPRC_MAX_NUMBER_OF_VSMS; Index++) {
+		CachePtr->Vsm[Index].CurrentRmId = XPRC_RMC_NONE;
+		CachePtr->Vsm[Index].LoadingRmId = XPRC_RMC_NONE;
+		CachePtr->Vsm[Index].RequestRmId = XPRC_RMC_NONE;
+		CachePtr->Vsm[Index].PredictRmId = XPRC_RMC_NONE;
+		CachePtr->Vsm[Index].RequestTime = 0;
+		CachePtr->Vsm[Index].WindowRmId = XPRC_RMC_NONE;
+		CachePtr->Vsm[Index].WindowFull = XPRC_CR_VS_EMPTY;
+
+		if (Index >= XPrc_GetNumberOfVsms(PrcPtr)) {
+			continue;
+		}
+		Status = XPrc_ReadStatusReg(PrcPtr, Index);
+		if ((XPrc_IsVsmInShutdown(NULL, Status) ==
+					XPRC_SR_SHUTDOWN_OFF) &&
+			(XPrc_GetVsmState(NULL, Status) ==
+					XPRC_SR_STATE_FULL)) {
+			CachePtr->Vsm[Index].CurrentRmId =
+				(u16)XPrc_GetRmIdFromStatus(NULL, Status);
+		}
+	}
+
+	memset(&CachePtr->Stats, 0, sizeof(CachePtr->Stats));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function installs the time stamp callback used for the swap latency
+* histogram.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	TimeHandler returns a free running time stamp, NULL disables
+*		the histogram.
+* @param	TimeRef is passed to TimeHandler.
+*
+* @return	None.
+*
+* @note		Latencies are in units of the time stamp, the histogram bins
+*		are powers of two of those units.
+*
+******************************************************************************/
+void XPrc_RmCacheSetTimeHandler(XPrc_RmCache *CachePtr,
+				XPrc_RmTimeHandler TimeHandler, void *TimeRef)
+{
+	Xil_AssertVoid(CachePtr != NULL);
+
+	CachePtr->TimeHandler = TimeHandler;
+	CachePtr->TimeRef = TimeRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function requests an RM to be loaded in a VSM. The request is served
+* by the following calls of XPrc_RmCacheProcess().
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM to load.
+*
+* @return
+*		- XST_SUCCESS if the request was queued.
+*		- XST_INVALID_PARAM if the VSM or RM does not exist.
+*
+* @note		A request which has not been started yet is replaced by a
+*		newer request to the same VSM, only the latest one matters
+*		when multiplexing a socket.
+*
+******************************************************************************/
+s32 XPrc_RmCacheRequest(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId)
+{
+	XPrc_RmVsm *VsmPtr;
+
+	Xil_AssertNonvoid(CachePtr != NULL);
+
+	if ((VsmId >= XPrc_GetNumberOfVsms(CachePtr->PrcPtr)) ||
+		(RmId >= XPrc_GetNumRms(CachePtr->PrcPtr, VsmId))) {
+		return XST_INVALID_PARAM;
+	}
+
+	VsmPtr = &CachePtr->Vsm[VsmId];
+	if (VsmPtr->RequestRmId != XPRC_RMC_NONE) {
+		CachePtr->Stats.Replaced++;
+	}
+	VsmPtr->RequestRmId = RmId;
+	VsmPtr->RequestTime = XPrc_RmCacheNow(CachePtr);
+	CachePtr->Stats.Requests++;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function tells the RM cache which RM a VSM is likely to need next. It
+* is staged by XPrc_RmCacheProcess() while the VSM has nothing else to do.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the predicted RM, XPRC_RMC_NONE to
+*		fall back to the RM that followed the current one last time.
+*
+* @return	None.
+*
+* @note		The prediction is kept until the VSM is quiescent, staging it
+*		shuts the VSM down to write its registers.
+*
+******************************************************************************/
+void XPrc_RmCachePredict(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId)
+{
+	Xil_AssertVoid(CachePtr != NULL);
+	Xil_AssertVoid(VsmId < XPRC_MAX_NUMBER_OF_VSMS);
+
+	CachePtr->Vsm[VsmId].PredictRmId = RmId;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function tells the RM cache whether the RM of a VSM may be shut down
+* at any time. XPrc_RmCacheProcess() only shuts down quiescent VSMs to
+* prefetch for them or to evict their slots for another VSM.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+* @param	Quiescent is TRUE if the VSM may be shut down, FALSE if
+*		only its own requests may shut it down.
+*
+* @return	None.
+*
+* @note		A shutdown decouples the RM, which then stops taking part in
+*		the static design until the VSM is restarted.
+*
+******************************************************************************/
+void XPrc_RmCacheSetQuiescent(XPrc_RmCache *CachePtr, u16 VsmId,
+				u8 Quiescent)
+{
+	Xil_AssertVoid(CachePtr != NULL);
+	Xil_AssertVoid(VsmId < XPRC_MAX_NUMBER_OF_VSMS);
+	Xil_AssertVoid((Quiescent == TRUE) || (Quiescent == FALSE));
+
+	if (Quiescent == TRUE) {
+		CachePtr->QuiescentMask |= ((u32)1 << VsmId);
+	} else {
+		CachePtr->QuiescentMask &= ~((u32)1 << VsmId);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs one step of the RM cache. It should be called
+* periodically or from the PRC status interrupt.
+*	- Loads which have finished are recorded and timed.
+*	- Requested RMs are staged, evicting the least recently used slot
+*	  if needed.
+*	- One predicted RM per idle quiescent VSM is prefetched.
+*	- VSMs whose registers were updated are restarted, each one once.
+*	  A VSM which does not leave shutdown is counted as a time out and
+*	  restarted again by the next call.
+*	- Software triggers are sent for the requests.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+*
+* @return	None.
+*
+* @note		Fetching a bitstream runs the fetch callback synchronously.
+*
+******************************************************************************/
+void XPrc_RmCacheProcess(XPrc_RmCache *CachePtr)
+{
+	XPrc_RmVsm *VsmPtr;
+	u16 NumVsms;
+	u16 VsmId;
+	u16 BaseRmId;
+	u16 PredictRmId;
+	u16 Slot;
+
+	Xil_AssertVoid(CachePtr != NULL);
+
+	NumVsms = XPrc_GetNumberOfVsms(CachePtr->PrcPtr);
+
+	for (VsmId = 0; VsmId < NumVsms; VsmId++) {
+		XPrc_RmCacheCheckLoad(CachePtr, VsmId);
+	}
+
+	/* Stage requested RMs */
+	for (VsmId = 0; VsmId < NumVsms; VsmId++) {
+		VsmPtr = &CachePtr->Vsm[VsmId];
+		if ((VsmPtr->LoadingRmId != XPRC_RMC_NONE) ||
+			(VsmPtr->RequestRmId == XPRC_RMC_NONE)) {
+			continue;
+		}
+		if (VsmPtr->RequestRmId == VsmPtr->CurrentRmId) {
+			VsmPtr->RequestRmId = XPRC_RMC_NONE;
+			continue;
+		}
+		Slot = XPrc_RmCacheStage(CachePtr, VsmId,
+				VsmPtr->RequestRmId, FALSE);
+		if (Slot == XPRC_RMC_NONE) {
+			CachePtr->Stats.Errors++;
+			VsmPtr->RequestRmId = XPRC_RMC_NONE;
+		}
+	}
+
+	/* Prefetch the RM expected after the current or requested one */
+	for (VsmId = 0; VsmId < NumVsms; VsmId++) {
+		VsmPtr = &CachePtr->Vsm[VsmId];
+		if ((VsmPtr->LoadingRmId != XPRC_RMC_NONE) ||
+			(((CachePtr->QuiescentMask >> VsmId) & 1) == 0)) {
+			continue;
+		}
+		BaseRmId = VsmPtr->RequestRmId;
+		if (BaseRmId == XPRC_RMC_NONE) {
+			BaseRmId = VsmPtr->CurrentRmId;
+		}
+		PredictRmId = VsmPtr->PredictRmId;
+		if (PredictRmId == XPRC_RMC_NONE) {
+			Slot = XPrc_RmCacheFind(CachePtr, VsmId, BaseRmId);
+			if (Slot != XPRC_RMC_NONE) {
+				PredictRmId = CachePtr->Slot[Slot].NextRmId;
+			}
+		}
+		if ((PredictRmId == XPRC_RMC_NONE) ||
+			(PredictRmId == BaseRmId) ||
+			(PredictRmId >= XPrc_GetNumRms(CachePtr->PrcPtr,
+							VsmId))) {
+			continue;
+		}
+		VsmPtr->PredictRmId = XPRC_RMC_NONE;
+		if (XPrc_RmCacheFind(CachePtr, VsmId, PredictRmId) ==
+							XPRC_RMC_NONE) {
+			(void)XPrc_RmCacheStage(CachePtr, VsmId, PredictRmId,
+							TRUE);
+		}
+	}
+
+	XPrc_RmCacheCloseWindows(CachePtr);
+
+	for (VsmId = 0; VsmId < NumVsms; VsmId++) {
+		if ((CachePtr->Vsm[VsmId].LoadingRmId == XPRC_RMC_NONE) &&
+			(CachePtr->Vsm[VsmId].RequestRmId != XPRC_RMC_NONE) &&
+			(((CachePtr->WindowMask >> VsmId) & 1) == 0)) {
+			XPrc_RmCacheStartLoad(CachePtr, VsmId);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns whether the RM cache has no work left for a VSM.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+*
+* @return	TRUE if no request is pending or loading, FALSE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+u8 XPrc_RmCacheIsIdle(XPrc_RmCache *CachePtr, u16 VsmId)
+{
+	Xil_AssertNonvoid(CachePtr != NULL);
+	Xil_AssertNonvoid(VsmId < XPRC_MAX_NUMBER_OF_VSMS);
+
+	return ((CachePtr->Vsm[VsmId].LoadingRmId == XPRC_RMC_NONE) &&
+		(CachePtr->Vsm[VsmId].RequestRmId == XPRC_RMC_NONE)) ?
+		TRUE : FALSE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the statistics and the swap latency histogram of the
+* RM cache.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+*
+* @return	None.
+*
+* @note		Empty histogram bins are not printed.
+*
+******************************************************************************/
+void XPrc_RmCachePrintStats(XPrc_RmCache *CachePtr)
+{
+	XPrc_RmStats *StatsPtr;
+	u32 Bin;
+
+	Xil_AssertVoid(CachePtr != NULL);
+
+	StatsPtr = &CachePtr->Stats;
+	xil_printf("RM cache: requests %d replaced %d hits %d misses %d\n\r",
+		StatsPtr->Requests, StatsPtr->Replaced, StatsPtr->Hits,
+		StatsPtr->Misses);
+	xil_printf("RM cache: prefetches %d prefetch hits %d evictions %d\n\r",
+		StatsPtr->Prefetches, StatsPtr->PrefetchHits,
+		StatsPtr->Evictions);
+	xil_printf("RM cache: windows %d swaps %d errors %d timeouts %d\n\r",
+		StatsPtr->Windows, StatsPtr->Swaps, StatsPtr->Errors,
+		StatsPtr->Timeouts);
+	for (Bin = 0; Bin < XPRC_RMC_HIST_BINS; Bin++) {
+		if (StatsPtr->Hist[Bin] != 0) {
+			xil_printf("RM cache: latency < 2^%d : %d\n\r",
+				Bin + 1, StatsPtr->Hist[Bin]);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the current time stamp, 0 without a time callback.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+*
+* @return	Time stamp.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XPrc_RmCacheNow(XPrc_RmCache *CachePtr)
+{
+	u32 Now = 0;
+
+	if (CachePtr->TimeHandler != NULL) {
+		Now = CachePtr->TimeHandler(CachePtr->TimeRef);
+	}
+
+	return Now;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function looks up the slot holding an RM.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM.
+*
+* @return	Slot index or XPRC_RMC_NONE if the RM is not staged.
+*
+* @note		None.
+*
+******************************************************************************/
+static u16 XPrc_RmCacheFind(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId)
+{
+	u16 Index;
+
+	if (RmId == XPRC_RMC_NONE) {
+		return XPRC_RMC_NONE;
+	}
+
+	for (Index = 0; Index < CachePtr->NumSlots; Index++) {
+		if ((CachePtr->Slot[Index].RmId == RmId) &&
+			(CachePtr->Slot[Index].VsmId == VsmId)) {
+			return Index;
+		}
+	}
+
+	return XPRC_RMC_NONE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns whether the cache may shut a VSM down to write its
+* registers on behalf of a VSM.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM to shut down.
+* @param	OwnerVsmId is the identifier of the VSM the RM is staged for.
+* @param	IsPrefetch is TRUE when staging ahead of a request.
+*
+* @return	TRUE if the VSM may be shut down, FALSE otherwise.
+*
+* @note		A VSM with a request is about to be reconfigured, so its own
+*		requests may shut it down. Any other shutdown needs the VSM
+*		to be quiescent, unless the cache holds it shut down already.
+*
+******************************************************************************/
+static u8 XPrc_RmCacheMayShutdown(XPrc_RmCache *CachePtr, u16 VsmId,
+				u16 OwnerVsmId, u8 IsPrefetch)
+{
+	if ((IsPrefetch == FALSE) && (VsmId == OwnerVsmId)) {
+		return TRUE;
+	}
+	if ((((CachePtr->WindowMask | CachePtr->QuiescentMask) >> VsmId) &
+								1) != 0) {
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function picks the slot to stage a new RM in: an empty slot if there
+* is one, otherwise the least recently used slot which is not needed by a
+* load in progress or a pending request, and whose VSM may be shut down.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM the RM is staged for.
+* @param	IsPrefetch is TRUE when staging ahead of a request.
+*
+* @return	Slot index or XPRC_RMC_NONE if all slots are busy.
+*
+* @note		None.
+*
+******************************************************************************/
+static u16 XPrc_RmCacheVictim(XPrc_RmCache *CachePtr, u16 VsmId,
+				u8 IsPrefetch)
+{
+	XPrc_RmSlot *SlotPtr;
+	XPrc_RmVsm *VsmPtr;
+	u16 Victim = XPRC_RMC_NONE;
+	u16 Index;
+
+	for (Index = 0; Index < CachePtr->NumSlots; Index++) {
+		SlotPtr = &CachePtr->Slot[Index];
+		if (SlotPtr->RmId == XPRC_RMC_NONE) {
+			return Index;
+		}
+
+		/* A loading VSM can not be shut down to clear its registers */
+		VsmPtr = &CachePtr->Vsm[SlotPtr->VsmId];
+		if ((VsmPtr->LoadingRmId != XPRC_RMC_NONE) ||
+			(VsmPtr->RequestRmId == SlotPtr->RmId)) {
+			continue;
+		}
+		if (XPrc_RmCacheMayShutdown(CachePtr, SlotPtr->VsmId, VsmId,
+						IsPrefetch) == FALSE) {
+			continue;
+		}
+		if ((Victim == XPRC_RMC_NONE) ||
+			((s32)(SlotPtr->LastUse -
+				CachePtr->Slot[Victim].LastUse) < 0)) {
+			Victim = Index;
+		}
+	}
+
+	return Victim;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function shuts a VSM down so its registers can be written, unless it
+* already is. VSMs shut down here are restarted by
+* XPrc_RmCacheCloseWindows() in the state they had before the shutdown.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+*
+* @return
+*		- XST_SUCCESS if the VSM is in the shutdown state.
+*		- XST_FAILURE if it did not enter the shutdown state.
+*
+* @note		A VSM which does not enter the shutdown state in time is
+*		counted in Timeouts. It is still restarted by
+*		XPrc_RmCacheCloseWindows() if it has got there by then.
+*
+******************************************************************************/
+static s32 XPrc_RmCacheOpenWindow(XPrc_RmCache *CachePtr, u16 VsmId)
+{
+	XPrc *PrcPtr = CachePtr->PrcPtr;
+	XPrc_RmVsm *VsmPtr = &CachePtr->Vsm[VsmId];
+	u32 PollCount;
+	u32 Status;
+
+	if (((CachePtr->WindowMask >> VsmId) & 1) != 0) {
+		return (XPrc_IsVsmInShutdown(PrcPtr, VsmId) ==
+			XPRC_SR_SHUTDOWN_ON) ? XST_SUCCESS : XST_FAILURE;
+	}
+	Status = XPrc_ReadStatusReg(PrcPtr, VsmId);
+	if (XPrc_IsVsmInShutdown(NULL, Status) == XPRC_SR_SHUTDOWN_ON) {
+		return XST_SUCCESS;
+	}
+
+	/* Remembered for the restart, the VSM keeps this RM */
+	if (XPrc_GetVsmState(NULL, Status) == XPRC_SR_STATE_FULL) {
+		VsmPtr->WindowFull = XPRC_CR_VS_FULL;
+		VsmPtr->WindowRmId = (u16)XPrc_GetRmIdFromStatus(NULL, Status);
+	} else {
+		VsmPtr->WindowFull = XPRC_CR_VS_EMPTY;
+		VsmPtr->WindowRmId = 0;
+	}
+
+	XPrc_SendShutdownCommand(PrcPtr, VsmId);
+	CachePtr->WindowMask |= ((u32)1 << VsmId);
+	CachePtr->Stats.Windows++;
+	for (PollCount = 0; PollCount < XPRC_RMC_POLL_COUNT; PollCount++) {
+		if (XPrc_IsVsmInShutdown(PrcPtr, VsmId) ==
+						XPRC_SR_SHUTDOWN_ON) {
+			return XST_SUCCESS;
+		}
+	}
+
+	CachePtr->Stats.Timeouts++;
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function restarts the VSMs shut down by XPrc_RmCacheOpenWindow().
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+*
+* @return	None.
+*
+* @note		The Bitstream Information registers were modified during the
+*		shutdown, so the VSMs are restarted with status: full with
+*		the RM they held before the shutdown, or empty. A VSM which
+*		does not leave the shutdown state in time is counted in
+*		Timeouts and left in WindowMask to be restarted again.
+*
+******************************************************************************/
+static void XPrc_RmCacheCloseWindows(XPrc_RmCache *CachePtr)
+{
+	XPrc *PrcPtr = CachePtr->PrcPtr;
+	XPrc_RmVsm *VsmPtr;
+	u32 PollCount;
+	u16 VsmId;
+
+	for (VsmId = 0; VsmId < XPRC_MAX_NUMBER_OF_VSMS; VsmId++) {
+		if (((CachePtr->WindowMask >> VsmId) & 1) == 0) {
+			continue;
+		}
+
+		/* Shutdown request which was never completed */
+		if (XPrc_IsVsmInShutdown(PrcPtr, VsmId) ==
+						XPRC_SR_SHUTDOWN_OFF) {
+			CachePtr->WindowMask &= ~((u32)1 << VsmId);
+			continue;
+		}
+
+		VsmPtr = &CachePtr->Vsm[VsmId];
+		XPrc_SendRestartWithStatusCommand(PrcPtr, VsmId,
+				VsmPtr->WindowFull, VsmPtr->WindowRmId);
+		for (PollCount = 0; PollCount < XPRC_RMC_POLL_COUNT;
+							PollCount++) {
+			if (XPrc_IsVsmInShutdown(PrcPtr, VsmId) ==
+						XPRC_SR_SHUTDOWN_OFF) {
+				break;
+			}
+		}
+		if (PollCount == XPRC_RMC_POLL_COUNT) {
+			CachePtr->Stats.Timeouts++;
+			continue;
+		}
+		CachePtr->WindowMask &= ~((u32)1 << VsmId);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function makes sure an RM is staged in a slot and its Bitstream
+* Information registers point at that slot.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+* @param	RmId is the identifier of the RM.
+* @param	IsPrefetch is TRUE when staging ahead of a request.
+*
+* @return	Slot index or XPRC_RMC_NONE if the RM could not be staged.
+*
+* @note		The evicted RM's bitstream size is set to 0.
+*
+******************************************************************************/
+static u16 XPrc_RmCacheStage(XPrc_RmCache *CachePtr, u16 VsmId, u16 RmId,
+				u8 IsPrefetch)
+{
+	XPrc *PrcPtr = CachePtr->PrcPtr;
+	XPrc_RmSlot *SlotPtr;
+	UINTPTR SlotAddr;
+	u32 BsIndex;
+	u32 BsSize;
+	u16 Slot;
+	s32 Status;
+
+	Slot = XPrc_RmCacheFind(CachePtr, VsmId, RmId);
+	if (Slot != XPRC_RMC_NONE) {
+		CachePtr->Slot[Slot].LastUse = ++CachePtr->Clock;
+		if (IsPrefetch == FALSE) {
+			CachePtr->Stats.Hits++;
+			if (CachePtr->Prefetched[Slot] == TRUE) {
+				CachePtr->Stats.PrefetchHits++;
+				CachePtr->Prefetched[Slot] = FALSE;
+			}
+		}
+		return Slot;
+	}
+
+	if (IsPrefetch == FALSE) {
+		CachePtr->Stats.Misses++;
+	}
+
+	Slot = XPrc_RmCacheVictim(CachePtr, VsmId, IsPrefetch);
+	if (Slot == XPRC_RMC_NONE) {
+		return XPRC_RMC_NONE;
+	}
+	SlotPtr = &CachePtr->Slot[Slot];
+	SlotAddr = CachePtr->SlotBase + ((UINTPTR)Slot * CachePtr->SlotSize);
+
+	/* Unhook the evicted RM before its bitstream is overwritten */
+	if (SlotPtr->RmId != XPRC_RMC_NONE) {
+		if (XPrc_RmCacheOpenWindow(CachePtr, SlotPtr->VsmId) !=
+							XST_SUCCESS) {
+			return XPRC_RMC_NONE;
+		}
+		BsIndex = XPrc_GetRmBsIndex(PrcPtr, SlotPtr->VsmId,
+						SlotPtr->RmId);
+		XPrc_SetBsSize(PrcPtr, SlotPtr->VsmId, BsIndex, 0);
+		SlotPtr->RmId = XPRC_RMC_NONE;
+		SlotPtr->VsmId = XPRC_RMC_NONE;
+		CachePtr->Prefetched[Slot] = FALSE;
+		CachePtr->Stats.Evictions++;
+	}
+
+	BsSize = 0;
+	Status = CachePtr->FetchHandler(CachePtr->FetchRef, VsmId, RmId,
+				SlotAddr, CachePtr->SlotSize, &BsSize);
+	if ((Status != XST_SUCCESS) || (BsSize == 0) ||
+				(BsSize > CachePtr->SlotSize)) {
+		return XPRC_RMC_NONE;
+	}
+
+	/* The PRC fetch path does not snoop the data cache */
+	Xil_DCacheFlushRange(SlotAddr, BsSize);
+
+	if (XPrc_RmCacheOpenWindow(CachePtr, VsmId) != XST_SUCCESS) {
+		return XPRC_RMC_NONE;
+	}
+	BsIndex = XPrc_GetRmBsIndex(PrcPtr, VsmId, RmId);
+	XPrc_SetBsAddress(PrcPtr, VsmId, BsIndex, (u32)SlotAddr);
+	XPrc_SetBsSize(PrcPtr, VsmId, BsIndex, BsSize);
+
+	SlotPtr->VsmId = VsmId;
+	SlotPtr->RmId = RmId;
+	SlotPtr->NextRmId = XPRC_RMC_NONE;
+	SlotPtr->BsSize = BsSize;
+	SlotPtr->LastUse = ++CachePtr->Clock;
+	CachePtr->Prefetched[Slot] = IsPrefetch;
+	if (IsPrefetch == TRUE) {
+		CachePtr->Stats.Prefetches++;
+	}
+
+	return Slot;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks whether the load in progress on a VSM has finished
+* and records its latency.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XPrc_RmCacheCheckLoad(XPrc_RmCache *CachePtr, u16 VsmId)
+{
+	XPrc *PrcPtr = CachePtr->PrcPtr;
+	XPrc_RmVsm *VsmPtr = &CachePtr->Vsm[VsmId];
+	u32 Status;
+	u32 State;
+	u32 Latency;
+	u32 Bin;
+	u16 Trigger;
+
+	if (VsmPtr->LoadingRmId == XPRC_RMC_NONE) {
+		return;
+	}
+
+	Status = XPrc_ReadStatusReg(PrcPtr, VsmId);
+	if (XPrc_IsVsmInShutdown(NULL, Status) == XPRC_SR_SHUTDOWN_ON) {
+		return;
+	}
+	State = XPrc_GetVsmState(NULL, Status);
+
+	if ((State == XPRC_SR_STATE_FULL) &&
+		(XPrc_GetRmIdFromStatus(NULL, Status) == VsmPtr->LoadingRmId)) {
+		VsmPtr->CurrentRmId = VsmPtr->LoadingRmId;
+		VsmPtr->LoadingRmId = XPRC_RMC_NONE;
+		CachePtr->Stats.Swaps++;
+
+		if (CachePtr->TimeHandler != NULL) {
+			Latency = XPrc_RmCacheNow(CachePtr) -
+						VsmPtr->RequestTime;
+			Bin = 0;
+			while ((Latency >> 1) != 0) {
+				Latency >>= 1;
+				Bin++;
+			}
+			CachePtr->Stats.Hist[Bin]++;
+		}
+		return;
+	}
+
+	/* An error status only counts once the trigger has been taken */
+	if ((XPrc_GetVsmErrorStatus(NULL, Status) != XPRC_SR_NO_ERROR) &&
+		((State == XPRC_SR_STATE_EMPTY) ||
+			(State == XPRC_SR_STATE_FULL)) &&
+		(XPrc_IsSwTriggerPending(PrcPtr, VsmId, &Trigger) ==
+					XPRC_NO_SW_TRIGGER_PENDING)) {
+		CachePtr->Stats.Errors++;
+		VsmPtr->CurrentRmId = (State == XPRC_SR_STATE_FULL) ?
+			(u16)XPrc_GetRmIdFromStatus(NULL, Status) :
+			XPRC_RMC_NONE;
+		VsmPtr->LoadingRmId = XPRC_RMC_NONE;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends the software trigger which loads the requested RM of
+* a VSM.
+*
+* @param	CachePtr is a pointer to the RM cache instance.
+* @param	VsmId is the identifier of the VSM.
+*
+* @return	None.
+*
+* @note		The trigger is the first one mapped to the RM. The RM which
+*		was current is remembered as followed by the requested RM,
+*		for prefetching next time.
+*
+******************************************************************************/
+static void XPrc_RmCacheStartLoad(XPrc_RmCache *CachePtr, u16 VsmId)
+{
+	XPrc *PrcPtr = CachePtr->PrcPtr;
+	XPrc_RmVsm *VsmPtr = &CachePtr->Vsm[VsmId];
+	u16 NumTriggers;
+	u16 Trigger;
+	u16 Slot;
+
+	NumTriggers = XPrc_GetNumTriggersAllocated(PrcPtr, VsmId);
+	for (Trigger = 0; Trigger < NumTriggers; Trigger++) {
+		if (XPrc_GetTriggerToRmMapping(PrcPtr, VsmId, Trigger) ==
+						VsmPtr->RequestRmId) {
+			break;
+		}
+	}
+	if (Trigger == NumTriggers) {
+		CachePtr->Stats.Errors++;
+		VsmPtr->RequestRmId = XPRC_RMC_NONE;
+		return;
+	}
+
+	Slot = XPrc_RmCacheFind(CachePtr, VsmId, VsmPtr->CurrentRmId);
+	if (Slot != XPRC_RMC_NONE) {
+		CachePtr->Slot[Slot].NextRmId = VsmPtr->RequestRmId;
+	}
+
+	VsmPtr->LoadingRmId = VsmPtr->RequestRmId;
+	VsmPtr->RequestRmId = XPRC_RMC_NONE;
+	XPrc_SendSwTrigger(PrcPtr, VsmId, Trigger);
+}
+/** @} */
@@ -0,0 +1,506 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspipsu_queue_read_example.c
+*
+*
+* This file contains a design example using the request queue of the QSPIPSU
+* driver (XQspiPsu). The flash ID is read with one request, then a number of
+* flash reads are queued back to back with XQspiPsu_EnqueueRequest() and run
+* from the interrupt handler without the CPU starting each of them. The
+* completion handler of each request counts it as done. When all requests
+* have completed, the queue counters returned by XQspiPsu_GetStats() are
+* printed.
+*
+* The example only reads the flash, so any serial flash that supports the
+* READ ID (0x9F) and READ (0x03) commands can be used. It runs on the lower
+* flash of a single connection; the reads use 3-byte addresses and stay in
+* the first 16MB.
+*
+* @note
+*
+* None.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 1.4   esd 10/18/26 First release
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"	/* SDK generated parameters */
+#include "xqspipsu.h"		/* QSPIPSU device driver */
+#include "xscugic.h"		/* Interrupt controller device driver */
+#include "xil_exception.h"
+#include "xil_printf.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+#define QSPIPSU_DEVICE_ID	XPAR_XQSPIPSU_0_DEVICE_ID
+#define INTC_DEVICE_ID		XPAR_SCUGIC_SINGLE_DEVICE_ID
+#define QSPIPSU_INTR_ID		XPAR_XQSPIPS_0_INTR
+
+/*
+ * Flash commands used by the example
+ */
+#define READ_CMD		0x03
+#define READ_ID			0x9F
+
+/*
+ * Number of reads queued at once, the size of each read and the flash
+ * address of the first one. Each request reads the chunk that follows the
+ * previous one.
+ */
+#define NUM_REQUESTS		8
+#define CHUNK_SIZE		4096
+#define START_ADDRESS		0x000000
+
+/* The DMA writes the read buffers, keep them on cache lines of their own */
+#define BUFFER_ALIGN		64
+
+/**************************** Type Definitions *******************************/
+
+/*
+ * Command bytes, messages and request of one queued read. The request and
+ * its messages belong to the driver until the completion handler is called.
+ */
+typedef struct {
+	u8 Cmd[4];			/* Command and 3-byte address */
+	XQspiPsu_Msg Msg[2];		/* Command, then data */
+	XQspiPsu_Request Req;
+} FlashRead;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int QspiPsuQueueReadExample(XScuGic *IntcInstancePtr,
+			XQspiPsu *QspiPsuInstancePtr, u16 QspiPsuDeviceId,
+			u16 QspiPsuIntrId);
+static int QueueReadID(XQspiPsu *QspiPsuPtr);
+static int QueueReads(XQspiPsu *QspiPsuPtr);
+static void RequestDone(void *CallBackRef, XQspiPsu_Request *Req,
+			s32 Status);
+static int QspiPsuSetupIntrSystem(XScuGic *IntcInstancePtr,
+			XQspiPsu *QspiPsuInstancePtr, u16 QspiPsuIntrId);
+static void QspiPsuDisableIntrSystem(XScuGic *IntcInstancePtr,
+			u16 QspiPsuIntrId);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic IntcInstance;
+static XQspiPsu QspiPsuInstance;
+
+static FlashRead Reads[NUM_REQUESTS];
+static u8 ReadBuffer[NUM_REQUESTS][CHUNK_SIZE]
+			__attribute__ ((aligned(BUFFER_ALIGN)));
+static u8 IdBuffer[BUFFER_ALIGN] __attribute__ ((aligned(BUFFER_ALIGN)));
+
+/*
+ * Updated by the completion handler, from interrupt context
+ */
+static volatile u32 RequestsDone;
+static volatile s32 RequestStatus;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the QSPIPSU request queue example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	xil_printf("QSPIPSU Queue Read Example Test \r\n");
+
+	Status = QspiPsuQueueReadExample(&IntcInstance, &QspiPsuInstance,
+					QSPIPSU_DEVICE_ID, QSPIPSU_INTR_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("QSPIPSU Queue Read Example Test Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran QSPIPSU Queue Read Example Test\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* The purpose of this function is to illustrate how to use the request queue
+* of the XQspiPsu driver.
+*
+* @param	IntcInstancePtr is a pointer to the interrupt controller
+*		instance.
+* @param	QspiPsuInstancePtr is a pointer to the QSPIPSU driver instance.
+* @param	QspiPsuDeviceId is the Device ID of the QSPIPSU device.
+* @param	QspiPsuIntrId is the interrupt Id of the QSPIPSU device.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+******************************************************************************/
+int QspiPsuQueueReadExample(XScuGic *IntcInstancePtr,
+			XQspiPsu *QspiPsuInstancePtr, u16 QspiPsuDeviceId,
+			u16 QspiPsuIntrId)
+{
+	int Status;
+	XQspiPsu_Config *QspiPsuConfig;
+	XQspiPsu_Stats Stats;
+
+	/*
+	 * Initialize the QSPIPSU driver so that it's ready to use
+	 */
+	QspiPsuConfig = XQspiPsu_LookupConfig(QspiPsuDeviceId);
+	if (NULL == QspiPsuConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XQspiPsu_CfgInitialize(QspiPsuInstancePtr, QspiPsuConfig,
+					QspiPsuConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Connect the QspiPsu device to the interrupt subsystem such that
+	 * interrupts can occur. This function is application specific
+	 */
+	Status = QspiPsuSetupIntrSystem(IntcInstancePtr, QspiPsuInstancePtr,
+					QspiPsuIntrId);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Set Manual Start and the prescaler for QSPIPSU clock
+	 */
+	XQspiPsu_SetOptions(QspiPsuInstancePtr, XQSPIPSU_MANUAL_START_OPTION);
+	XQspiPsu_SetClkPrescaler(QspiPsuInstancePtr, XQSPIPSU_CLK_PRESCALE_8);
+
+	/*
+	 * Requests run on the flash selected when they are queued
+	 */
+	XQspiPsu_SelectFlash(QspiPsuInstancePtr,
+		XQSPIPSU_SELECT_FLASH_CS_LOWER, XQSPIPSU_SELECT_FLASH_BUS_LOWER);
+
+	Status = QueueReadID(QspiPsuInstancePtr);
+	if (Status != XST_SUCCESS) {
+		goto done;
+	}
+
+	/* Only count the reads in the statistics */
+	XQspiPsu_ResetStats(QspiPsuInstancePtr);
+
+	Status = QueueReads(QspiPsuInstancePtr);
+	if (Status != XST_SUCCESS) {
+		goto done;
+	}
+
+	XQspiPsu_GetStats(QspiPsuInstancePtr, &Stats);
+	xil_printf("Requests %d, chained %d, errors %d, bytes read %d\r\n",
+		Stats.Requests, Stats.Chained, Stats.Errors,
+		(u32)Stats.RxBytes);
+
+	if ((Stats.Requests != NUM_REQUESTS) || (Stats.Errors != 0U)) {
+		Status = XST_FAILURE;
+	}
+
+done:
+	QspiPsuDisableIntrSystem(IntcInstancePtr, QspiPsuIntrId);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads the flash ID with a single queued request and waits for it.
+*
+* @param	QspiPsuPtr is a pointer to the QSPIPSU driver instance.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+******************************************************************************/
+static int QueueReadID(XQspiPsu *QspiPsuPtr)
+{
+	int Status;
+	FlashRead *ReadPtr = &Reads[0];
+
+	ReadPtr->Cmd[0] = READ_ID;
+
+	ReadPtr->Msg[0].TxBfrPtr = ReadPtr->Cmd;
+	ReadPtr->Msg[0].RxBfrPtr = NULL;
+	ReadPtr->Msg[0].ByteCount = 1;
+	ReadPtr->Msg[0].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+	ReadPtr->Msg[0].Flags = XQSPIPSU_MSG_FLAG_TX;
+
+	ReadPtr->Msg[1].TxBfrPtr = NULL;
+	ReadPtr->Msg[1].RxBfrPtr = IdBuffer;
+	ReadPtr->Msg[1].ByteCount = 3;
+	ReadPtr->Msg[1].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+	ReadPtr->Msg[1].Flags = XQSPIPSU_MSG_FLAG_RX;
+
+	RequestsDone = 0U;
+	RequestStatus = XST_SUCCESS;
+
+	XQspiPsu_InitRequest(&ReadPtr->Req, ReadPtr->Msg, 2, RequestDone,
+				NULL);
+	Status = XQspiPsu_EnqueueRequest(QspiPsuPtr, &ReadPtr->Req);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	while (RequestsDone == 0U);
+
+	if (RequestStatus != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("FlashID=0x%x 0x%x 0x%x\r\n", IdBuffer[0], IdBuffer[1],
+		IdBuffer[2]);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues NUM_REQUESTS reads of CHUNK_SIZE bytes at once and waits until all
+* of them have completed. The driver starts each read from the interrupt
+* handler as soon as the previous one is done.
+*
+* @param	QspiPsuPtr is a pointer to the QSPIPSU driver instance.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		If a request cannot be queued, the ones already queued are
+*		dropped with XQspiPsu_Abort() and completed with XST_FAILURE.
+*
+******************************************************************************/
+static int QueueReads(XQspiPsu *QspiPsuPtr)
+{
+	int Status;
+	u32 Index;
+	u32 Address;
+	FlashRead *ReadPtr;
+
+	RequestsDone = 0U;
+	RequestStatus = XST_SUCCESS;
+
+	for (Index = 0U; Index < NUM_REQUESTS; Index++) {
+		ReadPtr = &Reads[Index];
+		Address = START_ADDRESS + (Index * CHUNK_SIZE);
+
+		ReadPtr->Cmd[0] = READ_CMD;
+		ReadPtr->Cmd[1] = (u8)((Address & 0xFF0000) >> 16);
+		ReadPtr->Cmd[2] = (u8)((Address & 0xFF00) >> 8);
+		ReadPtr->Cmd[3] = (u8)(Address & 0xFF);
+
+		ReadPtr->Msg[0].TxBfrPtr = ReadPtr->Cmd;
+		ReadPtr->Msg[0].RxBfrPtr = NULL;
+		ReadPtr->Msg[0].ByteCount = 4;
+		ReadPtr->Msg[0].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+		ReadPtr->Msg[0].Flags = XQSPIPSU_MSG_FLAG_TX;
+
+		ReadPtr->Msg[1].TxBfrPtr = NULL;
+		ReadPtr->Msg[1].RxBfrPtr = ReadBuffer[Index];
+		ReadPtr->Msg[1].ByteCount = CHUNK_SIZE;
+		ReadPtr->Msg[1].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+		ReadPtr->Msg[1].Flags = XQSPIPSU_MSG_FLAG_RX;
+
+		XQspiPsu_InitRequest(&ReadPtr->Req, ReadPtr->Msg, 2,
+					RequestDone, NULL);
+		Status = XQspiPsu_EnqueueRequest(QspiPsuPtr, &ReadPtr->Req);
+		if (Status != XST_SUCCESS) {
+			XQspiPsu_Abort(QspiPsuPtr);
+			return XST_FAILURE;
+		}
+	}
+
+	/* The CPU is free to do other work while the queue runs */
+	while (RequestsDone < NUM_REQUESTS);
+
+	if (RequestStatus != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Completion handler of the queued requests. It is called from the QSPIPSU
+* interrupt handler once the request is done or dropped.
+*
+* @param	CallBackRef is the reference given to XQspiPsu_InitRequest().
+* @param	Req is a pointer to the completed request.
+* @param	Status is XST_SUCCESS, or the error the request ended with.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void RequestDone(void *CallBackRef, XQspiPsu_Request *Req,
+			s32 Status)
+{
+	(void)CallBackRef;
+	(void)Req;
+
+	if (Status != XST_SUCCESS) {
+		RequestStatus = Status;
+	}
+	RequestsDone++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function setups the interrupt system for a QspiPsu device.
+*
+* @param	IntcInstancePtr is a pointer to the instance of the Intc device.
+* @param	QspiPsuInstancePtr is a pointer to the instance of the
+*		QspiPsu device.
+* @param	QspiPsuIntrId is the interrupt Id for an QSPIPSU device.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+******************************************************************************/
+static int QspiPsuSetupIntrSystem(XScuGic *IntcInstancePtr,
+			XQspiPsu *QspiPsuInstancePtr, u16 QspiPsuIntrId)
+{
+	int Status;
+	XScuGic_Config *IntcConfig; /* Instance of the interrupt controller */
+
+	Xil_ExceptionInit();
+
+	/*
+	 * Initialize the interrupt controller driver so that it is ready to
+	 * use.
+	 */
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (NULL == IntcConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XScuGic_CfgInitialize(IntcInstancePtr, IntcConfig,
+					IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Connect the interrupt controller interrupt handler to the hardware
+	 * interrupt handling logic in the processor.
+	 */
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+				(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+				IntcInstancePtr);
+
+	/*
+	 * Connect the device driver handler that will be called when an
+	 * interrupt for the device occurs, the driver runs the request queue
+	 * from it.
+	 */
+	Status = XScuGic_Connect(IntcInstancePtr, QspiPsuIntrId,
+				(Xil_ExceptionHandler)XQspiPsu_InterruptHandler,
+				(void *)QspiPsuInstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	/*
+	 * Enable the interrupt for the QspiPsu device.
+	 */
+	XScuGic_Enable(IntcInstancePtr, QspiPsuIntrId);
+
+	/*
+	 * Enable interrupts in the Processor.
+	 */
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function disables the interrupts that occur for the QspiPsu device.
+*
+* @param	IntcInstancePtr is a pointer to the instance of the Intc device.
+* @param	QspiPsuIntrId is the interrupt Id for an QSPIPSU device.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void QspiPsuDisableIntrSystem(XScuGic *IntcInstancePtr,
+			u16 QspiPsuIntrId)
+{
+	/*
+	 * Disable the interrupt for the QSPIPSU device.
+	 */
+	XScuGic_Disable(IntcInstancePtr, QspiPsuIntrId);
+
+	/*
+	 * Disconnect and disable the interrupt for the QspiPsu device.
+	 */
+	XScuGic_Disconnect(IntcInstancePtr, QspiPsuIntrId);
+}
@@ -60,6 +60,9 @@
 * 1.3	nsk 09/16/16 Update PollData and PollTimeout support for dual
 *	             parallel configurations, modified XQspiPsu_PollData()
 *	             and XQspiPsu_Create_PollConfigData()
+* 1.4   esd 10/18/26 Added the request queue. The interrupt handler starts
+*                    the next queued request in the same pass that writes
+*                    the CS de-assert of the current one.
 *
 * </pre>
 *
@@ -93,6 +96,11 @@ static inline void XQspiPsu_ReadRxFifo(XQspiPsu *InstancePtr,
 			XQspiPsu_Msg *Msg, s32 Size);
 static inline void XQspiPsu_PollData(XQspiPsu *QspiPsuPtr,
 		XQspiPsu_Msg *FlashMsg);
+static void XQspiPsu_EnableIntr(XQspiPsu *InstancePtr);
+static void XQspiPsu_StartRequest(XQspiPsu *InstancePtr,
+			XQspiPsu_Request *Req);
+static void XQspiPsu_CompleteRequest(XQspiPsu *InstancePtr,
+			XQspiPsu_Request *Req);
 static inline u32 XQspiPsu_Create_PollConfigData(XQspiPsu *QspiPsuPtr,
 		XQspiPsu_Msg *FlashMsg);
 
@@ -162,6 +170,9 @@ s32 XQspiPsu_CfgInitialize(XQspiPsu *InstancePtr, XQspiPsu_Config *ConfigPtr,
 		InstancePtr->GenFifoBus = XQSPIPSU_GENFIFO_BUS_LOWER;
 		InstancePtr->IsUnaligned = 0;
 		InstancePtr->IsManualstart = TRUE;
+		InstancePtr->ReqHead = NULL;
+		InstancePtr->ReqTail = NULL;
+		XQspiPsu_ResetStats(InstancePtr);
 
 		/* Select QSPIPSU */
 		XQspiPsu_Select(InstancePtr, XQSPIPSU_SEL_GQSPI_MASK);
@@ -260,6 +271,10 @@ void XQspiPsu_Reset(XQspiPsu *InstancePtr)
 *
 * Aborts a transfer in progress by
 *
+* Queued requests are dropped; their completion handlers are called with
+* XST_FAILURE after the queue has been emptied. A request queued from one of
+* these handlers starts a new queue.
+*
 * @param	InstancePtr is a pointer to the XQspiPsu instance.
 *
 * @return	None.
@@ -271,6 +286,8 @@ void XQspiPsu_Abort(XQspiPsu *InstancePtr)
 {
 
 	u32 IntrStatus, ConfigReg;
+	XQspiPsu_Request *Req;
+	XQspiPsu_Request *Dropped;
 
 	IntrStatus = XQspiPsu_ReadReg(InstancePtr->Config.BaseAddress,
 					XQSPIPSU_ISR_OFFSET);
@@ -332,6 +349,22 @@ void XQspiPsu_Abort(XQspiPsu *InstancePtr)
 	InstancePtr->RxBytes = 0;
 	InstancePtr->GenFifoEntries = 0;
 	InstancePtr->IsBusy = FALSE;
+
+	/*
+	 * Detach the whole queue before handing the requests back, so a
+	 * request queued again from a completion handler starts a new queue
+	 * instead of being dropped along with this one
+	 */
+	Dropped = InstancePtr->ReqHead;
+	InstancePtr->ReqHead = NULL;
+	InstancePtr->ReqTail = NULL;
+
+	while (Dropped != NULL) {
+		Req = Dropped;
+		Dropped = Req->Next;
+		Req->Status = (s32)XST_FAILURE;
+		XQspiPsu_CompleteRequest(InstancePtr, Req);
+	}
 }
 
 /*****************************************************************************/
@@ -638,6 +671,7 @@ s32 XQspiPsu_InterruptHandler(XQspiPsu *InstancePtr)
 	u8 DeltaMsgCnt = 0;
 	s32 RxThr;
 	u32 TxRxFlag;
+	XQspiPsu_Request *Req;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
 
@@ -658,9 +692,14 @@ s32 XQspiPsu_InterruptHandler(XQspiPsu *InstancePtr)
 			XQSPIPSU_QSPIDMA_DST_I_STS_OFFSET, DmaIntrStatusReg);
 	}
 	if (((DmaIntrStatusReg & XQSPIPSU_QSPIDMA_DST_INTR_ERR_MASK) != FALSE)) {
-		/* Call status handler to indicate error */
-		InstancePtr->StatusHandler(InstancePtr->StatusRef,
+		if (InstancePtr->ReqHead != NULL) {
+			/* Reported when the request completes */
+			InstancePtr->ReqHead->Status = (s32)XST_SPI_COMMAND_ERROR;
+		} else {
+			/* Call status handler to indicate error */
+			InstancePtr->StatusHandler(InstancePtr->StatusRef,
 					XST_SPI_COMMAND_ERROR, 0);
+		}
 	}
 
 	/* Fill more data to be txed if required */
@@ -795,7 +834,20 @@ s32 XQspiPsu_InterruptHandler(XQspiPsu *InstancePtr)
 			/* De-select slave */
 			XQspiPsu_GenFifoEntryCSDeAssert(InstancePtr);
 
-			if (InstancePtr->IsManualstart == TRUE) {
+			if ((InstancePtr->ReqHead != NULL) &&
+				(InstancePtr->ReqHead->Next != NULL)) {
+				/*
+				 * All messages are done. Queue the next request
+				 * right behind the CS de-assert, then complete
+				 * this one.
+				 */
+				Req = InstancePtr->ReqHead;
+				InstancePtr->ReqHead = Req->Next;
+				XQspiPsu_StartRequest(InstancePtr,
+						InstancePtr->ReqHead);
+				InstancePtr->Stats.Chained += 1U;
+				XQspiPsu_CompleteRequest(InstancePtr, Req);
+			} else if (InstancePtr->IsManualstart == TRUE) {
 #ifdef DEBUG
 	xil_printf("\nManual Start\r\n");
 #endif
@@ -825,9 +877,23 @@ s32 XQspiPsu_InterruptHandler(XQspiPsu *InstancePtr)
 			/* Disable the device. */
 			XQspiPsu_Disable(InstancePtr);
 
-			/* Call status handler to indicate completion */
-			InstancePtr->StatusHandler(InstancePtr->StatusRef,
+			if (InstancePtr->ReqHead != NULL) {
+				Req = InstancePtr->ReqHead;
+				InstancePtr->ReqHead = Req->Next;
+				if (InstancePtr->ReqHead == NULL) {
+					InstancePtr->ReqTail = NULL;
+				} else {
+					/* Queued after the CS de-assert pass */
+					InstancePtr->IsBusy = TRUE;
+					XQspiPsu_StartRequest(InstancePtr,
+							InstancePtr->ReqHead);
+				}
+				XQspiPsu_CompleteRequest(InstancePtr, Req);
+			} else {
+				/* Call status handler to indicate completion */
+				InstancePtr->StatusHandler(InstancePtr->StatusRef,
 						XST_SPI_TRANSFER_DONE, 0);
+			}
 		}
 	}
 	if ((TxRxFlag & XQSPIPSU_MSG_FLAG_POLL) != FALSE){
@@ -909,6 +975,168 @@ void XQspiPsu_SetStatusHandler(XQspiPsu *InstancePtr, void *CallBackRef,
 	InstancePtr->StatusRef = CallBackRef;
 }
 
+/*****************************************************************************/
+/**
+*
+* Initializes a request for XQspiPsu_EnqueueRequest().
+*
+* @param	Req is a pointer to the request.
+* @param	Msg is a pointer to the messages, transferred between one CS
+*		assert and de-assert.
+* @param	NumMsg is the number of messages.
+* @param	Handler is the completion handler, or NULL.
+* @param	CallBackRef is passed back to the completion handler.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XQspiPsu_InitRequest(XQspiPsu_Request *Req, XQspiPsu_Msg *Msg,
+				u32 NumMsg, XQspiPsu_RequestHandler Handler,
+				void *CallBackRef)
+{
+	Xil_AssertVoid(Req != NULL);
+
+	Req->Msg = Msg;
+	Req->NumMsg = NumMsg;
+	Req->Handler = Handler;
+	Req->CallBackRef = CallBackRef;
+	Req->Status = (s32)XST_SUCCESS;
+	Req->TxBytes = 0U;
+	Req->RxBytes = 0U;
+	Req->Next = NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues a request behind the ones already submitted and returns without
+* waiting. If the controller is idle the request is started at once. The
+* request runs in interrupt mode on the flash selected by
+* XQspiPsu_SelectFlash() at the time it is queued, and its completion
+* handler is called from XQspiPsu_InterruptHandler().
+*
+* @param	InstancePtr is a pointer to the XQspiPsu instance.
+* @param	Req is a pointer to a request set up with XQspiPsu_InitRequest().
+*
+* @return
+*		- XST_SUCCESS if the request was queued.
+*		- XST_FAILURE if an RX message exceeds the DMA limit.
+*		- XST_INVALID_PARAM if a message uses the poll flag.
+*		- XST_DEVICE_BUSY if a polled or interrupt transfer is running.
+*
+* @note		May be called from a completion handler.
+*
+******************************************************************************/
+s32 XQspiPsu_EnqueueRequest(XQspiPsu *InstancePtr, XQspiPsu_Request *Req)
+{
+	u32 Index;
+	u32 BaseAddress;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Req != NULL);
+	Xil_AssertNonvoid(Req->Msg != NULL);
+	Xil_AssertNonvoid(Req->NumMsg > 0U);
+
+	Req->TxBytes = 0U;
+	Req->RxBytes = 0U;
+	for (Index = 0U; Index < Req->NumMsg; Index++) {
+		Xil_AssertNonvoid(Req->Msg[Index].ByteCount > 0U);
+
+		if ((Req->Msg[Index].Flags & XQSPIPSU_MSG_FLAG_POLL) != FALSE) {
+			return (s32)XST_INVALID_PARAM;
+		}
+		/* Check for ByteCount upper limit - 2^28 for DMA */
+		if ((Req->Msg[Index].Flags & XQSPIPSU_MSG_FLAG_RX) != FALSE) {
+			if (Req->Msg[Index].ByteCount > XQSPIPSU_DMA_BYTES_MAX) {
+				return (s32)XST_FAILURE;
+			}
+			Req->RxBytes += Req->Msg[Index].ByteCount;
+		}
+		if ((Req->Msg[Index].Flags & XQSPIPSU_MSG_FLAG_TX) != FALSE) {
+			Req->TxBytes += Req->Msg[Index].ByteCount;
+		}
+	}
+
+	Req->Status = (s32)XST_SUCCESS;
+	Req->GenFifoCS = InstancePtr->GenFifoCS;
+	Req->GenFifoBus = InstancePtr->GenFifoBus;
+	Req->Next = NULL;
+
+	/* A polled or interrupt transfer owns the controller */
+	if ((InstancePtr->IsBusy == TRUE) && (InstancePtr->ReqHead == NULL)) {
+		return (s32)XST_DEVICE_BUSY;
+	}
+
+	BaseAddress = InstancePtr->Config.BaseAddress;
+
+	/* Keep the interrupt handler away from the queue */
+	XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_IDR_OFFSET,
+			XQSPIPSU_IDR_ALL_MASK);
+	XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_QSPIDMA_DST_I_DIS_OFFSET,
+			XQSPIPSU_QSPIDMA_DST_I_EN_DONE_MASK);
+
+	if (InstancePtr->ReqHead == NULL) {
+		InstancePtr->ReqHead = Req;
+		InstancePtr->ReqTail = Req;
+		InstancePtr->IsBusy = TRUE;
+		XQspiPsu_StartRequest(InstancePtr, Req);
+	} else {
+		InstancePtr->ReqTail->Next = Req;
+		InstancePtr->ReqTail = Req;
+		XQspiPsu_EnableIntr(InstancePtr);
+	}
+
+	return (s32)XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the request queue counters. Together with a time base these give
+* the throughput of the queue.
+*
+* @param	InstancePtr is a pointer to the XQspiPsu instance.
+* @param	Stats is a pointer to the structure filled in.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XQspiPsu_GetStats(XQspiPsu *InstancePtr, XQspiPsu_Stats *Stats)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Stats != NULL);
+
+	*Stats = InstancePtr->Stats;
+}
+
+/*****************************************************************************/
+/**
+*
+* Clears the request queue counters.
+*
+* @param	InstancePtr is a pointer to the XQspiPsu instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XQspiPsu_ResetStats(XQspiPsu *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	InstancePtr->Stats.Requests = 0U;
+	InstancePtr->Stats.Chained = 0U;
+	InstancePtr->Stats.Errors = 0U;
+	InstancePtr->Stats.TxBytes = 0U;
+	InstancePtr->Stats.RxBytes = 0U;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -935,6 +1163,121 @@ static void StubStatusHandler(void *CallBackRef, u32 StatusEvent,
 	Xil_AssertVoidAlways();
 }
 
+/*****************************************************************************/
+/**
+*
+* Enables the interrupts used by interrupt mode transfers.
+*
+* @param	InstancePtr is a pointer to the XQspiPsu instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPsu_EnableIntr(XQspiPsu *InstancePtr)
+{
+	u32 BaseAddress = InstancePtr->Config.BaseAddress;
+
+	XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_IER_OFFSET,
+		(u32)XQSPIPSU_IER_TXNOT_FULL_MASK | (u32)XQSPIPSU_IER_TXEMPTY_MASK |
+		(u32)XQSPIPSU_IER_RXNEMPTY_MASK | (u32)XQSPIPSU_IER_GENFIFOEMPTY_MASK |
+		(u32)XQSPIPSU_IER_RXEMPTY_MASK);
+
+	if (InstancePtr->ReadMode == XQSPIPSU_READMODE_DMA) {
+		XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_QSPIDMA_DST_I_EN_OFFSET,
+				XQSPIPSU_QSPIDMA_DST_I_EN_DONE_MASK);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the CS assert and the first message of a request into the GENFIFO
+* and starts it. Anything already in the GENFIFO, such as the CS de-assert
+* of the previous request, is executed first.
+*
+* @param	InstancePtr is a pointer to the XQspiPsu instance.
+* @param	Req is a pointer to the request.
+*
+* @return	None.
+*
+* @note		The caller has set IsBusy.
+*
+******************************************************************************/
+static void XQspiPsu_StartRequest(XQspiPsu *InstancePtr,
+			XQspiPsu_Request *Req)
+{
+	u32 BaseAddress = InstancePtr->Config.BaseAddress;
+
+	/* Back to DMA if the previous transfer ended in IO mode */
+	if (InstancePtr->IsUnaligned != 0) {
+		InstancePtr->IsUnaligned = 0;
+		XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_CFG_OFFSET,
+			(XQspiPsu_ReadReg(BaseAddress, XQSPIPSU_CFG_OFFSET) |
+			XQSPIPSU_CFG_MODE_EN_DMA_MASK));
+		InstancePtr->ReadMode = XQSPIPSU_READMODE_DMA;
+	}
+
+	InstancePtr->Msg = Req->Msg;
+	InstancePtr->NumMsg = (s32)Req->NumMsg;
+	InstancePtr->MsgCnt = 0;
+	InstancePtr->GenFifoCS = Req->GenFifoCS;
+	InstancePtr->GenFifoBus = Req->GenFifoBus;
+
+	/* Enable */
+	XQspiPsu_Enable(InstancePtr);
+
+	/* Select slave */
+	XQspiPsu_GenFifoEntryCSAssert(InstancePtr);
+
+	/* Put first message in FIFO along with the above slave select */
+	XQspiPsu_GenFifoEntryData(InstancePtr, Req->Msg, 0);
+
+	if (InstancePtr->IsManualstart == TRUE) {
+#ifdef DEBUG
+	xil_printf("\nManual Start\r\n");
+#endif
+		XQspiPsu_WriteReg(BaseAddress, XQSPIPSU_CFG_OFFSET,
+			XQspiPsu_ReadReg(BaseAddress, XQSPIPSU_CFG_OFFSET) |
+				XQSPIPSU_CFG_START_GEN_FIFO_MASK);
+	}
+
+	XQspiPsu_EnableIntr(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Accounts a request that has left the queue and calls its completion
+* handler.
+*
+* @param	InstancePtr is a pointer to the XQspiPsu instance.
+* @param	Req is a pointer to the request, already unlinked.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPsu_CompleteRequest(XQspiPsu *InstancePtr,
+			XQspiPsu_Request *Req)
+{
+	Req->Next = NULL;
+
+	InstancePtr->Stats.Requests += 1U;
+	if (Req->Status == (s32)XST_SUCCESS) {
+		InstancePtr->Stats.TxBytes += Req->TxBytes;
+		InstancePtr->Stats.RxBytes += Req->RxBytes;
+	} else {
+		InstancePtr->Stats.Errors += 1U;
+	}
+
+	if (Req->Handler != NULL) {
+		Req->Handler(Req->CallBackRef, Req, Req->Status);
+	}
+}
+
 /*****************************************************************************/
 /**
 *
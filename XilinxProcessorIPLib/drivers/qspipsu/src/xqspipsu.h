@@ -82,6 +82,19 @@
 * check the status of the transfer and report back to the application
 * when done.
 *
+* Request queue:
+* XQspiPsu_EnqueueRequest() queues a message array, wrapped in an
+* XQspiPsu_Request, behind the ones already submitted and returns at once.
+* Requests run in interrupt mode in the order they were queued, each under
+* its own CS assertion on the flash that was selected when it was queued.
+* When the last message of a request is done the interrupt handler writes
+* the CS de-assert and the start of the next request into the GENFIFO in
+* the same pass and then calls the completion handler of the finished one,
+* so back to back requests do not wait for the CPU in between.
+* XQspiPsu_GetStats() returns request and byte counters for throughput
+* measurements. Polled and interrupt transfers return XST_DEVICE_BUSY while
+* requests are queued.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -112,6 +125,9 @@
 *	             configuration. Updated XQspiPsu_PollData() and
 *	             XQspiPsu_Create_PollConfigData() functions in xqspipsu.c
 *                    and also modified the polldata example
+* 1.4   esd 10/18/26 Added the request queue: XQspiPsu_InitRequest,
+*                    XQspiPsu_EnqueueRequest, XQspiPsu_GetStats and
+*                    XQspiPsu_ResetStats
 *
 * </pre>
 *
@@ -166,6 +182,47 @@ typedef struct {
 	u8 PollBusMask;
 } XQspiPsu_Msg;
 
+typedef struct XQspiPsu_RequestS XQspiPsu_Request;
+
+/**
+ * Completion handler of a queued request. It is called from the interrupt
+ * handler with Status XST_SUCCESS, XST_SPI_COMMAND_ERROR if the RX DMA
+ * reported an error, or XST_FAILURE if the request was dropped by
+ * XQspiPsu_Abort(). The request may be queued again from the handler.
+ */
+typedef void (*XQspiPsu_RequestHandler) (void *CallBackRef,
+				XQspiPsu_Request *Req, s32 Status);
+
+/**
+ * A message array queued with XQspiPsu_EnqueueRequest(). The request and
+ * its messages belong to the driver until the completion handler is called.
+ */
+struct XQspiPsu_RequestS {
+	XQspiPsu_Msg *Msg;	 /**< Messages, sent under one CS assertion */
+	u32 NumMsg;		 /**< Number of messages */
+	XQspiPsu_RequestHandler Handler; /**< Completion handler, or NULL */
+	void *CallBackRef;	 /**< Passed back to the handler */
+
+	/* Driver private */
+	s32 Status;
+	u32 GenFifoCS;
+	u32 GenFifoBus;
+	u32 TxBytes;
+	u32 RxBytes;
+	XQspiPsu_Request *Next;
+};
+
+/**
+ * Request queue counters, see XQspiPsu_GetStats()
+ */
+typedef struct {
+	u32 Requests;	 /**< Requests completed */
+	u32 Chained;	 /**< Requests started straight behind the previous one */
+	u32 Errors;	 /**< Requests completed with an error */
+	u64 TxBytes;	 /**< Bytes sent by completed requests */
+	u64 RxBytes;	 /**< Bytes received by completed requests */
+} XQspiPsu_Stats;
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -203,6 +260,9 @@ typedef struct {
 	XQspiPsu_Msg *Msg;
 	XQspiPsu_StatusHandler StatusHandler;
 	void *StatusRef;  	 /**< Callback reference for status handler */
+	XQspiPsu_Request *ReqHead; /**< Running request, then queued ones */
+	XQspiPsu_Request *ReqTail; /**< Last queued request */
+	XQspiPsu_Stats Stats;	 /**< Request queue counters */
 } XQspiPsu;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -285,6 +345,14 @@ s32 XQspiPsu_InterruptHandler(XQspiPsu *InstancePtr);
 void XQspiPsu_SetStatusHandler(XQspiPsu *InstancePtr, void *CallBackRef,
 				XQspiPsu_StatusHandler FuncPointer);
 
+/* Request queue */
+void XQspiPsu_InitRequest(XQspiPsu_Request *Req, XQspiPsu_Msg *Msg,
+				u32 NumMsg, XQspiPsu_RequestHandler Handler,
+				void *CallBackRef);
+s32 XQspiPsu_EnqueueRequest(XQspiPsu *InstancePtr, XQspiPsu_Request *Req);
+void XQspiPsu_GetStats(XQspiPsu *InstancePtr, XQspiPsu_Stats *Stats);
+void XQspiPsu_ResetStats(XQspiPsu *InstancePtr);
+
 /* Configuration functions */
 s32 XQspiPsu_SetClkPrescaler(XQspiPsu *InstancePtr, u8 Prescaler);
 void XQspiPsu_SelectFlash(XQspiPsu *InstancePtr, u8 FlashCS, u8 FlashBus);
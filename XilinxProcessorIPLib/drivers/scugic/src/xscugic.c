@@ -107,6 +107,8 @@
 *					  and properly mask interrupt target processor value to modify
 *					  interrupt target processor register for a given interrupt ID
 *					  and cpu ID
+* 3.5   esd  10/18/26 XScuGic_CfgInitialize clears the dispatch options and
+*                     the statistics table.
 *
 *
 * </pre>
@@ -374,6 +376,9 @@ s32  XScuGic_CfgInitialize(XScuGic *InstancePtr,
 
 		InstancePtr->IsReady = 0U;
 		InstancePtr->Config = ConfigPtr;
+		InstancePtr->Options = 0U;
+		InstancePtr->NestingThreshold = 0xFFU;
+		InstancePtr->StatsTable = NULL;
 
 
 		for (Int_Id = 0U; Int_Id<XSCUGIC_MAX_NUM_INTR_INPUTS;Int_Id++) {
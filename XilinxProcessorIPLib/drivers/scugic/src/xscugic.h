@@ -77,7 +77,27 @@
 *
 * <b>Nested Interrupts Processing</b>
 *
-* Nested interrupts are not supported by this driver.
+* By default interrupts are dispatched one per exception and handlers run with
+* interrupts masked. XScuGic_SetOptions() can enable the following modes of
+* XScuGic_InterruptHandler:
+*
+* - XSCUGIC_OPTION_TAIL_CHAIN: after a handler completes, the next pending
+*   interrupt is acknowledged and dispatched in the same exception, until the
+*   spurious interrupt ID is read. Bursts of interrupts then pay the exception
+*   entry and exit cost only once.
+* - XSCUGIC_OPTION_NESTING: handlers of interrupts whose priority is equal to
+*   or lower than the threshold set by XScuGic_SetNestingThreshold() run with
+*   interrupts enabled, so the GIC can preempt them with higher priority
+*   interrupts. Handlers of higher priority interrupts still run masked. This
+*   is only supported on 32-bit processors (Cortex-A9 and Cortex-R5).
+*
+* <b>Interrupt Statistics</b>
+*
+* XScuGic_SetStatsTable() registers a table of XScuGic_IntrStats, one entry
+* per interrupt ID, in which the handler records how often each interrupt is
+* serviced and how many cycles its handler takes. Time stamps come from the
+* performance monitor cycle counter on Cortex-A9 and Cortex-R5 (xpm_counter.h)
+* and from the global timer on Cortex-A53.
 *
 * NOTE:
 * The generic interrupt controller is not a part of the snoop control unit
@@ -157,6 +177,10 @@
 *            the distributor is enabled or not and if not, it does the
 *            standard Distributor initialization.
 *            This fixes the CR#952962.
+* 3.5   esd  10/18/26 Added tail-chained dispatch and nesting options, and
+*            per interrupt statistics in XScuGic_InterruptHandler.
+*            Added XScuGic_SetOptions, XScuGic_GetOptions,
+*            XScuGic_SetNestingThreshold and XScuGic_SetStatsTable.
 *
 * </pre>
 *
@@ -182,6 +206,16 @@ extern "C" {
 #define EFUSE_STATUS_OFFSET   0x10
 #define EFUSE_STATUS_CPU_MASK 0x80
 
+/** @name Dispatch Options
+ * Options of XScuGic_InterruptHandler, see XScuGic_SetOptions().
+ * @{
+ */
+#define XSCUGIC_OPTION_TAIL_CHAIN	0x00000001U /**< Dispatch all pending
+							  interrupts per entry */
+#define XSCUGIC_OPTION_NESTING		0x00000002U /**< Let lower priority
+							  handlers be preempted */
+/*@}*/
+
 #if !defined (ARMR5) && !defined (__aarch64__) && !defined (ARMA53_32)
 #define ARMA9
 #endif
@@ -209,6 +243,18 @@ typedef struct
 				 Vector table of interrupt handlers */
 } XScuGic_Config;
 
+/**
+ * The following data type holds the statistics of one interrupt ID, recorded
+ * when a table of them is registered with XScuGic_SetStatsTable(). Cycles are
+ * measured across the handler call and include any nested interrupt.
+ */
+typedef struct
+{
+	u32 Count;		/**< Number of times the handler was called */
+	u32 MaxCycles;		/**< Longest run time of the handler */
+	u64 TotalCycles;	/**< Sum of run times of the handler */
+} XScuGic_IntrStats;
+
 /**
  * The XScuGic driver instance data. The user is required to allocate a
  * variable of this type for every intc device in the system. A pointer
@@ -219,6 +265,9 @@ typedef struct
 	XScuGic_Config *Config;  /**< Configuration table entry */
 	u32 IsReady;		 /**< Device is initialized and ready */
 	u32 UnhandledInterrupts; /**< Intc Statistics */
+	u32 Options;		 /**< Dispatch options */
+	u8 NestingThreshold;	 /**< Priority from which handlers nest */
+	XScuGic_IntrStats *StatsTable; /**< Per interrupt statistics, or NULL */
 } XScuGic;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -299,6 +348,25 @@ typedef struct
 #define XScuGic_DistReadReg(InstancePtr, RegOffset) \
 (XScuGic_ReadReg(((InstancePtr)->Config->DistBaseAddress), (RegOffset)))
 
+/****************************************************************************/
+/**
+*
+* Compute the average handler run time from an interrupt statistics entry.
+*
+* @param    StatsPtr is a pointer to the XScuGic_IntrStats entry.
+*
+* @return   The average number of cycles per handler call, 0 if the handler
+*           has not been called.
+*
+* @note
+* C-style signature:
+*    u64 XScuGic_IntrStatsAvgCycles(XScuGic_IntrStats *StatsPtr)
+*
+*****************************************************************************/
+#define XScuGic_IntrStatsAvgCycles(StatsPtr) \
+	(((StatsPtr)->Count != 0U) ? \
+	((StatsPtr)->TotalCycles / (u64)(StatsPtr)->Count) : (u64)0U)
+
 /************************** Function Prototypes ******************************/
 
 /*
@@ -331,6 +399,10 @@ XScuGic_Config *XScuGic_LookupConfig(u16 DeviceId);
  * Interrupt functions in xscugic_intr.c
  */
 void XScuGic_InterruptHandler(XScuGic *InstancePtr);
+void XScuGic_SetOptions(XScuGic *InstancePtr, u32 Options);
+u32 XScuGic_GetOptions(XScuGic *InstancePtr);
+void XScuGic_SetNestingThreshold(XScuGic *InstancePtr, u8 Threshold);
+void XScuGic_SetStatsTable(XScuGic *InstancePtr, XScuGic_IntrStats *TablePtr);
 
 /*
  * Self-test functions in xscugic_selftest.c
@@ -62,6 +62,11 @@
 * 1.01a sdm  11/09/11 XScuGic_InterruptHandler has changed correspondingly
 *		      since the HandlerTable has now moved to XScuGic_Config.
 * 3.00  kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
+* 3.5   esd  10/18/26 XScuGic_InterruptHandler can dispatch every pending
+*                     interrupt per call, nest lower priority handlers and
+*                     record per interrupt statistics. Added
+*                     XScuGic_SetOptions, XScuGic_GetOptions,
+*                     XScuGic_SetNestingThreshold and XScuGic_SetStatsTable.
 *
 * </pre>
 *
@@ -81,15 +86,29 @@
 #include "xil_types.h"
 #include "xil_assert.h"
 #include "xscugic.h"
+#include "xil_exception.h"
+#if defined (ARMR5) || defined (ARMA9)
+#include "xpm_counter.h"
+#else
+#include "xtime_l.h"
+#endif
 
 /************************** Constant Definitions *****************************/
 
+#define XSCUGIC_SPURIOUS_INTR_ID	1023U	/* Returned by an empty IAR */
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 
+static u64 XScuGic_GetCycles(void);
+static void XScuGic_DispatchInterrupt(XScuGic *InstancePtr, u32 InterruptID);
+#if defined (ARMR5) || defined (ARMA9)
+static void XScuGic_CallNested(XScuGic_VectorTableEntry *TablePtr);
+#endif
+
 /************************** Variable Definitions *****************************/
 
 /*****************************************************************************/
@@ -101,6 +120,10 @@
 * the Interrupt Type information to determine when to acknowledge the interrupt.
 * Highest priority interrupts are serviced first.
 *
+* When XSCUGIC_OPTION_TAIL_CHAIN is set, the next pending interrupt is
+* acknowledged as soon as a handler completes, and the function only returns
+* once the spurious interrupt ID is read.
+*
 * This function assumes that an interrupt vector table has been previously
 * initialized.  It does not verify that entries in the table are valid before
 * calling an interrupt handler.
@@ -115,59 +138,252 @@
 ******************************************************************************/
 void XScuGic_InterruptHandler(XScuGic *InstancePtr)
 {
-
 	u32 InterruptID;
-	    u32 IntIDFull;
-	    XScuGic_VectorTableEntry *TablePtr;
-
-	    /* Assert that the pointer to the instance is valid
-	     */
-	    Xil_AssertVoid(InstancePtr != NULL);
-
-	    /*
-	     * Read the int_ack register to identify the highest priority interrupt ID
-	     * and make sure it is valid. Reading Int_Ack will clear the interrupt
-	     * in the GIC.
-	     */
-	    IntIDFull = XScuGic_CPUReadReg(InstancePtr, XSCUGIC_INT_ACK_OFFSET);
-	    InterruptID = IntIDFull & XSCUGIC_ACK_INTID_MASK;
-
-	    if(XSCUGIC_MAX_NUM_INTR_INPUTS < InterruptID){
-		goto IntrExit;
-	    }
-
-	    /*
-	     * If the interrupt is shared, do some locking here if there are multiple
-	     * processors.
-	     */
-	    /*
-	     * If pre-eption is required:
-	     * Re-enable pre-emption by setting the CPSR I bit for non-secure ,
-	     * interrupts or the F bit for secure interrupts
-	     */
-
-	    /*
-	     * If we need to change security domains, issue a SMC instruction here.
-	     */
-
-	    /*
-	     * Execute the ISR. Jump into the Interrupt service routine based on the
-	     * IRQSource. A software trigger is cleared by the ACK.
-	     */
-	    TablePtr = &(InstancePtr->Config->HandlerTable[InterruptID]);
-		if(TablePtr != NULL) {
-	        TablePtr->Handler(TablePtr->CallBackRef);
+	u32 IntIDFull;
+
+	/* Assert that the pointer to the instance is valid
+	 */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	do {
+		/*
+		 * Read the int_ack register to identify the highest priority
+		 * interrupt ID and make sure it is valid. Reading Int_Ack will
+		 * clear the interrupt in the GIC.
+		 */
+		IntIDFull = XScuGic_CPUReadReg(InstancePtr,
+						XSCUGIC_INT_ACK_OFFSET);
+		InterruptID = IntIDFull & XSCUGIC_ACK_INTID_MASK;
+
+		if (InterruptID == XSCUGIC_SPURIOUS_INTR_ID) {
+			/* Nothing is pending, a spurious ID needs no EOI */
+			break;
+		}
+
+		if (InterruptID <= XSCUGIC_MAX_NUM_INTR_INPUTS) {
+			XScuGic_DispatchInterrupt(InstancePtr, InterruptID);
+		}
+
+		/*
+		 * Write to the EOI register, we are all done with this
+		 * interrupt. A software trigger is cleared by the ACK.
+		 */
+		XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_EOI_OFFSET, IntIDFull);
+
+	} while ((InstancePtr->Options & XSCUGIC_OPTION_TAIL_CHAIN) != 0U);
+
+	/*
+	 * Return from the interrupt, the boot code will restore the stack.
+	 */
+}
+
+/*****************************************************************************/
+/**
+* Execute the handler of an acknowledged interrupt. The handler runs with
+* interrupts enabled when nesting is enabled and the interrupt priority is at
+* or below the nesting threshold, and its run time is recorded when a
+* statistics table is registered.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	InterruptID is the acknowledged interrupt ID.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XScuGic_DispatchInterrupt(XScuGic *InstancePtr, u32 InterruptID)
+{
+	XScuGic_VectorTableEntry *TablePtr;
+	XScuGic_IntrStats *StatsPtr = NULL;
+	u64 Start = 0U;
+	u64 Cycles;
+#if defined (ARMR5) || defined (ARMA9)
+	u32 RunPriority;
+#endif
+
+	TablePtr = &(InstancePtr->Config->HandlerTable[InterruptID]);
+
+	if (InstancePtr->StatsTable != NULL) {
+		StatsPtr = &InstancePtr->StatsTable[InterruptID];
+		Start = XScuGic_GetCycles();
+	}
+
+#if defined (ARMR5) || defined (ARMA9)
+	/*
+	 * Larger priority values are lower priorities. The running priority is
+	 * the priority of the interrupt just acknowledged.
+	 */
+	RunPriority = XScuGic_CPUReadReg(InstancePtr, XSCUGIC_RUN_PRIOR_OFFSET) &
+			XSCUGIC_RUN_PRIORITY_MASK;
+	if (((InstancePtr->Options & XSCUGIC_OPTION_NESTING) != 0U) &&
+		(RunPriority >= (u32)InstancePtr->NestingThreshold)) {
+		XScuGic_CallNested(TablePtr);
+	} else {
+		TablePtr->Handler(TablePtr->CallBackRef);
+	}
+#else
+	TablePtr->Handler(TablePtr->CallBackRef);
+#endif
+
+	if (StatsPtr != NULL) {
+		/* Subtract in 32 bits, so a wrap of the cycle counter is harmless */
+		Cycles = (u64)((u32)XScuGic_GetCycles() - (u32)Start);
+		StatsPtr->Count++;
+		StatsPtr->TotalCycles += Cycles;
+		if (Cycles > (u64)StatsPtr->MaxCycles) {
+			StatsPtr->MaxCycles = (u32)Cycles;
 		}
+	}
+}
+
+#if defined (ARMR5) || defined (ARMA9)
+/*****************************************************************************/
+/**
+* Call an interrupt handler with interrupts enabled. The handler runs in
+* system mode on the system stack so that a nested IRQ does not corrupt the
+* IRQ mode link register.
+*
+* @param	TablePtr is the vector table entry of the interrupt.
+*
+* @return	None.
+*
+* @note		Kept in its own function because the nesting macros push onto
+*		the stack and must be balanced around the handler call only.
+*
+******************************************************************************/
+static void XScuGic_CallNested(XScuGic_VectorTableEntry *TablePtr)
+{
+	Xil_EnableNestedInterrupts();
+	TablePtr->Handler(TablePtr->CallBackRef);
+	Xil_DisableNestedInterrupts();
+}
+#endif
+
+/*****************************************************************************/
+/**
+* Read the time stamp used for the interrupt statistics.
+*
+* @return	Processor cycle count on Cortex-A9 and Cortex-R5, global timer
+*		count otherwise.
+*
+* @note		The 32-bit cycle counter wraps, so two reads are compared in
+*		32 bits. That is exact for any handler shorter than 2^32
+*		counts.
+*
+******************************************************************************/
+static u64 XScuGic_GetCycles(void)
+{
+#if defined (ARMR5) || defined (ARMA9)
+	return (u64)Xpm_ReadCycleCounter();
+#else
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return (u64)Now;
+#endif
+}
 
-	IntrExit:
-	    /*
-	     * Write to the EOI register, we are all done here.
-	     * Let this function return, the boot code will restore the stack.
-	     */
-	    XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_EOI_OFFSET, IntIDFull);
+/*****************************************************************************/
+/**
+* Set the dispatch options of XScuGic_InterruptHandler.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Options is a bit mask of XSCUGIC_OPTION_* values. Options not
+*		in the mask are cleared.
+*
+* @return	None.
+*
+* @note		XSCUGIC_OPTION_NESTING is ignored on 64-bit processors.
+*
+******************************************************************************/
+void XScuGic_SetOptions(XScuGic *InstancePtr, u32 Options)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid((Options & ~(XSCUGIC_OPTION_TAIL_CHAIN |
+				XSCUGIC_OPTION_NESTING)) == 0U);
+
+	InstancePtr->Options = Options;
+}
+
+/*****************************************************************************/
+/**
+* Get the dispatch options of XScuGic_InterruptHandler.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+*
+* @return	Bit mask of the XSCUGIC_OPTION_* values that are set.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XScuGic_GetOptions(XScuGic *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	return InstancePtr->Options;
+}
+
+/*****************************************************************************/
+/**
+* Set the priority from which interrupt handlers are nested. When
+* XSCUGIC_OPTION_NESTING is set, handlers of interrupts with a priority value
+* greater than or equal to Threshold run with interrupts enabled, so any
+* interrupt with a smaller priority value can preempt them.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Threshold is the priority value, in the format used by
+*		XScuGic_SetPriorityTriggerType.
+*
+* @return	None.
+*
+* @note		Handlers of nested interrupts must be reentrant with respect to
+*		the handlers of higher priority interrupts.
+*
+******************************************************************************/
+void XScuGic_SetNestingThreshold(XScuGic *InstancePtr, u8 Threshold)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->NestingThreshold = Threshold;
+}
+
+/*****************************************************************************/
+/**
+* Register the table in which XScuGic_InterruptHandler records per interrupt
+* statistics. The table is cleared by this function.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	TablePtr is a table of XSCUGIC_MAX_NUM_INTR_INPUTS + 1 entries
+*		indexed by interrupt ID, or NULL to stop recording.
+*
+* @return	None.
+*
+* @note		On Cortex-A9 and Cortex-R5 the cycle counter is enabled here
+*		through Xpm_EnableCycleCounter.
+*
+******************************************************************************/
+void XScuGic_SetStatsTable(XScuGic *InstancePtr, XScuGic_IntrStats *TablePtr)
+{
+	u32 Index;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (TablePtr != NULL) {
+		for (Index = 0U; Index <= XSCUGIC_MAX_NUM_INTR_INPUTS; Index++) {
+			TablePtr[Index].Count = 0U;
+			TablePtr[Index].MaxCycles = 0U;
+			TablePtr[Index].TotalCycles = 0U;
+		}
+#if defined (ARMR5) || defined (ARMA9)
+		Xpm_EnableCycleCounter();
+#endif
+	}
 
-	    /*
-	     * Return from the interrupt. Change security domains could happen here.
-     */
+	InstancePtr->StatsTable = TablePtr;
 }
 /** @} */
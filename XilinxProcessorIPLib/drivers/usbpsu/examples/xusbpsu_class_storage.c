@@ -41,6 +41,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   sg  06/06/16  First release
+* 1.2   esd 10/18/26  Queue the CSW of a READ right behind its data
 *
 * </pre>
 *
@@ -234,6 +235,14 @@ void ParseCBW(struct XUsbPsu *InstancePtr)
 			xil_printf("Failed: READ Offset 0x%08x\n", (int) Offset);
 			return;
 		}
+
+		/*
+		 * The endpoint queues transfers, so the status can follow the
+		 * data without waiting for its completion. The data completion
+		 * then sees the status phase and queues the next CBW, and the
+		 * CSW completion finds the command phase and does nothing.
+		 */
+		SendCSW(InstancePtr, 0);
 		break;
 
 	case USB_RBC_MODE_SENSE:
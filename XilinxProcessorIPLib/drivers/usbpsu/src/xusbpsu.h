@@ -46,6 +46,9 @@
 * 1.0   sg    06/06/16 First release
 * 1.1   sg    10/24/16 Update for backward compatability
 *                      Added XUsbPsu_IsSuperSpeed function in xusbpsu.c
+* 1.2   esd   10/18/26 Replaced the single endpoint TRB with a TRB ring so
+*                      that transfers can be queued, added scatter-gather
+*                      XUsbPsu_EpBufferSendSg/XUsbPsu_EpBufferRecvSg
 *
 * </pre>
 *
@@ -102,7 +105,11 @@ extern "C" {
 #define	XUSBPSU_TEST_PACKET						4U
 #define	XUSBPSU_TEST_FORCE_ENABLE				5U
 
-#define XUSBPSU_NUM_TRBS				8
+#define XUSBPSU_NUM_TRBS				8U	/* TRBs per endpoint ring,
+								 * power of 2 */
+#define XUSBPSU_TRB_MAX_LEN				0x00FFFC00U	/* Largest TRB length
+								 * that is a multiple of
+								 * every packet size */
 
 #define XUSBPSU_EVENT_PENDING		(0x00000001U << 0)
 
@@ -283,6 +290,35 @@ struct XUsbPsu_Trb {
 } __attribute__((packed));
 
 
+/**
+ * TRB ring slot. Each TRB is followed by a Link TRB to the next slot and
+ * owns a whole cache line, so flushing a TRB that is being queued never
+ * writes back over a TRB the core is still updating.
+ */
+struct XUsbPsu_TrbSlot {
+	struct XUsbPsu_Trb	Trb;	/**< TRB handed to the core */
+	struct XUsbPsu_Trb	Link;	/**< Link TRB to the next slot */
+} ALIGNMENT_CACHELINE;
+
+/**
+ * Software state of a queued TRB
+ */
+struct XUsbPsu_TrbInfo {
+	u8	*BufferPtr;		/**< Buffer described by the TRB */
+	u32	Length;			/**< Length programmed in the TRB */
+	u32	RequestedBytes;	/**< Bytes requested by the whole transfer,
+						 *   valid in its last TRB */
+	u8	Last;			/**< Last TRB of a transfer */
+};
+
+/**
+ * Scatter-gather list entry for XUsbPsu_EpBufferSendSg/RecvSg
+ */
+struct XUsbPsu_SgEntry {
+	u8	*BufferPtr;		/**< Buffer location */
+	u32	Length;			/**< Length of the buffer */
+};
+
 /*
  * Endpoint Parameters
  */
@@ -312,7 +348,12 @@ struct XUsbPsu_Ep {
 						 *   when data is sent for IN Ep
 						 *   and received for OUT Ep
 						 */
-	struct XUsbPsu_Trb	EpTrb ALIGNMENT_CACHELINE;/**< TRB used by endpoint */
+	struct XUsbPsu_TrbSlot	EpTrb[XUSBPSU_NUM_TRBS];
+						/**< TRB ring used by endpoint */
+	struct XUsbPsu_TrbInfo	TrbInfo[XUSBPSU_NUM_TRBS];
+						/**< Software state of each TRB */
+	u32	TrbEnqueue;		/**< TRBs queued, free running */
+	u32	TrbDequeue;		/**< TRBs retired, free running */
 	u32	EpStatus;		/**< Flags to represent Endpoint status */
 	u32	RequestedBytes;	/**< RequestedBytes for transfer */
 	u32	BytesTxed;		/**< Actual Bytes transferred */
@@ -544,6 +585,10 @@ s32 XUsbPsu_EpBufferSend(struct XUsbPsu *InstancePtr, u8 UsbEp,
 			u8 *BufferPtr, u32 BufferLen);
 s32 XUsbPsu_EpBufferRecv(struct XUsbPsu *InstancePtr, u8 UsbEp,
 				u8 *BufferPtr, u32 Length);
+s32 XUsbPsu_EpBufferSendSg(struct XUsbPsu *InstancePtr, u8 UsbEp,
+			const struct XUsbPsu_SgEntry *SgList, u32 NumEntries);
+s32 XUsbPsu_EpBufferRecvSg(struct XUsbPsu *InstancePtr, u8 UsbEp,
+			const struct XUsbPsu_SgEntry *SgList, u32 NumEntries);
 void XUsbPsu_EpSetStall(struct XUsbPsu *InstancePtr, u8 Epnum, u8 Dir);
 void XUsbPsu_EpClearStall(struct XUsbPsu *InstancePtr, u8 Epnum, u8 Dir);
 void XUsbPsu_SetEpHandler(struct XUsbPsu *InstancePtr, u8 Epnum,
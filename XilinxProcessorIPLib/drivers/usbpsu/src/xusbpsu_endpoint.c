@@ -43,6 +43,9 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   sg  06/06/16 First release
+* 1.2   esd 10/18/26 Queue transfers on a per-endpoint TRB ring, added
+*                    scatter-gather send/receive and retire every completed
+*                    transfer per XferInProgress event
 *
 * </pre>
 *
@@ -65,6 +68,12 @@
 
 /************************** Function Prototypes ******************************/
 
+static void XUsbPsu_EpInitTrbRing(struct XUsbPsu_Ep *Ept);
+static s32 XUsbPsu_EpStartTransfer(struct XUsbPsu *InstancePtr,
+				struct XUsbPsu_Ep *Ept, struct XUsbPsu_Trb *TrbPtr);
+static s32 XUsbPsu_EpQueueTrbs(struct XUsbPsu *InstancePtr,
+				struct XUsbPsu_Ep *Ept,
+				const struct XUsbPsu_SgEntry *SgList, u32 NumEntries);
 
 /************************** Variable Definitions *****************************/
 
@@ -267,6 +276,14 @@ s32 XUsbPsu_SetEpConfig(struct XUsbPsu *InstancePtr, u8 UsbEpNum, u8 Dir,
 	Params->Param1 = XUSBPSU_DEPCFG_XFER_COMPLETE_EN
 		| XUSBPSU_DEPCFG_XFER_NOT_READY_EN;
 
+	/*
+	 * Transfers on the TRB ring never set LST, so completions of
+	 * non-control endpoints are reported as XferInProgress
+	 */
+	if (Type != XUSBPSU_ENDPOINT_XFER_CONTROL) {
+		Params->Param1 |= XUSBPSU_DEPCFG_XFER_IN_PROGRESS_EN;
+	}
+
 	/*
 	 * We are doing 1:1 mapping for endpoints, meaning
 	 * Physical Endpoints 2 maps to Logical Endpoint 2 and
@@ -355,6 +372,8 @@ s32 XUsbPsu_EpEnable(struct XUsbPsu *InstancePtr, u8 UsbEpNum, u8 Dir,
 	Ept->PhyEpNum	= (u8)PhyEpNum;
 
 	if ((Ept->EpStatus & XUSBPSU_EP_ENABLED) == 0U) {
+		XUsbPsu_EpInitTrbRing(Ept);
+
 		Ret = XUsbPsu_StartEpConfig(InstancePtr, UsbEpNum, Dir);
 		if (Ret != 0) {
 			return Ret;
@@ -533,6 +552,9 @@ void XUsbPsu_StopTransfer(struct XUsbPsu *InstancePtr, u8 UsbEpNum, u8 Dir)
 	Ept->ResourceIndex = 0U;
 	Ept->EpStatus &= ~XUSBPSU_EP_BUSY;
 	XUsbSleep(100U);
+
+	/* Transfers still queued were ended along with the transfer */
+	XUsbPsu_EpInitTrbRing(Ept);
 }
 
 /****************************************************************************/
@@ -578,77 +600,272 @@ void XUsbPsu_ClearStalls(struct XUsbPsu *InstancePtr)
 
 /****************************************************************************/
 /**
-* Initiates DMA to send data on endpoint to Host.
+* Links the TRB slots of an Endpoint into a ring and marks it empty.
+*
+* @param	Ept is a pointer to the Endpoint.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XUsbPsu_EpInitTrbRing(struct XUsbPsu_Ep *Ept)
+{
+	struct XUsbPsu_TrbSlot *Slot;
+	struct XUsbPsu_TrbSlot *Next;
+	u32 Index;
+
+	for (Index = 0U; Index < XUSBPSU_NUM_TRBS; Index++) {
+		Slot = &Ept->EpTrb[Index];
+		Next = &Ept->EpTrb[(Index + 1U) % XUSBPSU_NUM_TRBS];
+
+		Slot->Trb.BufferPtrLow = 0U;
+		Slot->Trb.BufferPtrHigh = 0U;
+		Slot->Trb.Size = 0U;
+		Slot->Trb.Ctrl = 0U;
+
+		Slot->Link.BufferPtrLow = (UINTPTR)&Next->Trb;
+		Slot->Link.BufferPtrHigh = ((UINTPTR)&Next->Trb >> 16) >> 16;
+		Slot->Link.Size = 0U;
+		Slot->Link.Ctrl = XUSBPSU_TRBCTL_LINK_TRB | XUSBPSU_TRB_CTRL_HWO;
+
+		Ept->TrbInfo[Index].BufferPtr = NULL;
+		Ept->TrbInfo[Index].Length = 0U;
+		Ept->TrbInfo[Index].RequestedBytes = 0U;
+		Ept->TrbInfo[Index].Last = 0U;
+	}
+
+	Xil_DCacheFlushRange((INTPTR)Ept->EpTrb, sizeof(Ept->EpTrb));
+
+	Ept->TrbEnqueue = 0U;
+	Ept->TrbDequeue = 0U;
+}
+
+/****************************************************************************/
+/**
+* Starts a transfer on an idle Endpoint from the given TRB. The transfer is
+* kept active and picks up TRBs queued later through Update Transfer.
 *
 * @param	InstancePtr is a pointer to the XUsbPsu instance.
-* @param	UsbEp is USB endpoint number.
-* @param	BufferPtr is pointer to data.
-* @param	BufferLen is length of data buffer.
+* @param	Ept is a pointer to the Endpoint.
+* @param	TrbPtr is the first TRB of the transfer.
 *
 * @return	XST_SUCCESS else XST_FAILURE
 *
 * @note		None.
 *
 *****************************************************************************/
-s32 XUsbPsu_EpBufferSend(struct XUsbPsu *InstancePtr, u8 UsbEp,
-						 u8 *BufferPtr, u32 BufferLen)
+static s32 XUsbPsu_EpStartTransfer(struct XUsbPsu *InstancePtr,
+				struct XUsbPsu_Ep *Ept, struct XUsbPsu_Trb *TrbPtr)
 {
-	u8	PhyEpNum;
-	s32	RetVal;
-	struct XUsbPsu_Trb	*TrbPtr;
-	struct XUsbPsu_Ep *Ept;
 	struct XUsbPsu_EpParams *Params;
+	s32 RetVal;
 
-	Xil_AssertNonvoid(InstancePtr != NULL);
-	Xil_AssertNonvoid(UsbEp <= (u8)16U);
-	Xil_AssertNonvoid(BufferPtr != NULL);
+	Params = XUsbPsu_GetEpParams(InstancePtr);
+	Xil_AssertNonvoid(Params != NULL);
+	Params->Param0 = ((UINTPTR)TrbPtr >> 16) >> 16;
+	Params->Param1 = (UINTPTR)TrbPtr;
 
-	PhyEpNum = PhysicalEp(UsbEp, XUSBPSU_EP_DIR_IN);
-	if (PhyEpNum == 1U) {
-		RetVal = XUsbPsu_Ep0Send(InstancePtr, BufferPtr, BufferLen);
-		return RetVal;
+	RetVal = XUsbPsu_SendEpCmd(InstancePtr, Ept->UsbEpNum, Ept->Direction,
+								XUSBPSU_DEPCMD_STARTTRANSFER, Params);
+	if (RetVal != XST_SUCCESS) {
+		return XST_FAILURE;
 	}
 
-	Ept = &InstancePtr->eps[PhyEpNum];
+	Ept->ResourceIndex = (u8)XUsbPsu_EpGetTransferIndex(InstancePtr,
+													Ept->UsbEpNum,
+													Ept->Direction);
+	Ept->EpStatus |= XUSBPSU_EP_BUSY;
 
-	if (Ept->Direction != XUSBPSU_EP_DIR_IN) {
-		return XST_FAILURE;
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+* Queues one transfer, described by a scatter-gather list, on the TRB ring of
+* an Endpoint and hands it to the core. Buffers longer than
+* XUSBPSU_TRB_MAX_LEN are split over chained TRBs.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	Ept is a pointer to the Endpoint.
+* @param	SgList is the list of buffers making up the transfer.
+* @param	NumEntries is the number of entries in SgList.
+*
+* @return	XST_SUCCESS, XST_DEVICE_BUSY if the ring has no room for the
+*			transfer, else XST_FAILURE.
+*
+* @note		None.
+*
+*****************************************************************************/
+static s32 XUsbPsu_EpQueueTrbs(struct XUsbPsu *InstancePtr,
+				struct XUsbPsu_Ep *Ept,
+				const struct XUsbPsu_SgEntry *SgList, u32 NumEntries)
+{
+	struct XUsbPsu_TrbSlot *Slot;
+	struct XUsbPsu_TrbSlot *FirstSlot = NULL;
+	struct XUsbPsu_TrbInfo *Info;
+	struct XUsbPsu_EpParams *Params;
+	u32 NumTrbs = 0U;
+	u32 Total = 0U;
+	u32 Pad = 0U;
+	u32 Queued = 0U;
+	u32 Entry = 0U;
+	u32 Offset = 0U;
+	u32 FirstCtrl = 0U;
+	u32 Ctrl;
+	u32 Len;
+	u8 *Buf;
+	s32 RetVal;
+
+	for (Entry = 0U; Entry < NumEntries; Entry++) {
+		Total += SgList[Entry].Length;
+		NumTrbs += (SgList[Entry].Length + XUSBPSU_TRB_MAX_LEN - 1U) /
+					XUSBPSU_TRB_MAX_LEN;
 	}
 
-	Ept->RequestedBytes = BufferLen;
-	Ept->BytesTxed = 0U;
-	Ept->BufferPtr = BufferPtr;
+	/* A zero length transfer still takes one TRB */
+	if (NumTrbs == 0U) {
+		NumTrbs = 1U;
+	}
 
-	TrbPtr = &Ept->EpTrb;
-	Xil_AssertNonvoid(TrbPtr != NULL);
+	if (NumTrbs > (XUSBPSU_NUM_TRBS - (Ept->TrbEnqueue - Ept->TrbDequeue))) {
+		return XST_DEVICE_BUSY;
+	}
 
-	TrbPtr->BufferPtrLow  = (UINTPTR)BufferPtr;
-	TrbPtr->BufferPtrHigh  = ((UINTPTR)BufferPtr >> 16) >> 16;
-	TrbPtr->Size = BufferLen & XUSBPSU_TRB_SIZE_MASK;
-	TrbPtr->Ctrl = XUSBPSU_TRBCTL_NORMAL;
+	/*
+	 * 8.2.5 - An OUT transfer size (Total TRB buffer allocation)
+	 * must be a multiple of MaxPacketSize even if software is expecting a
+	 * fixed non-multiple of MaxPacketSize transfer from the Host.
+	 */
+	if ((Ept->Direction == XUSBPSU_EP_DIR_OUT) &&
+		(!IS_ALIGNED(Total, Ept->MaxSize))) {
+		Pad = (u32)roundup(Total, Ept->MaxSize) - Total;
+	}
 
-	TrbPtr->Ctrl |= (XUSBPSU_TRB_CTRL_HWO
-					| XUSBPSU_TRB_CTRL_LST
-					| XUSBPSU_TRB_CTRL_IOC
-					| XUSBPSU_TRB_CTRL_ISP_IMI);
+	Entry = 0U;
+	while (Queued < NumTrbs) {
+		if (Total == 0U) {
+			Buf = SgList[0].BufferPtr;
+			Len = 0U;
+		} else {
+			while (Offset == SgList[Entry].Length) {
+				Entry++;
+				Offset = 0U;
+			}
+			Buf = SgList[Entry].BufferPtr + Offset;
+			Len = SgList[Entry].Length - Offset;
+			if (Len > XUSBPSU_TRB_MAX_LEN) {
+				Len = XUSBPSU_TRB_MAX_LEN;
+			}
+			Offset += Len;
+		}
 
-	Xil_DCacheFlushRange((INTPTR)TrbPtr, sizeof(struct XUsbPsu_Trb));
-	Xil_DCacheFlushRange((INTPTR)BufferPtr, BufferLen);
+		if (Ept->Direction == XUSBPSU_EP_DIR_IN) {
+			Xil_DCacheFlushRange((INTPTR)Buf, Len);
+		} else {
+			Xil_DCacheInvalidateRange((INTPTR)Buf, Len);
+		}
 
-	Params = XUsbPsu_GetEpParams(InstancePtr);
-	Xil_AssertNonvoid(Params != NULL);
-	Params->Param0 = 0U;
-	Params->Param1 = (UINTPTR)TrbPtr;
+		Slot = &Ept->EpTrb[(Ept->TrbEnqueue + Queued) % XUSBPSU_NUM_TRBS];
+		Info = &Ept->TrbInfo[(Ept->TrbEnqueue + Queued) % XUSBPSU_NUM_TRBS];
+		Queued++;
 
-	RetVal = XUsbPsu_SendEpCmd(InstancePtr, UsbEp, Ept->Direction,
-								XUSBPSU_DEPCMD_STARTTRANSFER, Params);
+		Ctrl = XUSBPSU_TRBCTL_NORMAL | XUSBPSU_TRB_CTRL_ISP_IMI;
+		if (Ept->Direction == XUSBPSU_EP_DIR_OUT) {
+			/* A short packet ends this transfer, not the ring */
+			Ctrl |= XUSBPSU_TRB_CTRL_CSP;
+		}
+
+		if (Queued == NumTrbs) {
+			Len += Pad;
+			Ctrl |= XUSBPSU_TRB_CTRL_IOC;
+			Info->Last = 1U;
+			Info->RequestedBytes = Total;
+		} else {
+			Ctrl |= XUSBPSU_TRB_CTRL_CHN;
+			Info->Last = 0U;
+			Info->RequestedBytes = 0U;
+		}
+		Info->BufferPtr = Buf;
+		Info->Length = Len;
+
+		Slot->Trb.BufferPtrLow  = (UINTPTR)Buf;
+		Slot->Trb.BufferPtrHigh = ((UINTPTR)Buf >> 16) >> 16;
+		Slot->Trb.Size = Len & XUSBPSU_TRB_SIZE_MASK;
+
+		if (FirstSlot == NULL) {
+			FirstSlot = Slot;
+			FirstCtrl = Ctrl;
+			Slot->Trb.Ctrl = Ctrl;
+		} else {
+			Slot->Trb.Ctrl = Ctrl | XUSBPSU_TRB_CTRL_HWO;
+		}
+		Xil_DCacheFlushRange((INTPTR)&Slot->Trb, sizeof(struct XUsbPsu_Trb));
+	}
+
+	/*
+	 * Hand the first TRB over last, so that an active transfer never
+	 * runs into a partly written chain
+	 */
+	FirstSlot->Trb.Ctrl = FirstCtrl | XUSBPSU_TRB_CTRL_HWO;
+	Xil_DCacheFlushRange((INTPTR)&FirstSlot->Trb, sizeof(struct XUsbPsu_Trb));
+
+	Ept->TrbEnqueue += NumTrbs;
+
+	if ((Ept->EpStatus & XUSBPSU_EP_BUSY) != 0U) {
+		Params = XUsbPsu_GetEpParams(InstancePtr);
+		Xil_AssertNonvoid(Params != NULL);
+
+		return XUsbPsu_SendEpCmd(InstancePtr, Ept->UsbEpNum, Ept->Direction,
+					XUSBPSU_DEPCMD_UPDATETRANSFER |
+					XUSBPSU_DEPCMD_PARAM(Ept->ResourceIndex), Params);
+	}
+
+	RetVal = XUsbPsu_EpStartTransfer(InstancePtr, Ept, &FirstSlot->Trb);
 	if (RetVal != XST_SUCCESS) {
-		return XST_FAILURE;
+		FirstSlot->Trb.Ctrl = FirstCtrl;
+		Xil_DCacheFlushRange((INTPTR)&FirstSlot->Trb,
+								sizeof(struct XUsbPsu_Trb));
+		Ept->TrbEnqueue -= NumTrbs;
 	}
-	Ept->ResourceIndex = (u8)XUsbPsu_EpGetTransferIndex(InstancePtr,
-													Ept->UsbEpNum,
-													Ept->Direction);
-	return XST_SUCCESS;
+
+	return RetVal;
+}
+
+/****************************************************************************/
+/**
+* Initiates DMA to send data on endpoint to Host.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	UsbEp is USB endpoint number.
+* @param	BufferPtr is pointer to data.
+* @param	BufferLen is length of data buffer.
+*
+* @return	XST_SUCCESS, XST_DEVICE_BUSY if the endpoint has no free TRBs,
+*			else XST_FAILURE
+*
+* @note		The transfer is queued behind any transfer already in
+*			progress on the endpoint; the endpoint handler is called once
+*			per transfer, in order.
+*
+*****************************************************************************/
+s32 XUsbPsu_EpBufferSend(struct XUsbPsu *InstancePtr, u8 UsbEp,
+						 u8 *BufferPtr, u32 BufferLen)
+{
+	struct XUsbPsu_SgEntry Sg;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(UsbEp <= (u8)16U);
+	Xil_AssertNonvoid(BufferPtr != NULL);
+
+	if (PhysicalEp(UsbEp, XUSBPSU_EP_DIR_IN) == 1U) {
+		return XUsbPsu_Ep0Send(InstancePtr, BufferPtr, BufferLen);
+	}
+
+	Sg.BufferPtr = BufferPtr;
+	Sg.Length = BufferLen;
+
+	return XUsbPsu_EpBufferSendSg(InstancePtr, UsbEp, &Sg, 1U);
 }
 
 /****************************************************************************/
@@ -660,83 +877,117 @@ s32 XUsbPsu_EpBufferSend(struct XUsbPsu *InstancePtr, u8 UsbEp,
 * @param	BufferPtr is pointer to data.
 * @param	Length is length of data to be received.
 *
-* @return	XST_SUCCESS else XST_FAILURE
+* @return	XST_SUCCESS, XST_DEVICE_BUSY if the endpoint has no free TRBs,
+*			else XST_FAILURE
 *
-* @note		None.
+* @note		The transfer is queued behind any transfer already in
+*			progress on the endpoint; the endpoint handler is called once
+*			per transfer, in order.
 *
 *****************************************************************************/
 s32 XUsbPsu_EpBufferRecv(struct XUsbPsu *InstancePtr, u8 UsbEp,
 						 u8 *BufferPtr, u32 Length)
 {
-	u8	PhyEpNum;
-	u32 Size;
-	s32	RetVal;
-	struct XUsbPsu_Trb	*TrbPtr;
-	struct XUsbPsu_Ep *Ept;
-	struct XUsbPsu_EpParams *Params;
+	struct XUsbPsu_SgEntry Sg;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(UsbEp <= (u8)16U);
 	Xil_AssertNonvoid(BufferPtr != NULL);
 
-	PhyEpNum = PhysicalEp(UsbEp, XUSBPSU_EP_DIR_OUT);
-	if (PhyEpNum == 0U) {
-		RetVal = XUsbPsu_Ep0Recv(InstancePtr, BufferPtr, Length);
-		return RetVal;
+	if (PhysicalEp(UsbEp, XUSBPSU_EP_DIR_OUT) == 0U) {
+		return XUsbPsu_Ep0Recv(InstancePtr, BufferPtr, Length);
 	}
 
-	Ept = &InstancePtr->eps[PhyEpNum];
+	Sg.BufferPtr = BufferPtr;
+	Sg.Length = Length;
 
-	if (Ept->Direction != XUSBPSU_EP_DIR_OUT) {
+	return XUsbPsu_EpBufferRecvSg(InstancePtr, UsbEp, &Sg, 1U);
+}
+
+/****************************************************************************/
+/**
+* Queues one transfer to the Host gathered from a list of buffers.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	UsbEp is USB endpoint number.
+* @param	SgList is the list of buffers, sent back to back.
+* @param	NumEntries is the number of entries in SgList.
+*
+* @return	XST_SUCCESS, XST_DEVICE_BUSY if the endpoint has not enough free
+*			TRBs, else XST_FAILURE
+*
+* @note		The endpoint handler is called once, with the total length,
+*			when the whole list has been sent. Control endpoints are not
+*			supported.
+*
+*****************************************************************************/
+s32 XUsbPsu_EpBufferSendSg(struct XUsbPsu *InstancePtr, u8 UsbEp,
+			const struct XUsbPsu_SgEntry *SgList, u32 NumEntries)
+{
+	u8	PhyEpNum;
+	struct XUsbPsu_Ep *Ept;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(UsbEp <= (u8)16U);
+	Xil_AssertNonvoid(SgList != NULL);
+	Xil_AssertNonvoid(NumEntries != 0U);
+
+	PhyEpNum = PhysicalEp(UsbEp, XUSBPSU_EP_DIR_IN);
+	if (PhyEpNum == 1U) {
 		return XST_FAILURE;
 	}
 
-	Ept->RequestedBytes = Length;
-	Size = Length;
-	Ept->BytesTxed = 0U;
-	Ept->BufferPtr = BufferPtr;
+	Ept = &InstancePtr->eps[PhyEpNum];
 
-	/*
-	 * 8.2.5 - An OUT transfer size (Total TRB buffer allocation)
-	 * must be a multiple of MaxPacketSize even if software is expecting a
-	 * fixed non-multiple of MaxPacketSize transfer from the Host.
-	 */
-	if (!IS_ALIGNED(Length, Ept->MaxSize)) {
-		Size = (u32)roundup(Length, Ept->MaxSize);
-		Ept->UnalignedTx = 1U;
+	if (Ept->Direction != XUSBPSU_EP_DIR_IN) {
+		return XST_FAILURE;
 	}
 
-	TrbPtr = &Ept->EpTrb;
-	Xil_AssertNonvoid(TrbPtr != NULL);
-
-	TrbPtr->BufferPtrLow  = (UINTPTR)BufferPtr;
-	TrbPtr->BufferPtrHigh = ((UINTPTR)BufferPtr >> 16) >> 16;
-	TrbPtr->Size = Size;
-	TrbPtr->Ctrl = XUSBPSU_TRBCTL_NORMAL;
+	return XUsbPsu_EpQueueTrbs(InstancePtr, Ept, SgList, NumEntries);
+}
 
-	TrbPtr->Ctrl |= (XUSBPSU_TRB_CTRL_HWO
-					| XUSBPSU_TRB_CTRL_LST
-					| XUSBPSU_TRB_CTRL_IOC
-					| XUSBPSU_TRB_CTRL_ISP_IMI);
+/****************************************************************************/
+/**
+* Queues one transfer from the Host scattered over a list of buffers.
+*
+* @param	InstancePtr is a pointer to the XUsbPsu instance.
+* @param	UsbEp is USB endpoint number.
+* @param	SgList is the list of buffers, filled back to back.
+* @param	NumEntries is the number of entries in SgList.
+*
+* @return	XST_SUCCESS, XST_DEVICE_BUSY if the endpoint has not enough free
+*			TRBs, else XST_FAILURE
+*
+* @note		The endpoint handler is called once, with the total length,
+*			when the transfer completes or ends with a short packet. If the
+*			total length is not a multiple of the packet size the last
+*			buffer must have room for the rounded up size. Control
+*			endpoints are not supported.
+*
+*****************************************************************************/
+s32 XUsbPsu_EpBufferRecvSg(struct XUsbPsu *InstancePtr, u8 UsbEp,
+			const struct XUsbPsu_SgEntry *SgList, u32 NumEntries)
+{
+	u8	PhyEpNum;
+	struct XUsbPsu_Ep *Ept;
 
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(UsbEp <= (u8)16U);
+	Xil_AssertNonvoid(SgList != NULL);
+	Xil_AssertNonvoid(NumEntries != 0U);
 
-	Xil_DCacheFlushRange((INTPTR)TrbPtr, sizeof(struct XUsbPsu_Trb));
-	Xil_DCacheInvalidateRange((INTPTR)BufferPtr, Length);
+	PhyEpNum = PhysicalEp(UsbEp, XUSBPSU_EP_DIR_OUT);
+	if (PhyEpNum == 0U) {
+		return XST_FAILURE;
+	}
 
-	Params = XUsbPsu_GetEpParams(InstancePtr);
-	Xil_AssertNonvoid(Params != NULL);
-	Params->Param0 = 0U;
-	Params->Param1 = (UINTPTR)TrbPtr;
+	Ept = &InstancePtr->eps[PhyEpNum];
 
-	RetVal = XUsbPsu_SendEpCmd(InstancePtr, UsbEp, Ept->Direction,
-								XUSBPSU_DEPCMD_STARTTRANSFER, Params);
-	if (RetVal != XST_SUCCESS) {
+	if (Ept->Direction != XUSBPSU_EP_DIR_OUT) {
 		return XST_FAILURE;
 	}
-	Ept->ResourceIndex = (u8)XUsbPsu_EpGetTransferIndex(InstancePtr,
-													Ept->UsbEpNum,
-													Ept->Direction);
-	return XST_SUCCESS;
+
+	return XUsbPsu_EpQueueTrbs(InstancePtr, Ept, SgList, NumEntries);
 }
 
 /****************************************************************************/
@@ -870,7 +1121,10 @@ s32 XUsbPsu_IsEpStalled(struct XUsbPsu *InstancePtr, u8 Epnum, u8 Dir)
 
 /****************************************************************************/
 /**
-* Checks the Data Phase and calls user Endpoint handler.
+* Retires every completed transfer on the TRB ring of an Endpoint and calls
+* the user Endpoint handler for each of them, in order. Transfers that
+* completed before the event was processed are retired by the same call, so
+* their own events find nothing left to do.
 *
 * @param	InstancePtr is a pointer to the XUsbPsu instance.
 * @param	Event is a pointer to the Endpoint event occured in core.
@@ -884,9 +1138,15 @@ void XUsbPsu_EpXferComplete(struct XUsbPsu *InstancePtr,
 							const struct XUsbPsu_Event_Epevt *Event)
 {
 	struct XUsbPsu_Ep	*Ept;
-	struct XUsbPsu_Trb	*TrbPtr;
-	u32	Length;
+	struct XUsbPsu_TrbSlot	*Slot;
+	struct XUsbPsu_TrbInfo	*Info;
 	u32	Epnum;
+	u32	Count;
+	u32	Remaining;
+	u32	Transferred;
+	u8	Short;
+	u8	Done;
+	u8	*BufferPtr;
 	u8	Dir;
 
 	Xil_AssertVoid(InstancePtr != NULL);
@@ -895,33 +1155,83 @@ void XUsbPsu_EpXferComplete(struct XUsbPsu *InstancePtr,
 	Epnum = Event->Epnumber;
 	Ept = &InstancePtr->eps[Epnum];
 	Dir = Ept->Direction;
-	TrbPtr = &Ept->EpTrb;
-	Xil_AssertVoid(TrbPtr != NULL);
-
-	Xil_DCacheInvalidateRange((INTPTR)TrbPtr, sizeof(struct XUsbPsu_Trb));
-
-	Length = TrbPtr->Size & XUSBPSU_TRB_SIZE_MASK;
-
-	if (Length == 0U) {
-		Ept->BytesTxed = Ept->RequestedBytes;
-	} else {
-		if (Dir == XUSBPSU_EP_DIR_IN) {
-			Ept->BytesTxed = Ept->RequestedBytes - Length;
-		} else if (Dir == XUSBPSU_EP_DIR_OUT) {
-			if (Ept->UnalignedTx == 1U) {
-				Ept->BytesTxed = Ept->RequestedBytes;
-				Ept->UnalignedTx = 0U;
+
+	if (Event->Endpoint_Event == XUSBPSU_DEPEVT_XFERCOMPLETE) {
+		/* The transfer has ended; TRBs still queued are restarted below */
+		Ept->EpStatus &= ~XUSBPSU_EP_BUSY;
+		Ept->ResourceIndex = 0U;
+	}
+
+	while (Ept->TrbDequeue != Ept->TrbEnqueue) {
+		Count = 0U;
+		Transferred = 0U;
+		Short = 0U;
+		Done = 0U;
+		BufferPtr = Ept->TrbInfo[Ept->TrbDequeue % XUSBPSU_NUM_TRBS].BufferPtr;
+
+		while ((Done == 0U) &&
+				((Ept->TrbDequeue + Count) != Ept->TrbEnqueue)) {
+			Slot = &Ept->EpTrb[(Ept->TrbDequeue + Count) % XUSBPSU_NUM_TRBS];
+			Info = &Ept->TrbInfo[(Ept->TrbDequeue + Count) % XUSBPSU_NUM_TRBS];
+
+			Xil_DCacheInvalidateRange((INTPTR)&Slot->Trb,
+										sizeof(struct XUsbPsu_Trb));
+
+			if ((Slot->Trb.Ctrl & XUSBPSU_TRB_CTRL_HWO) != 0U) {
+				if (Short == 0U) {
+					/* Transfer still in progress */
+					break;
+				}
+				/*
+				 * The core skipped the rest of the chain after a
+				 * short packet but leaves it owned by hardware
+				 */
+				Slot->Trb.Ctrl &= ~XUSBPSU_TRB_CTRL_HWO;
+				Xil_DCacheFlushRange((INTPTR)&Slot->Trb,
+										sizeof(struct XUsbPsu_Trb));
+			} else {
+				Remaining = Slot->Trb.Size & XUSBPSU_TRB_SIZE_MASK;
+				Transferred += Info->Length - Remaining;
+				if ((Dir == XUSBPSU_EP_DIR_OUT) && (Remaining != 0U)) {
+					Short = 1U;
+				}
+				if (Dir == XUSBPSU_EP_DIR_OUT) {
+					/* Invalidate Cache */
+					Xil_DCacheInvalidateRange((INTPTR)Info->BufferPtr,
+											Info->Length - Remaining);
+				}
+			}
+
+			Count++;
+			if (Info->Last != 0U) {
+				Done = 1U;
 			}
 		}
-	}
 
-	if (Dir == XUSBPSU_EP_DIR_OUT) {
-		/* Invalidate Cache */
-		Xil_DCacheInvalidateRange((INTPTR)Ept->BufferPtr, Ept->BytesTxed);
+		if (Done == 0U) {
+			break;
+		}
+
+		Ept->TrbDequeue += Count;
+
+		Info = &Ept->TrbInfo[(Ept->TrbDequeue - 1U) % XUSBPSU_NUM_TRBS];
+		Ept->RequestedBytes = Info->RequestedBytes;
+		Ept->BytesTxed = Transferred;
+		if (Ept->BytesTxed > Ept->RequestedBytes) {
+			/* Padding of an unaligned OUT transfer */
+			Ept->BytesTxed = Ept->RequestedBytes;
+		}
+		Ept->BufferPtr = BufferPtr;
+
+		if (Ept->Handler != NULL) {
+			Ept->Handler(InstancePtr, Ept->RequestedBytes, Ept->BytesTxed);
+		}
 	}
 
-	if (Ept->Handler != NULL) {
-		Ept->Handler(InstancePtr, Ept->RequestedBytes, Ept->BytesTxed);
+	if (((Ept->EpStatus & XUSBPSU_EP_BUSY) == 0U) &&
+		(Ept->TrbDequeue != Ept->TrbEnqueue)) {
+		Slot = &Ept->EpTrb[Ept->TrbDequeue % XUSBPSU_NUM_TRBS];
+		(void)XUsbPsu_EpStartTransfer(InstancePtr, Ept, &Slot->Trb);
 	}
 }
 /** @} */
@@ -43,6 +43,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   sg  06/06/16 First release
+* 1.2   esd 10/18/26 Handle XferInProgress for queued transfers and return
+*                    processed events to the core in one register write
 *
 * </pre>
 *
@@ -95,6 +97,7 @@ void XUsbPsu_EpInterrupt(struct XUsbPsu *InstancePtr,
 	/* Handle other end point events */
 	switch (Event->Endpoint_Event) {
 		case XUSBPSU_DEPEVT_XFERCOMPLETE:
+		case XUSBPSU_DEPEVT_XFERINPROGRESS:
 			XUsbPsu_EpXferComplete(InstancePtr, Event);
 			break;
 
@@ -362,6 +365,7 @@ void XUsbPsu_EventBufferHandler(struct XUsbPsu *InstancePtr)
 {
 	struct XUsbPsu_EvtBuffer *Evt;
 	union XUsbPsu_Event Event = {0};
+	u32 Processed = 0U;
 
 	Evt = &InstancePtr->Evt;
 
@@ -378,7 +382,12 @@ void XUsbPsu_EventBufferHandler(struct XUsbPsu *InstancePtr)
 
 		Evt->Offset = (Evt->Offset + 4U) % XUSBPSU_EVENT_BUFFERS_SIZE;
 		Evt->Count -= 4;
-		XUsbPsu_WriteReg(InstancePtr, XUSBPSU_GEVNTCOUNT(0), 4U);
+		Processed += 4U;
+	}
+
+	/* Hand all processed events back to the core at once */
+	if (Processed != 0U) {
+		XUsbPsu_WriteReg(InstancePtr, XUSBPSU_GEVNTCOUNT(0), Processed);
 	}
 
 	Evt->Flags &= ~XUSBPSU_EVENT_PENDING;
@@ -0,0 +1,279 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_chain_example.c
+*
+* This file contains the example using XZDma driver to stream transfers
+* through a descriptor chain on ZDMA device in polled mode.
+*
+* Transfers are appended in small batches with XZDma_ChainSubmit() while the
+* channel is running. XZDma_ChainPoll() retires the finished ones into the
+* completion ring, from which XZDma_ChainGetDone() returns them in order with
+* their sequence numbers. The chain is stopped with XZDma_ChainReset() at
+* the end. In interrupt mode XZDma_IntrHandler() calls XZDma_ChainPoll().
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.2   esd     10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xzdma.h"
+#include "xparameters.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+
+/************************** Function Prototypes ******************************/
+
+int XZDma_ChainExample(u16 DeviceId);
+static int CheckDone(XZDma_ChainDone *DonePtr, u32 Seq);
+
+/************************** Constant Definitions ******************************/
+
+/*
+ * The following constants map to the XPAR parameters created in the
+ * xparameters.h file. They are defined here such that a user can easily
+ * change all the needed parameters in one place.
+ */
+#define ZDMA_DEVICE_ID		XPAR_XZDMA_0_DEVICE_ID /* ZDMA device Id */
+
+#define NUM_TRANSFERS		32	/**< Transfers streamed in total */
+#define BATCH_SIZE		4	/**< Transfers per XZDma_ChainSubmit */
+#define TRANSFER_WORDS		64	/**< Size of a transfer in words */
+#define NUM_DSCR_PAIRS		8	/**< Descriptor pairs in the pool */
+#define RING_SIZE		8	/**< Entries of the completion ring */
+#define TESTDATA		0xABCD0000 /**< Test data */
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Variable Definitions *****************************/
+
+XZDma ZDma;		/**<Instance of the ZDMA Device */
+u32 SrcBuf[NUM_TRANSFERS][TRANSFER_WORDS] __attribute__ ((aligned (64)));
+u32 DstBuf[NUM_TRANSFERS][TRANSFER_WORDS] __attribute__ ((aligned (64)));
+/* 64 bytes per descriptor pair, source and destination descriptor */
+u8 DscrMem[NUM_DSCR_PAIRS * 64] __attribute__ ((aligned (64)));
+XZDma_ChainDone DoneRing[RING_SIZE];
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	/* Run the descriptor chain example */
+	Status = XZDma_ChainExample((u16)ZDMA_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("ZDMA Chain Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran ZDMA Chain Example\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function streams NUM_TRANSFERS transfers through a descriptor chain
+* on the ZDMA device and checks that they complete in order with the right
+* data.
+*
+* @param	DeviceId is the XPAR_<ZDMA Instance>_DEVICE_ID value from
+*		xparameters.h.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The pool holds fewer descriptor pairs than there are
+*		transfers, so descriptors are recycled while the chain runs.
+*
+******************************************************************************/
+int XZDma_ChainExample(u16 DeviceId)
+{
+	int Status;
+	XZDma_Config *Config;
+	XZDma_DataConfig Configur; /**< Configuration values */
+	XZDma_Transfer Data[BATCH_SIZE];
+	XZDma_ChainDone Done;
+	u32 Submitted = 0;
+	u32 Completed = 0;
+	u32 Seq;
+	u32 Index;
+	u32 Word;
+	u32 Value;
+
+	/*
+	 * Initialize the ZDMA driver so that it's ready to use.
+	 * Look up the configuration in the config table,
+	 * then initialize it.
+	 */
+	Config = XZDma_LookupConfig(DeviceId);
+	if (NULL == Config) {
+		return XST_FAILURE;
+	}
+
+	Status = XZDma_CfgInitialize(&ZDma, Config, Config->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/* Filling the buffers for data transfer */
+	Value = TESTDATA;
+	for (Index = 0; Index < NUM_TRANSFERS; Index++) {
+		for (Word = 0; Word < TRANSFER_WORDS; Word++) {
+			SrcBuf[Index][Word] = Value++;
+			DstBuf[Index][Word] = 0;
+		}
+	}
+	Xil_DCacheFlushRange((INTPTR)SrcBuf, sizeof(SrcBuf));
+	Xil_DCacheFlushRange((INTPTR)DstBuf, sizeof(DstBuf));
+
+	/* Descriptor chains run in scatter gather mode */
+	Status = XZDma_SetMode(&ZDma, TRUE, XZDMA_NORMAL_MODE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * All the configurations are kept as is which was got
+	 * through XZDma_GetChDataConfig and only over fetch is disabled
+	 */
+	XZDma_GetChDataConfig(&ZDma, &Configur);
+	Configur.OverFetch = 0;
+	XZDma_SetChDataConfig(&ZDma, &Configur);
+
+	/* Allocated memory starting address should be 64 byte aligned */
+	Status = XZDma_ChainInitialize(&ZDma, (UINTPTR)DscrMem,
+				sizeof(DscrMem), DoneRing, RING_SIZE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	while (Completed < NUM_TRANSFERS) {
+		/* Append a batch whenever the pool has room for it */
+		if ((Submitted < NUM_TRANSFERS) &&
+			(XZDma_ChainGetFreeCnt(&ZDma) >= BATCH_SIZE)) {
+			for (Index = 0; Index < BATCH_SIZE; Index++) {
+				Data[Index].SrcAddr =
+				(UINTPTR)SrcBuf[Submitted + Index];
+				Data[Index].DstAddr =
+				(UINTPTR)DstBuf[Submitted + Index];
+				Data[Index].Size = TRANSFER_WORDS * 4;
+				Data[Index].SrcCoherent = 0;
+				Data[Index].DstCoherent = 0;
+				Data[Index].Pause = 0;
+			}
+
+			Status = XZDma_ChainSubmit(&ZDma, Data, BATCH_SIZE,
+							&Seq);
+			if ((Status != XST_SUCCESS) || (Seq != Submitted)) {
+				XZDma_ChainReset(&ZDma);
+				return XST_FAILURE;
+			}
+			Submitted += BATCH_SIZE;
+		}
+
+		/* Retire finished transfers into the completion ring */
+		(void)XZDma_ChainPoll(&ZDma);
+
+		while (XZDma_ChainGetDone(&ZDma, &Done) == XST_SUCCESS) {
+			if (CheckDone(&Done, Completed) != XST_SUCCESS) {
+				XZDma_ChainReset(&ZDma);
+				return XST_FAILURE;
+			}
+			Completed++;
+		}
+	}
+
+	/* Stop the chain and give all the descriptors back to the pool */
+	XZDma_ChainReset(&ZDma);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks a finished transfer returned by XZDma_ChainGetDone().
+*
+* @param	DonePtr is a pointer to the finished transfer.
+* @param	Seq is the sequence number the transfer must have, transfers
+*		complete in the order they were submitted.
+*
+* @return
+*		- XST_SUCCESS if the transfer and its data are correct.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int CheckDone(XZDma_ChainDone *DonePtr, u32 Seq)
+{
+	u32 Word;
+
+	if ((DonePtr->Seq != Seq) ||
+		(DonePtr->DstAddr != (UINTPTR)DstBuf[Seq]) ||
+		(DonePtr->Size != (TRANSFER_WORDS * 4))) {
+		return XST_FAILURE;
+	}
+
+	Xil_DCacheInvalidateRange((INTPTR)DstBuf[Seq],
+				TRANSFER_WORDS * 4);
+	for (Word = 0; Word < TRANSFER_WORDS; Word++) {
+		if (SrcBuf[Seq][Word] != DstBuf[Seq][Word]) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
@@ -52,6 +52,8 @@
 *                        scatter gather mode data transfer and corrected
 *                        XZDma_SetChDataConfig API to set over fetch and
 *                        src issue parameters correctly.
+* 1.2   esd    10/18/26  Descriptor chain is marked not ready on
+*                        initialization.
 * </pre>
 *
 ******************************************************************************/
@@ -126,6 +128,8 @@ s32 XZDma_CfgInitialize(XZDma *InstancePtr, XZDma_Config *CfgPtr,
 	InstancePtr->Mode = XZDMA_NORMAL_MODE;
 	InstancePtr->IntrMask = 0x00U;
 	InstancePtr->ChannelState = XZDMA_IDLE;
+	InstancePtr->Chain.IsReady = FALSE;
+	InstancePtr->Chain.IsStarted = FALSE;
 
 	/*
 	 * Set all handlers to stub values, let user configure this
@@ -76,6 +76,27 @@
 * functions by using XZDma_SetCallBack API. In this version Descriptor done
 * option is disabled.
 *
+* <b> Descriptor chains </b>
+*
+* XZDma_Start() programs a fresh descriptor list for every batch, so a new
+* batch can only be started once the channel is idle. For continuous
+* streaming the driver can instead manage a pool of linked list descriptors
+* with XZDma_ChainInitialize(). Descriptors are used as a ring and recycled
+* in order as transfers complete. XZDma_ChainSubmit() appends transfers to
+* the running chain: the last descriptor of the chain always pauses the
+* channel and points at the next free descriptor, so appending only turns
+* the old tail into a next valid descriptor and resumes the channel through
+* XZDma_Resume() if it had already paused on it.
+* Finished transfers are collected by XZDma_ChainPoll() into a completion
+* ring supplied by the user and read back with XZDma_ChainGetDone().
+* XZDma_ChainPoll() is called from XZDma_IntrHandler() on destination
+* descriptor done and pause interrupts when those are enabled, otherwise
+* it has to be called by the user at least once per 255 completed
+* transfers, the width of the destination interrupt account counter.
+* XZDma_ChainSubmit() and XZDma_ChainGetDone() mask the channel interrupts
+* while they update the chain. A user calling XZDma_ChainPoll() from thread
+* context must not let it preempt, or be preempted by, those calls.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -115,6 +136,10 @@
 *                        scatter gather mode data transfer and corrected
 *                        XZDma_SetChDataConfig API to set over fetch and
 *                        src issue parameters correctly.
+* 1.2   esd    10/18/26  Added descriptor chains, XZDma_ChainInitialize,
+*                        XZDma_ChainSubmit, XZDma_ChainPoll,
+*                        XZDma_ChainGetDone and XZDma_ChainReset APIs, to
+*                        append transfers to a running linked list.
 
 * </pre>
 *
@@ -284,6 +309,51 @@ typedef struct {
 	u8 DmaType;		/**< Type of DMA */
 } XZDma_Config;
 
+/******************************************************************************/
+/**
+*
+* This typedef reports one finished transfer of a descriptor chain.
+*/
+typedef struct {
+	u32 Seq;		/**< Sequence number given by
+				  *  XZDma_ChainSubmit */
+	UINTPTR SrcAddr;	/**< Source address */
+	UINTPTR DstAddr;	/**< Destination address */
+	u32 Size;		/**< Size of the data transferred */
+} XZDma_ChainDone;
+
+/******************************************************************************/
+/**
+*
+* This typedef contains the descriptor pool and completion ring of a
+* descriptor chain. Descriptor pairs are used in order, pairs between
+* HwHead and HwTail are owned by the hardware and pairs from FreeHead on are
+* free. One pair is always kept free so the tail can point at it.
+*/
+typedef struct {
+	XZDma_LlDscr *SrcDscr;	/**< Source descriptors of the pool */
+	XZDma_LlDscr *DstDscr;	/**< Destination descriptors of the pool */
+	u32 DscrCount;		/**< Number of descriptor pairs in the pool */
+	u32 FreeHead;		/**< Next free descriptor pair */
+	u32 FreeCnt;		/**< Number of free descriptor pairs */
+	u32 HwHead;		/**< Oldest descriptor pair given to the
+				  *  hardware */
+	u32 HwTail;		/**< Last descriptor pair given to the
+				  *  hardware, tail of the chain */
+	u32 HwCnt;		/**< Descriptor pairs given to the hardware
+				  *  and not reported yet */
+	u32 HwDoneCnt;		/**< Descriptor pairs completed by the
+				  *  hardware and not reported yet */
+	u32 Seq;		/**< Sequence number of next transfer */
+	XZDma_ChainDone *DoneRing;	/**< Completion ring */
+	u32 RingSize;		/**< Number of entries of completion ring */
+	u32 RingHead;		/**< Oldest entry of completion ring */
+	u32 RingCnt;		/**< Valid entries in completion ring */
+	u32 ResumeCnt;		/**< Number of times the chain was resumed */
+	u8 IsReady;		/**< Pool is initialized */
+	u8 IsStarted;		/**< Channel is running on the chain */
+} XZDma_Chain;
+
 /******************************************************************************/
 /**
 *
@@ -315,6 +385,7 @@ typedef struct {
 	XZDma_DataConfig DataConfig;	/**< Current configurations */
 	XZDma_DscrConfig DscrConfig;	/**< Current configurations */
 	XZDmaState ChannelState;	 /**< ZDMA channel is busy */
+	XZDma_Chain Chain;		/**< Descriptor chain */
 
 } XZDma;
 
@@ -645,6 +716,24 @@ typedef struct {
 	XZDma_WriteReg((InstancePtr)->Config.BaseAddress,\
 		(XZDMA_CH_CTRL2_OFFSET), (XZDMA_CH_CTRL2_DIS_MASK))
 
+/*****************************************************************************/
+/**
+*
+* This function returns the number of transfers which can be appended to the
+* descriptor chain without waiting for completions.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+*
+* @return	Number of free descriptor pairs of the chain.
+*
+* @note
+*		C-style signature:
+*		u32 XZDma_ChainGetFreeCnt(XZDma *InstancePtr)
+*
+******************************************************************************/
+#define XZDma_ChainGetFreeCnt(InstancePtr) \
+	((InstancePtr)->Chain.FreeCnt)
+
 /************************ Prototypes of functions **************************/
 
 XZDma_Config *XZDma_LookupConfig(u16 DeviceId);
@@ -664,6 +753,14 @@ void XZDma_Resume(XZDma *InstancePtr);
 void XZDma_Reset(XZDma *InstancePtr);
 XZDmaState XZDma_ChannelState(XZDma *InstancePtr);
 
+s32 XZDma_ChainInitialize(XZDma *InstancePtr, UINTPTR Dscr_MemPtr,
+		u32 NoOfBytes, XZDma_ChainDone *DoneRing, u32 RingSize);
+s32 XZDma_ChainSubmit(XZDma *InstancePtr, XZDma_Transfer *Data, u32 Num,
+							u32 *SeqPtr);
+u32 XZDma_ChainPoll(XZDma *InstancePtr);
+s32 XZDma_ChainGetDone(XZDma *InstancePtr, XZDma_ChainDone *DonePtr);
+void XZDma_ChainReset(XZDma *InstancePtr);
+
 s32 XZDma_SelfTest(XZDma *InstancePtr);
 
 void XZDma_IntrHandler(void *Instance);
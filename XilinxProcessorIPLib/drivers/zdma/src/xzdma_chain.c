@@ -0,0 +1,622 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_chain.c
+* @addtogroup zdma_v1_0
+* @{
+*
+* This file contains the descriptor chain functions of Xilinx ZDMA core.
+* A chain keeps the channel running on a pool of linked list descriptors so
+* transfers can be appended while earlier ones are still in progress.
+* Please see xzdma.h for more details of the driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.2   esd    10/18/26  First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xzdma.h"
+
+/************************** Constant Definitions *****************************/
+
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/* Index of the descriptor pair following Index in the pool */
+#define XZDma_ChainNext(ChainPtr, Index) \
+	((((Index) + 1U) == (ChainPtr)->DscrCount) ? 0U : ((Index) + 1U))
+
+/************************** Function Prototypes ******************************/
+
+static void XZDma_ChainFill(XZDma_Chain *ChainPtr, u32 Index,
+				XZDma_Transfer *Data, u8 IsLast);
+static void XZDma_ChainSetStart(XZDma *InstancePtr, u32 Index);
+static void XZDma_ChainKick(XZDma *InstancePtr);
+static u32 XZDma_ChainMaskIntr(XZDma *InstancePtr);
+static void XZDma_ChainUnmaskIntr(XZDma *InstancePtr, u32 Mask);
+
+/************************** Variable Definitions *****************************/
+
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function sets up a descriptor chain on the memory allocated by the
+* user. The memory is split into source and destination linked list
+* descriptors the same way as XZDma_CreateBDList() does, and the descriptor
+* pairs are handed out and recycled in order by XZDma_ChainSubmit() and
+* XZDma_ChainPoll().
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+* @param	Dscr_MemPtr is a pointer to the allocated memory for the
+*		descriptors. It should be aligned to 64 bytes.
+* @param	NoOfBytes specifies the number of bytes allocated for
+*		descriptors, 64 bytes per descriptor pair.
+* @param	DoneRing is a pointer to an array of RingSize entries in which
+*		finished transfers are reported.
+* @param	RingSize is the number of entries of DoneRing.
+*
+* @return
+*		- XST_SUCCESS if the chain is initialized.
+*		- XST_FAILURE if the memory holds less than two descriptor
+*		pairs, one pair is always kept free.
+*
+* @note		The channel should be configured in scatter gather mode with
+*		XZDma_SetMode() and be idle. XZDma_Start() must not be used
+*		on the channel while the chain is running.
+*
+******************************************************************************/
+s32 XZDma_ChainInitialize(XZDma *InstancePtr, UINTPTR Dscr_MemPtr,
+		u32 NoOfBytes, XZDma_ChainDone *DoneRing, u32 RingSize)
+{
+	XZDma_Chain *ChainPtr;
+	u32 Count;
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+				(u32)(XIL_COMPONENT_IS_READY));
+	Xil_AssertNonvoid(InstancePtr->IsSgDma == TRUE);
+	Xil_AssertNonvoid(InstancePtr->ChannelState == XZDMA_IDLE);
+	Xil_AssertNonvoid(Dscr_MemPtr != 0x00);
+	Xil_AssertNonvoid((Dscr_MemPtr & 0x3FU) == 0x00U);
+	Xil_AssertNonvoid(DoneRing != NULL);
+	Xil_AssertNonvoid(RingSize != 0x00U);
+
+	ChainPtr = &InstancePtr->Chain;
+	Count = (NoOfBytes >> 1) / sizeof(XZDma_LlDscr);
+	if (Count < 2U) {
+		Status = XST_FAILURE;
+		goto End;
+	}
+
+	InstancePtr->Descriptor.DscrType = XZDMA_LINKEDLIST;
+	InstancePtr->Descriptor.DscrCount = Count;
+	InstancePtr->Descriptor.SrcDscrPtr = (void *)Dscr_MemPtr;
+	InstancePtr->Descriptor.DstDscrPtr =
+		(void *)(Dscr_MemPtr + (sizeof(XZDma_LlDscr) * Count));
+
+	ChainPtr->SrcDscr =
+		(XZDma_LlDscr *)InstancePtr->Descriptor.SrcDscrPtr;
+	ChainPtr->DstDscr =
+		(XZDma_LlDscr *)InstancePtr->Descriptor.DstDscrPtr;
+	ChainPtr->DscrCount = Count;
+	ChainPtr->DoneRing = DoneRing;
+	ChainPtr->RingSize = RingSize;
+	ChainPtr->IsReady = TRUE;
+	ChainPtr->IsStarted = FALSE;
+	XZDma_ChainReset(InstancePtr);
+
+	Xil_DCacheInvalidateRange((INTPTR)Dscr_MemPtr, NoOfBytes);
+	Status = XST_SUCCESS;
+
+End:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function appends transfers to the descriptor chain. If the chain is
+* not running yet the channel is started on the first transfer, otherwise
+* the transfers are linked behind the current tail and the channel is
+* resumed if it has already paused on that tail.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+* @param	Data is a pointer to an array of XZDma_Transfer structures
+*		describing the transfers to be appended.
+* @param	Num specifies number of array elements of Data pointer.
+* @param	SeqPtr, if not NULL, receives the sequence number of the first
+*		transfer. The following transfers are numbered consecutively
+*		and the numbers are reported back in XZDma_ChainDone.
+*
+* @return
+*		- XST_SUCCESS if the transfers are queued.
+*		- XST_FAILURE if there are not enough free descriptors, in
+*		which case nothing is queued.
+*
+* @note		The Pause field of the transfers is ignored, the chain pauses
+*		only at its tail. The channel interrupts are masked while the
+*		pool is updated, as XZDma_ChainPoll() changes it from the
+*		interrupt handler.
+*
+******************************************************************************/
+s32 XZDma_ChainSubmit(XZDma *InstancePtr, XZDma_Transfer *Data, u32 Num,
+							u32 *SeqPtr)
+{
+	XZDma_Chain *ChainPtr;
+	XZDma_LlDscr *TailPtr;
+	u32 Index;
+	u32 First;
+	u32 Count;
+	u32 IntrMask;
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(Data != NULL);
+	Xil_AssertNonvoid(Num != 0x00U);
+	Xil_AssertNonvoid(InstancePtr->Chain.IsReady == TRUE);
+
+	ChainPtr = &InstancePtr->Chain;
+	IntrMask = XZDma_ChainMaskIntr(InstancePtr);
+	if (Num > ChainPtr->FreeCnt) {
+		Status = XST_FAILURE;
+		goto End;
+	}
+
+	/*
+	 * Fill the new descriptors first, the last one pauses the channel
+	 * and points at the next free pair.
+	 */
+	First = ChainPtr->FreeHead;
+	Index = First;
+	for (Count = 0x00U; Count < Num; Count++) {
+		XZDma_ChainFill(ChainPtr, Index, &Data[Count],
+				(Count == (Num - 1U)) ? TRUE : FALSE);
+		if (Count != (Num - 1U)) {
+			Index = XZDma_ChainNext(ChainPtr, Index);
+		}
+	}
+
+	if (SeqPtr != NULL) {
+		*SeqPtr = ChainPtr->Seq;
+	}
+	ChainPtr->Seq += Num;
+	ChainPtr->FreeHead = XZDma_ChainNext(ChainPtr, Index);
+	ChainPtr->FreeCnt -= Num;
+
+	if (ChainPtr->IsStarted == TRUE) {
+		/*
+		 * Old tail already points at First, turning its pause into
+		 * next valid links the new transfers into the chain.
+		 */
+		TailPtr = &ChainPtr->SrcDscr[ChainPtr->HwTail];
+		TailPtr->Cntl &= ~XZDMA_WORD3_CMD_MASK;
+		Xil_DCacheFlushRange((UINTPTR)TailPtr, sizeof(XZDma_LlDscr));
+
+		ChainPtr->HwTail = Index;
+		ChainPtr->HwCnt += Num;
+		XZDma_ChainKick(InstancePtr);
+	}
+	else {
+		ChainPtr->HwHead = First;
+		ChainPtr->HwTail = Index;
+		ChainPtr->HwCnt += Num;
+		ChainPtr->IsStarted = TRUE;
+
+		XZDma_ChainSetStart(InstancePtr, First);
+		XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_IEN_OFFSET,
+			(InstancePtr->IntrMask & XZDMA_IXR_ALL_INTR_MASK));
+		InstancePtr->ChannelState = XZDMA_BUSY;
+		XZDma_EnableCh(InstancePtr);
+	}
+	Status = XST_SUCCESS;
+
+End:
+	XZDma_ChainUnmaskIntr(InstancePtr, IntrMask);
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function collects the transfers finished by the hardware into the
+* completion ring and returns their descriptors to the pool. It also resumes
+* the channel when it paused on a descriptor which is no longer the tail of
+* the chain.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+*
+* @return	Number of transfers added to the completion ring.
+*
+* @note		Called from XZDma_IntrHandler() on destination descriptor
+*		done and pause interrupts. Without interrupts it has to be
+*		called at least once per 255 finished transfers. Completions
+*		which do not fit in the completion ring are kept and reported
+*		by a later call.
+*
+******************************************************************************/
+u32 XZDma_ChainPoll(XZDma *InstancePtr)
+{
+	XZDma_Chain *ChainPtr;
+	XZDma_ChainDone *DonePtr;
+	u32 Index;
+	u32 Count = 0x00U;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->Chain.IsReady == TRUE);
+
+	ChainPtr = &InstancePtr->Chain;
+	if (ChainPtr->IsStarted != TRUE) {
+		goto End;
+	}
+
+	/*
+	 * Every destination descriptor has its interrupt bit set, so the
+	 * clear on read destination account counter tells how many
+	 * descriptor pairs completed since the last read.
+	 */
+	ChainPtr->HwDoneCnt += XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+				XZDMA_CH_IRQ_DST_ACCT_OFFSET) &
+				XZDMA_CH_IRQ_ACCT_MASK;
+	if (ChainPtr->HwDoneCnt > ChainPtr->HwCnt) {
+		ChainPtr->HwDoneCnt = ChainPtr->HwCnt;
+	}
+
+	while ((ChainPtr->HwDoneCnt != 0x00U) &&
+			(ChainPtr->RingCnt < ChainPtr->RingSize)) {
+		Index = ChainPtr->RingHead + ChainPtr->RingCnt;
+		if (Index >= ChainPtr->RingSize) {
+			Index -= ChainPtr->RingSize;
+		}
+		DonePtr = &ChainPtr->DoneRing[Index];
+		DonePtr->Seq = ChainPtr->Seq - ChainPtr->HwCnt;
+		DonePtr->SrcAddr =
+			(UINTPTR)ChainPtr->SrcDscr[ChainPtr->HwHead].Address;
+		DonePtr->DstAddr =
+			(UINTPTR)ChainPtr->DstDscr[ChainPtr->HwHead].Address;
+		DonePtr->Size = ChainPtr->SrcDscr[ChainPtr->HwHead].Size;
+		ChainPtr->RingCnt++;
+
+		ChainPtr->HwHead = XZDma_ChainNext(ChainPtr, ChainPtr->HwHead);
+		ChainPtr->HwCnt--;
+		ChainPtr->HwDoneCnt--;
+		ChainPtr->FreeCnt++;
+		Count++;
+	}
+
+	XZDma_ChainKick(InstancePtr);
+
+End:
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the oldest entry of the completion ring.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+* @param	DonePtr is a pointer to the XZDma_ChainDone structure which
+*		is filled with the finished transfer.
+*
+* @return
+*		- XST_SUCCESS if a finished transfer is returned.
+*		- XST_FAILURE if the completion ring is empty.
+*
+* @note		The completion ring is only filled by XZDma_ChainPoll(). The
+*		channel interrupts are masked while an entry is taken out.
+*
+******************************************************************************/
+s32 XZDma_ChainGetDone(XZDma *InstancePtr, XZDma_ChainDone *DonePtr)
+{
+	XZDma_Chain *ChainPtr;
+	u32 IntrMask;
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(DonePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->Chain.IsReady == TRUE);
+
+	ChainPtr = &InstancePtr->Chain;
+	IntrMask = XZDma_ChainMaskIntr(InstancePtr);
+	if (ChainPtr->RingCnt == 0x00U) {
+		Status = XST_FAILURE;
+	}
+	else {
+		*DonePtr = ChainPtr->DoneRing[ChainPtr->RingHead];
+		ChainPtr->RingHead++;
+		if (ChainPtr->RingHead == ChainPtr->RingSize) {
+			ChainPtr->RingHead = 0x00U;
+		}
+		ChainPtr->RingCnt--;
+		Status = XST_SUCCESS;
+	}
+	XZDma_ChainUnmaskIntr(InstancePtr, IntrMask);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function stops the channel and returns all the descriptors of the
+* chain to the pool. Transfers which were not reported are dropped.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+*
+* @return	None.
+*
+* @note		Used to recover from an error interrupt or to stop streaming.
+*		The channel is left idle so XZDma_Reset() or XZDma_Start()
+*		may be used afterwards.
+*
+******************************************************************************/
+void XZDma_ChainReset(XZDma *InstancePtr)
+{
+	XZDma_Chain *ChainPtr;
+
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->Chain.IsReady == TRUE);
+
+	ChainPtr = &InstancePtr->Chain;
+	if (ChainPtr->IsStarted == TRUE) {
+		XZDma_DisableCh(InstancePtr);
+		InstancePtr->ChannelState = XZDMA_IDLE;
+	}
+
+	/* Reading the account counters clears them */
+	(void)XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+				XZDMA_CH_IRQ_SRC_ACCT_OFFSET);
+	(void)XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+				XZDMA_CH_IRQ_DST_ACCT_OFFSET);
+
+	ChainPtr->FreeHead = 0x00U;
+	ChainPtr->FreeCnt = ChainPtr->DscrCount - 1U;
+	ChainPtr->HwHead = 0x00U;
+	ChainPtr->HwTail = 0x00U;
+	ChainPtr->HwCnt = 0x00U;
+	ChainPtr->HwDoneCnt = 0x00U;
+	ChainPtr->RingHead = 0x00U;
+	ChainPtr->RingCnt = 0x00U;
+	ChainPtr->IsStarted = FALSE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function fills the source and destination descriptors of one
+* descriptor pair of the chain.
+*
+* @param	ChainPtr is a pointer to the descriptor chain.
+* @param	Index is the descriptor pair to be filled.
+* @param	Data is a pointer to the XZDma_Transfer structure.
+* @param	IsLast specifies whether the pair becomes the tail of the
+*		chain, in which case the channel pauses after it.
+*
+* @return	None.
+*
+* @note		Both descriptors always point at the next pair, the tail is
+*		linked when the next transfers are appended.
+*
+******************************************************************************/
+static void XZDma_ChainFill(XZDma_Chain *ChainPtr, u32 Index,
+				XZDma_Transfer *Data, u8 IsLast)
+{
+	XZDma_LlDscr *SrcDscrPtr = &ChainPtr->SrcDscr[Index];
+	XZDma_LlDscr *DstDscrPtr = &ChainPtr->DstDscr[Index];
+	u32 Next = XZDma_ChainNext(ChainPtr, Index);
+	u32 Value;
+
+	if (IsLast == TRUE) {
+		Value = XZDMA_WORD3_CMD_PAUSE_MASK;
+	}
+	else {
+		Value = XZDMA_WORD3_CMD_NXTVALID_MASK;
+	}
+	if (Data->SrcCoherent == TRUE) {
+		Value |= XZDMA_WORD3_COHRNT_MASK;
+	}
+	SrcDscrPtr->Address = (u64)Data->SrcAddr;
+	SrcDscrPtr->Size = Data->Size & XZDMA_WORD2_SIZE_MASK;
+	SrcDscrPtr->Cntl = Value;
+	SrcDscrPtr->NextDscr = (u64)(UINTPTR)&ChainPtr->SrcDscr[Next];
+	SrcDscrPtr->Reserved = 0U;
+	Xil_DCacheFlushRange((UINTPTR)SrcDscrPtr, sizeof(XZDma_LlDscr));
+
+	/* Completion of each pair is counted on the destination side */
+	Value = XZDMA_WORD3_INTR_MASK;
+	if (Data->DstCoherent == TRUE) {
+		Value |= XZDMA_WORD3_COHRNT_MASK;
+	}
+	DstDscrPtr->Address = (u64)Data->DstAddr;
+	DstDscrPtr->Size = Data->Size & XZDMA_WORD2_SIZE_MASK;
+	DstDscrPtr->Cntl = Value;
+	DstDscrPtr->NextDscr = (u64)(UINTPTR)&ChainPtr->DstDscr[Next];
+	DstDscrPtr->Reserved = 0U;
+	Xil_DCacheFlushRange((UINTPTR)DstDscrPtr, sizeof(XZDma_LlDscr));
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function programs the source and destination start descriptor
+* addresses of the channel.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+* @param	Index is the descriptor pair the channel starts on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_ChainSetStart(XZDma *InstancePtr, u32 Index)
+{
+	UINTPTR SrcAddr = (UINTPTR)&InstancePtr->Chain.SrcDscr[Index];
+	UINTPTR DstAddr = (UINTPTR)&InstancePtr->Chain.DstDscr[Index];
+
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_SRC_START_LSB_OFFSET,
+		(SrcAddr & XZDMA_WORD0_LSB_MASK));
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_SRC_START_MSB_OFFSET,
+		(((u64)SrcAddr >> XZDMA_WORD1_MSB_SHIFT) &
+					XZDMA_WORD1_MSB_MASK));
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_DST_START_LSB_OFFSET,
+		(DstAddr & XZDMA_WORD0_LSB_MASK));
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+		XZDMA_CH_DST_START_MSB_OFFSET,
+		(((u64)DstAddr >> XZDMA_WORD1_MSB_SHIFT) &
+					XZDMA_WORD1_MSB_MASK));
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function resumes the channel if it has paused on a descriptor
+* which was the tail of the chain when it was fetched but has since been
+* linked to newer transfers.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+*
+* @return	None.
+*
+* @note		A channel paused on the current tail is left paused, the
+*		next descriptor has not been filled yet.
+*
+******************************************************************************/
+static void XZDma_ChainKick(XZDma *InstancePtr)
+{
+	XZDma_Chain *ChainPtr = &InstancePtr->Chain;
+	u64 CurDscr;
+	u32 Value;
+
+	Value = XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_STS_OFFSET) & XZDMA_STS_ALL_MASK;
+	if ((Value != XZDMA_STS_PAUSE_MASK) ||
+			(ChainPtr->HwCnt == ChainPtr->HwDoneCnt)) {
+		goto End;
+	}
+
+	CurDscr = (u64)XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_SRC_CUR_DSCR_LSB_OFFSET);
+	CurDscr |= ((u64)(XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_SRC_CUR_DSCR_MSB_OFFSET) &
+			XZDMA_WORD1_MSB_MASK)) << XZDMA_WORD1_MSB_SHIFT;
+	if (CurDscr ==
+		(u64)(UINTPTR)&ChainPtr->SrcDscr[ChainPtr->HwTail]) {
+		goto End;
+	}
+
+	InstancePtr->ChannelState = XZDMA_PAUSE;
+	XZDma_Resume(InstancePtr);
+	ChainPtr->ResumeCnt++;
+
+End:
+	return;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function masks all the interrupts of the channel, so the chain can be
+* updated without XZDma_ChainPoll() running from the interrupt handler.
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+*
+* @return	The interrupts which were enabled, to be passed to
+*		XZDma_ChainUnmaskIntr().
+*
+* @note		Interrupts raised in between stay pending in the status
+*		register and are taken once they are unmasked.
+*
+******************************************************************************/
+static u32 XZDma_ChainMaskIntr(XZDma *InstancePtr)
+{
+	u32 Mask;
+
+	Mask = (~XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_IMR_OFFSET)) & XZDMA_IXR_ALL_INTR_MASK;
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress, XZDMA_CH_IDS_OFFSET,
+			XZDMA_IXR_ALL_INTR_MASK);
+	/*
+	 * Read IMR back so the write has reached the channel before the
+	 * chain is touched, otherwise an interrupt could still be raised
+	 */
+	(void)XZDma_ReadReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_IMR_OFFSET);
+
+	return Mask;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function enables again the interrupts masked by
+* XZDma_ChainMaskIntr().
+*
+* @param	InstancePtr is a pointer to the XZDma instance.
+* @param	Mask is the value returned by XZDma_ChainMaskIntr().
+*
+* @return	None.
+*
+* @note		Interrupts enabled while they were masked stay enabled.
+*
+******************************************************************************/
+static void XZDma_ChainUnmaskIntr(XZDma *InstancePtr, u32 Mask)
+{
+	XZDma_WriteReg(InstancePtr->Config.BaseAddress, XZDMA_CH_IEN_OFFSET,
+			Mask);
+}
+/** @} */
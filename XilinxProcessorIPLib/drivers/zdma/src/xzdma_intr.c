@@ -45,6 +45,8 @@
 * Ver   Who     Date     Changes
 * ----- ------  -------- ------------------------------------------------------
 * 1.0   vns     2/27/15  First release
+* 1.2   esd    10/18/26  Descriptor done and pause interrupts of a running
+*                        descriptor chain are handled by XZDma_ChainPoll.
 * </pre>
 *
 ******************************************************************************/
@@ -82,6 +84,9 @@
 * system. Application beyond this driver is also responsible for providing
 * callbacks to handle interrupts and installing the callbacks using
 * XZDma_SetCallBack() during initialization phase. .
+* When a descriptor chain is running, destination descriptor done and pause
+* interrupts update the chain through XZDma_ChainPoll() and call the done
+* callback.
 *
 * @param	Instance is a pointer to the XZDma instance to be worked on.
 *
@@ -94,6 +99,7 @@ void XZDma_IntrHandler(void *Instance)
 {
 	u32 PendingIntr;
 	u32 ErrorStatus;
+	u32 ChainIntr;
 	XZDma *InstancePtr = NULL;
 	InstancePtr = (XZDma *)((void *)Instance);
 
@@ -104,6 +110,19 @@ void XZDma_IntrHandler(void *Instance)
 	PendingIntr = (u32)(XZDma_IntrGetStatus(InstancePtr));
 	PendingIntr &= (~XZDma_GetIntrMask(InstancePtr));
 
+	/*
+	 * Descriptor chain has completed descriptors or paused on its tail,
+	 * pause is not an error in that case
+	 */
+	ChainIntr = PendingIntr & (XZDMA_IXR_DST_DSCR_DONE_MASK |
+					XZDMA_IXR_DMA_PAUSE_MASK);
+	if ((InstancePtr->Chain.IsStarted == TRUE) && (ChainIntr != 0U)) {
+		XZDma_IntrClear(InstancePtr, ChainIntr);
+		PendingIntr &= (~ChainIntr);
+		(void)XZDma_ChainPoll(InstancePtr);
+		InstancePtr->DoneHandler(InstancePtr->DoneRef);
+	}
+
 	/* ZDMA transfer has completed */
 	ErrorStatus = (PendingIntr) & (XZDMA_IXR_DMA_DONE_MASK);
 	if ((ErrorStatus) != 0U) {
@@ -0,0 +1,678 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_dma.c
+*
+* Contains the ZDMA backed memcpy/memset service. See xil_dma.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.06  esd  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xil_dma.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+/* ZDMA channel registers, see xzdma_hw.h */
+#define XIL_DMA_ISR_OFFSET		0x100U
+#define XIL_DMA_IEN_OFFSET		0x108U
+#define XIL_DMA_IDS_OFFSET		0x10CU
+#define XIL_DMA_CTRL0_OFFSET		0x110U
+#define XIL_DMA_STS_OFFSET		0x11CU
+#define XIL_DMA_SRC_DSCR_WORD0_OFFSET	0x128U
+#define XIL_DMA_SRC_DSCR_WORD1_OFFSET	0x12CU
+#define XIL_DMA_SRC_DSCR_WORD2_OFFSET	0x130U
+#define XIL_DMA_SRC_DSCR_WORD3_OFFSET	0x134U
+#define XIL_DMA_DST_DSCR_WORD0_OFFSET	0x138U
+#define XIL_DMA_DST_DSCR_WORD1_OFFSET	0x13CU
+#define XIL_DMA_DST_DSCR_WORD2_OFFSET	0x140U
+#define XIL_DMA_DST_DSCR_WORD3_OFFSET	0x144U
+#define XIL_DMA_WR_ONLY_WORD0_OFFSET	0x148U
+#define XIL_DMA_CTRL2_OFFSET		0x200U
+
+#define XIL_DMA_IXR_DONE_MASK		0x00000400U
+#define XIL_DMA_IXR_ERR_MASK		0x00000BF9U
+#define XIL_DMA_IXR_ALL_MASK		0x00000FFFU
+#define XIL_DMA_CTRL0_RESET_VALUE	0x00000080U
+#define XIL_DMA_CTRL0_WRONLY_MASK	0x00000010U
+#define XIL_DMA_CTRL2_EN_MASK		0x00000001U
+#define XIL_DMA_STS_MASK		0x00000003U
+#define XIL_DMA_STS_PAUSE		0x00000001U
+#define XIL_DMA_STS_BUSY		0x00000002U
+#define XIL_DMA_WORD1_MSB_MASK		0x0001FFFFU
+
+#define XIL_DMA_LINE			64U	/* Cache line size */
+#define XIL_DMA_ALL_CHANNELS		(2U * XIL_DMA_NUM_CHANNELS)
+
+#define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
+
+/************************** Function Prototypes ******************************/
+
+static UINTPTR Xil_DmaChannelBase(u32 Channel);
+static u32 Xil_DmaIdleChannels(void);
+static void Xil_DmaStartChannel(u32 Channel, UINTPTR Dst, UINTPTR Src,
+				u32 Size, u32 Pattern, u32 IsFill);
+static void Xil_DmaChannelDone(u32 Channel);
+static void Xil_DmaComplete(Xil_DmaRequest *Req);
+static s32 Xil_DmaSubmit(Xil_DmaRequest *Req, void *Dst, const void *Src,
+				u8 Value, u64 Len, u32 IsFill);
+
+/************************** Variable Definitions *****************************/
+
+static u32 DmaChannels = (XIL_DMA_LPD_CHANNEL_MASK << XIL_DMA_NUM_CHANNELS) |
+				XIL_DMA_FPD_CHANNEL_MASK;
+static u64 DmaThreshold = XIL_DMA_THRESHOLD_DEFAULT;
+static Xil_DmaRequest *DmaOwner[XIL_DMA_ALL_CHANNELS];
+
+/****************************************************************************
+*
+* Return the register base of a service channel. Channels 0 to 7 are GDMA,
+* 8 to 15 are ADMA.
+*
+****************************************************************************/
+static UINTPTR Xil_DmaChannelBase(u32 Channel)
+{
+	UINTPTR Base;
+
+	if (Channel < XIL_DMA_NUM_CHANNELS) {
+		Base = XIL_DMA_FPD_BASEADDR;
+	} else {
+		Base = XIL_DMA_LPD_BASEADDR;
+	}
+
+	return Base + ((Channel % XIL_DMA_NUM_CHANNELS) * XIL_DMA_CH_STRIDE);
+}
+
+/****************************************************************************
+*
+* Return the service channels that have no request and are not busy.
+* Called with interrupts masked.
+*
+****************************************************************************/
+static u32 Xil_DmaIdleChannels(void)
+{
+	u32 Channel;
+	u32 Idle = 0U;
+	u32 Sts;
+
+	for (Channel = 0U; Channel < XIL_DMA_ALL_CHANNELS; Channel++) {
+		if (((DmaChannels & (1U << Channel)) == 0U) ||
+				(DmaOwner[Channel] != NULL)) {
+			continue;
+		}
+		Sts = Xil_In32(Xil_DmaChannelBase(Channel) + XIL_DMA_STS_OFFSET) &
+			XIL_DMA_STS_MASK;
+		if ((Sts != XIL_DMA_STS_BUSY) && (Sts != XIL_DMA_STS_PAUSE)) {
+			Idle |= (1U << Channel);
+		}
+	}
+
+	return Idle;
+}
+
+/****************************************************************************
+*
+* Program one channel in simple mode and enable it. In write only mode the
+* byte pattern is written to the destination instead of copying.
+*
+****************************************************************************/
+static void Xil_DmaStartChannel(u32 Channel, UINTPTR Dst, UINTPTR Src,
+				u32 Size, u32 Pattern, u32 IsFill)
+{
+	UINTPTR Base = Xil_DmaChannelBase(Channel);
+	u32 Ctrl0 = XIL_DMA_CTRL0_RESET_VALUE;
+	u32 Index;
+	u32 Words;
+
+	Xil_Out32(Base + XIL_DMA_ISR_OFFSET, XIL_DMA_IXR_ALL_MASK);
+
+	if (IsFill != 0U) {
+		Ctrl0 |= XIL_DMA_CTRL0_WRONLY_MASK;
+		/* 128 bit pattern for GDMA, 64 bit for ADMA */
+		Words = (Channel < XIL_DMA_NUM_CHANNELS) ? 4U : 2U;
+		for (Index = 0U; Index < Words; Index++) {
+			Xil_Out32(Base + XIL_DMA_WR_ONLY_WORD0_OFFSET + (Index * 4U),
+					Pattern);
+		}
+	}
+	Xil_Out32(Base + XIL_DMA_CTRL0_OFFSET, Ctrl0);
+
+	Xil_Out32(Base + XIL_DMA_SRC_DSCR_WORD0_OFFSET, (u32)Src);
+	Xil_Out32(Base + XIL_DMA_SRC_DSCR_WORD1_OFFSET,
+			(u32)((u64)Src >> 32U) & XIL_DMA_WORD1_MSB_MASK);
+	Xil_Out32(Base + XIL_DMA_SRC_DSCR_WORD2_OFFSET, Size);
+	Xil_Out32(Base + XIL_DMA_SRC_DSCR_WORD3_OFFSET, 0U);
+
+	Xil_Out32(Base + XIL_DMA_DST_DSCR_WORD0_OFFSET, (u32)Dst);
+	Xil_Out32(Base + XIL_DMA_DST_DSCR_WORD1_OFFSET,
+			(u32)((u64)Dst >> 32U) & XIL_DMA_WORD1_MSB_MASK);
+	Xil_Out32(Base + XIL_DMA_DST_DSCR_WORD2_OFFSET, Size);
+	Xil_Out32(Base + XIL_DMA_DST_DSCR_WORD3_OFFSET, 0U);
+
+	Xil_Out32(Base + XIL_DMA_IEN_OFFSET,
+			XIL_DMA_IXR_DONE_MASK | XIL_DMA_IXR_ERR_MASK);
+	dsb();
+	Xil_Out32(Base + XIL_DMA_CTRL2_OFFSET, XIL_DMA_CTRL2_EN_MASK);
+}
+
+/****************************************************************************
+*
+* Retire the channel if it has finished its part of a request. Called with
+* interrupts masked or from the channel interrupt.
+*
+****************************************************************************/
+static void Xil_DmaChannelDone(u32 Channel)
+{
+	Xil_DmaRequest *Req = DmaOwner[Channel];
+	UINTPTR Base = Xil_DmaChannelBase(Channel);
+	u32 Isr;
+
+	if (Req == NULL) {
+		return;
+	}
+
+	Isr = Xil_In32(Base + XIL_DMA_ISR_OFFSET);
+	if ((Isr & XIL_DMA_IXR_ERR_MASK) != 0U) {
+		Xil_Out32(Base + XIL_DMA_CTRL2_OFFSET, 0U);
+		Req->Status = XST_FAILURE;
+	} else if ((Isr & XIL_DMA_IXR_DONE_MASK) == 0U) {
+		return;
+	} else {
+		/* Done without errors */
+	}
+
+	Xil_Out32(Base + XIL_DMA_IDS_OFFSET, XIL_DMA_IXR_ALL_MASK);
+	Xil_Out32(Base + XIL_DMA_ISR_OFFSET, Isr);
+	DmaOwner[Channel] = NULL;
+	Req->Channels &= ~(1U << Channel);
+
+	if (Req->Channels == 0U) {
+		Xil_DmaComplete(Req);
+	}
+}
+
+/****************************************************************************
+*
+* Finish a request once all its channels are done.
+*
+****************************************************************************/
+static void Xil_DmaComplete(Xil_DmaRequest *Req)
+{
+	if (Req->Len != 0U) {
+		/* Drop lines the CPU may have speculatively fetched meanwhile */
+		Xil_DCacheInvalidateRange((INTPTR)Req->Dst, (INTPTR)Req->Len);
+	}
+
+	if (Req->Status == XST_DEVICE_BUSY) {
+		Req->Status = XST_SUCCESS;
+	}
+
+	if (Req->Handler != NULL) {
+		Req->Handler(Req->CallBackRef, Req->Status);
+	}
+}
+
+/****************************************************************************
+*
+* Split a request between the CPU and the idle service channels and start
+* it. The cache line aligned body goes to DMA, the head and tail are done
+* by the CPU while DMA runs.
+*
+****************************************************************************/
+static s32 Xil_DmaSubmit(Xil_DmaRequest *Req, void *Dst, const void *Src,
+				u8 Value, u64 Len, u32 IsFill)
+{
+	UINTPTR DstAddr = (UINTPTR)Dst;
+	UINTPTR SrcAddr = (UINTPTR)Src;
+	u64 Head;
+	u64 Body;
+	u64 Piece;
+	u64 Offset;
+	u32 Idle = 0U;
+	u32 Count = 0U;
+	u32 Channel;
+	u32 Pattern;
+	u32 CurrMask;
+
+	Req->Channels = 0U;
+	Req->Status = XST_DEVICE_BUSY;
+	Req->Dst = 0U;
+	Req->Len = 0U;
+
+	Head = (XIL_DMA_LINE - (DstAddr & (XIL_DMA_LINE - 1U))) &
+			(XIL_DMA_LINE - 1U);
+	if (Head > Len) {
+		Head = Len;
+	}
+	Body = (Len - Head) & ~((u64)XIL_DMA_LINE - 1U);
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	if ((Len >= DmaThreshold) && (Body != 0U)) {
+		Idle = Xil_DmaIdleChannels();
+	}
+
+	for (Channel = 0U; Channel < XIL_DMA_ALL_CHANNELS; Channel++) {
+		if ((Idle & (1U << Channel)) != 0U) {
+			Count++;
+		}
+	}
+
+	if (Count != 0U) {
+		/* Only use as many channels as the body is worth */
+		if (Count > (Body / XIL_DMA_MIN_SPLIT)) {
+			Count = (u32)(Body / XIL_DMA_MIN_SPLIT);
+			if (Count == 0U) {
+				Count = 1U;
+			}
+		}
+		if (Body > ((u64)Count * XIL_DMA_MAX_XFER)) {
+			Body = (u64)Count * XIL_DMA_MAX_XFER;
+		}
+
+		Xil_DCacheFlushRange((INTPTR)(DstAddr + Head), (INTPTR)Body);
+		if (IsFill == 0U) {
+			Xil_DCacheFlushRange((INTPTR)(SrcAddr + Head), (INTPTR)Body);
+		}
+
+		Req->Dst = DstAddr + Head;
+		Req->Len = Body;
+		Pattern = (u32)Value * 0x01010101U;
+		Piece = (Body / Count) & ~((u64)XIL_DMA_LINE - 1U);
+		Offset = Head;
+
+		/* GDMA channels come first in the bitmap */
+		for (Channel = 0U; (Channel < XIL_DMA_ALL_CHANNELS) &&
+				(Count != 0U); Channel++) {
+			if ((Idle & (1U << Channel)) == 0U) {
+				continue;
+			}
+			Count--;
+			if (Count == 0U) {
+				Piece = (Head + Body) - Offset;
+			}
+			DmaOwner[Channel] = Req;
+			Req->Channels |= (1U << Channel);
+			Xil_DmaStartChannel(Channel, DstAddr + Offset,
+					(IsFill == 0U) ? (SrcAddr + Offset) : 0U,
+					(u32)Piece, Pattern, IsFill);
+			Offset += Piece;
+		}
+	} else {
+		Body = 0U;
+	}
+
+	mtcpsr(CurrMask);
+
+	/* Head, and everything DMA does not take, on the CPU */
+	if (IsFill == 0U) {
+		Xil_MemcpyNeon(Dst, Src, Head);
+		Xil_MemcpyNeon((u8 *)Dst + Head + Body, (const u8 *)Src + Head + Body,
+				Len - Head - Body);
+	} else {
+		(void)memset(Dst, Value, Head);
+		(void)memset((u8 *)Dst + Head + Body, Value, Len - Head - Body);
+	}
+
+	if (Body == 0U) {
+		Xil_DmaComplete(Req);
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************
+*
+* Copy Len bytes from Src to Dst and wait for the copy to complete.
+*
+* @param	Dst is the destination address.
+* @param	Src is the source address. The ranges must not overlap.
+* @param	Len is the number of bytes to copy.
+*
+* @return	Dst.
+*
+* @note		None.
+*
+****************************************************************************/
+void *Xil_DmaMemcpy(void *Dst, const void *Src, u64 Len)
+{
+	Xil_DmaRequest Req;
+
+	Req.Handler = NULL;
+	Req.CallBackRef = NULL;
+	(void)Xil_DmaSubmit(&Req, Dst, Src, 0U, Len, 0U);
+	(void)Xil_DmaWait(&Req);
+
+	return Dst;
+}
+
+/****************************************************************************
+*
+* Fill Len bytes at Dst with Value and wait for the fill to complete.
+*
+* @param	Dst is the destination address.
+* @param	Value is the byte to fill with.
+* @param	Len is the number of bytes to fill.
+*
+* @return	Dst.
+*
+* @note		None.
+*
+****************************************************************************/
+void *Xil_DmaMemset(void *Dst, u8 Value, u64 Len)
+{
+	Xil_DmaRequest Req;
+
+	Req.Handler = NULL;
+	Req.CallBackRef = NULL;
+	(void)Xil_DmaSubmit(&Req, Dst, NULL, Value, Len, 1U);
+	(void)Xil_DmaWait(&Req);
+
+	return Dst;
+}
+
+/****************************************************************************
+*
+* Start copying Len bytes from Src to Dst and return without waiting.
+*
+* @param	Req is the request. Handler and CallBackRef must be set by
+*		the caller, the other fields are filled in here.
+* @param	Dst is the destination address.
+* @param	Src is the source address. The ranges must not overlap.
+* @param	Len is the number of bytes to copy.
+*
+* @return	XST_SUCCESS. Small requests are done by the time this returns.
+*
+* @note		Neither buffer may be accessed until the request completes.
+*
+****************************************************************************/
+s32 Xil_DmaMemcpyAsync(Xil_DmaRequest *Req, void *Dst, const void *Src,
+			u64 Len)
+{
+	return Xil_DmaSubmit(Req, Dst, Src, 0U, Len, 0U);
+}
+
+/****************************************************************************
+*
+* Start filling Len bytes at Dst with Value and return without waiting.
+*
+* @param	Req is the request. Handler and CallBackRef must be set by
+*		the caller, the other fields are filled in here.
+* @param	Dst is the destination address.
+* @param	Value is the byte to fill with.
+* @param	Len is the number of bytes to fill.
+*
+* @return	XST_SUCCESS. Small requests are done by the time this returns.
+*
+* @note		The buffer may not be accessed until the request completes.
+*
+****************************************************************************/
+s32 Xil_DmaMemsetAsync(Xil_DmaRequest *Req, void *Dst, u8 Value, u64 Len)
+{
+	return Xil_DmaSubmit(Req, Dst, NULL, Value, Len, 1U);
+}
+
+/****************************************************************************
+*
+* Check whether a request has completed, retiring any of its channels that
+* have finished.
+*
+* @param	Req is the request.
+*
+* @return
+*		- XST_DEVICE_BUSY if the request is still in progress.
+*		- XST_SUCCESS if it completed.
+*		- XST_FAILURE if a channel reported an error.
+*
+* @note		None.
+*
+****************************************************************************/
+s32 Xil_DmaPoll(Xil_DmaRequest *Req)
+{
+	u32 Channel;
+	u32 CurrMask;
+	s32 Status;
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	for (Channel = 0U; Channel < XIL_DMA_ALL_CHANNELS; Channel++) {
+		if ((Req->Channels & (1U << Channel)) != 0U) {
+			Xil_DmaChannelDone(Channel);
+		}
+	}
+
+	if (Req->Channels != 0U) {
+		Status = XST_DEVICE_BUSY;
+	} else {
+		Status = Req->Status;
+	}
+
+	mtcpsr(CurrMask);
+
+	return Status;
+}
+
+/****************************************************************************
+*
+* Wait for a request to complete.
+*
+* @param	Req is the request.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a channel reported an error.
+*
+* @note		None.
+*
+****************************************************************************/
+s32 Xil_DmaWait(Xil_DmaRequest *Req)
+{
+	s32 Status;
+
+	do {
+		Status = Xil_DmaPoll(Req);
+	} while (Status == XST_DEVICE_BUSY);
+
+	return Status;
+}
+
+/****************************************************************************
+*
+* Interrupt handler for a service channel. It may be connected to the
+* XPS_ZDMA_CHn_INT_ID (CallBackRef n) and XPS_ADMA_CHn_INT_ID (CallBackRef
+* 8 + n) interrupts of the service channels.
+*
+* @param	CallBackRef is the service channel number.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_DmaIntrHandler(void *CallBackRef)
+{
+	u32 Channel = (u32)(UINTPTR)CallBackRef;
+
+	if (Channel < XIL_DMA_ALL_CHANNELS) {
+		Xil_DmaChannelDone(Channel);
+	}
+}
+
+/****************************************************************************
+*
+* Select the ZDMA channels the service may use.
+*
+* @param	FpdMask is a bitmap of GDMA channels 0 to 7.
+* @param	LpdMask is a bitmap of ADMA channels 0 to 7.
+*
+* @return	None.
+*
+* @note		Must not be called while requests are in progress.
+*
+****************************************************************************/
+void Xil_DmaSetChannels(u32 FpdMask, u32 LpdMask)
+{
+	DmaChannels = ((LpdMask & 0xFFU) << XIL_DMA_NUM_CHANNELS) |
+			(FpdMask & 0xFFU);
+}
+
+/****************************************************************************
+*
+* Set the request size below which the CPU does the whole request.
+*
+* @param	Bytes is the new threshold.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_DmaSetThreshold(u64 Bytes)
+{
+	DmaThreshold = Bytes;
+}
+
+/****************************************************************************
+*
+* Get the request size below which the CPU does the whole request.
+*
+* @param	None.
+*
+* @return	The threshold in bytes.
+*
+* @note		None.
+*
+****************************************************************************/
+u64 Xil_DmaGetThreshold(void)
+{
+	return DmaThreshold;
+}
+
+/****************************************************************************
+*
+* Measure the size at which DMA beats the CPU copy and make it the
+* threshold. Copies of growing size are timed both ways between the two
+* halves of Buf, cache maintenance included.
+*
+* @param	Buf is a scratch buffer, its contents are destroyed.
+* @param	Len is the size of Buf in bytes.
+*
+* @return	The new threshold in bytes.
+*
+* @note		If DMA never wins the threshold is set above Len / 2.
+*
+****************************************************************************/
+u64 Xil_DmaCalibrate(void *Buf, u64 Len)
+{
+	u8 *Src = (u8 *)(((UINTPTR)Buf + XIL_DMA_LINE - 1U) &
+			~((UINTPTR)XIL_DMA_LINE - 1U));
+	u64 Half = ((Len - (u64)(Src - (u8 *)Buf)) / 2U) &
+			~((u64)XIL_DMA_LINE - 1U);
+	u8 *Dst = Src + Half;
+	u64 Size;
+	XTime Start;
+	XTime CpuTime;
+	XTime DmaTime;
+	u64 Threshold = Half + 1U;
+
+	for (Size = 4096U; Size <= Half; Size *= 2U) {
+		XTime_GetTime(&Start);
+		Xil_MemcpyNeon(Dst, Src, Size);
+		XTime_GetTime(&CpuTime);
+		CpuTime -= Start;
+
+		DmaThreshold = 0U;
+		XTime_GetTime(&Start);
+		(void)Xil_DmaMemcpy(Dst, Src, Size);
+		XTime_GetTime(&DmaTime);
+		DmaTime -= Start;
+
+		if (DmaTime < CpuTime) {
+			Threshold = Size;
+			break;
+		}
+	}
+
+	DmaThreshold = Threshold;
+
+	return Threshold;
+}
+
+/****************************************************************************
+*
+* Copy memory with 64 byte NEON loads and stores.
+*
+* @param	Dst is the destination address.
+* @param	Src is the source address.
+* @param	Len is the number of bytes to copy.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_MemcpyNeon(void *Dst, const void *Src, u64 Len)
+{
+	u8 *D = (u8 *)Dst;
+	const u8 *S = (const u8 *)Src;
+	u64 Count = Len;
+
+	while (Count >= 64U) {
+		__asm__ __volatile__(
+			"ld1 {v0.16b, v1.16b, v2.16b, v3.16b}, [%1], #64\n\t"
+			"st1 {v0.16b, v1.16b, v2.16b, v3.16b}, [%0], #64\n\t"
+			: "+r" (D), "+r" (S)
+			:
+			: "v0", "v1", "v2", "v3", "memory");
+		Count -= 64U;
+	}
+
+	if (Count != 0U) {
+		(void)memcpy(D, S, Count);
+	}
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_dma.h
+*
+* Bulk memory copy and fill through the ZynqMP ZDMA engines.
+*
+* Xil_DmaMemcpy and Xil_DmaMemset move the cache line aligned body of a
+* request with one or more idle ZDMA channels and do the unaligned head and
+* tail on the CPU. Requests shorter than the DMA threshold are done entirely
+* on the CPU with a NEON copy loop. The threshold can be measured on the
+* target with Xil_DmaCalibrate.
+*
+* Only channels in the service channel masks are used, so that channels
+* driven by an application through the zdma driver are never touched. By
+* default the upper four GDMA (FPD) and ADMA (LPD) channels are used; GDMA
+* channels are preferred because of their wider data path.
+*
+* The *Async variants return once the channels are started. Completion is
+* picked up by Xil_DmaPoll/Xil_DmaWait, or by Xil_DmaIntrHandler if the
+* application connects it to the ZDMA channel interrupts. The request
+* handler, if any, is called on completion.
+*
+* Source and destination are cleaned from the data cache before the DMA
+* starts and the destination is invalidated once it completes. The CPU must
+* not touch the destination while a request is in progress.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.06  esd  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XIL_DMA_H
+#define XIL_DMA_H
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_DMA_FPD_BASEADDR		0xFD500000U	/**< GDMA channel 0 */
+#define XIL_DMA_LPD_BASEADDR		0xFFA80000U	/**< ADMA channel 0 */
+#define XIL_DMA_CH_STRIDE		0x10000U
+#define XIL_DMA_NUM_CHANNELS		8U	/**< Per DMA engine */
+
+#define XIL_DMA_FPD_CHANNEL_MASK	0xF0U	/**< Default GDMA channels */
+#define XIL_DMA_LPD_CHANNEL_MASK	0xF0U	/**< Default ADMA channels */
+
+#define XIL_DMA_THRESHOLD_DEFAULT	0x10000U /**< CPU below 64 KB */
+#define XIL_DMA_MIN_SPLIT		0x40000U /**< Smallest per channel piece */
+#define XIL_DMA_MAX_XFER		0x3FFF0000U /**< Largest per channel piece */
+
+/**************************** Type Definitions *******************************/
+
+typedef void (*Xil_DmaHandler)(void *CallBackRef, s32 Status);
+
+/**
+ * One memcpy/memset request. It must stay valid until it completes.
+ */
+typedef struct {
+	volatile u32 Channels;	/**< Channels still running, bit 8 is ADMA 0 */
+	volatile s32 Status;	/**< XST_DEVICE_BUSY until done */
+	UINTPTR Dst;		/**< Destination range to invalidate */
+	u64 Len;
+	Xil_DmaHandler Handler;	/**< Called on completion, may be NULL */
+	void *CallBackRef;
+} Xil_DmaRequest;
+
+/************************** Function Prototypes ******************************/
+
+void *Xil_DmaMemcpy(void *Dst, const void *Src, u64 Len);
+void *Xil_DmaMemset(void *Dst, u8 Value, u64 Len);
+s32 Xil_DmaMemcpyAsync(Xil_DmaRequest *Req, void *Dst, const void *Src,
+			u64 Len);
+s32 Xil_DmaMemsetAsync(Xil_DmaRequest *Req, void *Dst, u8 Value, u64 Len);
+s32 Xil_DmaPoll(Xil_DmaRequest *Req);
+s32 Xil_DmaWait(Xil_DmaRequest *Req);
+void Xil_DmaIntrHandler(void *CallBackRef);
+
+void Xil_DmaSetChannels(u32 FpdMask, u32 LpdMask);
+void Xil_DmaSetThreshold(u64 Bytes);
+u64 Xil_DmaGetThreshold(void);
+u64 Xil_DmaCalibrate(void *Buf, u64 Len);
+
+void Xil_MemcpyNeon(void *Dst, const void *Src, u64 Len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -46,6 +46,7 @@
 * 1.00a sdm  07/11/11 First release
 * 4.2	pkp	 07/21/14 Corrected reset value of event counter in function
 *					  Xpm_ResetEventCounters to fix CR#796275
+* 6.2   esd  10/18/26 Added Xpm_EnableCycleCounter and Xpm_ReadCycleCounter.
 * </pre>
 *
 ******************************************************************************/
@@ -294,3 +295,61 @@ void Xpm_GetEventCounters(u32 *PmCtrValue)
 #endif
 	}
 }
+
+/****************************************************************************/
+/**
+*
+* This function enables the Cortex A9 cycle counter. The counter value is
+* left untouched, so the counter keeps counting from where it is.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void Xpm_EnableCycleCounter(void)
+{
+	u32 Reg;
+#ifdef __GNUC__
+	Reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+#elif defined (__ICCARM__)
+	mfcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+#else
+	{ register u32 C15Reg __asm(XREG_CP15_PERF_MONITOR_CTRL);
+	  Reg = C15Reg; }
+#endif
+	Reg |= 1U; /* enable all counters */
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+
+	/* Enable the cycle counter */
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, 0x80000000U);
+}
+
+/****************************************************************************/
+/**
+*
+* This function reads the Cortex A9 cycle counter.
+*
+* @param	None.
+*
+* @return	Current value of the cycle counter.
+*
+* @note		The counter is 32 bits wide and wraps around, and it only
+*		counts once Xpm_EnableCycleCounter has been called.
+*
+*****************************************************************************/
+u32 Xpm_ReadCycleCounter(void)
+{
+	u32 Count;
+#ifdef __GNUC__
+	Count = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+#elif defined (__ICCARM__)
+	mfcp(XREG_CP15_PERF_CYCLE_COUNTER, Count);
+#else
+	{ register u32 C15Reg __asm(XREG_CP15_PERF_CYCLE_COUNTER);
+	  Count = C15Reg; }
+#endif
+	return Count;
+}
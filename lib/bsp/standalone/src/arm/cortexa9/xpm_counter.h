@@ -46,8 +46,10 @@
 *
 * @note
 *
-* This file doesn't handle the Cortex-A9 cycle counter, as the cycle counter is
-* being used for time keeping.
+* Xpm_EnableCycleCounter and Xpm_ReadCycleCounter give access to the Cortex-A9
+* cycle counter, for instance to time interrupt handlers. The cycle counter is
+* only enabled and read, never reset or reconfigured, so that other users of it
+* are not disturbed.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -55,6 +57,7 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a sdm  07/11/11 First release
+* 6.2   esd  10/18/26 Added Xpm_EnableCycleCounter and Xpm_ReadCycleCounter.
 * </pre>
 *
 ******************************************************************************/
@@ -563,6 +566,8 @@ extern "C" {
 /* Interface fuctions to access perfromance counters from abstraction layer */
 void Xpm_SetEvents(s32 PmcrCfg);
 void Xpm_GetEventCounters(u32 *PmCtrValue);
+void Xpm_EnableCycleCounter(void);
+u32 Xpm_ReadCycleCounter(void);
 
 #ifdef __cplusplus
 }
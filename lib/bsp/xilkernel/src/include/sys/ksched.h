@@ -62,6 +62,8 @@ extern "C" {
 
 
 void readyq_init(void) ;
+void readyq_enq (pid_t pid);
+int  readyq_delq (pid_t pid);
 void process_scheduler(void) ;
 void process_scheduler_and_switch (void);
 void suspend (void);
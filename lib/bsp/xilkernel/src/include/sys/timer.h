@@ -47,8 +47,9 @@ extern "C" {
 #endif
 
 typedef struct soft_tmr_s {
-    unsigned int timeout;
+    unsigned int timeout;       // Ticks after the previous timer on the active list expires
     pid_t pid;
+    short next;                 // Next timer on the active or free list, -1 ends the list
 } soft_tmr_t;
 
 void     soft_tmr_init(void) ;
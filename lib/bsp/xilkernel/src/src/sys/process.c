@@ -145,11 +145,7 @@ pid_t proc_create (unsigned int priority)
 #endif
 
             if (pcb->pid != 0) {                                                // Do not enqueue the idle_task
-#if SCHED_TYPE == SCHED_RR
-                penq (&ready_q[0], i, 0);
-#else  /* SCHED_TYPE == SCHED_PRIO */
-                penq (&ready_q[priority], i, 0);
-#endif
+                readyq_enq (i);
             }
             break;
         }
@@ -199,11 +195,7 @@ int sys_kill (pid_t pid)
     }
 
     if (ptable[pid].state == PROC_READY) {
-#if SCHED_TYPE == SCHED_RR
-        pdelq (&ready_q[0], pid);
-#elif SCHED_TYPE == SCHED_PRIO
-        pdelq (&ready_q[ptable[pid].priority], pid);
-#endif
+        readyq_delq (pid);
     } else if (ptable[pid].state == PROC_WAIT || ptable[pid].state == PROC_TIMED_WAIT) {
 #if SCHED_TYPE == SCHED_RR
         pdelq (ptable[pid].blockq, pid);
@@ -377,10 +369,8 @@ void process_unblock (queuep queue)
     ptable[pid].state = PROC_READY;
     ptable[pid].blockq = NULL;
 
-#if SCHED_TYPE == SCHED_RR
-    penq (&ready_q[0], pid, 0);
-#else /* SCHED_TYPE == SCHED_PRIO */
-    penq (&ready_q[ptable[pid].priority], pid, 0);
+    readyq_enq (pid);
+#if SCHED_TYPE == SCHED_PRIO
     resched = 1;
 #endif
 }
@@ -481,11 +481,10 @@ int sys_pthread_setschedparam (pthread_t thread, int policy, struct sched_param
         thread_info->parent->state == PROC_DELAY) {                                     // Just need to change the priority
         thread_info->parent->priority = param->sched_priority;
     } else if (thread_info->parent->state == PROC_READY) {                              // cannot handle processes which are blocked
-        if (pdelq (&ready_q[thread_info->parent->priority],
-                   thread_info->parent->pid) < 0)                                       // Remove from corresponding priority queue
+        if (readyq_delq (thread_info->parent->pid) < 0)                                 // Remove from corresponding priority queue
             return -1;
         thread_info->parent->priority = param->sched_priority;                          // Change priority and enqueue in new queue
-        penq (&ready_q[thread_info->parent->priority], thread_info->parent->pid, 0);
+        readyq_enq (thread_info->parent->pid);
     } else if (thread_info->parent->state == PROC_WAIT ||
                thread_info->parent->state == PROC_TIMED_WAIT) {                         // Thread currently blocked
         if (prio_pdelq (thread_info->parent->blockq,                                    // Remove from corresponding wait queue
@@ -50,6 +50,15 @@
 
 // Ready Queue - Array of N_PRIO process queues
 struct _queue ready_q[N_PRIO] ;
+
+#if SCHED_TYPE == SCHED_PRIO
+// Ready priority bitmap. Priority p is bit (31 - (p % 32)) of word (p / 32), so that
+// a count-leading-zeros of the first non-zero word yields the highest ready priority.
+// A bit is set iff ready_q[p] is non-empty.
+#define READY_MAP_WORDS         ((N_PRIO + 31) / 32)
+#define READY_MAP_BIT(prio)     (0x80000000U >> ((prio) & 31))
+static unsigned int ready_map[READY_MAP_WORDS];
+#endif
 signed char entry_mode = ENTRY_MODE_USER;       // Current entry mode into kernel
 signed char resched = 0;                        // Indicates if rescheduling occurred elsewhere
 char did_resched = 0;                           // Indicates if the kernel completed the rescheduling
@@ -79,7 +88,83 @@ void readyq_init(void)
     for (;i < N_PRIO; i++ ) {
 	alloc_q (&ready_q[i], MAX_READYQ, READY_Q, sizeof(char), i);
     }
+#if SCHED_TYPE == SCHED_PRIO
+    for (i = 0; i < READY_MAP_WORDS; i++)
+	ready_map[i] = 0;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------//
+//  @func - readyq_enq
+//! @desc
+//!   Enqueue a process at the tail of the ready queue of its priority.
+//! @param
+//!   - pid is the process to make ready. Its ptable priority selects the queue.
+//! @return
+//!   - Nothing
+//! @note
+//!   - All ready queue insertions go through here to keep the ready bitmap in step.
+//----------------------------------------------------------------------------------------------------//
+void readyq_enq (pid_t pid)
+{
+#if SCHED_TYPE == SCHED_RR
+    penq (&ready_q[0], pid, 0);
+#else /* SCHED_TYPE == SCHED_PRIO */
+    unsigned int prio = ptable[pid].priority;
+
+    penq (&ready_q[prio], pid, 0);
+    ready_map[prio >> 5] |= READY_MAP_BIT (prio);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------//
+//  @func - readyq_delq
+//! @desc
+//!   Remove a process from the ready queue of its priority.
+//! @param
+//!   - pid is the process to remove. Its ptable priority selects the queue.
+//! @return
+//!   - 0 on success, -1 if the process was not in the queue
+//! @note
+//!   - None
+//----------------------------------------------------------------------------------------------------//
+int readyq_delq (pid_t pid)
+{
+#if SCHED_TYPE == SCHED_RR
+    return pdelq (&ready_q[0], pid);
+#else /* SCHED_TYPE == SCHED_PRIO */
+    unsigned int prio = ptable[pid].priority;
+    int ret;
+
+    ret = pdelq (&ready_q[prio], pid);
+    if (ready_q[prio].item_count == 0)
+	ready_map[prio >> 5] &= ~READY_MAP_BIT (prio);
+    return ret;
+#endif
+}
+
+#if SCHED_TYPE == SCHED_PRIO
+//----------------------------------------------------------------------------------------------------//
+//  @func - readyq_highest
+//! @desc
+//!   Find the highest non-empty ready priority from the ready bitmap.
+//! @return
+//!   - Highest ready priority, -1 if all ready queues are empty
+//! @note
+//!   - With the default 32 priority levels this is a single count-leading-zeros, which
+//!     MicroBlaze executes in one instruction when configured with the pattern compare unit.
+//----------------------------------------------------------------------------------------------------//
+static inline int readyq_highest (void)
+{
+    unsigned int i;
+
+    for (i = 0; i < READY_MAP_WORDS; i++) {
+	if (ready_map[i] != 0)
+	    return (int)((i << 5) + __builtin_clz (ready_map[i]));
+    }
+    return -1;
 }
+#endif
 int scheduler (void)
 {
 
@@ -151,7 +236,7 @@ void sched_rr (void)
     if (current_process->state == PROC_RUN) {
         ptable[current_pid].state = PROC_READY;
 	if(current_pid != idle_task_pid)
-	    penq (&ready_q[0], current_pid, 0);
+	    readyq_enq (current_pid);
     }
 
     SET_CURRENT_PROCESS (-1);
@@ -202,23 +287,21 @@ void sched_prio (void)
     if (current_process->state == PROC_RUN) {
 	ptable[current_pid].state = PROC_READY;
 	if (current_pid != idle_task_pid)
-	    penq (&ready_q[ptable[current_pid].priority], current_pid, 0);
+	    readyq_enq (current_pid);
     }
 
     SET_CURRENT_PROCESS (-1);
 
-    for (i=0; i <= PRIO_LOWEST; i++) {
-	while (ready_q[i].item_count != 0) {
-	    pdeq (&ready_q[i], &ready, 0);
-	    if (ptable[ready].state == PROC_DEAD) {   // Flush out dead processes
-		ready = -1;
-		continue;
-	    }
-	    else break;
+    // Pick the highest ready priority from the bitmap instead of walking every level
+    while ((i = readyq_highest ()) >= 0) {
+	pdeq (&ready_q[i], &ready, 0);
+	if (ready_q[i].item_count == 0)
+	    ready_map[i >> 5] &= ~READY_MAP_BIT (i);
+	if (ptable[ready].state == PROC_DEAD) {   // Flush out dead processes
+	    ready = -1;
+	    continue;
 	}
-
-	if (ready != -1)
-	    break;
+	break;
     }
 
     if (ready == -1)
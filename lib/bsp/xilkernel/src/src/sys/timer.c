@@ -36,32 +36,30 @@
  *****************************************************************************/
 #include <os_config.h>
 #include <sys/timer.h>
+#include <sys/ksched.h>
 #include <sys/process.h>
 #include <sys/decls.h>
 #include <sys/xtrace.h>
 #include <stdio.h>
 
 #ifdef CONFIG_TIME
-#define get_tmr_list_shadow(tmrlist) ((tmrlist == active_tmrs_a)?(active_tmrs_b):(active_tmrs_a))
 
+// Active timers are kept on a list sorted by expiry. Each entry holds its timeout relative
+// to the entry before it (a delta), so a tick only decrements the head and only expired
+// entries are touched. Insertion and removal walk the list; they run at thread level.
 static soft_tmr_t soft_tmrs[MAX_TMRS] ;
-static int* active_tmrs;                   // Pointer to the list of timer IDs that are currently active
-static int  active_tmrs_a[MAX_TMRS];       // Actual timer ID lists A & B. (One is the shadow of the other)
-static int  active_tmrs_b[MAX_TMRS];
-static int nactive;
+static int tmr_head;                        // First (soonest to expire) active timer, -1 if none
+static int tmr_free;                        // Free list of timers, linked through next
 extern unsigned int kernel_ticks;
-extern struct _queue ready_q[];
 extern process_struct ptable[];
 extern process_struct *current_process;
 extern signed char resched;
 
 static void            handle_timeout (pid_t pid);
-static int             get_free_tmr (void);
 static unsigned int
                 ms_to_ticks (unsigned int ms);
 static unsigned int
                 ticks_to_ms (unsigned int ticks);
-static void     update_active_tmrs_list (pid_t pid);
 
 void soft_tmr_init (void)
 {
@@ -70,12 +68,12 @@ void soft_tmr_init (void)
     for (i=0; i < MAX_TMRS; i++) {
 	soft_tmrs[i].timeout = 0;
 	soft_tmrs[i].pid = -1;
-	active_tmrs_a[i] = -1;
-	active_tmrs_b[i] = -1;
+	soft_tmrs[i].next = i + 1;
     }
+    soft_tmrs[MAX_TMRS - 1].next = -1;
 
-    active_tmrs = active_tmrs_a;                                        // Set the current active timer list to "list A"
-    nactive = 0;
+    tmr_head = -1;
+    tmr_free = 0;
     kernel_ticks = 0;
 }
 
@@ -103,113 +101,94 @@ static void handle_timeout (signed char pid)
     }
 
     ptable[pid].state = PROC_READY;
-#if SCHED_TYPE == SCHED_RR
-    penq (&ready_q[0], pid, 0);
-#else /* SCHED_TYPE == SCHED_PRIO */
-    penq (&ready_q[ptable[pid].priority], pid, 0);
-#endif
+    readyq_enq (pid);
 
     resched = 1;
 }
 
-
-static void update_active_tmrs_list (pid_t pid)
-{
-    int i;
-    int* tmrshadow;
-    int curactive = 0;
-
-    tmrshadow = get_tmr_list_shadow(active_tmrs);                       // Get the list that can act as a shadow to the current list
-    for (i=0; i < nactive; i++) {
-        if (soft_tmrs[active_tmrs[i]].pid == pid) {                      // This timer has been removed and is no longer active. Drop it
-            soft_tmrs[active_tmrs[i]].pid = -1;                         // and also make it available for future allocations
-            continue;
-        }
-
-        tmrshadow[curactive] = active_tmrs[i];                      // Append timer id to newly formed list
-        curactive++;
-    }
-
-    active_tmrs = tmrshadow;
-    nactive = curactive;
-}
-
-static int get_free_tmr (void)
-{
-    int i;
-
-    if (nactive == MAX_TMRS)                                            // Break early if no timers left
-	return -1;
-
-    for (i = 0; i < MAX_TMRS; i++) {
-	if (soft_tmrs[i].pid == -1)
-	    break;
-    }
-
-    return i;
-}
-
 int add_tmr (pid_t pid, unsigned int ms)
 {
     int tmr;
+    int cur, prev;
     unsigned int ticks;
 
-    if ((tmr = get_free_tmr ()) < 0) {
+    if ((tmr = tmr_free) < 0) {
         DPRINTF ("XMK: add_tmr -> Out of timers\r\n");
 	return -1;
     }
+    tmr_free = soft_tmrs[tmr].next;
 
     ticks = ms_to_ticks (ms);
     ticks = (ticks == 0) ? 1 : ticks;                                   // Bump it up a little
 
+    prev = -1;                                                          // Find the insertion point. Timers with the
+    cur = tmr_head;                                                     // same expiry stay in the order they were added
+    while (cur != -1 && soft_tmrs[cur].timeout <= ticks) {
+        ticks -= soft_tmrs[cur].timeout;
+        prev = cur;
+        cur = soft_tmrs[cur].next;
+    }
+
     soft_tmrs[tmr].pid = pid;
     soft_tmrs[tmr].timeout = ticks;
-    active_tmrs[nactive] = tmr;
-    nactive++;
+    soft_tmrs[tmr].next = cur;
+    if (cur != -1)
+        soft_tmrs[cur].timeout -= ticks;                                // Successor is now relative to us
+    if (prev == -1)
+        tmr_head = tmr;
+    else
+        soft_tmrs[prev].next = tmr;
 
     return 0;
 }
 
 unsigned int remove_tmr (pid_t pid)
 {
-    int i;
-    unsigned int remain = 0;
-
-    for (i = 0; i < MAX_TMRS; i++) {
-        if (soft_tmrs[i].pid == pid) {
-            remain = ticks_to_ms (soft_tmrs[i].timeout);
-            update_active_tmrs_list (pid);
-            break;
+    int cur, prev;
+    unsigned int ticks = 0;
+
+    prev = -1;
+    cur = tmr_head;
+    while (cur != -1) {
+        ticks += soft_tmrs[cur].timeout;
+        if (soft_tmrs[cur].pid == pid) {
+            if (soft_tmrs[cur].next != -1)                              // Hand our delta on to the successor
+                soft_tmrs[soft_tmrs[cur].next].timeout += soft_tmrs[cur].timeout;
+            if (prev == -1)
+                tmr_head = soft_tmrs[cur].next;
+            else
+                soft_tmrs[prev].next = soft_tmrs[cur].next;
+
+            soft_tmrs[cur].pid = -1;
+            soft_tmrs[cur].next = tmr_free;
+            tmr_free = cur;
+            return ticks_to_ms (ticks);
         }
+        prev = cur;
+        cur = soft_tmrs[cur].next;
     }
 
-    return remain;
+    return 0;
 }
 
-// Timer lists A&B.
-// One acts as a shadow to the other always. On every timer update event,
-// the current list is operated on, while the shadow list keeps getting updates
+// Called on every kernel tick. Only the head of the delta list is decremented; every
+// timer that reaches zero is unlinked and its process made ready.
 void soft_tmr_handler (void)
 {
-    int i;
-    int* tmrshadow;
-    int curactive = 0;
-
-    tmrshadow = get_tmr_list_shadow(active_tmrs);                       // Get the list that can act as a shadow to the current list
-    for (i=0; i < nactive; i++) {
-	soft_tmrs[active_tmrs[i]].timeout--;
-        if (soft_tmrs[active_tmrs[i]].timeout == 0) {                   // Timer expired. Unblock the process
-	    handle_timeout (soft_tmrs[active_tmrs[i]].pid);
-	    soft_tmrs[active_tmrs[i]].pid = -1;
-	}
-	else {
-	    tmrshadow[curactive] = active_tmrs[i];                      // Append timer id to newly formed list
-	    curactive++;
-	}
-    }
+    int tmr;
 
-    active_tmrs = tmrshadow;
-    nactive = curactive;
+    if (tmr_head == -1)
+        return;
+
+    soft_tmrs[tmr_head].timeout--;
+    while (tmr_head != -1 && soft_tmrs[tmr_head].timeout == 0) {       // Timer expired. Unblock the process
+        tmr = tmr_head;
+        tmr_head = soft_tmrs[tmr].next;
+        handle_timeout (soft_tmrs[tmr].pid);
+        soft_tmrs[tmr].pid = -1;
+        soft_tmrs[tmr].next = tmr_free;
+        tmr_free = tmr;
+    }
 }
 
 //----------------------------------------------------------------------------------------------------//
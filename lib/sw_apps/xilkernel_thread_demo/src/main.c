@@ -42,16 +42,34 @@
 #include "platform_config.h"
 #include <pthread.h>
 #include <sys/types.h>
+#if defined(CONFIG_SEMA) && defined(CONFIG_TIME)
+#include <semaphore.h>
+#define SCHED_BENCH
+#endif
 
 /* Declarations */
 #define DATA_SIZE   400
 #define N_THREADS   4
 
+/* Context switch benchmark: ping-pong rounds and background sleepers */
+#define BENCH_ROUNDS    10000
+#define BENCH_SLEEPERS  3
+
 void* master_thread(void *);
 void* partial_sum_worker(void *);
+#ifdef SCHED_BENCH
+void sched_bench(void);
+void* bench_ping(void *);
+void* bench_pong(void *);
+void* bench_sleeper(void *);
+#endif
 
 /* Data */
 int input_data[DATA_SIZE];
+#ifdef SCHED_BENCH
+sem_t bench_sem_ping, bench_sem_pong;
+volatile int bench_stop;
+#endif
 
 
 /* Functions */
@@ -147,6 +165,10 @@ void* master_thread(void *arg)
     xil_printf("Xilkernel Demo: Result computed by worker threads = %d.\r\n", 
                final_result);
 
+#ifdef SCHED_BENCH
+    sched_bench();
+#endif
+
     xil_printf("Xilkernel Demo: Master Thread Completing.\r\n");
     return (void*)0;
 }
@@ -168,3 +190,91 @@ void* partial_sum_worker(void *arg)
     pthread_exit((void*)psum);
     return NULL;
 }
+
+#ifdef SCHED_BENCH
+/*
+ * Context switch latency benchmark. Two threads hand a semaphore back and
+ * forth BENCH_ROUNDS times, each hand-off being one block, one wakeup and one
+ * context switch. BENCH_SLEEPERS threads sleep for a tick at a time meanwhile
+ * so that the tick handler has timers to process, as in a real system.
+ * The result is averaged over kernel ticks, so run enough rounds to span
+ * many ticks.
+ */
+void sched_bench(void)
+{
+    pthread_t ping, pong, sleeper[BENCH_SLEEPERS];
+    pthread_attr_t attr;
+#if SCHED_TYPE == SCHED_PRIO
+    struct sched_param spar;
+#endif
+    unsigned int start, ticks, ms_per_tick, ns_per_switch;
+    int i;
+
+    xil_printf("Xilkernel Demo: Context switch benchmark, %d rounds, "
+               "%d sleepers.\r\n", BENCH_ROUNDS, BENCH_SLEEPERS);
+
+    sem_init(&bench_sem_ping, 0, 0);
+    sem_init(&bench_sem_pong, 0, 0);
+    bench_stop = 0;
+
+    pthread_attr_init(&attr);
+#if SCHED_TYPE == SCHED_PRIO
+    spar.sched_priority = PRIO_HIGHEST + 1;
+    pthread_attr_setschedparam(&attr, &spar);
+#endif
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+
+    for (i = 0; i < BENCH_SLEEPERS; i++)
+        pthread_create(&sleeper[i], &attr, bench_sleeper, NULL);
+
+    start = xget_clock_ticks();
+    pthread_create(&pong, &attr, bench_pong, NULL);
+    pthread_create(&ping, &attr, bench_ping, NULL);
+    pthread_join(ping, NULL);
+    pthread_join(pong, NULL);
+    ticks = xget_clock_ticks() - start;
+
+    bench_stop = 1;
+    for (i = 0; i < BENCH_SLEEPERS; i++)
+        pthread_join(sleeper[i], NULL);
+
+    sem_destroy(&bench_sem_ping);
+    sem_destroy(&bench_sem_pong);
+
+    ms_per_tick = SYSTMR_INTERVAL / SYSTMR_CLK_FREQ_KHZ;
+    ns_per_switch = (unsigned int)(((unsigned long long)ticks * ms_per_tick
+                                    * 1000000ULL) / (2 * BENCH_ROUNDS));
+    xil_printf("Xilkernel Demo: %d switches in %d ticks (%d ms/tick), "
+               "%d ns per switch.\r\n", 2 * BENCH_ROUNDS, ticks, ms_per_tick,
+               ns_per_switch);
+}
+
+void* bench_ping(void *arg)
+{
+    int i;
+
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        sem_post(&bench_sem_pong);
+        sem_wait(&bench_sem_ping);
+    }
+    return NULL;
+}
+
+void* bench_pong(void *arg)
+{
+    int i;
+
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        sem_wait(&bench_sem_pong);
+        sem_post(&bench_sem_ping);
+    }
+    return NULL;
+}
+
+void* bench_sleeper(void *arg)
+{
+    while (!bench_stop)
+        sleep(1);
+    return NULL;
+}
+#endif
@@ -0,0 +1,341 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file dmacopy.c
+*
+* Contains the PS DMA (PL330) boot copy engine.
+*
+* Partitions in linear QSPI or NOR are copied to DDR by channel 0 of the
+* secure PS DMA controller in DMA_COPY_CHUNK_SIZE transfers. The driver
+* builds a nested loop program of 16 beat bursts for each transfer. When an
+* MD5 checksum is requested, chunk N is hashed from DDR while chunk N+1 is
+* being transferred, so the checksum costs little more than the copy itself
+* and the partition is not read a second time for validation.
+*
+* The FSBL runs with interrupts disabled, so completion is detected by
+* polling the controller's interrupt status and the driver's done handler is
+* called directly to retire the command.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 17.00a esd 10/18/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "fsbl.h"
+#include "md5.h"
+#include "dmacopy.h"
+
+#ifdef FSBL_DMA_COPY
+#include "xdmaps.h"
+#include "xil_cache.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+#ifdef FSBL_DMA_COPY
+static u32 DmaCopyInit(void);
+static u32 DmaCopyStart(u32 SourceAddr, u32 DestinationAddr, u32 LengthBytes);
+static u32 DmaCopyWait(void);
+#endif
+
+/************************** Variable Definitions *****************************/
+
+#ifdef FSBL_DMA_COPY
+static XDmaPs DmaInstance;
+static XDmaPs_Cmd DmaCmd;
+static u32 DmaInitDone = 0;
+#endif
+
+#ifdef FSBL_DMA_COPY
+/******************************************************************************/
+/**
+*
+* This function initializes the PS DMA controller on first use
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the controller is ready
+*		- XST_FAILURE otherwise
+*
+* @note		None
+*
+****************************************************************************/
+static u32 DmaCopyInit(void)
+{
+	XDmaPs_Config *DmaCfg;
+	int Status;
+
+	if (DmaInitDone) {
+		return XST_SUCCESS;
+	}
+
+	DmaCfg = XDmaPs_LookupConfig(DMA_COPY_DEVICE_ID);
+	if (DmaCfg == NULL) {
+		return XST_FAILURE;
+	}
+
+	Status = XDmaPs_CfgInitialize(&DmaInstance, DmaCfg,
+			DmaCfg->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Word accesses in 16 beat bursts on both sides, incrementing
+	 * addresses. Partitions are word aligned in the image and the
+	 * driver moves any unaligned head and tail in bytes.
+	 */
+	memset(&DmaCmd, 0, sizeof(XDmaPs_Cmd));
+	DmaCmd.ChanCtrl.SrcBurstSize = 4;
+	DmaCmd.ChanCtrl.SrcBurstLen = 16;
+	DmaCmd.ChanCtrl.SrcInc = 1;
+	DmaCmd.ChanCtrl.DstBurstSize = 4;
+	DmaCmd.ChanCtrl.DstBurstLen = 16;
+	DmaCmd.ChanCtrl.DstInc = 1;
+
+	DmaInitDone = 1;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function starts one DMA transfer on the copy channel
+*
+* @param	SourceAddr is the source address
+* @param	DestinationAddr is the destination address
+* @param	LengthBytes is the transfer length in bytes
+*
+* @return
+*		- XST_SUCCESS if the transfer was started
+*		- XST_FAILURE otherwise
+*
+* @note		The driver flushes the source and invalidates the
+*		destination range from the data cache before starting.
+*
+****************************************************************************/
+static u32 DmaCopyStart(u32 SourceAddr, u32 DestinationAddr, u32 LengthBytes)
+{
+	int Status;
+
+	DmaCmd.BD.SrcAddr = SourceAddr;
+	DmaCmd.BD.DstAddr = DestinationAddr;
+	DmaCmd.BD.Length = LengthBytes;
+	DmaCmd.GeneratedDmaProg = NULL;
+
+	Status = XDmaPs_Start(&DmaInstance, DMA_COPY_CHANNEL, &DmaCmd, 0);
+	if (Status != XST_SUCCESS) {
+		fsbl_printf(DEBUG_GENERAL, "DMA start failed %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+*
+* This function polls for the end of the transfer on the copy channel
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if the transfer completed
+*		- XST_FAILURE on a channel fault or time out
+*
+* @note		On a time out the channel is killed and its DMA program
+*		released, so a later copy can start on it again.
+*
+****************************************************************************/
+static u32 DmaCopyWait(void)
+{
+	u32 BaseAddr = DmaInstance.Config.BaseAddress;
+	u32 Count = 0;
+
+	while ((XDmaPs_ReadReg(BaseAddr, XDMAPS_INTSTATUS_OFFSET) &
+			(1U << DMA_COPY_CHANNEL)) == 0U) {
+		if ((XDmaPs_ReadReg(BaseAddr, XDMAPS_FSC_OFFSET) &
+				(1U << DMA_COPY_CHANNEL)) != 0U) {
+			fsbl_printf(DEBUG_GENERAL, "DMA channel fault 0x%x\r\n",
+				XDmaPs_ReadReg(BaseAddr,
+					XDmaPs_FTCn_OFFSET(DMA_COPY_CHANNEL)));
+			XDmaPs_FaultISR(&DmaInstance);
+			return XST_FAILURE;
+		}
+		if (++Count == DMA_COPY_TIMEOUT) {
+			fsbl_printf(DEBUG_GENERAL, "DMA copy timed out\r\n");
+			/*
+			 * Stop the channel thread with DMAKILL, then release
+			 * the DMA program and leave the channel idle for the
+			 * next copy
+			 */
+			(void)XDmaPs_ResetChannel(&DmaInstance,
+					DMA_COPY_CHANNEL);
+			XDmaPs_WriteReg(BaseAddr, XDMAPS_INTCLR_OFFSET,
+					1U << DMA_COPY_CHANNEL);
+			(void)XDmaPs_FreeDmaProg(&DmaInstance,
+					DMA_COPY_CHANNEL, &DmaCmd);
+			DmaInstance.Chans[DMA_COPY_CHANNEL].DmaCmdToHw = NULL;
+			return XST_FAILURE;
+		}
+	}
+
+	/*
+	 * Clears the event and releases the generated DMA program
+	 */
+	XDmaPs_DoneISR_0(&DmaInstance);
+
+	return XST_SUCCESS;
+}
+#endif
+
+/******************************************************************************/
+/**
+*
+* This function copies a partition from linear flash to DDR with the PS DMA,
+* optionally computing its MD5 checksum on the way
+*
+* @param	SourceAddr is the source address, in the linear flash window
+* @param	DestinationAddr is the destination address in DDR
+* @param	LengthBytes is the length of the data in bytes
+* @param	Checksum receives the MD5 checksum of the copied data, or is
+*		NULL if no checksum is needed
+*
+* @return
+*		- XST_SUCCESS if the copy completed
+*		- XST_FAILURE otherwise
+*
+* @note		Without a PS DMA controller, or for short copies, the data is
+*		moved with memcpy() and hashed afterwards.
+*
+****************************************************************************/
+u32 FsblDmaCopy(u32 SourceAddr, u32 DestinationAddr, u32 LengthBytes,
+		u8 *Checksum)
+{
+#ifdef FSBL_DMA_COPY
+	MD5Context Md5Context;
+	u32 Offset;
+	u32 Chunk;
+	u32 NextChunk;
+	u32 Status;
+
+	if ((LengthBytes >= DMA_COPY_MIN_SIZE) &&
+			(DmaCopyInit() == XST_SUCCESS)) {
+
+		if (Checksum != NULL) {
+			MD5Init(&Md5Context);
+		}
+
+		Offset = 0;
+		Chunk = LengthBytes;
+		if (Chunk > DMA_COPY_CHUNK_SIZE) {
+			Chunk = DMA_COPY_CHUNK_SIZE;
+		}
+
+		Status = DmaCopyStart(SourceAddr, DestinationAddr, Chunk);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		while (Chunk != 0) {
+			Status = DmaCopyWait();
+			if (Status != XST_SUCCESS) {
+				return XST_FAILURE;
+			}
+
+			/*
+			 * Kick off the next chunk before touching this one
+			 */
+			NextChunk = LengthBytes - (Offset + Chunk);
+			if (NextChunk > DMA_COPY_CHUNK_SIZE) {
+				NextChunk = DMA_COPY_CHUNK_SIZE;
+			}
+			if (NextChunk != 0) {
+				Status = DmaCopyStart(SourceAddr + Offset + Chunk,
+						DestinationAddr + Offset + Chunk,
+						NextChunk);
+				if (Status != XST_SUCCESS) {
+					return XST_FAILURE;
+				}
+			}
+
+			if (Checksum != NULL) {
+				/*
+				 * Lines of this chunk may have been pulled into
+				 * the cache while it was in flight
+				 */
+				Xil_DCacheInvalidateRange(DestinationAddr + Offset,
+						Chunk);
+				MD5Update(&Md5Context,
+						(u8 *)(DestinationAddr + Offset), Chunk, 0);
+			}
+
+			Offset += Chunk;
+			Chunk = NextChunk;
+		}
+
+		if (Checksum != NULL) {
+			MD5Final(&Md5Context, Checksum, 0);
+		}
+
+		return XST_SUCCESS;
+	}
+#endif
+
+	memcpy((void *)DestinationAddr, (const void *)SourceAddr,
+			(size_t)LengthBytes);
+	if (Checksum != NULL) {
+		md5((u8 *)DestinationAddr, LengthBytes, Checksum, 0);
+	}
+
+	return XST_SUCCESS;
+}
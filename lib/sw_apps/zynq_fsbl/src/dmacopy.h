@@ -0,0 +1,97 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file dmacopy.h
+*
+* This file contains the interface for the PS DMA (PL330) boot copy engine,
+* used to move partitions from linear QSPI/NOR into DDR.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 17.00a esd 10/18/26	Initial release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#ifndef ___DMACOPY_H___
+#define ___DMACOPY_H___
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xparameters.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * The copy engine uses the secure instance of the PS DMA controller, which
+ * is the one the FSBL is allowed to program. Without it, FsblDmaCopy()
+ * falls back to memcpy().
+ */
+#ifdef XPAR_PS7_DMA_S_DEVICE_ID
+#define FSBL_DMA_COPY
+#define DMA_COPY_DEVICE_ID		XPAR_PS7_DMA_S_DEVICE_ID
+#endif
+
+#define DMA_COPY_CHANNEL		0
+/*
+ * Size of one DMA transfer. When a checksum is requested, one chunk is
+ * hashed while the next one is in flight.
+ */
+#define DMA_COPY_CHUNK_SIZE		0x10000
+/* Copies shorter than this are not worth setting up the DMA for */
+#define DMA_COPY_MIN_SIZE		0x1000
+#define DMA_COPY_TIMEOUT		1000000000
+
+/************************** Function Prototypes ******************************/
+
+u32 FsblDmaCopy(u32 SourceAddr, u32 DestinationAddr, u32 LengthBytes,
+		u8 *Checksum);
+
+/************************** Variable Definitions *****************************/
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* ___DMACOPY_H___ */
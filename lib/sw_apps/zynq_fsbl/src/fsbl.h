@@ -238,6 +238,9 @@
 * 16.00a gan 08/02/16   Fix for CR# 955897 -(2016.3)FSBL -
 * 						In pcap.c, check pl power through MCTRL register
 * 						for 3.0 and later versions of silicon.
+* 17.00a esd 10/18/26   Added the PS DMA boot copy engine (dmacopy.c) for
+* 						linear QSPI/NOR, with the partition MD5 checksum
+* 						computed while the copy is in flight.
 * </pre>
 *
 * </pre>
@@ -73,6 +73,10 @@
 * 						fallback image offset handling using MD5
 * 						Fix for PR#782309 Fallback support for AES
 * 						encryption with E-Fuse - Enhancement
+* 17.00a esd 10/18/26	Linear boot devices copy non-secure partitions with
+* 						the PS DMA and compute the MD5 checksum during the
+* 						copy instead of re-reading the partition.
+* 						Per-partition load time reported with FSBL_PERF.
 *
 * </pre>
 *
@@ -82,6 +86,7 @@
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
+#include <string.h>
 #include "fsbl.h"
 #include "image_mover.h"
 #include "xil_printf.h"
@@ -89,6 +94,7 @@
 #include "pcap.h"
 #include "fsbl_hooks.h"
 #include "md5.h"
+#include "dmacopy.h"
 
 #ifdef XPAR_XWDTPS_0_BASEADDR
 #include "xwdtps.h"
@@ -128,6 +134,15 @@ u8 ApplicationFlag;
 u32 ExecutionAddress;
 ImageMoverType MoveImage;
 
+/*
+ * MD5 checksum computed while the current partition was copied, so that
+ * CalcPartitionChecksum() need not read the partition again
+ */
+static u8 CopyChecksum[MD5_CHECKSUM_SIZE];
+static u32 CopyChecksumAddr;
+static u32 CopyChecksumLength;
+static u8 CopyChecksumValid;
+
 /*
  * Header array
  */
@@ -448,12 +463,22 @@ u32 LoadBootImage(void)
 		/*
 		 * Move partitions from boot device
 		 */
+#ifdef FSBL_PERF
+		XTime tPartCur = 0;
+		FsblGetGlobalTime(&tPartCur);
+#endif
 		Status = PartitionMove(ImageStartAddress, HeaderPtr);
 		if (Status != XST_SUCCESS) {
 			fsbl_printf(DEBUG_GENERAL,"PARTITION_MOVE_FAIL\r\n");
 			OutputStatus(PARTITION_MOVE_FAIL);
 			FsblFallback();
 		}
+#ifdef FSBL_PERF
+		XTime tPartEnd = 0;
+		fsbl_printf(DEBUG_GENERAL,"Partition %d (0x%x bytes) loaded in ",
+				PartitionNum, (PartitionTotalSize << WORD_LENGTH_SHIFT));
+		FsblMeasurePerfTime(tPartCur,tPartEnd);
+#endif
 
 		if ((SignedPartitionFlag) || (PartitionChecksumFlag)) {
 			if(PLPartitionFlag) {
@@ -1055,6 +1080,7 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 	LoadAddr = Header->LoadAddr;
 	ImageWordLen = Header->ImageWordLen;
 	DataWordLen = Header->DataWordLen;
+	CopyChecksumValid = 0;
 
 	/*
 	 * Add flash base address for linear boot devices
@@ -1128,17 +1154,38 @@ u32 PartitionMove(u32 ImageBaseAddress, PartHeader *Header)
 			LoadAddr = DDR_TEMP_START_ADDR;
 		}
 
-		/*
-		 * Data transfer using PCAP
-		 */
-		Status = PcapDataTransfer((u32*)SourceAddr,
-						(u32*)LoadAddr,
-						ImageWordLen,
-						DataWordLen,
-						SecureTransferFlag);
-		if(Status != XST_SUCCESS) {
-			fsbl_printf(DEBUG_GENERAL, "PCAP Data Transfer Failed\r\n");
-			return XST_FAILURE;
+		if (LinearBootDeviceFlag && (!SecureTransferFlag)) {
+			/*
+			 * Plain copy from linear flash: use the PS DMA, and
+			 * compute the partition checksum on the way
+			 */
+			Status = FsblDmaCopy(SourceAddr,
+						LoadAddr,
+						(ImageWordLen << WORD_LENGTH_SHIFT),
+						PartitionChecksumFlag ?
+							CopyChecksum : NULL);
+			if(Status != XST_SUCCESS) {
+				fsbl_printf(DEBUG_GENERAL, "DMA Data Transfer Failed\r\n");
+				return XST_FAILURE;
+			}
+			if (PartitionChecksumFlag) {
+				CopyChecksumAddr = LoadAddr;
+				CopyChecksumLength = ImageWordLen << WORD_LENGTH_SHIFT;
+				CopyChecksumValid = 1;
+			}
+		} else {
+			/*
+			 * Data transfer using PCAP
+			 */
+			Status = PcapDataTransfer((u32*)SourceAddr,
+							(u32*)LoadAddr,
+							ImageWordLen,
+							DataWordLen,
+							SecureTransferFlag);
+			if(Status != XST_SUCCESS) {
+				fsbl_printf(DEBUG_GENERAL, "PCAP Data Transfer Failed\r\n");
+				return XST_FAILURE;
+			}
 		}
 
 		/*
@@ -1325,6 +1372,16 @@ u32 GetPartitionChecksum(u32 ChecksumOffset, u8 *Checksum)
 *******************************************************************************/
 u32 CalcPartitionChecksum(u32 SourceAddr, u32 DataLength, u8 *Checksum)
 {
+	/*
+	 * Checksum already computed while the partition was copied
+	 */
+	if (CopyChecksumValid && (CopyChecksumAddr == SourceAddr) &&
+			(CopyChecksumLength == DataLength)) {
+		memcpy(Checksum, CopyChecksum, MD5_CHECKSUM_SIZE);
+		CopyChecksumValid = 0;
+		return XST_SUCCESS;
+	}
+
 	/*
 	 * Calculate checksum using MD5 algorithm
 	 */
@@ -62,6 +62,7 @@
 *                                        command from LQSPI_CFG register
 *					 					 instead of hard coded read
 *					 					 command (0x6B).
+* 17.00a esd 10/18/26 Linear mode reads use the PS DMA copy engine.
 *
 * </pre>
 *
@@ -73,6 +74,7 @@
 
 #include "qspi.h"
 #include "image_mover.h"
+#include "dmacopy.h"
 
 #ifdef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
 #include "xqspips_hw.h"
@@ -499,9 +501,14 @@ u32 QspiAccess( u32 SourceAddress, u32 DestinationAddress, u32 LengthBytes)
 			LengthBytes += (4 - (LengthBytes & 0x00000003));
 		}
 
-		memcpy((void*)DestinationAddress,
-		      (const void*)(SourceAddress + FlashReadBaseAddress),
-		      (size_t)LengthBytes);
+		/*
+		 * PS DMA for anything but short reads
+		 */
+		Status = FsblDmaCopy(SourceAddress + FlashReadBaseAddress,
+				DestinationAddress, LengthBytes, NULL);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
 	} else {
 		/*
 		 * Non Linear access
@@ -67,6 +67,27 @@ extern u8 ReadBuffer[READ_BUFFER_SIZE];
 u8 AuthBuffer[XFSBL_AUTH_BUFFER_SIZE];
 #endif
 
+#ifdef XFSBL_PS_DDR
+#define XFSBL_SHA_STREAM_IDLE		(0U)
+#define XFSBL_SHA_STREAM_ACTIVE		(1U)
+#define XFSBL_SHA_STREAM_DONE		(2U)
+
+/**
+ * SHA3 of a partition computed while it is being copied
+ */
+typedef struct {
+	u32 State;
+	u32 PartitionNum;
+	PTRSIZE DataAddress;
+	u32 DataLen;
+	u32 HashedLen;
+	PTRSIZE AcAddress;
+	u8 Hash[XFSBL_HASH_TYPE_SHA3] __attribute__ ((aligned (4)));
+} XFsbl_ShaStream;
+
+static XFsbl_ShaStream ShaStream;
+#endif
+
 /*****************************************************************************/
 /**
  * Configure the RSA and SHA for the SPK
@@ -198,6 +219,18 @@ u32 XFsbl_PartitionSignVer(XFsblPs *FsblInstancePtr, u64 PartitionOffset,
 	 */
 	HashDataLen = PartitionLen - XFSBL_AUTH_CERT_MIN_SIZE;
 
+#ifdef XFSBL_PS_DDR
+	/* Use the hash calculated while the partition was copied, if any */
+	if ((HashLen == XFSBL_HASH_TYPE_SHA3) &&
+		(XFsbl_ShaStreamGetHash(PartitionNum, PartitionOffset,
+			HashDataLen, PartitionHash) == XFSBL_SUCCESS))
+	{
+		XFsbl_Printf(DEBUG_INFO, "XFsbl_PartitionVer: "
+					"using hash calculated during copy\r\n");
+		goto HASH_DONE;
+	}
+#endif
+
 	/* Start the SHA engine */
 	(void)XFsbl_ShaStart(ShaCtx, HashLen);
 
@@ -243,6 +276,9 @@ u32 XFsbl_PartitionSignVer(XFsblPs *FsblInstancePtr, u64 PartitionOffset,
 
 	XFsbl_ShaFinish(ShaCtx, (u8 *)PartitionHash, HashLen);
 
+#ifdef XFSBL_PS_DDR
+HASH_DONE:
+#endif
 	/* Set SPK pointer */
 	AcPtr += (XFSBL_RSA_AC_ALIGN + XFSBL_PPK_SIZE);
 	SpkModular = (u8 *)AcPtr;
@@ -334,6 +370,115 @@ u32 XFsbl_Authentication(XFsblPs * FsblInstancePtr, u64 PartitionOffset,
 END:
         return Status;
 }
+#ifdef XFSBL_PS_DDR
+/*****************************************************************************/
+/**
+ * Prepares SHA3 calculation of a partition while it is copied. The data is
+ * fed through XFsbl_ShaStreamUpdate and the hash is picked up by
+ * XFsbl_PartitionSignVer.
+ *
+ * @param      PartitionNum - Partition being copied
+ * @param      DataAddress - Load address of the partition data
+ * @param      DataLen - Partition length without the AC
+ * @param      AcAddress - Address of the AC, already copied
+ *
+ * @return     None
+ *
+ ******************************************************************************/
+void XFsbl_ShaStreamStart(u32 PartitionNum, PTRSIZE DataAddress,
+		u32 DataLen, PTRSIZE AcAddress)
+{
+	ShaStream.State = XFSBL_SHA_STREAM_ACTIVE;
+	ShaStream.PartitionNum = PartitionNum;
+	ShaStream.DataAddress = DataAddress;
+	ShaStream.DataLen = DataLen;
+	ShaStream.HashedLen = 0U;
+	ShaStream.AcAddress = AcAddress;
+}
+
+/*****************************************************************************/
+/**
+ * Chunk handler for the boot device copy. Chunks have to arrive in order;
+ * anything else drops the streamed hash and validation hashes the
+ * partition as before.
+ *
+ * @param      CallBackRef - Unused
+ * @param      ChunkAddress - Start of the chunk
+ * @param      ChunkLength - Length of the chunk
+ *
+ * @return     None
+ *
+ ******************************************************************************/
+void XFsbl_ShaStreamUpdate(void *CallBackRef, PTRSIZE ChunkAddress,
+		u32 ChunkLength)
+{
+	(void)CallBackRef;
+
+	if ((ShaStream.State != XFSBL_SHA_STREAM_ACTIVE) ||
+		(ChunkAddress != (ShaStream.DataAddress + ShaStream.HashedLen)) ||
+		(ChunkLength > (ShaStream.DataLen - ShaStream.HashedLen)))
+	{
+		ShaStream.State = XFSBL_SHA_STREAM_IDLE;
+		goto END;
+	}
+
+	if (ShaStream.HashedLen == 0U)
+	{
+		XFsbl_ShaStart(NULL, XFSBL_HASH_TYPE_SHA3);
+	}
+
+	XFsbl_ShaUpdate(NULL, (u8 *)ChunkAddress, ChunkLength,
+			XFSBL_HASH_TYPE_SHA3);
+	ShaStream.HashedLen += ChunkLength;
+
+	if (ShaStream.HashedLen == ShaStream.DataLen)
+	{
+		/* Calculate hash for (AC - signature size) */
+		XFsbl_ShaUpdate(NULL, (u8 *)ShaStream.AcAddress,
+			(XFSBL_AUTH_CERT_MIN_SIZE - XFSBL_FSBL_SIG_SIZE),
+			XFSBL_HASH_TYPE_SHA3);
+		XFsbl_ShaFinish(NULL, ShaStream.Hash, XFSBL_HASH_TYPE_SHA3);
+		ShaStream.State = XFSBL_SHA_STREAM_DONE;
+	}
+
+END:
+	return;
+}
+
+/*****************************************************************************/
+/**
+ * Returns the hash calculated during the copy if it covers the given
+ * partition data. The streamed hash is consumed either way.
+ *
+ * @param      PartitionNum - Partition number
+ * @param      PartitionOffset - Load address of the partition data
+ * @param      DataLen - Partition length without the AC
+ * @param      Hash - Pointer to store hash
+ *
+ * @return     XFSBL_SUCCESS - Hash is valid
+ *             XFSBL_FAILURE - No matching hash, calculate it
+ *
+ ******************************************************************************/
+u32 XFsbl_ShaStreamGetHash(u32 PartitionNum, u64 PartitionOffset,
+		u32 DataLen, u8 *Hash)
+{
+	u32 Status = XFSBL_FAILURE;
+
+	if ((ShaStream.State == XFSBL_SHA_STREAM_DONE) &&
+		(ShaStream.PartitionNum == PartitionNum) &&
+		((u64)ShaStream.DataAddress == PartitionOffset) &&
+		(ShaStream.DataLen == DataLen))
+	{
+		(void)XFsbl_MemCpy(Hash, ShaStream.Hash, XFSBL_HASH_TYPE_SHA3);
+		Status = XFSBL_SUCCESS;
+	}
+
+	ShaStream.State = XFSBL_SHA_STREAM_IDLE;
+
+	return Status;
+}
+#endif
+
 #ifndef XFSBL_PS_DDR
 #ifdef XFSBL_BS
 /*****************************************************************************/
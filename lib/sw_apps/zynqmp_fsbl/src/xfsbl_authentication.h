@@ -141,6 +141,15 @@ void XFsbl_ShaDigest(const u8 *In, const u32 Size, u8 *Out, u32 HashLen);
 void XFsbl_ShaStart(void * Ctx, u32 HashLen);
 void XFsbl_ShaUpdate(void * Ctx, u8 * Data, u32 Size, u32 HashLen);
 void XFsbl_ShaFinish(void * Ctx, u8 * Hash, u32 HashLen);
+
+#ifdef XFSBL_PS_DDR
+void XFsbl_ShaStreamStart(u32 PartitionNum, PTRSIZE DataAddress,
+		u32 DataLen, PTRSIZE AcAddress);
+void XFsbl_ShaStreamUpdate(void *CallBackRef, PTRSIZE ChunkAddress,
+		u32 ChunkLength);
+u32 XFsbl_ShaStreamGetHash(u32 PartitionNum, u64 PartitionOffset,
+		u32 DataLen, u8 *Hash);
+#endif
 #endif
 
 
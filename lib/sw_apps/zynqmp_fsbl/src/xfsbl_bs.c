@@ -43,6 +43,9 @@
  * Ver   Who  Date        Changes
  * ----- ---- -------- -------------------------------------------------------
  * 1.00  ba   11/17/14 Initial release
+ * 2.00  esd  10/18/26 Split PCAP writes into start and wait. Chunked
+ *                     transfers read the next chunk while PCAP takes
+ *                     the current one
  *
  * </pre>
  *
@@ -158,7 +161,8 @@ static u32 XFsbl_PcapWaitForDone() {
 }
 
 /*****************************************************************************/
-/** This is the function to write data to PCAP interface
+/** This function starts writing data to PCAP interface and returns without
+ * waiting for the transfer to complete
  *
  * @param	WrSize: Number of 32bit words that the DMA should write to
  *          the PCAP interface
@@ -167,10 +171,12 @@ static u32 XFsbl_PcapWaitForDone() {
  *
  * @return	None
  *
+ * @note	WrAddr must not be modified until XFsbl_WriteToPcapWait()
+ *		returns. CSU DMA source channel is busy till then.
+ *
  *****************************************************************************/
-u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
+void XFsbl_WriteToPcapStart(u32 WrSize, u8 *WrAddr) {
 	u32 RegVal;
-	u32 Status = XFSBL_SUCCESS;
 
 	/*
 	 * Setup the  SSS, setup the PCAP to receive from DMA source
@@ -182,6 +188,39 @@ u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
 
 	/* Setup the source DMA channel */
 	XCsuDma_Transfer(&CsuDma, XCSUDMA_SRC_CHANNEL, (PTRSIZE) WrAddr, WrSize, 0);
+}
+
+/*****************************************************************************/
+/** This function checks, without blocking, whether the CSU DMA has finished
+ * the transfer started by XFsbl_WriteToPcapStart
+ *
+ * @param	None
+ *
+ * @return	TRUE if the source DMA done interrupt is pending, else FALSE
+ *
+ *****************************************************************************/
+u32 XFsbl_WriteToPcapIsDone(void) {
+	u32 Status = FALSE;
+
+	if ((XCsuDma_IntrGetStatus(&CsuDma, XCSUDMA_SRC_CHANNEL) &
+			XCSUDMA_IXR_DONE_MASK) == XCSUDMA_IXR_DONE_MASK) {
+		Status = TRUE;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/** This function waits for the transfer started by XFsbl_WriteToPcapStart
+ * to complete
+ *
+ * @param	None
+ *
+ * @return	error status based on implemented functionality (SUCCESS by default)
+ *
+ *****************************************************************************/
+u32 XFsbl_WriteToPcapWait(void) {
+	u32 Status = XFSBL_SUCCESS;
 
 	/* wait for the SRC_DMA to complete and the pcap to be IDLE */
 	XCsuDma_WaitForDone(&CsuDma, XCSUDMA_SRC_CHANNEL);
@@ -191,11 +230,26 @@ u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
 
 	XFsbl_Printf(DEBUG_INFO, "DMA transfer done \r\n");
 	Status = XFsbl_PcapWaitForDone();
-	if (Status != XFSBL_SUCCESS) {
-		goto END;
-	}
 
-	END: return Status;
+	return Status;
+}
+
+/*****************************************************************************/
+/** This is the function to write data to PCAP interface
+ *
+ * @param	WrSize: Number of 32bit words that the DMA should write to
+ *          the PCAP interface
+ * @param   WrAddr: Linear memory space from where CSUDMA will read
+ *	        the data to be written to PCAP interface
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr) {
+
+	XFsbl_WriteToPcapStart(WrSize, WrAddr);
+
+	return XFsbl_WriteToPcapWait();
 }
 
 /*****************************************************************************/
@@ -248,6 +302,9 @@ u32 XFsbl_PLWaitForDone(void) {
 
 /*****************************************************************************/
 /** This is the function to download nonsebitstream to PL using chunking.
+ *
+ * ReadBuffer is used as two halves. While CSU DMA sends one half to PCAP,
+ * the next chunk is read from flash into the other half.
  *
  * @param	None
  *
@@ -259,13 +316,14 @@ u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum)
 {
 	u32 Status = XFSBL_SUCCESS;
 	XFsblPs_PartitionHeader *PartitionHeader;
-	u32 NumChunks = 0U;
-	u32 RemainingBytes = 0U;
-	u32 Index = 0U;
 	u32 BitStreamSizeWord = 0U;
 	u32 BitStreamSizeByte = 0U;
 	u32 ImageOffset = 0U;
 	u32 StartAddrByte = 0U;
+	u32 ChunkSize = 0U;
+	u32 Half = 0U;
+	u32 PcapBusy = FALSE;
+	u8 *ChunkBuffer;
 
 	XFsbl_Printf(DEBUG_GENERAL,
 		"Nonsecure Bitstream transfer in chunks to begin now\r\n");
@@ -288,14 +346,20 @@ u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum)
 	/* Converting size in words to bytes */
 	BitStreamSizeByte = BitStreamSizeWord*4;
 
-	NumChunks = BitStreamSizeByte / READ_BUFFER_SIZE;
-	RemainingBytes = BitStreamSizeByte % READ_BUFFER_SIZE;
-
-	for(Index = 0; Index < NumChunks; Index++)
+	while (BitStreamSizeByte != 0U)
 	{
-		Status = FsblInstancePtr->DeviceOps.DeviceCopy(StartAddrByte,
-				(PTRSIZE)ReadBuffer, READ_BUFFER_SIZE);
+		ChunkSize = READ_BUFFER_SIZE/2U;
+		if (ChunkSize > BitStreamSizeByte)
+		{
+			ChunkSize = BitStreamSizeByte;
+		}
+		ChunkBuffer = &ReadBuffer[Half * (READ_BUFFER_SIZE/2U)];
 
+		/**
+		 * The previous chunk is still going to PCAP from the other half
+		 */
+		Status = FsblInstancePtr->DeviceOps.DeviceCopy(StartAddrByte,
+				(PTRSIZE)ChunkBuffer, ChunkSize);
 		if (XFSBL_SUCCESS != Status)
 		{
 			XFsbl_Printf(DEBUG_GENERAL,
@@ -303,30 +367,37 @@ u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum)
 			goto END;
 		}
 
-		Status = XFsbl_WriteToPcap((READ_BUFFER_SIZE/4), &ReadBuffer[0]);
-		if (XFSBL_SUCCESS != Status)
+		if (PcapBusy == TRUE)
 		{
-			goto END;
+			PcapBusy = FALSE;
+			Status = XFsbl_WriteToPcapWait();
+			if (XFSBL_SUCCESS != Status)
+			{
+				goto END;
+			}
 		}
 
-		StartAddrByte += READ_BUFFER_SIZE;
+		XFsbl_WriteToPcapStart((ChunkSize/4U), ChunkBuffer);
+		PcapBusy = TRUE;
+
+		StartAddrByte += ChunkSize;
+		BitStreamSizeByte -= ChunkSize;
+		Half ^= 1U;
 	}
 
-	if(RemainingBytes != 0U)
+END:
+	if (PcapBusy == TRUE)
 	{
-		Status = FsblInstancePtr->DeviceOps.DeviceCopy(StartAddrByte,
-					(PTRSIZE)ReadBuffer, RemainingBytes);
-		if (XFSBL_SUCCESS != Status)
+		if (XFSBL_SUCCESS == Status)
 		{
-			XFsbl_Printf(DEBUG_GENERAL,
-				"Copy of chunk from flash to OCM failed \r\n");
-			goto END;
+			Status = XFsbl_WriteToPcapWait();
+		}
+		else
+		{
+			(void)XFsbl_WriteToPcapWait();
 		}
-
-		Status = XFsbl_WriteToPcap((RemainingBytes/4), &ReadBuffer[0]);
 	}
 
-END:
 	return Status;
 }
 #endif
@@ -44,6 +44,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  ba   11/17/14 Initial release
+* 2.00  esd  10/18/26 Split PCAP writes into start and wait
 *
 * </pre>
 *
@@ -83,6 +84,9 @@ u32 XFsbl_ChunkedBSTxfer(XFsblPs *FsblInstancePtr, u32 PartitionNum);
 u32 XFsbl_PcapInit(void);
 u32 XFsbl_PLWaitForDone(void);
 u32 XFsbl_WriteToPcap(u32 WrSize, u8 *WrAddr);
+void XFsbl_WriteToPcapStart(u32 WrSize, u8 *WrAddr);
+u32 XFsbl_WriteToPcapIsDone(void);
+u32 XFsbl_WriteToPcapWait(void);
 
 /************************** Variable Definitions *****************************/
 
@@ -44,6 +44,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   10/21/13 Initial release
+* 2.00  esd  10/18/26 Added FSBL_BS_OVERLAP_EXCLUDE
 *
 * </pre>
 *
@@ -123,6 +124,8 @@ extern "C" {
  *     - FSBL_SECURE_EXCLUDE Secure features
  *     			(authentication, decryption, checksum) will be excluded
  *     - FSBL_BS_EXCLUDE PL bitstream code will be excluded
+ *     - FSBL_BS_OVERLAP_EXCLUDE Loading of later partitions will not
+ *       overlap the PCAP download of a non secure bitstream
  *     - FSBL_SHA2_EXCLUDE SHA2 code will be excluded
  *     - FSBL_EARLY_HANDOFF_EXCLUDE Early handoff related code will be excluded
  *     - FSBL_WDT_EXCLUDE WDT code will be excluded
@@ -134,6 +137,7 @@ extern "C" {
 #define FSBL_SD_EXCLUDE_VAL			(0U)
 #define FSBL_SECURE_EXCLUDE_VAL			(0U)
 #define FSBL_BS_EXCLUDE_VAL				(0U)
+#define FSBL_BS_OVERLAP_EXCLUDE_VAL		(0U)
 #define FSBL_SHA2_EXCLUDE_VAL			(1U)
 #define FSBL_EARLY_HANDOFF_EXCLUDE_VAL	(1U)
 #define FSBL_WDT_EXCLUDE_VAL			(0U)
@@ -160,6 +164,10 @@ extern "C" {
 #define FSBL_BS_EXCLUDE
 #endif
 
+#if FSBL_BS_OVERLAP_EXCLUDE_VAL
+#define FSBL_BS_OVERLAP_EXCLUDE
+#endif
+
 #if FSBL_SHA2_EXCLUDE_VAL
 #define FSBL_SHA2_EXCLUDE
 #endif
@@ -736,6 +736,15 @@ extern "C" {
 #define XFSBL_PS_DDR
 #endif
 
+/**
+ * Definition for overlapping the PCAP download of a bitstream with the
+ * loading of the partitions after it
+ */
+#if defined(XFSBL_BS) && defined(XFSBL_PS_DDR) && \
+		!defined(FSBL_BS_OVERLAP_EXCLUDE)
+#define XFSBL_BS_OVERLAP
+#endif
+
 #define XFSBL_PS_DDR_START_ADDRESS		(0x0U)
 #define XFSBL_PS_DDR_START_ADDRESS_R5	(0x100000U)
 
@@ -43,6 +43,9 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   10/21/13 Initial release
+* 2.00  esd  10/18/26 Read partition headers from the image index when
+*                     it is present and matches the image header table
+*                     and the first and last partition headers in flash
 *
 * </pre>
 *
@@ -109,6 +112,8 @@ u32 XFsbl_GetA53ExecState(XFsblPs_PartitionHeader * PartitionHeader)
 static u32 XFsbl_ValidateImageHeaderTable(
 		XFsblPs_ImageHeaderTable * ImageHeaderTable);
 static u32 XFsbl_CheckValidMemoryAddress(u64 Address, u32 CpuId, u32 DevId);
+static u32 XFsbl_ReadImageIndex(XFsblPs_ImageHeader * ImageHeader,
+		XFsblPs_DeviceOps * DeviceOps, u32 FlashImageOffsetAddress);
 static void XFsbl_SetATFHandoffParameters(
 		XFsblPs_PartitionHeader *PartitionHeader, u32 EntryCount);
 
@@ -260,6 +265,153 @@ END:
 	return Status;
 }
 
+/****************************************************************************/
+/**
+ * This function reads all the partition headers from the image index with
+ * a single flash read. The index is used only if it was built for this
+ * image header table and its first and last entries are the same as the
+ * first and last partition headers in flash, so an index left behind by an
+ * older image is ignored and the caller walks the partition header chain
+ * instead.
+ *
+ * @param ImageHeader pointer to the image header with a validated image
+ * header table
+ *
+ * @param DeviceOps pointer deviceops structure which contains the
+ * function pointer to flash read function
+ *
+ * @param FlashImageOffsetAddress base offset to the image in the flash
+ *
+ * @return
+ * 	- XFSBL_SUCCESS if the partition headers were read from the index
+ * 	- XFSBL_FAILURE if there is no index or it is stale
+ *
+ * @note Each entry is still checked against its own checksum when the
+ * partition is loaded.
+ *****************************************************************************/
+static u32 XFsbl_ReadImageIndex(XFsblPs_ImageHeader * ImageHeader,
+		XFsblPs_DeviceOps * DeviceOps, u32 FlashImageOffsetAddress)
+{
+	u32 Status = XFSBL_FAILURE;
+	u32 ImageIndexOffset = 0U;
+	XFsblPs_ImageIndex ImageIndex;
+	u32 *EntryWord;
+	u32 EntryChecksum = 0U;
+	u32 NoOfPartitions;
+	u32 Count;
+	u32 Entry;
+	u32 PartitionHeaderAddress;
+	XFsblPs_PartitionHeader PartitionHeader;
+
+	NoOfPartitions = ImageHeader->ImageHeaderTable.NoOfPartitions;
+
+	/**
+	 * Read the image index offset from the boot header
+	 */
+	if (DeviceOps->DeviceCopy(FlashImageOffsetAddress
+			+ XIH_BH_IMAGE_INDEX_OFFSET,
+			(PTRSIZE ) &ImageIndexOffset, XIH_FIELD_LEN) != XFSBL_SUCCESS)
+	{
+		goto END;
+	}
+
+	if ((ImageIndexOffset == 0U) || (ImageIndexOffset == XIH_IDX_NONE))
+	{
+		goto END;
+	}
+
+	/**
+	 * Read the index header. The entries are read after it has been
+	 * checked, in one go, straight into the partition header array.
+	 */
+	if (DeviceOps->DeviceCopy(FlashImageOffsetAddress + ImageIndexOffset,
+			(PTRSIZE ) &ImageIndex, XIH_IDX_LEN) != XFSBL_SUCCESS)
+	{
+		goto END;
+	}
+
+	if ((ImageIndex.Magic != XIH_IDX_MAGIC) ||
+		(ImageIndex.Version != XIH_IDX_VERSION) ||
+		(ImageIndex.NoOfEntries != NoOfPartitions) ||
+		(ImageIndex.IhtChecksum !=
+			ImageHeader->ImageHeaderTable.Checksum) ||
+		(XFsbl_ValidateChecksum((u32 *)&ImageIndex,
+			XIH_IDX_LEN/XIH_PARTITION_WORD_LENGTH) != XFSBL_SUCCESS))
+	{
+		XFsbl_Printf(DEBUG_INFO,"Image index stale, ignored \n\r");
+		goto END;
+	}
+
+	if (DeviceOps->DeviceCopy(FlashImageOffsetAddress + ImageIndexOffset
+			+ XIH_IDX_LEN,
+			(PTRSIZE ) &(ImageHeader->PartitionHeader[0]),
+			NoOfPartitions * XIH_PH_LEN) != XFSBL_SUCCESS)
+	{
+		goto END;
+	}
+
+	/**
+	 * EntriesChecksum = ~(X1 + X2 + X3 + .... + Xn) over all the entries
+	 */
+	EntryWord = (u32 *)&(ImageHeader->PartitionHeader[0]);
+	for (Count = 0U;
+		Count < ((NoOfPartitions * XIH_PH_LEN)/XIH_PARTITION_WORD_LENGTH);
+		Count++)
+	{
+		EntryChecksum += EntryWord[Count];
+	}
+	EntryChecksum ^= 0xFFFFFFFFU;
+
+	if (EntryChecksum != ImageIndex.EntriesChecksum)
+	{
+		XFsbl_Printf(DEBUG_GENERAL,"Image index entries checksum "
+				"0x%0lx != %0lx, ignored \n\r",
+				EntryChecksum, ImageIndex.EntriesChecksum);
+		goto END;
+	}
+
+	/**
+	 * Bind the index to the partition headers it was built from. The
+	 * IHT checksum does not cover them, so compare the first partition
+	 * header, and the last one found through the index, with flash.
+	 */
+	Entry = 0U;
+	PartitionHeaderAddress =
+		(ImageHeader->ImageHeaderTable.PartitionHeaderAddress)
+			* XIH_PARTITION_WORD_LENGTH;
+	for (Count = 0U; Count < 2U; Count++)
+	{
+		if (DeviceOps->DeviceCopy(FlashImageOffsetAddress
+				+ PartitionHeaderAddress,
+				(PTRSIZE ) &PartitionHeader,
+				XIH_PH_LEN) != XFSBL_SUCCESS)
+		{
+			goto END;
+		}
+
+		if (XFsbl_MemCmp(&PartitionHeader,
+				&(ImageHeader->PartitionHeader[Entry]),
+				XIH_PH_LEN) != 0)
+		{
+			XFsbl_Printf(DEBUG_INFO,"Image index entry %d does not "
+					"match flash, ignored \n\r", Entry);
+			goto END;
+		}
+
+		Entry = NoOfPartitions - 1U;
+		PartitionHeaderAddress =
+			(ImageHeader->PartitionHeader[Entry - 1U].NextPartitionOffset)
+				* XIH_PARTITION_WORD_LENGTH;
+	}
+
+	XFsbl_Printf(DEBUG_INFO,"Image index at 0x%0lx used \n\r",
+			ImageIndexOffset);
+	Status = XFSBL_SUCCESS;
+
+END:
+	return Status;
+}
+
 /****************************************************************************/
 /**
  * This function reads the image header from flash device. Image header
@@ -334,6 +486,17 @@ u32 XFsbl_ReadImageHeader(XFsblPs_ImageHeader * ImageHeader,
 		goto END;
 	}
 
+	/**
+	 * Take all the partition headers from the image index if there is
+	 * a valid one, otherwise walk the partition header chain
+	 */
+	ImageHeader->IndexValid = FALSE;
+	if (XFsbl_ReadImageIndex(ImageHeader, DeviceOps,
+			FlashImageOffsetAddress) == XFSBL_SUCCESS)
+	{
+		ImageHeader->IndexValid = TRUE;
+	}
+
 	/**
 	 * Update the first partition address
 	 */
@@ -355,14 +518,17 @@ u32 XFsbl_ReadImageHeader(XFsblPs_ImageHeader * ImageHeader,
 		 * Read the Image header table of 64 bytes
 		 * and update the image header table structure
 		 */
-		Status = DeviceOps->DeviceCopy(
-	                FlashImageOffsetAddress + PartitionHeaderAddress,
-		(PTRSIZE ) &(ImageHeader->PartitionHeader[PartitionIndex]),
-			XIH_PH_LEN);
-		if (XFSBL_SUCCESS != Status)
+		if (ImageHeader->IndexValid != TRUE)
 		{
-			XFsbl_Printf(DEBUG_GENERAL,"Device Copy Failed \n\r");
-			goto END;
+			Status = DeviceOps->DeviceCopy(
+				FlashImageOffsetAddress + PartitionHeaderAddress,
+			(PTRSIZE ) &(ImageHeader->PartitionHeader[PartitionIndex]),
+				XIH_PH_LEN);
+			if (XFSBL_SUCCESS != Status)
+			{
+				XFsbl_Printf(DEBUG_GENERAL,"Device Copy Failed \n\r");
+				goto END;
+			}
 		}
 
 #if 0
@@ -43,6 +43,7 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   10/21/13 Initial release
+* 2.00  esd  10/18/26 Added the image index
 *
 * </pre>
 *
@@ -75,6 +76,7 @@ extern "C" {
 #define XIH_BH_IMAGE_ATTRB_OFFSET	(0x44U)
 #define XIH_BH_IH_TABLE_OFFSET		(0x98U)
 #define XIH_BH_PH_TABLE_OFFSET		(0x9CU)
+#define XIH_BH_IMAGE_INDEX_OFFSET	(0x94U)
 
 #define XIH_BH_IMAGE_ATTRB_RSA_MASK	(0xC000U)
 #define XIH_BH_IMAGE_ATTRB_SHA2_MASK	(0x3000U)
@@ -88,6 +90,7 @@ extern "C" {
 #define XIH_PFW_LEN_FIELD_LEN		(4U)
 #define XIH_IHT_LEN				(64U)
 #define XIH_PH_LEN				(64U)
+#define XIH_IDX_LEN				(64U)
 
 /**
  * Image header table field offsets
@@ -115,6 +118,18 @@ extern "C" {
 #define XIH_PH_AUTHCERTIFICATE_OFFSET			(0x34U)
 #define XIH_PH_CHECKSUM					(0x3CU)
 
+/**
+ * Image index fields
+ *
+ * The index is optional. Its offset from the start of the image is kept
+ * in the last user defined word of the boot header, 0x0 or 0xFFFFFFFF
+ * meaning there is none. The 64 byte index header is followed by a copy of
+ * every partition header, in the same order as the partition header chain.
+ */
+#define XIH_IDX_MAGIC				(0x58444958U) /* "XIDX" */
+#define XIH_IDX_VERSION				(0x1U)
+#define XIH_IDX_NONE				(0xFFFFFFFFU)
+
 /**
  * Partition Present Devices(PPD) in IHT
  */
@@ -254,8 +269,24 @@ typedef struct {
 		/**< Image header table structure */
 	XFsblPs_PartitionHeader PartitionHeader[XIH_MAX_PARTITIONS];
 		/**< Partition header */
+	u32 IndexValid;
+		/**< TRUE when partition headers were read from the image index */
 } XFsblPs_ImageHeader;
 
+/**
+ * Structure of the image index header. It is followed in flash by
+ * NoOfEntries partition headers.
+ */
+typedef struct {
+	u32 Magic; /**< XIH_IDX_MAGIC */
+	u32 Version; /**< Index format version */
+	u32 NoOfEntries; /**< Must match the IHT partition count */
+	u32 IhtChecksum; /**< Checksum of the IHT the index was built for */
+	u32 EntriesChecksum; /**< Word checksum of all the entries */
+	u32 Reserved[10]; /**< Reserved */
+	u32 Checksum; /**< Checksum of the index header */
+} XFsblPs_ImageIndex;
+
 /* Structure corresponding to each partition entry */
 typedef struct {
 	u64 EntryPoint;
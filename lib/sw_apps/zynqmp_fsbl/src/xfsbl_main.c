@@ -44,6 +44,7 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   10/21/13 Initial release
 * 1.00  ba   02/22/16 Added performance measurement feature.
+* 2.00  esd  10/18/26 Complete background bitstream download before handoff
 *
 * </pre>
 *
@@ -246,6 +247,19 @@ int main(void )
 				XFsbl_Printf(DEBUG_INFO,
 						"================= In Stage 4 ============ \n\r");
 
+				/**
+				 * PL must be configured before any application runs
+				 */
+				FsblStatus = XFsbl_PartitionLoadWait();
+				if (XFSBL_SUCCESS != FsblStatus)
+				{
+					XFsbl_Printf(DEBUG_GENERAL,"Bitstream Load Failed, "
+							"0x%0lx\n\r", FsblStatus);
+					FsblStatus += XFSBL_ERROR_STAGE_3;
+					FsblStage = XFSBL_STAGE_ERR;
+					break;
+				}
+
 				/**
 				 * Handoff to the applications
 				 * Handoff address
@@ -201,6 +201,7 @@ u32 XFsbl_TcmEccInit(XFsblPs * FsblInstancePtr, u32 CpuId);
  * Functions defined in xfsbl_partition_load.c
  */
 u32 XFsbl_PartitionLoad(XFsblPs * FsblInstancePtr, u32 PartitionNum);
+u32 XFsbl_PartitionLoadWait(void);
 u32 XFsbl_PowerUpMemory(u32 MemoryType);
 u32 XFsbl_CalcualteCheckSum(XFsblPs * FsblInstancePtr,
 		PTRSIZE LoadAddress, u32 PartitionNum);
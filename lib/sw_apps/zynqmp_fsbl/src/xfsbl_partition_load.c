@@ -43,6 +43,11 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  kc   10/21/13 Initial release
+* 2.00  esd  10/18/26 Hash authenticated partitions while QSPI copies them
+*       esd  10/18/26 Coalesce copies of adjacent partitions listed in the
+*                     image index
+*       esd  10/18/26 Load later partitions while PCAP takes a non secure
+*                     bitstream
 *
 * </pre>
 *
@@ -58,6 +63,7 @@
 #include "xfsbl_hooks.h"
 #include "xfsbl_authentication.h"
 #include "xfsbl_bs.h"
+#include "xfsbl_qspi.h"
 #include "psu_init.h"
 /************************** Constant Definitions *****************************/
 
@@ -79,11 +85,21 @@ static u32 XFsbl_ConfigureMemory(XFsblPs * FsblInstancePtr, u32 RunningCpu,
 u32 XFsbl_GetLoadAddress(u32 DestinationCpu, PTRSIZE * LoadAddressPtr,
 		u32 Length);
 static void XFsbl_CheckPmuFw(XFsblPs * FsblInstancePtr, u32 PartitionNum);
+static u32 XFsbl_IsPlainDdrPartition(XFsblPs * FsblInstancePtr,
+		XFsblPs_PartitionHeader * PartitionHeader);
+#ifdef XFSBL_BS
+static u32 XFsbl_PLConfigComplete(void);
+#endif
+#ifdef XFSBL_BS_OVERLAP
+static u32 XFsbl_NeedsPcapIdle(XFsblPs_PartitionHeader * PartitionHeader);
+#endif
 
 /************************** Variable Definitions *****************************/
 u8 TcmVectorArray[32];
 u32 TcmSkipLength=0U;
 PTRSIZE TcmSkipAddress=0U;
+/* Partitions below this number were already copied by a coalesced copy */
+static u32 CoalescedPartitionEnd=0U;
 #ifdef XFSBL_SECURE
 static XSecure_Aes SecureAes;
 extern u8 AuthBuffer[XFSBL_AUTH_BUFFER_SIZE];
@@ -92,6 +108,14 @@ extern u8 AuthBuffer[XFSBL_AUTH_BUFFER_SIZE];
 #if !defined(XFSBL_PS_DDR) && defined(XFSBL_BS)
 extern u8 ReadBuffer[READ_BUFFER_SIZE];
 #endif
+
+#ifdef XFSBL_BS_OVERLAP
+/* Non secure bitstream still being sent to PCAP by CSU DMA */
+static u32 PcapPending=FALSE;
+static u32 PcapPartitionNum=0U;
+static PTRSIZE PcapAddress=0U;
+static u32 PcapLength=0U;
+#endif
 /*****************************************************************************/
 /**
  * This function loads the partition
@@ -138,6 +162,24 @@ u32 XFsbl_PartitionLoad(XFsblPs * FsblInstancePtr, u32 PartitionNum)
 		 */
 	}
 
+#ifdef XFSBL_BS_OVERLAP
+	/**
+	 * Finish the bitstream download first if it is already done, or if
+	 * this partition needs CSU DMA or would overwrite the bitstream
+	 */
+	if ((PcapPending == TRUE) &&
+		((XFsbl_WriteToPcapIsDone() == TRUE) ||
+		(XFsbl_NeedsPcapIdle(&FsblInstancePtr->ImageHeader.
+				PartitionHeader[PartitionNum]) == TRUE)))
+	{
+		Status = XFsbl_PartitionLoadWait();
+		if (XFSBL_SUCCESS != Status)
+		{
+			goto END;
+		}
+	}
+#endif
+
 	/**
 	 * Partition Copy
 	 */
@@ -163,6 +205,95 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * This function completes the partition load still running in the
+ * background, which is the PCAP download of a non secure bitstream.
+ * It has to be called before handing off to any application.
+ *
+ * @return	returns the error codes described in xfsbl_error.h on any error
+ * 			returns XFSBL_SUCCESS on success or if nothing is pending
+ *
+ *****************************************************************************/
+u32 XFsbl_PartitionLoadWait(void)
+{
+	u32 Status=XFSBL_SUCCESS;
+
+#ifdef XFSBL_BS_OVERLAP
+	if (PcapPending == TRUE)
+	{
+		PcapPending = FALSE;
+
+		Status = XFsbl_WriteToPcapWait();
+		if (Status != XFSBL_SUCCESS) {
+			goto END;
+		}
+
+		XFsbl_Printf(DEBUG_INFO,"P%u bitstream download complete\r\n",
+				PcapPartitionNum);
+
+		Status = XFsbl_PLConfigComplete();
+	}
+
+END:
+#endif
+	return Status;
+}
+
+#ifdef XFSBL_BS_OVERLAP
+/*****************************************************************************/
+/**
+ * This function checks whether a partition can be loaded while CSU DMA is
+ * still sending a bitstream to PCAP
+ *
+ * @param	PartitionHeader is pointer to the partition header
+ *
+ * @return	TRUE if the PCAP download has to be finished first
+ *
+ *****************************************************************************/
+static u32 XFsbl_NeedsPcapIdle(XFsblPs_PartitionHeader * PartitionHeader)
+{
+	u32 Status = FALSE;
+	u64 Length;
+	u32 ChecksumType;
+
+	Length = (u64)PartitionHeader->TotalDataWordLength *
+			XIH_PARTITION_WORD_LENGTH;
+	ChecksumType = XFsbl_GetChecksumType(PartitionHeader);
+
+	/**
+	 * AES, SHA3, RSA and PCAP all sit behind CSU DMA
+	 */
+	if ((XFsbl_IsRsaSignaturePresent(PartitionHeader) ==
+			XIH_PH_ATTRB_RSA_SIGNATURE) ||
+		(XFsbl_IsEncrypted(PartitionHeader) ==
+			XIH_PH_ATTRB_ENCRYPTION) ||
+		(XFsbl_GetDestinationDevice(PartitionHeader) ==
+			XIH_PH_ATTRB_DEST_DEVICE_PL) ||
+		((ChecksumType != XIH_PH_ATTRB_NOCHECKSUM) &&
+			(ChecksumType != XIH_PH_ATTRB_CHECKSUM_MD5)))
+	{
+		Status = TRUE;
+		goto END;
+	}
+
+	/**
+	 * The bitstream is read from DDR, so it must not be overwritten
+	 */
+	if ((Length != 0U) &&
+		(PartitionHeader->DestinationLoadAddress <
+			((u64)PcapAddress + PcapLength)) &&
+		((PartitionHeader->DestinationLoadAddress + Length) >
+			(u64)PcapAddress))
+	{
+		Status = TRUE;
+	}
+
+END:
+	return Status;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * This function validates the partition header
@@ -711,6 +842,58 @@ END:
 }
 
 
+/*****************************************************************************/
+/**
+ * This function checks whether a partition can share one flash read with
+ * its neighbours. Only partitions that are copied verbatim to PS DDR
+ * qualify, so nothing between the header checks and the copy itself has
+ * to run for them.
+ *
+ * @param	FsblInstancePtr is pointer to the XFsbl Instance
+ *
+ * @param	PartitionHeader is pointer to the partition header
+ *
+ * @return	TRUE if the partition can be coalesced, FALSE otherwise
+ *
+ *****************************************************************************/
+static u32 XFsbl_IsPlainDdrPartition(XFsblPs * FsblInstancePtr,
+		XFsblPs_PartitionHeader * PartitionHeader)
+{
+	u32 Status = FALSE;
+#ifdef XFSBL_PS_DDR
+	u64 Length;
+
+	Length = (u64)PartitionHeader->TotalDataWordLength *
+			XIH_PARTITION_WORD_LENGTH;
+
+	if ((XFsbl_ValidateChecksum((u32 *)PartitionHeader,
+			XIH_PH_LEN/4U) == XFSBL_SUCCESS) &&
+		(XFsbl_GetPartitionOwner(PartitionHeader) ==
+			XIH_PH_ATTRB_PART_OWNER_FSBL) &&
+		(XFsbl_ValidatePartitionHeader(PartitionHeader,
+			FsblInstancePtr->ProcessorID) == XFSBL_SUCCESS) &&
+		(XFsbl_IsRsaSignaturePresent(PartitionHeader) !=
+			XIH_PH_ATTRB_RSA_SIGNATURE) &&
+		(XFsbl_IsEncrypted(PartitionHeader) !=
+			XIH_PH_ATTRB_ENCRYPTION) &&
+		(XFsbl_GetDestinationDevice(PartitionHeader) ==
+			XIH_PH_ATTRB_DEST_DEVICE_PS) &&
+		(Length != 0U) &&
+		(PartitionHeader->DestinationLoadAddress >=
+			XFSBL_PS_DDR_INIT_START_ADDRESS) &&
+		((PartitionHeader->DestinationLoadAddress + Length - 1U) <=
+			XFSBL_PS_DDR_END_ADDRESS))
+	{
+		Status = TRUE;
+	}
+#else
+	(void)FsblInstancePtr;
+	(void)PartitionHeader;
+#endif
+
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * This function copies the partition to specified destination
@@ -733,7 +916,10 @@ static u32 XFsbl_PartitionCopy(XFsblPs * FsblInstancePtr, u32 PartitionNum)
 	u32 SrcAddress=0U;
 	PTRSIZE LoadAddress=0U;
 	u32 Length=0U;
+	u32 CopyLength=0U;
 	u32 RunningCpu=0U;
+	u32 NextPartitionNum;
+	XFsblPs_PartitionHeader * NextPartitionHeader;
 
 	/**
 	 * Assign the partition header to local variable
@@ -806,6 +992,17 @@ static u32 XFsbl_PartitionCopy(XFsblPs * FsblInstancePtr, u32 PartitionNum)
 	DestinationDevice = XFsbl_GetDestinationDevice(PartitionHeader);
 	LoadAddress = PartitionHeader->DestinationLoadAddress;
 
+	/**
+	 * Already in DDR if an earlier partition's copy was extended over
+	 * this one
+	 */
+	if (PartitionNum < CoalescedPartitionEnd)
+	{
+		XFsbl_Printf(DEBUG_INFO,"P%u copied with a previous partition\n\r",
+				PartitionNum);
+		goto END;
+	}
+
 	/**
 	 * Copy the authentication certificate to auth. buffer
 	 * Update Partition length to be copied.
@@ -953,6 +1150,68 @@ static u32 XFsbl_PartitionCopy(XFsblPs * FsblInstancePtr, u32 PartitionNum)
 						PMU_GLOBAL_GLOBAL_CNTRL_MB_SLEEP_MASK ) {;}
 	}
 
+#if defined(XFSBL_SECURE) && defined(XFSBL_PS_DDR) && defined(XFSBL_QSPI)
+	/**
+	 * SHA3 an authenticated partition chunk by chunk while QSPI
+	 * receives the rest of it. Validation then only checks the
+	 * signature.
+	 */
+	if ((XFsbl_IsRsaSignaturePresent(PartitionHeader) ==
+			XIH_PH_ATTRB_RSA_SIGNATURE) &&
+		((FsblInstancePtr->BootHdrAttributes &
+			XIH_BH_IMAGE_ATTRB_SHA2_MASK) !=
+			XIH_BH_IMAGE_ATTRB_SHA2_MASK))
+	{
+		XFsbl_ShaStreamStart(PartitionNum, LoadAddress, Length,
+				(PTRSIZE)AuthBuffer);
+		XFsbl_QspiSetChunkHandler(XFsbl_ShaStreamUpdate, NULL);
+	}
+#endif
+
+	/**
+	 * With the image index all the partition headers are known up front,
+	 * so extend the copy over the following partitions that sit right
+	 * after this one both in flash and in DDR
+	 */
+	CopyLength = Length;
+	if ((FsblInstancePtr->ImageHeader.IndexValid == TRUE) &&
+		(XFsbl_IsPlainDdrPartition(FsblInstancePtr, PartitionHeader)
+			== TRUE))
+	{
+		for (NextPartitionNum = PartitionNum + 1U;
+			NextPartitionNum <
+			FsblInstancePtr->ImageHeader.ImageHeaderTable.NoOfPartitions;
+			NextPartitionNum++)
+		{
+			NextPartitionHeader = &FsblInstancePtr->ImageHeader.
+					PartitionHeader[NextPartitionNum];
+
+#ifdef XFSBL_BS_OVERLAP
+			if ((PcapPending == TRUE) &&
+				(XFsbl_NeedsPcapIdle(NextPartitionHeader) == TRUE))
+			{
+				break;
+			}
+#endif
+
+			if ((XFsbl_IsPlainDdrPartition(FsblInstancePtr,
+					NextPartitionHeader) != TRUE) ||
+				((FsblInstancePtr->ImageOffsetAddress +
+					(NextPartitionHeader->DataWordOffset *
+					XIH_PARTITION_WORD_LENGTH)) !=
+					(SrcAddress + CopyLength)) ||
+				(NextPartitionHeader->DestinationLoadAddress !=
+					((u64)LoadAddress + CopyLength)))
+			{
+				break;
+			}
+
+			CopyLength += NextPartitionHeader->TotalDataWordLength *
+					XIH_PARTITION_WORD_LENGTH;
+			CoalescedPartitionEnd = NextPartitionNum + 1U;
+		}
+	}
+
 #ifdef XFSBL_PERF
 	XTime tCur = 0;
 	XTime_GetTime(&tCur);
@@ -961,12 +1220,16 @@ static u32 XFsbl_PartitionCopy(XFsblPs * FsblInstancePtr, u32 PartitionNum)
 	 * Copy the partition to PS_DDR/PL_DDR/TCM
 	 */
 	Status = FsblInstancePtr->DeviceOps.DeviceCopy(SrcAddress,
-					LoadAddress, Length);
+					LoadAddress, CopyLength);
+
+#if defined(XFSBL_SECURE) && defined(XFSBL_PS_DDR) && defined(XFSBL_QSPI)
+	XFsbl_QspiSetChunkHandler(NULL, NULL);
+#endif
 
 #ifdef XFSBL_PERF
 	XFsbl_MeasurePerfTime(tCur);
 	XFsbl_Printf(DEBUG_PRINT_ALWAYS, ": P%u Copy time, Size: %0u \r\n",
-				PartitionNum, Length);
+				PartitionNum, CopyLength);
 #endif
 
 	if (XFSBL_SUCCESS != Status)
@@ -1376,10 +1639,26 @@ static u32 XFsbl_PartitionValidation(XFsblPs * FsblInstancePtr,
 			BitstreamWordSize =
 				PartitionHeader->UnEncryptedDataWordLength;
 
+#ifdef XFSBL_BS_OVERLAP
+			/**
+			 * Let CSU DMA feed PCAP while the next partitions are
+			 * read. XFsbl_PartitionLoadWait() completes the PL
+			 * configuration.
+			 */
+			XFsbl_WriteToPcapStart(BitstreamWordSize, (u8 *) LoadAddress);
+			PcapPending = TRUE;
+			PcapPartitionNum = PartitionNum;
+			PcapAddress = LoadAddress;
+			PcapLength = BitstreamWordSize * 4U;
+			XFsbl_Printf(DEBUG_INFO,
+				"P%u bitstream download started\r\n", PartitionNum);
+			goto END;
+#else
 			Status = XFsbl_WriteToPcap(BitstreamWordSize, (u8 *) LoadAddress);
 			if (Status != XFSBL_SUCCESS) {
 				goto END;
 			}
+#endif
 #else
 			/* In case of DDR less system, do the chunked transfer */
 			Status = XFsbl_ChunkedBSTxfer(FsblInstancePtr,
@@ -1397,31 +1676,10 @@ static u32 XFsbl_PartitionValidation(XFsblPs * FsblInstancePtr,
 #endif
 		}
 
-		Status = XFsbl_PLWaitForDone();
+		Status = XFsbl_PLConfigComplete();
 		if (Status != XFSBL_SUCCESS) {
 			goto END;
 		}
-
-		/**
-		 * PL is powered-up before its configuration, but will be in isolation.
-		 * Now since PL configuration is done, just remove the isolation
-		 */
-		psu_ps_pl_isolation_removal_data();
-
-		/* Reset PL, if configured for */
-		psu_ps_pl_reset_config_data();
-
-		/**
-		 * Fsbl hook after bit stream download
-		 */
-		Status = XFsbl_HookAfterBSDownload();
-		if (Status != XFSBL_SUCCESS)
-		{
-			Status = XFSBL_ERROR_HOOK_AFTER_BITSTREAM_DOWNLOAD;
-			XFsbl_Printf(DEBUG_GENERAL,
-			 "XFSBL_ERROR_HOOK_AFTER_BITSTREAM_DOWNLOAD\r\n");
-			goto END;
-		}
 	}
 #endif
 
@@ -1447,6 +1705,51 @@ END:
 	return Status;
 }
 
+#ifdef XFSBL_BS
+/*****************************************************************************/
+/**
+ * This function finishes PL configuration once the whole bitstream has
+ * been sent to PCAP
+ *
+ * @return	returns the error codes described in xfsbl_error.h on any error
+ * 			returns XFSBL_SUCCESS on success
+ *
+ *****************************************************************************/
+static u32 XFsbl_PLConfigComplete(void)
+{
+	u32 Status=XFSBL_SUCCESS;
+
+	Status = XFsbl_PLWaitForDone();
+	if (Status != XFSBL_SUCCESS) {
+		goto END;
+	}
+
+	/**
+	 * PL is powered-up before its configuration, but will be in isolation.
+	 * Now since PL configuration is done, just remove the isolation
+	 */
+	psu_ps_pl_isolation_removal_data();
+
+	/* Reset PL, if configured for */
+	psu_ps_pl_reset_config_data();
+
+	/**
+	 * Fsbl hook after bit stream download
+	 */
+	Status = XFsbl_HookAfterBSDownload();
+	if (Status != XFSBL_SUCCESS)
+	{
+		Status = XFSBL_ERROR_HOOK_AFTER_BITSTREAM_DOWNLOAD;
+		XFsbl_Printf(DEBUG_GENERAL,
+		 "XFSBL_ERROR_HOOK_AFTER_BITSTREAM_DOWNLOAD\r\n");
+		goto END;
+	}
+
+END:
+	return Status;
+}
+#endif
+
 /*****************************************************************************/
 /**
  * This function checks if PMU FW is loaded and gives handoff to PMU Microblaze
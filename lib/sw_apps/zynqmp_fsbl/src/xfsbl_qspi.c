@@ -45,6 +45,9 @@
 * 1.00  kc   10/21/13 Initial release
 * 2.00  sg   12/03/15 Added GQSPI driver support
 *                     32Bit boot mode support
+* 3.00  esd  10/18/26 Copies stream one read command per bank, received in
+*                     chunks through the interrupt mode state machine, and
+*                     hand each chunk to an optional chunk handler
 *
 * </pre>
 *
@@ -88,6 +91,17 @@ static u8 TxBfrPtr __attribute__ ((aligned(32)));
 static u8 ReadBuffer[10] __attribute__ ((aligned(32)));
 static u8 WriteBuffer[10] __attribute__ ((aligned(32)));
 
+/*
+ * Command, dummy and one message per chunk, plus two spare entries. The
+ * driver's handler reads Msg[MsgCnt].Flags on every interrupt, and MsgCnt
+ * runs to NumMsg after the last message and to NumMsg + 1 once the CS
+ * de-assert entry has been executed.
+ */
+static XQspiPsu_Msg StreamMsg[XFSBL_QSPI_STREAM_MAX_CHUNKS + 4U];
+static volatile u32 StreamEvent;
+static XFsbl_QspiChunkHandler ChunkHandler = NULL;
+static void *ChunkHandlerRef = NULL;
+
 /******************************************************************************
 *
 * This function reads serial FLASH ID connected to the SPI interface.
@@ -529,6 +543,272 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * This function returns the bus width of the data phase of ReadCommand
+ *
+ * @param	None
+ *
+ * @return	XQSPIPSU_SELECT_MODE_SPI/DUALSPI/QUADSPI
+ *
+ *****************************************************************************/
+static u8 XFsbl_QspiReadBusWidth(void)
+{
+	u8 BusWidth;
+
+	switch (ReadCommand) {
+		case DUAL_READ_CMD_24BIT:
+		case DUAL_READ_CMD_32BIT:
+		{
+			BusWidth = XQSPIPSU_SELECT_MODE_DUALSPI;
+		} break;
+
+		case QUAD_READ_CMD_24BIT:
+		case QUAD_READ_CMD_32BIT:
+		{
+			BusWidth = XQSPIPSU_SELECT_MODE_QUADSPI;
+		} break;
+
+		default:
+		{
+			BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+		} break;
+	}
+
+	return BusWidth;
+}
+
+/*****************************************************************************/
+/**
+ * This function returns how many bytes from SrcAddress can be read with one
+ * read command: up to the end of the bank and, in stacked mode, up to the
+ * end of the lower flash.
+ *
+ * @param SrcAddress is the flash address to read from
+ *
+ * @param RemainingBytes is the number of bytes left to read
+ *
+ * @param BankSize is the bank size as seen through the connection mode
+ *
+ * @return	Number of bytes for the next read command
+ *
+ *****************************************************************************/
+static u32 XFsbl_QspiSegmentLength(u32 SrcAddress, u32 RemainingBytes,
+		u32 BankSize)
+{
+	u32 TransferBytes;
+	u32 LowerFlashSize = QspiFlashSize / 2U;
+
+	TransferBytes = BankSize - (SrcAddress % BankSize);
+	if (TransferBytes > RemainingBytes) {
+		TransferBytes = RemainingBytes;
+	}
+
+	if ((QspiPsuInstancePtr->Config.ConnectionMode ==
+			XQSPIPSU_CONNECTION_MODE_STACKED) &&
+			(SrcAddress < LowerFlashSize) &&
+			((SrcAddress + TransferBytes) > LowerFlashSize)) {
+		TransferBytes = LowerFlashSize - SrcAddress;
+	}
+
+	return TransferBytes;
+}
+
+/*****************************************************************************/
+/**
+ * Status callback for the streaming reads. It is called from
+ * XQspiPsu_InterruptHandler, which XFsbl_QspiStreamRead polls.
+ *
+ * @param	CallBackRef is unused
+ * @param	StatusEvent is the event reported by the driver
+ * @param	ByteCount is unused
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XFsbl_QspiStatusHandler(void *CallBackRef, u32 StatusEvent,
+		u32 ByteCount)
+{
+	(void)CallBackRef;
+	(void)ByteCount;
+
+	StreamEvent = StatusEvent;
+}
+
+/*****************************************************************************/
+/**
+ * This function reads Length bytes with a single read command. The command,
+ * address and dummy cycles are sent once and the data is received as a
+ * chain of XFSBL_QSPI_STREAM_CHUNK sized RX messages with CS held asserted,
+ * so the flash keeps streaming across the chunk boundaries.
+ *
+ * The transfer is started with XQspiPsu_InterruptTransfer and completed by
+ * polling XQspiPsu_InterruptHandler, as the QSPI interrupt is not routed in
+ * FSBL. When a chunk is retired the GenFIFO entry for the next one has
+ * already been queued, so the chunk handler runs while the QSPI DMA fills
+ * the next chunk.
+ *
+ * The caller makes sure the read neither crosses a bank nor a stacked
+ * flash boundary and has selected the bank.
+ *
+ * @param SrcAddress is the flash address to read from
+ *
+ * @param DestAddress is the address of the destination
+ *
+ * @param Length is the number of bytes to read
+ *
+ * @param AddrSize is the number of address bytes, 3 or 4
+ *
+ * @return
+ * 		- XFSBL_SUCCESS for successful read
+ * 		- XFSBL_ERROR_QSPI_READ on failure
+ *
+ *****************************************************************************/
+static u32 XFsbl_QspiStreamRead(u32 SrcAddress, PTRSIZE DestAddress,
+		u32 Length, u32 AddrSize)
+{
+	u32 Status = XFSBL_SUCCESS;
+	u32 QspiAddr;
+	u32 NumMsg;
+	u32 Chunk;
+	u32 ChunkBytes;
+	u32 Offset;
+	PTRSIZE ChunkAddress;
+	u8 BusWidth;
+
+	/**
+	 * Translate address based on type of connection
+	 * If stacked assert the slave select based on address
+	 */
+	QspiAddr = XFsbl_GetQspiAddr(SrcAddress);
+	BusWidth = XFsbl_QspiReadBusWidth();
+
+	XFsbl_Printf(DEBUG_INFO,".");
+	XFsbl_Printf(DEBUG_DETAILED,
+			"QSPI Read Src 0x%0lx, Dest %0lx, Length %0lx\r\n",
+			QspiAddr, DestAddress, Length);
+
+	/**
+	 * Setup the read command with the specified address
+	 */
+	WriteBuffer[COMMAND_OFFSET] = ReadCommand;
+	if (AddrSize == 4U) {
+		WriteBuffer[ADDRESS_1_OFFSET] = (u8)((QspiAddr & 0xFF000000) >> 24);
+		WriteBuffer[ADDRESS_2_OFFSET] = (u8)((QspiAddr & 0xFF0000) >> 16);
+		WriteBuffer[ADDRESS_3_OFFSET] = (u8)((QspiAddr & 0xFF00) >> 8);
+		WriteBuffer[ADDRESS_4_OFFSET] = (u8)(QspiAddr & 0xFF);
+	} else {
+		WriteBuffer[ADDRESS_1_OFFSET] = (u8)((QspiAddr & 0xFF0000) >> 16);
+		WriteBuffer[ADDRESS_2_OFFSET] = (u8)((QspiAddr & 0xFF00) >> 8);
+		WriteBuffer[ADDRESS_3_OFFSET] = (u8)(QspiAddr & 0xFF);
+	}
+
+	StreamMsg[0].TxBfrPtr = WriteBuffer;
+	StreamMsg[0].RxBfrPtr = NULL;
+	StreamMsg[0].ByteCount = AddrSize + 1U;
+	StreamMsg[0].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+	StreamMsg[0].Flags = XQSPIPSU_MSG_FLAG_TX;
+
+	/*
+	 * Separate entry for dummy, with the bus width of the data phase
+	 */
+	StreamMsg[1].TxBfrPtr = NULL;
+	StreamMsg[1].RxBfrPtr = NULL;
+	StreamMsg[1].ByteCount = DUMMY_CLOCKS;
+	StreamMsg[1].BusWidth = BusWidth;
+	StreamMsg[1].Flags = 0;
+
+	/**
+	 * One RX message per chunk
+	 */
+	NumMsg = 2U;
+	for (Offset = 0U; Offset < Length; Offset += ChunkBytes) {
+		ChunkBytes = Length - Offset;
+		if (ChunkBytes > XFSBL_QSPI_STREAM_CHUNK) {
+			ChunkBytes = XFSBL_QSPI_STREAM_CHUNK;
+		}
+
+		StreamMsg[NumMsg].TxBfrPtr = NULL;
+		StreamMsg[NumMsg].RxBfrPtr = (u8 *)(DestAddress + Offset);
+		StreamMsg[NumMsg].ByteCount = ChunkBytes;
+		StreamMsg[NumMsg].BusWidth = BusWidth;
+		StreamMsg[NumMsg].Flags = XQSPIPSU_MSG_FLAG_RX;
+
+		if (QspiPsuInstancePtr->Config.ConnectionMode ==
+				XQSPIPSU_CONNECTION_MODE_PARALLEL) {
+			StreamMsg[NumMsg].Flags |= XQSPIPSU_MSG_FLAG_STRIPE;
+		}
+		NumMsg++;
+	}
+
+	StreamEvent = XST_SUCCESS;
+	XQspiPsu_SetStatusHandler(QspiPsuInstancePtr, NULL,
+			XFsbl_QspiStatusHandler);
+
+	Status = XQspiPsu_InterruptTransfer(QspiPsuInstancePtr, StreamMsg,
+			NumMsg);
+	if (Status != XST_SUCCESS) {
+		Status = XFSBL_ERROR_QSPI_READ;
+		XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_QSPI_READ\r\n");
+		goto END;
+	}
+
+	Chunk = 2U;
+	do {
+		(void)XQspiPsu_InterruptHandler(QspiPsuInstancePtr);
+
+		if (StreamEvent == XST_SPI_COMMAND_ERROR) {
+			XQspiPsu_Abort(QspiPsuInstancePtr);
+			Status = XFSBL_ERROR_QSPI_READ;
+			XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_QSPI_READ\r\n");
+			goto END;
+		}
+
+		/**
+		 * Hand the chunks the driver has retired to the chunk handler
+		 */
+		while ((Chunk < NumMsg) &&
+				((u32)QspiPsuInstancePtr->MsgCnt > Chunk)) {
+			if (ChunkHandler != NULL) {
+				Offset = (Chunk - 2U) * XFSBL_QSPI_STREAM_CHUNK;
+				ChunkAddress = DestAddress + Offset;
+				ChunkBytes = Length - Offset;
+				if (ChunkBytes > XFSBL_QSPI_STREAM_CHUNK) {
+					ChunkBytes = XFSBL_QSPI_STREAM_CHUNK;
+				}
+
+				Xil_DCacheInvalidateRange((INTPTR)ChunkAddress,
+						ChunkBytes);
+				ChunkHandler(ChunkHandlerRef, ChunkAddress,
+						ChunkBytes);
+			}
+			Chunk++;
+		}
+	} while (QspiPsuInstancePtr->IsBusy == TRUE);
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * This function registers the handler called for every chunk of the
+ * following QSPI copies. Pass NULL to remove it.
+ *
+ * @param Handler is the chunk handler
+ *
+ * @param CallBackRef is passed back to the handler
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XFsbl_QspiSetChunkHandler(XFsbl_QspiChunkHandler Handler,
+		void *CallBackRef)
+{
+	ChunkHandler = Handler;
+	ChunkHandlerRef = CallBackRef;
+}
+
 /*****************************************************************************/
 /**
  * This function is used to copy the data from QSPI flash to destination
@@ -550,14 +830,12 @@ END:
 u32 XFsbl_Qspi24Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 {
 	u32 Status = XFSBL_SUCCESS;
-	u32 QspiAddr=0, OrigAddr=0;
+	u32 QspiAddr=0;
 	u32 BankSel=0;
 	u32 RemainingBytes=0;
 	u32 TransferBytes=0;
-	u32 DiscardByteCnt;
 	u8 BankSwitchFlag=0;
 	u32 BankSize=SINGLEBANKSIZE;
-	u32 BankMask=SINGLEBANKMASK;
 
 	XFsbl_Printf(DEBUG_INFO,"QSPI Reading Src 0x%0lx, Dest %0lx, Length %0lx\r\n",
 			SrcAddress, DestAddress, Length);
@@ -572,11 +850,10 @@ u32 XFsbl_Qspi24Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 		goto END;
 	}
 
-	/* Multiply bank size & mask in case of Dual Parallel */
+	/* Multiply bank size in case of Dual Parallel */
 	if (QspiPsuInstancePtr->Config.ConnectionMode ==
 	    XQSPIPSU_CONNECTION_MODE_PARALLEL){
 		BankSize =  SINGLEBANKSIZE * 2;
-		BankMask =  SINGLEBANKMASK * 2;
 	}
 
 	/**
@@ -586,36 +863,17 @@ u32 XFsbl_Qspi24Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 
 	while(RemainingBytes > 0) {
 
-		if (RemainingBytes > DMA_DATA_TRAN_SIZE)
-		{
-			TransferBytes = DMA_DATA_TRAN_SIZE;
-		} else {
-			TransferBytes = RemainingBytes;
-		}
-
 		/**
-		 * Translate address based on type of connection
-		 * If stacked assert the slave select based on address
+		 * Read up to the end of the current bank with one command
 		 */
-		QspiAddr = XFsbl_GetQspiAddr((u32 )SrcAddress);
-
-		/**
-		 * Multiply address by 2 in case of Dual Parallel
-		 * This address is used to calculate the bank crossing
-		 * condition
-		 */
-		if (QspiPsuInstancePtr->Config.ConnectionMode ==
-		    XQSPIPSU_CONNECTION_MODE_PARALLEL){
-			OrigAddr = QspiAddr * 2;
-		} else {
-			OrigAddr = QspiAddr;
-		}
+		TransferBytes = XFsbl_QspiSegmentLength(SrcAddress,
+				RemainingBytes, BankSize);
 
 		/**
 		 * Select bank
-		 * check logic for DualQspi
 		 */
 		if(QspiFlashSize > BankSize) {
+			QspiAddr = XFsbl_GetQspiAddr((u32 )SrcAddress);
 			BankSel = QspiAddr/BANKSIZE;
 			Status = SendBankSelect(BankSel);
 			if (Status != XFSBL_SUCCESS) {
@@ -624,98 +882,14 @@ u32 XFsbl_Qspi24Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 					"XFSBL_ERROR_QSPI_READ\r\n");
 				goto END;
 			}
-		}
-
-
-		/**
-		 * If data to be read spans beyond the current bank, then
-		 * calculate Transfer Bytes in current bank. Else
-		 * transfer bytes are same
-		 */
-		if ((OrigAddr & BankMask) != ((OrigAddr + TransferBytes) & BankMask)) {
-			TransferBytes = (OrigAddr & BankMask) + BankSize - OrigAddr;
-		}
-
-		XFsbl_Printf(DEBUG_INFO,".");
-				XFsbl_Printf(DEBUG_DETAILED,
-					"QSPI Read Src 0x%0lx, Dest %0lx, Length %0lx\r\n",
-						QspiAddr, DestAddress, TransferBytes);
-
-		/**
-		 * Setup the read command with the specified address and data for the
-		 * Flash
-		 */
-
-		WriteBuffer[COMMAND_OFFSET]   = ReadCommand;
-		WriteBuffer[ADDRESS_1_OFFSET] = (u8)((QspiAddr & 0xFF0000) >> 16);
-		WriteBuffer[ADDRESS_2_OFFSET] = (u8)((QspiAddr & 0xFF00) >> 8);
-		WriteBuffer[ADDRESS_3_OFFSET] = (u8)(QspiAddr & 0xFF);
-		DiscardByteCnt = 4;
-
-		FlashMsg[0].TxBfrPtr = WriteBuffer;
-		FlashMsg[0].RxBfrPtr = NULL;
-		FlashMsg[0].ByteCount = DiscardByteCnt;
-		FlashMsg[0].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
-		FlashMsg[0].Flags = XQSPIPSU_MSG_FLAG_TX;
-
-		/* It is recommended to have a separate entry for dummy */
-		if ((ReadCommand == FAST_READ_CMD_24BIT) || (ReadCommand == DUAL_READ_CMD_24BIT) ||
-		    (ReadCommand == QUAD_READ_CMD_24BIT)) {
-			/* Update Dummy cycles as per flash specs for QUAD IO */
-
-			/*
-			 * It is recommended that Bus width value during dummy
-			 * phase should be same as data phase
-			 */
-			if (ReadCommand == FAST_READ_CMD_24BIT) {
-				FlashMsg[1].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
-			}
-
-			if (ReadCommand == DUAL_READ_CMD_24BIT) {
-				FlashMsg[1].BusWidth = XQSPIPSU_SELECT_MODE_DUALSPI;
+			if (BankSel != 0U) {
+				BankSwitchFlag = 1;
 			}
-
-			if (ReadCommand == QUAD_READ_CMD_24BIT) {
-				FlashMsg[1].BusWidth = XQSPIPSU_SELECT_MODE_QUADSPI;
-			}
-
-			FlashMsg[1].TxBfrPtr = NULL;
-			FlashMsg[1].RxBfrPtr = NULL;
-			FlashMsg[1].ByteCount = DUMMY_CLOCKS;
-			FlashMsg[1].Flags = 0;
-		}
-
-		if (ReadCommand == FAST_READ_CMD_24BIT) {
-			FlashMsg[2].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
-		}
-
-		if (ReadCommand == DUAL_READ_CMD_24BIT) {
-			FlashMsg[2].BusWidth = XQSPIPSU_SELECT_MODE_DUALSPI;
-		}
-
-		if (ReadCommand == QUAD_READ_CMD_24BIT) {
-			FlashMsg[2].BusWidth = XQSPIPSU_SELECT_MODE_QUADSPI;
-		}
-
-		FlashMsg[2].TxBfrPtr = NULL;
-		FlashMsg[2].RxBfrPtr = (u8 *)DestAddress;
-		FlashMsg[2].ByteCount = TransferBytes;
-		FlashMsg[2].Flags = XQSPIPSU_MSG_FLAG_RX;
-
-		if(QspiPsuInstancePtr->Config.ConnectionMode ==
-				XQSPIPSU_CONNECTION_MODE_PARALLEL){
-			FlashMsg[2].Flags |= XQSPIPSU_MSG_FLAG_STRIPE;
 		}
 
-		/**
-		 * Send the read command to the Flash to read the specified number
-		 * of bytes from the Flash, send the read command and address and
-		 * receive the specified number of bytes of data in the data buffer
-		 */
-		Status = XQspiPsu_PolledTransfer(QspiPsuInstancePtr, FlashMsg, 3);
-		if (Status != XST_SUCCESS) {
-			Status = XFSBL_ERROR_QSPI_READ;
-			XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_QSPI_READ\r\n");
+		Status = XFsbl_QspiStreamRead(SrcAddress, DestAddress,
+				TransferBytes, 3U);
+		if (Status != XFSBL_SUCCESS) {
 			goto END;
 		}
 
@@ -890,10 +1064,9 @@ END:
 u32 XFsbl_Qspi32Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 {
 	u32 Status = XFSBL_SUCCESS;
-	u32 QspiAddr=0;
 	u32 RemainingBytes=0;
 	u32 TransferBytes=0;
-	u32 DiscardByteCnt;
+	u32 BankSize=SINGLEBANKSIZE;
 
 	XFsbl_Printf(DEBUG_INFO,"QSPI Reading Src 0x%0lx, Dest %0lx, Length %0lx\r\n",
 			SrcAddress, DestAddress, Length);
@@ -908,6 +1081,10 @@ u32 XFsbl_Qspi32Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 		goto END;
 	}
 
+	if (QspiPsuInstancePtr->Config.ConnectionMode ==
+	    XQSPIPSU_CONNECTION_MODE_PARALLEL){
+		BankSize =  SINGLEBANKSIZE * 2;
+	}
 
 	/**
 	 * Update no of bytes to be copied
@@ -916,104 +1093,17 @@ u32 XFsbl_Qspi32Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length)
 
 	while(RemainingBytes > 0) {
 
-		if (RemainingBytes > DMA_DATA_TRAN_SIZE)
-		{
-			TransferBytes = DMA_DATA_TRAN_SIZE;
-		} else {
-			TransferBytes = RemainingBytes;
-		}
-
 		/**
-		 * Translate address based on type of connection
-		 * If stacked assert the slave select based on address
+		 * No bank register in 4 byte addressing, but one read command
+		 * still covers at most a bank worth of data, which bounds the
+		 * number of chunk messages
 		 */
-		QspiAddr = XFsbl_GetQspiAddr((u32 )SrcAddress);
-
-		XFsbl_Printf(DEBUG_INFO,".");
-		XFsbl_Printf(DEBUG_DETAILED,
-					"QSPI Read Src 0x%0lx, Dest %0lx, Length %0lx\r\n",
-						QspiAddr, DestAddress, TransferBytes);
-
-		/**
-		 * Setup the read command with the specified address and data for the
-		 * Flash
-		 */
-
-		WriteBuffer[COMMAND_OFFSET]   = ReadCommand;
-		WriteBuffer[ADDRESS_1_OFFSET] = (u8)((QspiAddr & 0xFF000000) >> 24);
-		WriteBuffer[ADDRESS_2_OFFSET] = (u8)((QspiAddr & 0xFF0000) >> 16);
-		WriteBuffer[ADDRESS_3_OFFSET] = (u8)((QspiAddr & 0xFF00) >> 8);
-		WriteBuffer[ADDRESS_4_OFFSET] = (u8)(QspiAddr & 0xFF);
-		DiscardByteCnt = 5;
-
-		FlashMsg[0].TxBfrPtr = WriteBuffer;
-		FlashMsg[0].RxBfrPtr = NULL;
-		FlashMsg[0].ByteCount = DiscardByteCnt;
-		FlashMsg[0].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
-		FlashMsg[0].Flags = XQSPIPSU_MSG_FLAG_TX;
+		TransferBytes = XFsbl_QspiSegmentLength(SrcAddress,
+				RemainingBytes, BankSize);
 
-		/*
-		 * It is recommended to have a separate entry for dummy
-		 */
-		if ((ReadCommand == FAST_READ_CMD_32BIT) ||
-				(ReadCommand == DUAL_READ_CMD_32BIT) ||
-				(ReadCommand == QUAD_READ_CMD_32BIT)) {
-
-			/* Update Dummy cycles as per flash specs for QUAD IO */
-
-			/*
-			 * It is recommended that Bus width value during dummy
-			 * phase should be same as data phase
-			 */
-			if (ReadCommand == FAST_READ_CMD_32BIT) {
-				FlashMsg[1].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
-			}
-
-			if (ReadCommand == DUAL_READ_CMD_32BIT) {
-				FlashMsg[1].BusWidth = XQSPIPSU_SELECT_MODE_DUALSPI;
-			}
-
-			if (ReadCommand == QUAD_READ_CMD_32BIT) {
-				FlashMsg[1].BusWidth = XQSPIPSU_SELECT_MODE_QUADSPI;
-			}
-
-			FlashMsg[1].TxBfrPtr = NULL;
-			FlashMsg[1].RxBfrPtr = NULL;
-			FlashMsg[1].ByteCount = DUMMY_CLOCKS;
-			FlashMsg[1].Flags = 0;
-		}
-
-		if (ReadCommand == FAST_READ_CMD_32BIT) {
-			FlashMsg[2].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
-		}
-
-		if (ReadCommand == DUAL_READ_CMD_32BIT) {
-			FlashMsg[2].BusWidth = XQSPIPSU_SELECT_MODE_DUALSPI;
-		}
-
-		if (ReadCommand == QUAD_READ_CMD_32BIT) {
-			FlashMsg[2].BusWidth = XQSPIPSU_SELECT_MODE_QUADSPI;
-		}
-
-		FlashMsg[2].TxBfrPtr = NULL;
-		FlashMsg[2].RxBfrPtr = (u8 *)DestAddress;
-		FlashMsg[2].ByteCount = TransferBytes;
-		FlashMsg[2].Flags = XQSPIPSU_MSG_FLAG_RX;
-
-		if(QspiPsuInstancePtr->Config.ConnectionMode ==
-				XQSPIPSU_CONNECTION_MODE_PARALLEL){
-			FlashMsg[2].Flags |= XQSPIPSU_MSG_FLAG_STRIPE;
-		}
-
-		/**
-		 * Send the read command to the Flash to read the specified number
-		 * of bytes from the Flash, send the read command and address and
-		 * receive the specified number of bytes of data in the data buffer
-		 */
-		Status = XQspiPsu_PolledTransfer(QspiPsuInstancePtr, FlashMsg, 3);
-		if (Status != XST_SUCCESS) {
-			Status = XFSBL_ERROR_QSPI_READ;
-			XFsbl_Printf(DEBUG_GENERAL,"XFSBL_ERROR_QSPI_READ\r\n");
+		Status = XFsbl_QspiStreamRead(SrcAddress, DestAddress,
+				TransferBytes, 4U);
+		if (Status != XFSBL_SUCCESS) {
 			goto END;
 		}
 
@@ -45,6 +45,7 @@
 * 1.00  kc   10/21/13 Initial release
 * 2.00  sg   12/03/15 Added GQSPI driver support
 *                     32Bit boot mode support
+* 3.00  esd  10/18/26 Added streaming reads and the chunk handler
 * </pre>
 *
 * @note
@@ -114,6 +115,15 @@ extern "C" {
  */
 #define DMA_DATA_TRAN_SIZE		(0x20000000U)
 
+/*
+ * Streaming reads issue one read command per bank and receive the data as a
+ * chain of XFSBL_QSPI_STREAM_CHUNK sized messages under the same CS
+ * assertion. A bank is at most 2 * BANKSIZE bytes (dual parallel).
+ */
+#define XFSBL_QSPI_STREAM_CHUNK		(0x80000U)
+#define XFSBL_QSPI_STREAM_MAX_CHUNKS	((2U * BANKSIZE) / \
+					 XFSBL_QSPI_STREAM_CHUNK)
+
 /*
  * The following defines are for dual flash interface.
  */
@@ -188,6 +198,13 @@ extern "C" {
 
 /**************************** Type Definitions *******************************/
 
+/**
+ * Called for every chunk of a streaming read once it has landed in memory,
+ * while the next chunk is still being received
+ */
+typedef void (*XFsbl_QspiChunkHandler) (void *CallBackRef,
+		PTRSIZE ChunkAddress, u32 ChunkLength);
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
@@ -198,6 +215,8 @@ u32 XFsbl_Qspi24Release(void );
 u32 XFsbl_Qspi32Init(u32 DeviceFlags);
 u32 XFsbl_Qspi32Copy(u32 SrcAddress, PTRSIZE DestAddress, u32 Length);
 u32 XFsbl_Qspi32Release(void );
+void XFsbl_QspiSetChunkHandler(XFsbl_QspiChunkHandler Handler,
+		void *CallBackRef);
 
 /************************** Variable Definitions *****************************/
 
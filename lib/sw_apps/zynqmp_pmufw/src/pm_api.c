@@ -142,6 +142,10 @@ static const PmApiEntry pmApiTable[] = {
 		.apiId = PM_GET_CHIPID,
 		.argTypes = { ARG_UNDEF, ARG_UNDEF, ARG_UNDEF, ARG_UNDEF,
 			      ARG_UNDEF },
+	}, {
+		.apiId = PM_BATCH,
+		.argTypes = { ARG_UINT32, ARG_UINT32, ARG_UNDEF, ARG_UNDEF,
+			      ARG_UNDEF },
 	},
 };
 
@@ -55,6 +55,16 @@
 /* Payload element size in bytes */
 #define PAYLOAD_ELEM_SIZE	4U
 
+/*
+ * PM_BATCH command table entry: payload of the call followed by the words
+ * of its response (status + up to 3 return values), filled in by the PMU
+ */
+#define BATCH_RESP_CNT		4U
+#define BATCH_ENTRY_CNT		(PAYLOAD_ELEM_CNT + BATCH_RESP_CNT)
+
+/* Maximum number of calls in one PM_BATCH request */
+#define BATCH_MAX_CALLS		64U
+
 #define ARG_UNDEF              0U
 #define ARG_NODE               1U
 #define ARG_ACK                2U
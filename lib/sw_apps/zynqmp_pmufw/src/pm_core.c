@@ -47,6 +47,98 @@
 #include "pm_system.h"
 #include "xilfpga_pcap.h"
 #include "pm_clock.h"
+#include "xpfw_ipi_manager.h"
+
+#ifdef ENABLE_PM_BENCHMARK
+/*
+ * Benchmark mode: PIT2 is run as a free running down-counter clocked by the
+ * PMU clock, and the time spent servicing each PM API call is recorded in PMU
+ * cycles. The statistics are printed on demand by PmBenchReport, which is
+ * kept out of the IPI path so that printing does not add to the measured
+ * service times.
+ */
+#define PM_BENCH_PIT_MAX	0xFFFFFFFFU
+#define PM_BENCH_PIT_EN_RELOAD	0x3U
+
+/**
+ * PmBenchStats - Service time statistics of one PM API
+ * @calls   Number of serviced calls
+ * @total   Sum of service times in PMU cycles
+ * @min     Shortest service time in PMU cycles
+ * @max     Longest service time in PMU cycles
+ */
+typedef struct {
+	u32 calls;
+	u64 total;
+	u32 min;
+	u32 max;
+} PmBenchStats;
+
+static PmBenchStats pmBenchStats[PM_API_MAX + 1U];
+static bool pmBenchRunning;
+
+/**
+ * PmBenchStart() - Start the free running PIT used for time stamping
+ */
+static void PmBenchStart(void)
+{
+	XPfw_Write32(PMU_IOMODULE_PIT2_CONTROL, 0U);
+	XPfw_Write32(PMU_IOMODULE_PIT2_PRELOAD, PM_BENCH_PIT_MAX);
+	XPfw_Write32(PMU_IOMODULE_PIT2_CONTROL, PM_BENCH_PIT_EN_RELOAD);
+	pmBenchRunning = true;
+}
+
+/**
+ * PmBenchReport() - Print service time statistics of all called PM APIs
+ *
+ * @note    Debug hook, called from XPfw_CorePrintStats. Not to be called while
+ *          a PM API call is being serviced.
+ */
+void PmBenchReport(void)
+{
+	u32 api;
+	const PmBenchStats* st;
+
+	for (api = PM_API_MIN; api <= PM_API_MAX; api++) {
+		st = &pmBenchStats[api];
+		if (0U == st->calls) {
+			continue;
+		}
+		fw_printf("PMUFW: API #%lu: calls %lu min %lu avg %lu max %lu cycles\r\n",
+			  api, st->calls, st->min,
+			  (u32)(st->total / st->calls), st->max);
+	}
+}
+
+/**
+ * PmBenchRecord() - Account service time of a PM API call
+ * @api     ID of the serviced API
+ * @start   PIT2 counter value read before the call was serviced
+ */
+static void PmBenchRecord(const u32 api, const u32 start)
+{
+	/* PIT counts down, wrap-around is handled by unsigned arithmetic */
+	u32 cycles = start - XPfw_Read32(PMU_IOMODULE_PIT2_COUNTER);
+	PmBenchStats* st;
+
+	if ((api < PM_API_MIN) || (api > PM_API_MAX)) {
+		goto done;
+	}
+
+	st = &pmBenchStats[api];
+	if ((0U == st->calls) || (cycles < st->min)) {
+		st->min = cycles;
+	}
+	if (cycles > st->max) {
+		st->max = cycles;
+	}
+	st->total += cycles;
+	st->calls++;
+
+done:
+	return;
+}
+#endif /* ENABLE_PM_BENCHMARK */
 
 /**
  * PmProcessAckRequest() -Returns appropriate acknowledge if required
@@ -372,7 +464,8 @@ static void PmReleaseNode(const PmMaster *master,
 
 	/* Release requirements */
 	status = PmRequirementUpdate(masterReq, 0U);
-	masterReq->info &= ~PM_MASTER_USING_SLAVE_MASK;
+	PmRequirementSet(masterReq, (u8)(masterReq->info &
+			 ~PM_MASTER_USING_SLAVE_MASK), masterReq->currReq);
 
 	usage = PmSlaveGetUsersMask(masterReq->slave);
 	if (0U == usage) {
@@ -447,7 +540,8 @@ static void PmRequestNode(const PmMaster *master,
 	}
 
 	/* Set requested capabilities if they are valid */
-	masterReq->info |= PM_MASTER_USING_SLAVE_MASK;
+	PmRequirementSet(masterReq, (u8)(masterReq->info |
+			 PM_MASTER_USING_SLAVE_MASK), masterReq->currReq);
 	status = PmRequirementUpdate(masterReq, capabilities);
 
 done:
@@ -1019,6 +1113,201 @@ static void PmProcessApiCall(const PmMaster *const master, const u32 *pload)
 	}
 }
 
+/**
+ * PmBatchIsTableValid() - Check the location of a PM_BATCH command table
+ * @master  Master which issued the PM_BATCH call
+ * @address Address of the first entry in the table
+ * @count   Number of entries in the table
+ *
+ * @return  True if the table is word aligned and placed entirely within
+ *          memory in which the master may place batch tables (see
+ *          PmGetBatchAccess), false otherwise
+ */
+static bool PmBatchIsTableValid(const PmMaster *const master,
+				const u32 address, const u32 count)
+{
+	bool valid = false;
+	u32 last;
+
+	if ((0U == count) || (count > BATCH_MAX_CALLS) ||
+	    (0U != (address & (PAYLOAD_ELEM_SIZE - 1U)))) {
+		goto done;
+	}
+
+	last = address + (count * BATCH_ENTRY_CNT * PAYLOAD_ELEM_SIZE) - 1U;
+	if (last < address) {
+		/* Table wraps around the end of the address space */
+		goto done;
+	}
+
+	valid = PmGetBatchAccess(master, address, last);
+
+done:
+	return valid;
+}
+
+/**
+ * PmBatchResetsMaster() - Check whether a reset line resets the master
+ * @master  Master to check for
+ * @reset   ID of the reset line
+ *
+ * @return  True if asserting the reset puts a processor of the master (or
+ *          the whole system) into reset, false otherwise
+ */
+static bool PmBatchResetsMaster(const PmMaster *const master, const u32 reset)
+{
+	bool resets;
+
+	switch (reset) {
+	case PM_RESET_SOFT:
+	case PM_RESET_PS_ONLY:
+		resets = true;
+		break;
+	case PM_RESET_FPD:
+	case PM_RESET_APU_L2:
+	case PM_RESET_ACPU0:
+	case PM_RESET_ACPU1:
+	case PM_RESET_ACPU2:
+	case PM_RESET_ACPU3:
+	case PM_RESET_ACPU0_PWRON:
+	case PM_RESET_ACPU1_PWRON:
+	case PM_RESET_ACPU2_PWRON:
+	case PM_RESET_ACPU3_PWRON:
+		resets = (&pmMasterApu_g == master);
+		break;
+	case PM_RESET_RPU_R50:
+		resets = (&pmMasterRpu0_g == master);
+		break;
+	case PM_RESET_RPU_R51:
+		resets = (&pmMasterRpu1_g == master);
+		break;
+	case PM_RESET_RPU_AMBA:
+	case PM_RESET_RPU_LS:
+	case PM_RESET_RPU_PGE:
+		resets = ((&pmMasterRpu0_g == master) ||
+			  (&pmMasterRpu1_g == master));
+		break;
+	default:
+		resets = false;
+		break;
+	}
+
+	return resets;
+}
+
+/**
+ * PmBatchIsCallAllowed() - Check whether a PM API call can be batched
+ * @master  Master which issued the PM_BATCH call
+ * @cmd     Payload of the call
+ *
+ * @return  False for nested batches and for calls which suspend, power down
+ *          or reset the calling master, or which trigger callbacks. The
+ *          caller waits for the batch response, so it has to keep running
+ *          and its IPI channel must not be used until all calls are done.
+ */
+static bool PmBatchIsCallAllowed(const PmMaster *const master, const u32 *cmd)
+{
+	bool allowed;
+
+	if (REQUEST_ACK_NON_BLOCKING == PmRequestAcknowledge(cmd)) {
+		/* Non-blocking acknowledge is sent as a callback */
+		allowed = false;
+		goto done;
+	}
+
+	switch (cmd[0]) {
+	case PM_BATCH:
+	case PM_SELF_SUSPEND:
+	case PM_REQUEST_SUSPEND:
+	case PM_SYSTEM_SHUTDOWN:
+		allowed = false;
+		break;
+	case PM_FORCE_POWERDOWN:
+		allowed = ((master->nid != cmd[1]) &&
+			   (NULL == PmGetProcOfThisMaster(master, cmd[1])));
+		break;
+	case PM_RESET_ASSERT:
+		allowed = ((PM_RESET_ACTION_RELEASE == cmd[2]) ||
+			   (false == PmBatchResetsMaster(master, cmd[1])));
+		break;
+	default:
+		allowed = true;
+		break;
+	}
+
+done:
+	return allowed;
+}
+
+/**
+ * PmProcessBatch() - Process a batch of PM API calls
+ * @master  Pointer to a requesting master structure
+ * @pload   Payload of the PM_BATCH call:
+ *          pload[1] - address of the command table
+ *          pload[2] - number of entries in the command table
+ *
+ * Each entry of the command table holds the payload of one PM API call
+ * followed by BATCH_RESP_CNT words into which the response of the call is
+ * written. Calls are executed in order, without handling any other request
+ * in between, until a call responds with an error. Entries of calls which do
+ * not respond are left zeroed (XST_SUCCESS). Calls rejected by
+ * PmBatchIsCallAllowed respond with XST_INVALID_PARAM.
+ *
+ * The response of the batch itself is the status of the last executed call
+ * and the number of executed calls.
+ */
+static void PmProcessBatch(const PmMaster *const master, const u32 *pload)
+{
+	u32 i, w;
+	u32 entry;
+	u32 executed = 0U;
+	u32 cmd[PAYLOAD_ELEM_CNT];
+	u32 resp[BATCH_RESP_CNT];
+	int status = XST_SUCCESS;
+
+	if (false == PmBatchIsTableValid(master, pload[1], pload[2])) {
+		PmDbg("ERROR invalid command table 0x%lx (%lu)\r\n",
+		      pload[1], pload[2]);
+		status = XST_INVALID_PARAM;
+		goto done;
+	}
+
+	for (i = 0U; i < pload[2]; i++) {
+		entry = pload[1] + (i * BATCH_ENTRY_CNT * PAYLOAD_ELEM_SIZE);
+
+		for (w = 0U; w < PAYLOAD_ELEM_CNT; w++) {
+			cmd[w] = XPfw_Read32(entry + (w * PAYLOAD_ELEM_SIZE));
+		}
+		for (w = 0U; w < BATCH_RESP_CNT; w++) {
+			resp[w] = 0U;
+		}
+
+		if ((PM_PAYLOAD_OK != PmCheckPayload(cmd)) ||
+		    (false == PmBatchIsCallAllowed(master, cmd))) {
+			resp[0] = XST_INVALID_PARAM;
+		} else {
+			XPfw_IpiCaptureResponse(&resp[0], BATCH_RESP_CNT);
+			PmProcessApiCall(master, cmd);
+			XPfw_IpiCaptureResponse(NULL, 0U);
+		}
+
+		entry += PAYLOAD_ELEM_CNT * PAYLOAD_ELEM_SIZE;
+		for (w = 0U; w < BATCH_RESP_CNT; w++) {
+			XPfw_Write32(entry + (w * PAYLOAD_ELEM_SIZE), resp[w]);
+		}
+
+		executed++;
+		status = (int)resp[0];
+		if (XST_SUCCESS != status) {
+			PmDbg("ERROR call #%lu (api %lu) failed\r\n", i, cmd[0]);
+			break;
+		}
+	}
+
+done:
+	IPI_RESPONSE2(master->ipiMask, status, executed);
+}
+
 /**
  * PmProcessRequest() - Process PM API call
  * @master  Pointer to a requesting master structure
@@ -1031,9 +1320,25 @@ static void PmProcessApiCall(const PmMaster *const master, const u32 *pload)
 void PmProcessRequest(const PmMaster *const master, const u32 *pload)
 {
 	PmPayloadStatus status = PmCheckPayload(pload);
+#ifdef ENABLE_PM_BENCHMARK
+	u32 start;
 
-	if (PM_PAYLOAD_OK == status) {
+	if (false == pmBenchRunning) {
+		PmBenchStart();
+	}
+	start = XPfw_Read32(PMU_IOMODULE_PIT2_COUNTER);
+#endif
+
+	if ((PM_PAYLOAD_OK == status) && (PM_BATCH == pload[0])) {
+		PmProcessBatch(master, pload);
+#ifdef ENABLE_PM_BENCHMARK
+		PmBenchRecord(pload[0], start);
+#endif
+	} else if (PM_PAYLOAD_OK == status) {
 		PmProcessApiCall(master, pload);
+#ifdef ENABLE_PM_BENCHMARK
+		PmBenchRecord(pload[0], start);
+#endif
 	} else {
 		PmDbg("ERROR invalid payload, status #%d\r\n", status);
 		/* Acknowledge if possible */
@@ -48,5 +48,8 @@
 void PmProcessRequest(const PmMaster *const master, const u32 *payload);
 void PmInit(const PmMaster* const master);
 int PmForcePowerDownInt(u32 node, u32 *oppoint);
+#ifdef ENABLE_PM_BENCHMARK
+void PmBenchReport(void);
+#endif
 
 #endif
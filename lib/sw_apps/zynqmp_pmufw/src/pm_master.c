@@ -827,6 +827,7 @@ static int PmApuEvaluateState(const u32 state)
 PmMaster pmMasterApu_g = {
 	.procs = pmApuProcs_g,
 	.procsCnt = PM_PROC_APU_MAX,
+	.idx = PM_MASTER_APU_IDX,
 	.wakeProc = NULL,
 	.nid = NODE_APU,
 	.ipiMask = IPI_PMU_0_IER_APU_MASK,
@@ -845,6 +846,7 @@ PmMaster pmMasterApu_g = {
 PmMaster pmMasterRpu0_g = {
 	.procs = &pmRpuProcs_g[PM_PROC_RPU_0],
 	.procsCnt = 1U,
+	.idx = PM_MASTER_RPU_0_IDX,
 	.wakeProc = NULL,
 	.nid = NODE_RPU,
 	.ipiMask = IPI_PMU_0_IER_RPU_0_MASK,
@@ -863,6 +865,7 @@ PmMaster pmMasterRpu0_g = {
 PmMaster pmMasterRpu1_g = {
 	.procs = &pmRpuProcs_g[PM_PROC_RPU_1],
 	.procsCnt = 1U,
+	.idx = PM_MASTER_RPU_1_IDX,
 	.wakeProc = NULL,
 	.nid = NODE_RPU_0, /* placeholder for request suspend, not used */
 	.ipiMask = IPI_PMU_0_IER_RPU_1_MASK,
@@ -879,11 +882,25 @@ PmMaster pmMasterRpu1_g = {
 };
 
 PmMaster *const pmAllMasters[PM_MASTER_MAX] = {
-	&pmMasterApu_g,
-	&pmMasterRpu0_g,
-	&pmMasterRpu1_g,
+	[PM_MASTER_APU_IDX] = &pmMasterApu_g,
+	[PM_MASTER_RPU_0_IDX] = &pmMasterRpu0_g,
+	[PM_MASTER_RPU_1_IDX] = &pmMasterRpu1_g,
 };
 
+/* Marks a master/slave pair for which no requirement structure exists */
+#define PM_REQ_IDX_NONE	0xFFU
+
+/*
+ * Index of the master's requirement for a slave in pmReqData, indexed by the
+ * master's position in pmAllMasters and by the slave's node ID. Built once by
+ * PmRequirementInit so that finding a requirement does not walk the lists.
+ */
+static u8 pmReqIdx[PM_MASTER_MAX][NODE_MAX + 1U];
+
+/* Capabilities of the slave that the requirement currently asks for */
+#define PM_REQ_CAPS(req)	((0U != (PM_MASTER_USING_SLAVE_MASK & (req)->info)) ? \
+				 (req)->currReq : 0U)
+
 /**
  * PmRequirementLink() - Link requirement struct into master's and slave's lists
  * @req	Pointer to the requirement structure to be linked in lists
@@ -904,13 +921,52 @@ static void PmRequirementLink(PmRequirement* const req)
  */
 void PmRequirementInit(void)
 {
-	u32 i;
+	u32 i, n;
+	u32 mstIdx;
+
+	for (i = 0U; i < PM_MASTER_MAX; i++) {
+		for (n = 0U; n <= NODE_MAX; n++) {
+			pmReqIdx[i][n] = PM_REQ_IDX_NONE;
+		}
+	}
 
 	for (i = 0U; i < ARRAY_SIZE(pmReqData); i++) {
 		PmRequirementLink(&pmReqData[i]);
+
+		mstIdx = pmReqData[i].master->idx;
+		if (mstIdx < PM_MASTER_MAX) {
+			pmReqIdx[mstIdx][pmReqData[i].slave->node.nodeId] = (u8)i;
+		}
+		/* Every slave that can be requested needs its capabilities map */
+		if (0U == pmReqData[i].slave->capsMap) {
+			PmSlaveInitCapsMap(pmReqData[i].slave);
+		}
+		/* Account the initial requirements in the slave's aggregate */
+		PmSlaveAccountCaps(pmReqData[i].slave, 0U,
+				   PM_REQ_CAPS(&pmReqData[i]));
 	}
 }
 
+/**
+ * PmRequirementSet() - Set info flags and current capabilities of requirement
+ * @req     Requirement to be changed
+ * @info    New info flags of the requirement
+ * @caps    New current capabilities of the requirement
+ *
+ * @note    Usage flag and current capabilities must only be changed through
+ *          this function, so that the slave's aggregated requirements stay
+ *          in sync. The slave's state is not updated here.
+ */
+void PmRequirementSet(PmRequirement* const req, const u8 info,
+		      const u32 caps)
+{
+	const u32 prevCaps = PM_REQ_CAPS(req);
+
+	req->info = info;
+	req->currReq = caps;
+	PmSlaveAccountCaps(req->slave, prevCaps, PM_REQ_CAPS(req));
+}
+
 /**
  * PmRequirementSchedule() - Schedule requirements of the master for slave
  * @masterReq   Pointer to master requirement structure (for a slave)
@@ -964,7 +1020,7 @@ int PmRequirementUpdate(PmRequirement* const masterReq, const u32 caps)
 
 	/* Configure requested capabilities */
 	tmpCaps = masterReq->currReq;
-	masterReq->currReq = caps;
+	PmRequirementSet(masterReq, masterReq->info, caps);
 	status = PmUpdateSlave(masterReq->slave);
 
 	if (XST_SUCCESS == status) {
@@ -972,7 +1028,7 @@ int PmRequirementUpdate(PmRequirement* const masterReq, const u32 caps)
 		masterReq->nextReq = masterReq->currReq;
 	} else {
 		/* Remember the last setting, will report an error */
-		masterReq->currReq = tmpCaps;
+		PmRequirementSet(masterReq, masterReq->info, tmpCaps);
 	}
 
 done:
@@ -1024,7 +1080,7 @@ static int PmRequirementUpdateScheduled(const PmMaster* const master,
 				}
 			}
 
-			req->currReq = tmpReq;
+			PmRequirementSet(req, req->info, tmpReq);
 
 			/* Update slave setting */
 			status = PmUpdateSlave(req->slave);
@@ -1077,7 +1133,9 @@ static void PmRequirementRequestDefault(const PmMaster* const master)
 	while (NULL != req) {
 		if (0U != req->defaultReq) {
 			/* Set flag to state that master is using slave */
-			req->info |= PM_MASTER_USING_SLAVE_MASK;
+			PmRequirementSet(req, (u8)(req->info |
+					 PM_MASTER_USING_SLAVE_MASK),
+					 req->currReq);
 			req->nextReq = req->defaultReq;
 		}
 		req = req->nextSlave;
@@ -1099,9 +1157,9 @@ static int PmRequirementReleaseAll(const PmMaster* const master)
 	while (NULL != req) {
 		if (0U != (PM_MASTER_USING_SLAVE_MASK & req->info)) {
 			/* Clear flag - master is not using slave anymore */
-			req->info &= ~PM_MASTER_USING_SLAVE_MASK;
 			/* Release current and next requirements */
-			req->currReq = 0U;
+			PmRequirementSet(req, (u8)(req->info &
+					 ~PM_MASTER_USING_SLAVE_MASK), 0U);
 			req->nextReq = 0U;
 			/* Update slave setting */
 			status = PmUpdateSlave(req->slave);
@@ -1131,15 +1189,17 @@ static int PmRequirementReleaseAll(const PmMaster* const master)
 PmRequirement* PmGetRequirementForSlave(const PmMaster* const master,
 					const PmNodeId nodeId)
 {
-	PmRequirement* req = master->reqs;
+	PmRequirement* req = NULL;
+	u32 mstIdx = master->idx;
 
-	while (NULL != req) {
-		if (nodeId == req->slave->node.nodeId) {
-			break;
-		}
-		req = req->nextSlave;
+	if ((mstIdx >= PM_MASTER_MAX) || (nodeId > NODE_MAX) ||
+	    (PM_REQ_IDX_NONE == pmReqIdx[mstIdx][nodeId])) {
+		goto done;
 	}
 
+	req = &pmReqData[pmReqIdx[mstIdx][nodeId]];
+
+done:
 	return req;
 }
 
@@ -1176,13 +1236,10 @@ const PmMaster* PmGetMasterByIpiMask(const u32 mask)
 PmProc* PmGetProcOfThisMaster(const PmMaster* const master,
 			      const PmNodeId nodeId)
 {
-	u32 i;
-	PmProc *proc = NULL;
+	PmProc *proc = PmGetProcByNodeId(nodeId);
 
-	for (i = 0U; i < master->procsCnt; i++) {
-		if (nodeId == master->procs[i].node.nodeId) {
-			proc = &master->procs[i];
-		}
+	if ((NULL != proc) && (master != proc->master)) {
+		proc = NULL;
 	}
 
 	return proc;
@@ -1200,25 +1257,12 @@ PmProc* PmGetProcOfThisMaster(const PmMaster* const master,
 PmProc* PmGetProcOfOtherMaster(const PmMaster* const master,
 			       const PmNodeId nodeId)
 {
-	u32 i;
-	PmProc *proc = NULL;
-
-	for (i = 0U; i < ARRAY_SIZE(pmAllMasters); i++) {
-		u32 p;
-
-		if (master == pmAllMasters[i]) {
-			continue;
-		}
+	PmProc *proc = PmGetProcByNodeId(nodeId);
 
-		for (p = 0U; p < pmAllMasters[i]->procsCnt; p++) {
-			if (nodeId == pmAllMasters[i]->procs[p].node.nodeId) {
-				proc = &pmAllMasters[i]->procs[p];
-				goto done;
-			}
-		}
+	if ((NULL != proc) && (master == proc->master)) {
+		proc = NULL;
 	}
 
-done:
 	return proc;
 }
 
@@ -1231,21 +1275,14 @@ done:
  */
 PmProc* PmGetProcByNodeId(const PmNodeId nodeId)
 {
-	u32 i;
 	PmProc *proc = NULL;
+	PmNode* node = PmGetNodeById(nodeId);
 
-	for (i = 0U; i < ARRAY_SIZE(pmAllMasters); i++) {
-		u32 p;
-
-		for (p = 0U; p < pmAllMasters[i]->procsCnt; p++) {
-			if (nodeId == pmAllMasters[i]->procs[p].node.nodeId) {
-				proc = &pmAllMasters[i]->procs[p];
-				goto done;
-			}
-		}
+	/* Processor nodes are derived from their processor structures */
+	if ((NULL != node) && (true == NODE_IS_PROC(node->typeId))) {
+		proc = (PmProc*)node->derived;
 	}
 
-done:
 	return proc;
 }
 
@@ -1601,8 +1638,9 @@ void PmSetupInitialMasterRequirements(void)
 		masterReq = PmGetRequirementForSlave(&pmMasterApu_g,
 						     apuDefaultSlaves[i]);
 		if (NULL != masterReq) {
-			masterReq->info |= PM_MASTER_USING_SLAVE_MASK;
-			masterReq->currReq = PM_CAP_ACCESS;
+			PmRequirementSet(masterReq, (u8)(masterReq->info |
+					 PM_MASTER_USING_SLAVE_MASK),
+					 PM_CAP_ACCESS);
 			masterReq->nextReq = PM_CAP_ACCESS;
 		}
 	}
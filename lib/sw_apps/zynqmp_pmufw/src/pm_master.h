@@ -60,6 +60,11 @@ typedef struct PmRequirement PmRequirement;
 /* Maximum number of masters currently supported */
 #define PM_MASTER_MAX               3U
 
+/* Position of the masters in pmAllMasters array */
+#define PM_MASTER_APU_IDX           0U
+#define PM_MASTER_RPU_0_IDX         1U
+#define PM_MASTER_RPU_1_IDX         2U
+
 /* Master state definitions */
 
 /* Master is active if at least one of its processors is in active state */
@@ -148,6 +153,7 @@ typedef struct {
  *              processors in the PU. In RPU case, this data could be
  *              initialized from PCW, based on RPU configuration.
  * @procsCnt    Number of processors within the master
+ * @idx         Position of the master in pmAllMasters array
  * @permissions ORed ipi masks of masters which this master is allowed to
  *              request to suspend (to be updated based on specific
  *              configuration, by default all masters should be able to request
@@ -173,6 +179,7 @@ typedef struct PmMaster {
 	u32 permissions;
 	PmNodeId nid;
 	const u8 procsCnt;
+	const u8 idx;
 	u8 state;
 } PmMaster;
 
@@ -204,6 +211,8 @@ PmRequirement* PmGetRequirementForSlave(const PmMaster* const master,
 /* Requirements related functions */
 int PmRequirementSchedule(PmRequirement* const masterReq, const u32 caps);
 int PmRequirementUpdate(PmRequirement* const masterReq, const u32 caps);
+void PmRequirementSet(PmRequirement* const req, const u8 info,
+		      const u32 caps);
 
 void PmRequirementInit(void);
 
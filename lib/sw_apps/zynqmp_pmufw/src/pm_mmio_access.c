@@ -37,6 +37,24 @@
 #define PM_MMIO_IOU_SLCR_BASE  0xFF180000
 #define PM_MMIO_CSU_BASE       0xFFCA0000
 
+/*
+ * Memory in which each master may place PM_BATCH command tables. The PMU
+ * writes call responses into the table, so a region must only be given to
+ * the master which owns the memory. Each RPU uses its own TCM (global
+ * addresses) by default. The APU has no default region, since the PMU cannot
+ * tell which part of the DDR belongs to it: PM_BATCH_APU_START and
+ * PM_BATCH_APU_END must be defined by the build to a buffer reserved for the
+ * tables, otherwise PM_BATCH calls from the APU are rejected.
+ */
+#ifndef PM_BATCH_RPU_0_START
+#define PM_BATCH_RPU_0_START	0xFFE00000U
+#define PM_BATCH_RPU_0_END	0xFFE2FFFFU
+#endif
+#ifndef PM_BATCH_RPU_1_START
+#define PM_BATCH_RPU_1_START	0xFFE90000U
+#define PM_BATCH_RPU_1_END	0xFFEBFFFFU
+#endif
+
 #define WRITE_PERM_SHIFT	16
 #define MMIO_ACCESS_RO(m)	(m)
 #define MMIO_ACCESS_RW(m)	((m) | ((m) << WRITE_PERM_SHIFT))
@@ -143,6 +161,28 @@ static const PmAccessRegion pmAccessTable[] = {
 	},
 };
 
+static const PmAccessRegion pmBatchAccessTable[] = {
+#if defined(PM_BATCH_APU_START) && defined(PM_BATCH_APU_END)
+	{
+		.startAddr = PM_BATCH_APU_START,
+		.endAddr = PM_BATCH_APU_END,
+		.access = MMIO_ACCESS_RW(IPI_PMU_0_IER_APU_MASK),
+	},
+#endif
+
+	{
+		.startAddr = PM_BATCH_RPU_0_START,
+		.endAddr = PM_BATCH_RPU_0_END,
+		.access = MMIO_ACCESS_RW(IPI_PMU_0_IER_RPU_0_MASK),
+	},
+
+	{
+		.startAddr = PM_BATCH_RPU_1_START,
+		.endAddr = PM_BATCH_RPU_1_END,
+		.access = MMIO_ACCESS_RW(IPI_PMU_0_IER_RPU_1_MASK),
+	},
+};
+
 /**
  * PmGetMmioAccess() - Retrieve access info for a particular address
  * @master     Master who requests access permission
@@ -190,3 +230,36 @@ bool PmGetMmioAccessWrite(const PmMaster *const master, const u32 address)
 {
 	return PmGetMmioAccess(master, address, MMIO_ACCESS_TYPE_WRITE);
 }
+
+/**
+ * PmGetBatchAccess() - Check whether a master may place a PM_BATCH command
+ *                      table in a memory range
+ * @master     Master who issued the PM_BATCH call
+ * @first      Address of the first byte of the table
+ * @last       Address of the last byte of the table
+ *
+ * @return     Return true if the whole range is within a single region of the
+ *             batch access table that the master has read/write access to
+ */
+bool PmGetBatchAccess(const PmMaster *const master, const u32 first,
+		      const u32 last)
+{
+	u32 i;
+	bool permission = false;
+
+	if ((NULL == master) || (last < first)) {
+		goto done;
+	}
+
+	for (i = 0U; i < ARRAY_SIZE(pmBatchAccessTable); i++) {
+		if ((first >= pmBatchAccessTable[i].startAddr) &&
+		    (last <= pmBatchAccessTable[i].endAddr)) {
+			permission = !!(pmBatchAccessTable[i].access &
+					(master->ipiMask << WRITE_PERM_SHIFT));
+			break;
+		}
+	}
+
+done:
+	return permission;
+}
@@ -36,5 +36,7 @@
  ********************************************************************/
 bool PmGetMmioAccessRead(const PmMaster *const master, const u32 address);
 bool PmGetMmioAccessWrite(const PmMaster *const master, const u32 address);
+bool PmGetBatchAccess(const PmMaster *const master, const u32 first,
+		      const u32 last);
 
 #endif
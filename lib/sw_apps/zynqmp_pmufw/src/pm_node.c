@@ -43,69 +43,73 @@
 #include "pm_notifier.h"
 #include "pm_ddr.h"
 
-static PmNode* const pmNodes[NODE_MAX] = {
-	&pmApuProcs_g[PM_PROC_APU_0].node,
-	&pmApuProcs_g[PM_PROC_APU_1].node,
-	&pmApuProcs_g[PM_PROC_APU_2].node,
-	&pmApuProcs_g[PM_PROC_APU_3].node,
-	&pmRpuProcs_g[PM_PROC_RPU_0].node,
-	&pmRpuProcs_g[PM_PROC_RPU_1].node,
-	&pmPowerIslandRpu_g.node,
-	&pmPowerIslandApu_g.node,
-	&pmPowerDomainFpd_g.node,
-	&pmPowerDomainPld_g.node,
-	&pmSlaveL2_g.slv.node,
-	&pmSlaveOcm0_g.slv.node,
-	&pmSlaveOcm1_g.slv.node,
-	&pmSlaveOcm2_g.slv.node,
-	&pmSlaveOcm3_g.slv.node,
-	&pmSlaveTcm0A_g.slv.node,
-	&pmSlaveTcm0B_g.slv.node,
-	&pmSlaveTcm1A_g.slv.node,
-	&pmSlaveTcm1B_g.slv.node,
-	&pmSlaveUsb0_g.slv.node,
-	&pmSlaveUsb1_g.slv.node,
-	&pmSlaveTtc0_g.slv.node,
-	&pmSlaveTtc1_g.slv.node,
-	&pmSlaveTtc2_g.slv.node,
-	&pmSlaveTtc3_g.slv.node,
-	&pmSlaveSata_g.slv.node,
-	&pmSlaveApll_g.slv.node,
-	&pmSlaveVpll_g.slv.node,
-	&pmSlaveDpll_g.slv.node,
-	&pmSlaveRpll_g.slv.node,
-	&pmSlaveIOpll_g.slv.node,
-	&pmSlaveGpuPP0_g.slv.node,
-	&pmSlaveGpuPP1_g.slv.node,
-	&pmSlaveUart0_g.node,
-	&pmSlaveUart1_g.node,
-	&pmSlaveSpi0_g.node,
-	&pmSlaveSpi1_g.node,
-	&pmSlaveI2C0_g.node,
-	&pmSlaveI2C1_g.node,
-	&pmSlaveSD0_g.node,
-	&pmSlaveSD1_g.node,
-	&pmSlaveCan0_g.node,
-	&pmSlaveCan1_g.node,
-	&pmSlaveEth0_g.node,
-	&pmSlaveEth1_g.node,
-	&pmSlaveEth2_g.node,
-	&pmSlaveEth3_g.node,
-	&pmSlaveAdma_g.node,
-	&pmSlaveGdma_g.node,
-	&pmSlaveDP_g.node,
-	&pmSlaveNand_g.node,
-	&pmSlaveQSpi_g.node,
-	&pmSlaveGpio_g.node,
-	&pmSlaveAFI_g.node,
-	&pmSlaveDdr_g.node,
-	&pmSlaveIpiApu_g.node,
-	&pmSlaveIpiRpu0_g.node,
-	&pmSlaveGpu_g.node,
-	&pmSlavePcie_g.node,
-	&pmSlavePcap_g.node,
-	&pmSlaveRtc_g.node,
-	&pmPowerDomainLpd_g.node,
+/*
+ * Nodes are indexed directly by their node ID, so the lookup of a node does not
+ * depend on the number of nodes. Entries for unused node IDs are NULL.
+ */
+static PmNode* const pmNodes[NODE_MAX + 1U] = {
+	[NODE_APU_0] = &pmApuProcs_g[PM_PROC_APU_0].node,
+	[NODE_APU_1] = &pmApuProcs_g[PM_PROC_APU_1].node,
+	[NODE_APU_2] = &pmApuProcs_g[PM_PROC_APU_2].node,
+	[NODE_APU_3] = &pmApuProcs_g[PM_PROC_APU_3].node,
+	[NODE_RPU_0] = &pmRpuProcs_g[PM_PROC_RPU_0].node,
+	[NODE_RPU_1] = &pmRpuProcs_g[PM_PROC_RPU_1].node,
+	[NODE_RPU] = &pmPowerIslandRpu_g.node,
+	[NODE_APU] = &pmPowerIslandApu_g.node,
+	[NODE_FPD] = &pmPowerDomainFpd_g.node,
+	[NODE_PL] = &pmPowerDomainPld_g.node,
+	[NODE_L2] = &pmSlaveL2_g.slv.node,
+	[NODE_OCM_BANK_0] = &pmSlaveOcm0_g.slv.node,
+	[NODE_OCM_BANK_1] = &pmSlaveOcm1_g.slv.node,
+	[NODE_OCM_BANK_2] = &pmSlaveOcm2_g.slv.node,
+	[NODE_OCM_BANK_3] = &pmSlaveOcm3_g.slv.node,
+	[NODE_TCM_0_A] = &pmSlaveTcm0A_g.slv.node,
+	[NODE_TCM_0_B] = &pmSlaveTcm0B_g.slv.node,
+	[NODE_TCM_1_A] = &pmSlaveTcm1A_g.slv.node,
+	[NODE_TCM_1_B] = &pmSlaveTcm1B_g.slv.node,
+	[NODE_USB_0] = &pmSlaveUsb0_g.slv.node,
+	[NODE_USB_1] = &pmSlaveUsb1_g.slv.node,
+	[NODE_TTC_0] = &pmSlaveTtc0_g.slv.node,
+	[NODE_TTC_1] = &pmSlaveTtc1_g.slv.node,
+	[NODE_TTC_2] = &pmSlaveTtc2_g.slv.node,
+	[NODE_TTC_3] = &pmSlaveTtc3_g.slv.node,
+	[NODE_SATA] = &pmSlaveSata_g.slv.node,
+	[NODE_APLL] = &pmSlaveApll_g.slv.node,
+	[NODE_VPLL] = &pmSlaveVpll_g.slv.node,
+	[NODE_DPLL] = &pmSlaveDpll_g.slv.node,
+	[NODE_RPLL] = &pmSlaveRpll_g.slv.node,
+	[NODE_IOPLL] = &pmSlaveIOpll_g.slv.node,
+	[NODE_GPU_PP_0] = &pmSlaveGpuPP0_g.slv.node,
+	[NODE_GPU_PP_1] = &pmSlaveGpuPP1_g.slv.node,
+	[NODE_UART_0] = &pmSlaveUart0_g.node,
+	[NODE_UART_1] = &pmSlaveUart1_g.node,
+	[NODE_SPI_0] = &pmSlaveSpi0_g.node,
+	[NODE_SPI_1] = &pmSlaveSpi1_g.node,
+	[NODE_I2C_0] = &pmSlaveI2C0_g.node,
+	[NODE_I2C_1] = &pmSlaveI2C1_g.node,
+	[NODE_SD_0] = &pmSlaveSD0_g.node,
+	[NODE_SD_1] = &pmSlaveSD1_g.node,
+	[NODE_CAN_0] = &pmSlaveCan0_g.node,
+	[NODE_CAN_1] = &pmSlaveCan1_g.node,
+	[NODE_ETH_0] = &pmSlaveEth0_g.node,
+	[NODE_ETH_1] = &pmSlaveEth1_g.node,
+	[NODE_ETH_2] = &pmSlaveEth2_g.node,
+	[NODE_ETH_3] = &pmSlaveEth3_g.node,
+	[NODE_ADMA] = &pmSlaveAdma_g.node,
+	[NODE_GDMA] = &pmSlaveGdma_g.node,
+	[NODE_DP] = &pmSlaveDP_g.node,
+	[NODE_NAND] = &pmSlaveNand_g.node,
+	[NODE_QSPI] = &pmSlaveQSpi_g.node,
+	[NODE_GPIO] = &pmSlaveGpio_g.node,
+	[NODE_AFI] = &pmSlaveAFI_g.node,
+	[NODE_DDR] = &pmSlaveDdr_g.node,
+	[NODE_IPI_APU] = &pmSlaveIpiApu_g.node,
+	[NODE_IPI_RPU_0] = &pmSlaveIpiRpu0_g.node,
+	[NODE_GPU] = &pmSlaveGpu_g.node,
+	[NODE_PCIE] = &pmSlavePcie_g.node,
+	[NODE_PCAP] = &pmSlavePcap_g.node,
+	[NODE_RTC] = &pmSlaveRtc_g.node,
+	[NODE_LPD] = &pmPowerDomainLpd_g.node,
 };
 
 /**
@@ -116,16 +120,15 @@ static PmNode* const pmNodes[NODE_MAX] = {
  */
 PmNode* PmGetNodeById(const u32 nodeId)
 {
-	u32 i;
 	PmNode* node = NULL;
 
-	for (i = 0U; i < NODE_MAX; i++) {
-		if (pmNodes[i]->nodeId == nodeId) {
-			node = pmNodes[i];
-			break;
-		}
+	if ((nodeId < NODE_MIN) || (nodeId > NODE_MAX)) {
+		goto done;
 	}
 
+	node = pmNodes[nodeId];
+
+done:
 	return node;
 }
 
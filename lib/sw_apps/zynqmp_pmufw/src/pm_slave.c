@@ -46,6 +46,10 @@
 #include "pm_ddr.h"
 #include "pm_clock.h"
 
+/* Number of capability combinations tracked in the slave's capsMap */
+#define PM_CAPS_MAP_SIZE	((PM_CAP_ACCESS | PM_CAP_CONTEXT | PM_CAP_WAKEUP | \
+				  PM_CAP_POWER | PM_CAP_CLOCK) + 1U)
+
 /* All slaves array */
 static PmSlave* const pmSlaves[] = {
 	&pmSlaveL2_g.slv,
@@ -113,21 +117,10 @@ static PmSlave* const pmSlaves[] = {
  */
 bool PmSlaveRequiresPower(const PmSlave* const slave)
 {
-	PmRequirement* req = slave->reqs;
-	bool hasRequests = false;
 	bool requiresPower = false;
 
-	while (NULL != req) {
-		if ((0U != (PM_MASTER_USING_SLAVE_MASK & req->info)) &&
-		    (0U != req->currReq)) {
-			/* Slave is used by this master and has current request for caps */
-			hasRequests = true;
-			break;
-		}
-		req = req->nextMaster;
-	}
-
-	if (true == hasRequests) {
+	/* Some master that uses the slave has a current request for caps */
+	if (0U != slave->reqCaps) {
 		if (0U != (PM_CAP_POWER &
 			   slave->slvFsm->states[slave->node.currState])) {
 			requiresPower = true;
@@ -138,24 +131,34 @@ bool PmSlaveRequiresPower(const PmSlave* const slave)
 }
 
 /**
- * PmGetMaxCapabilities()- Get maximum of all requested capabilities of slave
- * @slave   Slave whose maximum required capabilities should be determined
+ * PmSlaveAccountCaps() - Account a change of a requirement for the slave
+ * @slave       Slave whose requirement has changed
+ * @prevCaps    Capabilities the requirement contributed before the change
+ * @caps        Capabilities the requirement contributes after the change
  *
- * @return  32bit value encoding the capabilities
+ * Keeps the union of all masters' requirements up to date, so that it does
+ * not have to be collected from the requirements list on every slave update.
  */
-static u32 PmGetMaxCapabilities(const PmSlave* const slave)
+void PmSlaveAccountCaps(PmSlave* const slave, const u32 prevCaps,
+			const u32 caps)
 {
-	PmRequirement* req = slave->reqs;
-	u32 maxCaps = 0U;
-
-	while (NULL != req) {
-		if (0U != (PM_MASTER_USING_SLAVE_MASK & req->info)) {
-			maxCaps |= req->currReq;
+	u32 i;
+	u32 bit;
+
+	for (i = 0U; i < PM_SLAVE_CAPS_BITS; i++) {
+		bit = (u32)1U << i;
+		if ((0U != (prevCaps & bit)) && (0U == (caps & bit))) {
+			slave->reqCapsCnt[i]--;
+			if (0U == slave->reqCapsCnt[i]) {
+				slave->reqCaps &= ~bit;
+			}
+		} else if ((0U == (prevCaps & bit)) && (0U != (caps & bit))) {
+			slave->reqCapsCnt[i]++;
+			slave->reqCaps |= bit;
+		} else {
+			/* Contribution to this capability is unchanged */
 		}
-		req = req->nextMaster;
 	}
-
-	return maxCaps;
 }
 
 /**
@@ -173,6 +176,14 @@ int PmCheckCapabilities(const PmSlave* const slave, const u32 capabilities)
 	PmStateId i;
 	int status = XST_NO_FEATURE;
 
+	/* Use the cached map when the capabilities are covered by it */
+	if ((0U != slave->capsMap) && (capabilities < PM_CAPS_MAP_SIZE)) {
+		if (0U != (slave->capsMap & ((u32)1U << capabilities))) {
+			status = XST_SUCCESS;
+		}
+		goto done;
+	}
+
 	for (i = 0U; i < slave->slvFsm->statesCnt; i++) {
 		/* Find the first state that contains all capabilities */
 		if ((capabilities & slave->slvFsm->states[i]) == capabilities) {
@@ -181,9 +192,36 @@ int PmCheckCapabilities(const PmSlave* const slave, const u32 capabilities)
 		}
 	}
 
+done:
 	return status;
 }
 
+/**
+ * PmSlaveInitCapsMap() - Build the map of capabilities the slave can provide
+ * @slave   Slave whose map should be built
+ *
+ * The map has one bit per combination of capabilities, so checking whether
+ * the slave has a state with requested capabilities does not require walking
+ * through all the states of the slave on every request.
+ */
+void PmSlaveInitCapsMap(PmSlave* const slave)
+{
+	PmStateId i;
+	u32 caps;
+	u32 map = 0U;
+
+	for (caps = 0U; caps < PM_CAPS_MAP_SIZE; caps++) {
+		for (i = 0U; i < slave->slvFsm->statesCnt; i++) {
+			if ((caps & slave->slvFsm->states[i]) == caps) {
+				map |= (u32)1U << caps;
+				break;
+			}
+		}
+	}
+
+	slave->capsMap = map;
+}
+
 /**
  * PmSlaveHasWakeUpCap() - Check if the slave has a wake-up capability
  * @slv		Slave to be checked
@@ -470,7 +508,7 @@ int PmUpdateSlave(PmSlave* const slave)
 	PmStateId state = 0U;
 	int status = XST_SUCCESS;
 	u32 wkupLat, minLat, latencyMargin;
-	u32 capsToSet = PmGetMaxCapabilities(slave);
+	u32 capsToSet = slave->reqCaps;
 	PmPower* parent;
 
 	if (0U != capsToSet) {
@@ -57,6 +57,9 @@ typedef int (*const PmSlaveFsmHandler)(PmSlave* const slave,
 /* Mask definitions for slave's flags */
 #define PM_SLAVE_FLAG_IS_SHAREABLE	0x1U
 
+/* Number of capability bits (PM_CAP_ACCESS up to PM_CAP_CLOCK) */
+#define PM_SLAVE_CAPS_BITS		5U
+
 /*********************************************************************
  * Structure definitions
  ********************************************************************/
@@ -98,12 +101,22 @@ typedef struct {
  * @slvFsm      Slave finite state machine
  * @flags       Slave's flags (bit 0: whether the slave is shareable (1) or
  *              exclusive (0) resource)
+ * @capsMap     Cached map of capability combinations the slave can provide.
+ *              Bit n is set if the slave has a state with all capabilities
+ *              encoded in n. Zero if the map is not built yet.
+ * @reqCaps     Union of the capabilities currently required by the masters
+ *              that use the slave, updated by PmSlaveAccountCaps on every
+ *              change of a requirement
+ * @reqCapsCnt  Number of requirements that contribute each bit of reqCaps
  */
 typedef struct PmSlave {
 	PmNode node;
 	PmRequirement* reqs;
 	const PmGicProxyWake* const wake;
 	const PmSlaveFsm* slvFsm;
+	u32 capsMap;
+	u32 reqCaps;
+	u8 reqCapsCnt[PM_SLAVE_CAPS_BITS];
 	u8 flags;
 } PmSlave;
 
@@ -112,6 +125,9 @@ typedef struct PmSlave {
  ********************************************************************/
 int PmUpdateSlave(PmSlave* const slave);
 int PmCheckCapabilities(const PmSlave* const slave, const u32 capabilities);
+void PmSlaveInitCapsMap(PmSlave* const slave);
+void PmSlaveAccountCaps(PmSlave* const slave, const u32 prevCaps,
+			const u32 caps);
 int PmSlaveHasWakeUpCap(const PmSlave* const slv);
 
 bool PmSlaveRequiresPower(const PmSlave* const slave);
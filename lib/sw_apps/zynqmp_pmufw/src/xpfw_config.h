@@ -51,6 +51,13 @@
  * ENABLE_EM        - Enable Error Management Module
  * ENABLE_RTC_TEST  - Enable RTC Event Handler Test Module
  * ENABLE_SCHEDULER - Enable Scheduler Test Module
+ * ENABLE_PM_BENCHMARK - Record service time of PM API calls in PMU cycles
+ *                       (uses PIT2 as a free running counter), printed by
+ *                       XPfw_CorePrintStats
+ * PM_BATCH_APU_START/PM_BATCH_APU_END - First and last address of the buffer
+ *                       in which the APU may place PM_BATCH command tables.
+ *                       PM_BATCH calls from the APU are rejected unless both
+ *                       are defined
  */
 
 /* Enable Power Management Module */
@@ -35,6 +35,9 @@
 #include "xpfw_events.h"
 #include "xpfw_interrupts.h"
 #include "xpfw_ipi_manager.h"
+#if defined(ENABLE_PM) && defined(ENABLE_PM_BENCHMARK)
+#include "pm_core.h"
+#endif
 
 #define CORE_IS_READY	((u32)0x5AFEC0DEU)
 #define CORE_IS_DEAD	((u32)0xDEADBEAFU)
@@ -310,6 +313,10 @@ void XPfw_CorePrintStats(void)
 	fw_printf("Module Count: %d (%d)\r\n", CorePtr->ModCount, XPFW_MAX_MOD_COUNT);
 	fw_printf("Scheduler State: %s\r\n",((CorePtr->Scheduler.Enabled == TRUE)?"ENABLED":"DISABLED"));
 	fw_printf("Scheduler Ticks: %lu\r\n",CorePtr->Scheduler.Tick);
+	XPfw_SchedulerPrintStats(&CorePtr->Scheduler);
+#if defined(ENABLE_PM) && defined(ENABLE_PM_BENCHMARK)
+	PmBenchReport();
+#endif
 	fw_printf("######################################################\r\n");
 	}
 }
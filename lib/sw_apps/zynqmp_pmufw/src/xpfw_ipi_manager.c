@@ -46,6 +46,10 @@ static XIpiPsu IpiInst;
 static XIpiPsu *IpiInstPtr = &IpiInst;
 u32 IpiMaskList[XPFW_IPI_MASK_COUNT] = {0U};
 
+/* Buffer which receives responses instead of the IPI response buffer */
+static u32 *IpiCapturePtr = NULL;
+static u32 IpiCaptureLen = 0U;
+
 s32 XPfw_IpiManagerInit(void)
  {
 	s32 Status;
@@ -98,6 +102,7 @@ Done:
 s32 XPfw_IpiWriteResponse(const XPfw_Module_t *ModPtr, u32 DestCpuMask, u32 *MsgPtr, u32 MsgLen)
  {
 	s32 Status;
+	u32 Idx;
 
 	if ((ModPtr == NULL) || (MsgPtr == NULL)) {
 		Status = XST_FAILURE;
@@ -105,6 +110,16 @@ s32 XPfw_IpiWriteResponse(const XPfw_Module_t *ModPtr, u32 DestCpuMask, u32 *Msg
 	}
 
 	MsgPtr[0] = (MsgPtr[0] & 0x0000FFFFU) | ((u32)ModPtr->IpiId << 16U);
+
+	if (IpiCapturePtr != NULL) {
+		/* Response is captured, e.g. as a result of a batched request */
+		for (Idx = 0U; (Idx < MsgLen) && (Idx < IpiCaptureLen); Idx++) {
+			IpiCapturePtr[Idx] = MsgPtr[Idx];
+		}
+		Status = XST_SUCCESS;
+		goto Done;
+	}
+
 	Status = XIpiPsu_WriteMessage(IpiInstPtr, DestCpuMask, MsgPtr, MsgLen,
 			XIPIPSU_BUF_TYPE_RESP);
 
@@ -112,6 +127,12 @@ Done:
 	return Status;
 }
 
+void XPfw_IpiCaptureResponse(u32 *BufPtr, u32 BufLen)
+{
+	IpiCapturePtr = BufPtr;
+	IpiCaptureLen = (BufPtr != NULL) ? BufLen : 0U;
+}
+
 s32 XPfw_IpiReadMessage(u32 SrcCpuMask, u32 *MsgPtr, u32 MsgLen)
  {
 	s32 Status = XST_FAILURE;
@@ -75,6 +75,16 @@ s32 XPfw_IpiWriteMessage(const XPfw_Module_t *ModPtr, u32 DestCpuMask, u32 *MsgP
  */
 s32 XPfw_IpiWriteResponse(const XPfw_Module_t *ModPtr, u32 DestCpuMask, u32 *MsgPtr, u32 MsgLen);
 
+/**
+ * Redirect responses into a buffer instead of the IPI Response Buffer
+ * Used to collect the result of each call of a batched request, the
+ * response of the batch itself is then written to the IPI Response Buffer
+ * @param BufPtr is pointer to the buffer receiving the responses, or NULL to
+ *        stop capturing
+ * @param BufLen is the number of 32-bit words available in the buffer
+ */
+void XPfw_IpiCaptureResponse(u32 *BufPtr, u32 BufLen);
+
 /**
  * Read Message buffer contents (Used only by Core)
  * @param SrcCpuMask is mask for the Source CPU
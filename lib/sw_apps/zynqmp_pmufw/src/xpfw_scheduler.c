@@ -31,11 +31,27 @@
 #include "xpfw_scheduler.h"
 
 /**
- * PMU PIT Clock Frequency and Tick Calculation
+ * PMU PIT Clock Frequency and Time Conversion
+ *
+ * The scheduler is tickless: the PIT is programmed for the earliest task
+ * deadline only, so the PMU is not woken up while no task is due. Time is kept in PIT counts by accumulating the expired part of
+ * each programmed PIT period, read back from the PIT counter.
+ *
+ * The PIT is started with the period to the next deadline and the preload
+ * register is then set to RELOAD_COUNT, so at expiry the counter reloads and
+ * keeps running instead of stopping. Periods are limited to MAX_PERIOD, so a
+ * counter value above the programmed period means that the PIT has expired
+ * and tells how long ago, however late the interrupt is handled.
  */
 #define PMU_PIT_CLK_FREQ	XPFW_CFG_PMU_CLK_FREQ
-#define TICK_MILLISECONDS	10U
-#define COUNT_PER_TICK ((PMU_PIT_CLK_FREQ / 1000U)* TICK_MILLISECONDS )
+#define US_TO_COUNTS(Us)	((u32)(((u64)(Us) * (u64)PMU_PIT_CLK_FREQ) / 1000000U))
+#define COUNTS_TO_US(Cnt)	((u32)(((u64)(Cnt) * 1000000U) / (u64)PMU_PIT_CLK_FREQ))
+
+/* Shortest PIT period programmed, so an overdue deadline still interrupts */
+#define MIN_COUNT		US_TO_COUNTS(5U)
+#define MAX_COUNT		0xFFFFFFFFU
+#define MAX_PERIOD		0x7FFFFFFFU
+#define RELOAD_COUNT		0xFFFFFFFFU
 
 /**
  * Microblaze IOModule PIT Register Offsets
@@ -45,6 +61,108 @@
 #define PIT_COUNTER_OFFSET	4U
 #define PIT_CONTROL_OFFSET	8U
 
+/* PIT Control Register bits */
+#define PIT_CONTROL_EN		1U
+#define PIT_CONTROL_PRELOAD	2U
+
+/* MicroBlaze MSR Interrupt Enable bit */
+#define MSR_IE_MASK		0x2U
+
+static u32 XPfw_SchedulerLock(void)
+{
+	u32 Msr = mfmsr();
+
+	microblaze_disable_interrupts();
+	return Msr;
+}
+
+static void XPfw_SchedulerUnlock(u32 Msr)
+{
+	/* Only re-enable if interrupts were enabled, e.g. not in an ISR */
+	if ((Msr & MSR_IE_MASK) != 0U) {
+		microblaze_enable_interrupts();
+	}
+}
+
+/* Insert a task into the list of active tasks sorted by deadline */
+static void XPfw_SchedulerInsert(XPfw_Scheduler_t *SchedPtr, u8 Idx)
+{
+	u8 *LinkPtr = &SchedPtr->Head;
+
+	while ((*LinkPtr != XPFW_SCHED_NO_TASK) &&
+		(SchedPtr->TaskList[*LinkPtr].Deadline <=
+				SchedPtr->TaskList[Idx].Deadline)) {
+		LinkPtr = &SchedPtr->TaskList[*LinkPtr].Next;
+	}
+
+	SchedPtr->TaskList[Idx].Next = *LinkPtr;
+	*LinkPtr = Idx;
+}
+
+/* Remove a task from the list of active tasks, if it is on it */
+static void XPfw_SchedulerUnlink(XPfw_Scheduler_t *SchedPtr, u8 Idx)
+{
+	u8 *LinkPtr = &SchedPtr->Head;
+
+	while (*LinkPtr != XPFW_SCHED_NO_TASK) {
+		if (*LinkPtr == Idx) {
+			*LinkPtr = SchedPtr->TaskList[Idx].Next;
+			break;
+		}
+		LinkPtr = &SchedPtr->TaskList[*LinkPtr].Next;
+	}
+
+	SchedPtr->TaskList[Idx].Next = XPFW_SCHED_NO_TASK;
+}
+
+/* Program the PIT to expire at the earliest deadline, or stop it */
+static void XPfw_SchedulerProgram(XPfw_Scheduler_t *SchedPtr)
+{
+	u64 Delta;
+	u32 Count;
+
+	SchedPtr->Now = XPfw_SchedulerGetTime(SchedPtr);
+	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 0U);
+
+	/*
+	 * Drop an expiry of the previous period that is still pending, so
+	 * it is not taken for the end of the new one
+	 */
+	XPfw_Write32(PMU_IOMODULE_IRQ_ACK, PMU_IOMODULE_IRQ_ACK_PIT1_MASK);
+
+	if ((SchedPtr->Enabled != TRUE) ||
+		(SchedPtr->Head == XPFW_SCHED_NO_TASK)) {
+		/* Nothing is due, let the PMU sleep until the next event */
+		SchedPtr->Programmed = 0U;
+		goto done;
+	}
+
+	if (SchedPtr->TaskList[SchedPtr->Head].Deadline > SchedPtr->Now) {
+		Delta = SchedPtr->TaskList[SchedPtr->Head].Deadline -
+				SchedPtr->Now;
+	} else {
+		Delta = 0U;
+	}
+
+	if (Delta < (u64)MIN_COUNT) {
+		Count = MIN_COUNT;
+	} else if (Delta > (u64)MAX_PERIOD) {
+		Count = MAX_PERIOD;
+	} else {
+		Count = (u32)Delta;
+	}
+
+	SchedPtr->Programmed = Count;
+	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET, Count);
+	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET,
+			PIT_CONTROL_EN | PIT_CONTROL_PRELOAD);
+	/* Only used when the period expires, the counter is already loaded */
+	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET, RELOAD_COUNT);
+
+done:
+	return;
+}
+
 XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr)
 {
 	u32 Idx;
@@ -60,11 +178,16 @@ XStatus XPfw_SchedulerInit(XPfw_Scheduler_t *SchedPtr, u32 PitBaseAddr)
 		SchedPtr->TaskList[Idx].Interval = 0U;
 		SchedPtr->TaskList[Idx].Callback = NULL;
 		SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
+		SchedPtr->TaskList[Idx].Next = XPFW_SCHED_NO_TASK;
 	}
 
 	SchedPtr->Enabled = FALSE;
 	SchedPtr->PitBaseAddr = PitBaseAddr;
 	SchedPtr->Tick = 0U;
+	SchedPtr->TaskCount = 0U;
+	SchedPtr->Now = 0U;
+	SchedPtr->Programmed = 0U;
+	SchedPtr->Head = XPFW_SCHED_NO_TASK;
 	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 0U);
 
 	/* Successfully completed init */
@@ -77,17 +200,17 @@ done:
 XStatus XPfw_SchedulerStart(XPfw_Scheduler_t *SchedPtr)
 {
 	XStatus Status;
+	u32 Msr;
 
 	if (SchedPtr == NULL) {
 		Status = XST_FAILURE;
 		goto done;
 	}
 
+	Msr = XPfw_SchedulerLock();
 	SchedPtr->Enabled = TRUE;
-
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET,
-			COUNT_PER_TICK);
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 3U);
+	XPfw_SchedulerProgram(SchedPtr);
+	XPfw_SchedulerUnlock(Msr);
 	Status = XST_SUCCESS;
 
 done:
@@ -96,28 +219,83 @@ done:
 
 XStatus XPfw_SchedulerStop(XPfw_Scheduler_t *SchedPtr)
 {
-	SchedPtr->Enabled =FALSE;
+	u32 Msr;
 
+	Msr = XPfw_SchedulerLock();
+	SchedPtr->Enabled =FALSE;
+	XPfw_SchedulerProgram(SchedPtr);
 	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_PRELOAD_OFFSET, 0U );
-	XPfw_Write32(SchedPtr->PitBaseAddr + PIT_CONTROL_OFFSET, 0U );
+	XPfw_SchedulerUnlock(Msr);
 
 	return XST_SUCCESS;
 }
 
+u64 XPfw_SchedulerGetTime(const XPfw_Scheduler_t *SchedPtr)
+{
+	u64 Time = SchedPtr->Now;
+	u32 Count;
+
+	if (SchedPtr->Programmed != 0U) {
+		Count = XPfw_Read32(SchedPtr->PitBaseAddr + PIT_COUNTER_OFFSET);
+		if (Count <= SchedPtr->Programmed) {
+			Time += (u64)(SchedPtr->Programmed - Count);
+		} else {
+			/* Expired and reloaded with RELOAD_COUNT since then */
+			Time += (u64)SchedPtr->Programmed +
+					(u64)(RELOAD_COUNT - Count) + 1U;
+		}
+	}
+
+	return Time;
+}
+
 void XPfw_SchedulerTickHandler(XPfw_Scheduler_t *SchedPtr)
 {
-	u32 Idx;
-	/* TODO: Add check to detect task misses */
+	u8 Idx;
+	u64 Now;
+	u64 Skipped;
+	struct XPfw_Task_t *TaskPtr;
+
 	SchedPtr->Tick++;
-	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
-		/* Check if it this task can be triggered */
-		if ((0U != SchedPtr->TaskList[Idx].Interval) &&
-			(NULL != SchedPtr->TaskList[Idx].Callback) &&
-			(0U == (SchedPtr->Tick % SchedPtr->TaskList[Idx].Interval))) {
-			/* Mark the Task as TRIGGERED */
-			SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_TRIGGERED;
+
+	/*
+	 * Take the time from the counter rather than assuming the period has
+	 * just expired: the interrupt may be handled late or be left over
+	 * from a period that was reprogrammed
+	 */
+	Now = XPfw_SchedulerGetTime(SchedPtr);
+
+	/* Only the expired tasks at the head of the sorted list are touched */
+	while ((SchedPtr->Head != XPFW_SCHED_NO_TASK) &&
+		(SchedPtr->TaskList[SchedPtr->Head].Deadline <= Now)) {
+		Idx = SchedPtr->Head;
+		TaskPtr = &SchedPtr->TaskList[Idx];
+		SchedPtr->Head = TaskPtr->Next;
+		TaskPtr->Next = XPFW_SCHED_NO_TASK;
+
+		if (XPFW_TASK_STATUS_TRIGGERED == TaskPtr->Status) {
+			/* Previous trigger was not processed in time */
+			TaskPtr->MissCount++;
+		} else {
+			TaskPtr->TriggerTime = TaskPtr->Deadline;
+		}
+		/* Mark the Task as TRIGGERED */
+		TaskPtr->Status = XPFW_TASK_STATUS_TRIGGERED;
+
+		if ((TaskPtr->Flags & XPFW_TASK_FLAG_ONESHOT) == 0U) {
+			TaskPtr->Deadline += (u64)TaskPtr->Interval;
+			if (TaskPtr->Deadline <= Now) {
+				/* Skip the periods that were missed entirely */
+				Skipped = ((Now - TaskPtr->Deadline) /
+						(u64)TaskPtr->Interval) + 1U;
+				TaskPtr->MissCount += (u32)Skipped;
+				TaskPtr->Deadline += Skipped * (u64)TaskPtr->Interval;
+			}
+			XPfw_SchedulerInsert(SchedPtr, Idx);
 		}
 	}
+
+	XPfw_SchedulerProgram(SchedPtr);
 }
 
 XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr)
@@ -125,16 +303,51 @@ XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr)
 	u32 Idx;
 	XStatus Status;
 	u32 CallCount = 0U;
+	u32 Msr;
+	u64 Start;
+	u64 Elapsed;
+	struct XPfw_Task_t *TaskPtr;
 
 	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
+		TaskPtr = &SchedPtr->TaskList[Idx];
 		/* Check if the task is triggered and has a valid Callback */
-		if ((XPFW_TASK_STATUS_TRIGGERED == SchedPtr->TaskList[Idx].Status) &&
-			(NULL != SchedPtr->TaskList[Idx].Callback)) {
+		if ((XPFW_TASK_STATUS_TRIGGERED == TaskPtr->Status) &&
+			(NULL != TaskPtr->Callback)) {
+			Msr = XPfw_SchedulerLock();
+			Start = XPfw_SchedulerGetTime(SchedPtr);
+			/*
+			 * Disable the Task before running it, so a trigger
+			 * raised while the callback runs is not lost
+			 */
+			TaskPtr->Status = XPFW_TASK_STATUS_DISABLED;
+			if (Start > TaskPtr->TriggerTime) {
+				Elapsed = Start - TaskPtr->TriggerTime;
+				if (Elapsed > (u64)TaskPtr->MaxLatency) {
+					TaskPtr->MaxLatency = (Elapsed > (u64)MAX_COUNT) ?
+							MAX_COUNT : (u32)Elapsed;
+				}
+			}
+			XPfw_SchedulerUnlock(Msr);
+
 			/* Execute the Task */
-			SchedPtr->TaskList[Idx].Callback();
-			/* Disable the executed Task */
-			SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
+			TaskPtr->Callback();
+			TaskPtr->RunCount++;
 			CallCount++;
+
+			Msr = XPfw_SchedulerLock();
+			Elapsed = XPfw_SchedulerGetTime(SchedPtr) - Start;
+			if (Elapsed > (u64)TaskPtr->MaxRunTime) {
+				TaskPtr->MaxRunTime = (Elapsed > (u64)MAX_COUNT) ?
+						MAX_COUNT : (u32)Elapsed;
+			}
+			/* A one-shot task is done once it has run */
+			if ((TaskPtr->Flags & XPFW_TASK_FLAG_ONESHOT) != 0U) {
+				TaskPtr->Callback = NULL;
+				TaskPtr->Interval = 0U;
+				TaskPtr->Flags = 0U;
+				SchedPtr->TaskCount--;
+			}
+			XPfw_SchedulerUnlock(Msr);
 		}
 	}
 
@@ -148,53 +361,145 @@ XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr)
 	return Status;
 }
 
-XStatus XPfw_SchedulerAddTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,u32 MilliSeconds, XPfw_Callback_t Callback)
+/* Converts a period to PIT counts, clamped to the 32-bit task interval */
+static u32 XPfw_SchedulerUsToCounts(u64 MicroSeconds)
+{
+	u64 Counts = (MicroSeconds * (u64)PMU_PIT_CLK_FREQ) / 1000000U;
+
+	return (Counts > (u64)MAX_COUNT) ? MAX_COUNT : (u32)Counts;
+}
+
+static XStatus XPfw_SchedulerAdd(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,
+		u64 MicroSeconds, XPfw_Callback_t Callback, u32 Flags)
 {
 	u32 Idx;
+	u32 Msr;
+	u32 Interval;
+	u64 Now;
 	XStatus Status;
 
+	Interval = XPfw_SchedulerUsToCounts(MicroSeconds);
+	if ((SchedPtr == NULL) || (Callback == NULL) || (Interval == 0U)) {
+		Status = XST_FAILURE;
+		goto done;
+	}
+
+	Msr = XPfw_SchedulerLock();
+
 	/* Get the Next Free Task Index */
 	for (Idx=0U;Idx < XPFW_SCHED_MAX_TASK;Idx++) {
-		if (0U == SchedPtr->TaskList[Idx].Interval) {
+		if (NULL == SchedPtr->TaskList[Idx].Callback) {
 			break;
 		}
 	}
 
 	/* Check if we have reached Max Task limit */
 	if (XPFW_SCHED_MAX_TASK == Idx) {
+		XPfw_SchedulerUnlock(Msr);
 		Status = XST_FAILURE;
 		goto done;
 	}
 
-	/* Add Interval as a factor of TICK_MILLISECONDS */
-	SchedPtr->TaskList[Idx].Interval = MilliSeconds/TICK_MILLISECONDS;
+	Now = XPfw_SchedulerGetTime(SchedPtr);
+
+	SchedPtr->TaskList[Idx].Interval =
+		((Flags & XPFW_TASK_FLAG_ONESHOT) != 0U) ? 0U : Interval;
 	SchedPtr->TaskList[Idx].OwnerId = OwnerId;
+	SchedPtr->TaskList[Idx].Flags = Flags;
+	SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
+	SchedPtr->TaskList[Idx].Deadline = Now + (u64)Interval;
+	SchedPtr->TaskList[Idx].RunCount = 0U;
+	SchedPtr->TaskList[Idx].MissCount = 0U;
+	SchedPtr->TaskList[Idx].MaxLatency = 0U;
+	SchedPtr->TaskList[Idx].MaxRunTime = 0U;
 	SchedPtr->TaskList[Idx].Callback = Callback;
+	SchedPtr->TaskCount++;
+
+	XPfw_SchedulerInsert(SchedPtr, (u8)Idx);
+
+	/* Reprogram the PIT if the new task is due first */
+	if ((SchedPtr->Enabled == TRUE) && (SchedPtr->Head == (u8)Idx)) {
+		XPfw_SchedulerProgram(SchedPtr);
+	}
+
+	XPfw_SchedulerUnlock(Msr);
 	Status = XST_SUCCESS;
 
 done:
 	return Status;
 }
 
+XStatus XPfw_SchedulerAddTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,u32 MilliSeconds, XPfw_Callback_t Callback)
+{
+	return XPfw_SchedulerAdd(SchedPtr, OwnerId, (u64)MilliSeconds * 1000U,
+			Callback, 0U);
+}
+
+XStatus XPfw_SchedulerAddTaskUs(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MicroSeconds, XPfw_Callback_t Callback)
+{
+	return XPfw_SchedulerAdd(SchedPtr, OwnerId, MicroSeconds, Callback, 0U);
+}
+
+XStatus XPfw_SchedulerAddOneShotTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MicroSeconds, XPfw_Callback_t Callback)
+{
+	return XPfw_SchedulerAdd(SchedPtr, OwnerId, MicroSeconds, Callback,
+			XPFW_TASK_FLAG_ONESHOT);
+}
+
 XStatus XPfw_SchedulerRemoveTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MilliSeconds, XPfw_Callback_t Callback)
 {
 	u32 Idx;
+	u32 Msr;
 	u32 TaskCount = 0;
+	u32 Interval = XPfw_SchedulerUsToCounts((u64)MilliSeconds * 1000U);
+
+	Msr = XPfw_SchedulerLock();
 
 	/*Find the Task Index */
 	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
-		if ((Callback == SchedPtr->TaskList[Idx].Callback) &&
+		if ((NULL != SchedPtr->TaskList[Idx].Callback) &&
+		    (Callback == SchedPtr->TaskList[Idx].Callback) &&
 		    (SchedPtr->TaskList[Idx].OwnerId == OwnerId) &&
-		    ((SchedPtr->TaskList[Idx].Interval == (MilliSeconds/TICK_MILLISECONDS)) ||
+		    ((SchedPtr->TaskList[Idx].Interval == Interval) ||
 				(0U == MilliSeconds))) {
+			XPfw_SchedulerUnlink(SchedPtr, (u8)Idx);
 			SchedPtr->TaskList[Idx].Interval = 0U;
 			SchedPtr->TaskList[Idx].OwnerId = 0U;
+			SchedPtr->TaskList[Idx].Flags = 0U;
+			SchedPtr->TaskList[Idx].Status = XPFW_TASK_STATUS_DISABLED;
 			SchedPtr->TaskList[Idx].Callback = NULL;
+			SchedPtr->TaskCount--;
 			TaskCount++;
 		}
 	}
 
+	/* The removed task may have been the one the PIT is set up for */
+	if ((TaskCount > 0U) && (SchedPtr->Enabled == TRUE)) {
+		XPfw_SchedulerProgram(SchedPtr);
+	}
+
+	XPfw_SchedulerUnlock(Msr);
+
 	fw_printf("%s: Removed %lu tasks\r\n", __func__, TaskCount);
 
 	return ((TaskCount > 0) ? XST_SUCCESS : XST_FAILURE);
 }
+
+void XPfw_SchedulerPrintStats(const XPfw_Scheduler_t *SchedPtr)
+{
+	u32 Idx;
+	const struct XPfw_Task_t *TaskPtr;
+
+	for (Idx = 0U; Idx < XPFW_SCHED_MAX_TASK; Idx++) {
+		TaskPtr = &SchedPtr->TaskList[Idx];
+		if (NULL == TaskPtr->Callback) {
+			continue;
+		}
+		fw_printf("Task %lu: Owner %lu Interval %luus Runs %lu "
+			"Misses %lu MaxLatency %luus MaxRunTime %luus\r\n",
+			Idx, TaskPtr->OwnerId, COUNTS_TO_US(TaskPtr->Interval),
+			TaskPtr->RunCount, TaskPtr->MissCount,
+			COUNTS_TO_US(TaskPtr->MaxLatency),
+			COUNTS_TO_US(TaskPtr->MaxRunTime));
+	}
+}
@@ -35,25 +35,47 @@
 
 #define XPFW_SCHED_MAX_TASK	10U
 
+/* Marks the end of the sorted list of active tasks */
+#define XPFW_SCHED_NO_TASK	0xFFU
+
 /* Values for TaskPtr->Status */
 #define XPFW_TASK_STATUS_TRIGGERED	0x5AFEC0C0U
 #define XPFW_TASK_STATUS_DISABLED	0x00000000U
 
+/* Values for TaskPtr->Flags */
+#define XPFW_TASK_FLAG_ONESHOT		0x1U
+
 typedef void (*XPfw_Callback_t) (void);
 
+/**
+ * Task entry. Interval and all times are in PIT counts. A task is free when
+ * its Callback is NULL.
+ */
 struct XPfw_Task_t{
-	u32 Interval;
+	u32 Interval;		/* Period, 0 for a one-shot task */
 	u32 OwnerId;
 	u32 Status;
+	u32 Flags;
 	XPfw_Callback_t Callback;
+	u64 Deadline;		/* Time at which the task is due next */
+	u64 TriggerTime;	/* Deadline of the pending trigger */
+	u8 Next;		/* Next task in the deadline sorted list */
+	/* Statistics */
+	u32 RunCount;		/* Number of times the callback ran */
+	u32 MissCount;		/* Deadlines lost to a still pending trigger */
+	u32 MaxLatency;		/* Max counts from deadline to callback start */
+	u32 MaxRunTime;		/* Max counts spent in the callback */
 };
 
 typedef struct {
 	struct XPfw_Task_t TaskList[XPFW_SCHED_MAX_TASK];
 	u32 TaskCount;
 	u32 PitBaseAddr;
-	u32 Tick;
+	u32 Tick;		/* Number of timer expiries handled */
 	u32 Enabled;
+	u64 Now;		/* Time at the last PIT (re)programming */
+	u32 Programmed;		/* Counts loaded into the PIT, 0 if idle */
+	u8 Head;		/* Task with the earliest deadline */
 } XPfw_Scheduler_t ;
 
 void XPfw_SchedulerTickHandler(XPfw_Scheduler_t *SchedPtr);
@@ -62,6 +84,10 @@ XStatus XPfw_SchedulerStart(XPfw_Scheduler_t *SchedPtr);
 XStatus XPfw_SchedulerStop(XPfw_Scheduler_t *SchedPtr);
 XStatus XPfw_SchedulerProcess(XPfw_Scheduler_t *SchedPtr);
 XStatus XPfw_SchedulerAddTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId,u32 MilliSeconds, XPfw_Callback_t Callback);
+XStatus XPfw_SchedulerAddTaskUs(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MicroSeconds, XPfw_Callback_t Callback);
+XStatus XPfw_SchedulerAddOneShotTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MicroSeconds, XPfw_Callback_t Callback);
 XStatus XPfw_SchedulerRemoveTask(XPfw_Scheduler_t *SchedPtr, u32 OwnerId, u32 MilliSeconds, XPfw_Callback_t Callback);
+u64 XPfw_SchedulerGetTime(const XPfw_Scheduler_t *SchedPtr);
+void XPfw_SchedulerPrintStats(const XPfw_Scheduler_t *SchedPtr);
 
 #endif /* XPFW_SCHEDULER_H_ */
@@ -36,6 +36,7 @@
 # ----- ----  -------  -----------------------------------------------
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
+# 3.5   esd   10/18/26 Added the NAND interface (fs_interface = 2)
 #
 ##############################################################################
 
@@ -56,6 +57,14 @@ proc ffs_drc {libhandle} {
 		puts "WARNING : No interface that uses file system is available \n"
 	}
 
+	# The NAND interface runs on a XilNandFtl partition, libxilffs then
+	# needs libxilnandftl, which the xilnandftl library adds to the link
+	set fs_interface [common::get_property CONFIG.fs_interface $libhandle]
+	if {$fs_interface == 2 &&
+	    [llength [hsi::get_libs -filter "NAME==xilnandftl"]] == 0} {
+		error  "ERROR: NAND interface requires the xilnandftl library \n"
+	}
+
 }
 
 proc get_ffs_periphs {processor} {
@@ -67,9 +76,10 @@ proc get_ffs_periphs {processor} {
 
 	foreach periph $periphs_list {
 		set periphname [common::get_property IP_NAME $periph]
-		# Checks if SD instance is present
+		# Checks if SD or NAND instance is present
 		# This can be expanded to add more instances.
-		if {$periphname == "ps7_sdio" || $periphname == "psu_sd"} {
+		if {$periphname == "ps7_sdio" || $periphname == "psu_sd" ||
+		    $periphname == "ps7_nand" || $periphname == "psu_nand"} {
 			lappend ffs_periphs_list $periph
 			lappend ffs_periphs_name_list $periphname
 		}
@@ -113,38 +123,49 @@ proc xgen_opts_file {libhandle} {
 	set enable_multi_partition [common::get_property CONFIG.enable_multi_partition $libhandle]
 	set num_logical_vol [common::get_property CONFIG.num_logical_vol $libhandle]
 
-	# Checking if SD with FATFS is enabled.
+	# Checking if SD or NAND with FATFS is enabled.
 	# This can be expanded to add more interfaces.
 
 	global ffs_periphs_name_list
+	set interface_found 0
 	foreach periph $ffs_periphs_name_list {
-
-		if {$periph == "ps7_sdio" || $periph == "psu_sd"} {
-			if {$fs_interface == 1} {
-				puts $file_handle "\#define FILE_SYSTEM_INTERFACE_SD"
-				if {$read_only == true} {
-					puts $file_handle "\#define FILE_SYSTEM_READ_ONLY"
-				}
-				if {$use_lfn == true} {
-					puts $file_handle "\#define FILE_SYSTEM_USE_LFN"
-				}
-				if {$use_mkfs == true} {
-					puts $file_handle "\#define FILE_SYSTEM_USE_MKFS"
-				}
-				if {$enable_multi_partition == true} {
-					puts $file_handle "\#define FILE_SYSTEM_MULTI_PARTITION"
-				}
-				if {$num_logical_vol > 10} {
-					puts "WARNING : File System supports only upto 10 logical drives\
-							Setting back the num of vol to 10\n"
-					set num_logical_vol 10
-				}
-				puts $file_handle "\#define FILE_SYSTEM_NUM_LOGIC_VOL $num_logical_vol"
-			} else {
-				error  "ERROR: Invalid interface selected \n"
-			}
+		if {$fs_interface == 1 &&
+		    ($periph == "ps7_sdio" || $periph == "psu_sd")} {
+			set interface_found 1
 		}
+		if {$fs_interface == 2 &&
+		    ($periph == "ps7_nand" || $periph == "psu_nand")} {
+			set interface_found 1
+		}
+	}
 
+	if {[llength $ffs_periphs_name_list] != 0} {
+		if {$interface_found == 0} {
+			error  "ERROR: Invalid interface selected \n"
+		}
+		if {$fs_interface == 1} {
+			puts $file_handle "\#define FILE_SYSTEM_INTERFACE_SD"
+		} else {
+			puts $file_handle "\#define FILE_SYSTEM_INTERFACE_NAND"
+		}
+		if {$read_only == true} {
+			puts $file_handle "\#define FILE_SYSTEM_READ_ONLY"
+		}
+		if {$use_lfn == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_LFN"
+		}
+		if {$use_mkfs == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_MKFS"
+		}
+		if {$enable_multi_partition == true} {
+			puts $file_handle "\#define FILE_SYSTEM_MULTI_PARTITION"
+		}
+		if {$num_logical_vol > 10} {
+			puts "WARNING : File System supports only upto 10 logical drives\
+					Setting back the num of vol to 10\n"
+			set num_logical_vol 10
+		}
+		puts $file_handle "\#define FILE_SYSTEM_NUM_LOGIC_VOL $num_logical_vol"
 	}
 
 
@@ -54,6 +54,15 @@
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
 *
+*		Description related to NAND:
+*		Select xilffs and xilnandftl in SDK and set "fs_interface"
+*		to 2. Drive 0 is then a XilNandFtl partition on the first
+*		NAND controller (nandpsu on ZynqMP, nandps on Zynq), placed
+*		by the xilnandftl start_block and num_blocks parameters.
+*		disk_initialize mounts the partition, formatting it on first
+*		use. CTRL_SYNC flushes the FTL write buffer and map, so
+*		f_sync() and f_close() are power cut safe.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -79,6 +88,7 @@
 * 3.2   sk   11/24/15 Considered the slot type before checking the CD/WP pins.
 * 3.3   sk   04/01/15 Added one second delay for checking CD pin.
 * 3.4   sk   06/09/16 Added support for mkfs.
+* 3.5   esd  10/18/26 Added the NAND interface on top of XilNandFtl.
 *
 * </pre>
 *
@@ -93,6 +103,9 @@
 #ifdef FILE_SYSTEM_INTERFACE_SD
 #include "xsdps.h"		/* SD device driver */
 #endif
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+#include "xilnandftl.h"		/* NAND flash translation layer */
+#endif
 #include "sleep.h"
 #include "xil_printf.h"
 
@@ -127,6 +140,15 @@ static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
 #endif
 
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+static XNandFtl NandFtl;
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+static XNandPsu NandInstance;
+#else
+static XNandPs NandInstance;
+#endif
+#endif
+
 #ifdef __ICCARM__
 #pragma data_alignment = 32
 static u8 ExtCsd[512];
@@ -219,6 +241,13 @@ DSTATUS disk_status (
 
 Label:
 		Stat[pdrv] = s;
+#endif
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+		(void)StatusReg;
+		(void)DelayCount;
+		if (pdrv != 0U) {
+			s = STA_NODISK | STA_NOINIT;
+		}
 #endif
 		return s;
 }
@@ -231,6 +260,8 @@ Label:
 *
 * Initializes the drive.
 * In case of SD, it initializes the host controller and the card.
+* In case of NAND, it initializes the controller and mounts the FTL
+* partition, formatting it first if it has never been used.
 * This function also selects additional settings such as bus width,
 * speed and block size.
 *
@@ -314,6 +345,90 @@ DSTATUS disk_initialize (
 
 	Stat[pdrv] = s;
 
+#endif
+
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+
+	XNandFtl_Config FtlConfig;
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+	XNandPsu_Config *NandConfig;
+#else
+	XNandPs_Config *NandConfig;
+#endif
+
+	s = disk_status(pdrv);
+	if ((s & (STA_NODISK | STA_NOINIT)) != STA_NOINIT) {
+		return s;
+	}
+
+	/*
+	 * Initialize the NAND controller
+	 */
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+	NandConfig = XNandPsu_LookupConfig(XPAR_XNANDPSU_0_DEVICE_ID);
+	if (NULL == NandConfig) {
+		return s;
+	}
+	Status = XNandPsu_CfgInitialize(&NandInstance, NandConfig,
+					NandConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return s;
+	}
+	XNandPsu_EnableDmaMode(&NandInstance);
+	Status = XNandFtl_NandPsuConfig(&FtlConfig, &NandInstance);
+#else
+	NandConfig = XNandPs_LookupConfig(XPAR_XNANDPS_0_DEVICE_ID);
+	if (NULL == NandConfig) {
+		return s;
+	}
+	Status = XNandPs_CfgInitialize(&NandInstance, NandConfig,
+					NandConfig->SmcBase, NandConfig->FlashBase);
+	if (Status != XST_SUCCESS) {
+		return s;
+	}
+	Status = XNandFtl_NandPsConfig(&FtlConfig, &NandInstance);
+#endif
+	if (Status != XST_SUCCESS) {
+		return s;
+	}
+
+	/*
+	 * Place the partition as configured in the BSP. A zero block
+	 * count keeps the binding's default, the rest of the device.
+	 */
+	if (XNANDFTL_START_BLOCK != 0U) {
+		if (FtlConfig.NumBlocks <= XNANDFTL_START_BLOCK) {
+			return s;
+		}
+		FtlConfig.NumBlocks -= XNANDFTL_START_BLOCK;
+		FtlConfig.StartBlock += XNANDFTL_START_BLOCK;
+	}
+	if ((XNANDFTL_NUM_BLOCKS != 0U) &&
+			(XNANDFTL_NUM_BLOCKS < FtlConfig.NumBlocks)) {
+		FtlConfig.NumBlocks = XNANDFTL_NUM_BLOCKS;
+	}
+
+	Status = XNandFtl_CfgInitialize(&NandFtl, &FtlConfig);
+	if (Status != XST_SUCCESS) {
+		return s;
+	}
+
+	/*
+	 * A partition that was never formatted reads back erased; give
+	 * FatFs an empty FTL so that f_mkfs() can be run on it.
+	 */
+	Status = XNandFtl_Mount(&NandFtl);
+	if (Status == XST_NO_DATA) {
+		Status = XNandFtl_Format(&NandFtl);
+	}
+	if (Status != XST_SUCCESS) {
+		return s;
+	}
+
+	s &= (~STA_NOINIT);
+
+	Stat[pdrv] = s;
+
 #endif
 
 	return s;
@@ -373,6 +488,22 @@ DRESULT disk_read (
 		return RES_ERROR;
 	}
 
+#endif
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+	s32 Status;
+
+	if ((disk_status(pdrv) & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+	if (count == 0U) {
+		return RES_PARERR;
+	}
+
+	Status = XNandFtl_Read(&NandFtl, (u32)sector, (u32)count, buff);
+	if (Status != XST_SUCCESS) {
+		return RES_ERROR;
+	}
+
 #endif
     return RES_OK;
 }
@@ -416,6 +547,40 @@ DRESULT disk_ioctl (
 	}
 
 		return res;
+#elif defined(FILE_SYSTEM_INTERFACE_NAND)
+	DRESULT res;
+	void *LocBuff = buff;
+
+	if ((disk_status(pdrv) & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+
+	res = RES_ERROR;
+	switch (cmd) {
+		case (BYTE)CTRL_SYNC :	/* Flush the write buffer and the map */
+			if (XNandFtl_Sync(&NandFtl) == XST_SUCCESS) {
+				res = RES_OK;
+			}
+			break;
+
+		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
+			(*((DWORD *)(void *)LocBuff)) =
+				(DWORD)XNandFtl_GetSectorCount(&NandFtl);
+			res = RES_OK;
+			break;
+
+		case (BYTE)GET_BLOCK_SIZE :	/* Get erase block size in unit of sector (DWORD) */
+			(*((DWORD *)((void *)LocBuff))) =
+				(DWORD)XNandFtl_GetBlockSectors(&NandFtl);
+			res = RES_OK;
+			break;
+
+		default:
+			res = RES_PARERR;
+			break;
+	}
+
+	return res;
 #else
 		return 0;
 #endif
@@ -494,6 +659,23 @@ DRESULT disk_write (
 		return RES_ERROR;
 	}
 
+#endif
+#ifdef FILE_SYSTEM_INTERFACE_NAND
+	(void)LocSector;
+	s = disk_status(pdrv);
+
+	if ((s & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+	if (count == 0U) {
+		return RES_PARERR;
+	}
+
+	Status = XNandFtl_Write(&NandFtl, (u32)sector, (u32)count, buff);
+	if (Status != XST_SUCCESS) {
+		return RES_ERROR;
+	}
+
 #endif
 	return RES_OK;
 }
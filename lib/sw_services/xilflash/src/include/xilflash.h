@@ -110,6 +110,30 @@
 * only after the erase operation is completed successfully or an error is
 * reported.
 *
+* <b>Background Erase/Program</b>
+*
+* XFlash_BgErase() and XFlash_BgWrite() start an erase or program operation
+* and return immediately. The operation is split per bank and advanced by
+* XFlash_BgPoll(), which the application calls from a timer interrupt, from
+* the RY/BY interrupt handler or from its main loop. Each call
+* retires the blocks the device(s) have finished and issues the next ones, up to
+* the number of banks set with XFlash_BgSetConcurrency() at a time. Erases run
+* entirely in the device; programming is done one write buffer per bank per
+* call. The handler installed with XFlash_BgSetHandler() is called once the
+* whole range is done or an error stops it, and XFlash_BgGetStatus() reports
+* the progress in between.
+*
+* The banks are the partitions of the part that can be erased or programmed
+* while another one is read. They are taken from the Intel partition region
+* information or the AMD bank organisation of the CFI query. For parts whose
+* query does not describe them, define XFL_BANK_SIZE to the bank size in bytes;
+* otherwise such a part is handled as a single bank.
+*
+* XFlash_Read() may be called while a background erase is in progress. The
+* banks being erased are erase-suspended, the data is copied and the erase is
+* resumed. XFlash_Write(), XFlash_Erase(), XFlash_Lock() and XFlash_Unlock()
+* return XFLASH_BUSY until the background operation has completed.
+*
 * <b>Sector Protection</b>
 *
 * The Flash Device is divided into Blocks. Each Block can be protected
@@ -212,6 +236,15 @@
 *                     Updated xilflash_readwrite_example.c file.
 *                     Modified FLASH_BASE_ADDRESS in xilflash_readwrite
 *                     _example.c to canonical name (CR 808007)
+* 4.3   esd  10/18/26 Added the background erase/program engine:
+*		      XFlash_BgErase, XFlash_BgWrite, XFlash_BgPoll,
+*		      XFlash_BgGetStatus, XFlash_BgSetHandler and
+*		      XFlash_BgSetConcurrency. XFlash_Read suspends a background
+*		      erase to service reads. Added the EraseBlockStart,
+*		      GetBankStatus, EraseSuspend, EraseResume and GetBlock
+*		      VTable entries for the Intel and AMD families.
+*		      Added NumBanks and BankBlock to the geometry, taken from
+*		      the CFI partition/bank layout or XFL_BANK_SIZE.
 *
 * </pre>
 *
@@ -290,6 +323,28 @@ extern "C" {
 						 */
 #define XFLASH_BLOCK_PROTECTED		114	/**< Block is protected */
 
+/*
+ * Background operation types, see XFlash_BgGetStatus().
+ */
+#define XFL_BG_OP_NONE			0	/**< No background operation */
+#define XFL_BG_OP_ERASE			1	/**< Background erase */
+#define XFL_BG_OP_WRITE			2	/**< Background program */
+
+/*
+ * Per bank states of a background operation.
+ */
+#define XFL_BG_BANK_IDLE		0	/**< Nothing to do in the bank */
+#define XFL_BG_BANK_PENDING		1	/**< Blocks left to issue */
+#define XFL_BG_BANK_ACTIVE		2	/**< Operation in the device */
+#define XFL_BG_BANK_SUSPENDED		3	/**< Erase suspended for a
+						 * read */
+
+/*
+ * Number of bytes programmed per bank in one XFlash_BgPoll() call when the
+ * device does not report a write buffer size.
+ */
+#define XFL_BG_DEF_WRITE_CHUNK		256
+
 /**
  * Supported part arrangements.
  * This enumeration defines the supported arrangements of parts on the
@@ -380,6 +435,20 @@ extern "C" {
 						 */
 #endif /* XPAR_XFL_DEVICE_FAMILY_INTEL */
 
+/*
+ * Maximum number of banks (partitions which can be erased or programmed
+ * while another one is read) kept in the geometry.
+ */
+#define XFL_MAX_GEOM_BANKS		XFL_MAX_ERASE_REGIONS
+
+/*
+ * Size in bytes of a bank, for parts whose CFI query does not describe
+ * their banks. 0 handles such a part as a single bank.
+ */
+#ifndef XFL_BANK_SIZE
+#define XFL_BANK_SIZE			0
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /**
@@ -412,6 +481,10 @@ typedef struct {
 		u16 Number;	/**< Number of blocks in this region */
 		u32 Size;	/**< Size of the block in bytes */
 	} EraseRegion[XFL_MAX_ERASE_REGIONS + 1];
+	u16 NumBanks;		/**< Number of banks described by the CFI
+				 * query, 0 if it has none */
+	u16 BankBlock[XFL_MAX_GEOM_BANKS];
+				/**< Block number where each bank begins */
 
 } XFlashGeometry;
 
@@ -451,6 +524,57 @@ typedef union {
 #endif /* XPAR_XFL_DEVICE_FAMILY_INTEL */
 } DeviceCtrlParam;
 
+/**
+ * Callback invoked by XFlash_BgPoll() when a background operation completes.
+ * Status is XST_SUCCESS or the error which stopped the operation.
+ */
+typedef void (*XFlash_BgHandler) (void *CallBackRef, u32 Offset, u32 Bytes,
+				  int Status);
+
+/**
+ * Progress of a background operation, filled in by XFlash_BgGetStatus().
+ */
+typedef struct {
+	u32 Op;			/**< XFL_BG_OP_* of the current operation */
+	u32 Offset;		/**< Start of the requested range */
+	u32 Bytes;		/**< Size of the requested range */
+	u32 BytesDone;		/**< Bytes of the range completed so far */
+	u32 ActiveBanks;	/**< Bitmask of banks with an operation in the
+				 * device */
+	u32 SuspendedBanks;	/**< Bitmask of banks erase-suspended */
+	int Status;		/**< XFLASH_BUSY while the operation runs,
+				 * then its final status */
+} XFlash_BgStatus;
+
+/*
+ * State of one bank in a background operation.
+ */
+typedef struct {
+	u32 Next;		/* Next offset to issue in this bank */
+	u32 End;		/* End of the range in this bank (exclusive) */
+	u32 Current;		/* Block/offset of the operation in flight */
+	u32 CurrentBytes;	/* Bytes of the range it covers */
+	u8 State;		/* XFL_BG_BANK_* */
+} XFlash_BgBank;
+
+/*
+ * Background operation engine state, see XFlash_BgPoll().
+ */
+typedef struct {
+	u32 Op;			/* XFL_BG_OP_* */
+	u32 Offset;		/* Requested range */
+	u32 Bytes;
+	u32 BytesDone;
+	u8 *SrcPtr;		/* Source data of a background write */
+	int Status;		/* First error, XST_SUCCESS otherwise */
+	u32 NumActive;		/* Banks with an operation in the device */
+	u32 MaxActive;		/* Max banks active at a time */
+	u32 NextBank;		/* Where the round robin issue starts */
+	XFlash_BgHandler Handler;
+	void *CallBackRef;
+	XFlash_BgBank Bank[XFL_MAX_GEOM_BANKS];
+} XFlash_Bg;
+
 /**
  * The XFlash library instance data. The user is required to allocate a
  * variable of this type for every flash device in the system. A pointer
@@ -494,8 +618,24 @@ typedef struct XFlashTag {
 		int (*DeviceControl) (struct XFlashTag * InstancePtr,
 					u32 Command, DeviceCtrlParam
 					*Parameters);
+
+		/*
+		 * Background operation primitives. None of them wait for
+		 * the device.
+		 */
+		int (*EraseBlockStart) (struct XFlashTag * InstancePtr,
+					u32 Offset);
+		int (*GetBankStatus) (struct XFlashTag * InstancePtr,
+					u32 Offset);
+		int (*EraseSuspend) (struct XFlashTag * InstancePtr,
+					u32 Offset);
+		int (*EraseResume) (struct XFlashTag * InstancePtr,
+					u32 Offset);
+		int (*GetBlock) (struct XFlashTag * InstancePtr, u32 Offset,
+				 u16 *Bank, u32 *BlockOffset, u32 *BlockBytes);
 	} VTable;
 	XFlashCommandSet Command;	/* Flash Specific Commands */
+	XFlash_Bg Bg;			/* Background operation state */
 } XFlash;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -635,6 +775,17 @@ int XFlash_Lock(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 int XFlash_Unlock(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 int XFlash_IsReady(XFlash * InstancePtr);
 
+/*
+ * Background erase/program functions.
+ */
+int XFlash_BgErase(XFlash * InstancePtr, u32 Offset, u32 Bytes);
+int XFlash_BgWrite(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *SrcPtr);
+int XFlash_BgPoll(XFlash * InstancePtr);
+void XFlash_BgGetStatus(XFlash * InstancePtr, XFlash_BgStatus *StatusPtr);
+void XFlash_BgSetHandler(XFlash * InstancePtr, XFlash_BgHandler FuncPtr,
+			 void *CallBackRef);
+int XFlash_BgSetConcurrency(XFlash * InstancePtr, u32 MaxActive);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,6 +48,8 @@
 *		      XFL_AMD_BOTTOM_WP_UNIFORM.
 * 4.1	nsk  06/06/12 Added New definitions as per AMD spec.
 *		      (CR 781697).
+* 4.3   esd  10/18/26 Added the background erase primitives used by
+*		      XFlash_BgPoll.
 * </pre>
 *
 ******************************************************************************/
@@ -170,6 +172,13 @@ int XFlashAmd_Lock(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 int XFlashAmd_Unlock(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 int XFlashAmd_EraseChip(struct XFlashTag * InstancePtr);
 
+int XFlashAmd_EraseBlockStart(XFlash * InstancePtr, u32 Offset);
+int XFlashAmd_GetBankStatus(XFlash * InstancePtr, u32 Offset);
+int XFlashAmd_EraseSuspend(XFlash * InstancePtr, u32 Offset);
+int XFlashAmd_EraseResume(XFlash * InstancePtr, u32 Offset);
+int XFlashAmd_GetBlock(XFlash * InstancePtr, u32 Offset, u16 *Bank,
+		       u32 *BlockOffset, u32 *BlockBytes);
+
 #endif /* XPAR_XFL_DEVICE_FAMILY_AMD */
 
 #ifdef __cplusplus
@@ -62,6 +62,8 @@
 *		      fixes the CR 662317.
 *		      CR 662317 Description - Xilinx Platform Flash on ML605
 *		      fails to work.
+* 4.3   esd  10/18/26 Added the background erase primitives used by
+*		      XFlash_BgPoll.
 *
 * </pre>
 *
@@ -271,6 +273,13 @@ int XFlashIntel_Lock(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 int XFlashIntel_Unlock(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 int XFlashIntel_GetStatus(XFlash * InstancePtr, u32 Offset);
 
+int XFlashIntel_EraseBlockStart(XFlash * InstancePtr, u32 Offset);
+int XFlashIntel_GetBankStatus(XFlash * InstancePtr, u32 Offset);
+int XFlashIntel_EraseSuspend(XFlash * InstancePtr, u32 Offset);
+int XFlashIntel_EraseResume(XFlash * InstancePtr, u32 Offset);
+int XFlashIntel_GetBlock(XFlash * InstancePtr, u32 Offset, u16 *Bank,
+			 u32 *BlockOffset, u32 *BlockBytes);
+
 #endif /* XPAR_XFL_DEVICE_FAMILY_INTEL */
 
 #ifdef __cplusplus
@@ -64,6 +64,10 @@
 *		      fixes the CR 662317.
 *		      CR 662317 Description - Xilinx Platform Flash on ML605
 *		      fails to work.
+* 4.3   esd  10/18/26 Added the background erase/program engine
+*		      (XFlash_BgErase, XFlash_BgWrite, XFlash_BgPoll). XFlash_Read
+*		      suspends a background erase to service reads; the other
+*		      operations return XFLASH_BUSY while one is in progress.
 * </pre>
 *
 *
@@ -89,6 +93,11 @@
 /************************** Function Prototypes ******************************/
 
 static int SetVTable(XFlash * InstancePtr);
+static int BgStart(XFlash * InstancePtr, u32 Op, u32 Offset, u32 Bytes,
+		   void *SrcPtr);
+static void BgRetire(XFlash * InstancePtr, u32 BankNum, int Status);
+static void BgIssue(XFlash * InstancePtr);
+static int BgRead(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *DestPtr);
 
 /************************** Variable Definitions *****************************/
 
@@ -150,6 +159,13 @@ int XFlash_Initialize(XFlash * InstancePtr, u32 BaseAddress, u8 BusWidth,
 	InstancePtr->Geometry.BaseAddress = BaseAddress;
 	InstancePtr->IsPlatformFlash = IsPlatformFlash;
 
+	/*
+	 * No background operation, one bank active at a time.
+	 */
+	memset(&InstancePtr->Bg, 0, sizeof(XFlash_Bg));
+	InstancePtr->Bg.Status = XST_SUCCESS;
+	InstancePtr->Bg.MaxActive = 1;
+
 #ifdef XPAR_XFL_DEVICE_FAMILY_INTEL
 	if (IsPlatformFlash == 1) {
 		/*
@@ -202,6 +218,8 @@ int XFlash_Initialize(XFlash * InstancePtr, u32 BaseAddress, u8 BusWidth,
 * alignment supported by the processor.
 *
 * The device is polled until an error or the operation completes successfully.
+* If a background erase is in progress, it is suspended for the duration of the
+* copy and resumed afterwards.
 *
 * @param	InstancePtr is the pointer to the XFlash instance.
 * @param	Offset is the offset into the device(s) address space from
@@ -216,7 +234,8 @@ int XFlash_Initialize(XFlash * InstancePtr, u32 BaseAddress, u8 BusWidth,
 *
 * @note		This function allows the transfer of data past the end of the
 *		device's address space. If this occurs, then results are
-*		undefined.
+*		undefined. Data read from a block which is being erased in the
+*		background is undefined as well.
 *
 ******************************************************************************/
 int XFlash_Read(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
@@ -229,6 +248,10 @@ int XFlash_Read(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 		return XST_FAILURE;
 	}
 
+	if (InstancePtr->Bg.NumActive != 0) {
+		return (BgRead(InstancePtr, Offset, Bytes, DestPtr));
+	}
+
 	return (InstancePtr->VTable.Read(InstancePtr, Offset, Bytes, DestPtr));
 }
 
@@ -260,6 +283,7 @@ int XFlash_Read(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
 *		  retrieve specific error conditions. When this error is
 *		  returned, it is possible that the target address range was
 *		  only partially programmed.
+*		- XFLASH_BUSY if a background operation is in progress.
 *
 * @note		None.
 *
@@ -274,6 +298,10 @@ int XFlash_Write(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *SrcPtr)
 		return XST_FAILURE;
 	}
 
+	if (InstancePtr->Bg.Op != XFL_BG_OP_NONE) {
+		return (XFLASH_BUSY);
+	}
+
 	return (InstancePtr->VTable.Write(InstancePtr, Offset, Bytes, SrcPtr));
 }
 
@@ -295,6 +323,7 @@ int XFlash_Write(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *SrcPtr)
 *		- XST_SUCCESS if successful.
 *		- XFLASH_ADDRESS_ERROR if the destination address range is
 *		  not completely within the addressable areas of the device(s).
+*		- XFLASH_BUSY if a background operation is in progress.
 *
 * @note		Due to flash memory design, the range actually erased may be
 *		larger than what was specified by the Offset & Bytes parameters.
@@ -312,6 +341,10 @@ int XFlash_Erase(XFlash * InstancePtr, u32 Offset, u32 Bytes)
 		return XST_FAILURE;
 	}
 
+	if (InstancePtr->Bg.Op != XFL_BG_OP_NONE) {
+		return (XFLASH_BUSY);
+	}
+
 	return (InstancePtr->VTable.Erase(InstancePtr, Offset, Bytes));
 }
 
@@ -334,6 +367,7 @@ int XFlash_Erase(XFlash * InstancePtr, u32 Offset, u32 Bytes)
 * 		- XST_SUCCESS if successful.
 *		- XFLASH_ADDRESS_ERROR if the destination address range is
 *		  not completely within the addressable areas of the device(s).
+*		- XFLASH_BUSY if a background operation is in progress.
 *
 * @note		Due to flash memory design, the range actually locked may be
 *		larger than what was specified by the Offset & Bytes parameters.
@@ -351,6 +385,10 @@ int XFlash_Lock(XFlash * InstancePtr, u32 Offset, u32 Bytes)
 		return XST_FAILURE;
 	}
 
+	if (InstancePtr->Bg.Op != XFL_BG_OP_NONE) {
+		return (XFLASH_BUSY);
+	}
+
 	return (InstancePtr->VTable.Lock(InstancePtr, Offset, Bytes));
 }
 
@@ -374,6 +412,7 @@ int XFlash_Lock(XFlash * InstancePtr, u32 Offset, u32 Bytes)
 *		- XST_SUCCESS if successful.
 *		- XFLASH_ADDRESS_ERROR if the destination address range is
 *		  not completely within the addressable areas of the device(s).
+*		- XFLASH_BUSY if a background operation is in progress.
 *
 * @note		None.
 *
@@ -388,6 +427,10 @@ int XFlash_Unlock(XFlash * InstancePtr, u32 Offset, u32 Bytes)
 		return XST_FAILURE;
 	}
 
+	if (InstancePtr->Bg.Op != XFL_BG_OP_NONE) {
+		return (XFLASH_BUSY);
+	}
+
 	return (InstancePtr->VTable.Unlock(InstancePtr, Offset, Bytes));
 }
 
@@ -480,6 +523,277 @@ int XFlash_IsReady(XFlash * InstancePtr)
 	return (InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function starts erasing the specified address range in the background
+* and returns without waiting for the device(s). The blocks of every bank
+* (erase region) in the range are erased one after another, and up to the
+* number of banks set with XFlash_BgSetConcurrency() are erased at the same
+* time. XFlash_BgPoll() must be called until the operation completes.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is the offset into the device(s) address space from which
+*		to begin erasure.
+* @param	Bytes is the number of bytes to erase.
+*
+* @return
+*		- XST_SUCCESS if the erase was started or Bytes is zero.
+*		- XFLASH_ADDRESS_ERROR if the address range is not completely
+*		  within the addressable areas of the device(s).
+*		- XFLASH_BUSY if a background operation is already in progress.
+*
+* @note		Due to flash memory design, the range actually erased may be
+*		larger than what was specified by the Offset & Bytes parameters.
+*		This will occur if the parameters do not align to block
+*		boundaries.
+*
+******************************************************************************/
+int XFlash_BgErase(XFlash * InstancePtr, u32 Offset, u32 Bytes)
+{
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	if(InstancePtr->IsReady != XIL_COMPONENT_IS_READY) {
+		return XST_FAILURE;
+	}
+
+	return (BgStart(InstancePtr, XFL_BG_OP_ERASE, Offset, Bytes, NULL));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function starts programming the flash device(s) in the background. Each
+* call to XFlash_BgPoll() programs one write buffer in each of up to the number
+* of banks set with XFlash_BgSetConcurrency(), so that the caller is never held
+* for longer than a few buffer programming times.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is the offset into the device(s) address space from which
+*		to begin programming. Must be aligned to the width of the
+*		flash's data bus.
+* @param	Bytes is the number of bytes to program.
+* @param	SrcPtr is the source address containing data to be programmed.
+*		Must be aligned to the width of the flash's data bus and must
+*		remain valid until the operation completes.
+*
+* @return
+*		- XST_SUCCESS if the write was started or Bytes is zero.
+*		- XFLASH_ADDRESS_ERROR if the address range is not completely
+*		  within the addressable areas of the device(s).
+*		- XFLASH_BUSY if a background operation is already in progress.
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlash_BgWrite(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *SrcPtr)
+{
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	if(InstancePtr->IsReady != XIL_COMPONENT_IS_READY) {
+		return XST_FAILURE;
+	}
+
+	if(SrcPtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	return (BgStart(InstancePtr, XFL_BG_OP_WRITE, Offset, Bytes, SrcPtr));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function advances the background operation. The banks with an erase in
+* the device are sampled once; finished blocks are retired and the next blocks
+* are issued. For a background write, the next write buffer of each bank is
+* programmed. When the whole range is done, or an error stops the operation
+* once the blocks already in the device have finished, the handler set by
+* XFlash_BgSetHandler() is called.
+*
+* The function does not wait for the device(s) and may be called from a timer
+* interrupt, from the RY/BY interrupt handler or from the main loop.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+*
+* @return
+*		- XFLASH_BUSY if the operation is still in progress.
+*		- XST_SUCCESS if the last background operation completed, or
+*		  none was started.
+*		- XFLASH_ERROR or another error code returned by the device
+*		  family if the last background operation failed.
+*
+* @note		XFlash_BgPoll() and XFlash_Read() must not preempt each other.
+*		If XFlash_BgPoll() is called from an interrupt, that interrupt
+*		must be disabled around XFlash_Read().
+*
+******************************************************************************/
+int XFlash_BgPoll(XFlash * InstancePtr)
+{
+	XFlash_Bg *BgPtr;
+	u32 BankNum;
+	int Status;
+
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	BgPtr = &InstancePtr->Bg;
+	if (BgPtr->Op == XFL_BG_OP_NONE) {
+		return (BgPtr->Status);
+	}
+
+	/*
+	 * Retire the erases the device(s) have finished.
+	 */
+	for (BankNum = 0; BankNum < XFL_MAX_GEOM_BANKS; BankNum++) {
+		if (BgPtr->Bank[BankNum].State != XFL_BG_BANK_ACTIVE) {
+			continue;
+		}
+
+		Status = InstancePtr->VTable.GetBankStatus(InstancePtr,
+					BgPtr->Bank[BankNum].Current);
+		if (Status != XFLASH_BUSY) {
+			BgRetire(InstancePtr, BankNum, Status);
+		}
+	}
+
+	/*
+	 * Keep the banks busy unless an error has stopped the operation.
+	 */
+	if (BgPtr->Status == XST_SUCCESS) {
+		BgIssue(InstancePtr);
+	}
+
+	for (BankNum = 0; BankNum < XFL_MAX_GEOM_BANKS; BankNum++) {
+		if ((BgPtr->Bank[BankNum].State == XFL_BG_BANK_ACTIVE) ||
+		    ((BgPtr->Bank[BankNum].State == XFL_BG_BANK_PENDING) &&
+		     (BgPtr->Status == XST_SUCCESS))) {
+			return (XFLASH_BUSY);
+		}
+	}
+
+	/*
+	 * Nothing left in the device(s), the operation is over.
+	 */
+	BgPtr->Op = XFL_BG_OP_NONE;
+	if (BgPtr->Handler != NULL) {
+		BgPtr->Handler(BgPtr->CallBackRef, BgPtr->Offset, BgPtr->Bytes,
+			       BgPtr->Status);
+	}
+
+	return (BgPtr->Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reports the progress of the background operation.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	StatusPtr is the structure filled in with the progress. Status
+*		is XFLASH_BUSY while the operation runs and its final status
+*		after it completed.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XFlash_BgGetStatus(XFlash * InstancePtr, XFlash_BgStatus *StatusPtr)
+{
+	XFlash_Bg *BgPtr;
+	u32 BankNum;
+
+	if((InstancePtr == NULL) || (StatusPtr == NULL)) {
+		return;
+	}
+
+	BgPtr = &InstancePtr->Bg;
+	StatusPtr->Op = BgPtr->Op;
+	StatusPtr->Offset = BgPtr->Offset;
+	StatusPtr->Bytes = BgPtr->Bytes;
+	StatusPtr->BytesDone = BgPtr->BytesDone;
+	StatusPtr->ActiveBanks = 0;
+	StatusPtr->SuspendedBanks = 0;
+	StatusPtr->Status = (BgPtr->Op != XFL_BG_OP_NONE) ? XFLASH_BUSY :
+							     BgPtr->Status;
+
+	for (BankNum = 0; BankNum < XFL_MAX_GEOM_BANKS; BankNum++) {
+		if (BgPtr->Bank[BankNum].State == XFL_BG_BANK_ACTIVE) {
+			StatusPtr->ActiveBanks |= (1U << BankNum);
+		}
+		else if (BgPtr->Bank[BankNum].State ==
+			 XFL_BG_BANK_SUSPENDED) {
+			StatusPtr->SuspendedBanks |= (1U << BankNum);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the handler called by XFlash_BgPoll() when a background
+* operation completes.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	FuncPtr is the handler, NULL for none.
+* @param	CallBackRef is passed to the handler as its first argument.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XFlash_BgSetHandler(XFlash * InstancePtr, XFlash_BgHandler FuncPtr,
+			 void *CallBackRef)
+{
+	if(InstancePtr == NULL) {
+		return;
+	}
+
+	InstancePtr->Bg.Handler = FuncPtr;
+	InstancePtr->Bg.CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets how many CFI banks a background operation keeps busy at
+* the same time. The default is 1, which suits parts with a single write
+* state machine; raise it only for parts whose banks erase and program
+* independently.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	MaxActive is the maximum number of banks active at a time.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XFLASH_BUSY if a background operation is in progress.
+*		- XST_FAILURE if MaxActive is zero.
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlash_BgSetConcurrency(XFlash * InstancePtr, u32 MaxActive)
+{
+	if((InstancePtr == NULL) || (MaxActive == 0)) {
+		return XST_FAILURE;
+	}
+
+	if (InstancePtr->Bg.Op != XFL_BG_OP_NONE) {
+		return (XFLASH_BUSY);
+	}
+
+	InstancePtr->Bg.MaxActive = MaxActive;
+
+	return (XST_SUCCESS);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -621,6 +935,54 @@ int XFlashGeometry_ToBlock(XFlashGeometry * InstancePtr,
 	return (XST_SUCCESS);
 }
 
+/*****************************************************************************/
+/**
+*
+* Finds the bank of a block. The banks come from the CFI partition/bank
+* layout of the part or, when the query has none, from XFL_BANK_SIZE.
+*
+* @param	InstancePtr is the pointer to the XFlashGeometry.
+* @param	Region is the erase region of the block.
+* @param	Block is the block within Region.
+* @param	Offset is the byte offset of the block in the device(s).
+*
+* @return	The bank of the block.
+*
+* @note		Blocks past the last bank XFL_BANK_SIZE can describe are all
+*		put in that bank.
+*
+******************************************************************************/
+u16 XFlashGeometry_ToBank(XFlashGeometry * InstancePtr, u16 Region,
+			  u16 Block, u32 Offset)
+{
+	u32 AbsoluteBlock;
+	u32 Index;
+
+	if (InstancePtr->NumBanks == 0) {
+#if (XFL_BANK_SIZE != 0)
+		Index = Offset / XFL_BANK_SIZE;
+		return ((Index < XFL_MAX_GEOM_BANKS) ? Index :
+						       (XFL_MAX_GEOM_BANKS - 1));
+#else
+		(void) Offset;
+		return 0;
+#endif
+	}
+
+	/*
+	 * When the loop breaks, Index will index one past the bank that the
+	 * block appears in.
+	 */
+	AbsoluteBlock = InstancePtr->EraseRegion[Region].AbsoluteBlock + Block;
+	for (Index = 1; Index < InstancePtr->NumBanks; Index++) {
+		if (AbsoluteBlock < InstancePtr->BankBlock[Index]) {
+			break;
+		}
+	}
+
+	return (Index - 1);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -655,6 +1017,14 @@ static int SetVTable(XFlash * InstancePtr)
 			InstancePtr->VTable.Reset = XFlashIntel_Reset;
 			InstancePtr->VTable.DeviceControl =
 						XFlashIntel_DeviceControl;
+			InstancePtr->VTable.EraseBlockStart =
+						XFlashIntel_EraseBlockStart;
+			InstancePtr->VTable.GetBankStatus =
+						XFlashIntel_GetBankStatus;
+			InstancePtr->VTable.EraseSuspend =
+						XFlashIntel_EraseSuspend;
+			InstancePtr->VTable.EraseResume = XFlashIntel_EraseResume;
+			InstancePtr->VTable.GetBlock = XFlashIntel_GetBlock;
 			break;
 #endif /* XPAR_XFL_DEVICE_FAMILY_INTEL */
 
@@ -671,6 +1041,13 @@ static int SetVTable(XFlash * InstancePtr)
 			InstancePtr->VTable.Reset = XFlashAmd_Reset;
 			InstancePtr->VTable.DeviceControl =
 						XFlashAmd_DeviceControl;
+			InstancePtr->VTable.EraseBlockStart =
+						XFlashAmd_EraseBlockStart;
+			InstancePtr->VTable.GetBankStatus =
+						XFlashAmd_GetBankStatus;
+			InstancePtr->VTable.EraseSuspend = XFlashAmd_EraseSuspend;
+			InstancePtr->VTable.EraseResume = XFlashAmd_EraseResume;
+			InstancePtr->VTable.GetBlock = XFlashAmd_GetBlock;
 			break;
 #endif /* XPAR_XFL_DEVICE_FAMILY_AMD */
 
@@ -680,3 +1057,295 @@ static int SetVTable(XFlash * InstancePtr)
 
 	return (XST_SUCCESS);
 }
+
+/*****************************************************************************/
+/**
+*
+* Sets up a background operation. The range is split into one contiguous
+* sub-range per bank (erase region) it touches.
+*
+* @param	InstancePtr is a pointer to the Flash instance.
+* @param	Op is XFL_BG_OP_ERASE or XFL_BG_OP_WRITE.
+* @param	Offset is the start of the range.
+* @param	Bytes is the size of the range.
+* @param	SrcPtr is the source data of a write, NULL for an erase.
+*
+* @return
+*		- XST_SUCCESS if the operation was started or Bytes is zero.
+*		- XFLASH_ADDRESS_ERROR if the range is outside the device(s).
+*		- XFLASH_BUSY if a background operation is in progress.
+*
+* @note		None.
+*
+******************************************************************************/
+static int BgStart(XFlash * InstancePtr, u32 Op, u32 Offset, u32 Bytes,
+		   void *SrcPtr)
+{
+	XFlash_Bg *BgPtr = &InstancePtr->Bg;
+	XFlash_BgBank *BankPtr;
+	u32 EndOffset;
+	u32 BlockOffset;
+	u32 BlockBytes;
+	u16 BankNum;
+	int Status;
+
+	if (BgPtr->Op != XFL_BG_OP_NONE) {
+		return (XFLASH_BUSY);
+	}
+
+	if (Bytes == 0) {
+		return (XST_SUCCESS);
+	}
+
+	/*
+	 * Verify the address range is within the part.
+	 */
+	EndOffset = Offset + Bytes;
+	if ((EndOffset < Offset) ||
+	    (InstancePtr->VTable.GetBlock(InstancePtr, EndOffset - 1,
+			&BankNum, &BlockOffset, &BlockBytes) != XST_SUCCESS)) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	for (BankNum = 0; BankNum < XFL_MAX_GEOM_BANKS; BankNum++) {
+		BgPtr->Bank[BankNum].State = XFL_BG_BANK_IDLE;
+	}
+
+	/*
+	 * Walk the range block by block and record where it starts and ends in
+	 * each bank.
+	 */
+	while (Offset < EndOffset) {
+		Status = InstancePtr->VTable.GetBlock(InstancePtr, Offset,
+					&BankNum, &BlockOffset, &BlockBytes);
+		if ((Status != XST_SUCCESS) ||
+		    (BankNum >= XFL_MAX_GEOM_BANKS)) {
+			return (XFLASH_ADDRESS_ERROR);
+		}
+
+		BankPtr = &BgPtr->Bank[BankNum];
+		if (BankPtr->State == XFL_BG_BANK_IDLE) {
+			BankPtr->State = XFL_BG_BANK_PENDING;
+			BankPtr->Next = Offset;
+		}
+
+		Offset = BlockOffset + BlockBytes;
+		BankPtr->End = (Offset < EndOffset) ? Offset : EndOffset;
+	}
+
+	BgPtr->Op = Op;
+	BgPtr->Offset = EndOffset - Bytes;
+	BgPtr->Bytes = Bytes;
+	BgPtr->BytesDone = 0;
+	BgPtr->SrcPtr = (u8 *) SrcPtr;
+	BgPtr->Status = XST_SUCCESS;
+	BgPtr->NumActive = 0;
+	BgPtr->NextBank = 0;
+
+	/*
+	 * Get the first blocks going right away.
+	 */
+	BgIssue(InstancePtr);
+
+	return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* Accounts for the end of the erase in flight in a bank.
+*
+* @param	InstancePtr is a pointer to the Flash instance.
+* @param	BankNum is the bank.
+* @param	Status is XFLASH_READY or the error reported by the device.
+*
+* @return	None.
+*
+* @note		The first error is kept as the status of the operation.
+*
+******************************************************************************/
+static void BgRetire(XFlash * InstancePtr, u32 BankNum, int Status)
+{
+	XFlash_Bg *BgPtr = &InstancePtr->Bg;
+	XFlash_BgBank *BankPtr = &BgPtr->Bank[BankNum];
+
+	BgPtr->NumActive--;
+	if (Status == XFLASH_READY) {
+		BgPtr->BytesDone += BankPtr->CurrentBytes;
+	}
+	else if (BgPtr->Status == XST_SUCCESS) {
+		BgPtr->Status = Status;
+	}
+
+	BankPtr->State = (BankPtr->Next < BankPtr->End) ?
+				XFL_BG_BANK_PENDING : XFL_BG_BANK_IDLE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Issues the next block erase, or programs the next write buffer, in the
+* pending banks. The banks are served round robin, no more than MaxActive of
+* them per call.
+*
+* @param	InstancePtr is a pointer to the Flash instance.
+*
+* @return	None.
+*
+* @note		A write buffer is programmed with the family Write function
+*		and so completes before this function returns.
+*
+******************************************************************************/
+static void BgIssue(XFlash * InstancePtr)
+{
+	XFlash_Bg *BgPtr = &InstancePtr->Bg;
+	XFlash_BgBank *BankPtr;
+	u32 NumBanks = XFL_MAX_GEOM_BANKS;
+	u32 Served = 0;
+	u32 Count;
+	u32 BankNum;
+	u32 BlockOffset;
+	u32 BlockBytes;
+	u32 Chunk;
+	u16 Dummy;
+	int Status;
+
+	for (Count = 0; Count < NumBanks; Count++) {
+		if ((BgPtr->NumActive >= BgPtr->MaxActive) ||
+		    (Served >= BgPtr->MaxActive)) {
+			break;
+		}
+
+		BankNum = (BgPtr->NextBank + Count) % NumBanks;
+		BankPtr = &BgPtr->Bank[BankNum];
+		if (BankPtr->State != XFL_BG_BANK_PENDING) {
+			continue;
+		}
+		Served++;
+
+		if (BgPtr->Op == XFL_BG_OP_ERASE) {
+			(void) InstancePtr->VTable.GetBlock(InstancePtr,
+					BankPtr->Next, &Dummy, &BlockOffset,
+					&BlockBytes);
+			Status = InstancePtr->VTable.EraseBlockStart(
+					InstancePtr, BlockOffset);
+			if (Status != XST_SUCCESS) {
+				BgPtr->Status = Status;
+				BankPtr->State = XFL_BG_BANK_IDLE;
+				break;
+			}
+
+			BankPtr->Current = BlockOffset;
+			BlockOffset += BlockBytes;
+			if (BlockOffset > BankPtr->End) {
+				BlockOffset = BankPtr->End;
+			}
+			BankPtr->CurrentBytes = BlockOffset - BankPtr->Next;
+			BankPtr->Next = BlockOffset;
+			BankPtr->State = XFL_BG_BANK_ACTIVE;
+			BgPtr->NumActive++;
+			continue;
+		}
+
+		/*
+		 * Program up to the next write buffer boundary.
+		 */
+		Chunk = InstancePtr->Properties.ProgCap.WriteBufferSize;
+		if (Chunk == 0) {
+			Chunk = XFL_BG_DEF_WRITE_CHUNK;
+		}
+		Chunk -= BankPtr->Next & (Chunk - 1);
+		if (Chunk > (BankPtr->End - BankPtr->Next)) {
+			Chunk = BankPtr->End - BankPtr->Next;
+		}
+
+		Status = InstancePtr->VTable.Write(InstancePtr, BankPtr->Next,
+				Chunk,
+				BgPtr->SrcPtr + (BankPtr->Next - BgPtr->Offset));
+		if (Status != XST_SUCCESS) {
+			BgPtr->Status = Status;
+			BankPtr->State = XFL_BG_BANK_IDLE;
+			break;
+		}
+
+		BgPtr->BytesDone += Chunk;
+		BankPtr->Next += Chunk;
+		if (BankPtr->Next >= BankPtr->End) {
+			BankPtr->State = XFL_BG_BANK_IDLE;
+		}
+	}
+
+	BgPtr->NextBank = (BgPtr->NextBank + Count) % NumBanks;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads from the device(s) while a background erase is in progress. Every bank
+* with an erase in the device is erase-suspended, the data is copied and the
+* erases are resumed.
+*
+* @param	InstancePtr is a pointer to the Flash instance.
+* @param	Offset is the offset into the device(s) address space from
+*		which to read.
+* @param	Bytes is the number of bytes to copy.
+* @param	DestPtr is the destination address to copy data to.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XFLASH_ADDRESS_ERROR if the source address does not start
+*		  within the addressable areas of the device(s).
+*
+* @note		All the active banks are suspended, not only the ones in the
+*		range, since on parts with a single partition a bank in read
+*		status mode hides the array data of the whole device.
+*
+******************************************************************************/
+static int BgRead(XFlash * InstancePtr, u32 Offset, u32 Bytes, void *DestPtr)
+{
+	XFlash_Bg *BgPtr = &InstancePtr->Bg;
+	XFlash_BgBank *BankPtr;
+	u32 BankNum;
+	int Status;
+
+	if (DestPtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	if (!XFL_GEOMETRY_IS_ABSOLUTE_VALID(&InstancePtr->Geometry, Offset)) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	for (BankNum = 0; BankNum < XFL_MAX_GEOM_BANKS; BankNum++) {
+		BankPtr = &BgPtr->Bank[BankNum];
+		if (BankPtr->State != XFL_BG_BANK_ACTIVE) {
+			continue;
+		}
+
+		Status = InstancePtr->VTable.EraseSuspend(InstancePtr,
+							  BankPtr->Current);
+		if (Status == XFLASH_ERASE_SUSPENDED) {
+			BankPtr->State = XFL_BG_BANK_SUSPENDED;
+		}
+		else {
+			/*
+			 * The erase finished before it could be suspended.
+			 */
+			BgRetire(InstancePtr, BankNum, Status);
+		}
+	}
+
+	memcpy(DestPtr, (void *) (InstancePtr->Geometry.BaseAddress + Offset),
+	       Bytes);
+
+	for (BankNum = 0; BankNum < XFL_MAX_GEOM_BANKS; BankNum++) {
+		BankPtr = &BgPtr->Bank[BankNum];
+		if (BankPtr->State == XFL_BG_BANK_SUSPENDED) {
+			(void) InstancePtr->VTable.EraseResume(InstancePtr,
+							BankPtr->Current);
+			BankPtr->State = XFL_BG_BANK_ACTIVE;
+		}
+	}
+
+	return (XST_SUCCESS);
+}
@@ -80,6 +80,9 @@
 *		      of erase regions is not more than 1.
 * 4.1	nsk  06/06/12 Updated Spansion WriteBuffer programming.
 *		      (CR 781697).
+* 4.3   esd  10/18/26 Added XFlashAmd_EraseBlockStart, XFlashAmd_GetBankStatus,
+*		      XFlashAmd_EraseSuspend, XFlashAmd_EraseResume and
+*		      XFlashAmd_GetBlock for the background erase engine.
 * </pre>
 *
 ******************************************************************************/
@@ -183,6 +186,7 @@ static void EnterExtendedBlockMode(XFlash * InstancePtr);
 static void ExitExtendedBlockMode(XFlash * InstancePtr);
 static int CheckBlockProtection(XFlash * InstancePtr, u32 Offset);
 static void  FlashPause(u32 MicroSeconds);
+static u32 ToGeometryOffset(XFlash * InstancePtr, u32 Offset);
 static int XFlashAmd_ResetBank(XFlash * InstancePtr, u32 Offset, u32 Bytes);
 extern int XFlashGeometry_ToBlock(XFlashGeometry * InstancePtr,
 				u32 AbsoluteOffset,
@@ -191,6 +195,8 @@ extern int XFlashGeometry_ToAbsolute(XFlashGeometry * InstancePtr,
 				u16 Region,
 				u16 Block,
 				u32 BlockOffset, u32 *AbsoluteOffsetPtr);
+extern u16 XFlashGeometry_ToBank(XFlashGeometry * InstancePtr,
+				u16 Region, u16 Block, u32 Offset);
 int WriteSingleBuffer(XFlash * InstancePtr, void *DestPtr,
 			 void *SrcPtr, u32 Bytes);
 static int WriteBufferAmd(XFlash * InstancePtr, void *DestPtr,
@@ -727,6 +733,222 @@ int XFlashAmd_Erase(XFlash * InstancePtr, u32 Offset, u32 Bytes)
 	return (XST_SUCCESS);
 }
 
+/*****************************************************************************/
+/**
+*
+* Issues the erase of the block containing Offset and returns without waiting
+* for the device.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the block to erase.
+*
+* @return
+*		- XST_SUCCESS if the erase was issued.
+*		- XFLASH_ADDRESS_ERROR if Offset is outside the device(s).
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlashAmd_EraseBlockStart(XFlash * InstancePtr, u32 Offset)
+{
+	u16 Region;
+	u16 Block;
+	u32 Dummy;
+	int Status;
+
+	/* Verify inputs are valid. */
+	if (InstancePtr == NULL) {
+		return (XST_FAILURE);
+	}
+
+	Status = XFlashGeometry_ToBlock(&InstancePtr->Geometry,
+					ToGeometryOffset(InstancePtr, Offset),
+					&Region, &Block, &Dummy);
+	if (Status != XST_SUCCESS) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	(void) EnqueueEraseBlocks(InstancePtr, &Region, &Block, 1);
+
+	return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* Samples the toggle bits of the bank containing Offset once. When the embedded
+* algorithm is done the bank is placed back into read mode.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the block being erased.
+*
+* @return
+*		- XFLASH_BUSY if the operation is still in progress.
+*		- XFLASH_READY if the operation completed.
+*		- XFLASH_ERROR if DQ5 reported a failure.
+*
+* @note		This is the non blocking counterpart of PollSR.
+*
+******************************************************************************/
+int XFlashAmd_GetBankStatus(XFlash * InstancePtr, u32 Offset)
+{
+	u32 BlockAddr;
+	u32 StatusReg1;
+	u32 StatusReg2;
+	int Status;
+	XFlashVendorData_Amd *DevDataPtr;
+
+	/* Verify inputs are valid. */
+	if (InstancePtr == NULL) {
+		return (XST_FAILURE);
+	}
+
+	DevDataPtr = GET_PARTDATA(InstancePtr);
+	BlockAddr = ToGeometryOffset(InstancePtr, Offset);
+
+	/* DQ6 stops toggling once the operation is over. */
+	StatusReg1 = DevDataPtr->GetStatus(InstancePtr->Geometry.BaseAddress,
+					   BlockAddr);
+	StatusReg2 = DevDataPtr->GetStatus(InstancePtr->Geometry.BaseAddress,
+					   BlockAddr);
+	if (((StatusReg1 ^ StatusReg2) & XFL_AMD_SR_ERASE_COMPL_MASK) == 0) {
+		Status = XFLASH_READY;
+	}
+	else if ((StatusReg2 & XFL_AMD_SR_ERASE_ERROR_MASK) == 0) {
+		return (XFLASH_BUSY);
+	}
+	else {
+		/* DQ5 set, DQ6 must have stopped toggling by now. */
+		StatusReg1 = DevDataPtr->GetStatus(
+					InstancePtr->Geometry.BaseAddress,
+					BlockAddr);
+		StatusReg2 = DevDataPtr->GetStatus(
+					InstancePtr->Geometry.BaseAddress,
+					BlockAddr);
+		if (((StatusReg1 ^ StatusReg2) &
+		     XFL_AMD_SR_ERASE_COMPL_MASK) == 0) {
+			Status = XFLASH_READY;
+		}
+		else {
+			Status = XFLASH_ERROR;
+		}
+	}
+
+	/* Return the bank to read mode. */
+	DevDataPtr->WriteFlash(InstancePtr->Geometry.BaseAddress, BlockAddr,
+			       XFL_AMD_CMD_RESET);
+
+	return (Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* Suspends the erase in progress in the bank containing Offset and places the
+* device into erase-suspend-read mode until XFlashAmd_EraseResume() is called.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the block being erased.
+*
+* @return
+*		- XFLASH_ERASE_SUSPENDED.
+*		- XST_FAILURE if failed.
+*
+* @note		An erase that completed before the suspend is reported as
+*		suspended too; the device ignores the resume command and the
+*		next XFlashAmd_GetBankStatus() reports it as done.
+*
+******************************************************************************/
+int XFlashAmd_EraseSuspend(XFlash * InstancePtr, u32 Offset)
+{
+	int Status;
+
+	Status = EraseSuspend(InstancePtr,
+			      ToGeometryOffset(InstancePtr, Offset));
+	if (Status != XST_SUCCESS) {
+		return (Status);
+	}
+
+	return (XFLASH_ERASE_SUSPENDED);
+}
+
+/*****************************************************************************/
+/**
+*
+* Resumes the erase suspended by XFlashAmd_EraseSuspend().
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the block being erased.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlashAmd_EraseResume(XFlash * InstancePtr, u32 Offset)
+{
+	return (EraseResume(InstancePtr,
+			    ToGeometryOffset(InstancePtr, Offset)));
+}
+
+/*****************************************************************************/
+/**
+*
+* Locates the block containing Offset.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is the byte offset to locate.
+* @param	Bank is the returned bank of the block.
+* @param	BlockOffset is the returned byte offset of the start of the
+*		block.
+* @param	BlockBytes is the returned size of the block in bytes.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XFLASH_ADDRESS_ERROR if Offset is outside the device(s).
+*		- XST_FAILURE if failed.
+*
+* @note		The geometry of a x16 device is kept in words; the results are
+*		converted back to bytes.
+*
+******************************************************************************/
+int XFlashAmd_GetBlock(XFlash * InstancePtr, u32 Offset, u16 *Bank,
+		       u32 *BlockOffset, u32 *BlockBytes)
+{
+	u16 Region;
+	u16 Block;
+	u32 Dummy;
+	u32 Shift;
+	int Status;
+
+	/* Verify inputs are valid. */
+	if (InstancePtr == NULL) {
+		return (XST_FAILURE);
+	}
+
+	Shift = (InstancePtr->Geometry.MemoryLayout == XFL_LAYOUT_X16_X16_X1) ?
+		1 : 0;
+
+	Status = XFlashGeometry_ToBlock(&InstancePtr->Geometry,
+					Offset >> Shift, &Region, &Block,
+					&Dummy);
+	if (Status != XST_SUCCESS) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	(void) XFlashGeometry_ToAbsolute(&InstancePtr->Geometry, Region, Block,
+					 0, BlockOffset);
+	*BlockOffset <<= Shift;
+	*Bank = XFlashGeometry_ToBank(&InstancePtr->Geometry, Region, Block,
+				      *BlockOffset);
+	*BlockBytes = InstancePtr->Geometry.EraseRegion[Region].Size << Shift;
+
+	return (XST_SUCCESS);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -2382,12 +2604,9 @@ static u16 EnqueueEraseBlocks(XFlash * InstancePtr, u16 *Region,
 *		- XST_SUCCESS if successful.
 *		- XST_FAILURE if fail.
 *
-* @note		This API can not be used in application, because Erase API is
-*		blocking function in this library. If user wants to use this
-*		feature than Flash library Erase function should be changed such
-*		Erase API will be non blocking function. In case of non blocking
-*		Erase API, application must check status of erase operation in
-*		the application.
+* @note		The blocking Erase API never leaves an erase to suspend. The
+*		background erase started by XFlash_BgErase() uses this through
+*		XFlashAmd_EraseSuspend() and XFlashAmd_EraseResume().
 *
 ******************************************************************************/
 static int EraseResume(XFlash * InstancePtr, u32 EraseAddrOff)
@@ -2424,12 +2643,9 @@ static int EraseResume(XFlash * InstancePtr, u32 EraseAddrOff)
 *		- XST_SUCCESS if successful.
 *		- XST_FAILURE if fail.
 *
-* @note		This API can not be used in application, because Erase API is
-*		blocking function in this library. If user wants to use this
-*		feature than Flash library Erase function should be changed such
-*		Erase API will be non blocking function. In case of non blocking
-*		Erase API, application must check status of erase operation in
-*		the application.
+* @note		The blocking Erase API never leaves an erase to suspend. The
+*		background erase started by XFlash_BgErase() uses this through
+*		XFlashAmd_EraseSuspend() and XFlashAmd_EraseResume().
 *
 ******************************************************************************/
 static int EraseSuspend(XFlash * InstancePtr, u32 EraseAddrOff)
@@ -2674,4 +2890,26 @@ static void  FlashPause(u32 MicroSeconds)
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* Converts a byte offset into the units the geometry of the part is kept in.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is the byte offset.
+*
+* @return	The word offset for a x16 part, Offset otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 ToGeometryOffset(XFlash * InstancePtr, u32 Offset)
+{
+	if (InstancePtr->Geometry.MemoryLayout == XFL_LAYOUT_X16_X16_X1) {
+		return (Offset >> 1);
+	}
+
+	return (Offset);
+}
+
 #endif /* XPAR_XFL_DEVICE_FAMILY_AMD */
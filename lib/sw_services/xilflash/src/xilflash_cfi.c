@@ -84,6 +84,9 @@
 *		      CR 662317 Description - Xilinx Platform Flash on ML605
 *		      fails to work.
 * 3.04a srt  02/18/13 Fixed CR 700553.
+* 4.3   esd  10/18/26 Record the bank layout in Geometry.NumBanks/BankBlock
+*		      from the Intel partition region information and the
+*		      AMD bank organisation.
 * </pre>
 *
 *
@@ -152,6 +155,8 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 	u8 TypesEraseBlock;
 	u16 NumBlockInBank;
 	u32 SizeBlockInBank;
+	u16 BlocksInBank;
+	u16 BankStart;
 	XFlashGeometry *GeomPtr;
 
 	if(InstancePtr == NULL) {
@@ -458,6 +463,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 		CurrentAbsoluteOffset = 0;
 		CurrentAbsoluteBlock = 0;
 		InstancePtr->Geometry.NumBlocks = 0;
+		InstancePtr->Geometry.NumBanks = 0;
 		for (Index = 0; Index < InstancePtr->Geometry.NumEraseRegions;
 		     Index++) {
 
@@ -555,6 +561,50 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 					     (ExtendedQueryTblOffset + 0x0F));
 			InstancePtr->Geometry.BootMode =
 				XFlashCFI_Read8((u8*)DataPtr, Interleave, Mode);
+
+			/*
+			 * Extended Query Table Offset + 0x03/0x04: Version.
+			 * Extended Query Table Offset + 0x17: Number of
+			 * banks, from version 1.4 on. It is followed by the
+			 * number of sectors in each bank, lowest bank first.
+			 */
+			XFL_CFI_POSITION_PTR(DataPtr, BaseAddress, Interleave,
+					     (ExtendedQueryTblOffset + 0x03));
+			Data8 = XFlashCFI_Read8((u8*)DataPtr, Interleave, Mode);
+			XFL_CFI_ADVANCE_PTR8(DataPtr, Interleave);
+			Data16 = XFlashCFI_Read8((u8*)DataPtr, Interleave,
+						 Mode);
+			if ((Data8 > '1') || ((Data8 == '1') &&
+			    (Data16 >= '4'))) {
+				XFL_CFI_POSITION_PTR(DataPtr, BaseAddress,
+					Interleave,
+					(ExtendedQueryTblOffset + 0x17));
+				NumBanks = XFlashCFI_Read8((u8*)DataPtr,
+						Interleave, Mode);
+				if (NumBanks > XFL_MAX_GEOM_BANKS) {
+					NumBanks = 0;
+				}
+
+				BankStart = 0;
+				for (Bank = 0; Bank < NumBanks; Bank++) {
+					XFL_CFI_ADVANCE_PTR8(DataPtr,
+							     Interleave);
+					InstancePtr->Geometry.BankBlock[Bank] =
+								BankStart;
+					BankStart += XFlashCFI_Read8(
+							(u8*)DataPtr,
+							Interleave, Mode);
+				}
+
+				/*
+				 * Only trust a layout which covers the part.
+				 */
+				if (BankStart ==
+				    InstancePtr->Geometry.NumBlocks) {
+					InstancePtr->Geometry.NumBanks =
+								NumBanks;
+				}
+			}
 		}
 
 		/*
@@ -573,6 +623,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 			CurrentAbsoluteOffset = 0;
 			CurrentAbsoluteBlock = 0;
 			Bank = 0;
+			BankStart = 0;
 			GeomPtr = &InstancePtr->Geometry;
 			while (Index < NumEraseRegions) {
 				/*
@@ -602,6 +653,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 						Interleave, Mode);
 
 				XFL_CFI_ADVANCE_PTR8(DataPtr, Interleave);
+				BlocksInBank = 0;
 				while (TypesEraseBlock--) {
 					/*
 					 * Number of erase block in bank
@@ -619,6 +671,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 						XFlashCFI_Read16((u8*)DataPtr,
 							Interleave, Mode);
 					SizeBlockInBank *= 256;
+					BlocksInBank += NumBlockInBank;
 					/*
 					 * Update flash instance structure
 					 */
@@ -652,6 +705,17 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 					XFL_CFI_ADVANCE_PTR16(DataPtr,
 						Interleave);
 				}
+
+				/*
+				 * Each of the identical banks is a partition.
+				 */
+				while ((NumBanks-- != 0) &&
+				       (GeomPtr->NumBanks < XFL_MAX_GEOM_BANKS)) {
+					GeomPtr->BankBlock[GeomPtr->NumBanks] =
+								BankStart;
+					GeomPtr->NumBanks++;
+					BankStart += BlocksInBank;
+				}
 				Index++;
 			}
 			GeomPtr->EraseRegion[Bank].AbsoluteOffset =
@@ -673,6 +737,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 			CurrentAbsoluteOffset = 0;
 			CurrentAbsoluteBlock = 0;
 			Bank = 0;
+			BankStart = 0;
 			GeomPtr = &InstancePtr->Geometry;
 
 			while (Index < NumEraseRegions) {
@@ -699,6 +764,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 						Interleave, Mode);
 
 				XFL_CFI_ADVANCE_PTR8(DataPtr, Interleave);
+				BlocksInBank = 0;
 				while (TypesEraseBlock--) {
 					/*
 					 * Number of erase block in bank
@@ -716,6 +782,7 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 						XFlashCFI_Read16((u8*)DataPtr,
 							Interleave, Mode);
 					SizeBlockInBank *= 256;
+					BlocksInBank += NumBlockInBank;
 
 					/*
 					 * Update flash instance structure
@@ -744,6 +811,17 @@ int XFlashCFI_ReadCommon(XFlash *InstancePtr, u8 BusWidth)
 						Bank++;
 					}
 				}
+
+				/*
+				 * Each of the identical banks is a partition.
+				 */
+				while ((NumBanks-- != 0) &&
+				       (GeomPtr->NumBanks < XFL_MAX_GEOM_BANKS)) {
+					GeomPtr->BankBlock[GeomPtr->NumBanks] =
+								BankStart;
+					GeomPtr->NumBanks++;
+					BankStart += BlocksInBank;
+				}
 				Index++;
 			}
 			GeomPtr->EraseRegion[Bank].AbsoluteOffset =
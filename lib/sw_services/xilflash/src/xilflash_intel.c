@@ -97,6 +97,10 @@
 *		      Description: Non-word aligned data write to flash fails
 *		      with AXI interface.
 * 4.1	nsk  08/06/15 Fixed CR 835008.
+* 4.3   esd  10/18/26 Added XFlashIntel_EraseBlockStart,
+*		      XFlashIntel_GetBankStatus, XFlashIntel_EraseSuspend,
+*		      XFlashIntel_EraseResume and XFlashIntel_GetBlock for the
+*		      background erase engine.
 * </pre>
 *
 ******************************************************************************/
@@ -211,6 +215,7 @@ static void GetPartID(XFlash *InstancePtr);
 static int XFlashIntel_ResetBank(XFlash *InstancePtr, u32 Offset, u32 Bytes);
 static u16 EnqueueEraseBlocks(XFlash *InstancePtr, u16 *RegionPtr,
 				u16 *BlockPtr, u16 MaxBlocks);
+static int IsEraseSuspended(XFlash *InstancePtr);
 
 extern int XFlashGeometry_ToBlock(XFlashGeometry *InstancePtr,
 				u32 AbsoluteOffset,
@@ -219,6 +224,8 @@ extern int XFlashGeometry_ToAbsolute(XFlashGeometry *InstancePtr,
 				u16 Region,
 				u16 Block,
 				u32 BlockOffset, u32 *AbsoluteOffsetPtr);
+extern u16 XFlashGeometry_ToBank(XFlashGeometry *InstancePtr,
+				u16 Region, u16 Block, u32 Offset);
 
 /************************** Variable Definitions *****************************/
 
@@ -575,6 +582,237 @@ int XFlashIntel_Erase(XFlash *InstancePtr, u32 Offset, u32 Bytes)
 	return (XST_SUCCESS);
 }
 
+/*****************************************************************************/
+/**
+*
+* Issues the erase of the block containing Offset and returns without waiting
+* for the device. The bank stays in read status mode until the erase completes
+* and XFlashIntel_GetBankStatus() returns it to read array mode.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the block to erase.
+*
+* @return
+*		- XST_SUCCESS if the erase was issued.
+*		- XFLASH_ADDRESS_ERROR if Offset is outside the device(s).
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlashIntel_EraseBlockStart(XFlash *InstancePtr, u32 Offset)
+{
+	u16 Region, Block;
+	u32 Dummy;
+	int Status;
+
+	/*
+	 * Verify inputs are valid.
+	 */
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	Status = XFlashGeometry_ToBlock(&InstancePtr->Geometry, Offset,
+					&Region, &Block, &Dummy);
+	if (Status != XST_SUCCESS) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	(void) EnqueueEraseBlocks(InstancePtr, &Region, &Block, 1);
+
+	return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* Samples the status register of the bank containing Offset once. When the WSM
+* is done the status register is cleared and the bank is placed back into read
+* array mode.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the bank.
+*
+* @return
+*		- XFLASH_BUSY if the operation is still in progress.
+*		- XFLASH_READY if the operation completed without errors.
+*		- XFLASH_ERROR if the operation failed. XFlash_DeviceControl()
+*		  retrieves the status register contents.
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlashIntel_GetBankStatus(XFlash *InstancePtr, u32 Offset)
+{
+	XFlashVendorData_Intel *DevDataPtr;
+	u32 BaseAddress;
+	int Status;
+
+	/*
+	 * Verify inputs are valid.
+	 */
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	DevDataPtr = GET_PARTDATA(InstancePtr);
+	BaseAddress = InstancePtr->Geometry.BaseAddress;
+
+	DevDataPtr->SendCmd(BaseAddress, Offset,
+			    XFL_INTEL_CMD_READ_STATUS_REG);
+	Status = DevDataPtr->GetStatus(InstancePtr, Offset);
+	if (Status == XFLASH_BUSY) {
+		return (XFLASH_BUSY);
+	}
+
+	DevDataPtr->SendCmd(BaseAddress, Offset,
+			    XFL_INTEL_CMD_CLEAR_STATUS_REG);
+	DevDataPtr->SendCmd(BaseAddress, Offset, XFL_INTEL_CMD_READ_ARRAY);
+
+	return (Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* Suspends the erase in progress in the bank containing Offset and places the
+* bank into read array mode, so that it can be read until
+* XFlashIntel_EraseResume() is called.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the bank.
+*
+* @return
+*		- XFLASH_ERASE_SUSPENDED if the erase was suspended.
+*		- XFLASH_READY if the erase completed before it could be
+*		  suspended. The erase must not be resumed.
+*		- XFLASH_ERROR if the erase failed before it could be
+*		  suspended. The erase must not be resumed.
+*
+* @note		The suspend latency of the device (typically 20-30us) is
+*		spent polling here.
+*
+******************************************************************************/
+int XFlashIntel_EraseSuspend(XFlash *InstancePtr, u32 Offset)
+{
+	XFlashVendorData_Intel *DevDataPtr;
+	u32 BaseAddress;
+	int Status;
+
+	/*
+	 * Verify inputs are valid.
+	 */
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	DevDataPtr = GET_PARTDATA(InstancePtr);
+	BaseAddress = InstancePtr->Geometry.BaseAddress;
+
+	/*
+	 * Request the suspend and wait for the WSM to stop.
+	 */
+	DevDataPtr->SendCmd(BaseAddress, Offset, XFL_INTEL_CMD_SUSPEND);
+	do {
+		Status = DevDataPtr->GetStatus(InstancePtr, Offset);
+	} while (Status == XFLASH_BUSY);
+
+	/*
+	 * A ready WSM with only the erase suspended bit set is reported as an
+	 * error by GetStatus; tell it apart from a real error.
+	 */
+	if ((Status == XFLASH_ERROR) && IsEraseSuspended(InstancePtr)) {
+		Status = XFLASH_ERASE_SUSPENDED;
+	}
+	else {
+		DevDataPtr->SendCmd(BaseAddress, Offset,
+				    XFL_INTEL_CMD_CLEAR_STATUS_REG);
+	}
+
+	DevDataPtr->SendCmd(BaseAddress, Offset, XFL_INTEL_CMD_READ_ARRAY);
+
+	return (Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* Resumes the erase suspended by XFlashIntel_EraseSuspend(). The bank returns
+* to read status mode.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is an offset within the bank.
+*
+* @return	XST_SUCCESS.
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlashIntel_EraseResume(XFlash *InstancePtr, u32 Offset)
+{
+	XFlashVendorData_Intel *DevDataPtr;
+
+	/*
+	 * Verify inputs are valid.
+	 */
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	DevDataPtr = GET_PARTDATA(InstancePtr);
+	DevDataPtr->SendCmd(InstancePtr->Geometry.BaseAddress, Offset,
+			    XFL_INTEL_CMD_RESUME);
+
+	return (XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+*
+* Locates the block containing Offset.
+*
+* @param	InstancePtr is the pointer to the XFlash instance.
+* @param	Offset is the offset to locate.
+* @param	Bank is the returned bank (partition) of the block.
+* @param	BlockOffset is the returned offset of the start of the block.
+* @param	BlockBytes is the returned size of the block.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XFLASH_ADDRESS_ERROR if Offset is outside the device(s).
+*
+* @note		None.
+*
+******************************************************************************/
+int XFlashIntel_GetBlock(XFlash *InstancePtr, u32 Offset, u16 *Bank,
+			 u32 *BlockOffset, u32 *BlockBytes)
+{
+	u16 Region, Block;
+	u32 Dummy;
+	int Status;
+
+	/*
+	 * Verify inputs are valid.
+	 */
+	if(InstancePtr == NULL) {
+		return XST_FAILURE;
+	}
+
+	Status = XFlashGeometry_ToBlock(&InstancePtr->Geometry, Offset,
+					&Region, &Block, &Dummy);
+	if (Status != XST_SUCCESS) {
+		return (XFLASH_ADDRESS_ERROR);
+	}
+
+	(void) XFlashGeometry_ToAbsolute(&InstancePtr->Geometry, Region, Block,
+					 0, BlockOffset);
+	*Bank = XFlashGeometry_ToBank(&InstancePtr->Geometry, Region, Block,
+				      *BlockOffset);
+	*BlockBytes = InstancePtr->Geometry.EraseRegion[Region].Size;
+
+	return (XST_SUCCESS);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -3264,4 +3502,53 @@ static u16 EnqueueEraseBlocks(XFlash *InstancePtr, u16 *Region,
 	return (1);
 }
 
+/*****************************************************************************/
+/**
+*
+* Checks the status register value last captured in SR_LastError for an erase
+* suspended indication without any error bits.
+*
+* @param	InstancePtr is the pointer to xflash object to work on.
+*
+* @return	TRUE if every part reports the WSM ready with the erase
+*		suspended, FALSE otherwise.
+*
+* @note		The erase suspended bit is the bit below WSM ready in every
+*		part, so its mask is SR_WsmReady shifted right by one.
+*
+******************************************************************************/
+static int IsEraseSuspended(XFlash *InstancePtr)
+{
+	XFlashVendorData_Intel *DevDataPtr = GET_PARTDATA(InstancePtr);
+	u32 Mask;
+
+	switch (InstancePtr->Geometry.MemoryLayout) {
+		case XFL_LAYOUT_X16_X8_X1:
+			Mask = DevDataPtr->SR_WsmReady.Mask8;
+			Mask |= Mask >> 1;
+			return (DevDataPtr->SR_LastError.Mask8 == Mask);
+
+		case XFL_LAYOUT_X16_X16_X1:
+			Mask = DevDataPtr->SR_WsmReady.Mask16;
+			Mask |= Mask >> 1;
+			return (DevDataPtr->SR_LastError.Mask16 == Mask);
+
+		case XFL_LAYOUT_X16_X16_X2:
+			Mask = DevDataPtr->SR_WsmReady.Mask32;
+			Mask |= Mask >> 1;
+			return (DevDataPtr->SR_LastError.Mask32 == Mask);
+
+		case XFL_LAYOUT_X16_X16_X4:
+			Mask = DevDataPtr->SR_WsmReady.Mask32;
+			Mask |= Mask >> 1;
+			return ((XUINT64_MSW(DevDataPtr->SR_LastError.Mask64) ==
+				 Mask) &&
+				(XUINT64_LSW(DevDataPtr->SR_LastError.Mask64) ==
+				 Mask));
+
+		default:
+			return (FALSE);
+	}
+}
+
 #endif /* XPAR_XFL_DEVICE_FAMILY_INTEL */
@@ -43,6 +43,9 @@
  * ----- ---- -------- -------------------------------------------------------
  * 1.0   Nava  08/06/16 Initial release
  * 1.1   Nava  16/11/16 Added PL power-up sequence.
+ * 1.2   esd   18/10/26 Added chunked streaming API, partial bit-stream
+ *                      loading without PL re-initialization and
+ *                      preloaded bit-streams.
  *
  * </pre>
  *
@@ -74,6 +77,12 @@
 
 #define MAX_REG_BITS	31
 
+/* CSU DMA source channel errors which end a transfer */
+#define XFPGA_CSUDMA_SRC_ERR_MASK	(XCSUDMA_IXR_INVALID_APB_MASK | \
+					XCSUDMA_IXR_TIMEOUT_MEM_MASK | \
+					XCSUDMA_IXR_TIMEOUT_STRM_MASK | \
+					XCSUDMA_IXR_AXI_WRERR_MASK)
+
 /**************************** Type Definitions *******************************/
 #ifdef __MICROBLAZE__
 typedef u32 (*XpbrServHndlr_t) (void);
@@ -82,8 +91,10 @@ typedef u32 (*XpbrServHndlr_t) (void);
 
 /************************** Function Prototypes ******************************/
 static u32 XFpga_PcapWaitForDone();
-static u32 XFpga_WriteToPcap(u32 WrSize, u32 WrAddrHigh, u32 WrAddrLow);
-static u32 XFpga_PcapInit(void);
+static u32 XFpga_CsuDmaSrcCheck(u64 WrAddr, u32 WrSize);
+static void XFpga_CsuDmaSrcStart(u64 WrAddr, u32 WrSize, u32 Flags);
+static u32 XFpga_CsuDmaSrcWait(void);
+static u32 XFpga_PcapInit(u32 Flags);
 static u32 XFpga_CsuDmaInit();
 static u32 XFpga_PLWaitForDone(void);
 static u32 XFpga_PowerUpPl(void);
@@ -95,6 +106,11 @@ extern const XpbrServHndlr_t XpbrServHndlrTbl[XPBR_SERV_EXT_TBL_MAX];
 /************************** Variable Definitions *****************************/
 XCsuDma CsuDma;
 
+static u8 CsuDmaReady = FALSE;	/* CSU DMA driver is initialized */
+static u8 StreamActive = FALSE;	/* Between StreamStart and StreamFinish */
+static u8 XferPending = FALSE;	/* A chunk is still being transferred */
+static u32 StreamFlags;		/* Flags of the active stream */
+
 /*****************************************************************************/
 
 /*****************************************************************************/
@@ -119,8 +135,11 @@ XCsuDma CsuDma;
  *		BIT(2) - Encryption.
  *			 1 - Enable.
  *			 0 - Disable.
+ *		BIT(3) - Preloaded Bit-stream.
+ *			 1 - Bit-stream was prepared with XFpga_PL_Preload.
+ *			 0 - Bit-stream is flushed from the data cache.
  * NOTE -
- *	The current implementation supports only Full Bit-stream.
+ *	Authentication and Encryption are not supported.
  *
  *@return	error status based on implemented functionality (SUCCESS by default)
  *
@@ -130,28 +149,172 @@ u32 XFpga_PL_BitSream_Load (u32 WrAddrHigh, u32 WrAddrLow,
 {
 	u32 Status = XFPGA_SUCCESS;
 
-	/* Power-Up PL */
-	Status = XFpga_PowerUpPl();
+	Status = XFpga_PL_StreamStart(flags);
 	if (Status != XFPGA_SUCCESS) {
-		xil_printf("XFPGA_ERROR_PL_POWER_UP\r\n");
-		Status = XFPGA_ERROR_PL_POWER_UP;
 		goto END;
 	}
 
-	/* PS PL Isolation Restore */
-	Status = XFpga_IsolationRestore();
+	Status = XFpga_PL_StreamWrite(WrAddrHigh, WrAddrLow, WrSize);
 	if (Status != XFPGA_SUCCESS) {
-		xil_printf("XFPGA_ERROR_PL_ISOLATION\r\n");
-		Status = XFPGA_ERROR_PL_ISOLATION;
 		goto END;
 	}
 
-	Status = XFpga_PcapInit();
+	Status = XFpga_PL_StreamFinish();
+
+	END:
+	return Status;
+}
+
+/*****************************************************************************/
+/** This function prepares the PL and the PCAP interface for a bit-stream
+ * which is then written in chunks with XFpga_PL_StreamWrite.
+ *
+ * For a full bit-stream the PL is powered up, the PS-PL isolation is
+ * removed and the PL is reset through PROG_B. For a partial bit-stream
+ * (XFPGA_PARTIAL_EN) the PL keeps running and only the PCAP interface is
+ * set up, so that the static part of the design is not disturbed.
+ *
+ *@param	Flags: Same as the flags of XFpga_PL_BitSream_Load.
+ *
+ *@return	error status based on implemented functionality (SUCCESS by default)
+ *
+ *****************************************************************************/
+u32 XFpga_PL_StreamStart(u32 Flags)
+{
+	u32 Status = XFPGA_SUCCESS;
+	u32 RegVal;
+
+	if (StreamActive == TRUE) {
+		Status = XFPGA_ERROR_STREAM_STATE;
+		goto END;
+	}
+
+	if ((Flags & XFPGA_PARTIAL_EN) == 0U) {
+		/* Power-Up PL */
+		Status = XFpga_PowerUpPl();
+		if (Status != XFPGA_SUCCESS) {
+			xil_printf("XFPGA_ERROR_PL_POWER_UP\r\n");
+			Status = XFPGA_ERROR_PL_POWER_UP;
+			goto END;
+		}
+
+		/* PS PL Isolation Restore */
+		Status = XFpga_IsolationRestore();
+		if (Status != XFPGA_SUCCESS) {
+			xil_printf("XFPGA_ERROR_PL_ISOLATION\r\n");
+			Status = XFPGA_ERROR_PL_ISOLATION;
+			goto END;
+		}
+	}
+
+	Status = XFpga_PcapInit(Flags);
 	if(Status != XFPGA_SUCCESS) {
 		xil_printf("FPGA Init fail\n");
 		goto END;
 	}
-	Status = XFpga_WriteToPcap(WrSize, WrAddrHigh, WrAddrLow);
+
+	/*
+	 * Setup the  SSS, setup the PCAP to receive from DMA source
+	 */
+	RegVal = Xil_In32(CSU_CSU_SSS_CFG) & CSU_CSU_SSS_CFG_PCAP_SSS_MASK;
+	RegVal = RegVal
+			| (XFPGA_CSU_SSS_SRC_SRC_DMA << CSU_CSU_SSS_CFG_PCAP_SSS_SHIFT);
+	Xil_Out32(CSU_CSU_SSS_CFG, RegVal);
+
+	StreamFlags = Flags;
+	XferPending = FALSE;
+	StreamActive = TRUE;
+
+	END:
+	return Status;
+}
+
+/*****************************************************************************/
+/** This function queues one chunk of the bit-stream to the PCAP interface.
+ * It waits for the previous chunk to be consumed, starts the CSU DMA on this
+ * chunk and returns while the transfer is in progress, so the caller can
+ * fetch the next chunk into another buffer meanwhile.
+ *
+ *@param	WrAddrHigh: Higher 32-bit Linear memory space of the chunk
+ *
+ *@param        WrAddrLow: Lower 32-bit Linear memory space of the chunk
+ *
+ *@param        WrSize: Number of 32bit words in the chunk
+ *
+ *@return	error status based on implemented functionality (SUCCESS by default)
+ *
+ * NOTE -
+ *	The chunk must not be modified until the next XFpga_PL_StreamWrite or
+ *	XFpga_PL_StreamFinish returns, two buffers used alternately keep the
+ *	PCAP busy. The chunk must be word aligned and at most XCSUDMA_SIZE_MAX
+ *	words. On an error, of this chunk or of the CSU DMA transfer of the
+ *	previous one, the stream is over and must be started again.
+ *
+ *****************************************************************************/
+u32 XFpga_PL_StreamWrite(u32 WrAddrHigh, u32 WrAddrLow, u32 WrSize)
+{
+	u32 Status = XFPGA_SUCCESS;
+	u64 WrAddr;
+
+	if (StreamActive != TRUE) {
+		Status = XFPGA_ERROR_STREAM_STATE;
+		goto END;
+	}
+
+	WrAddr = ((u64)WrAddrHigh << 32)|WrAddrLow;
+	Status = XFpga_CsuDmaSrcCheck(WrAddr, WrSize);
+
+	if (XferPending == TRUE) {
+		XferPending = FALSE;
+		if (XFpga_CsuDmaSrcWait() != XFPGA_SUCCESS) {
+			xil_printf("FPGA fail to write Bit-stream chunk\n");
+			Status = XFPGA_ERROR_CSUDMA_XFER_FAIL;
+		}
+	}
+
+	if (Status != XFPGA_SUCCESS) {
+		/* The bit-stream is incomplete, the stream is over */
+		StreamActive = FALSE;
+		goto END;
+	}
+
+	XFpga_CsuDmaSrcStart(WrAddr, WrSize, StreamFlags);
+	XferPending = TRUE;
+
+	END:
+	return Status;
+}
+
+/*****************************************************************************/
+/** This function completes a bit-stream written with XFpga_PL_StreamWrite.
+ * It waits for the last chunk and the PL done status, and for a full
+ * bit-stream powers up the PL and resets the fabric through the EMIO pins.
+ *
+ *@param	None
+ *
+ *@return	error status based on implemented functionality (SUCCESS by default)
+ *
+ *****************************************************************************/
+u32 XFpga_PL_StreamFinish(void)
+{
+	u32 Status = XFPGA_SUCCESS;
+
+	if (StreamActive != TRUE) {
+		Status = XFPGA_ERROR_STREAM_STATE;
+		goto END;
+	}
+	StreamActive = FALSE;
+
+	if (XferPending == TRUE) {
+		XferPending = FALSE;
+		Status = XFpga_CsuDmaSrcWait();
+		if (Status != XFPGA_SUCCESS) {
+			xil_printf("FPGA fail to write Bit-stream chunk\n");
+			goto END;
+		}
+	}
+
+	Status = XFpga_PcapWaitForDone();
 	if(Status != XFPGA_SUCCESS) {
 		xil_printf("FPGA fail to write Bit-stream into PL\n");
 		goto END;
@@ -162,6 +325,11 @@ u32 XFpga_PL_BitSream_Load (u32 WrAddrHigh, u32 WrAddrLow,
 		goto END;
 	}
 
+	/* Partial Bit-stream leaves the running PL untouched */
+	if ((StreamFlags & XFPGA_PARTIAL_EN) != 0U) {
+		goto END;
+	}
+
 	/* Power-Up PL */
 	Status = XFpga_PowerUpPl();
 	if (Status != XFPGA_SUCCESS) {
@@ -176,15 +344,54 @@ u32 XFpga_PL_BitSream_Load (u32 WrAddrHigh, u32 WrAddrLow,
 	END:
 	return Status;
 }
+
+/*****************************************************************************/
+/** This function prepares a bit-stream kept in memory, typically a partial
+ * bit-stream cached in DDR, for repeated loading. The bit-stream is flushed
+ * from the data cache once here, and loads with XFPGA_PRELOADED_EN skip the
+ * cache maintenance, which otherwise costs a walk over the whole bit-stream
+ * on every load.
+ *
+ *@param	WrAddrHigh: Higher 32-bit Linear memory space of the bit-stream
+ *
+ *@param        WrAddrLow: Lower 32-bit Linear memory space of the bit-stream
+ *
+ *@param        WrSize: Number of 32bit words of the bit-stream
+ *
+ *@return	error status based on implemented functionality (SUCCESS by default)
+ *
+ * NOTE -
+ *	The bit-stream must not be written by the CPU between XFpga_PL_Preload
+ *	and a load with XFPGA_PRELOADED_EN.
+ *
+ *****************************************************************************/
+u32 XFpga_PL_Preload(u32 WrAddrHigh, u32 WrAddrLow, u32 WrSize)
+{
+	u32 Status = XFPGA_SUCCESS;
+	u64 WrAddr;
+
+	WrAddr = ((u64)WrAddrHigh << 32)|WrAddrLow;
+	Status = XFpga_CsuDmaSrcCheck(WrAddr, WrSize);
+	if (Status != XFPGA_SUCCESS) {
+		goto END;
+	}
+
+	Xil_DCacheFlushRange((UINTPTR)WrAddr, WrSize << XCSUDMA_SIZE_SHIFT);
+
+	Status = XFpga_CsuDmaInit();
+
+	END:
+	return Status;
+}
 /*****************************************************************************/
 /** This function does the necessary initialization of PCAP interface
  *
- * @param	None
+ * @param	Flags: With XFPGA_PARTIAL_EN the PL is not reset.
  *
  * @return	error status based on implemented functionality (SUCCESS by default)
  *
  *****************************************************************************/
-static u32 XFpga_PcapInit(void) {
+static u32 XFpga_PcapInit(u32 Flags) {
 	u32 RegVal;
 	u32 PollCount;
 	u32 Status = XFPGA_SUCCESS;
@@ -200,6 +407,11 @@ static u32 XFpga_PcapInit(void) {
 	Xil_Out32(CSU_PCAP_CTRL, RegVal);
 	Xil_Out32(CSU_PCAP_RDWR, 0x0);
 
+	/* Partial reconfiguration must keep the running PL configured */
+	if ((Flags & XFPGA_PARTIAL_EN) != 0U) {
+		goto DMA_INIT;
+	}
+
 	/* Reset PL */
 	Xil_Out32(CSU_PCAP_PROG, 0x0U);
 
@@ -218,8 +430,9 @@ static u32 XFpga_PcapInit(void) {
 			break;
 		PollCount--;
 	}
+
+DMA_INIT:
 	Status = XFpga_CsuDmaInit();
-END:
 	return Status;
 }
 /*****************************************************************************/
@@ -247,44 +460,94 @@ static u32 XFpga_PcapWaitForDone() {
 }
 
 /*****************************************************************************/
-/** This is the function to write data to PCAP interface
+/** This function checks that a buffer can be given to the CSU DMA source
+ * channel, which needs a word aligned address and at most XCSUDMA_SIZE_MAX
+ * words. XCsuDma_Transfer only asserts this and the preloaded path does not
+ * go through it at all.
+ *
+ * @param       WrAddr: Linear memory space of the buffer
+ *
+ * @param	WrSize: Number of 32bit words of the buffer
+ *
+ * @return	XFPGA_SUCCESS or XFPGA_ERROR_BITSTREAM_ALIGN
+ *
+ *****************************************************************************/
+static u32 XFpga_CsuDmaSrcCheck(u64 WrAddr, u32 WrSize) {
+	u32 Status = XFPGA_SUCCESS;
+
+	if ((((u32)WrAddr & XCSUDMA_ADDR_LSB_MASK) != 0U) ||
+			(WrSize > (u32)XCSUDMA_SIZE_MAX)) {
+		xil_printf("XFPGA_ERROR_BITSTREAM_ALIGN\r\n");
+		Status = XFPGA_ERROR_BITSTREAM_ALIGN;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/** This is the function to start the CSU DMA source channel towards the PCAP
+ * interface
+ *
+ * @param       WrAddr: Linear memory space from where CSUDMA will read the
+ *              data to be written to PCAP interface
  *
  * @param	WrSize: Number of 32bit words that the DMA should write to
  *         	the PCAP interface
  *
- * @param       WrAddrHigh: Higher 32-bit Linear memory space from where CSUDMA
- *              will read the data to be written to PCAP interfacae
- *
- * @param       WrAddrLow: Lower 32-bit Linear memory space from where CSUDMA
- *              will read the data to be written to PCAP interface
+ * @param	Flags: With XFPGA_PRELOADED_EN the data cache is not flushed,
+ *		XFpga_PL_Preload has already done it.
  *
  * @return	None
  *
  *****************************************************************************/
-static u32 XFpga_WriteToPcap(u32 WrSize, u32 WrAddrHigh, u32 WrAddrLow) {
-	u32 RegVal;
-	u32 Status = XFPGA_SUCCESS;
-	u64 WrAddr;
+static void XFpga_CsuDmaSrcStart(u64 WrAddr, u32 WrSize, u32 Flags) {
 
-	WrAddr = ((u64)WrAddrHigh << 32)|WrAddrLow;
-	/*
-	 * Setup the  SSS, setup the PCAP to receive from DMA source
-	 */
-	RegVal = Xil_In32(CSU_CSU_SSS_CFG) & CSU_CSU_SSS_CFG_PCAP_SSS_MASK;
-	RegVal = RegVal
-			| (XFPGA_CSU_SSS_SRC_SRC_DMA << CSU_CSU_SSS_CFG_PCAP_SSS_SHIFT);
-	Xil_Out32(CSU_CSU_SSS_CFG, RegVal);
+	if ((Flags & XFPGA_PRELOADED_EN) == 0U) {
+		/* Setup the source DMA channel */
+		XCsuDma_Transfer(&CsuDma, XCSUDMA_SRC_CHANNEL, WrAddr,
+					WrSize, 0);
+		return;
+	}
 
-	/* Setup the source DMA channel */
-	XCsuDma_Transfer(&CsuDma, XCSUDMA_SRC_CHANNEL, WrAddr, WrSize, 0);
+	/* Same as XCsuDma_Transfer without the cache flush */
+	XCsuDma_WriteReg(CsuDma.Config.BaseAddress, XCSUDMA_ADDR_OFFSET,
+			((u32)WrAddr & XCSUDMA_ADDR_MASK));
+	XCsuDma_WriteReg(CsuDma.Config.BaseAddress, XCSUDMA_ADDR_MSB_OFFSET,
+			((u32)(WrAddr >> XCSUDMA_MSB_ADDR_SHIFT) &
+					XCSUDMA_MSB_ADDR_MASK));
+	XCsuDma_WriteReg(CsuDma.Config.BaseAddress, XCSUDMA_SIZE_OFFSET,
+			(WrSize << XCSUDMA_SIZE_SHIFT));
+}
 
-	/* wait for the SRC_DMA to complete and the pcap to be IDLE */
-	XCsuDma_WaitForDone(&CsuDma, XCSUDMA_SRC_CHANNEL);
+/*****************************************************************************/
+/** This is the function to wait for the CSU DMA source channel transfer
+ * started by XFpga_CsuDmaSrcStart to complete or to fail
+ *
+ * @param	None
+ *
+ * @return	XFPGA_SUCCESS or XFPGA_ERROR_CSUDMA_XFER_FAIL if the channel
+ *		reported an AXI, APB or time out error
+ *
+ *****************************************************************************/
+static u32 XFpga_CsuDmaSrcWait(void) {
+	u32 Status = XFPGA_SUCCESS;
+	u32 RegVal;
 
-	/* Acknowledge the transfer has completed */
-	XCsuDma_IntrClear(&CsuDma, XCSUDMA_SRC_CHANNEL, XCSUDMA_IXR_DONE_MASK);
+	/* wait for the SRC_DMA to complete or to report an error */
+	do {
+		RegVal = XCsuDma_IntrGetStatus(&CsuDma, XCSUDMA_SRC_CHANNEL);
+	} while ((RegVal & (XCSUDMA_IXR_DONE_MASK |
+				XFPGA_CSUDMA_SRC_ERR_MASK)) == 0U);
 
-	Status = XFpga_PcapWaitForDone();
+	if ((RegVal & XFPGA_CSUDMA_SRC_ERR_MASK) != 0U) {
+		xil_printf("XFPGA_ERROR_CSUDMA_XFER_FAIL\r\n");
+		Status = XFPGA_ERROR_CSUDMA_XFER_FAIL;
+	}
+
+	/* Acknowledge the transfer has completed */
+	XCsuDma_IntrClear(&CsuDma, XCSUDMA_SRC_CHANNEL,
+			RegVal & (XCSUDMA_IXR_DONE_MASK |
+				XFPGA_CSUDMA_SRC_ERR_MASK));
 
 	return Status;
 }
@@ -353,6 +616,11 @@ static u32 XFpga_CsuDmaInit()
 	u32 Status = XFPGA_SUCCESS;
 	XCsuDma_Config * CsuDmaConfig;
 
+	/* Configuration does not change between loads */
+	if (CsuDmaReady == TRUE) {
+		goto END;
+	}
+
 	CsuDmaConfig = XCsuDma_LookupConfig(0);
 	if (NULL == CsuDmaConfig) {
 		Status = XFPGA_ERROR_CSUDMA_INIT_FAIL;
@@ -365,6 +633,7 @@ static u32 XFpga_CsuDmaInit()
 		Status = XFPGA_ERROR_CSUDMA_INIT_FAIL;
 		goto END;
 	}
+	CsuDmaReady = TRUE;
 END:
 	return Status;
 }
@@ -43,8 +43,9 @@
 * Features
 *	Supported:
 *		Full Bit-stream loading.
+*		Partial Bit-stream loading.
+*		Bit-stream loading in chunks (streaming).
 *	To be supported features:
-* 		Partial Bit-stream loading.
 *		Encrypted Bit-stream loading.
 *		Authenticated Bit stream loading.
 *
@@ -70,7 +71,7 @@
 *       -xilfpga library is capable of loading only .bin format files into PL.
 *        it will not support the other file formates.
 *
-*       -The current implementation supports only Full Bit-stream.
+*       -The current implementation supports only non-secure Bit-streams.
 *
 * This is the header file which contains definitions for the PCAP hardware
 * registers and declarations of bitstream download functions
@@ -83,6 +84,19 @@
 *
 *   - u32 XFpga_PL_BitSream_Load ();
 *
+* A Bit-stream which is not completely in memory, e.g. read from a file
+* system or received from the network, can be written in chunks while the
+* PCAP consumes the previous chunk:
+*
+*   - u32 XFpga_PL_StreamStart ();
+*   - u32 XFpga_PL_StreamWrite (); for each chunk
+*   - u32 XFpga_PL_StreamFinish ();
+*
+* Partial Bit-streams (XFPGA_PARTIAL_EN) skip the PL power-up, isolation,
+* PROG_B and fabric reset steps. Partial Bit-streams kept in DDR for region
+* swaps can be prepared once with XFpga_PL_Preload () and then loaded with
+* XFPGA_PRELOADED_EN, which also skips the data cache flush.
+*
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -90,6 +104,8 @@
 * Ver   Who  Date        Changes
 * ----- ---- -------- -------------------------------------------------------
 * 1.0   Nava   08/06/16 Initial release
+* 1.2   esd    18/10/26 Added streaming, partial and preloaded Bit-stream
+*                       loading APIs.
 *
 * </pre>
 *
@@ -173,6 +189,14 @@
 #define XFPGA_ERROR_BITSTREAM_LOAD_FAIL		(0x2U)
 #define XFPGA_ERROR_PL_POWER_UP			(0x3U)
 #define XFPGA_ERROR_PL_ISOLATION		(0x4U)
+#define XFPGA_ERROR_STREAM_STATE		(0x5U)
+#define XFPGA_ERROR_BITSTREAM_ALIGN		(0x6U)
+#define XFPGA_ERROR_CSUDMA_XFER_FAIL		(0x7U)
+
+/* flags of XFpga_PL_BitSream_Load and XFpga_PL_StreamStart */
+#define XFPGA_FULLBIT_EN			(0x0U)
+#define XFPGA_PARTIAL_EN			(0x1U)
+#define XFPGA_PRELOADED_EN			(0x8U)
 
 /**************************** Type Definitions *******************************/
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -180,6 +204,10 @@
 /************************** Function Prototypes ******************************/
 u32 XFpga_PL_BitSream_Load (u32 WrAddrHigh, u32 WrAddrLow,
 				u32 WrSize, u32 flags);
+u32 XFpga_PL_StreamStart(u32 Flags);
+u32 XFpga_PL_StreamWrite(u32 WrAddrHigh, u32 WrAddrLow, u32 WrSize);
+u32 XFpga_PL_StreamFinish(void);
+u32 XFpga_PL_Preload(u32 WrAddrHigh, u32 WrAddrLow, u32 WrSize);
 u32 XFpga_PcapStatus(void);
 /************************** Variable Definitions *****************************/
 
@@ -0,0 +1,130 @@
+###############################################################################
+#
+# Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# Use of the Software is limited solely to applications:
+# (a) running on a Xilinx device, or
+# (b) that interact with a Xilinx device through a bus or interconnect.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+# OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Except as contained in this notice, the name of the Xilinx shall not be used
+# in advertising or otherwise to promote the sale, use or other dealings in
+# this Software without prior written authorization from Xilinx.
+#
+###############################################################################
+#
+# Modification History
+#
+# Ver   Who   Date     Changes
+# ----- ----  -------  -----------------------------------------------
+# 1.0   esd   10/18/26 First release
+#
+##############################################################################
+
+#---------------------------------------------
+# nandftl_drc - check that a NAND controller
+# the library can run on is present
+#---------------------------------------------
+
+proc nandftl_drc {libhandle} {
+
+	set sw_processor [hsi::get_sw_processor]
+	set processor [hsi::get_cells -hier [common::get_property HW_INSTANCE $sw_processor]]
+	set periphs_list [hsi::utils::get_proc_slave_periphs $processor]
+	set nand_found 0
+
+	foreach periph $periphs_list {
+		set periphname [common::get_property IP_NAME $periph]
+		if {$periphname == "ps7_nand" || $periphname == "psu_nand"} {
+			set nand_found 1
+		}
+	}
+
+	if { $nand_found == 0 } {
+		puts "WARNING : No NAND controller is available for XilNandFtl \n"
+	}
+}
+
+proc generate {libhandle} {
+
+}
+
+#-------
+# post_generate: called after generate called on all libraries
+#-------
+proc post_generate {libhandle} {
+	xgen_opts_file $libhandle
+}
+
+#-------
+# execs_generate: called after BSP's, libraries and drivers have been compiled
+#-------
+proc execs_generate {libhandle} {
+
+}
+
+proc xgen_opts_file {libhandle} {
+
+	# Open xparameters.h file
+	set file_handle [hsi::utils::open_include_file "xparameters.h"]
+
+	puts $file_handle "/* Xilinx NAND Flash Translation Layer Library (XilNandFtl) User Settings */"
+	set max_page_size [common::get_property CONFIG.max_page_size $libhandle]
+	set max_blocks [common::get_property CONFIG.max_blocks $libhandle]
+	set map_cache_size [common::get_property CONFIG.map_cache_size $libhandle]
+	set overprovision [common::get_property CONFIG.overprovision $libhandle]
+	set start_block [common::get_property CONFIG.start_block $libhandle]
+	set num_blocks [common::get_property CONFIG.num_blocks $libhandle]
+
+	if {$map_cache_size < [expr 2 * $max_page_size]} {
+		puts "WARNING : XilNandFtl map cache is smaller than two pages,\
+				setting it to [expr 2 * $max_page_size] bytes\n"
+		set map_cache_size [expr 2 * $max_page_size]
+	}
+	if {$overprovision < 1 || $overprovision > 50} {
+		error "ERROR: XilNandFtl overprovision must be between 1 and 50 percent \n"
+	}
+
+	puts $file_handle "\#define XNANDFTL_MAX_PAGE_SIZE ${max_page_size}U"
+	puts $file_handle "\#define XNANDFTL_MAX_BLOCKS ${max_blocks}U"
+	puts $file_handle "\#define XNANDFTL_MAP_CACHE_SIZE ${map_cache_size}U"
+	puts $file_handle "\#define XNANDFTL_OVERPROVISION ${overprovision}U"
+	puts $file_handle "\#define XNANDFTL_START_BLOCK ${start_block}U"
+	puts $file_handle "\#define XNANDFTL_NUM_BLOCKS ${num_blocks}U"
+
+	close $file_handle
+
+	# Copy the include files to the include directory
+	set srcdir [file join src include]
+	set dstdir [file join .. .. include]
+
+	# Create dstdir if it does not exist
+	if { ! [file exists $dstdir] } {
+		file mkdir $dstdir
+	}
+
+	# Get list of files in the srcdir
+	set sources [glob -join $srcdir *.h]
+
+	# Copy each of the files in the list to dstdir
+	foreach source $sources {
+		file copy -force $source $dstdir
+	}
+}
@@ -0,0 +1,276 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilnandftl_example.c
+*
+* This example mounts an FTL partition on the NAND flash, formatting it if
+* it has never been used, writes a pattern over a range of sectors with a mix
+* of page aligned and unaligned requests, syncs, and reads the range back to
+* verify it. It then prints the FTL statistics.
+*
+* The example uses the ZynqMP NAND controller (nandpsu) when it is present
+* and the Zynq SMC NAND controller (nandps) otherwise.
+*
+* @note	The example writes to the whole FTL partition range given by
+*	TEST_SECTOR and TEST_SECTORS; any file system on it is lost.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 1.0   esd  10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_printf.h"
+#include "xil_cache.h"
+#include "xilnandftl.h"
+
+/************************** Constant Definitions *****************************/
+
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+#define NAND_DEVICE_ID		XPAR_XNANDPSU_0_DEVICE_ID
+#else
+#define NAND_DEVICE_ID		XPAR_XNANDPS_0_DEVICE_ID
+#endif
+
+#define TEST_SECTOR		100U	/* First sector written */
+#define TEST_SECTORS		256U	/* Sectors written and verified */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+s32 NandFtlExample(u16 DeviceId);
+static s32 NandInit(u16 DeviceId, XNandFtl_Config *ConfigPtr);
+
+/************************** Variable Definitions *****************************/
+
+static XNandFtl Ftl;
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+static XNandPsu Nand;
+#else
+static XNandPs Nand;
+#endif
+
+static u8 WriteBuffer[TEST_SECTORS * XNANDFTL_SECTOR_SIZE]
+					__attribute__ ((aligned(64)));
+static u8 ReadBuffer[TEST_SECTORS * XNANDFTL_SECTOR_SIZE]
+					__attribute__ ((aligned(64)));
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the NAND FTL example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	s32 Status;
+
+	xil_printf("NAND FTL Example Test\r\n");
+
+	Status = NandFtlExample(NAND_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf("NAND FTL Example Test Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran NAND FTL Example Test\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the NAND driver and fills in the FTL configuration for it.
+*
+* @param	DeviceId is the device ID of the NAND controller.
+* @param	ConfigPtr is the FTL configuration to fill in.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 NandInit(u16 DeviceId, XNandFtl_Config *ConfigPtr)
+{
+	s32 Status;
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+	XNandPsu_Config *NandConfig;
+
+	NandConfig = XNandPsu_LookupConfig(DeviceId);
+	if (NandConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XNandPsu_CfgInitialize(&Nand, NandConfig,
+			NandConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XNandPsu_EnableDmaMode(&Nand);
+
+	Status = XNandFtl_NandPsuConfig(ConfigPtr, &Nand);
+#else
+	XNandPs_Config *NandConfig;
+
+	NandConfig = XNandPs_LookupConfig(DeviceId);
+	if (NandConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XNandPs_CfgInitialize(&Nand, NandConfig,
+			NandConfig->SmcBase, NandConfig->FlashBase);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XNandFtl_NandPsConfig(ConfigPtr, &Nand);
+#endif
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Mounts (or formats) the FTL partition, writes TEST_SECTORS sectors in
+* requests of varying size, syncs, remounts and verifies the data.
+*
+* @param	DeviceId is the device ID of the NAND controller.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+s32 NandFtlExample(u16 DeviceId)
+{
+	XNandFtl_Config Config;
+	XNandFtl_Stats Stats;
+	s32 Status;
+	u32 Index;
+	u32 Done;
+	u32 Count;
+
+	Status = NandInit(DeviceId, &Config);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XNandFtl_CfgInitialize(&Ftl, &Config);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XNandFtl_Mount(&Ftl);
+	if (Status == XST_NO_DATA) {
+		xil_printf("Formatting FTL partition\r\n");
+		Status = XNandFtl_Format(&Ftl);
+	}
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (XNandFtl_GetSectorCount(&Ftl) < (TEST_SECTOR + TEST_SECTORS)) {
+		return XST_FAILURE;
+	}
+
+	for (Index = 0U; Index < sizeof(WriteBuffer); Index++) {
+		WriteBuffer[Index] = (u8)(Index + (Index >> 9));
+		ReadBuffer[Index] = 0U;
+	}
+
+	/*
+	 * Write in requests of 1, 2, 3 ... sectors so that both partial
+	 * pages, which go through the write buffer, and whole pages are
+	 * exercised.
+	 */
+	Done = 0U;
+	Count = 1U;
+	while (Done < TEST_SECTORS) {
+		if (Count > (TEST_SECTORS - Done)) {
+			Count = TEST_SECTORS - Done;
+		}
+		Status = XNandFtl_Write(&Ftl, TEST_SECTOR + Done, Count,
+				&WriteBuffer[Done * XNANDFTL_SECTOR_SIZE]);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Done += Count;
+		Count++;
+	}
+
+	/*
+	 * Unmount writes a checkpoint; the second mount then reads the
+	 * data back from flash rather than from the write buffer.
+	 */
+	Status = XNandFtl_Unmount(&Ftl);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XNandFtl_Mount(&Ftl);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XNandFtl_Read(&Ftl, TEST_SECTOR, TEST_SECTORS, ReadBuffer);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	for (Index = 0U; Index < sizeof(ReadBuffer); Index++) {
+		if (ReadBuffer[Index] != WriteBuffer[Index]) {
+			return XST_FAILURE;
+		}
+	}
+
+	XNandFtl_GetStats(&Ftl, &Stats);
+	xil_printf("Host pages %d, flash pages %d, map pages %d\r\n",
+			Stats.HostPages, Stats.FlashPages, Stats.MapPages);
+	xil_printf("GC runs %d, erases %d, bad blocks %d\r\n",
+			Stats.GcRuns, Stats.Erases, Stats.BadBlocks);
+
+	return XNandFtl_Unmount(&Ftl);
+}
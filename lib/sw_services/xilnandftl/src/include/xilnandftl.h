@@ -0,0 +1,376 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilnandftl.h
+*
+* This is the header file for the Xilinx NAND flash translation layer library
+* (XilNandFtl). It presents a raw NAND partition driven by the nandps (Zynq
+* SMC) or nandpsu (ZynqMP) driver as an array of 512 byte sectors, so that a
+* file system such as xilffs can be mounted on it.
+*
+* <b>Layout</b>
+*
+* The FTL is log structured: every page write, whether host data, a page of
+* the logical to physical map or a checkpoint, is appended at the write
+* frontier with a tag in the spare area carrying the logical page, a
+* monotonically increasing sequence number and the erase count of the block.
+* Pages are never rewritten in place; the previous copy just becomes stale
+* and is reclaimed by garbage collection.
+*
+* The logical to physical map has one 32 bit entry per logical page and is
+* itself stored in the log, one flash page ("chunk") at a time. Only
+* XNANDFTL_MAP_CACHE_SIZE bytes worth of chunks are held in RAM, in an LRU
+* cache; the RAM resident directory just records where the latest copy of
+* every chunk lives. RAM usage therefore scales with the number of chunks,
+* not with the size of the device.
+*
+* A checkpoint (the chunk directory and the erase count of every block) is
+* written by XNandFtl_Sync() once enough pages have been written since the
+* previous one. XNandFtl_Mount() loads the newest complete checkpoint and
+* replays the tags written after it, so mount time is bounded by the
+* checkpoint interval and not by the size of the device.
+*
+* <b>Write path</b>
+*
+* Sector writes are coalesced in a one page write buffer and only reach the
+* flash once the page is complete, when a different page is written or on
+* XNandFtl_Sync(). Whole page aligned writes bypass the buffer. Each host page
+* therefore costs one page program plus, amortised, a map chunk update.
+*
+* <b>Garbage collection and wear leveling</b>
+*
+* Victims are picked greedily (fewest valid pages) and their live pages are
+* moved in logical order, so that each map chunk is updated once per victim. When the spread between
+* the most and least worn blocks exceeds XNANDFTL_WL_THRESHOLD the least worn
+* used block is collected instead, so that cold data moves onto worn blocks.
+* Free blocks are handed out lowest erase count first. XNandFtl_Background()
+* performs one collection step when the free pool is below
+* XNANDFTL_GC_BG_BLOCKS and should be called from the application idle loop
+* (or a low priority task) so that host writes rarely have to collect in the
+* foreground; foreground collection only kicks in when the pool drops to the
+* XNANDFTL_GC_RESERVE blocks kept for collection itself.
+*
+* <b>Bad blocks</b>
+*
+* Blocks the driver's bad block table reports as bad are skipped. A block
+* whose erase fails is marked bad immediately; a block whose program fails is
+* retired: the write is retried on a fresh block and the failing block is
+* marked bad once garbage collection has moved its valid pages out.
+*
+* <b>Usage</b>
+*
+* <pre>
+*	XNandFtl_Config Config;
+*
+*	XNandPsu_CfgInitialize(&Nand, ...);
+*	XNandFtl_NandPsuConfig(&Config, &Nand);
+*	Config.StartBlock = 64U;	(optional, keep boot images out)
+*	XNandFtl_CfgInitialize(&Ftl, &Config);
+*	if (XNandFtl_Mount(&Ftl) == XST_NO_DATA) {
+*		XNandFtl_Format(&Ftl);
+*	}
+*	...
+*	XNandFtl_Write(&Ftl, Sector, Count, Buf);
+*	XNandFtl_Sync(&Ftl);
+* </pre>
+*
+* The partition must not overlap the blocks holding the driver's bad block
+* tables; the XNandFtl_NandPsConfig() and XNandFtl_NandPsuConfig() defaults
+* already stop short of them.
+*
+* The library is not thread safe. Under an RTOS all calls for one instance,
+* including XNandFtl_Background(), must be serialised by the caller.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 1.0   esd  10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XILNANDFTL_H		/* prevent circular inclusions */
+#define XILNANDFTL_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xparameters.h"
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+#include "xnandpsu.h"
+#include "xnandpsu_bbm.h"
+#endif
+#ifdef XPAR_XNANDPS_NUM_INSTANCES
+#include "xnandps.h"
+#include "xnandps_bbm.h"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+/**
+ * Build time limits. The defaults cover every device the nandps and nandpsu
+ * drivers support; they can be lowered from the BSP settings to save RAM.
+ */
+#ifndef XNANDFTL_MAX_PAGE_SIZE
+#define XNANDFTL_MAX_PAGE_SIZE		16384U	/**< Largest page size */
+#endif
+#ifndef XNANDFTL_MAX_BLOCKS
+#define XNANDFTL_MAX_BLOCKS		16384U	/**< Largest partition */
+#endif
+#ifndef XNANDFTL_MAX_CHUNKS
+#define XNANDFTL_MAX_CHUNKS		4096U	/**< Largest map in chunks */
+#endif
+#ifndef XNANDFTL_MAX_BLOCK_PAGES
+#define XNANDFTL_MAX_BLOCK_PAGES	1024U	/**< Most pages per block */
+#endif
+#ifndef XNANDFTL_MAP_CACHE_SIZE
+#define XNANDFTL_MAP_CACHE_SIZE		65536U	/**< Bytes of RAM for cached
+						  map chunks, at least two
+						  pages */
+#endif
+#ifndef XNANDFTL_OVERPROVISION
+#define XNANDFTL_OVERPROVISION		10U	/**< Percent of the partition
+						  not exported to the host */
+#endif
+
+#define XNANDFTL_SECTOR_SIZE		512U	/**< Host sector size */
+
+#define XNANDFTL_MAX_SLOTS		(XNANDFTL_MAP_CACHE_SIZE /	\
+					XNANDFTL_SECTOR_SIZE)
+						/**< Map cache slots for the
+						  smallest page size */
+
+#define XNANDFTL_GC_RESERVE		3U	/**< Free blocks kept for
+						  garbage collection */
+#define XNANDFTL_GC_BG_BLOCKS		8U	/**< Background collection
+						  works below this many
+						  free blocks */
+#define XNANDFTL_WL_THRESHOLD		64U	/**< Erase count spread that
+						  triggers static wear
+						  leveling */
+#define XNANDFTL_CKPT_INTERVAL		4U	/**< Blocks written between
+						  checkpoints */
+
+/** @name Spare area tag types
+ * @{
+ */
+#define XNANDFTL_TAG_DATA		0x0001U	/**< Host data page */
+#define XNANDFTL_TAG_MAP		0x0002U	/**< Map chunk page */
+#define XNANDFTL_TAG_CKPT		0x0003U	/**< Checkpoint page */
+/* @} */
+
+#define XNANDFTL_TAG_SIZE		16U	/**< Bytes of spare area used */
+
+#define XNANDFTL_UNMAPPED		0xFFFFFFFFU	/**< No physical page */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Tag stored in the spare area of every page the FTL writes. A tag that
+ * reads back as all 0xFF belongs to a page that has not been programmed.
+ */
+typedef struct {
+	u32 Lpn;		/**< Logical page, map chunk or checkpoint
+				  part, depending on Type */
+	u32 Seq;		/**< Write sequence number */
+	u32 EraseCount;		/**< Erase count of the block */
+	u16 Type;		/**< XNANDFTL_TAG_* */
+	u16 Check;		/**< Folded checksum of the fields above */
+} XNandFtl_Tag;
+
+/**
+ * Flash operations the FTL needs from the NAND driver. Page and block numbers
+ * are absolute device numbers. All functions return XST_SUCCESS on success,
+ * except IsBlockBad which follows the driver convention of returning
+ * XST_SUCCESS when the block is bad.
+ */
+typedef struct {
+	s32 (*ReadPage)(void *DevPtr, u32 Page, u8 *Buf);
+	s32 (*ReadTag)(void *DevPtr, u32 Page, XNandFtl_Tag *Tag);
+	s32 (*ProgramPage)(void *DevPtr, u32 Page, const u8 *Buf,
+				const XNandFtl_Tag *Tag);
+	s32 (*EraseBlock)(void *DevPtr, u32 Block);
+	s32 (*IsBlockBad)(void *DevPtr, u32 Block);
+	s32 (*MarkBlockBad)(void *DevPtr, u32 Block);
+} XNandFtl_Ops;
+
+/**
+ * FTL partition configuration, normally filled in by XNandFtl_NandPsConfig()
+ * or XNandFtl_NandPsuConfig().
+ */
+typedef struct {
+	const XNandFtl_Ops *Ops;	/**< Driver operations */
+	void *DevPtr;			/**< Driver instance */
+	u32 BytesPerPage;		/**< Page size */
+	u32 PagesPerBlock;		/**< Pages per erase block */
+	u32 StartBlock;			/**< First block of the partition */
+	u32 NumBlocks;			/**< Blocks in the partition */
+	u32 Overprovision;		/**< Percent of the partition kept
+					  back from the host */
+} XNandFtl_Config;
+
+/**
+ * Per block bookkeeping.
+ */
+typedef struct {
+	u32 Seq;		/**< Sequence number of the first page */
+	u32 EraseCount;		/**< Number of erase cycles */
+	u16 Valid;		/**< Live data and map pages */
+	u8 State;		/**< XNANDFTL_BLOCK_* */
+	u8 Flags;		/**< XNANDFTL_BLOCK_CLEAN / _RETIRE */
+} XNandFtl_BlockInfo;
+
+/**
+ * One cached chunk of the logical to physical map.
+ */
+typedef struct {
+	u32 *Entry;		/**< Chunk contents, one page long */
+	u32 Chunk;		/**< Cached chunk, XNANDFTL_UNMAPPED if
+				  the slot is empty */
+	u32 Dirty;		/**< Slot differs from the flash copy */
+	u32 LastUse;		/**< LRU stamp */
+} XNandFtl_MapSlot;
+
+/**
+ * Statistics, cleared by XNandFtl_CfgInitialize().
+ */
+typedef struct {
+	u32 HostPages;		/**< Pages written on behalf of the host */
+	u32 FlashPages;		/**< Pages programmed, all causes */
+	u32 MapPages;		/**< Map chunk pages programmed */
+	u32 GcRuns;		/**< Blocks collected */
+	u32 GcCopies;		/**< Pages copied by collection */
+	u32 WlRuns;		/**< Collections for wear leveling */
+	u32 Erases;		/**< Blocks erased */
+	u32 BadBlocks;		/**< Blocks retired at run time */
+} XNandFtl_Stats;
+
+/**
+ * The XNandFtl instance. The user allocates one per partition; it is large
+ * (the map cache and the block table) and is best placed statically.
+ */
+typedef struct {
+	XNandFtl_Config Config;		/**< Partition configuration */
+	u32 IsReady;			/**< Mounted or formatted */
+	u32 SectorsPerPage;
+	u32 EntriesPerChunk;		/**< Map entries per chunk */
+	u32 LogicalPages;		/**< Pages exported to the host */
+	u32 NumChunks;			/**< Chunks in the map */
+	u32 CkptPages;			/**< Pages per checkpoint */
+	u32 Seq;			/**< Next write sequence number */
+	u32 CkptBlock;			/**< Block of the latest checkpoint */
+	u32 PagesSinceCkpt;
+	u32 OpenBlock;			/**< Write frontier block */
+	u32 OpenPage;			/**< Next page in OpenBlock */
+	u32 FreeBlocks;
+	u32 InGc;			/**< Collection in progress */
+	u32 NumSlots;			/**< Map cache slots in use */
+	u32 UseClock;			/**< LRU clock of the map cache */
+	u32 WbLpn;			/**< Page held in the write buffer */
+	u32 WbValid;			/**< Sectors present, one bit each */
+	XNandFtl_Stats Stats;
+	XNandFtl_BlockInfo Block[XNANDFTL_MAX_BLOCKS];
+	u32 Gmd[XNANDFTL_MAX_CHUNKS];	/**< Physical page of every chunk */
+	XNandFtl_MapSlot Slot[XNANDFTL_MAX_SLOTS];
+	u32 MapCache[XNANDFTL_MAP_CACHE_SIZE / 4U]
+				__attribute__ ((aligned(64)));
+					/**< Storage for the slots */
+	u8 WbData[XNANDFTL_MAX_PAGE_SIZE] __attribute__ ((aligned(64)));
+					/**< Write coalescing buffer */
+	u8 PageBuf[XNANDFTL_MAX_PAGE_SIZE] __attribute__ ((aligned(64)));
+					/**< Scratch page */
+} XNandFtl;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*****************************************************************************/
+/**
+*
+* Returns the number of sectors exported by the FTL.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return	Sector count.
+*
+******************************************************************************/
+#define XNandFtl_GetSectorCount(InstancePtr)				\
+	((InstancePtr)->LogicalPages * (InstancePtr)->SectorsPerPage)
+
+/*****************************************************************************/
+/**
+*
+* Returns the erase block size in sectors.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return	Sectors per erase block.
+*
+******************************************************************************/
+#define XNandFtl_GetBlockSectors(InstancePtr)				\
+	((InstancePtr)->Config.PagesPerBlock * (InstancePtr)->SectorsPerPage)
+
+/************************** Function Prototypes ******************************/
+
+s32 XNandFtl_CfgInitialize(XNandFtl *InstancePtr,
+				const XNandFtl_Config *ConfigPtr);
+s32 XNandFtl_Format(XNandFtl *InstancePtr);
+s32 XNandFtl_Mount(XNandFtl *InstancePtr);
+s32 XNandFtl_Read(XNandFtl *InstancePtr, u32 Sector, u32 Count, u8 *Buf);
+s32 XNandFtl_Write(XNandFtl *InstancePtr, u32 Sector, u32 Count,
+				const u8 *Buf);
+s32 XNandFtl_Sync(XNandFtl *InstancePtr);
+s32 XNandFtl_Unmount(XNandFtl *InstancePtr);
+s32 XNandFtl_Background(XNandFtl *InstancePtr);
+void XNandFtl_GetStats(XNandFtl *InstancePtr, XNandFtl_Stats *StatsPtr);
+
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+s32 XNandFtl_NandPsuConfig(XNandFtl_Config *ConfigPtr, XNandPsu *NandPtr);
+#endif
+#ifdef XPAR_XNANDPS_NUM_INSTANCES
+s32 XNandFtl_NandPsConfig(XNandFtl_Config *ConfigPtr, XNandPs *NandPtr);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XILNANDFTL_H */
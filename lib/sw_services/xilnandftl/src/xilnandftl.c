@@ -0,0 +1,2106 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilnandftl.c
+*
+* This file contains the log structured flash translation layer: the write
+* frontier, the chunked map cache, checkpoints, mount time replay, garbage
+* collection and wear leveling. The NAND drivers are reached through the
+* XNandFtl_Ops table only; see xilnandftl_nand.c for the nandps and nandpsu
+* bindings.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 1.0   esd  10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include "xilnandftl.h"
+#include "xil_assert.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XNANDFTL_BLOCK_FREE		0U	/**< Erased or erasable */
+#define XNANDFTL_BLOCK_OPEN		1U	/**< Write frontier */
+#define XNANDFTL_BLOCK_USED		2U	/**< Written, collectable */
+#define XNANDFTL_BLOCK_BAD		3U	/**< Never used */
+
+#define XNANDFTL_BLOCK_CLEAN		0x01U	/**< Erased, not programmed */
+#define XNANDFTL_BLOCK_RETIRE		0x02U	/**< Program failed, mark bad
+						  once collected */
+
+#define XNANDFTL_NO_BLOCK		0xFFFFFFFFU
+
+#define XNANDFTL_CKPT_MAGIC		0x4C54464EU	/**< "NFTL" */
+#define XNANDFTL_CKPT_VERSION		1U
+#define XNANDFTL_CKPT_HDR_WORDS		8U
+
+#define XNANDFTL_PROGRAM_RETRIES	4U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XNandFtl_PpnBlock(InstancePtr, Ppn)				\
+	((Ppn) / (InstancePtr)->Config.PagesPerBlock)
+
+#define XNandFtl_DevPage(InstancePtr, Ppn)				\
+	(((InstancePtr)->Config.StartBlock *				\
+	(InstancePtr)->Config.PagesPerBlock) + (Ppn))
+
+/************************** Function Prototypes ******************************/
+
+static u16 XNandFtl_TagCheck(const XNandFtl_Tag *Tag);
+static u32 XNandFtl_TagIsErased(const XNandFtl_Tag *Tag);
+static u32 XNandFtl_TagIsValid(const XNandFtl_Tag *Tag);
+static s32 XNandFtl_ReadTag(XNandFtl *InstancePtr, u32 Ppn,
+				XNandFtl_Tag *Tag);
+static s32 XNandFtl_ReadPage(XNandFtl *InstancePtr, u32 Ppn, u8 *Buf);
+static void XNandFtl_RetireBlock(XNandFtl *InstancePtr, u32 Block);
+static s32 XNandFtl_OpenBlock(XNandFtl *InstancePtr);
+static void XNandFtl_CloseBlock(XNandFtl *InstancePtr);
+static s32 XNandFtl_ProgramPage(XNandFtl *InstancePtr, const u8 *Buf,
+				u16 Type, u32 Lpn, u32 *PpnPtr);
+static void XNandFtl_Validate(XNandFtl *InstancePtr, u32 Ppn);
+static void XNandFtl_Invalidate(XNandFtl *InstancePtr, u32 Ppn);
+static s32 XNandFtl_FlushSlot(XNandFtl *InstancePtr, XNandFtl_MapSlot *Slot);
+static s32 XNandFtl_FlushMap(XNandFtl *InstancePtr);
+static s32 XNandFtl_GetSlot(XNandFtl *InstancePtr, u32 Chunk,
+				XNandFtl_MapSlot **SlotPtr);
+static s32 XNandFtl_LookupMap(XNandFtl *InstancePtr, u32 Lpn, u32 *PpnPtr);
+static s32 XNandFtl_UpdateMap(XNandFtl *InstancePtr, u32 Lpn, u32 Ppn);
+static u32 XNandFtl_CkptWord(XNandFtl *InstancePtr, u32 Index);
+static s32 XNandFtl_WriteCheckpoint(XNandFtl *InstancePtr);
+static s32 XNandFtl_LoadCheckpoint(XNandFtl *InstancePtr, u32 FirstPpn);
+static u32 XNandFtl_PickVictim(XNandFtl *InstancePtr, u32 AllowWl,
+				u32 *IsWlPtr);
+static s32 XNandFtl_CollectBlock(XNandFtl *InstancePtr, u32 Victim);
+static s32 XNandFtl_EnsureFree(XNandFtl *InstancePtr);
+static s32 XNandFtl_WritePage(XNandFtl *InstancePtr, u32 Lpn, const u8 *Buf);
+static s32 XNandFtl_FlushWb(XNandFtl *InstancePtr);
+static void XNandFtl_ResetCache(XNandFtl *InstancePtr);
+static s32 XNandFtl_CheckCapacity(XNandFtl *InstancePtr);
+static s32 XNandFtl_Replay(XNandFtl *InstancePtr, u32 Block, u32 FirstPage,
+				u32 CkptSeq, u32 Pass);
+static s32 XNandFtl_CountValid(XNandFtl *InstancePtr);
+static int XNandFtl_SeqCompare(const void *A, const void *B);
+static int XNandFtl_LiveCompare(const void *A, const void *B);
+
+/************************** Variable Definitions *****************************/
+
+/*
+ * Block order used while mounting. Mount is not reentrant (see the note on
+ * thread safety in xilnandftl.h), so one table serves every instance.
+ */
+static u32 XNandFtl_Order[XNANDFTL_MAX_BLOCKS];
+static const XNandFtl_BlockInfo *XNandFtl_SortBlocks;
+
+/* Sequence number of the newest map page of every chunk, during mount */
+static u32 XNandFtl_MapSeq[XNANDFTL_MAX_CHUNKS];
+
+/* Live data pages of the block being collected, logical page : Ppn */
+static u64 XNandFtl_Live[XNANDFTL_MAX_BLOCK_PAGES];
+
+/*****************************************************************************/
+/**
+*
+* This function initializes an XNandFtl instance for the given partition. It
+* only validates the configuration and derives the logical geometry; the
+* flash is not accessed until XNandFtl_Mount() or XNandFtl_Format().
+*
+* The exported capacity is the partition less the over-provisioned share and
+* the pages needed by the map itself. It depends only on the configuration,
+* never on the number of bad blocks, so a volume keeps its size for life;
+* the over-provisioned share absorbs bad blocks and the collection reserve.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	ConfigPtr is a pointer to the partition configuration.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the geometry or partition is not
+*		supported with the build time limits in xilnandftl.h.
+*
+******************************************************************************/
+s32 XNandFtl_CfgInitialize(XNandFtl *InstancePtr,
+				const XNandFtl_Config *ConfigPtr)
+{
+	u32 Bpp;
+	u32 Ppb;
+	u64 RawPages;
+	u64 Usable;
+	u32 Index;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(ConfigPtr != NULL);
+	Xil_AssertNonvoid(ConfigPtr->Ops != NULL);
+
+	Bpp = ConfigPtr->BytesPerPage;
+	Ppb = ConfigPtr->PagesPerBlock;
+
+	if ((Bpp == 0U) || (Bpp > XNANDFTL_MAX_PAGE_SIZE) ||
+		((Bpp % XNANDFTL_SECTOR_SIZE) != 0U) ||
+		((Bpp / XNANDFTL_SECTOR_SIZE) > 32U) ||
+		(Ppb < 2U) || (Ppb > XNANDFTL_MAX_BLOCK_PAGES) ||
+		(XNANDFTL_MAP_CACHE_SIZE < (2U * Bpp)) ||
+		(ConfigPtr->NumBlocks > XNANDFTL_MAX_BLOCKS) ||
+		(ConfigPtr->NumBlocks <= (XNANDFTL_GC_RESERVE + 2U)) ||
+		(ConfigPtr->Overprovision == 0U) ||
+		(ConfigPtr->Overprovision >= 100U)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	(void)memset(InstancePtr, 0, sizeof(XNandFtl));
+	InstancePtr->Config = *ConfigPtr;
+	InstancePtr->SectorsPerPage = Bpp / XNANDFTL_SECTOR_SIZE;
+	InstancePtr->EntriesPerChunk = Bpp / 4U;
+	InstancePtr->NumSlots = XNANDFTL_MAP_CACHE_SIZE / Bpp;
+	for (Index = 0U; Index < InstancePtr->NumSlots; Index++) {
+		InstancePtr->Slot[Index].Entry = &InstancePtr->MapCache[
+				Index * InstancePtr->EntriesPerChunk];
+	}
+
+	/*
+	 * The spare share has to hold the collection reserve, the write
+	 * frontier and a block for a checkpoint that does not fit in the
+	 * frontier, on top of whatever goes bad.
+	 */
+	RawPages = (u64)ConfigPtr->NumBlocks * Ppb;
+	Usable = RawPages - ((RawPages * ConfigPtr->Overprovision) / 100U);
+	if ((RawPages - Usable) < ((u64)(XNANDFTL_GC_RESERVE + 2U) * Ppb)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	/* Map chunks live in the log too and come out of the usable pages */
+	InstancePtr->NumChunks = (u32)((Usable +
+			InstancePtr->EntriesPerChunk - 1U) /
+			InstancePtr->EntriesPerChunk);
+	InstancePtr->LogicalPages = (u32)Usable - InstancePtr->NumChunks;
+	InstancePtr->NumChunks = (InstancePtr->LogicalPages +
+			InstancePtr->EntriesPerChunk - 1U) /
+			InstancePtr->EntriesPerChunk;
+	if (InstancePtr->NumChunks > XNANDFTL_MAX_CHUNKS) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	InstancePtr->CkptPages = (((XNANDFTL_CKPT_HDR_WORDS +
+			InstancePtr->NumChunks + ConfigPtr->NumBlocks) * 4U) +
+			Bpp - 1U) / Bpp;
+	if (InstancePtr->CkptPages >= Ppb) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	for (Index = 0U; Index < XNANDFTL_MAX_CHUNKS; Index++) {
+		InstancePtr->Gmd[Index] = XNANDFTL_UNMAPPED;
+	}
+	XNandFtl_ResetCache(InstancePtr);
+	InstancePtr->OpenBlock = XNANDFTL_NO_BLOCK;
+	InstancePtr->CkptBlock = XNANDFTL_NO_BLOCK;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function erases every good block of the partition and writes an empty
+* map. All data in the partition is lost; erase counts found in the tags of
+* a previous FTL volume are carried over.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if too many blocks are bad or the checkpoint
+*		could not be written.
+*
+******************************************************************************/
+s32 XNandFtl_Format(XNandFtl *InstancePtr)
+{
+	const XNandFtl_Ops *Ops;
+	XNandFtl_BlockInfo *Info;
+	XNandFtl_Tag Tag;
+	u32 Block;
+	u32 Index;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->Config.Ops != NULL);
+
+	Ops = InstancePtr->Config.Ops;
+	InstancePtr->IsReady = 0U;
+	InstancePtr->FreeBlocks = 0U;
+
+	for (Block = 0U; Block < InstancePtr->Config.NumBlocks; Block++) {
+		Info = &InstancePtr->Block[Block];
+		(void)memset(Info, 0, sizeof(XNandFtl_BlockInfo));
+		if (Ops->IsBlockBad(InstancePtr->Config.DevPtr,
+			InstancePtr->Config.StartBlock + Block) == XST_SUCCESS) {
+			Info->State = XNANDFTL_BLOCK_BAD;
+			continue;
+		}
+
+		Status = XNandFtl_ReadTag(InstancePtr,
+				Block * InstancePtr->Config.PagesPerBlock, &Tag);
+		if ((Status == XST_SUCCESS) &&
+			(XNandFtl_TagIsValid(&Tag) != 0U)) {
+			Info->EraseCount = Tag.EraseCount;
+		}
+
+		Status = Ops->EraseBlock(InstancePtr->Config.DevPtr,
+				InstancePtr->Config.StartBlock + Block);
+		InstancePtr->Stats.Erases++;
+		if (Status != XST_SUCCESS) {
+			(void)Ops->MarkBlockBad(InstancePtr->Config.DevPtr,
+				InstancePtr->Config.StartBlock + Block);
+			Info->State = XNANDFTL_BLOCK_BAD;
+			InstancePtr->Stats.BadBlocks++;
+			continue;
+		}
+		Info->EraseCount++;
+		Info->State = XNANDFTL_BLOCK_FREE;
+		Info->Flags = XNANDFTL_BLOCK_CLEAN;
+		InstancePtr->FreeBlocks++;
+	}
+
+	Status = XNandFtl_CheckCapacity(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	for (Index = 0U; Index < InstancePtr->NumChunks; Index++) {
+		InstancePtr->Gmd[Index] = XNANDFTL_UNMAPPED;
+	}
+	XNandFtl_ResetCache(InstancePtr);
+	InstancePtr->OpenBlock = XNANDFTL_NO_BLOCK;
+	InstancePtr->CkptBlock = XNANDFTL_NO_BLOCK;
+	InstancePtr->Seq = 1U;
+
+	Status = XNandFtl_WriteCheckpoint(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function mounts a volume previously created with XNandFtl_Format().
+*
+* Only the tag of the first page of every block is read to order the blocks
+* by age. The newest complete checkpoint is then located from the newest
+* block backwards, and the pages written after it are replayed in sequence
+* order to bring the map up to date. Valid page counts are rebuilt from the
+* map and a fresh checkpoint is written, so the next mount starts from here.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_NO_DATA if the partition holds no FTL volume. Call
+*		XNandFtl_Format() to create one.
+*		- XST_FAILURE if the volume could not be brought up.
+*
+******************************************************************************/
+s32 XNandFtl_Mount(XNandFtl *InstancePtr)
+{
+	const XNandFtl_Ops *Ops;
+	XNandFtl_BlockInfo *Info;
+	XNandFtl_Tag Tag;
+	u32 Ppb;
+	u32 Block;
+	u32 Page;
+	u32 NumUsed = 0U;
+	u32 MaxSeq = 0U;
+	u32 CkptSeq = 0U;
+	u32 CkptLast = 0U;
+	u32 Index;
+	u32 Pass;
+	s32 Found;
+	s32 Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->Config.Ops != NULL);
+
+	Ops = InstancePtr->Config.Ops;
+	Ppb = InstancePtr->Config.PagesPerBlock;
+	InstancePtr->IsReady = 0U;
+	InstancePtr->FreeBlocks = 0U;
+	InstancePtr->OpenBlock = XNANDFTL_NO_BLOCK;
+	InstancePtr->CkptBlock = XNANDFTL_NO_BLOCK;
+	for (Index = 0U; Index < InstancePtr->NumChunks; Index++) {
+		InstancePtr->Gmd[Index] = XNANDFTL_UNMAPPED;
+	}
+	XNandFtl_ResetCache(InstancePtr);
+
+	/* Classify the blocks from the tag of their first page */
+	for (Block = 0U; Block < InstancePtr->Config.NumBlocks; Block++) {
+		Info = &InstancePtr->Block[Block];
+		(void)memset(Info, 0, sizeof(XNandFtl_BlockInfo));
+		if (Ops->IsBlockBad(InstancePtr->Config.DevPtr,
+			InstancePtr->Config.StartBlock + Block) == XST_SUCCESS) {
+			Info->State = XNANDFTL_BLOCK_BAD;
+			continue;
+		}
+
+		Status = XNandFtl_ReadTag(InstancePtr, Block * Ppb, &Tag);
+		if ((Status == XST_SUCCESS) &&
+			(XNandFtl_TagIsErased(&Tag) != 0U)) {
+			/* Possibly half written: erase before use */
+			Info->State = XNANDFTL_BLOCK_FREE;
+			InstancePtr->FreeBlocks++;
+			continue;
+		}
+
+		Info->State = XNANDFTL_BLOCK_USED;
+		if ((Status == XST_SUCCESS) &&
+			(XNandFtl_TagIsValid(&Tag) != 0U)) {
+			Info->Seq = Tag.Seq;
+			Info->EraseCount = Tag.EraseCount;
+			if (Tag.Seq > MaxSeq) {
+				MaxSeq = Tag.Seq;
+			}
+		}
+		XNandFtl_Order[NumUsed] = Block;
+		NumUsed++;
+	}
+
+	XNandFtl_SortBlocks = InstancePtr->Block;
+	qsort(XNandFtl_Order, NumUsed, sizeof(u32), XNandFtl_SeqCompare);
+
+	/* Newest complete checkpoint, searching from the newest page down */
+	Found = 0;
+	for (Index = NumUsed; (Index > 0U) && (Found == 0); Index--) {
+		Block = XNandFtl_Order[Index - 1U];
+		for (Page = Ppb; Page >= InstancePtr->CkptPages; Page--) {
+			Status = XNandFtl_ReadTag(InstancePtr,
+					(Block * Ppb) + Page - 1U, &Tag);
+			if ((Status != XST_SUCCESS) ||
+				(XNandFtl_TagIsValid(&Tag) == 0U) ||
+				(Tag.Type != XNANDFTL_TAG_CKPT) ||
+				(Tag.Lpn != ((InstancePtr->CkptPages - 1U) |
+					(InstancePtr->CkptPages << 16U)))) {
+				continue;
+			}
+
+			Status = XNandFtl_LoadCheckpoint(InstancePtr,
+					(Block * Ppb) + Page -
+					InstancePtr->CkptPages);
+			if (Status == XST_SUCCESS) {
+				CkptSeq = Tag.Seq;
+				CkptLast = Page;
+				InstancePtr->CkptBlock = Block;
+				Found = 1;
+				break;
+			}
+		}
+	}
+	if (Found == 0) {
+		return (s32)XST_NO_DATA;
+	}
+
+	Status = XNandFtl_CheckCapacity(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	/*
+	 * Sequence numbers of the pages behind the first one of the newest
+	 * block are not known yet; skipping a block's worth is enough.
+	 */
+	InstancePtr->Seq = MaxSeq + Ppb + 1U;
+
+	/*
+	 * Pages behind the checkpoint in its own block, then newer blocks.
+	 * The first pass settles the chunk directory, so that the second
+	 * one only ever loads chunks from where they live now.
+	 */
+	for (Index = 0U; Index < InstancePtr->NumChunks; Index++) {
+		XNandFtl_MapSeq[Index] = CkptSeq;
+	}
+	for (Pass = 0U; (Pass < 2U) && (Status == XST_SUCCESS); Pass++) {
+		Status = XNandFtl_Replay(InstancePtr, InstancePtr->CkptBlock,
+				CkptLast, CkptSeq, Pass);
+		for (Index = 0U; (Index < NumUsed) &&
+				(Status == XST_SUCCESS); Index++) {
+			Block = XNandFtl_Order[Index];
+			if ((InstancePtr->Block[Block].Seq > CkptSeq) &&
+				(Block != InstancePtr->CkptBlock)) {
+				Status = XNandFtl_Replay(InstancePtr, Block, 0U,
+						CkptSeq, Pass);
+			}
+		}
+	}
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XNandFtl_FlushMap(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XNandFtl_CountValid(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XNandFtl_WriteCheckpoint(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads sectors. Sectors never written read as zero.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Sector is the first sector to read.
+* @param	Count is the number of sectors to read.
+* @param	Buf is the destination buffer.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the range is outside the volume.
+*		- XST_FAILURE if a page could not be read.
+*
+******************************************************************************/
+s32 XNandFtl_Read(XNandFtl *InstancePtr, u32 Sector, u32 Count, u8 *Buf)
+{
+	u32 Spp;
+	u32 Lpn;
+	u32 First;
+	u32 Num;
+	u32 Mask;
+	u32 Ppn;
+	u32 Index;
+	u8 *Ptr = Buf;
+	u32 Left = Count;
+	u32 Next = Sector;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buf != NULL);
+
+	if ((Sector > XNandFtl_GetSectorCount(InstancePtr)) ||
+		(Count > (XNandFtl_GetSectorCount(InstancePtr) - Sector))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	Spp = InstancePtr->SectorsPerPage;
+	while (Left > 0U) {
+		Lpn = Next / Spp;
+		First = Next % Spp;
+		Num = ((Spp - First) < Left) ? (Spp - First) : Left;
+		Mask = ((Num == 32U) ? 0xFFFFFFFFU : ((1U << Num) - 1U)) << First;
+
+		/* Go to the flash unless the write buffer has it all */
+		if ((Lpn != InstancePtr->WbLpn) ||
+			((Mask & ~InstancePtr->WbValid) != 0U)) {
+			Status = XNandFtl_LookupMap(InstancePtr, Lpn, &Ppn);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+			if (Ppn == XNANDFTL_UNMAPPED) {
+				(void)memset(Ptr, 0, Num * XNANDFTL_SECTOR_SIZE);
+			} else if ((Num == Spp) &&
+				(((UINTPTR)Ptr & 63U) == 0U)) {
+				Status = XNandFtl_ReadPage(InstancePtr, Ppn, Ptr);
+				if (Status != XST_SUCCESS) {
+					return (s32)XST_FAILURE;
+				}
+			} else {
+				Status = XNandFtl_ReadPage(InstancePtr, Ppn,
+						InstancePtr->PageBuf);
+				if (Status != XST_SUCCESS) {
+					return (s32)XST_FAILURE;
+				}
+				(void)memcpy(Ptr, &InstancePtr->PageBuf[First *
+						XNANDFTL_SECTOR_SIZE],
+						Num * XNANDFTL_SECTOR_SIZE);
+			}
+		}
+
+		if (Lpn == InstancePtr->WbLpn) {
+			for (Index = First; Index < (First + Num); Index++) {
+				if ((InstancePtr->WbValid & (1U << Index)) != 0U) {
+					(void)memcpy(&Ptr[(Index - First) *
+						XNANDFTL_SECTOR_SIZE],
+						&InstancePtr->WbData[Index *
+						XNANDFTL_SECTOR_SIZE],
+						XNANDFTL_SECTOR_SIZE);
+				}
+			}
+		}
+
+		Ptr += Num * XNANDFTL_SECTOR_SIZE;
+		Next += Num;
+		Left -= Num;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes sectors. Partial pages are collected in the write
+* buffer; whole aligned pages are programmed straight from Buf. Data is
+* durable once XNandFtl_Sync() returns.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Sector is the first sector to write.
+* @param	Count is the number of sectors to write.
+* @param	Buf is the source buffer.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the range is outside the volume.
+*		- XST_FAILURE if the flash could not be written or no space
+*		could be reclaimed.
+*
+******************************************************************************/
+s32 XNandFtl_Write(XNandFtl *InstancePtr, u32 Sector, u32 Count,
+				const u8 *Buf)
+{
+	u32 Spp;
+	u32 Lpn;
+	u32 First;
+	u32 Num;
+	u32 Full;
+	const u8 *Ptr = Buf;
+	u32 Left = Count;
+	u32 Next = Sector;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Buf != NULL);
+
+	if ((Sector > XNandFtl_GetSectorCount(InstancePtr)) ||
+		(Count > (XNandFtl_GetSectorCount(InstancePtr) - Sector))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	Spp = InstancePtr->SectorsPerPage;
+	Full = (Spp == 32U) ? 0xFFFFFFFFU : ((1U << Spp) - 1U);
+	while (Left > 0U) {
+		Lpn = Next / Spp;
+		First = Next % Spp;
+
+		if ((First == 0U) && (Left >= Spp)) {
+			/* Whole page: anything buffered for it is superseded */
+			if (Lpn == InstancePtr->WbLpn) {
+				InstancePtr->WbLpn = XNANDFTL_UNMAPPED;
+				InstancePtr->WbValid = 0U;
+			}
+			Status = XNandFtl_WritePage(InstancePtr, Lpn, Ptr);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+			Num = Spp;
+		} else {
+			if (Lpn != InstancePtr->WbLpn) {
+				Status = XNandFtl_FlushWb(InstancePtr);
+				if (Status != XST_SUCCESS) {
+					return Status;
+				}
+				InstancePtr->WbLpn = Lpn;
+			}
+			Num = ((Spp - First) < Left) ? (Spp - First) : Left;
+			(void)memcpy(&InstancePtr->WbData[First *
+					XNANDFTL_SECTOR_SIZE], Ptr,
+					Num * XNANDFTL_SECTOR_SIZE);
+			InstancePtr->WbValid |= ((1U << Num) - 1U) << First;
+			if (InstancePtr->WbValid == Full) {
+				Status = XNandFtl_FlushWb(InstancePtr);
+				if (Status != XST_SUCCESS) {
+					return Status;
+				}
+			}
+		}
+
+		Ptr += Num * XNANDFTL_SECTOR_SIZE;
+		Next += Num;
+		Left -= Num;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function makes everything written so far durable: the write buffer
+* and the dirty map chunks are programmed, and a checkpoint is written once
+* XNANDFTL_CKPT_INTERVAL blocks have been filled since the previous one.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+s32 XNandFtl_Sync(XNandFtl *InstancePtr)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Status = XNandFtl_FlushWb(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XNandFtl_FlushMap(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	if (InstancePtr->PagesSinceCkpt >=
+		(XNANDFTL_CKPT_INTERVAL * InstancePtr->Config.PagesPerBlock)) {
+		Status = XNandFtl_WriteCheckpoint(InstancePtr);
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function flushes all state and writes a checkpoint so that the next
+* mount has nothing to replay. The instance has to be mounted again before
+* further use.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+s32 XNandFtl_Unmount(XNandFtl *InstancePtr)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Status = XNandFtl_FlushWb(InstancePtr);
+	if ((Status == XST_SUCCESS) && (InstancePtr->PagesSinceCkpt != 0U)) {
+		Status = XNandFtl_WriteCheckpoint(InstancePtr);
+	}
+	InstancePtr->IsReady = 0U;
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function performs at most one block of garbage collection ahead of
+* need. It collects the block with the fewest valid pages while the free
+* pool is below XNANDFTL_GC_BG_BLOCKS, and otherwise moves the least worn
+* block when the erase count spread calls for static wear leveling.
+*
+* Call it whenever the application is idle. Each call costs at most one
+* block worth of page copies and one erase.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if a block was collected.
+*		- XST_NO_DATA if there was nothing to do.
+*		- XST_FAILURE on a flash error.
+*
+******************************************************************************/
+s32 XNandFtl_Background(XNandFtl *InstancePtr)
+{
+	XNandFtl_BlockInfo *Info;
+	u32 Victim;
+	u32 IsWl = 0U;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->FreeBlocks < XNANDFTL_GC_BG_BLOCKS) {
+		Victim = XNandFtl_PickVictim(InstancePtr, 0U, &IsWl);
+		if ((Victim == XNANDFTL_NO_BLOCK) ||
+			((InstancePtr->Block[Victim].Valid >=
+				InstancePtr->Config.PagesPerBlock) &&
+			((InstancePtr->Block[Victim].Flags &
+				XNANDFTL_BLOCK_RETIRE) == 0U))) {
+			return (s32)XST_NO_DATA;
+		}
+	} else {
+		/* Pool is healthy: only wear leveling and dead blocks */
+		Victim = XNandFtl_PickVictim(InstancePtr, 1U, &IsWl);
+		if (Victim == XNANDFTL_NO_BLOCK) {
+			return (s32)XST_NO_DATA;
+		}
+		Info = &InstancePtr->Block[Victim];
+		if ((IsWl == 0U) && (Info->Valid != 0U) &&
+			((Info->Flags & XNANDFTL_BLOCK_RETIRE) == 0U)) {
+			return (s32)XST_NO_DATA;
+		}
+	}
+
+	if (IsWl != 0U) {
+		InstancePtr->Stats.WlRuns++;
+	}
+
+	return XNandFtl_CollectBlock(InstancePtr, Victim);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function copies the statistics of the instance.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	StatsPtr is where the statistics are copied to.
+*
+* @return	None.
+*
+******************************************************************************/
+void XNandFtl_GetStats(XNandFtl *InstancePtr, XNandFtl_Stats *StatsPtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = InstancePtr->Stats;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes the check field of a tag.
+*
+* @param	Tag is the tag.
+*
+* @return	Check value.
+*
+******************************************************************************/
+static u16 XNandFtl_TagCheck(const XNandFtl_Tag *Tag)
+{
+	u32 Sum;
+
+	Sum = Tag->Lpn ^ (Tag->Seq * 0x9E3779B1U) ^ (Tag->EraseCount << 7U) ^
+		(u32)Tag->Type ^ 0x5AA5C33CU;
+
+	return (u16)((Sum ^ (Sum >> 16U)) & 0xFFFFU);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function tells whether a tag belongs to an unprogrammed page.
+*
+* @param	Tag is the tag.
+*
+* @return	1 if every byte of the tag reads 0xFF, 0 otherwise.
+*
+******************************************************************************/
+static u32 XNandFtl_TagIsErased(const XNandFtl_Tag *Tag)
+{
+	return ((Tag->Lpn == 0xFFFFFFFFU) && (Tag->Seq == 0xFFFFFFFFU) &&
+		(Tag->EraseCount == 0xFFFFFFFFU) && (Tag->Type == 0xFFFFU) &&
+		(Tag->Check == 0xFFFFU)) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function tells whether a tag was written by the FTL and read back
+* intact.
+*
+* @param	Tag is the tag.
+*
+* @return	1 if valid, 0 otherwise.
+*
+******************************************************************************/
+static u32 XNandFtl_TagIsValid(const XNandFtl_Tag *Tag)
+{
+	if ((Tag->Type < XNANDFTL_TAG_DATA) ||
+		(Tag->Type > XNANDFTL_TAG_CKPT)) {
+		return 0U;
+	}
+
+	return (Tag->Check == XNandFtl_TagCheck(Tag)) ? 1U : 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the tag of a partition page.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Ppn is the page number within the partition.
+* @param	Tag is where the tag is returned.
+*
+* @return	Status from the driver.
+*
+******************************************************************************/
+static s32 XNandFtl_ReadTag(XNandFtl *InstancePtr, u32 Ppn,
+				XNandFtl_Tag *Tag)
+{
+	return InstancePtr->Config.Ops->ReadTag(InstancePtr->Config.DevPtr,
+			XNandFtl_DevPage(InstancePtr, Ppn), Tag);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the data of a partition page.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Ppn is the page number within the partition.
+* @param	Buf is the destination, one page long.
+*
+* @return	Status from the driver.
+*
+******************************************************************************/
+static s32 XNandFtl_ReadPage(XNandFtl *InstancePtr, u32 Ppn, u8 *Buf)
+{
+	return InstancePtr->Config.Ops->ReadPage(InstancePtr->Config.DevPtr,
+			XNandFtl_DevPage(InstancePtr, Ppn), Buf);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function takes a block out of service and records it in the driver's
+* bad block table.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Block is the block within the partition.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XNandFtl_RetireBlock(XNandFtl *InstancePtr, u32 Block)
+{
+	(void)InstancePtr->Config.Ops->MarkBlockBad(InstancePtr->Config.DevPtr,
+			InstancePtr->Config.StartBlock + Block);
+	InstancePtr->Block[Block].State = XNANDFTL_BLOCK_BAD;
+	InstancePtr->Block[Block].Valid = 0U;
+	InstancePtr->Stats.BadBlocks++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function opens a new write frontier on the least worn free block,
+* erasing it first unless it is known to be clean.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if no free block is left.
+*
+******************************************************************************/
+static s32 XNandFtl_OpenBlock(XNandFtl *InstancePtr)
+{
+	XNandFtl_BlockInfo *Info;
+	u32 Block;
+	u32 Best;
+	s32 Status;
+
+	while (InstancePtr->FreeBlocks > 0U) {
+		Best = XNANDFTL_NO_BLOCK;
+		for (Block = 0U; Block < InstancePtr->Config.NumBlocks;
+				Block++) {
+			Info = &InstancePtr->Block[Block];
+			if ((Info->State == XNANDFTL_BLOCK_FREE) &&
+				((Best == XNANDFTL_NO_BLOCK) ||
+				(Info->EraseCount <
+				InstancePtr->Block[Best].EraseCount))) {
+				Best = Block;
+			}
+		}
+		if (Best == XNANDFTL_NO_BLOCK) {
+			break;
+		}
+
+		Info = &InstancePtr->Block[Best];
+		InstancePtr->FreeBlocks--;
+		if ((Info->Flags & XNANDFTL_BLOCK_CLEAN) == 0U) {
+			Status = InstancePtr->Config.Ops->EraseBlock(
+					InstancePtr->Config.DevPtr,
+					InstancePtr->Config.StartBlock + Best);
+			InstancePtr->Stats.Erases++;
+			if (Status != XST_SUCCESS) {
+				XNandFtl_RetireBlock(InstancePtr, Best);
+				continue;
+			}
+			Info->EraseCount++;
+		}
+
+		Info->State = XNANDFTL_BLOCK_OPEN;
+		Info->Flags = 0U;
+		Info->Valid = 0U;
+		Info->Seq = InstancePtr->Seq;
+		InstancePtr->OpenBlock = Best;
+		InstancePtr->OpenPage = 0U;
+		return XST_SUCCESS;
+	}
+
+	return (s32)XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function closes the write frontier. Unwritten pages at the end of the
+* block stay erased until the block is collected.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XNandFtl_CloseBlock(XNandFtl *InstancePtr)
+{
+	if (InstancePtr->OpenBlock != XNANDFTL_NO_BLOCK) {
+		InstancePtr->Block[InstancePtr->OpenBlock].State =
+				XNANDFTL_BLOCK_USED;
+		InstancePtr->OpenBlock = XNANDFTL_NO_BLOCK;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function appends one page to the log. A failed program retires the
+* frontier block and the page is retried on a fresh one.
+*
+* This never collects garbage itself; callers that may consume more than a
+* few pages go through XNandFtl_EnsureFree() first.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Buf is the page data.
+* @param	Type is the XNANDFTL_TAG_* type of the page.
+* @param	Lpn is the tag Lpn field.
+* @param	PpnPtr is where the partition page written is returned.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if no block could take the page.
+*
+******************************************************************************/
+static s32 XNandFtl_ProgramPage(XNandFtl *InstancePtr, const u8 *Buf,
+				u16 Type, u32 Lpn, u32 *PpnPtr)
+{
+	XNandFtl_BlockInfo *Info;
+	XNandFtl_Tag Tag;
+	u32 Ppn;
+	u32 Retry;
+	s32 Status = XST_FAILURE;
+
+	for (Retry = 0U; Retry < XNANDFTL_PROGRAM_RETRIES; Retry++) {
+		if ((InstancePtr->OpenBlock == XNANDFTL_NO_BLOCK) ||
+			(InstancePtr->OpenPage ==
+				InstancePtr->Config.PagesPerBlock)) {
+			XNandFtl_CloseBlock(InstancePtr);
+			Status = XNandFtl_OpenBlock(InstancePtr);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+		}
+
+		Info = &InstancePtr->Block[InstancePtr->OpenBlock];
+		Ppn = (InstancePtr->OpenBlock *
+				InstancePtr->Config.PagesPerBlock) +
+				InstancePtr->OpenPage;
+		Tag.Lpn = Lpn;
+		Tag.Seq = InstancePtr->Seq;
+		Tag.EraseCount = Info->EraseCount;
+		Tag.Type = Type;
+		Tag.Check = XNandFtl_TagCheck(&Tag);
+		if (InstancePtr->OpenPage == 0U) {
+			Info->Seq = Tag.Seq;
+		}
+		InstancePtr->Seq++;
+		InstancePtr->OpenPage++;
+
+		Status = InstancePtr->Config.Ops->ProgramPage(
+				InstancePtr->Config.DevPtr,
+				XNandFtl_DevPage(InstancePtr, Ppn), Buf, &Tag);
+		if (Status == XST_SUCCESS) {
+			InstancePtr->Stats.FlashPages++;
+			InstancePtr->PagesSinceCkpt++;
+			*PpnPtr = Ppn;
+			return XST_SUCCESS;
+		}
+
+		Info->Flags |= XNANDFTL_BLOCK_RETIRE;
+		InstancePtr->OpenPage = InstancePtr->Config.PagesPerBlock;
+	}
+
+	return (s32)XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* These functions account a map reference to a page being added or dropped.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Ppn is the partition page, XNANDFTL_UNMAPPED is ignored.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XNandFtl_Validate(XNandFtl *InstancePtr, u32 Ppn)
+{
+	u32 Block = XNandFtl_PpnBlock(InstancePtr, Ppn);
+
+	if ((Ppn != XNANDFTL_UNMAPPED) &&
+		(Block < InstancePtr->Config.NumBlocks)) {
+		InstancePtr->Block[Block].Valid++;
+	}
+}
+
+static void XNandFtl_Invalidate(XNandFtl *InstancePtr, u32 Ppn)
+{
+	u32 Block = XNandFtl_PpnBlock(InstancePtr, Ppn);
+
+	if ((Ppn != XNANDFTL_UNMAPPED) &&
+		(Block < InstancePtr->Config.NumBlocks) &&
+		(InstancePtr->Block[Block].Valid != 0U)) {
+		InstancePtr->Block[Block].Valid--;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a dirty map chunk to the log.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Slot is the cache slot.
+*
+* @return
+*		- XST_SUCCESS if successful or the slot is clean.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_FlushSlot(XNandFtl *InstancePtr, XNandFtl_MapSlot *Slot)
+{
+	u32 Ppn;
+	s32 Status;
+
+	if ((Slot->Dirty == 0U) || (Slot->Chunk == XNANDFTL_UNMAPPED)) {
+		return XST_SUCCESS;
+	}
+
+	Status = XNandFtl_ProgramPage(InstancePtr, (u8 *)Slot->Entry,
+			XNANDFTL_TAG_MAP, Slot->Chunk, &Ppn);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	XNandFtl_Invalidate(InstancePtr, InstancePtr->Gmd[Slot->Chunk]);
+	InstancePtr->Gmd[Slot->Chunk] = Ppn;
+	XNandFtl_Validate(InstancePtr, Ppn);
+	Slot->Dirty = 0U;
+	InstancePtr->Stats.MapPages++;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes every dirty map chunk to the log.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_FlushMap(XNandFtl *InstancePtr)
+{
+	u32 Index;
+	s32 Status;
+
+	for (Index = 0U; Index < InstancePtr->NumSlots; Index++) {
+		Status = XNandFtl_FlushSlot(InstancePtr,
+				&InstancePtr->Slot[Index]);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the cache slot holding a map chunk, loading it into
+* the least recently used slot on a miss. A dirty victim is written back
+* first.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Chunk is the map chunk.
+* @param	SlotPtr is where the slot is returned.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the write back or the load failed.
+*
+******************************************************************************/
+static s32 XNandFtl_GetSlot(XNandFtl *InstancePtr, u32 Chunk,
+				XNandFtl_MapSlot **SlotPtr)
+{
+	XNandFtl_MapSlot *Slot;
+	XNandFtl_MapSlot *Victim = NULL;
+	u32 Index;
+	s32 Status;
+
+	InstancePtr->UseClock++;
+	for (Index = 0U; Index < InstancePtr->NumSlots; Index++) {
+		Slot = &InstancePtr->Slot[Index];
+		if (Slot->Chunk == Chunk) {
+			Slot->LastUse = InstancePtr->UseClock;
+			*SlotPtr = Slot;
+			return XST_SUCCESS;
+		}
+		if ((Victim == NULL) || (Slot->Chunk == XNANDFTL_UNMAPPED) ||
+			((Victim->Chunk != XNANDFTL_UNMAPPED) &&
+			(Slot->LastUse < Victim->LastUse))) {
+			Victim = Slot;
+		}
+	}
+
+	Status = XNandFtl_FlushSlot(InstancePtr, Victim);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Victim->Chunk = XNANDFTL_UNMAPPED;
+	if (InstancePtr->Gmd[Chunk] == XNANDFTL_UNMAPPED) {
+		(void)memset(Victim->Entry, 0xFF,
+				InstancePtr->Config.BytesPerPage);
+	} else {
+		Status = XNandFtl_ReadPage(InstancePtr, InstancePtr->Gmd[Chunk],
+				(u8 *)Victim->Entry);
+		if (Status != XST_SUCCESS) {
+			return (s32)XST_FAILURE;
+		}
+	}
+
+	Victim->Chunk = Chunk;
+	Victim->Dirty = 0U;
+	Victim->LastUse = InstancePtr->UseClock;
+	*SlotPtr = Victim;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function looks up the physical page of a logical page.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Lpn is the logical page.
+* @param	PpnPtr is where the partition page, or XNANDFTL_UNMAPPED, is
+*		returned.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the map chunk could not be loaded.
+*
+******************************************************************************/
+static s32 XNandFtl_LookupMap(XNandFtl *InstancePtr, u32 Lpn, u32 *PpnPtr)
+{
+	XNandFtl_MapSlot *Slot;
+	s32 Status;
+
+	Status = XNandFtl_GetSlot(InstancePtr,
+			Lpn / InstancePtr->EntriesPerChunk, &Slot);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	*PpnPtr = Slot->Entry[Lpn % InstancePtr->EntriesPerChunk];
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function points a logical page at a new physical page and moves the
+* valid page accounting along with it.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Lpn is the logical page.
+* @param	Ppn is the new partition page.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the map chunk could not be loaded.
+*
+******************************************************************************/
+static s32 XNandFtl_UpdateMap(XNandFtl *InstancePtr, u32 Lpn, u32 Ppn)
+{
+	XNandFtl_MapSlot *Slot;
+	u32 *EntryPtr;
+	s32 Status;
+
+	Status = XNandFtl_GetSlot(InstancePtr,
+			Lpn / InstancePtr->EntriesPerChunk, &Slot);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	EntryPtr = &Slot->Entry[Lpn % InstancePtr->EntriesPerChunk];
+	XNandFtl_Invalidate(InstancePtr, *EntryPtr);
+	*EntryPtr = Ppn;
+	XNandFtl_Validate(InstancePtr, Ppn);
+	Slot->Dirty = 1U;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns one word of the checkpoint image: the header, the
+* chunk directory and the erase count of every block, in that order.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Index is the word index.
+*
+* @return	The word, 0xFFFFFFFF past the end of the image.
+*
+******************************************************************************/
+static u32 XNandFtl_CkptWord(XNandFtl *InstancePtr, u32 Index)
+{
+	u32 Word;
+
+	if (Index < XNANDFTL_CKPT_HDR_WORDS) {
+		switch (Index) {
+		case 0U:
+			Word = XNANDFTL_CKPT_MAGIC;
+			break;
+		case 1U:
+			Word = XNANDFTL_CKPT_VERSION;
+			break;
+		case 2U:
+			Word = InstancePtr->Config.StartBlock;
+			break;
+		case 3U:
+			Word = InstancePtr->Config.NumBlocks;
+			break;
+		case 4U:
+			Word = InstancePtr->Config.PagesPerBlock;
+			break;
+		case 5U:
+			Word = InstancePtr->LogicalPages;
+			break;
+		case 6U:
+			Word = InstancePtr->NumChunks;
+			break;
+		default:
+			Word = InstancePtr->CkptPages;
+			break;
+		}
+	} else if (Index < (XNANDFTL_CKPT_HDR_WORDS +
+			InstancePtr->NumChunks)) {
+		Word = InstancePtr->Gmd[Index - XNANDFTL_CKPT_HDR_WORDS];
+	} else if (Index < (XNANDFTL_CKPT_HDR_WORDS + InstancePtr->NumChunks +
+			InstancePtr->Config.NumBlocks)) {
+		Word = InstancePtr->Block[Index - XNANDFTL_CKPT_HDR_WORDS -
+				InstancePtr->NumChunks].EraseCount;
+	} else {
+		Word = 0xFFFFFFFFU;
+	}
+
+	return Word;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function writes a checkpoint. The map is flushed first so that the
+* chunk directory in the checkpoint describes every page written before it.
+* The checkpoint pages are kept together in one block, which is how mount
+* recognises a complete one.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_WriteCheckpoint(XNandFtl *InstancePtr)
+{
+	u32 Words = InstancePtr->Config.BytesPerPage / 4U;
+	u32 *WordPtr = (u32 *)(void *)InstancePtr->PageBuf;
+	u32 Retry;
+	u32 Part;
+	u32 Index;
+	u32 First = 0U;
+	u32 Ppn;
+	s32 Status;
+
+	Status = XNandFtl_FlushMap(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	for (Retry = 0U; Retry < XNANDFTL_PROGRAM_RETRIES; Retry++) {
+		if ((InstancePtr->OpenBlock == XNANDFTL_NO_BLOCK) ||
+			((InstancePtr->OpenPage + InstancePtr->CkptPages) >
+			InstancePtr->Config.PagesPerBlock)) {
+			XNandFtl_CloseBlock(InstancePtr);
+			Status = XNandFtl_OpenBlock(InstancePtr);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+		}
+
+		for (Part = 0U; Part < InstancePtr->CkptPages; Part++) {
+			for (Index = 0U; Index < Words; Index++) {
+				WordPtr[Index] = XNandFtl_CkptWord(InstancePtr,
+						(Part * Words) + Index);
+			}
+			Status = XNandFtl_ProgramPage(InstancePtr,
+					InstancePtr->PageBuf, XNANDFTL_TAG_CKPT,
+					Part | (InstancePtr->CkptPages << 16U),
+					&Ppn);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+			if (Part == 0U) {
+				First = Ppn;
+			} else if (Ppn != (First + Part)) {
+				/* A program failure moved us to a new block */
+				break;
+			}
+		}
+
+		if (Part == InstancePtr->CkptPages) {
+			InstancePtr->CkptBlock = XNandFtl_PpnBlock(InstancePtr,
+					First);
+			InstancePtr->PagesSinceCkpt = 0U;
+			return XST_SUCCESS;
+		}
+	}
+
+	return (s32)XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function loads a checkpoint candidate found by mount. The parts must
+* carry consecutive sequence numbers and the header must match the current
+* configuration, otherwise the candidate is rejected.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	FirstPpn is the partition page of the first part.
+*
+* @return
+*		- XST_SUCCESS if the checkpoint was loaded.
+*		- XST_FAILURE if it is incomplete or does not match.
+*
+******************************************************************************/
+static s32 XNandFtl_LoadCheckpoint(XNandFtl *InstancePtr, u32 FirstPpn)
+{
+	XNandFtl_BlockInfo *Info;
+	XNandFtl_Tag Tag;
+	u32 Words = InstancePtr->Config.BytesPerPage / 4U;
+	const u32 *WordPtr = (const u32 *)(void *)InstancePtr->PageBuf;
+	u32 Seq = 0U;
+	u32 Part;
+	u32 Index;
+	u32 Word;
+	u32 Pos;
+	s32 Status;
+
+	for (Part = 0U; Part < InstancePtr->CkptPages; Part++) {
+		Status = XNandFtl_ReadTag(InstancePtr, FirstPpn + Part, &Tag);
+		if ((Status != XST_SUCCESS) ||
+			(XNandFtl_TagIsValid(&Tag) == 0U) ||
+			(Tag.Type != XNANDFTL_TAG_CKPT) ||
+			(Tag.Lpn != (Part | (InstancePtr->CkptPages << 16U))) ||
+			((Part != 0U) && (Tag.Seq != (Seq + 1U)))) {
+			return (s32)XST_FAILURE;
+		}
+		Seq = Tag.Seq;
+	}
+
+	for (Part = 0U; Part < InstancePtr->CkptPages; Part++) {
+		Status = XNandFtl_ReadPage(InstancePtr, FirstPpn + Part,
+				InstancePtr->PageBuf);
+		if (Status != XST_SUCCESS) {
+			return (s32)XST_FAILURE;
+		}
+
+		for (Index = 0U; Index < Words; Index++) {
+			Pos = (Part * Words) + Index;
+			Word = WordPtr[Index];
+			if (Pos < XNANDFTL_CKPT_HDR_WORDS) {
+				if (Word != XNandFtl_CkptWord(InstancePtr, Pos)) {
+					return (s32)XST_FAILURE;
+				}
+			} else if (Pos < (XNANDFTL_CKPT_HDR_WORDS +
+					InstancePtr->NumChunks)) {
+				InstancePtr->Gmd[Pos -
+					XNANDFTL_CKPT_HDR_WORDS] = Word;
+			} else if (Pos < (XNANDFTL_CKPT_HDR_WORDS +
+					InstancePtr->NumChunks +
+					InstancePtr->Config.NumBlocks)) {
+				/* Tags are newer for blocks holding data */
+				Info = &InstancePtr->Block[Pos -
+					XNANDFTL_CKPT_HDR_WORDS -
+					InstancePtr->NumChunks];
+				if ((Info->State == XNANDFTL_BLOCK_FREE) ||
+					(Info->Seq == 0U)) {
+					Info->EraseCount = Word;
+				}
+			} else {
+				break;
+			}
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function picks the next block to collect. Retired blocks go first,
+* then the least worn used block if wear leveling is allowed and the erase
+* count spread exceeds XNANDFTL_WL_THRESHOLD, and otherwise the used block
+* with the fewest valid pages.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	AllowWl allows a wear leveling pick.
+* @param	IsWlPtr is set to 1 for a wear leveling pick, 0 otherwise.
+*
+* @return	The block, or XNANDFTL_NO_BLOCK if no block is collectable.
+*
+******************************************************************************/
+static u32 XNandFtl_PickVictim(XNandFtl *InstancePtr, u32 AllowWl,
+				u32 *IsWlPtr)
+{
+	XNandFtl_BlockInfo *Info;
+	u32 Block;
+	u32 Greedy = XNANDFTL_NO_BLOCK;
+	u32 Coldest = XNANDFTL_NO_BLOCK;
+	u32 MaxErase = 0U;
+
+	*IsWlPtr = 0U;
+	for (Block = 0U; Block < InstancePtr->Config.NumBlocks; Block++) {
+		Info = &InstancePtr->Block[Block];
+		if (Info->State == XNANDFTL_BLOCK_BAD) {
+			continue;
+		}
+		if (Info->EraseCount > MaxErase) {
+			MaxErase = Info->EraseCount;
+		}
+		if (Info->State != XNANDFTL_BLOCK_USED) {
+			continue;
+		}
+		if ((Info->Flags & XNANDFTL_BLOCK_RETIRE) != 0U) {
+			return Block;
+		}
+		if ((Greedy == XNANDFTL_NO_BLOCK) ||
+			(Info->Valid < InstancePtr->Block[Greedy].Valid)) {
+			Greedy = Block;
+		}
+		if ((Coldest == XNANDFTL_NO_BLOCK) ||
+			(Info->EraseCount <
+			InstancePtr->Block[Coldest].EraseCount)) {
+			Coldest = Block;
+		}
+	}
+
+	if ((AllowWl != 0U) && (Coldest != XNANDFTL_NO_BLOCK) &&
+		((MaxErase - InstancePtr->Block[Coldest].EraseCount) >
+		XNANDFTL_WL_THRESHOLD)) {
+		*IsWlPtr = 1U;
+		return Coldest;
+	}
+
+	return Greedy;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function moves the live pages out of a block and erases it, or marks
+* it bad if it was retired. A live data page is one the map still points at;
+* a live map page is the latest copy of its chunk. If the block holds the
+* latest checkpoint a new one is written before the erase.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Victim is the block to collect.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the live pages could not be moved.
+*
+******************************************************************************/
+static s32 XNandFtl_CollectBlock(XNandFtl *InstancePtr, u32 Victim)
+{
+	XNandFtl_BlockInfo *Info = &InstancePtr->Block[Victim];
+	XNandFtl_MapSlot *Slot;
+	XNandFtl_Tag Tag;
+	u32 Ppb = InstancePtr->Config.PagesPerBlock;
+	u32 Page;
+	u32 Ppn;
+	u32 NewPpn;
+	u32 Index;
+	u32 NumLive = 0U;
+	u32 Lpn;
+	s32 Status = XST_SUCCESS;
+
+	InstancePtr->InGc = 1U;
+
+	for (Page = 0U; Page < Ppb; Page++) {
+		Ppn = (Victim * Ppb) + Page;
+		Status = XNandFtl_ReadTag(InstancePtr, Ppn, &Tag);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		if (XNandFtl_TagIsErased(&Tag) != 0U) {
+			break;
+		}
+		if (XNandFtl_TagIsValid(&Tag) == 0U) {
+			continue;
+		}
+
+		if ((Tag.Type == XNANDFTL_TAG_DATA) &&
+			(Tag.Lpn < InstancePtr->LogicalPages)) {
+			/* Checked against the map below, in logical order */
+			XNandFtl_Live[NumLive] = ((u64)Tag.Lpn << 32U) | Ppn;
+			NumLive++;
+		} else if ((Tag.Type == XNANDFTL_TAG_MAP) &&
+			(Tag.Lpn < InstancePtr->NumChunks) &&
+			(InstancePtr->Gmd[Tag.Lpn] == Ppn)) {
+			/* A cached copy is at least as new: write that */
+			Slot = NULL;
+			for (Index = 0U; Index < InstancePtr->NumSlots;
+					Index++) {
+				if (InstancePtr->Slot[Index].Chunk == Tag.Lpn) {
+					Slot = &InstancePtr->Slot[Index];
+				}
+			}
+			if (Slot != NULL) {
+				Slot->Dirty = 1U;
+				Status = XNandFtl_FlushSlot(InstancePtr, Slot);
+				if (Status != XST_SUCCESS) {
+					goto Out;
+				}
+			} else {
+				(void)XNandFtl_ReadPage(InstancePtr, Ppn,
+						InstancePtr->PageBuf);
+				Status = XNandFtl_ProgramPage(InstancePtr,
+						InstancePtr->PageBuf,
+						XNANDFTL_TAG_MAP, Tag.Lpn,
+						&NewPpn);
+				if (Status != XST_SUCCESS) {
+					goto Out;
+				}
+				XNandFtl_Invalidate(InstancePtr, Ppn);
+				InstancePtr->Gmd[Tag.Lpn] = NewPpn;
+				XNandFtl_Validate(InstancePtr, NewPpn);
+				InstancePtr->Stats.MapPages++;
+			}
+			InstancePtr->Stats.GcCopies++;
+		} else {
+			/* Stale page or checkpoint */
+		}
+	}
+
+	/*
+	 * Sorted by logical page, consecutive live pages mostly share a map
+	 * chunk, which then stays cached while they are moved instead of
+	 * being evicted and rewritten for every page.
+	 */
+	qsort(XNandFtl_Live, NumLive, sizeof(u64), XNandFtl_LiveCompare);
+	for (Index = 0U; Index < NumLive; Index++) {
+		Lpn = (u32)(XNandFtl_Live[Index] >> 32U);
+		Ppn = (u32)XNandFtl_Live[Index];
+		Status = XNandFtl_LookupMap(InstancePtr, Lpn, &NewPpn);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		if (NewPpn != Ppn) {
+			continue;
+		}
+		/* An uncorrectable page is still moved, as read */
+		(void)XNandFtl_ReadPage(InstancePtr, Ppn, InstancePtr->PageBuf);
+		Status = XNandFtl_ProgramPage(InstancePtr, InstancePtr->PageBuf,
+				XNANDFTL_TAG_DATA, Lpn, &NewPpn);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		Status = XNandFtl_UpdateMap(InstancePtr, Lpn, NewPpn);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		InstancePtr->Stats.GcCopies++;
+	}
+
+	if (Victim == InstancePtr->CkptBlock) {
+		Status = XNandFtl_WriteCheckpoint(InstancePtr);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+
+	if ((Info->Flags & XNANDFTL_BLOCK_RETIRE) != 0U) {
+		XNandFtl_RetireBlock(InstancePtr, Victim);
+	} else {
+		Status = InstancePtr->Config.Ops->EraseBlock(
+				InstancePtr->Config.DevPtr,
+				InstancePtr->Config.StartBlock + Victim);
+		InstancePtr->Stats.Erases++;
+		if (Status != XST_SUCCESS) {
+			XNandFtl_RetireBlock(InstancePtr, Victim);
+		} else {
+			Info->EraseCount++;
+			Info->State = XNANDFTL_BLOCK_FREE;
+			Info->Flags = XNANDFTL_BLOCK_CLEAN;
+			Info->Valid = 0U;
+			InstancePtr->FreeBlocks++;
+		}
+		Status = XST_SUCCESS;
+	}
+	InstancePtr->Stats.GcRuns++;
+
+Out:
+	InstancePtr->InGc = 0U;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function collects garbage in the foreground until more than
+* XNANDFTL_GC_RESERVE blocks are free. The first pick of a call may be a wear
+* leveling one, so that static data still moves when the volume is kept so
+* full that background collection never finds a healthy pool.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the volume is full or the flash failed.
+*
+******************************************************************************/
+static s32 XNandFtl_EnsureFree(XNandFtl *InstancePtr)
+{
+	u32 Victim;
+	u32 IsWl;
+	u32 Budget = InstancePtr->Config.NumBlocks;
+	s32 Status;
+
+	while ((InstancePtr->FreeBlocks <= XNANDFTL_GC_RESERVE) &&
+		(InstancePtr->InGc == 0U)) {
+		Victim = XNandFtl_PickVictim(InstancePtr,
+				(Budget == InstancePtr->Config.NumBlocks) ?
+				1U : 0U, &IsWl);
+		if ((Victim == XNANDFTL_NO_BLOCK) || (Budget == 0U) ||
+			((IsWl == 0U) && (InstancePtr->Block[Victim].Valid >=
+				InstancePtr->Config.PagesPerBlock) &&
+			((InstancePtr->Block[Victim].Flags &
+				XNANDFTL_BLOCK_RETIRE) == 0U))) {
+			return (s32)XST_FAILURE;
+		}
+		if (IsWl != 0U) {
+			InstancePtr->Stats.WlRuns++;
+		}
+		Status = XNandFtl_CollectBlock(InstancePtr, Victim);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+		Budget--;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs one host page and maps it.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Lpn is the logical page.
+* @param	Buf is the page data.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_WritePage(XNandFtl *InstancePtr, u32 Lpn, const u8 *Buf)
+{
+	u32 Ppn;
+	s32 Status;
+
+	Status = XNandFtl_EnsureFree(InstancePtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XNandFtl_ProgramPage(InstancePtr, Buf, XNANDFTL_TAG_DATA, Lpn,
+			&Ppn);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	InstancePtr->Stats.HostPages++;
+
+	return XNandFtl_UpdateMap(InstancePtr, Lpn, Ppn);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function programs the write buffer. Sectors of the page that were not
+* written are merged in from the current copy on flash.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful or the buffer is empty.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_FlushWb(XNandFtl *InstancePtr)
+{
+	u32 Spp = InstancePtr->SectorsPerPage;
+	u32 Full = (Spp == 32U) ? 0xFFFFFFFFU : ((1U << Spp) - 1U);
+	u32 Ppn;
+	u32 Index;
+	s32 Status;
+
+	if (InstancePtr->WbValid == 0U) {
+		InstancePtr->WbLpn = XNANDFTL_UNMAPPED;
+		return XST_SUCCESS;
+	}
+
+	if (InstancePtr->WbValid != Full) {
+		Status = XNandFtl_LookupMap(InstancePtr, InstancePtr->WbLpn,
+				&Ppn);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+		if (Ppn == XNANDFTL_UNMAPPED) {
+			(void)memset(InstancePtr->PageBuf, 0,
+					InstancePtr->Config.BytesPerPage);
+		} else {
+			Status = XNandFtl_ReadPage(InstancePtr, Ppn,
+					InstancePtr->PageBuf);
+			if (Status != XST_SUCCESS) {
+				return (s32)XST_FAILURE;
+			}
+		}
+		for (Index = 0U; Index < Spp; Index++) {
+			if ((InstancePtr->WbValid & (1U << Index)) == 0U) {
+				(void)memcpy(&InstancePtr->WbData[Index *
+					XNANDFTL_SECTOR_SIZE],
+					&InstancePtr->PageBuf[Index *
+					XNANDFTL_SECTOR_SIZE],
+					XNANDFTL_SECTOR_SIZE);
+			}
+		}
+	}
+
+	Status = XNandFtl_WritePage(InstancePtr, InstancePtr->WbLpn,
+			InstancePtr->WbData);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	InstancePtr->WbLpn = XNANDFTL_UNMAPPED;
+	InstancePtr->WbValid = 0U;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function empties the map cache and the write buffer.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XNandFtl_ResetCache(XNandFtl *InstancePtr)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < InstancePtr->NumSlots; Index++) {
+		InstancePtr->Slot[Index].Chunk = XNANDFTL_UNMAPPED;
+		InstancePtr->Slot[Index].Dirty = 0U;
+		InstancePtr->Slot[Index].LastUse = 0U;
+	}
+	InstancePtr->WbLpn = XNANDFTL_UNMAPPED;
+	InstancePtr->WbValid = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks that enough good blocks are left to hold the volume
+* with its collection reserve.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if the volume fits.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_CheckCapacity(XNandFtl *InstancePtr)
+{
+	u32 Good = 0U;
+	u32 Block;
+
+	for (Block = 0U; Block < InstancePtr->Config.NumBlocks; Block++) {
+		if (InstancePtr->Block[Block].State != XNANDFTL_BLOCK_BAD) {
+			Good++;
+		}
+	}
+
+	if (Good <= (XNANDFTL_GC_RESERVE + 2U)) {
+		return (s32)XST_FAILURE;
+	}
+	if (((u64)(Good - XNANDFTL_GC_RESERVE - 2U) *
+		InstancePtr->Config.PagesPerBlock) <
+		((u64)InstancePtr->LogicalPages + InstancePtr->NumChunks)) {
+		return (s32)XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function replays the pages of one block written after the checkpoint.
+* Blocks are replayed oldest first, so the newest copy of everything wins.
+*
+* Pass 0 points the chunk directory at the newest copy of every map chunk.
+* Pass 1 then applies the data pages written after that copy; older ones
+* are already in it. Chunks are never loaded before pass 1, as the copy the
+* checkpoint points at may have been collected since.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+* @param	Block is the block to replay.
+* @param	FirstPage is the first page to look at.
+* @param	CkptSeq is the sequence number of the checkpoint.
+* @param	Pass is 0 for map pages, 1 for data pages.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE otherwise.
+*
+******************************************************************************/
+static s32 XNandFtl_Replay(XNandFtl *InstancePtr, u32 Block, u32 FirstPage,
+				u32 CkptSeq, u32 Pass)
+{
+	XNandFtl_Tag Tag;
+	u32 Ppb = InstancePtr->Config.PagesPerBlock;
+	u32 Page;
+	u32 Ppn;
+	s32 Status;
+
+	for (Page = FirstPage; Page < Ppb; Page++) {
+		Ppn = (Block * Ppb) + Page;
+		Status = XNandFtl_ReadTag(InstancePtr, Ppn, &Tag);
+		if (Status != XST_SUCCESS) {
+			continue;
+		}
+		if (XNandFtl_TagIsErased(&Tag) != 0U) {
+			break;
+		}
+		if ((XNandFtl_TagIsValid(&Tag) == 0U) || (Tag.Seq <= CkptSeq)) {
+			continue;
+		}
+
+		if ((Pass == 0U) && (Tag.Type == XNANDFTL_TAG_MAP) &&
+			(Tag.Lpn < InstancePtr->NumChunks)) {
+			InstancePtr->Gmd[Tag.Lpn] = Ppn;
+			XNandFtl_MapSeq[Tag.Lpn] = Tag.Seq;
+		} else if ((Pass != 0U) && (Tag.Type == XNANDFTL_TAG_DATA) &&
+			(Tag.Lpn < InstancePtr->LogicalPages) &&
+			(Tag.Seq > XNandFtl_MapSeq[Tag.Lpn /
+				InstancePtr->EntriesPerChunk])) {
+			Status = XNandFtl_UpdateMap(InstancePtr, Tag.Lpn, Ppn);
+			if (Status != XST_SUCCESS) {
+				return Status;
+			}
+		} else {
+			/* Other pass, checkpoint or corrupt tag */
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function rebuilds the valid page counts from the chunk directory and
+* the map. The map has to be clean, so that walking it does not write.
+*
+* @param	InstancePtr is a pointer to the XNandFtl instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if a map chunk could not be read.
+*
+******************************************************************************/
+static s32 XNandFtl_CountValid(XNandFtl *InstancePtr)
+{
+	XNandFtl_MapSlot *Slot;
+	u32 Block;
+	u32 Chunk;
+	u32 Index;
+	u32 Entries;
+	s32 Status;
+
+	for (Block = 0U; Block < InstancePtr->Config.NumBlocks; Block++) {
+		InstancePtr->Block[Block].Valid = 0U;
+	}
+
+	for (Chunk = 0U; Chunk < InstancePtr->NumChunks; Chunk++) {
+		if (InstancePtr->Gmd[Chunk] == XNANDFTL_UNMAPPED) {
+			continue;
+		}
+		XNandFtl_Validate(InstancePtr, InstancePtr->Gmd[Chunk]);
+
+		Status = XNandFtl_GetSlot(InstancePtr, Chunk, &Slot);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+		Entries = InstancePtr->LogicalPages -
+				(Chunk * InstancePtr->EntriesPerChunk);
+		if (Entries > InstancePtr->EntriesPerChunk) {
+			Entries = InstancePtr->EntriesPerChunk;
+		}
+		for (Index = 0U; Index < Entries; Index++) {
+			XNandFtl_Validate(InstancePtr, Slot->Entry[Index]);
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* qsort() comparison of two blocks by the sequence number of their first
+* page.
+*
+* @param	A is a pointer to the first block number.
+* @param	B is a pointer to the second block number.
+*
+* @return	<0, 0 or >0 as for qsort().
+*
+******************************************************************************/
+static int XNandFtl_SeqCompare(const void *A, const void *B)
+{
+	u32 SeqA = XNandFtl_SortBlocks[*(const u32 *)A].Seq;
+	u32 SeqB = XNandFtl_SortBlocks[*(const u32 *)B].Seq;
+
+	if (SeqA < SeqB) {
+		return -1;
+	}
+
+	return (SeqA > SeqB) ? 1 : 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* qsort() comparison of two live page records, by logical page.
+*
+* @param	A is a pointer to the first record.
+* @param	B is a pointer to the second record.
+*
+* @return	<0, 0 or >0 as for qsort().
+*
+******************************************************************************/
+static int XNandFtl_LiveCompare(const void *A, const void *B)
+{
+	u64 LiveA = *(const u64 *)A;
+	u64 LiveB = *(const u64 *)B;
+
+	if (LiveA < LiveB) {
+		return -1;
+	}
+
+	return (LiveA > LiveB) ? 1 : 0;
+}
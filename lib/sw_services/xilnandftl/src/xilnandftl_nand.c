@@ -0,0 +1,391 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilnandftl_nand.c
+*
+* This file binds the FTL to the nandps (Zynq SMC) and nandpsu (ZynqMP)
+* drivers. Each binding is built only when its driver is in the BSP.
+*
+* The FTL tag is kept in spare bytes the controller ECC does not use and
+* clear of the factory bad block marker; the offset is worked out from the
+* driver's ECC layout when the configuration is filled in.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 1.0   esd  10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xilnandftl.h"
+#include "xil_assert.h"
+
+/************************** Constant Definitions *****************************/
+
+/**
+ * Spare bytes kept clear at the start of the spare area for the factory
+ * bad block marker.
+ */
+#define XNANDFTL_BBM_BYTES		4U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+static s32 XNandFtl_PsuReadPage(void *DevPtr, u32 Page, u8 *Buf);
+static s32 XNandFtl_PsuReadTag(void *DevPtr, u32 Page, XNandFtl_Tag *Tag);
+static s32 XNandFtl_PsuProgramPage(void *DevPtr, u32 Page, const u8 *Buf,
+				const XNandFtl_Tag *Tag);
+static s32 XNandFtl_PsuEraseBlock(void *DevPtr, u32 Block);
+static s32 XNandFtl_PsuIsBlockBad(void *DevPtr, u32 Block);
+static s32 XNandFtl_PsuMarkBlockBad(void *DevPtr, u32 Block);
+#endif
+#ifdef XPAR_XNANDPS_NUM_INSTANCES
+static s32 XNandFtl_PsReadPage(void *DevPtr, u32 Page, u8 *Buf);
+static s32 XNandFtl_PsReadTag(void *DevPtr, u32 Page, XNandFtl_Tag *Tag);
+static s32 XNandFtl_PsProgramPage(void *DevPtr, u32 Page, const u8 *Buf,
+				const XNandFtl_Tag *Tag);
+static s32 XNandFtl_PsEraseBlock(void *DevPtr, u32 Block);
+static s32 XNandFtl_PsIsBlockBad(void *DevPtr, u32 Block);
+static s32 XNandFtl_PsMarkBlockBad(void *DevPtr, u32 Block);
+#endif
+
+/************************** Variable Definitions *****************************/
+
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+static const XNandFtl_Ops XNandFtl_PsuOps = {
+	XNandFtl_PsuReadPage,
+	XNandFtl_PsuReadTag,
+	XNandFtl_PsuProgramPage,
+	XNandFtl_PsuEraseBlock,
+	XNandFtl_PsuIsBlockBad,
+	XNandFtl_PsuMarkBlockBad
+};
+
+static u32 XNandFtl_PsuTagOffset;
+static u8 XNandFtl_PsuSpare[XNANDPSU_MAX_SPARE_SIZE]
+				__attribute__ ((aligned(64)));
+#endif
+
+#ifdef XPAR_XNANDPS_NUM_INSTANCES
+static const XNandFtl_Ops XNandFtl_PsOps = {
+	XNandFtl_PsReadPage,
+	XNandFtl_PsReadTag,
+	XNandFtl_PsProgramPage,
+	XNandFtl_PsEraseBlock,
+	XNandFtl_PsIsBlockBad,
+	XNandFtl_PsMarkBlockBad
+};
+
+static u32 XNandFtl_PsTagOffset;
+static u8 XNandFtl_PsSpare[XNANDPS_MAX_SPARE_SIZE];
+#endif
+
+#ifdef XPAR_XNANDPSU_NUM_INSTANCES
+/*****************************************************************************/
+/**
+*
+* This function fills in an FTL configuration for a device driven by the
+* nandpsu driver. The partition defaults to the whole device less the blocks
+* searched for the bad block tables; adjust StartBlock and NumBlocks to keep
+* boot images out of it.
+*
+* With hardware ECC the tag goes into the free bytes in front of the ECC
+* bytes if they can hold it, otherwise into the free bytes behind them. A
+* layout with no free bytes in front of the ECC is not supported, as
+* XNandPsu_WriteSpareBytes() cannot program the bytes behind it alone.
+*
+* @param	ConfigPtr is the configuration to fill in.
+* @param	NandPtr is an initialized nandpsu instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_NO_FEATURE if the spare area has no room for the tag.
+*
+******************************************************************************/
+s32 XNandFtl_NandPsuConfig(XNandFtl_Config *ConfigPtr, XNandPsu *NandPtr)
+{
+	u32 Spare;
+	u32 PreEcc;
+	u32 PostEcc;
+
+	Xil_AssertNonvoid(ConfigPtr != NULL);
+	Xil_AssertNonvoid(NandPtr != NULL);
+	Xil_AssertNonvoid(NandPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Spare = NandPtr->Geometry.SpareBytesPerPage;
+	if (NandPtr->EccMode == XNANDPSU_HWECC) {
+		PreEcc = (u32)NandPtr->EccCfg.EccAddr -
+				NandPtr->Geometry.BytesPerPage;
+		PostEcc = PreEcc + NandPtr->EccCfg.EccSize;
+		if (((PreEcc / 4U) * 4U) >= (XNANDFTL_BBM_BYTES +
+				XNANDFTL_TAG_SIZE)) {
+			XNandFtl_PsuTagOffset = XNANDFTL_BBM_BYTES;
+		} else if ((PreEcc >= 4U) && (PostEcc < Spare) &&
+			((((Spare - PostEcc) / 4U) * 4U) >=
+				XNANDFTL_TAG_SIZE)) {
+			XNandFtl_PsuTagOffset = PostEcc;
+		} else {
+			return (s32)XST_NO_FEATURE;
+		}
+	} else {
+		if (Spare < (XNANDFTL_BBM_BYTES + XNANDFTL_TAG_SIZE)) {
+			return (s32)XST_NO_FEATURE;
+		}
+		XNandFtl_PsuTagOffset = XNANDFTL_BBM_BYTES;
+	}
+
+	ConfigPtr->Ops = &XNandFtl_PsuOps;
+	ConfigPtr->DevPtr = NandPtr;
+	ConfigPtr->BytesPerPage = NandPtr->Geometry.BytesPerPage;
+	ConfigPtr->PagesPerBlock = NandPtr->Geometry.PagesPerBlock;
+	ConfigPtr->StartBlock = 0U;
+	ConfigPtr->NumBlocks = NandPtr->Geometry.NumBlocks -
+				NandPtr->BbtDesc.MaxBlocks;
+	if (ConfigPtr->NumBlocks > XNANDFTL_MAX_BLOCKS) {
+		ConfigPtr->NumBlocks = XNANDFTL_MAX_BLOCKS;
+	}
+	ConfigPtr->Overprovision = XNANDFTL_OVERPROVISION;
+
+	return XST_SUCCESS;
+}
+
+static s32 XNandFtl_PsuReadPage(void *DevPtr, u32 Page, u8 *Buf)
+{
+	XNandPsu *NandPtr = (XNandPsu *)DevPtr;
+
+	return XNandPsu_Read(NandPtr,
+			(u64)Page * NandPtr->Geometry.BytesPerPage,
+			NandPtr->Geometry.BytesPerPage, Buf);
+}
+
+static s32 XNandFtl_PsuReadTag(void *DevPtr, u32 Page, XNandFtl_Tag *Tag)
+{
+	s32 Status;
+
+	Status = XNandPsu_ReadSpareBytes((XNandPsu *)DevPtr, Page,
+			XNandFtl_PsuSpare);
+	(void)memcpy(Tag, &XNandFtl_PsuSpare[XNandFtl_PsuTagOffset],
+			sizeof(XNandFtl_Tag));
+
+	return Status;
+}
+
+/*
+ * The data goes in with the regular page program, which also lays down the
+ * hardware ECC; the tag follows as a partial program of the free spare
+ * bytes, the same way the driver writes its bad block table signature.
+ */
+static s32 XNandFtl_PsuProgramPage(void *DevPtr, u32 Page, const u8 *Buf,
+				const XNandFtl_Tag *Tag)
+{
+	XNandPsu *NandPtr = (XNandPsu *)DevPtr;
+	s32 Status;
+
+	Status = XNandPsu_Write(NandPtr,
+			(u64)Page * NandPtr->Geometry.BytesPerPage,
+			NandPtr->Geometry.BytesPerPage, (u8 *)Buf);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	(void)memset(XNandFtl_PsuSpare, 0xFF,
+			NandPtr->Geometry.SpareBytesPerPage);
+	(void)memcpy(&XNandFtl_PsuSpare[XNandFtl_PsuTagOffset], Tag,
+			sizeof(XNandFtl_Tag));
+
+	return XNandPsu_WriteSpareBytes(NandPtr, Page, XNandFtl_PsuSpare);
+}
+
+static s32 XNandFtl_PsuEraseBlock(void *DevPtr, u32 Block)
+{
+	XNandPsu *NandPtr = (XNandPsu *)DevPtr;
+
+	return XNandPsu_Erase(NandPtr,
+			(u64)Block * NandPtr->Geometry.BlockSize,
+			NandPtr->Geometry.BlockSize);
+}
+
+static s32 XNandFtl_PsuIsBlockBad(void *DevPtr, u32 Block)
+{
+	return XNandPsu_IsBlockBad((XNandPsu *)DevPtr, Block);
+}
+
+static s32 XNandFtl_PsuMarkBlockBad(void *DevPtr, u32 Block)
+{
+	return XNandPsu_MarkBlockBad((XNandPsu *)DevPtr, Block);
+}
+#endif /* XPAR_XNANDPSU_NUM_INSTANCES */
+
+#ifdef XPAR_XNANDPS_NUM_INSTANCES
+/*****************************************************************************/
+/**
+*
+* This function fills in an FTL configuration for a device driven by the
+* nandps driver. The partition defaults to the whole device less the blocks
+* searched for the bad block tables; adjust StartBlock and NumBlocks to keep
+* boot images out of it.
+*
+* The tag is written together with the page through the driver's user spare
+* buffer, at the first run of spare bytes not claimed by the ECC layout or
+* the bad block marker.
+*
+* @param	ConfigPtr is the configuration to fill in.
+* @param	NandPtr is an initialized nandps instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_NO_FEATURE if the spare area has no room for the tag.
+*
+******************************************************************************/
+s32 XNandFtl_NandPsConfig(XNandFtl_Config *ConfigPtr, XNandPs *NandPtr)
+{
+	u32 Spare;
+	u32 Index;
+	u32 Run = 0U;
+	u32 Offset = 0U;
+
+	Xil_AssertNonvoid(ConfigPtr != NULL);
+	Xil_AssertNonvoid(NandPtr != NULL);
+	Xil_AssertNonvoid(NandPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	/* Mark the bytes the ECC and the bad block marker own */
+	Spare = NandPtr->Geometry.SpareBytesPerPage;
+	(void)memset(XNandFtl_PsSpare, 0, Spare);
+	for (Index = 0U; Index < XNANDFTL_BBM_BYTES; Index++) {
+		XNandFtl_PsSpare[Index] = 1U;
+	}
+	for (Index = 0U; (Index < NandPtr->BbPattern.Length) &&
+			((NandPtr->BbPattern.Offset + Index) < Spare); Index++) {
+		XNandFtl_PsSpare[NandPtr->BbPattern.Offset + Index] = 1U;
+	}
+	for (Index = 0U; Index < NandPtr->EccConfig.TotalBytes; Index++) {
+		if (NandPtr->EccConfig.EccPos[Index] < Spare) {
+			XNandFtl_PsSpare[NandPtr->EccConfig.EccPos[Index]] = 1U;
+		}
+	}
+
+	for (Index = 0U; (Index < Spare) && (Run < XNANDFTL_TAG_SIZE);
+			Index++) {
+		if (XNandFtl_PsSpare[Index] != 0U) {
+			Run = 0U;
+		} else {
+			if (Run == 0U) {
+				Offset = Index;
+			}
+			Run++;
+		}
+	}
+	if (Run < XNANDFTL_TAG_SIZE) {
+		return (s32)XST_NO_FEATURE;
+	}
+	XNandFtl_PsTagOffset = Offset;
+
+	ConfigPtr->Ops = &XNandFtl_PsOps;
+	ConfigPtr->DevPtr = NandPtr;
+	ConfigPtr->BytesPerPage = NandPtr->Geometry.BytesPerPage;
+	ConfigPtr->PagesPerBlock = NandPtr->Geometry.PagesPerBlock;
+	ConfigPtr->StartBlock = 0U;
+	ConfigPtr->NumBlocks = (u32)NandPtr->Geometry.NumBlocks -
+				NandPtr->BbtDesc.MaxBlocks;
+	if (ConfigPtr->NumBlocks > XNANDFTL_MAX_BLOCKS) {
+		ConfigPtr->NumBlocks = XNANDFTL_MAX_BLOCKS;
+	}
+	ConfigPtr->Overprovision = XNANDFTL_OVERPROVISION;
+
+	return XST_SUCCESS;
+}
+
+static s32 XNandFtl_PsReadPage(void *DevPtr, u32 Page, u8 *Buf)
+{
+	XNandPs *NandPtr = (XNandPs *)DevPtr;
+
+	return XNandPs_Read(NandPtr,
+			(u64)Page * NandPtr->Geometry.BytesPerPage,
+			NandPtr->Geometry.BytesPerPage, Buf, NULL);
+}
+
+static s32 XNandFtl_PsReadTag(void *DevPtr, u32 Page, XNandFtl_Tag *Tag)
+{
+	s32 Status;
+
+	Status = XNandPs_ReadSpareBytes((XNandPs *)DevPtr, Page,
+			XNandFtl_PsSpare);
+	(void)memcpy(Tag, &XNandFtl_PsSpare[XNandFtl_PsTagOffset],
+			sizeof(XNandFtl_Tag));
+
+	return Status;
+}
+
+static s32 XNandFtl_PsProgramPage(void *DevPtr, u32 Page, const u8 *Buf,
+				const XNandFtl_Tag *Tag)
+{
+	XNandPs *NandPtr = (XNandPs *)DevPtr;
+
+	(void)memset(XNandFtl_PsSpare, 0xFF,
+			NandPtr->Geometry.SpareBytesPerPage);
+	(void)memcpy(&XNandFtl_PsSpare[XNandFtl_PsTagOffset], Tag,
+			sizeof(XNandFtl_Tag));
+
+	return XNandPs_Write(NandPtr,
+			(u64)Page * NandPtr->Geometry.BytesPerPage,
+			NandPtr->Geometry.BytesPerPage, (void *)Buf,
+			XNandFtl_PsSpare);
+}
+
+static s32 XNandFtl_PsEraseBlock(void *DevPtr, u32 Block)
+{
+	return XNandPs_EraseBlock((XNandPs *)DevPtr, Block);
+}
+
+static s32 XNandFtl_PsIsBlockBad(void *DevPtr, u32 Block)
+{
+	return XNandPs_IsBlockBad((XNandPs *)DevPtr, Block);
+}
+
+static s32 XNandFtl_PsMarkBlockBad(void *DevPtr, u32 Block)
+{
+	return XNandPs_MarkBlockBad((XNandPs *)DevPtr, Block);
+}
+#endif /* XPAR_XNANDPS_NUM_INSTANCES */
@@ -34,6 +34,7 @@
 #include "pm_common.h"
 #include "pm_api_sys.h"
 #include "pm_callbacks.h"
+#include <xil_cache.h>
 
 /** @name Payload Packets
  *
@@ -1113,3 +1114,73 @@ XStatus XPm_MmioRead(const u32 address, u32 *const value)
 	/* Return result from IPI return buffer */
 	return pm_ipi_buff_read32(primary_master, value, NULL, NULL);
 }
+
+/****************************************************************************/
+/**
+ * @brief  Call this function to execute several PM API calls with a single
+ * request to the PMU. The calls are executed in order, without any other
+ * request being handled in between, until one of them fails. This avoids an
+ * IPI round trip per call, e.g. for the sequence of requirement changes done
+ * before suspend.
+ *
+ * @param  calls    Array of calls. The payload of each call is filled in by
+ * the caller, the response of each executed call is returned in its response
+ * field (zero for calls which do not return a response).
+ * @param  count    Number of calls in the array
+ * @param  executed Returns the number of executed calls (optional)
+ *
+ * @return XST_SUCCESS if all calls succeeded, otherwise the status of the
+ * failed call or an error code
+ *
+ * @note   The array must be placed in memory owned by the calling master:
+ * for the APU the buffer configured with PM_BATCH_APU_START/END in the PMU
+ * firmware, for an RPU its own TCM. Exactly the range of the array is
+ * flushed before and invalidated after the call, so data sharing a cache
+ * line with the array must not be written while the call is in progress.
+ * Calls which acknowledge through IPI
+ * (REQUEST_ACK_BLOCKING) return their result in the response field instead.
+ * The PMU rejects calls which would suspend, power down or reset the caller
+ * (e.g. XPm_SelfSuspend, XPm_SystemShutdown), calls that use callbacks
+ * (XPm_RequestSuspend, REQUEST_ACK_NON_BLOCKING) and nested batches.
+ *
+ ****************************************************************************/
+XStatus XPm_Batch(XPm_BatchCall *const calls, const u32 count,
+		  u32 *const executed)
+{
+	XStatus status;
+	u32 payload[PAYLOAD_ARG_CNT];
+	u32 done = 0U;
+	u32 i, j;
+	UINTPTR addr = (UINTPTR)calls;
+	u32 size = count * sizeof(XPm_BatchCall);
+
+	if ((NULL == calls) || (0U == count) ||
+	    (count > (0xFFFFFFFFU / sizeof(XPm_BatchCall))) ||
+	    ((u64)addr + size > 0x100000000ULL)) {
+		status = XST_INVALID_PARAM;
+		goto done;
+	}
+
+	for (i = 0U; i < count; i++) {
+		for (j = 0U; j < RESPONSE_ARG_CNT; j++) {
+			calls[i].response[j] = 0U;
+		}
+	}
+
+	/* PMU reads the calls from memory, they must not remain in cache */
+	Xil_DCacheFlushRange(addr, size);
+
+	PACK_PAYLOAD2(payload, PM_BATCH, (u32)addr, count);
+	status = pm_ipi_send(primary_master, payload);
+
+	if (XST_SUCCESS != status)
+		goto done;
+
+	status = pm_ipi_buff_read32(primary_master, &done, NULL, NULL);
+	Xil_DCacheInvalidateRange(addr, size);
+
+done:
+	if (NULL != executed)
+		*executed = done;
+	return status;
+}
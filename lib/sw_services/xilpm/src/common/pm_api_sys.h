@@ -213,5 +213,16 @@ XStatus XPm_ResetGetStatus(const enum XPmReset reset, u32 *status);
 XStatus XPm_MmioWrite(const u32 address, const u32 mask, const u32 value);
 
 XStatus XPm_MmioRead(const u32 address, u32 *const value);
+
+/**
+ * XPm_BatchCall - One PM API call in a batch executed with XPm_Batch
+ */
+typedef struct XPm_BatchCall {
+	u32 payload[PAYLOAD_ARG_CNT];	/**< API id followed by the API arguments */
+	u32 response[RESPONSE_ARG_CNT];	/**< Status and values returned by the call */
+} XPm_BatchCall;
+
+XStatus XPm_Batch(XPm_BatchCall *const calls, const u32 count,
+		  u32 *const executed);
 /** @} */
 #endif /* _PM_API_SYS_H_ */
@@ -131,6 +131,8 @@ enum XPmApiId {
 	PM_FPGA_LOAD,
 	PM_FPGA_GET_STATUS,
 	PM_GET_CHIPID,
+	/** Batched execution of API calls: */
+	PM_BATCH,
 	PM_API_MAX
 };
 